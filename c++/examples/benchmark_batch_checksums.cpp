@@ -0,0 +1,91 @@
+#include "pod5_format/batch_checksum.h"
+#include "pod5_format/file_reader.h"
+#include "pod5_format/signal_table_reader.h"
+#include "pod5_format/types.h"
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+namespace {
+
+double seconds_since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Load every signal batch, returning the time taken.
+double load_signal_batches(std::string const & path, bool verify)
+{
+    pod5::FileReaderOptions options;
+    options.set_verify_batch_checksums(verify);
+    // Cache nothing, so every batch is loaded (and verified) from the file:
+    options.set_max_cached_signal_table_batches(1);
+
+    auto reader = pod5::open_file_reader(path, options);
+    if (!reader.ok()) {
+        std::cerr << "Failed to open file " << path << ": " << reader.status() << "\n";
+        std::exit(EXIT_FAILURE);
+    }
+
+    auto const start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < (*reader)->num_signal_record_batches(); ++i) {
+        auto batch = (*reader)->read_signal_record_batch(i);
+        if (!batch.ok()) {
+            std::cerr << "Failed to load signal batch " << i << ": " << batch.status() << "\n";
+            std::exit(EXIT_FAILURE);
+        }
+    }
+    return seconds_since(start);
+}
+
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+    if (argc != 2) {
+        std::cerr << "Expected one argument - a pod5 file to benchmark\n";
+        return EXIT_FAILURE;
+    }
+    std::string const path = argv[1];
+
+    auto const status = pod5::register_extension_types();
+    if (!status.ok()) {
+        std::cerr << "Failed to register extension types: " << status << "\n";
+        return EXIT_FAILURE;
+    }
+
+    auto const unverified_time = load_signal_batches(path, false);
+    auto const verified_time = load_signal_batches(path, true);
+    std::cout << "Signal batch loads:\n"
+              << "  unverified: " << unverified_time << "s\n"
+              << "  verified:   " << verified_time << "s\n";
+    if (unverified_time > 0) {
+        std::cout << "  overhead:   " << (100 * (verified_time / unverified_time - 1)) << "%\n";
+    }
+
+    auto reader = pod5::open_file_reader(path, {});
+    if (!reader.ok()) {
+        std::cerr << "Failed to open file " << path << ": " << reader.status() << "\n";
+        return EXIT_FAILURE;
+    }
+
+    auto const start = std::chrono::steady_clock::now();
+    auto report = (*reader)->verify_batch_checksums();
+    auto const verify_time = seconds_since(start);
+    if (!report.ok()) {
+        std::cerr << "Failed to verify file: " << report.status() << "\n";
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Whole file verification (" << std::thread::hardware_concurrency()
+              << " threads):\n"
+              << "  checked batches:   " << report->checked_batch_count << "\n"
+              << "  unchecked batches: " << report->unchecked_batch_count << "\n"
+              << "  throughput:        " << (report->checked_byte_count / verify_time / 1e6)
+              << " MB/s\n";
+    for (auto const & failure : report->failures) {
+        std::cout << "  FAILED: " << failure << "\n";
+    }
+    return report->ok() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
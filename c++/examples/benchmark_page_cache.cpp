@@ -0,0 +1,126 @@
+#include "pod5_format/async_signal_loader.h"
+#include "pod5_format/file_reader.h"
+#include "pod5_format/types.h"
+
+#include <chrono>
+#include <iostream>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <vector>
+#endif
+
+namespace {
+
+double seconds_since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+#ifdef __linux__
+// Drop all cached pages of the file, so every scan starts from a cold cache.
+void evict_file(std::string const & path)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Failed to open file " << path << "\n";
+        std::exit(EXIT_FAILURE);
+    }
+    (void)::fdatasync(fd);
+    (void)::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    ::close(fd);
+}
+
+// Find the number of bytes of the file held in the page cache.
+std::size_t resident_bytes(std::string const & path)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Failed to open file " << path << "\n";
+        std::exit(EXIT_FAILURE);
+    }
+    auto const size = ::lseek(fd, 0, SEEK_END);
+    auto const page_size = ::sysconf(_SC_PAGESIZE);
+    std::size_t resident = 0;
+    if (size > 0) {
+        // Mapping the file doesn't fault pages in, mincore reports the page cache state:
+        void * mapping = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        if (mapping != MAP_FAILED) {
+            std::vector<unsigned char> pages((size + page_size - 1) / page_size);
+            if (::mincore(mapping, size, pages.data()) == 0) {
+                for (auto page : pages) {
+                    resident += (page & 1) ? page_size : 0;
+                }
+            }
+            ::munmap(mapping, size);
+        }
+    }
+    ::close(fd);
+    return resident;
+}
+#else
+void evict_file(std::string const &) {}
+
+std::size_t resident_bytes(std::string const &) { return 0; }
+#endif
+
+// Scan the samples of every read with the given access pattern, returning the time taken.
+double scan_file(std::string const & path, pod5::FileAccessPattern access_pattern)
+{
+    pod5::FileReaderOptions options;
+    options.set_access_pattern(access_pattern);
+    auto reader = pod5::open_file_reader(path, options);
+    if (!reader.ok()) {
+        std::cerr << "Failed to open file " << path << ": " << reader.status() << "\n";
+        std::exit(EXIT_FAILURE);
+    }
+
+    auto const start = std::chrono::steady_clock::now();
+    pod5::AsyncSignalLoader loader(*reader, pod5::AsyncSignalLoader::SamplesMode::Samples, {}, {});
+    while (true) {
+        auto batch = loader.release_next_batch();
+        if (!batch.ok()) {
+            std::cerr << "Failed to load signal: " << batch.status() << "\n";
+            std::exit(EXIT_FAILURE);
+        }
+        if (!*batch) {
+            break;
+        }
+    }
+    return seconds_since(start);
+}
+
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+    if (argc != 2) {
+        std::cerr << "Expected one argument - a pod5 file to benchmark\n";
+        return EXIT_FAILURE;
+    }
+    std::string const path = argv[1];
+
+    auto const status = pod5::register_extension_types();
+    if (!status.ok()) {
+        std::cerr << "Failed to register extension types: " << status << "\n";
+        return EXIT_FAILURE;
+    }
+
+    std::pair<char const *, pod5::FileAccessPattern> const patterns[] = {
+        {"normal:    ", pod5::FileAccessPattern::Normal},
+        {"sequential:", pod5::FileAccessPattern::Sequential},
+        {"random:    ", pod5::FileAccessPattern::Random},
+    };
+
+    std::cout << "Full file scans (resident page cache after scan):\n";
+    for (auto const & pattern : patterns) {
+        evict_file(path);
+        auto const scan_time = scan_file(path, pattern.second);
+        std::cout << "  " << pattern.first << " " << scan_time << "s, "
+                  << (resident_bytes(path) / 1e6) << " MB resident\n";
+    }
+    return EXIT_SUCCESS;
+}
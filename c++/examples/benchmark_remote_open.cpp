@@ -0,0 +1,96 @@
+#include "pod5_format/file_reader.h"
+#include "pod5_format/signal_table_reader.h"
+#include "pod5_format/types.h"
+
+#include <arrow/filesystem/filesystem.h>
+#include <arrow/filesystem/localfs.h>
+
+#include <chrono>
+#include <iostream>
+#include <numeric>
+
+namespace {
+
+double seconds_since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <typename T>
+T check(arrow::Result<T> && result, char const * message)
+{
+    if (!result.ok()) {
+        std::cerr << message << ": " << result.status() << "\n";
+        std::exit(EXIT_FAILURE);
+    }
+    return std::move(*result);
+}
+
+// Number of signal batches prefetched together while scanning.
+std::size_t const PREFETCH_BATCH_COUNT = 16;
+
+// Open the file and read every signal batch, reporting the time taken by each.
+void open_and_scan(
+    std::shared_ptr<arrow::fs::FileSystem> const & filesystem,
+    std::string const & path,
+    bool coalesce_reads)
+{
+    auto const open_start = std::chrono::steady_clock::now();
+    std::shared_ptr<pod5::FileReader> reader;
+    if (coalesce_reads) {
+        reader = check(pod5::open_file_reader(filesystem, path), "Failed to open file");
+    } else {
+        auto file = check(filesystem->OpenInputFile(path), "Failed to open file");
+        reader = check(pod5::open_file_reader(file), "Failed to open file");
+    }
+    auto const open_time = seconds_since(open_start);
+
+    auto const scan_start = std::chrono::steady_clock::now();
+    auto const batch_count = reader->num_signal_record_batches();
+    for (std::size_t i = 0; i < batch_count; ++i) {
+        if (i % PREFETCH_BATCH_COUNT == 0) {
+            std::vector<std::size_t> batches(std::min(PREFETCH_BATCH_COUNT, batch_count - i));
+            std::iota(batches.begin(), batches.end(), i);
+            auto const status = reader->prefetch_signal_batches(batches);
+            if (!status.ok()) {
+                std::cerr << "Failed to prefetch signal: " << status << "\n";
+                std::exit(EXIT_FAILURE);
+            }
+        }
+        check(reader->read_signal_record_batch(i), "Failed to read signal");
+    }
+
+    std::cout << "  " << (coalesce_reads ? "coalesced:  " : "individual: ") << "open "
+              << open_time << "s, scan of " << batch_count << " signal batches "
+              << seconds_since(scan_start) << "s\n";
+}
+
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+    if (argc != 2 && argc != 3) {
+        std::cerr << "Expected arguments - a pod5 file to benchmark, and optionally the latency "
+                     "of each read in seconds\n";
+        return EXIT_FAILURE;
+    }
+    std::string const path = argv[1];
+    double const latency = argc == 3 ? std::stod(argv[2]) : 0.02;
+
+    auto const status = pod5::register_extension_types();
+    if (!status.ok()) {
+        std::cerr << "Failed to register extension types: " << status << "\n";
+        return EXIT_FAILURE;
+    }
+
+    // Every read from this filesystem waits for [latency], as a read from object storage would:
+    auto const filesystem = std::make_shared<arrow::fs::SlowFileSystem>(
+        std::make_shared<arrow::fs::LocalFileSystem>(), latency);
+
+    std::cout << "Reading with " << latency << "s latency per request:\n";
+    open_and_scan(filesystem, path, false);
+    open_and_scan(filesystem, path, true);
+
+    (void)pod5::unregister_extension_types();
+    return EXIT_SUCCESS;
+}
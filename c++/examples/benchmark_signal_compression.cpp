@@ -0,0 +1,186 @@
+#include "pod5_format/file_reader.h"
+#include "pod5_format/file_writer.h"
+#include "pod5_format/signal_compression.h"
+#include "pod5_format/signal_table_reader.h"
+#include "pod5_format/types.h"
+
+#include <arrow/array/array_primitive.h>
+#include <arrow/buffer.h>
+#include <arrow/memory_pool.h>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+double seconds_since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Load the samples of every signal row in the file.
+std::vector<std::vector<std::int16_t>> load_signal(std::string const & path)
+{
+    auto reader = pod5::open_file_reader(path, {});
+    if (!reader.ok()) {
+        std::cerr << "Failed to open file " << path << ": " << reader.status() << "\n";
+        std::exit(EXIT_FAILURE);
+    }
+
+    std::vector<std::vector<std::int16_t>> signal;
+    for (std::size_t i = 0; i < (*reader)->num_signal_record_batches(); ++i) {
+        auto batch = (*reader)->read_signal_record_batch(i);
+        if (!batch.ok()) {
+            std::cerr << "Failed to load signal batch " << i << ": " << batch.status() << "\n";
+            std::exit(EXIT_FAILURE);
+        }
+        auto const samples = batch->samples_column();
+        for (std::size_t row = 0; row < batch->num_rows(); ++row) {
+            std::vector<std::int16_t> row_signal(samples->Value(row));
+            auto const status = batch->extract_signal_row(row, gsl::make_span(row_signal));
+            if (!status.ok()) {
+                std::cerr << "Failed to load signal row " << row << ": " << status << "\n";
+                std::exit(EXIT_FAILURE);
+            }
+            signal.push_back(std::move(row_signal));
+        }
+    }
+    return signal;
+}
+
+template <typename Compress, typename Decompress>
+void benchmark_codec(
+    char const * name,
+    std::vector<std::vector<std::int16_t>> const & signal,
+    Compress && compress,
+    Decompress && decompress)
+{
+    auto const pool = arrow::system_memory_pool();
+    std::size_t sample_count = 0;
+    for (auto const & row : signal) {
+        sample_count += row.size();
+    }
+
+    auto const compress_start = std::chrono::steady_clock::now();
+    std::vector<std::shared_ptr<arrow::Buffer>> compressed;
+    std::size_t compressed_size = 0;
+    for (auto const & row : signal) {
+        auto row_compressed = compress(gsl::make_span(row), pool);
+        if (!row_compressed.ok()) {
+            std::cerr << "Failed to compress signal: " << row_compressed.status() << "\n";
+            std::exit(EXIT_FAILURE);
+        }
+        compressed_size += (*row_compressed)->size();
+        compressed.push_back(std::move(*row_compressed));
+    }
+    auto const compress_time = seconds_since(compress_start);
+
+    std::vector<std::int16_t> decompressed;
+    auto const decompress_start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < signal.size(); ++i) {
+        decompressed.resize(signal[i].size());
+        auto const status = decompress(
+            gsl::make_span(compressed[i]->data(), compressed[i]->size()),
+            pool,
+            gsl::make_span(decompressed));
+        if (!status.ok()) {
+            std::cerr << "Failed to decompress signal: " << status << "\n";
+            std::exit(EXIT_FAILURE);
+        }
+    }
+    auto const decompress_time = seconds_since(decompress_start);
+
+    // Check the round trip outside of the timed loop:
+    for (std::size_t i = 0; i < signal.size(); ++i) {
+        decompressed.resize(signal[i].size());
+        auto const status = decompress(
+            gsl::make_span(compressed[i]->data(), compressed[i]->size()),
+            pool,
+            gsl::make_span(decompressed));
+        if (!status.ok() || decompressed != signal[i]) {
+            std::cerr << name << " failed to round trip signal row " << i << "\n";
+            std::exit(EXIT_FAILURE);
+        }
+    }
+
+    auto const sample_bytes = sample_count * sizeof(std::int16_t);
+    std::cout << "  " << name << " " << (8.0 * compressed_size / sample_count)
+              << " bits/sample, compress " << (sample_bytes / compress_time / 1e6)
+              << " MB/s, decompress " << (sample_bytes / decompress_time / 1e6) << " MB/s\n";
+}
+
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+    if (argc != 2) {
+        std::cerr << "Expected one argument - a pod5 file to benchmark\n";
+        return EXIT_FAILURE;
+    }
+    std::string const path = argv[1];
+
+    auto const status = pod5::register_extension_types();
+    if (!status.ok()) {
+        std::cerr << "Failed to register extension types: " << status << "\n";
+        return EXIT_FAILURE;
+    }
+
+    auto const signal = load_signal(path);
+
+    // Throughput is measured in uncompressed sample bytes:
+    std::cout << "Signal compression of " << signal.size() << " signal rows:\n";
+    benchmark_codec(
+        "vbz:",
+        signal,
+        [](gsl::span<std::int16_t const> samples, arrow::MemoryPool * pool) {
+            return pod5::compress_signal(samples, pool);
+        },
+        [](gsl::span<std::uint8_t const> compressed,
+           arrow::MemoryPool * pool,
+           gsl::span<std::int16_t> samples) {
+            return pod5::decompress_signal(compressed, pool, samples);
+        });
+    benchmark_codec(
+        "vbz (level 9):",
+        signal,
+        [](gsl::span<std::int16_t const> samples, arrow::MemoryPool * pool) {
+            return pod5::compress_signal(samples, pool, 9, nullptr);
+        },
+        [](gsl::span<std::uint8_t const> compressed,
+           arrow::MemoryPool * pool,
+           gsl::span<std::int16_t> samples) {
+            return pod5::decompress_signal(compressed, pool, samples);
+        });
+
+    // Train a dictionary on the signal being compressed, as the file writer does with its first
+    // reads:
+    std::vector<gsl::span<std::int16_t const>> training_rows;
+    for (auto const & row : signal) {
+        training_rows.push_back(gsl::make_span(row));
+    }
+    auto dictionary_data = pod5::train_vbz_dictionary(
+        training_rows,
+        pod5::FileWriterOptions::DEFAULT_SIGNAL_DICTIONARY_MAX_SIZE,
+        arrow::system_memory_pool());
+    auto dictionary = dictionary_data.ok() ? pod5::VbzDictionary::make(*dictionary_data)
+                                           : dictionary_data.status();
+    if (dictionary.ok()) {
+        auto const vbz_dictionary = *dictionary;
+        benchmark_codec(
+            "vbz (dictionary):",
+            signal,
+            [&](gsl::span<std::int16_t const> samples, arrow::MemoryPool * pool) {
+                return pod5::compress_signal(
+                    samples, pool, vbz_dictionary->compression_level(), vbz_dictionary.get());
+            },
+            [&](gsl::span<std::uint8_t const> compressed,
+                arrow::MemoryPool * pool,
+                gsl::span<std::int16_t> samples) {
+                return pod5::decompress_signal(compressed, pool, samples, vbz_dictionary.get());
+            });
+    } else {
+        std::cout << "  vbz (dictionary): failed to train: " << dictionary.status() << "\n";
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,23 @@
+#include "pod5_format/file_writer.h"
+
+#include <arrow/io/stdio.h>
+
+#include <iostream>
+
+// Convert a pod5 stream (see pod5::create_stream_file_writer) read from stdin into a pod5 file,
+// eg. `producer | convert_pod5_stream output.pod5`.
+int main(int argc, char ** argv)
+{
+    if (argc != 2) {
+        std::cerr << "Expected one argument - the pod5 file to write\n";
+        return EXIT_FAILURE;
+    }
+
+    auto const status =
+        pod5::convert_stream_to_file(std::make_shared<arrow::io::StdinStream>(), argv[1]);
+    if (!status.ok()) {
+        std::cerr << "Failed to convert stream: " << status << "\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,89 @@
+#include "pod5_format/adaptive_compression_level.h"
+
+#include <algorithm>
+
+namespace pod5 {
+
+namespace {
+// Weight of the latest batch in each level's smoothed throughput:
+constexpr double ThroughputSmoothing = 0.5;
+}  // namespace
+
+AdaptiveCompressionLevel::AdaptiveCompressionLevel(
+    int min_level,
+    int max_level,
+    int initial_level)
+: m_min_level(std::min(min_level, max_level))
+, m_max_level(std::max(min_level, max_level))
+, m_level(std::min(std::max(initial_level, m_min_level), m_max_level))
+{
+}
+
+void AdaptiveCompressionLevel::add_row(
+    std::size_t sample_bytes,
+    Clock::duration compression_time,
+    Clock::time_point now)
+{
+    if (!m_batch_started) {
+        // The first batch is timed from its first row, later ones from the end of the last:
+        m_batch_started = true;
+        m_batch_start = now - compression_time;
+    }
+    m_batch_sample_bytes += sample_bytes;
+    m_batch_compression_time += compression_time;
+}
+
+int AdaptiveCompressionLevel::finish_batch(Clock::time_point now)
+{
+    auto const compression_seconds =
+        std::chrono::duration<double>(m_batch_compression_time).count();
+    auto const elapsed_seconds = std::chrono::duration<double>(now - m_batch_start).count();
+    auto const sample_bytes = m_batch_sample_bytes;
+
+    m_batch_start = now;
+    m_batch_sample_bytes = 0;
+    m_batch_compression_time = Clock::duration{0};
+    if (!m_batch_started || sample_bytes == 0 || compression_seconds <= 0
+        || elapsed_seconds <= 0)
+    {
+        return m_level;
+    }
+
+    auto const measured = sample_bytes / compression_seconds;
+    auto const it = m_throughput.find(m_level);
+    if (it == m_throughput.end()) {
+        m_throughput[m_level] = measured;
+    } else {
+        it->second += ThroughputSmoothing * (measured - it->second);
+    }
+
+    // The throughput a level needs to keep up with the signal arriving:
+    auto const required_throughput = (sample_bytes / elapsed_seconds) / BUSY_FRACTION_TARGET;
+    auto const busy_fraction = compression_seconds / elapsed_seconds;
+    if (busy_fraction > BUSY_FRACTION_HIGH) {
+        auto level = m_level - 1;
+        while (level > m_min_level) {
+            auto const level_throughput = throughput(level);
+            if (level_throughput == 0 || level_throughput >= required_throughput) {
+                break;
+            }
+            --level;
+        }
+        m_level = std::max(level, m_min_level);
+    } else if (busy_fraction < BUSY_FRACTION_LOW && m_level < m_max_level) {
+        // Only step up to levels not already measured too slow:
+        auto const next_throughput = throughput(m_level + 1);
+        if (next_throughput == 0 || next_throughput >= required_throughput) {
+            ++m_level;
+        }
+    }
+    return m_level;
+}
+
+double AdaptiveCompressionLevel::throughput(int level) const
+{
+    auto const it = m_throughput.find(level);
+    return it == m_throughput.end() ? 0.0 : it->second;
+}
+
+}  // namespace pod5
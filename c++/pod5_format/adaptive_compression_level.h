@@ -0,0 +1,80 @@
+#pragma once
+
+#include "pod5_format/pod5_format_export.h"
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+
+namespace pod5 {
+
+/// \brief Measurements of the signal a writer compressed.
+/// \note Only signal compressed by the writer is counted, pre-compressed signal is not.
+struct SignalCompressionMetrics {
+    std::uint64_t sample_bytes = 0;
+    std::uint64_t compressed_bytes = 0;
+    /// Time spent compressing signal.
+    double compression_seconds = 0;
+    /// The number of rows compressed at each zstd level, for vbz signal.
+    std::map<int, std::uint64_t> rows_per_level;
+
+    /// Find the ratio of sample bytes to compressed bytes, 0 if nothing was compressed.
+    double compression_ratio() const
+    {
+        return compressed_bytes ? double(sample_bytes) / compressed_bytes : 0.0;
+    }
+};
+
+/// \brief Pick the zstd level signal is compressed at for each batch, from the writer's backlog
+///        and the throughput measured at each level.
+/// \details The writer can't see its caller's queue, but a caller with a backlog adds signal back
+///          to back, so the fraction of each batch's wall time spent compressing stands in for it.
+///          While that fraction is high the level drops (straight to the highest level measured
+///          fast enough for the signal's arrival rate), while it is low the level rises one step
+///          at a time.
+class POD5_FORMAT_EXPORT AdaptiveCompressionLevel {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// Above this fraction of time spent compressing the level is lowered.
+    static constexpr double BUSY_FRACTION_HIGH = 0.6;
+    /// Below this fraction of time spent compressing the level is raised.
+    static constexpr double BUSY_FRACTION_LOW = 0.3;
+    /// The fraction of time spent compressing levels are chosen to keep to.
+    static constexpr double BUSY_FRACTION_TARGET = 0.45;
+
+    AdaptiveCompressionLevel(int min_level, int max_level, int initial_level);
+
+    /// Find the level the current batch is compressed at.
+    int level() const { return m_level; }
+
+    int min_level() const { return m_min_level; }
+
+    int max_level() const { return m_max_level; }
+
+    /// \brief Record a row of [sample_bytes] compressed in [compression_time], added at [now].
+    void add_row(std::size_t sample_bytes, Clock::duration compression_time, Clock::time_point now);
+
+    /// \brief Finish the current batch at [now], choosing the level for the next one.
+    /// \returns The level for the next batch.
+    int finish_batch(Clock::time_point now);
+
+    /// \brief Find the compression throughput measured at [level] in bytes per second, 0 if it
+    ///        hasn't been measured.
+    double throughput(int level) const;
+
+private:
+    int m_min_level;
+    int m_max_level;
+    int m_level;
+
+    bool m_batch_started = false;
+    Clock::time_point m_batch_start;
+    std::size_t m_batch_sample_bytes = 0;
+    Clock::duration m_batch_compression_time{0};
+
+    // Smoothed sample bytes compressed per second at each level measured:
+    std::map<int, double> m_throughput;
+};
+
+}  // namespace pod5
@@ -0,0 +1,164 @@
+#pragma once
+
+#include "pod5_format/file_reader.h"
+#include "pod5_format/read_table_reader.h"
+#include "pod5_format/result.h"
+#include "pod5_format/signal_table_reader.h"
+#include "pod5_format/thread_pool.h"
+
+#include <gsl/gsl-lite.hpp>
+
+#include <algorithm>
+#include <coroutine>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace pod5 {
+
+/// \brief The result of an operation run on a thread pool, co_await it for the operation's result.
+/// \details The operation starts as soon as it is created, so several can be started and then
+///          awaited in turn to overlap them. Awaiting an unfinished operation suspends the awaiting
+///          coroutine, which is resumed on the pool thread that finishes it.
+/// \tparam ResultType Status, or the Result<T> the operation returns.
+/// \note Each result can only be awaited once.
+template <typename ResultType>
+class AsyncResult {
+public:
+    struct State {
+        void complete(ResultType && operation_result)
+        {
+            std::coroutine_handle<> waiter;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                result.emplace(std::move(operation_result));
+                waiter = std::exchange(this->waiter, nullptr);
+            }
+            if (waiter) {
+                waiter.resume();
+            }
+        }
+
+        std::mutex mutex;
+        std::optional<ResultType> result;
+        std::coroutine_handle<> waiter;
+    };
+
+    explicit AsyncResult(std::shared_ptr<State> state) : m_state(std::move(state)) {}
+
+    bool await_ready() const
+    {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        return m_state->result.has_value();
+    }
+
+    bool await_suspend(std::coroutine_handle<> waiter)
+    {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        if (m_state->result) {
+            return false;
+        }
+        m_state->waiter = waiter;
+        return true;
+    }
+
+    ResultType await_resume()
+    {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        return std::move(*m_state->result);
+    }
+
+private:
+    std::shared_ptr<State> m_state;
+};
+
+/// \brief Run [operation] on [thread_pool], returning its result to co_await.
+template <typename Operation>
+auto run_on_thread_pool(ThreadPool & thread_pool, Operation operation)
+    -> AsyncResult<decltype(operation())>
+{
+    using ResultType = decltype(operation());
+    auto state = std::make_shared<typename AsyncResult<ResultType>::State>();
+    thread_pool.create_strand()->post(
+        [state, operation = std::move(operation)] { state->complete(operation()); });
+    return AsyncResult<ResultType>(std::move(state));
+}
+
+/// \brief Awaitable versions of a FileReader's batch and signal reads, run on a thread pool.
+/// \details Many batch and signal reads can be started together, and are spread across the
+///          pool's threads:
+///
+///     std::vector<AsyncResult<Result<ReadTableRecordBatch>>> batches;
+///     for (std::size_t i = 0; i < reader.num_read_record_batches(); ++i) {
+///         batches.push_back(reader.read_read_record_batch(i));
+///     }
+///     for (auto & batch : batches) {
+///         Result<ReadTableRecordBatch> read_batch = co_await batch;
+///         ...
+///     }
+///
+/// \note Only available to C++20 code, and installed when pod5 is built with
+///       POD5_ENABLE_COROUTINES. The last reference to the thread pool must not be released on one
+///       of its own threads.
+class AsyncFileReader {
+public:
+    /// \brief Create an async reader for [reader], reading on [thread_pool].
+    /// \param thread_pool The pool to read on, or null for one with a thread per hardware thread.
+    AsyncFileReader(
+        std::shared_ptr<FileReader> reader,
+        std::shared_ptr<ThreadPool> thread_pool = nullptr)
+    : m_reader(std::move(reader))
+    , m_thread_pool(std::move(thread_pool))
+    {
+        if (!m_thread_pool) {
+            m_thread_pool =
+                make_thread_pool(std::max<std::size_t>(1, std::thread::hardware_concurrency()));
+        }
+    }
+
+    FileReader & reader() const { return *m_reader; }
+
+    std::size_t num_read_record_batches() const { return m_reader->num_read_record_batches(); }
+
+    std::size_t num_signal_record_batches() const { return m_reader->num_signal_record_batches(); }
+
+    /// \brief Read a read table batch, see FileReader::read_read_record_batch.
+    AsyncResult<Result<ReadTableRecordBatch>> read_read_record_batch(std::size_t i) const
+    {
+        return run_on_thread_pool(
+            *m_thread_pool, [reader = m_reader, i] { return reader->read_read_record_batch(i); });
+    }
+
+    /// \brief Read a signal table batch, see FileReader::read_signal_record_batch.
+    AsyncResult<Result<SignalTableRecordBatch>> read_signal_record_batch(std::size_t i) const
+    {
+        return run_on_thread_pool(
+            *m_thread_pool, [reader = m_reader, i] { return reader->read_signal_record_batch(i); });
+    }
+
+    /// \brief Extract the samples for a list of rows, see FileReader::extract_samples.
+    /// \note [row_indices] is copied, [output_samples] must stay valid until the extraction
+    ///       completes.
+    AsyncResult<Status> extract_samples(
+        gsl::span<std::uint64_t const> const & row_indices,
+        gsl::span<std::int16_t> const & output_samples) const
+    {
+        return run_on_thread_pool(
+            *m_thread_pool,
+            [reader = m_reader,
+             rows = std::vector<std::uint64_t>(row_indices.begin(), row_indices.end()),
+             output_samples] {
+                return reader->extract_samples(gsl::make_span(rows), output_samples);
+            });
+    }
+
+private:
+    std::shared_ptr<FileReader> m_reader;
+    std::shared_ptr<ThreadPool> m_thread_pool;
+};
+
+}  // namespace pod5
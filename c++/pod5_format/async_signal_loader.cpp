@@ -1,5 +1,7 @@
 #include "pod5_format/async_signal_loader.h"
 
+#include <algorithm>
+
 namespace pod5 {
 
 const std::size_t AsyncSignalLoader::MINIMUM_JOB_SIZE = 50;
@@ -10,14 +12,18 @@ AsyncSignalLoader::AsyncSignalLoader(
     gsl::span<std::uint32_t const> const & batch_counts,
     gsl::span<std::uint32_t const> const & batch_rows,
     std::size_t worker_count,
-    std::size_t max_pending_batches)
+    std::size_t max_pending_batches,
+    gsl::span<std::uint32_t const> const & batch_order)
 : m_reader(reader)
 , m_samples_mode(samples_mode)
 , m_max_pending_batches(max_pending_batches)
-, m_reads_batch_count(m_reader->num_read_record_batches())
+, m_reads_batch_count(
+      batch_order.empty() ? m_reader->num_read_record_batches() : batch_order.size())
 , m_batch_counts(batch_counts)
 , m_total_batch_count_so_far(0)
 , m_batch_rows(batch_rows)
+, m_batch_order(batch_order)
+, m_next_prefetch_batch(0)
 , m_worker_job_size(std::max<std::size_t>(
       MINIMUM_JOB_SIZE,
       m_batch_rows.size() / (m_reads_batch_count * worker_count * 2)))
@@ -95,6 +101,19 @@ Result<std::unique_ptr<CachedBatchSignalData>> AsyncSignalLoader::release_next_b
             std::this_thread::sleep_for(std::chrono::milliseconds(1));
         }
 
+        // Signal batches before the last one this batch loaded won't be needed again by a
+        // sequential scan, let the reader drop them from the page cache (an ordered traversal
+        // may return to them):
+        auto const max_signal_row = batch->max_signal_row();
+        if (m_batch_order.empty() && max_signal_row) {
+            std::size_t batch_row = 0;
+            auto const signal_batch =
+                m_reader->signal_batch_for_row_id(*max_signal_row, &batch_row);
+            if (signal_batch.ok()) {
+                m_reader->release_signal_batches_before(*signal_batch);
+            }
+        }
+
         return batch->release_data();
     }
 
@@ -178,18 +197,41 @@ void AsyncSignalLoader::do_work(
     std::uint32_t row_start,
     std::uint32_t row_end)
 {
-    // First secure the sample counts column for the batch we are processing:
+    // First secure the read id, signal and sample count columns for the batch we are processing:
+    auto read_id_column = batch->read_batch().read_id_column();
     auto signal_column = batch->read_batch().signal_column();
 
+    // Without samples to load, counts come from the read table and no signal is touched:
+    std::shared_ptr<arrow::UInt64Array> num_samples_column;
+    if (m_samples_mode == SamplesMode::NoSamples) {
+        auto num_samples_result = batch->read_batch().num_samples_column();
+        if (!num_samples_result.ok()) {
+            m_error = num_samples_result.status();
+            m_has_error = true;
+            return;
+        }
+        num_samples_column = *num_samples_result;
+    }
+
     // And record where we are starting in the batch rows array, if it exists:
     for (std::uint32_t i = row_start; i < row_end; ++i) {
         // Find the actual batch row to query - we may be working on a subset of batch data:
         auto const actual_batch_row = batch->get_batch_row_to_query(i);
+        batch->set_read_id(i, read_id_column->Value(actual_batch_row));
+        if (num_samples_column) {
+            batch->set_samples(i, num_samples_column->Value(actual_batch_row), {});
+            continue;
+        }
+
         // Get the signal row data for the read:
         auto const signal_rows = std::static_pointer_cast<arrow::UInt64Array>(
             signal_column->value_slice(actual_batch_row));
         auto const signal_rows_span =
             gsl::make_span(signal_rows->raw_values(), signal_rows->length());
+        if (!signal_rows_span.empty()) {
+            batch->record_signal_row(
+                *std::max_element(signal_rows_span.begin(), signal_rows_span.end()));
+        }
 
         // Find the sample count for these rows:
         auto sample_count_result = m_reader->extract_sample_count(signal_rows_span);
@@ -222,22 +264,79 @@ void AsyncSignalLoader::do_work(
 Status AsyncSignalLoader::setup_next_in_progress_batch(std::unique_lock<std::mutex> & lock)
 {
     assert(!m_in_progress_batch);
-    ARROW_ASSIGN_OR_RAISE(auto read_batch, m_reader->read_read_record_batch(m_current_batch));
+    std::uint32_t batch_index = m_current_batch;
+    if (!m_batch_order.empty()) {
+        batch_index = m_batch_order[m_current_batch];
+        if (m_samples_mode == SamplesMode::Samples && m_current_batch >= m_next_prefetch_batch) {
+            ARROW_RETURN_NOT_OK(prefetch_upcoming_batches());
+        }
+    }
+
+    ARROW_ASSIGN_OR_RAISE(auto read_batch, m_reader->read_read_record_batch(batch_index));
     std::size_t row_count = read_batch.num_rows();
 
     gsl::span<std::uint32_t const> next_specific_batch_rows;
     if (!m_batch_counts.empty()) {
         row_count = m_batch_counts[m_current_batch];
         if (!m_batch_rows.empty()) {
+            if (m_total_batch_count_so_far + row_count > m_batch_rows.size()) {
+                return Status::Invalid("Batch rows hold fewer rows than the batch counts");
+            }
             next_specific_batch_rows = m_batch_rows.subspan(m_total_batch_count_so_far, row_count);
+            for (auto row : next_specific_batch_rows) {
+                if (row >= read_batch.num_rows()) {
+                    return Status::IndexError("Batch row ", row, " out of range");
+                }
+            }
         }
     }
 
     m_in_progress_batch = std::make_shared<SignalCacheWorkPackage>(
-        m_current_batch, row_count, next_specific_batch_rows, std::move(read_batch));
+        batch_index, row_count, next_specific_batch_rows, std::move(read_batch));
     return Status::OK();
 }
 
+Status AsyncSignalLoader::prefetch_upcoming_batches()
+{
+    // Rows are only known up front when the caller lists them:
+    if (m_batch_counts.empty() || m_batch_rows.empty()) {
+        return Status::OK();
+    }
+
+    auto const end_batch = std::min(
+        m_reads_batch_count, m_current_batch + std::max<std::size_t>(m_max_pending_batches, 1));
+
+    // Merge the visits into a plan ordered by read table batch, as the reader expects:
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> batch_rows;
+    std::size_t row_offset = m_total_batch_count_so_far;
+    for (std::size_t i = m_current_batch; i < end_batch; ++i) {
+        if (row_offset + m_batch_counts[i] > m_batch_rows.size()) {
+            return Status::Invalid("Batch rows hold fewer rows than the batch counts");
+        }
+        auto const rows = m_batch_rows.subspan(row_offset, m_batch_counts[i]);
+        for (auto row : rows) {
+            batch_rows.emplace_back(m_batch_order[i], row);
+        }
+        row_offset += m_batch_counts[i];
+    }
+    std::sort(batch_rows.begin(), batch_rows.end());
+    batch_rows.erase(std::unique(batch_rows.begin(), batch_rows.end()), batch_rows.end());
+
+    ReadTraversalPlan plan;
+    plan.batch_counts.resize(m_reader->num_read_record_batches());
+    plan.batch_rows.reserve(batch_rows.size());
+    for (auto const & batch_row : batch_rows) {
+        if (batch_row.first >= plan.batch_counts.size()) {
+            return Status::IndexError("Read batch ", batch_row.first, " out of range");
+        }
+        plan.batch_counts[batch_row.first] += 1;
+        plan.batch_rows.push_back(batch_row.second);
+    }
+
+    m_next_prefetch_batch = end_batch;
+    return m_reader->prefetch_traversal(plan);
+}
+
 void AsyncSignalLoader::release_in_progress_batch()
 {
     if (m_in_progress_batch) {
@@ -7,10 +7,13 @@
 
 #include <arrow/array/array_nested.h>
 #include <arrow/array/array_primitive.h>
+#include <boost/optional/optional.hpp>
 #include <boost/thread/synchronized_value.hpp>
+#include <boost/uuid/uuid.hpp>
 
 #include <condition_variable>
 #include <deque>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <thread>
@@ -21,6 +24,7 @@ class POD5_FORMAT_EXPORT CachedBatchSignalData {
 public:
     CachedBatchSignalData(std::uint32_t batch_index, std::size_t entry_count)
     : m_batch_index(batch_index)
+    , m_read_ids(entry_count)
     , m_sample_counts(entry_count)
     , m_samples(entry_count)
     {
@@ -28,12 +32,23 @@ public:
 
     std::uint32_t batch_index() const { return m_batch_index; }
 
+    /// Find a list of read ids for all requested batch rows.
+    std::vector<boost::uuids::uuid> const & read_ids() const { return m_read_ids; }
+
     /// Find a list of sample counts for all requested batch rows.
     std::vector<std::uint64_t> const & sample_count() const { return m_sample_counts; }
 
     /// Find a list of signal samples counts for all requested batch rows.
     std::vector<std::vector<std::int16_t>> const & samples() const { return m_samples; }
 
+    /// Take the signal samples of all requested batch rows, leaving the batch without samples.
+    std::vector<std::vector<std::int16_t>> release_samples() { return std::move(m_samples); }
+
+    void set_read_id(std::size_t row, boost::uuids::uuid const & read_id)
+    {
+        m_read_ids[row] = read_id;
+    }
+
     void
     set_samples(std::size_t row, std::uint64_t sample_count, std::vector<std::int16_t> && samples)
     {
@@ -43,6 +58,7 @@ public:
 
 private:
     std::uint32_t m_batch_index;
+    std::vector<boost::uuids::uuid> m_read_ids;
     std::vector<std::uint64_t> m_sample_counts;
     std::vector<std::vector<std::int16_t>> m_samples;
 };
@@ -65,6 +81,11 @@ public:
 
     std::uint32_t job_row_count() const { return m_job_row_count; }
 
+    void set_read_id(std::size_t row, boost::uuids::uuid const & read_id)
+    {
+        m_cached_data->set_read_id(row, read_id);
+    }
+
     void
     set_samples(std::size_t row, std::uint64_t sample_count, std::vector<std::int16_t> && samples)
     {
@@ -99,12 +120,35 @@ public:
 
     bool is_complete() const { return m_completed_rows.load() >= m_job_row_count; }
 
+    /// Record that signal [row] has been loaded for this batch.
+    void record_signal_row(std::uint64_t row)
+    {
+        auto max_row = m_max_signal_row.load();
+        while ((max_row == NO_SIGNAL_ROW || row > max_row)
+               && !m_max_signal_row.compare_exchange_weak(max_row, row))
+        {
+        }
+    }
+
+    /// Find the highest signal row loaded for this batch, if any were loaded.
+    boost::optional<std::uint64_t> max_signal_row() const
+    {
+        auto const max_row = m_max_signal_row.load();
+        if (max_row == NO_SIGNAL_ROW) {
+            return boost::none;
+        }
+        return max_row;
+    }
+
 private:
+    static constexpr std::uint64_t NO_SIGNAL_ROW = std::numeric_limits<std::uint64_t>::max();
+
     std::size_t m_job_row_count;
     gsl::span<std::uint32_t const> m_specific_job_rows;
 
     std::uint32_t m_next_row_to_start;
     std::atomic<std::uint32_t> m_completed_rows;
+    std::atomic<std::uint64_t> m_max_signal_row{NO_SIGNAL_ROW};
 
     std::unique_ptr<CachedBatchSignalData> m_cached_data;
     pod5::ReadTableRecordBatch m_read_batch;
@@ -119,13 +163,21 @@ public:
         Samples,
     };
 
+    /// \param batch_counts Number of rows to load from each batch visited, or empty for all rows.
+    /// \param batch_rows Rows to load, packed batch by batch in visiting order, or empty for all
+    ///                   rows of each batch.
+    /// \param batch_order Read table batches to visit in turn, batches may be visited more than
+    ///                    once. Empty visits every batch once, in file order.
+    /// \note When [batch_order] is given [batch_counts] holds one entry per visit, and the signal
+    ///       of upcoming visits is prefetched by the reader (see FileReader::prefetch_traversal).
     AsyncSignalLoader(
         std::shared_ptr<pod5::FileReader> const & reader,
         SamplesMode samples_mode,
         gsl::span<std::uint32_t const> const & batch_counts,
         gsl::span<std::uint32_t const> const & batch_rows,
         std::size_t worker_count = std::thread::hardware_concurrency(),
-        std::size_t max_pending_batches = 10);
+        std::size_t max_pending_batches = 10,
+        gsl::span<std::uint32_t const> const & batch_order = {});
 
     ~AsyncSignalLoader();
 
@@ -153,6 +205,10 @@ private:
     /// \note m_current_batch is used as the index of the next batch to begin.
     Status setup_next_in_progress_batch(std::unique_lock<std::mutex> & lock);
 
+    /// Prefetch the signal of the visits from m_current_batch onwards, up to the next
+    /// m_max_pending_batches visits.
+    Status prefetch_upcoming_batches();
+
     /// Release the currently in progress batch to readers, if it exists.
     /// \note This call locks m_batches_sync internally.
     /// \note The batch must not have any work remaining to start, but can be completing already started work.
@@ -166,6 +222,8 @@ private:
     gsl::span<std::uint32_t const> m_batch_counts;
     std::size_t m_total_batch_count_so_far;
     gsl::span<std::uint32_t const> m_batch_rows;
+    gsl::span<std::uint32_t const> m_batch_order;
+    std::size_t m_next_prefetch_batch;
 
     std::uint32_t const m_worker_job_size;
 
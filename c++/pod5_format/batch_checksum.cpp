@@ -0,0 +1,141 @@
+#include "pod5_format/batch_checksum.h"
+
+#include <arrow/buffer.h>
+#include <arrow/io/interfaces.h>
+
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define POD5_CRC32C_X64
+#include <nmmintrin.h>
+#endif
+
+namespace pod5 {
+
+namespace {
+
+// Reflected form of the Castagnoli polynomial.
+constexpr std::uint32_t CRC32C_POLYNOMIAL = 0x82F63B78;
+
+struct Crc32cTables {
+    Crc32cTables()
+    {
+        for (std::uint32_t i = 0; i < 256; ++i) {
+            std::uint32_t crc = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                crc = (crc >> 1) ^ (CRC32C_POLYNOMIAL & (0u - (crc & 1)));
+            }
+            table[0][i] = crc;
+        }
+        for (std::uint32_t i = 0; i < 256; ++i) {
+            for (std::size_t slice = 1; slice < table.size(); ++slice) {
+                auto const previous = table[slice - 1][i];
+                table[slice][i] = (previous >> 8) ^ table[0][previous & 0xff];
+            }
+        }
+    }
+
+    std::array<std::array<std::uint32_t, 256>, 8> table;
+};
+
+std::uint32_t crc32c_software(std::uint32_t crc, std::uint8_t const * data, std::size_t length)
+{
+    static Crc32cTables const tables;
+    auto const & t = tables.table;
+
+    // Slicing-by-8, consuming a little endian word at a time:
+    while (length >= 8) {
+        std::uint32_t low;
+        std::uint32_t high;
+        std::memcpy(&low, data, sizeof(low));
+        std::memcpy(&high, data + 4, sizeof(high));
+        low ^= crc;
+        crc = t[7][low & 0xff] ^ t[6][(low >> 8) & 0xff] ^ t[5][(low >> 16) & 0xff]
+              ^ t[4][low >> 24] ^ t[3][high & 0xff] ^ t[2][(high >> 8) & 0xff]
+              ^ t[1][(high >> 16) & 0xff] ^ t[0][high >> 24];
+        data += 8;
+        length -= 8;
+    }
+
+    while (length--) {
+        crc = (crc >> 8) ^ t[0][(crc ^ *data++) & 0xff];
+    }
+    return crc;
+}
+
+#ifdef POD5_CRC32C_X64
+__attribute__((target("sse4.2"))) std::uint32_t
+crc32c_sse42(std::uint32_t crc, std::uint8_t const * data, std::size_t length)
+{
+    std::uint64_t crc64 = crc;
+    while (length >= 8) {
+        std::uint64_t word;
+        std::memcpy(&word, data, sizeof(word));
+        crc64 = _mm_crc32_u64(crc64, word);
+        data += 8;
+        length -= 8;
+    }
+
+    auto crc32 = std::uint32_t(crc64);
+    while (length--) {
+        crc32 = _mm_crc32_u8(crc32, *data++);
+    }
+    return crc32;
+}
+
+bool has_sse42()
+{
+    static bool const supported = __builtin_cpu_supports("sse4.2");
+    return supported;
+}
+#endif
+
+}  // namespace
+
+std::uint32_t crc32c(void const * data, std::size_t length, std::uint32_t crc)
+{
+    auto const bytes = static_cast<std::uint8_t const *>(data);
+    crc = ~crc;
+#ifdef POD5_CRC32C_X64
+    if (has_sse42()) {
+        return ~crc32c_sse42(crc, bytes, length);
+    }
+#endif
+    return ~crc32c_software(crc, bytes, length);
+}
+
+Result<std::shared_ptr<arrow::Buffer>> read_checked_bytes(
+    arrow::io::RandomAccessFile & file,
+    BatchChecksum const & checksum)
+{
+    ARROW_ASSIGN_OR_RAISE(auto buffer, file.ReadAt(checksum.offset, checksum.length));
+    if (buffer->size() != checksum.length) {
+        return Status::IOError(
+            "Batch at offset ",
+            checksum.offset,
+            " is truncated, expected ",
+            checksum.length,
+            " bytes, found ",
+            buffer->size());
+    }
+
+    auto const crc = crc32c(buffer->data(), buffer->size());
+    if (crc != checksum.crc32c) {
+        return Status::IOError(
+            "Checksum mismatch for batch at offset ",
+            checksum.offset,
+            ", expected ",
+            checksum.crc32c,
+            ", found ",
+            crc);
+    }
+    return buffer;
+}
+
+Status verify_batch_checksum(arrow::io::RandomAccessFile & file, BatchChecksum const & checksum)
+{
+    return read_checked_bytes(file, checksum).status();
+}
+
+}  // namespace pod5
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "pod5_format/pod5_format_export.h"
+#include "pod5_format/result.h"
+
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace arrow {
+class Buffer;
+namespace io {
+class RandomAccessFile;
+}
+}  // namespace arrow
+
+namespace pod5 {
+
+/// \brief Compute the CRC32C (Castagnoli) checksum of [length] bytes at [data].
+/// \param crc  The checksum of any preceding data, allowing a checksum to be built in pieces.
+/// \note Uses the SSE4.2 crc32 instruction when the running CPU supports it.
+POD5_FORMAT_EXPORT std::uint32_t crc32c(
+    void const * data,
+    std::size_t length,
+    std::uint32_t crc = 0);
+
+/// \brief The checksum of the bytes written for one record batch of a table.
+/// \details The range covers every IPC message written with the batch (including the schema and
+///          any dictionary batches written alongside it), relative to the start of the table.
+///          Stored per table in the pod5 file footer.
+struct BatchChecksum {
+    std::int64_t offset = 0;
+    std::int64_t length = 0;
+    std::uint32_t crc32c = 0;
+
+    bool operator==(BatchChecksum const & other) const
+    {
+        return offset == other.offset && length == other.length && crc32c == other.crc32c;
+    }
+};
+
+/// \brief Read the bytes covered by [checksum] from [file], and check they are unchanged.
+/// \returns The bytes read, so they can be decoded without reading them again. IOError if they can
+///          not be read or do not match the checksum.
+POD5_FORMAT_EXPORT Result<std::shared_ptr<arrow::Buffer>> read_checked_bytes(
+    arrow::io::RandomAccessFile & file,
+    BatchChecksum const & checksum);
+
+/// \brief Re-read the bytes covered by [checksum] from [file], and check they are unchanged.
+/// \returns IOError if the bytes can not be read or do not match the checksum.
+POD5_FORMAT_EXPORT Status verify_batch_checksum(
+    arrow::io::RandomAccessFile & file,
+    BatchChecksum const & checksum);
+
+/// \brief Outcome of checking every stored batch of a file against its checksum.
+struct BatchChecksumReport {
+    /// Number of batches checked against a stored checksum.
+    std::size_t checked_batch_count = 0;
+    /// Number of batches written without a checksum (for example by an older writer).
+    std::size_t unchecked_batch_count = 0;
+    /// Total size of the checked batches.
+    std::uint64_t checked_byte_count = 0;
+    /// A description of each batch which failed verification.
+    std::vector<std::string> failures;
+
+    bool ok() const { return failures.empty(); }
+
+    void merge(BatchChecksumReport && other)
+    {
+        checked_batch_count += other.checked_batch_count;
+        unchecked_batch_count += other.unchecked_batch_count;
+        checked_byte_count += other.checked_byte_count;
+        failures.insert(
+            failures.end(),
+            std::make_move_iterator(other.failures.begin()),
+            std::make_move_iterator(other.failures.end()));
+    }
+};
+
+}  // namespace pod5
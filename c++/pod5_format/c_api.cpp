@@ -1,21 +1,41 @@
 #include "pod5_format/c_api.h"
 
+#include "pod5_format/decoded_signal_cache.h"
 #include "pod5_format/file_reader.h"
 #include "pod5_format/file_writer.h"
+#include "pod5_format/read_batch_view.h"
+#include "pod5_format/read_id_utils.h"
 #include "pod5_format/read_table_reader.h"
+#include "pod5_format/signal_client.h"
 #include "pod5_format/signal_compression.h"
+#include "pod5_format/signal_kernels.h"
 #include "pod5_format/signal_table_reader.h"
+#include "pod5_format/thread_pool.h"
 
 #include <arrow/array/array_binary.h>
 #include <arrow/array/array_dict.h>
 #include <arrow/array/array_nested.h>
 #include <arrow/array/array_primitive.h>
+#include <arrow/buffer.h>
 #include <arrow/memory_pool.h>
 #include <arrow/type.h>
-#include <boost/uuid/uuid_io.hpp>
 
+#include <algorithm>
+#include <cerrno>
 #include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <functional>
 #include <iostream>
+#include <mutex>
+#include <thread>
+
+#ifdef __linux__
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
 
 //---------------------------------------------------------------------------------------------------------------------
 struct Pod5FileReader {
@@ -24,6 +44,40 @@ struct Pod5FileReader {
     std::shared_ptr<pod5::FileReader> reader;
 };
 
+struct Pod5DecodedSignalCache {
+    Pod5DecodedSignalCache(std::shared_ptr<pod5::DecodedSignalCache> && cache_)
+    : cache(std::move(cache_))
+    {
+    }
+
+    std::shared_ptr<pod5::DecodedSignalCache> cache;
+};
+
+struct Pod5SignalClient {
+    Pod5SignalClient(std::unique_ptr<pod5::SignalClient> && client_) : client(std::move(client_)) {}
+
+    std::unique_ptr<pod5::SignalClient> client;
+};
+
+struct Pod5SignalServerReads {
+    Pod5SignalServerReads(std::shared_ptr<pod5::SignalServerReads> && reads_)
+    : reads(std::move(reads_))
+    {
+    }
+
+    std::shared_ptr<pod5::SignalServerReads> reads;
+};
+
+// Signal server reads are handed to C callers in place:
+static_assert(
+    sizeof(SignalServerRead_t) == sizeof(pod5::SignalServerRead),
+    "C signal server reads must match the protocol's");
+static_assert(
+    offsetof(SignalServerRead_t, sample_offset) == offsetof(pod5::SignalServerRead, sample_offset)
+        && offsetof(SignalServerRead_t, time_since_mux_change)
+               == offsetof(pod5::SignalServerRead, time_since_mux_change),
+    "C signal server reads must match the protocol's");
+
 struct Pod5FileWriter {
     Pod5FileWriter(std::unique_ptr<pod5::FileWriter> && writer_) : writer(std::move(writer_)) {}
 
@@ -33,16 +87,107 @@ struct Pod5FileWriter {
 struct Pod5ReadRecordBatch {
     Pod5ReadRecordBatch(
         pod5::ReadTableRecordBatch && batch_,
+        pod5::LatestReadBatchView const & view_,
         std::shared_ptr<pod5::FileReader> const & reader)
     : batch(std::move(batch_))
+    , view(view_)
     , reader(reader)
     {
     }
 
     pod5::ReadTableRecordBatch batch;
+    pod5::LatestReadBatchView view;
     std::shared_ptr<pod5::FileReader> reader;
 };
 
+struct Pod5AsyncQueue {
+    struct Completion {
+        void * user_data;
+        pod5_async_operation_t operation;
+        arrow::Status status;
+        std::unique_ptr<Pod5FileReader> reader;
+        std::unique_ptr<Pod5ReadRecordBatch> batch;
+    };
+
+    struct PendingOperation {
+        pod5_async_operation_t operation;
+        void * user_data;
+        std::function<arrow::Status(Completion &)> work;
+    };
+
+    Pod5AsyncQueue(std::size_t worker_count_, int event_fd_)
+    : pool(pod5::shared_thread_pool())
+    , worker_count(worker_count_)
+    , event_fd(event_fd_)
+    {
+    }
+
+    ~Pod5AsyncQueue()
+    {
+        // Running operations refer to the queue, so wait for every submitted operation to finish:
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            workers_idle.wait(lock, [&] { return running_workers == 0; });
+        }
+#ifdef __linux__
+        if (event_fd >= 0) {
+            close(event_fd);
+        }
+#endif
+    }
+
+    /// Run [work] on the pool, queueing its completion once it finishes.
+    void submit(
+        pod5_async_operation_t operation,
+        void * user_data,
+        std::function<arrow::Status(Completion &)> work)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.push_back({operation, user_data, std::move(work)});
+        if (running_workers < worker_count) {
+            running_workers += 1;
+            pool->create_strand()->post([this] { run_pending(); });
+        }
+    }
+
+    std::shared_ptr<pod5::ThreadPool> pool;
+    // The most operations of this queue run on the pool at once:
+    std::size_t const worker_count;
+    int event_fd;
+
+    std::mutex mutex;
+    std::condition_variable workers_idle;
+    std::size_t running_workers = 0;
+    std::deque<PendingOperation> pending;
+    std::deque<Completion> completions;
+    // Error strings of the completions last collected, kept alive for the caller:
+    std::vector<std::string> collected_error_strings;
+
+    /// Run pending operations on a pool thread until none remain.
+    void run_pending()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!pending.empty()) {
+            auto next = std::move(pending.front());
+            pending.pop_front();
+            lock.unlock();
+
+            Completion completion{next.user_data, next.operation, {}, nullptr, nullptr};
+            completion.status = next.work(completion);
+
+            lock.lock();
+            completions.push_back(std::move(completion));
+#ifdef __linux__
+            std::uint64_t const one = 1;
+            auto const written = write(event_fd, &one, sizeof(one));
+            (void)written;
+#endif
+        }
+        running_workers -= 1;
+        workers_idle.notify_all();
+    }
+};
+
 namespace {
 //---------------------------------------------------------------------------------------------------------------------
 pod5_error_t g_pod5_error_no;
@@ -170,6 +315,7 @@ pod5_error_t pod5_init()
 {
     pod5_reset_error();
     POD5_C_RETURN_NOT_OK(pod5::register_extension_types());
+    POD5_C_RETURN_NOT_OK(pod5::calibrate_signal_kernels().status());
     return POD5_OK;
 }
 
@@ -180,6 +326,26 @@ pod5_error_t pod5_terminate()
     return POD5_OK;
 }
 
+pod5_error_t pod5_get_signal_kernels(char * kernels, size_t * kernels_size)
+{
+    pod5_reset_error();
+
+    if (!check_output_pointer_not_null(kernels) || !check_output_pointer_not_null(kernels_size)) {
+        return g_pod5_error_no;
+    }
+
+    auto const description = pod5::format_signal_kernels(pod5::signal_kernels());
+    auto const input_buffer_len = *kernels_size;
+    *kernels_size = description.size() + 1;
+    if (description.size() >= input_buffer_len) {
+        return POD5_ERROR_STRING_NOT_LONG_ENOUGH;
+    }
+
+    std::copy(description.begin(), description.end(), kernels);
+    kernels[description.size()] = '\0';
+    return POD5_OK;
+}
+
 pod5_error_t pod5_get_error_no() { return g_pod5_error_no; }
 
 char const * pod5_get_error_string() { return g_pod5_error_string.c_str(); }
@@ -221,6 +387,119 @@ Pod5FileReader * pod5_open_file_options(char const * filename, Pod5ReaderOptions
     return reader.release();
 }
 
+namespace {
+/// Buffer wrapping caller owned memory, handed back to the caller once destroyed.
+class ReleasingBuffer : public arrow::Buffer {
+public:
+    ReleasingBuffer(
+        void const * data,
+        std::size_t size,
+        Pod5ReleaseBufferCallback_t release,
+        void * release_context)
+    : arrow::Buffer(static_cast<std::uint8_t const *>(data), size)
+    , m_release(release)
+    , m_release_context(release_context)
+    {
+    }
+
+    ~ReleasingBuffer()
+    {
+        if (m_release) {
+            m_release(data(), size(), m_release_context);
+        }
+    }
+
+private:
+    Pod5ReleaseBufferCallback_t m_release;
+    void * m_release_context;
+};
+}  // namespace
+
+Pod5FileReader * pod5_open_buffer(
+    void const * data,
+    size_t size,
+    Pod5ReleaseBufferCallback_t release,
+    void * release_context)
+{
+    pod5_reset_error();
+
+    auto buffer = std::make_shared<ReleasingBuffer>(data, size, release, release_context);
+    if (!check_not_null(data)) {
+        return nullptr;
+    }
+
+    auto internal_reader = pod5::open_file_reader(std::shared_ptr<arrow::Buffer>(buffer), {});
+    if (!internal_reader.ok()) {
+        pod5_set_error(internal_reader.status());
+        return nullptr;
+    }
+
+    auto reader = std::make_unique<Pod5FileReader>(std::move(*internal_reader));
+    return reader.release();
+}
+
+Pod5DecodedSignalCache * pod5_create_decoded_signal_cache(size_t capacity_bytes)
+{
+    pod5_reset_error();
+
+    auto cache = std::make_unique<Pod5DecodedSignalCache>(
+        std::make_shared<pod5::DecodedSignalCache>(capacity_bytes));
+    return cache.release();
+}
+
+pod5_error_t pod5_free_decoded_signal_cache(Pod5DecodedSignalCache * cache)
+{
+    pod5_reset_error();
+
+    std::unique_ptr<Pod5DecodedSignalCache> ptr{cache};
+    ptr.reset();
+    return POD5_OK;
+}
+
+pod5_error_t pod5_get_decoded_signal_cache_metrics(
+    Pod5DecodedSignalCache const * cache,
+    DecodedSignalCacheMetrics_t * metrics)
+{
+    pod5_reset_error();
+
+    if (!check_not_null(cache) || !check_output_pointer_not_null(metrics)) {
+        return g_pod5_error_no;
+    }
+
+    auto const internal_metrics = cache->cache->metrics();
+    metrics->hits = internal_metrics.hits;
+    metrics->misses = internal_metrics.misses;
+    metrics->insertions = internal_metrics.insertions;
+    metrics->rejections = internal_metrics.rejections;
+    metrics->evictions = internal_metrics.evictions;
+    metrics->entry_count = internal_metrics.entry_count;
+    metrics->byte_count = internal_metrics.byte_count;
+    return POD5_OK;
+}
+
+Pod5FileReader * pod5_open_file_with_signal_cache(
+    char const * filename,
+    Pod5ReaderOptions_t const * options,
+    Pod5DecodedSignalCache * cache)
+{
+    pod5_reset_error();
+
+    if (!check_string_not_empty(filename) || !check_not_null(cache)) {
+        return nullptr;
+    }
+
+    auto internal_options = make_internal_reader_options(options);
+    internal_options.set_decoded_signal_cache(cache->cache);
+    auto internal_reader = pod5::open_file_reader(filename, internal_options);
+    if (!internal_reader.ok()) {
+        pod5_set_error(internal_reader.status());
+        return nullptr;
+    }
+
+    auto reader = std::make_unique<Pod5FileReader>(std::move(*internal_reader));
+    return reader.release();
+}
+
 pod5_error_t pod5_close_and_free_reader(Pod5FileReader * file)
 {
     pod5_reset_error();
@@ -400,9 +679,10 @@ pod5_get_read_batch(Pod5ReadRecordBatch ** batch, Pod5FileReader * reader, size_
     }
 
     POD5_C_ASSIGN_OR_RAISE(auto internal_batch, reader->reader->read_read_record_batch(index));
+    POD5_C_ASSIGN_OR_RAISE(auto view, pod5::LatestReadBatchView::make(internal_batch));
 
     auto wrapped_batch =
-        std::make_unique<Pod5ReadRecordBatch>(std::move(internal_batch), reader->reader);
+        std::make_unique<Pod5ReadRecordBatch>(std::move(internal_batch), view, reader->reader);
 
     *batch = wrapped_batch.release();
     return POD5_OK;
@@ -462,43 +742,39 @@ pod5_error_t pod5_get_read_batch_row_info_data(
     if (struct_version == READ_BATCH_ROW_INFO_VERSION_3) {
         auto typed_row_data = static_cast<ReadBatchRowInfoV3 *>(row_data);
 
-        POD5_C_ASSIGN_OR_RAISE(auto cols, batch->batch.columns());
+        auto const & view = batch->view;
 
         // Inform the caller of the version of the input table.
-        *read_table_version = cols.table_version.as_int();
+        *read_table_version = view.version;
 
-        if (check_row_index_and_set_error(row, cols.read_id->length()) != POD5_OK) {
+        if (check_row_index_and_set_error(row, view.num_rows()) != POD5_OK) {
             return g_pod5_error_no;
         }
 
-        auto read_id_val = cols.read_id->Value(row);
+        auto const & read_id_val = view.read_id(row);
         std::copy(read_id_val.begin(), read_id_val.end(), typed_row_data->read_id);
 
-        typed_row_data->read_number = cols.read_number->Value(row);
-        typed_row_data->start_sample = cols.start_sample->Value(row);
-        typed_row_data->median_before = cols.median_before->Value(row);
-        typed_row_data->channel = cols.channel->Value(row);
-        typed_row_data->well = cols.well->Value(row);
-        auto pore_type_col = std::static_pointer_cast<arrow::Int16Array>(cols.pore_type->indices());
-        typed_row_data->pore_type = pore_type_col->Value(row);
-        typed_row_data->calibration_offset = cols.calibration_offset->Value(row);
-        typed_row_data->calibration_scale = cols.calibration_scale->Value(row);
-        auto end_reason_col =
-            std::static_pointer_cast<arrow::Int16Array>(cols.end_reason->indices());
-        typed_row_data->end_reason = end_reason_col->Value(row);
-        typed_row_data->end_reason_forced = cols.end_reason_forced->Value(row);
-        auto run_info_col = std::static_pointer_cast<arrow::Int16Array>(cols.run_info->indices());
-        typed_row_data->run_info = run_info_col->Value(row);
-        typed_row_data->num_minknow_events = cols.num_minknow_events->Value(row);
-        typed_row_data->tracked_scaling_scale = cols.tracked_scaling_scale->Value(row);
-        typed_row_data->tracked_scaling_shift = cols.tracked_scaling_shift->Value(row);
-        typed_row_data->predicted_scaling_scale = cols.predicted_scaling_scale->Value(row);
-        typed_row_data->predicted_scaling_shift = cols.predicted_scaling_shift->Value(row);
-        typed_row_data->num_reads_since_mux_change = cols.num_reads_since_mux_change->Value(row);
-        typed_row_data->time_since_mux_change = cols.time_since_mux_change->Value(row);
-
-        typed_row_data->signal_row_count = cols.signal->value_length(row);
-        typed_row_data->num_samples = cols.num_samples->Value(row);
+        typed_row_data->read_number = view.read_number(row);
+        typed_row_data->start_sample = view.start_sample(row);
+        typed_row_data->median_before = view.median_before(row);
+        typed_row_data->channel = view.channel(row);
+        typed_row_data->well = view.well(row);
+        typed_row_data->pore_type = view.pore_type(row);
+        typed_row_data->calibration_offset = view.calibration_offset(row);
+        typed_row_data->calibration_scale = view.calibration_scale(row);
+        typed_row_data->end_reason = view.end_reason(row);
+        typed_row_data->end_reason_forced = view.end_reason_forced(row);
+        typed_row_data->run_info = view.run_info(row);
+        typed_row_data->num_minknow_events = view.num_minknow_events(row);
+        typed_row_data->tracked_scaling_scale = view.tracked_scaling_scale(row);
+        typed_row_data->tracked_scaling_shift = view.tracked_scaling_shift(row);
+        typed_row_data->predicted_scaling_scale = view.predicted_scaling_scale(row);
+        typed_row_data->predicted_scaling_shift = view.predicted_scaling_shift(row);
+        typed_row_data->num_reads_since_mux_change = view.num_reads_since_mux_change(row);
+        typed_row_data->time_since_mux_change = view.time_since_mux_change(row);
+
+        typed_row_data->signal_row_count = view.signal_row_count(row);
+        typed_row_data->num_samples = view.num_samples(row);
     } else {
         pod5_set_error(
             arrow::Status::Invalid("Invalid struct version '", struct_version, "' passed"));
@@ -555,15 +831,13 @@ pod5_error_t pod5_get_calibration_extra_info(
         return g_pod5_error_no;
     }
 
-    POD5_C_ASSIGN_OR_RAISE(auto cols, batch->batch.columns());
-
-    if (check_row_index_and_set_error(row, cols.calibration_scale->length()) != POD5_OK) {
+    auto const & view = batch->view;
+    if (check_row_index_and_set_error(row, view.num_rows()) != POD5_OK) {
         return g_pod5_error_no;
     }
 
-    auto scale = cols.calibration_scale->Value(row);
-    auto const run_info_dict_index =
-        std::static_pointer_cast<arrow::Int16Array>(cols.run_info->indices())->Value(row);
+    auto scale = view.calibration_scale(row);
+    auto const run_info_dict_index = view.run_info(row);
 
     POD5_C_ASSIGN_OR_RAISE(
         auto const acquisition_id, batch->batch.get_run_info(run_info_dict_index));
@@ -575,6 +849,36 @@ pod5_error_t pod5_get_calibration_extra_info(
     return POD5_OK;
 }
 
+pod5_error_t pod5_get_read_signal_statistics(
+    Pod5ReadRecordBatch_t * batch,
+    size_t row,
+    SignalStatisticsData_t * signal_statistics)
+{
+    pod5_reset_error();
+
+    if (!check_not_null(batch) || !check_output_pointer_not_null(signal_statistics)) {
+        return g_pod5_error_no;
+    }
+
+    auto const & view = batch->view;
+    if (check_row_index_and_set_error(row, view.num_rows()) != POD5_OK) {
+        return g_pod5_error_no;
+    }
+
+    auto const statistics = view.signal_statistics(row);
+    if (!statistics) {
+        pod5_set_error(arrow::Status::KeyError("No signal statistics stored for read"));
+        return g_pod5_error_no;
+    }
+
+    signal_statistics->min = statistics->min;
+    signal_statistics->max = statistics->max;
+    signal_statistics->mean = statistics->mean;
+    signal_statistics->stdev = statistics->stdev;
+    signal_statistics->saturated_count = statistics->saturated_count;
+    return POD5_OK;
+}
+
 struct RunInfoDataCHelper : public RunInfoDictData {
     struct InternalMapHelper {
         std::vector<char const *> keys;
@@ -862,16 +1166,43 @@ pod5_error_t pod5_get_read_complete_sample_count(
 {
     pod5_reset_error();
 
-    if (!check_not_null(reader) || !check_output_pointer_not_null(sample_count)) {
+    if (!check_not_null(reader) || !check_not_null(batch)
+        || !check_output_pointer_not_null(sample_count))
+    {
         return g_pod5_error_no;
     }
 
-    POD5_C_ASSIGN_OR_RAISE(auto const & signal_rows, batch->batch.get_signal_rows(batch_row));
+    auto const & view = batch->view;
+    if (check_row_index_and_set_error(batch_row, view.num_rows()) != POD5_OK) {
+        return g_pod5_error_no;
+    }
+
+    // The read table records each read's length, so no signal needs to be loaded:
+    *sample_count = view.num_samples(batch_row);
+    return POD5_OK;
+}
+
+pod5_error_t pod5_get_read_complete_byte_count(
+    Pod5FileReader_t * reader,
+    Pod5ReadRecordBatch_t * batch,
+    size_t batch_row,
+    size_t * byte_count)
+{
+    pod5_reset_error();
+
+    if (!check_not_null(reader) || !check_not_null(batch)
+        || !check_output_pointer_not_null(byte_count))
+    {
+        return g_pod5_error_no;
+    }
+
+    auto const & view = batch->view;
+    if (check_row_index_and_set_error(batch_row, view.num_rows()) != POD5_OK) {
+        return g_pod5_error_no;
+    }
 
     POD5_C_ASSIGN_OR_RAISE(
-        *sample_count,
-        reader->reader->extract_sample_count(
-            gsl::make_span(signal_rows->raw_values(), signal_rows->length())));
+        *byte_count, reader->reader->extract_samples_byte_count(view.signal_rows(batch_row)));
     return POD5_OK;
 }
 
@@ -896,6 +1227,229 @@ pod5_error_t pod5_get_read_complete_signal(
     return POD5_OK;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+Pod5AsyncQueue * pod5_create_async_queue(size_t worker_count)
+{
+    pod5_reset_error();
+
+    if (worker_count == 0) {
+        worker_count = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    }
+
+    int event_fd = -1;
+#ifdef __linux__
+    // The eventfd stays readable while completions are waiting, it is reset as they are collected:
+    event_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (event_fd < 0) {
+        pod5_set_error(arrow::Status::IOError(
+            "Failed to create async queue eventfd: ", std::strerror(errno)));
+        return nullptr;
+    }
+#endif
+
+    auto queue = std::make_unique<Pod5AsyncQueue>(worker_count, event_fd);
+    return queue.release();
+}
+
+pod5_error_t pod5_free_async_queue(Pod5AsyncQueue * queue)
+{
+    pod5_reset_error();
+
+    std::unique_ptr<Pod5AsyncQueue> ptr{queue};
+    ptr.reset();
+    return POD5_OK;
+}
+
+pod5_error_t pod5_get_async_queue_fd(Pod5AsyncQueue * queue, int * fd)
+{
+    pod5_reset_error();
+
+    if (!check_not_null(queue) || !check_output_pointer_not_null(fd)) {
+        return g_pod5_error_no;
+    }
+
+    if (queue->event_fd < 0) {
+        pod5_set_error(
+            arrow::Status::NotImplemented("Async queue descriptors are only supported on Linux"));
+        return g_pod5_error_no;
+    }
+
+    *fd = queue->event_fd;
+    return POD5_OK;
+}
+
+pod5_error_t pod5_get_async_completions(
+    Pod5AsyncQueue * queue,
+    Pod5AsyncCompletion * completions,
+    size_t completions_size,
+    size_t * count)
+{
+    pod5_reset_error();
+
+    if (!check_not_null(queue) || !check_output_pointer_not_null(completions)
+        || !check_output_pointer_not_null(count))
+    {
+        return g_pod5_error_no;
+    }
+
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    auto const collect_count = std::min(completions_size, queue->completions.size());
+    queue->collected_error_strings.assign(collect_count, std::string{});
+    for (std::size_t i = 0; i < collect_count; ++i) {
+        auto & completion = queue->completions.front();
+        auto & output = completions[i];
+        output.user_data = completion.user_data;
+        output.operation = completion.operation;
+        output.error_no = (pod5_error_t)completion.status.code();
+        if (!completion.status.ok()) {
+            queue->collected_error_strings[i] = completion.status.ToString();
+        }
+        output.error_string = queue->collected_error_strings[i].c_str();
+        output.reader = completion.reader.release();
+        output.batch = completion.batch.release();
+        queue->completions.pop_front();
+    }
+    *count = collect_count;
+
+#ifdef __linux__
+    // Completions are queued holding the lock, so the eventfd can be reset once the queue is empty:
+    if (queue->completions.empty()) {
+        std::uint64_t value = 0;
+        auto const read_size = read(queue->event_fd, &value, sizeof(value));
+        (void)read_size;
+    }
+#endif
+    return POD5_OK;
+}
+
+pod5_error_t pod5_async_open_file(
+    Pod5AsyncQueue * queue,
+    char const * filename,
+    Pod5ReaderOptions_t const * options,
+    void * user_data)
+{
+    pod5_reset_error();
+
+    if (!check_not_null(queue) || !check_string_not_empty(filename)) {
+        return g_pod5_error_no;
+    }
+
+    queue->submit(
+        POD5_ASYNC_OPEN_FILE,
+        user_data,
+        [filename = std::string(filename),
+         internal_options = make_internal_reader_options(options)](
+            Pod5AsyncQueue::Completion & completion) -> arrow::Status {
+            ARROW_ASSIGN_OR_RAISE(auto reader, pod5::open_file_reader(filename, internal_options));
+            completion.reader = std::make_unique<Pod5FileReader>(std::move(reader));
+            return arrow::Status::OK();
+        });
+    return POD5_OK;
+}
+
+pod5_error_t pod5_async_plan_traversal(
+    Pod5AsyncQueue * queue,
+    Pod5FileReader_t * reader,
+    uint8_t const * read_id_array,
+    size_t read_id_count,
+    uint32_t * batch_counts,
+    uint32_t * batch_rows,
+    size_t * find_success_count_out,
+    void * user_data)
+{
+    pod5_reset_error();
+
+    if (!check_not_null(queue) || !check_file_not_null(reader) || !check_not_null(read_id_array)
+        || !check_output_pointer_not_null(batch_counts)
+        || !check_output_pointer_not_null(batch_rows))
+    {
+        return g_pod5_error_no;
+    }
+
+    queue->submit(
+        POD5_ASYNC_PLAN_TRAVERSAL,
+        user_data,
+        [reader = reader->reader,
+         read_ids = gsl::make_span(
+             reinterpret_cast<boost::uuids::uuid const *>(read_id_array), read_id_count),
+         batch_counts,
+         batch_rows,
+         find_success_count_out](Pod5AsyncQueue::Completion &) -> arrow::Status {
+            ARROW_ASSIGN_OR_RAISE(
+                auto find_success_count,
+                reader->search_for_read_ids(
+                    pod5::ReadIdSearchInput(read_ids),
+                    gsl::make_span(batch_counts, reader->num_read_record_batches()),
+                    gsl::make_span(batch_rows, read_ids.size())));
+            if (find_success_count_out) {
+                *find_success_count_out = find_success_count;
+            }
+            return arrow::Status::OK();
+        });
+    return POD5_OK;
+}
+
+pod5_error_t pod5_async_get_read_batch(
+    Pod5AsyncQueue * queue,
+    Pod5FileReader_t * reader,
+    size_t index,
+    void * user_data)
+{
+    pod5_reset_error();
+
+    if (!check_not_null(queue) || !check_file_not_null(reader)) {
+        return g_pod5_error_no;
+    }
+
+    queue->submit(
+        POD5_ASYNC_GET_READ_BATCH,
+        user_data,
+        [reader = reader->reader, index](Pod5AsyncQueue::Completion & completion) -> arrow::Status {
+            ARROW_ASSIGN_OR_RAISE(auto batch, reader->read_read_record_batch(index));
+            ARROW_ASSIGN_OR_RAISE(auto view, pod5::LatestReadBatchView::make(batch));
+            completion.batch =
+                std::make_unique<Pod5ReadRecordBatch>(std::move(batch), view, reader);
+            return arrow::Status::OK();
+        });
+    return POD5_OK;
+}
+
+pod5_error_t pod5_async_get_read_complete_signal(
+    Pod5AsyncQueue * queue,
+    Pod5FileReader_t * reader,
+    Pod5ReadRecordBatch_t * batch,
+    size_t batch_row,
+    size_t sample_count,
+    int16_t * signal,
+    void * user_data)
+{
+    pod5_reset_error();
+
+    if (!check_not_null(queue) || !check_file_not_null(reader) || !check_not_null(batch)
+        || !check_output_pointer_not_null(signal))
+    {
+        return g_pod5_error_no;
+    }
+
+    if (check_row_index_and_set_error(batch_row, batch->view.num_rows()) != POD5_OK) {
+        return g_pod5_error_no;
+    }
+
+    // Find the signal rows now, so the batch can be freed while the signal is decoded:
+    POD5_C_ASSIGN_OR_RAISE(auto signal_rows, batch->batch.get_signal_rows(batch_row));
+
+    queue->submit(
+        POD5_ASYNC_GET_READ_COMPLETE_SIGNAL,
+        user_data,
+        [reader = reader->reader, signal_rows, sample_count, signal](
+            Pod5AsyncQueue::Completion &) -> arrow::Status {
+            return reader->extract_samples(
+                gsl::make_span(signal_rows->raw_values(), signal_rows->length()),
+                gsl::make_span(signal, sample_count));
+        });
+    return POD5_OK;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 Pod5FileWriter *
 pod5_create_file(char const * filename, char const * writer_name, Pod5WriterOptions const * options)
@@ -1285,6 +1839,31 @@ pod5_error_t pod5_vbz_decompress_signal(
     return POD5_OK;
 }
 
+pod5_error_t pod5_vbz_decompress_file_signal(
+    Pod5FileReader_t * reader,
+    char const * compressed_signal,
+    size_t compressed_signal_size,
+    size_t sample_count,
+    short * signal_out)
+{
+    pod5_reset_error();
+
+    if (!check_file_not_null(reader) || !check_not_null(compressed_signal)
+        || !check_output_pointer_not_null(signal_out))
+    {
+        return g_pod5_error_no;
+    }
+
+    auto const in_span =
+        gsl::make_span(compressed_signal, compressed_signal_size).as_span<std::uint8_t const>();
+    auto out_span = gsl::make_span(signal_out, sample_count);
+    auto const dictionary = reader->reader->signal_dictionary();
+    POD5_C_RETURN_NOT_OK(pod5::decompress_signal(
+        in_span, arrow::system_memory_pool(), out_span, dictionary.get()));
+
+    return POD5_OK;
+}
+
 pod5_error_t pod5_format_read_id(read_id_t const read_id, char * read_id_string)
 {
     pod5_reset_error();
@@ -1294,15 +1873,189 @@ pod5_error_t pod5_format_read_id(read_id_t const read_id, char * read_id_string)
     }
 
     auto uuid_data = reinterpret_cast<boost::uuids::uuid const *>(read_id);
-    std::string string_data = boost::uuids::to_string(*uuid_data);
-    if (string_data.size() != 36) {
-        pod5_set_error(pod5::Status::Invalid("Unexpected length of UUID"));
+    pod5::format_read_id(*uuid_data, read_id_string);
+    read_id_string[pod5::READ_ID_STRING_LENGTH] = '\0';
+
+    return POD5_OK;
+}
+
+pod5_error_t
+pod5_format_read_ids(read_id_t const * read_ids, size_t count, char * read_id_strings)
+{
+    pod5_reset_error();
+
+    if (!check_not_null(read_ids) || !check_output_pointer_not_null(read_id_strings)) {
         return g_pod5_error_no;
     }
 
-    std::copy(string_data.begin(), string_data.end(), read_id_string);
-    read_id_string[string_data.size()] = '\0';
+    auto const stride = pod5::READ_ID_STRING_LENGTH + 1;
+    auto const uuid_data = reinterpret_cast<boost::uuids::uuid const *>(read_ids);
+    POD5_C_RETURN_NOT_OK(pod5::format_read_ids(
+        gsl::make_span(uuid_data, count), gsl::make_span(read_id_strings, count * stride), stride));
+
+    return POD5_OK;
+}
+
+pod5_error_t pod5_parse_read_ids(
+    char const * read_id_strings,
+    size_t count,
+    size_t stride,
+    read_id_t * read_ids)
+{
+    pod5_reset_error();
+
+    if (!check_not_null(read_id_strings) || !check_output_pointer_not_null(read_ids)) {
+        return g_pod5_error_no;
+    }
+
+    auto const uuid_data = reinterpret_cast<boost::uuids::uuid *>(read_ids);
+    std::vector<std::uint8_t> valid(count);
+    POD5_C_ASSIGN_OR_RAISE(
+        auto const valid_count,
+        pod5::parse_read_ids(
+            gsl::make_span(read_id_strings, count * stride),
+            stride,
+            gsl::make_span(uuid_data, count),
+            gsl::make_span(valid)));
+    if (valid_count != count) {
+        auto const first_invalid = std::find(valid.begin(), valid.end(), 0) - valid.begin();
+        pod5_set_error(pod5::Status::Invalid(
+            count - valid_count,
+            " read id strings are invalid, the first at index ",
+            first_invalid));
+        return g_pod5_error_no;
+    }
+
+    return POD5_OK;
+}
+
+Pod5SignalClient * pod5_signal_client_connect(char const * socket_path)
+{
+    pod5_reset_error();
+
+    if (!check_string_not_empty(socket_path)) {
+        return nullptr;
+    }
+
+    auto internal_client = pod5::SignalClient::connect(socket_path);
+    if (!internal_client.ok()) {
+        pod5_set_error(internal_client.status());
+        return nullptr;
+    }
+
+    auto client = std::make_unique<Pod5SignalClient>(std::move(*internal_client));
+    return client.release();
+}
 
+pod5_error_t pod5_signal_client_disconnect(Pod5SignalClient * client)
+{
+    pod5_reset_error();
+
+    std::unique_ptr<Pod5SignalClient> ptr{client};
+    ptr.reset();
+    return POD5_OK;
+}
+
+pod5_error_t pod5_signal_client_open_file(
+    Pod5SignalClient * client,
+    char const * filename,
+    uint32_t * file,
+    size_t * read_count)
+{
+    pod5_reset_error();
+
+    if (!check_not_null(client) || !check_string_not_empty(filename)
+        || !check_output_pointer_not_null(file))
+    {
+        return g_pod5_error_no;
+    }
+
+    POD5_C_ASSIGN_OR_RAISE(auto const opened_file, client->client->open_file(filename));
+    *file = opened_file.file;
+    if (read_count) {
+        *read_count = opened_file.read_count;
+    }
+    return POD5_OK;
+}
+
+pod5_error_t pod5_signal_client_close_file(Pod5SignalClient * client, uint32_t file)
+{
+    pod5_reset_error();
+
+    if (!check_not_null(client)) {
+        return g_pod5_error_no;
+    }
+
+    POD5_C_RETURN_NOT_OK(client->client->close_file(file));
+    return POD5_OK;
+}
+
+pod5_error_t pod5_signal_client_get_reads(
+    Pod5SignalClient * client,
+    uint32_t file,
+    read_id_t const * read_ids,
+    size_t read_id_count,
+    int with_signal,
+    Pod5SignalServerReads ** reads)
+{
+    pod5_reset_error();
+
+    if (!check_not_null(client) || !check_output_pointer_not_null(reads)) {
+        return g_pod5_error_no;
+    }
+    if (read_id_count > 0 && !check_not_null(read_ids)) {
+        return g_pod5_error_no;
+    }
+
+    POD5_C_ASSIGN_OR_RAISE(
+        auto internal_reads,
+        client->client->get_reads(
+            file,
+            gsl::make_span(
+                reinterpret_cast<boost::uuids::uuid const *>(read_ids),
+                read_ids ? read_id_count : 0),
+            with_signal != 0));
+
+    auto wrapped_reads = std::make_unique<Pod5SignalServerReads>(std::move(internal_reads));
+    *reads = wrapped_reads.release();
+    return POD5_OK;
+}
+
+pod5_error_t pod5_get_signal_server_reads(
+    Pod5SignalServerReads const * reads,
+    SignalServerRead_t const ** read_data,
+    size_t * read_count,
+    int16_t const ** samples,
+    size_t * sample_count)
+{
+    pod5_reset_error();
+
+    if (!check_not_null(reads) || !check_output_pointer_not_null(read_data)
+        || !check_output_pointer_not_null(read_count))
+    {
+        return g_pod5_error_no;
+    }
+
+    auto const internal_reads = reads->reads->reads();
+    *read_data = reinterpret_cast<SignalServerRead_t const *>(internal_reads.data());
+    *read_count = internal_reads.size();
+
+    auto const internal_samples = reads->reads->samples();
+    if (samples) {
+        *samples = internal_samples.empty() ? nullptr : internal_samples.data();
+    }
+    if (sample_count) {
+        *sample_count = internal_samples.size();
+    }
+    return POD5_OK;
+}
+
+pod5_error_t pod5_free_signal_server_reads(Pod5SignalServerReads * reads)
+{
+    pod5_reset_error();
+
+    std::unique_ptr<Pod5SignalServerReads> ptr{reads};
+    ptr.reset();
     return POD5_OK;
 }
 }
@@ -21,6 +21,14 @@ struct Pod5FileWriter;
 typedef struct Pod5FileWriter Pod5FileWriter_t;
 struct Pod5ReadRecordBatch;
 typedef struct Pod5ReadRecordBatch Pod5ReadRecordBatch_t;
+struct Pod5DecodedSignalCache;
+typedef struct Pod5DecodedSignalCache Pod5DecodedSignalCache_t;
+struct Pod5SignalClient;
+typedef struct Pod5SignalClient Pod5SignalClient_t;
+struct Pod5SignalServerReads;
+typedef struct Pod5SignalServerReads Pod5SignalServerReads_t;
+struct Pod5AsyncQueue;
+typedef struct Pod5AsyncQueue Pod5AsyncQueue_t;
 
 //---------------------------------------------------------------------------------------------------------------------
 // Error management
@@ -56,10 +64,21 @@ POD5_FORMAT_EXPORT char const * pod5_get_error_string();
 //---------------------------------------------------------------------------------------------------------------------
 
 /// \brief Initialise and register global pod5 types
+/// \note The first call also times the signal compression kernels available on this cpu (taking a
+///       few milliseconds) to pick the fastest, unless overridden by the POD5_SIGNAL_KERNELS
+///       environment variable. An invalid variable gives POD5_ERROR_INVALID, pod5 is still usable.
 POD5_FORMAT_EXPORT pod5_error_t pod5_init();
 /// \brief Terminate global pod5 types
 POD5_FORMAT_EXPORT pod5_error_t pod5_terminate();
 
+/// \brief Describe the signal compression kernels in use,
+///        eg. "svb16_decode=sse4.1,svb16_encode=ssse3,zstd_decompress=one_shot".
+/// \param[out] kernels            Output location for the description.
+/// \param[in, out] kernels_size   The size of the [kernels] buffer, set to the size needed.
+/// \note Setting POD5_SIGNAL_KERNELS to the description reproduces the choice in another process.
+///       If the string input is not long enough POD5_ERROR_STRING_NOT_LONG_ENOUGH is returned.
+POD5_FORMAT_EXPORT pod5_error_t pod5_get_signal_kernels(char * kernels, size_t * kernels_size);
+
 //---------------------------------------------------------------------------------------------------------------------
 // Shared Structures
 //---------------------------------------------------------------------------------------------------------------------
@@ -217,6 +236,66 @@ POD5_FORMAT_EXPORT Pod5FileReader_t * pod5_open_file_options(
     char const * filename,
     Pod5ReaderOptions_t const * options);
 
+/// \brief Called once the library has finished with memory passed to pod5_open_buffer.
+/// \param data             The data passed to pod5_open_buffer.
+/// \param size             The size passed to pod5_open_buffer.
+/// \param context          The release context passed to pod5_open_buffer.
+typedef void (*Pod5ReleaseBufferCallback_t)(void const * data, size_t size, void * context);
+
+/// \brief Open a file reader on a pod5 file held in memory, reading it in place.
+/// \param data             The contents of the pod5 file.
+/// \param size             The size of [data] in bytes.
+/// \param release          Called with [data] once the reader, and all batches read from it, are
+///                         closed. Also called if opening the file fails. May be null.
+/// \param release_context  Passed to [release].
+/// \note [data] must stay valid and unchanged until released.
+POD5_FORMAT_EXPORT Pod5FileReader_t * pod5_open_buffer(
+    void const * data,
+    size_t size,
+    Pod5ReleaseBufferCallback_t release,
+    void * release_context);
+
+/// \brief Create a cache of decoded reads, which readers opened with it consult when fetching
+///        signal so reads fetched repeatedly are only decompressed once.
+/// \param capacity_bytes   The most bytes of decoded samples to hold, across all readers.
+/// \note The cache can be freed while readers using it are still open.
+POD5_FORMAT_EXPORT Pod5DecodedSignalCache_t * pod5_create_decoded_signal_cache(
+    size_t capacity_bytes);
+
+/// \brief Release a decoded signal cache.
+POD5_FORMAT_EXPORT pod5_error_t
+pod5_free_decoded_signal_cache(Pod5DecodedSignalCache_t * cache);
+
+struct DecodedSignalCacheMetrics {
+    uint64_t hits;
+    uint64_t misses;
+    // Reads added to the cache.
+    uint64_t insertions;
+    // Reads refused by the cache, as less used than those they would have evicted.
+    uint64_t rejections;
+    uint64_t evictions;
+    size_t entry_count;
+    // Bytes of decoded samples held.
+    size_t byte_count;
+};
+typedef struct DecodedSignalCacheMetrics DecodedSignalCacheMetrics_t;
+
+/// \brief Find the activity of a decoded signal cache.
+/// \param      cache       The cache to query.
+/// \param[out] metrics     The cache's counts of hits, misses, insertions etc.
+POD5_FORMAT_EXPORT pod5_error_t pod5_get_decoded_signal_cache_metrics(
+    Pod5DecodedSignalCache_t const * cache,
+    DecodedSignalCacheMetrics_t * metrics);
+
+/// \brief Open a file reader which caches decoded reads in [cache].
+/// \param filename         The filename of the pod5 file.
+/// \param options          The options to use when opening the file, or null for the defaults.
+/// \param cache            The cache pod5_get_read_complete_signal consults.
+POD5_FORMAT_EXPORT Pod5FileReader_t * pod5_open_file_with_signal_cache(
+    char const * filename,
+    Pod5ReaderOptions_t const * options,
+    Pod5DecodedSignalCache_t * cache);
+
 /// \brief Close a file reader, releasing all memory held by the reader.
 POD5_FORMAT_EXPORT pod5_error_t pod5_close_and_free_reader(Pod5FileReader_t * file);
 
@@ -368,6 +447,29 @@ POD5_FORMAT_EXPORT pod5_error_t pod5_get_calibration_extra_info(
     size_t row,
     CalibrationExtraData_t * calibration_extra_data);
 
+struct SignalStatisticsData {
+    // Minimum and maximum sample values, in ADC units.
+    int16_t min;
+    int16_t max;
+    // Mean and standard deviation of the samples, in ADC units.
+    float mean;
+    float stdev;
+    // Number of samples at or beyond the digitiser limits of the read's run.
+    uint64_t saturated_count;
+};
+typedef struct SignalStatisticsData SignalStatisticsData_t;
+
+/// \brief Find the signal statistics stored for a row in a read batch.
+/// \param      batch                   The read batch to query.
+/// \param      row                     The read row index.
+/// \param[out] signal_statistics       Output location for the statistics.
+/// \note Statistics are optional, if the file (or the read) has none POD5_ERROR_KEYERROR is returned.
+///       Reading the statistics does not touch the signal table.
+POD5_FORMAT_EXPORT pod5_error_t pod5_get_read_signal_statistics(
+    Pod5ReadRecordBatch_t * batch,
+    size_t row,
+    SignalStatisticsData_t * signal_statistics);
+
 struct KeyValueData {
     size_t size;
     char const ** keys;
@@ -508,6 +610,18 @@ POD5_FORMAT_EXPORT pod5_error_t pod5_get_read_complete_sample_count(
     size_t batch_row,
     size_t * sample_count);
 
+/// \brief Find the number of bytes stored in the file for a full read's signal.
+/// \param      reader          The reader to query.
+/// \param      batch           The read batch to query.
+/// \param      batch_row       The read row to query data for.
+/// \param[out] byte_count      The stored (compressed) size of the read - including all chunks of raw data.
+/// \note Only the sample count and size of each signal row are read, the signal itself is not.
+POD5_FORMAT_EXPORT pod5_error_t pod5_get_read_complete_byte_count(
+    Pod5FileReader_t * reader,
+    Pod5ReadRecordBatch_t * batch,
+    size_t batch_row,
+    size_t * byte_count);
+
 /// \brief Find the signal for a full read.
 /// \param      reader          The reader to query.
 /// \param      batch           The read batch to query.
@@ -522,6 +636,108 @@ POD5_FORMAT_EXPORT pod5_error_t pod5_get_read_complete_signal(
     size_t sample_count,
     int16_t * signal);
 
+//---------------------------------------------------------------------------------------------------------------------
+// Asynchronous reading
+//---------------------------------------------------------------------------------------------------------------------
+
+// Operations run by an async queue.
+enum pod5_async_operation {
+    POD5_ASYNC_OPEN_FILE = 0,
+    POD5_ASYNC_PLAN_TRAVERSAL = 1,
+    POD5_ASYNC_GET_READ_BATCH = 2,
+    POD5_ASYNC_GET_READ_COMPLETE_SIGNAL = 3,
+};
+typedef enum pod5_async_operation pod5_async_operation_t;
+
+// The result of an operation submitted to an async queue.
+struct Pod5AsyncCompletion {
+    // The user data passed when the operation was submitted.
+    void * user_data;
+    pod5_async_operation_t operation;
+    // The result of the operation, as pod5_get_error_no would return it for the blocking call.
+    pod5_error_t error_no;
+    // The error message, valid until the next call to pod5_get_async_completions on the queue.
+    char const * error_string;
+    // The reader opened by POD5_ASYNC_OPEN_FILE, to be closed with #pod5_close_and_free_reader.
+    Pod5FileReader_t * reader;
+    // The batch read by POD5_ASYNC_GET_READ_BATCH, to be freed with #pod5_free_read_batch.
+    Pod5ReadRecordBatch_t * batch;
+};
+typedef struct Pod5AsyncCompletion Pod5AsyncCompletion_t;
+
+/// \brief Create a queue running reads on the library's shared pool of worker threads.
+/// \param worker_count     The most operations of the queue to run at once, 0 for one per hardware thread.
+/// \note Operations are submitted with the pod5_async_* functions, which return once the
+///       operation is queued. Results are collected with #pod5_get_async_completions, the
+///       descriptor from #pod5_get_async_queue_fd becomes readable while completions are waiting,
+///       so a queue can be polled from an event loop alongside other descriptors.
+POD5_FORMAT_EXPORT Pod5AsyncQueue_t * pod5_create_async_queue(size_t worker_count);
+
+/// \brief Free a queue, waiting for submitted operations to finish.
+/// \note Readers and batches from completions that have not been collected are freed.
+POD5_FORMAT_EXPORT pod5_error_t pod5_free_async_queue(Pod5AsyncQueue_t * queue);
+
+/// \brief Find the descriptor that is readable while a queue has completions waiting.
+/// \param[out] fd  An eventfd owned by the queue. Wait for it to become readable with poll, epoll
+///                 or select, then call #pod5_get_async_completions - do not read from it.
+/// \note Only supported on Linux, elsewhere call #pod5_get_async_completions periodically.
+POD5_FORMAT_EXPORT pod5_error_t pod5_get_async_queue_fd(Pod5AsyncQueue_t * queue, int * fd);
+
+/// \brief Collect the results of finished operations, without blocking.
+/// \param      queue               The queue to collect completions from.
+/// \param[out] completions         The completions collected, in the order the operations finished.
+/// \param      completions_size    The number of completions allocated in [completions].
+/// \param[out] count               The number of completions written to [completions].
+POD5_FORMAT_EXPORT pod5_error_t pod5_get_async_completions(
+    Pod5AsyncQueue_t * queue,
+    Pod5AsyncCompletion_t * completions,
+    size_t completions_size,
+    size_t * count);
+
+/// \brief Open a file reader on a queue, see #pod5_open_file_options.
+/// \param options      The options to use when opening the file, or null for the defaults.
+/// \param user_data    Passed back in the operation's completion.
+POD5_FORMAT_EXPORT pod5_error_t pod5_async_open_file(
+    Pod5AsyncQueue_t * queue,
+    char const * filename,
+    Pod5ReaderOptions_t const * options,
+    void * user_data);
+
+/// \brief Plan a traversal of the given read ids on a queue, see #pod5_plan_traversal.
+/// \param user_data    Passed back in the operation's completion.
+/// \note [read_id_array] and the outputs must stay valid until the operation completes.
+POD5_FORMAT_EXPORT pod5_error_t pod5_async_plan_traversal(
+    Pod5AsyncQueue_t * queue,
+    Pod5FileReader_t * reader,
+    uint8_t const * read_id_array,
+    size_t read_id_count,
+    uint32_t * batch_counts,
+    uint32_t * batch_rows,
+    size_t * find_success_count,
+    void * user_data);
+
+/// \brief Read a read batch on a queue, see #pod5_get_read_batch.
+/// \param user_data    Passed back in the operation's completion, along with the batch.
+/// \note [reader] must stay open until the operation completes.
+POD5_FORMAT_EXPORT pod5_error_t pod5_async_get_read_batch(
+    Pod5AsyncQueue_t * queue,
+    Pod5FileReader_t * reader,
+    size_t index,
+    void * user_data);
+
+/// \brief Decode the signal for a full read on a queue, see #pod5_get_read_complete_signal.
+/// \param user_data    Passed back in the operation's completion.
+/// \note [reader] must stay open, and [signal] valid, until the operation completes. [batch] may
+///       be freed once this returns.
+POD5_FORMAT_EXPORT pod5_error_t pod5_async_get_read_complete_signal(
+    Pod5AsyncQueue_t * queue,
+    Pod5FileReader_t * reader,
+    Pod5ReadRecordBatch_t * batch,
+    size_t batch_row,
+    size_t sample_count,
+    int16_t * signal,
+    void * user_data);
+
 //---------------------------------------------------------------------------------------------------------------------
 // Writing files
 //---------------------------------------------------------------------------------------------------------------------
@@ -703,6 +919,8 @@ POD5_FORMAT_EXPORT pod5_error_t pod5_vbz_compress_signal(
     size_t * compressed_signal_size);
 
 /// \brief VBZ decompress an array of samples.
+/// \note Fails for signal compressed with a file's signal dictionary, use [pod5_vbz_decompress_file_signal] for signal
+///       read from a file.
 /// \param          compressed_signal           The signal to compress.
 /// \param          compressed_signal_size      The number of compressed bytes, should be set to the size of compressed_signal_out on call.
 /// \param          sample_count                The number of samples to decompress.
@@ -713,6 +931,19 @@ POD5_FORMAT_EXPORT pod5_error_t pod5_vbz_decompress_signal(
     size_t sample_count,
     short * signal_out);
 
+/// \brief VBZ decompress an array of samples read from [reader]'s file, using the file's signal dictionary if it has one.
+/// \param          reader                      The file the signal was read from.
+/// \param          compressed_signal           The signal to decompress.
+/// \param          compressed_signal_size      The number of compressed bytes.
+/// \param          sample_count                The number of samples to decompress.
+/// \param[out]     signal_out                  The decompressed signal, of [sample_count] samples.
+POD5_FORMAT_EXPORT pod5_error_t pod5_vbz_decompress_file_signal(
+    Pod5FileReader_t * reader,
+    char const * compressed_signal,
+    size_t compressed_signal_size,
+    size_t sample_count,
+    short * signal_out);
+
 //---------------------------------------------------------------------------------------------------------------------
 // Global state
 //---------------------------------------------------------------------------------------------------------------------
@@ -722,6 +953,111 @@ POD5_FORMAT_EXPORT pod5_error_t pod5_vbz_decompress_signal(
 /// \param[out]     read_id_string    Output string containing the string formatted UUID (expects a string of at least 37 bytes, one null byte is written.)
 POD5_FORMAT_EXPORT pod5_error_t pod5_format_read_id(read_id_t const read_id, char * read_id_string);
 
+/// \brief Format an array of packed binary read ids as readable read id strings.
+/// \param          read_ids          The 16 byte binary formatted UUIDs to format.
+/// \param          count             The number of read ids to format.
+/// \param[out]     read_id_strings   Output buffer of count * 37 bytes, each read id is written as 36 characters followed by a null byte.
+POD5_FORMAT_EXPORT pod5_error_t
+pod5_format_read_ids(read_id_t const * read_ids, size_t count, char * read_id_strings);
+
+/// \brief Parse an array of read id strings into packed binary read ids.
+/// \param          read_id_strings   Buffer of count * stride bytes holding one read id string every stride bytes, each ending at its first null byte or after stride bytes.
+/// \param          count             The number of read ids to parse.
+/// \param          stride            The number of bytes between the start of each read id string, eg. 37 for the output of pod5_format_read_ids.
+/// \param[out]     read_ids          Output array of count read ids.
+/// \note Read ids must be in the 36 character form with dashes, in upper or lower case.
+/// \note If any string is not a read id, POD5_ERROR_INVALID is returned, naming the first invalid index.
+POD5_FORMAT_EXPORT pod5_error_t pod5_parse_read_ids(
+    char const * read_id_strings,
+    size_t count,
+    size_t stride,
+    read_id_t * read_ids);
+
+//---------------------------------------------------------------------------------------------------------------------
+// Signal server client
+//---------------------------------------------------------------------------------------------------------------------
+
+/// \brief Connect to a pod5d signal server, which serves reads from files it keeps open.
+/// \param socket_path      The path of the server's Unix domain socket.
+/// \note Only supported on Linux. A client sends one request at a time.
+POD5_FORMAT_EXPORT Pod5SignalClient_t * pod5_signal_client_connect(char const * socket_path);
+
+/// \brief Disconnect from a signal server, closing any files the client has open.
+POD5_FORMAT_EXPORT pod5_error_t pod5_signal_client_disconnect(Pod5SignalClient_t * client);
+
+/// \brief Open a file on a signal server.
+/// \param      client      The client to open the file with.
+/// \param      filename    The path of the file, resolved by the server.
+/// \param[out] file        The handle to pass to later calls for the file.
+/// \param[out] read_count  The number of reads in the file.
+POD5_FORMAT_EXPORT pod5_error_t pod5_signal_client_open_file(
+    Pod5SignalClient_t * client,
+    char const * filename,
+    uint32_t * file,
+    size_t * read_count);
+
+/// \brief Close a file opened with pod5_signal_client_open_file.
+POD5_FORMAT_EXPORT pod5_error_t
+pod5_signal_client_close_file(Pod5SignalClient_t * client, uint32_t file);
+
+/// \brief A read's metadata, as served by a signal server.
+struct SignalServerRead {
+    read_id_t read_id;
+    uint64_t start_sample;
+    uint64_t num_samples;
+    uint64_t num_minknow_events;
+    // Offset of the read's first sample in the samples returned with it, if signal was requested.
+    uint64_t sample_offset;
+    uint32_t read_number;
+    uint16_t channel;
+    uint8_t well;
+    uint8_t padding_0;
+    float median_before;
+    float calibration_offset;
+    float calibration_scale;
+    float tracked_scaling_scale;
+    float tracked_scaling_shift;
+    float predicted_scaling_scale;
+    float predicted_scaling_shift;
+    uint32_t num_reads_since_mux_change;
+    float time_since_mux_change;
+    uint32_t padding_1;
+};
+typedef struct SignalServerRead SignalServerRead_t;
+
+/// \brief Fetch reads from a file open on a signal server.
+/// \param      client          The client to fetch the reads with.
+/// \param      file            The file to fetch reads from.
+/// \param      read_ids        The read ids to fetch, null to fetch every read in the file.
+/// \param      read_id_count   The number of read ids in [read_ids].
+/// \param      with_signal     Non zero to fetch the reads' samples as well as their metadata.
+/// \param[out] reads           The fetched reads, free with pod5_free_signal_server_reads.
+/// \note Reads are returned in file order, read ids not in the file are skipped.
+POD5_FORMAT_EXPORT pod5_error_t pod5_signal_client_get_reads(
+    Pod5SignalClient_t * client,
+    uint32_t file,
+    read_id_t const * read_ids,
+    size_t read_id_count,
+    int with_signal,
+    Pod5SignalServerReads_t ** reads);
+
+/// \brief Find the reads and samples fetched by pod5_signal_client_get_reads.
+/// \param      reads           The fetched reads.
+/// \param[out] read_data       Array of the reads' metadata.
+/// \param[out] read_count      The number of entries in [read_data].
+/// \param[out] samples         The samples of every read, each read's samples start at its sample_offset. Null if no signal was fetched.
+/// \param[out] sample_count    The number of samples in [samples].
+/// \note Large replies are mapped from the memory the server wrote them to, the outputs are valid until [reads] is freed.
+POD5_FORMAT_EXPORT pod5_error_t pod5_get_signal_server_reads(
+    Pod5SignalServerReads_t const * reads,
+    SignalServerRead_t const ** read_data,
+    size_t * read_count,
+    int16_t const ** samples,
+    size_t * sample_count);
+
+/// \brief Release reads fetched by pod5_signal_client_get_reads.
+POD5_FORMAT_EXPORT pod5_error_t pod5_free_signal_server_reads(Pod5SignalServerReads_t * reads);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,195 @@
+#include "pod5_format/channel_index_table_reader.h"
+
+#include "pod5_format/schema_metadata.h"
+#include "pod5_format/schema_utils.h"
+
+#include <arrow/array/array_primitive.h>
+#include <arrow/ipc/reader.h>
+
+#include <algorithm>
+#include <limits>
+#include <tuple>
+
+namespace pod5 {
+
+ChannelIndexTableReader::ChannelIndexTableReader(
+    std::shared_ptr<arrow::io::RandomAccessFile> const & input_source,
+    std::shared_ptr<arrow::ipc::RecordBatchFileReader> && reader,
+    std::shared_ptr<ChannelIndexTableSchemaDescription const> const & field_locations,
+    SchemaMetadataDescription && schema_metadata,
+    arrow::MemoryPool * pool)
+: TableReader(input_source, std::move(reader), std::move(schema_metadata), pool)
+, m_field_locations(field_locations)
+{
+}
+
+ChannelIndexTableReader::ChannelIndexTableReader(ChannelIndexTableReader && other)
+: TableReader(std::move(other))
+, m_field_locations(std::move(other.m_field_locations))
+, m_entries_loaded(other.m_entries_loaded)
+, m_entries(std::move(other.m_entries))
+{
+}
+
+ChannelIndexTableReader & ChannelIndexTableReader::operator=(ChannelIndexTableReader && other)
+{
+    static_cast<TableReader &>(*this) = std::move(static_cast<TableReader &>(other));
+    m_field_locations = std::move(other.m_field_locations);
+    m_entries_loaded = other.m_entries_loaded;
+    m_entries = std::move(other.m_entries);
+    return *this;
+}
+
+Result<gsl::span<ChannelIndexEntry const>> ChannelIndexTableReader::entries() const
+{
+    std::lock_guard<std::mutex> l(m_entries_mutex);
+    ARROW_RETURN_NOT_OK(load_entries());
+    return gsl::make_span(m_entries);
+}
+
+Result<gsl::span<ChannelIndexEntry const>> ChannelIndexTableReader::find_channel_window(
+    std::uint16_t channel,
+    std::uint64_t first_sample,
+    std::uint64_t end_sample) const
+{
+    ARROW_ASSIGN_OR_RAISE(auto const all_entries, entries());
+    if (end_sample <= first_sample) {
+        return gsl::span<ChannelIndexEntry const>{};
+    }
+
+    auto const key = [](ChannelIndexEntry const & entry) {
+        return std::make_tuple(entry.channel, entry.start_sample);
+    };
+    auto const begin = std::lower_bound(
+        all_entries.begin(),
+        all_entries.end(),
+        std::make_tuple(channel, first_sample),
+        [&](ChannelIndexEntry const & entry, std::tuple<std::uint16_t, std::uint64_t> const & v) {
+            return key(entry) < v;
+        });
+    auto const end = std::lower_bound(
+        begin,
+        all_entries.end(),
+        std::make_tuple(channel, end_sample),
+        [&](ChannelIndexEntry const & entry, std::tuple<std::uint16_t, std::uint64_t> const & v) {
+            return key(entry) < v;
+        });
+
+    return all_entries.subspan(begin - all_entries.begin(), end - begin);
+}
+
+Result<ChannelIndexEntry> ChannelIndexTableReader::find_read(
+    std::uint16_t channel,
+    std::uint32_t read_number) const
+{
+    ARROW_ASSIGN_OR_RAISE(
+        auto channel_entries,
+        find_channel_window(channel, 0, std::numeric_limits<std::uint64_t>::max()));
+
+    // Read numbers are not guaranteed to follow start sample order, so scan the channel:
+    for (auto const & entry : channel_entries) {
+        if (entry.read_number == read_number) {
+            return entry;
+        }
+    }
+
+    return arrow::Status::KeyError(
+        "No read number ", read_number, " indexed on channel ", channel);
+}
+
+arrow::Status ChannelIndexTableReader::load_entries() const
+{
+    if (m_entries_loaded) {
+        return Status::OK();
+    }
+
+    std::vector<ChannelIndexEntry> entries;
+    for (std::size_t i = 0; i < num_record_batches(); ++i) {
+        ARROW_ASSIGN_OR_RAISE(auto batch, read_checked_record_batch(i));
+        auto const channel = find_column(batch, m_field_locations->channel);
+        auto const start_sample = find_column(batch, m_field_locations->start_sample);
+        auto const read_number = find_column(batch, m_field_locations->read_number);
+        auto const batch_index = find_column(batch, m_field_locations->batch);
+        auto const batch_row = find_column(batch, m_field_locations->batch_row);
+
+        entries.reserve(entries.size() + batch->num_rows());
+        for (std::int64_t j = 0; j < batch->num_rows(); ++j) {
+            entries.push_back(
+                {channel->Value(j),
+                 start_sample->Value(j),
+                 read_number->Value(j),
+                 batch_index->Value(j),
+                 batch_row->Value(j)});
+        }
+    }
+
+    auto const key = [](ChannelIndexEntry const & entry) {
+        return std::make_tuple(entry.channel, entry.start_sample);
+    };
+    if (!std::is_sorted(
+            entries.begin(),
+            entries.end(),
+            [&](ChannelIndexEntry const & a, ChannelIndexEntry const & b) {
+                return key(a) < key(b);
+            }))
+    {
+        return arrow::Status::Invalid("Channel index is not sorted by channel and start sample");
+    }
+
+    m_entries = std::move(entries);
+    m_entries_loaded = true;
+    return Status::OK();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+Result<ReadTraversalPlan> make_read_traversal_plan(
+    gsl::span<ChannelIndexEntry const> const & entries,
+    std::size_t read_table_batch_count)
+{
+    std::vector<std::vector<std::uint32_t>> batch_data(read_table_batch_count);
+    for (auto const & entry : entries) {
+        if (entry.batch >= read_table_batch_count) {
+            return arrow::Status::IndexError(
+                "Indexed read batch ", entry.batch, " is out of range of the read table");
+        }
+        batch_data[entry.batch].push_back(entry.batch_row);
+    }
+
+    ReadTraversalPlan plan;
+    plan.batch_counts.reserve(read_table_batch_count);
+    plan.batch_rows.reserve(entries.size());
+    for (auto & rows : batch_data) {
+        // Rows within a batch are visited in storage order:
+        std::sort(rows.begin(), rows.end());
+        plan.batch_counts.push_back(rows.size());
+        plan.batch_rows.insert(plan.batch_rows.end(), rows.begin(), rows.end());
+    }
+    return plan;
+}
+
+Result<ChannelIndexTableReader> make_channel_index_table_reader(
+    std::shared_ptr<arrow::io::RandomAccessFile> const & input,
+    arrow::MemoryPool * pool)
+{
+    arrow::ipc::IpcReadOptions options;
+    options.memory_pool = pool;
+
+    ARROW_ASSIGN_OR_RAISE(auto reader, arrow::ipc::RecordBatchFileReader::Open(input, options));
+
+    auto metadata_key_values = reader->schema()->metadata();
+    if (!metadata_key_values) {
+        return Status::IOError("Missing metadata on channel index table schema");
+    }
+    if (read_index_type(metadata_key_values) != CHANNEL_INDEX_TYPE) {
+        return Status::Invalid("Table is not a channel index");
+    }
+    ARROW_ASSIGN_OR_RAISE(auto metadata, read_schema_key_value_metadata(metadata_key_values));
+    ARROW_ASSIGN_OR_RAISE(
+        auto field_locations, read_channel_index_table_schema(metadata, reader->schema()));
+
+    return ChannelIndexTableReader(
+        {input}, std::move(reader), field_locations, std::move(metadata), pool);
+}
+
+}  // namespace pod5
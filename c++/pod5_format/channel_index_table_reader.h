@@ -0,0 +1,77 @@
+#pragma once
+
+#include "pod5_format/channel_index_table_schema.h"
+#include "pod5_format/pod5_format_export.h"
+#include "pod5_format/read_table_utils.h"
+#include "pod5_format/result.h"
+#include "pod5_format/schema_metadata.h"
+#include "pod5_format/table_reader.h"
+
+#include <arrow/io/type_fwd.h>
+#include <gsl/gsl-lite.hpp>
+
+#include <mutex>
+#include <vector>
+
+namespace arrow {
+namespace io {
+class RandomAccessFile;
+}
+
+namespace ipc {
+class RecordBatchFileReader;
+}
+}  // namespace arrow
+
+namespace pod5 {
+
+class POD5_FORMAT_EXPORT ChannelIndexTableReader : public TableReader {
+public:
+    ChannelIndexTableReader(
+        std::shared_ptr<arrow::io::RandomAccessFile> const & input_source,
+        std::shared_ptr<arrow::ipc::RecordBatchFileReader> && reader,
+        std::shared_ptr<ChannelIndexTableSchemaDescription const> const & field_locations,
+        SchemaMetadataDescription && schema_metadata,
+        arrow::MemoryPool * pool);
+
+    ChannelIndexTableReader(ChannelIndexTableReader && other);
+    ChannelIndexTableReader & operator=(ChannelIndexTableReader && other);
+
+    /// \brief Find all indexed reads, sorted by (channel, start_sample).
+    /// \returns The entries of the index, the span remains valid for the lifetime of the reader.
+    Result<gsl::span<ChannelIndexEntry const>> entries() const;
+
+    /// \brief Find the reads on [channel] with a start sample in [first_sample, end_sample).
+    /// \returns Entries for the matching reads in start sample order, the span remains valid for
+    ///          the lifetime of the reader.
+    Result<gsl::span<ChannelIndexEntry const>>
+    find_channel_window(std::uint16_t channel, std::uint64_t first_sample, std::uint64_t end_sample)
+        const;
+
+    /// \brief Find the read with [read_number] on [channel].
+    /// \returns The entry for the read, or KeyError if no such read is indexed.
+    Result<ChannelIndexEntry> find_read(std::uint16_t channel, std::uint32_t read_number) const;
+
+private:
+    /// Load the full index into memory, called with m_entries_mutex held.
+    arrow::Status load_entries() const;
+
+    std::shared_ptr<ChannelIndexTableSchemaDescription const> m_field_locations;
+
+    mutable bool m_entries_loaded = false;
+    mutable std::vector<ChannelIndexEntry> m_entries;
+    mutable std::mutex m_entries_mutex;
+};
+
+/// \brief Build a plan to visit [entries] in read table order.
+/// \param entries              The reads to visit.
+/// \param read_table_batch_count The number of batches in the read table the entries refer to.
+POD5_FORMAT_EXPORT Result<ReadTraversalPlan> make_read_traversal_plan(
+    gsl::span<ChannelIndexEntry const> const & entries,
+    std::size_t read_table_batch_count);
+
+POD5_FORMAT_EXPORT Result<ChannelIndexTableReader> make_channel_index_table_reader(
+    std::shared_ptr<arrow::io::RandomAccessFile> const & input,
+    arrow::MemoryPool * pool);
+
+}  // namespace pod5
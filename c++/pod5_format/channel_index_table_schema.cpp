@@ -0,0 +1,49 @@
+#include "pod5_format/channel_index_table_schema.h"
+
+#include "pod5_format/schema_metadata.h"
+#include "pod5_format/types.h"
+
+#include <algorithm>
+#include <tuple>
+
+namespace pod5 {
+
+ChannelIndexTableSchemaDescription::ChannelIndexTableSchemaDescription()
+: SchemaDescriptionBase(ChannelIndexTableSpecVersion::latest())
+// V0 Fields
+, channel(this, "channel", arrow::uint16(), ChannelIndexTableSpecVersion::v0())
+, start_sample(this, "start_sample", arrow::uint64(), ChannelIndexTableSpecVersion::v0())
+, read_number(this, "read_number", arrow::uint32(), ChannelIndexTableSpecVersion::v0())
+, batch(this, "batch", arrow::uint32(), ChannelIndexTableSpecVersion::v0())
+, batch_row(this, "batch_row", arrow::uint32(), ChannelIndexTableSpecVersion::v0())
+{
+}
+
+TableSpecVersion ChannelIndexTableSchemaDescription::table_version_from_file_version(
+    Version file_version) const
+{
+    return ChannelIndexTableSpecVersion::latest();
+}
+
+void sort_channel_index_entries(std::vector<ChannelIndexEntry> & entries)
+{
+    std::stable_sort(
+        entries.begin(),
+        entries.end(),
+        [](ChannelIndexEntry const & a, ChannelIndexEntry const & b) {
+            return std::tie(a.channel, a.start_sample) < std::tie(b.channel, b.start_sample);
+        });
+}
+
+Result<std::shared_ptr<ChannelIndexTableSchemaDescription const>> read_channel_index_table_schema(
+    SchemaMetadataDescription const & schema_metadata,
+    std::shared_ptr<arrow::Schema> const & schema)
+{
+    auto result = std::make_shared<ChannelIndexTableSchemaDescription>();
+    ARROW_RETURN_NOT_OK(
+        ChannelIndexTableSchemaDescription::read_schema(result, schema_metadata, schema));
+
+    return result;
+}
+
+}  // namespace pod5
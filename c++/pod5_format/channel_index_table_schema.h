@@ -0,0 +1,79 @@
+#pragma once
+
+#include "pod5_format/pod5_format_export.h"
+#include "pod5_format/result.h"
+#include "pod5_format/schema_utils.h"
+#include "pod5_format/tuple_utils.h"
+#include "pod5_format/types.h"
+
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+namespace arrow {
+class KeyValueMetadata;
+class Schema;
+class DataType;
+class StructType;
+}  // namespace arrow
+
+namespace pod5 {
+
+class ChannelIndexTableSpecVersion {
+public:
+    static TableSpecVersion v0() { return TableSpecVersion::first_version(); }
+
+    static TableSpecVersion latest() { return v0(); }
+};
+
+/// Index type recorded in the schema metadata of an embedded channel index table.
+static constexpr char const * CHANNEL_INDEX_TYPE = "channel_start_sample";
+
+/// \brief Location of one read in the read table, as stored in the channel index.
+struct ChannelIndexEntry {
+    std::uint16_t channel;
+    std::uint64_t start_sample;
+    std::uint32_t read_number;
+    std::uint32_t batch;
+    std::uint32_t batch_row;
+};
+
+/// \brief Sort [entries] by (channel, start_sample), the order they are stored in the index.
+/// \note Entries sharing a channel and start sample keep their relative order.
+POD5_FORMAT_EXPORT void sort_channel_index_entries(std::vector<ChannelIndexEntry> & entries);
+
+/// \brief Schema of the channel index table, embedded in a file as an OtherIndex.
+/// \details Holds one row per read, sorted by (channel, start_sample), locating the read in the
+///          read table.
+class ChannelIndexTableSchemaDescription : public SchemaDescriptionBase {
+public:
+    ChannelIndexTableSchemaDescription();
+
+    ChannelIndexTableSchemaDescription(ChannelIndexTableSchemaDescription const &) = delete;
+    ChannelIndexTableSchemaDescription & operator=(ChannelIndexTableSchemaDescription const &) =
+        delete;
+
+    TableSpecVersion table_version_from_file_version(Version file_version) const override;
+
+    Field<0, arrow::UInt16Array> channel;
+    Field<1, arrow::UInt64Array> start_sample;
+    Field<2, arrow::UInt32Array> read_number;
+    Field<3, arrow::UInt32Array> batch;
+    Field<4, arrow::UInt32Array> batch_row;
+
+    using FieldBuilders = FieldBuilder<
+        // V0 fields
+        decltype(channel),
+        decltype(start_sample),
+        decltype(read_number),
+        decltype(batch),
+        decltype(batch_row)>;
+};
+
+POD5_FORMAT_EXPORT Result<std::shared_ptr<ChannelIndexTableSchemaDescription const>>
+read_channel_index_table_schema(
+    SchemaMetadataDescription const & schema_metadata,
+    std::shared_ptr<arrow::Schema> const &);
+
+}  // namespace pod5
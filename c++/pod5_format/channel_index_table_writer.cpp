@@ -0,0 +1,80 @@
+#include "pod5_format/channel_index_table_writer.h"
+
+#include "pod5_format/internal/tracing/tracing.h"
+#include "pod5_format/schema_field_builder.h"
+#include "pod5_format/schema_metadata.h"
+
+#include <arrow/io/interfaces.h>
+#include <arrow/ipc/writer.h>
+#include <arrow/record_batch.h>
+#include <arrow/type.h>
+
+#include <algorithm>
+
+namespace pod5 {
+
+ChannelIndexWriter::ChannelIndexWriter(std::size_t table_batch_size, arrow::MemoryPool * pool)
+: m_table_batch_size(table_batch_size)
+, m_pool(pool)
+{
+}
+
+void ChannelIndexWriter::add_read(
+    std::uint16_t channel,
+    std::uint64_t start_sample,
+    std::uint32_t read_number,
+    std::uint32_t batch,
+    std::uint32_t batch_row)
+{
+    m_entries.push_back({channel, start_sample, read_number, batch, batch_row});
+}
+
+Status ChannelIndexWriter::write(
+    std::shared_ptr<arrow::io::OutputStream> const & sink,
+    std::shared_ptr<const arrow::KeyValueMetadata> const & metadata)
+{
+    POD5_TRACE_FUNCTION();
+    if (m_table_batch_size == 0) {
+        return Status::Invalid("Channel index batch size must be greater than zero");
+    }
+
+    // Ties on start sample keep their write order, so the index is deterministic.
+    sort_channel_index_entries(m_entries);
+
+    ARROW_ASSIGN_OR_RAISE(
+        auto index_metadata, make_index_key_value_metadata(metadata, CHANNEL_INDEX_TYPE));
+
+    auto field_locations = std::make_shared<ChannelIndexTableSchemaDescription>();
+    auto schema = field_locations->make_writer_schema(index_metadata);
+
+    arrow::ipc::IpcWriteOptions options;
+    options.memory_pool = m_pool;
+    ARROW_ASSIGN_OR_RAISE(
+        auto writer, arrow::ipc::MakeFileWriter(sink, schema, options, index_metadata));
+
+    ChannelIndexTableSchemaDescription::FieldBuilders field_builders(field_locations, m_pool);
+    for (std::size_t batch_start = 0; batch_start < m_entries.size();
+         batch_start += m_table_batch_size) {
+        auto const batch_size = std::min(m_table_batch_size, m_entries.size() - batch_start);
+        ARROW_RETURN_NOT_OK(field_builders.reserve(batch_size));
+
+        for (std::size_t i = batch_start; i < batch_start + batch_size; ++i) {
+            auto const & entry = m_entries[i];
+            ARROW_RETURN_NOT_OK(field_builders.append(
+                // V0 Fields
+                entry.channel,
+                entry.start_sample,
+                entry.read_number,
+                entry.batch,
+                entry.batch_row));
+        }
+
+        ARROW_ASSIGN_OR_RAISE(auto columns, field_builders.finish_columns());
+        auto const record_batch = arrow::RecordBatch::Make(schema, batch_size, std::move(columns));
+        ARROW_RETURN_NOT_OK(writer->WriteRecordBatch(*record_batch));
+    }
+
+    return writer->Close();
+}
+
+}  // namespace pod5
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "pod5_format/channel_index_table_schema.h"
+#include "pod5_format/pod5_format_export.h"
+#include "pod5_format/result.h"
+
+#include <arrow/io/type_fwd.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace arrow {
+class KeyValueMetadata;
+class MemoryPool;
+
+namespace io {
+class OutputStream;
+}
+}  // namespace arrow
+
+namespace pod5 {
+
+/// \brief Collects the location of each read written to a file, and writes them sorted by
+///        (channel, start_sample) as a channel index table.
+/// \details Entries are held in memory until the file is closed, as the index can only be sorted
+///          once all reads are known.
+class POD5_FORMAT_EXPORT ChannelIndexWriter {
+public:
+    ChannelIndexWriter(std::size_t table_batch_size, arrow::MemoryPool * pool);
+
+    /// \brief Record the read table location of a read.
+    void add_read(
+        std::uint16_t channel,
+        std::uint64_t start_sample,
+        std::uint32_t read_number,
+        std::uint32_t batch,
+        std::uint32_t batch_row);
+
+    std::size_t read_count() const { return m_entries.size(); }
+
+    /// \brief Sort all recorded reads and write them as a table to [sink].
+    /// \param sink Sink to be used for output of the table.
+    /// \param metadata Metadata of the file, the index type is added to this for the table schema.
+    Status write(
+        std::shared_ptr<arrow::io::OutputStream> const & sink,
+        std::shared_ptr<const arrow::KeyValueMetadata> const & metadata);
+
+private:
+    std::size_t m_table_batch_size;
+    arrow::MemoryPool * m_pool;
+    std::vector<ChannelIndexEntry> m_entries;
+};
+
+}  // namespace pod5
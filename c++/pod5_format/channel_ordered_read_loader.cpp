@@ -0,0 +1,140 @@
+#include "pod5_format/channel_ordered_read_loader.h"
+
+#include <algorithm>
+#include <numeric>
+#include <tuple>
+
+namespace pod5 {
+
+ChannelOrderedReadLoader::ChannelOrderedReadLoader(
+    std::shared_ptr<pod5::FileReader> const & reader,
+    SamplesMode samples_mode,
+    std::size_t reads_per_batch,
+    std::size_t worker_count,
+    std::size_t max_pending_batches)
+: m_reader(reader)
+, m_reads_per_batch(std::max<std::size_t>(reads_per_batch, 1))
+{
+    m_error = prepare(samples_mode, worker_count, max_pending_batches);
+}
+
+ChannelOrderedReadLoader::~ChannelOrderedReadLoader() = default;
+
+Result<std::unique_ptr<ChannelOrderedReadBatch>> ChannelOrderedReadLoader::release_next_batch(
+    boost::optional<std::chrono::steady_clock::time_point> timeout)
+{
+    if (!m_error.ok()) {
+        return m_error;
+    }
+
+    if (m_next_batch_index >= m_traversal_batch_visits.size()) {
+        // No more data - return null.
+        return nullptr;
+    }
+
+    if (!m_next_batch) {
+        auto const first_read = m_next_batch_index * m_reads_per_batch;
+        auto const read_count = std::min(m_reads_per_batch, m_locations.size() - first_read);
+        m_next_batch = std::make_unique<ChannelOrderedReadBatch>(
+            first_read, m_locations.subspan(first_read, read_count));
+        m_next_visit = 0;
+    }
+
+    // Gather the reads of each read table batch visited back into traversal order, a timeout
+    // leaves the batch part assembled for the next call:
+    while (m_next_visit < m_traversal_batch_visits[m_next_batch_index]) {
+        ARROW_ASSIGN_OR_RAISE(auto visit, m_signal_loader->release_next_batch(timeout));
+        if (!visit) {
+            // The loader can report it has finished just after queueing its last batch, look
+            // once more before treating the traversal as cut short:
+            if (!m_signal_loader->is_finished()) {
+                return nullptr;
+            }
+            ARROW_ASSIGN_OR_RAISE(
+                visit, m_signal_loader->release_next_batch(std::chrono::steady_clock::now()));
+            if (!visit) {
+                m_error = Status::Invalid("Signal loader finished before the traversal");
+                return m_error;
+            }
+        }
+
+        auto samples = visit->release_samples();
+        for (std::size_t row = 0; row < visit->read_ids().size(); ++row, ++m_next_row) {
+            auto const position = m_traversal_positions[m_next_row];
+            m_next_batch->set_read_id(position, visit->read_ids()[row]);
+            m_next_batch->set_samples(
+                position, visit->sample_count()[row], std::move(samples[row]));
+        }
+        ++m_next_visit;
+    }
+
+    ++m_next_batch_index;
+    return std::move(m_next_batch);
+}
+
+Status ChannelOrderedReadLoader::prepare(
+    SamplesMode samples_mode,
+    std::size_t worker_count,
+    std::size_t max_pending_batches)
+{
+    // Taken from the channel index if the file has one, otherwise from one pass of the read table:
+    ARROW_ASSIGN_OR_RAISE(m_locations, m_reader->channel_ordered_read_locations());
+    if (m_locations.empty()) {
+        return Status::OK();
+    }
+
+    auto const read_batch_count = m_reader->num_read_record_batches();
+    m_batch_rows.reserve(m_locations.size());
+    m_traversal_positions.reserve(m_locations.size());
+
+    // Each batch of the traversal visits the read table batches holding its reads once, in file
+    // order, so a read table batch is only opened once per traversal batch:
+    std::vector<std::uint32_t> positions;
+    for (std::size_t first_read = 0; first_read < m_locations.size();
+         first_read += m_reads_per_batch)
+    {
+        auto const locations = m_locations.subspan(
+            first_read, std::min(m_reads_per_batch, m_locations.size() - first_read));
+        positions.resize(locations.size());
+        std::iota(positions.begin(), positions.end(), 0);
+        std::sort(positions.begin(), positions.end(), [&](std::uint32_t a, std::uint32_t b) {
+            return std::tie(locations[a].batch, locations[a].batch_row)
+                   < std::tie(locations[b].batch, locations[b].batch_row);
+        });
+
+        std::uint32_t visit_count = 0;
+        for (std::size_t i = 0; i < positions.size(); ++i) {
+            auto const & location = locations[positions[i]];
+            if (location.batch >= read_batch_count) {
+                return Status::IndexError("Read location batch ", location.batch, " out of range");
+            }
+            if (i == 0 || location.batch != locations[positions[i - 1]].batch) {
+                m_batch_order.push_back(location.batch);
+                m_batch_counts.push_back(0);
+                ++visit_count;
+            }
+            m_batch_counts.back() += 1;
+            m_batch_rows.push_back(location.batch_row);
+            m_traversal_positions.push_back(positions[i]);
+        }
+        m_traversal_batch_visits.push_back(visit_count);
+    }
+
+    // The signal loader counts batches it runs ahead by visit, scale the limit so it stays around
+    // [max_pending_batches] traversal batches ahead:
+    auto const traversal_batch_count = m_traversal_batch_visits.size();
+    auto const visits_per_batch =
+        (m_batch_order.size() + traversal_batch_count - 1) / traversal_batch_count;
+
+    m_signal_loader = std::make_unique<AsyncSignalLoader>(
+        m_reader,
+        samples_mode,
+        m_batch_counts,
+        m_batch_rows,
+        std::max<std::size_t>(worker_count, 1),
+        max_pending_batches * visits_per_batch,
+        m_batch_order);
+    return Status::OK();
+}
+
+}  // namespace pod5
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "pod5_format/async_signal_loader.h"
+#include "pod5_format/channel_index_table_schema.h"
+#include "pod5_format/file_reader.h"
+#include "pod5_format/pod5_format_export.h"
+
+#include <boost/optional/optional.hpp>
+#include <boost/uuid/uuid.hpp>
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace pod5 {
+
+/// \brief A consecutive range of reads from a channel ordered traversal, with their signal.
+class POD5_FORMAT_EXPORT ChannelOrderedReadBatch {
+public:
+    ChannelOrderedReadBatch(
+        std::size_t first_read_index,
+        gsl::span<ChannelIndexEntry const> const & locations)
+    : m_first_read_index(first_read_index)
+    , m_locations(locations.begin(), locations.end())
+    , m_read_ids(locations.size())
+    , m_sample_counts(locations.size())
+    , m_samples(locations.size())
+    {
+    }
+
+    /// Find the position of the first read in this batch within the whole traversal.
+    std::size_t first_read_index() const { return m_first_read_index; }
+
+    /// Find the channel, start sample and read table location of each read.
+    std::vector<ChannelIndexEntry> const & locations() const { return m_locations; }
+
+    std::vector<boost::uuids::uuid> const & read_ids() const { return m_read_ids; }
+
+    /// Find a list of sample counts for all reads.
+    std::vector<std::uint64_t> const & sample_count() const { return m_sample_counts; }
+
+    /// Find a list of signal samples for all reads, empty if samples were not requested.
+    std::vector<std::vector<std::int16_t>> const & samples() const { return m_samples; }
+
+    void set_read_id(std::size_t row, boost::uuids::uuid const & read_id)
+    {
+        m_read_ids[row] = read_id;
+    }
+
+    void
+    set_samples(std::size_t row, std::uint64_t sample_count, std::vector<std::int16_t> && samples)
+    {
+        m_sample_counts[row] = sample_count;
+        m_samples[row] = std::move(samples);
+    }
+
+private:
+    std::size_t m_first_read_index;
+    std::vector<ChannelIndexEntry> m_locations;
+    std::vector<boost::uuids::uuid> m_read_ids;
+    std::vector<std::uint64_t> m_sample_counts;
+    std::vector<std::vector<std::int16_t>> m_samples;
+};
+
+/// \brief Loads every read in a file grouped by channel, in start sample order within a channel.
+/// \details The traversal order comes from FileReader::channel_ordered_read_locations, so no
+///          sorting is done by the caller. The traversal is split into batches of
+///          [reads_per_batch] reads, each batch visits the read table batches holding its reads
+///          in file order through an AsyncSignalLoader, which loads (and prefetches) signal ahead
+///          of the caller, up to about [max_pending_batches] batches ahead.
+class POD5_FORMAT_EXPORT ChannelOrderedReadLoader {
+public:
+    using SamplesMode = AsyncSignalLoader::SamplesMode;
+
+    static constexpr std::size_t DEFAULT_READS_PER_BATCH = 1000;
+
+    ChannelOrderedReadLoader(
+        std::shared_ptr<pod5::FileReader> const & reader,
+        SamplesMode samples_mode,
+        std::size_t reads_per_batch = DEFAULT_READS_PER_BATCH,
+        std::size_t worker_count = std::thread::hardware_concurrency(),
+        std::size_t max_pending_batches = 10);
+
+    ~ChannelOrderedReadLoader();
+
+    /// Find the total number of reads the loader will return.
+    std::size_t read_count() const { return m_locations.size(); }
+
+    /// Find if all batches of the traversal have been returned to the caller.
+    bool is_finished() const { return m_next_batch_index >= m_traversal_batch_visits.size(); }
+
+    /// Get the next batch of reads, always returns the consecutive next batch of the traversal.
+    /// \note Returns nullptr when timeout occurs, or if all data is exhausted.
+    Result<std::unique_ptr<ChannelOrderedReadBatch>> release_next_batch(
+        boost::optional<std::chrono::steady_clock::time_point> timeout = boost::none);
+
+private:
+    /// Plan the read table batches each batch of the traversal visits, and start loading them.
+    Status prepare(
+        SamplesMode samples_mode,
+        std::size_t worker_count,
+        std::size_t max_pending_batches);
+
+    std::shared_ptr<pod5::FileReader> m_reader;
+    std::size_t m_reads_per_batch;
+    pod5::Status m_error;
+
+    // Traversal order, owned by m_reader:
+    gsl::span<ChannelIndexEntry const> m_locations;
+
+    // Read table batches visited, their row counts and rows, in the order they are loaded:
+    std::vector<std::uint32_t> m_batch_order;
+    std::vector<std::uint32_t> m_batch_counts;
+    std::vector<std::uint32_t> m_batch_rows;
+    // Position within its traversal batch of each entry in m_batch_rows:
+    std::vector<std::uint32_t> m_traversal_positions;
+    // Number of entries in m_batch_order for each traversal batch:
+    std::vector<std::uint32_t> m_traversal_batch_visits;
+
+    std::unique_ptr<AsyncSignalLoader> m_signal_loader;
+
+    // Progress of the caller through the traversal, m_next_batch is assembled from the visits of
+    // traversal batch m_next_batch_index:
+    std::size_t m_next_batch_index = 0;
+    std::size_t m_next_visit = 0;
+    std::size_t m_next_row = 0;
+    std::unique_ptr<ChannelOrderedReadBatch> m_next_batch;
+};
+
+}  // namespace pod5
@@ -0,0 +1,279 @@
+#include "pod5_format/decoded_signal_cache.h"
+
+#include <algorithm>
+
+namespace pod5 {
+
+namespace {
+
+// Counters per row of a cache's sketch are sized assuming reads of around this many bytes:
+constexpr std::size_t SketchBytesPerRead = 16 * 1024;
+constexpr std::size_t MinSketchWidth = 256;
+constexpr std::size_t MaxSketchWidth = 1 << 20;
+
+std::uint64_t mix(std::uint64_t value)
+{
+    // splitmix64 finaliser:
+    value ^= value >> 30;
+    value *= 0xbf58476d1ce4e5b9ULL;
+    value ^= value >> 27;
+    value *= 0x94d049bb133111ebULL;
+    value ^= value >> 31;
+    return value;
+}
+
+std::size_t round_up_to_power_of_two(std::size_t value)
+{
+    std::size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+}  // namespace
+
+constexpr std::uint8_t FrequencySketch::MAX_COUNT;
+
+FrequencySketch::FrequencySketch(std::size_t width)
+: m_mask(round_up_to_power_of_two(std::max<std::size_t>(width, 1)) - 1)
+, m_counters(Rows * (m_mask + 1))
+, m_reset_period(10 * (m_mask + 1))
+{
+}
+
+std::size_t FrequencySketch::index(std::uint64_t hash, std::size_t row) const
+{
+    // Each row indexes with a differently seeded remix of the hash:
+    auto const row_hash = mix(hash + row * 0x9e3779b97f4a7c15ULL);
+    return row * (m_mask + 1) + (row_hash & m_mask);
+}
+
+void FrequencySketch::increment(std::uint64_t hash)
+{
+    for (std::size_t row = 0; row < Rows; ++row) {
+        auto & counter = m_counters[index(hash, row)];
+        if (counter < MAX_COUNT) {
+            ++counter;
+        }
+    }
+
+    if (++m_increments >= m_reset_period) {
+        for (auto & counter : m_counters) {
+            counter /= 2;
+        }
+        m_increments /= 2;
+    }
+}
+
+std::uint8_t FrequencySketch::estimate(std::uint64_t hash) const
+{
+    auto result = MAX_COUNT;
+    for (std::size_t row = 0; row < Rows; ++row) {
+        result = std::min(result, m_counters[index(hash, row)]);
+    }
+    return result;
+}
+
+DecodedSignalCache::DecodedSignalCache(std::size_t capacity_bytes)
+: m_capacity_bytes(capacity_bytes)
+, m_sketch(std::min(
+      std::max(capacity_bytes / SketchBytesPerRead, MinSketchWidth),
+      MaxSketchWidth))
+{
+}
+
+std::uint64_t DecodedSignalCache::register_file() { return m_next_file_id++; }
+
+void DecodedSignalCache::remove_file(std::uint64_t file_id)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        auto const next = std::next(it);
+        if (it->file_id == file_id) {
+            erase_entry(it);
+        }
+        it = next;
+    }
+    m_metrics.entry_count = m_entries.size();
+}
+
+DecodedSignalCache::Samples DecodedSignalCache::find(
+    std::uint64_t file_id,
+    gsl::span<std::uint64_t const> const & signal_rows)
+{
+    auto const key_hash = hash(file_id, signal_rows);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_sketch.increment(key_hash);
+
+    auto const entry = find_entry(key_hash, file_id, signal_rows);
+    if (entry == m_entries.end()) {
+        m_metrics.misses += 1;
+        return nullptr;
+    }
+    m_metrics.hits += 1;
+    m_entries.splice(m_entries.begin(), m_entries, entry);
+    return entry->samples;
+}
+
+bool DecodedSignalCache::insert(
+    std::uint64_t file_id,
+    gsl::span<std::uint64_t const> const & signal_rows,
+    Samples const & samples)
+{
+    if (!samples) {
+        return false;
+    }
+    auto const key_hash = hash(file_id, signal_rows);
+    auto const bytes = samples->size() * sizeof(std::int16_t);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto const admission = admit(key_hash, file_id, signal_rows, bytes);
+    if (admission != Admission::Admitted) {
+        return admission == Admission::Cached;
+    }
+    add_entry(key_hash, file_id, signal_rows, samples, bytes);
+    return true;
+}
+
+bool DecodedSignalCache::insert(
+    std::uint64_t file_id,
+    gsl::span<std::uint64_t const> const & signal_rows,
+    gsl::span<std::int16_t const> const & samples)
+{
+    auto const key_hash = hash(file_id, signal_rows);
+    auto const bytes = samples.size() * sizeof(std::int16_t);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto const admission = admit(key_hash, file_id, signal_rows, bytes);
+    if (admission != Admission::Admitted) {
+        return admission == Admission::Cached;
+    }
+    // Copied under the lock, so the room made for the read isn't taken by another meanwhile:
+    add_entry(
+        key_hash,
+        file_id,
+        signal_rows,
+        std::make_shared<std::vector<std::int16_t> const>(samples.begin(), samples.end()),
+        bytes);
+    return true;
+}
+
+void DecodedSignalCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_index.clear();
+    m_metrics.byte_count = 0;
+    m_metrics.entry_count = 0;
+}
+
+DecodedSignalCacheMetrics DecodedSignalCache::metrics() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_metrics;
+}
+
+std::uint64_t DecodedSignalCache::hash(
+    std::uint64_t file_id,
+    gsl::span<std::uint64_t const> const & signal_rows)
+{
+    auto result = mix(file_id) ^ signal_rows.size();
+    for (auto const row : signal_rows) {
+        result = mix(result ^ row);
+    }
+    return result;
+}
+
+DecodedSignalCache::EntryIterator DecodedSignalCache::find_entry(
+    std::uint64_t hash,
+    std::uint64_t file_id,
+    gsl::span<std::uint64_t const> const & signal_rows)
+{
+    auto const range = m_index.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        auto const & entry = *it->second;
+        if (entry.file_id == file_id
+            && std::equal(
+                entry.signal_rows.begin(),
+                entry.signal_rows.end(),
+                signal_rows.begin(),
+                signal_rows.end()))
+        {
+            return it->second;
+        }
+    }
+    return m_entries.end();
+}
+
+DecodedSignalCache::Admission DecodedSignalCache::admit(
+    std::uint64_t hash,
+    std::uint64_t file_id,
+    gsl::span<std::uint64_t const> const & signal_rows,
+    std::size_t bytes)
+{
+    auto const existing = find_entry(hash, file_id, signal_rows);
+    if (existing != m_entries.end()) {
+        // Already added by another thread, the samples are the same:
+        m_entries.splice(m_entries.begin(), m_entries, existing);
+        return Admission::Cached;
+    }
+    if (bytes > m_capacity_bytes) {
+        m_metrics.rejections += 1;
+        return Admission::Rejected;
+    }
+
+    // Find the least recently used reads which would make room, the read is only added if it is
+    // used more often than each of them:
+    auto const frequency = m_sketch.estimate(hash);
+    auto free_bytes = m_capacity_bytes - m_metrics.byte_count;
+    std::size_t victim_count = 0;
+    for (auto victim = m_entries.rbegin(); free_bytes < bytes; ++victim) {
+        if (m_sketch.estimate(victim->hash) >= frequency) {
+            m_metrics.rejections += 1;
+            return Admission::Rejected;
+        }
+        free_bytes += victim->bytes;
+        victim_count += 1;
+    }
+    for (std::size_t i = 0; i < victim_count; ++i) {
+        evict_entry(std::prev(m_entries.end()));
+    }
+    return Admission::Admitted;
+}
+
+void DecodedSignalCache::add_entry(
+    std::uint64_t hash,
+    std::uint64_t file_id,
+    gsl::span<std::uint64_t const> const & signal_rows,
+    Samples const & samples,
+    std::size_t bytes)
+{
+    m_entries.push_front({file_id, {signal_rows.begin(), signal_rows.end()}, hash, samples, bytes});
+    m_index.emplace(hash, m_entries.begin());
+    m_metrics.insertions += 1;
+    m_metrics.byte_count += bytes;
+    m_metrics.entry_count = m_entries.size();
+}
+
+void DecodedSignalCache::erase_entry(EntryIterator entry)
+{
+    m_metrics.byte_count -= entry->bytes;
+    auto const range = m_index.equal_range(entry->hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == entry) {
+            m_index.erase(it);
+            break;
+        }
+    }
+    m_entries.erase(entry);
+}
+
+void DecodedSignalCache::evict_entry(EntryIterator entry)
+{
+    m_metrics.evictions += 1;
+    erase_entry(entry);
+    m_metrics.entry_count = m_entries.size();
+}
+
+}  // namespace pod5
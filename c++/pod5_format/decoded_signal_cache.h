@@ -0,0 +1,166 @@
+#pragma once
+
+#include "pod5_format/pod5_format_export.h"
+
+#include <gsl/gsl-lite.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace pod5 {
+
+/// \brief Estimates how often keys were seen recently, in a fixed amount of memory.
+/// \details A count-min sketch of 4 rows of 4 bit counters. Once 10 increments per counter have
+///          been made every counter is halved, so old accesses fade.
+class POD5_FORMAT_EXPORT FrequencySketch {
+public:
+    static constexpr std::uint8_t MAX_COUNT = 15;
+
+    /// \param width The number of counters in each row, rounded up to a power of two.
+    explicit FrequencySketch(std::size_t width);
+
+    /// Record an access of [hash].
+    void increment(std::uint64_t hash);
+
+    /// Find the estimated number of recent accesses of [hash], at most MAX_COUNT.
+    std::uint8_t estimate(std::uint64_t hash) const;
+
+    std::size_t width() const { return m_mask + 1; }
+
+private:
+    static constexpr std::size_t Rows = 4;
+
+    std::size_t index(std::uint64_t hash, std::size_t row) const;
+
+    std::size_t m_mask;
+    std::vector<std::uint8_t> m_counters;
+    std::size_t m_increments = 0;
+    std::size_t m_reset_period;
+};
+
+/// \brief Counts of a decoded signal cache's activity.
+struct DecodedSignalCacheMetrics {
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    /// Reads added to the cache.
+    std::uint64_t insertions = 0;
+    /// Reads refused by the cache, as less used than those they would have evicted.
+    std::uint64_t rejections = 0;
+    std::uint64_t evictions = 0;
+    std::size_t entry_count = 0;
+    /// Bytes of decoded samples held.
+    std::size_t byte_count = 0;
+
+    /// Find the fraction of lookups which hit, 0 if there were none.
+    double hit_rate() const
+    {
+        auto const lookups = hits + misses;
+        return lookups ? double(hits) / lookups : 0.0;
+    }
+};
+
+/// \brief Holds the decoded samples of recently read reads, so reads fetched again aren't
+///        decompressed again.
+/// \details Reads are keyed by the file they come from and all their signal rows, one cache can be
+///          shared by many readers (see FileReaderOptions::set_decoded_signal_cache()).
+///          Reads are evicted least recently used first, but a read is only added if it has been
+///          looked up more often than those it would evict (TinyLFU admission), so a scan of reads
+///          used once doesn't flush reads used repeatedly.
+/// \note All methods are thread safe.
+class POD5_FORMAT_EXPORT DecodedSignalCache {
+public:
+    using Samples = std::shared_ptr<std::vector<std::int16_t> const>;
+
+    /// \param capacity_bytes The most bytes of decoded samples to hold.
+    explicit DecodedSignalCache(std::size_t capacity_bytes);
+
+    std::size_t capacity_bytes() const { return m_capacity_bytes; }
+
+    /// \brief Find a new id to key a file's reads with.
+    std::uint64_t register_file();
+
+    /// \brief Drop every read from [file_id].
+    void remove_file(std::uint64_t file_id);
+
+    /// \brief Find the samples of the read with [signal_rows] in [file_id], null if not cached.
+    Samples find(std::uint64_t file_id, gsl::span<std::uint64_t const> const & signal_rows);
+
+    /// \brief Offer the samples of the read with [signal_rows] in [file_id] to the cache.
+    /// \returns If the read was added (or was already cached).
+    bool insert(
+        std::uint64_t file_id,
+        gsl::span<std::uint64_t const> const & signal_rows,
+        Samples const & samples);
+
+    /// \brief Offer the samples of the read with [signal_rows] in [file_id] to the cache, copying
+    ///        them only if the read is added.
+    /// \returns If the read was added (or was already cached).
+    bool insert(
+        std::uint64_t file_id,
+        gsl::span<std::uint64_t const> const & signal_rows,
+        gsl::span<std::int16_t const> const & samples);
+
+    /// \brief Drop every read.
+    void clear();
+
+    DecodedSignalCacheMetrics metrics() const;
+
+private:
+    struct Entry {
+        std::uint64_t file_id;
+        std::vector<std::uint64_t> signal_rows;
+        std::uint64_t hash;
+        Samples samples;
+        std::size_t bytes;
+    };
+    using EntryIterator = std::list<Entry>::iterator;
+
+    static std::uint64_t hash(
+        std::uint64_t file_id,
+        gsl::span<std::uint64_t const> const & signal_rows);
+
+    /// Find the entry for exactly [signal_rows] in [file_id], m_entries.end() if there is none.
+    EntryIterator find_entry(
+        std::uint64_t hash,
+        std::uint64_t file_id,
+        gsl::span<std::uint64_t const> const & signal_rows);
+
+    enum class Admission { Cached, Rejected, Admitted };
+
+    /// Decide whether to add a read of [bytes] with [signal_rows] in [file_id], evicting reads to
+    /// make room for it if it is admitted. Called with m_mutex held.
+    Admission admit(
+        std::uint64_t hash,
+        std::uint64_t file_id,
+        gsl::span<std::uint64_t const> const & signal_rows,
+        std::size_t bytes);
+
+    /// Add an admitted read. Called with m_mutex held.
+    void add_entry(
+        std::uint64_t hash,
+        std::uint64_t file_id,
+        gsl::span<std::uint64_t const> const & signal_rows,
+        Samples const & samples,
+        std::size_t bytes);
+
+    void erase_entry(EntryIterator entry);
+    void evict_entry(EntryIterator entry);
+
+    std::size_t const m_capacity_bytes;
+    std::atomic<std::uint64_t> m_next_file_id{0};
+
+    mutable std::mutex m_mutex;
+    FrequencySketch m_sketch;
+    // Most recently used first:
+    std::list<Entry> m_entries;
+    // Entries by the hash of their key, reads whose hashes collide are told apart by their rows:
+    std::unordered_multimap<std::uint64_t, EntryIterator> m_index;
+    DecodedSignalCacheMetrics m_metrics;
+};
+
+}  // namespace pod5
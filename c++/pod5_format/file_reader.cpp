@@ -1,16 +1,39 @@
 #include "pod5_format/file_reader.h"
 
+#include "pod5_format/batch_checksum.h"
+#include "pod5_format/channel_index_table_reader.h"
+#include "pod5_format/decoded_signal_cache.h"
+#include "pod5_format/internal/coalescing_file.h"
 #include "pod5_format/internal/combined_file_utils.h"
+#include "pod5_format/internal/direct_io_file.h"
+#include "pod5_format/internal/page_cache_advisor.h"
 #include "pod5_format/migration/migration.h"
+#include "pod5_format/read_batch_view.h"
 #include "pod5_format/read_table_reader.h"
 #include "pod5_format/run_info_table_reader.h"
+#include "pod5_format/shared_signal_cache.h"
+#include "pod5_format/signal_compression.h"
+#include "pod5_format/signal_dictionary_table.h"
+#include "pod5_format/signal_summary_table_reader.h"
 #include "pod5_format/signal_table_reader.h"
+#include "pod5_format/thread_pool.h"
 
+#include <arrow/array/array_nested.h>
+#include <arrow/array/array_primitive.h>
+#include <arrow/filesystem/filesystem.h>
 #include <arrow/io/concurrency.h>
 #include <arrow/io/file.h>
+#include <arrow/io/memory.h>
+#include <arrow/ipc/reader.h>
 #include <arrow/memory_pool.h>
+#include <boost/optional/optional.hpp>
 #include <boost/uuid/uuid_io.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
 namespace pod5 {
 
 FileReaderOptions::FileReaderOptions()
@@ -27,10 +50,35 @@ void FileReaderOptions::set_max_cached_signal_table_batches(
 
 inline FileLocation make_file_locaton(combined_file_utils::ParsedFileInfo const & parsed_file_info)
 {
-    return FileLocation{
+    FileLocation location{
         parsed_file_info.file_path,
         std::size_t(parsed_file_info.file_start_offset),
         std::size_t(parsed_file_info.file_length)};
+    location.batch_checksums = parsed_file_info.batch_checksums;
+    return location;
+}
+
+inline std::vector<FileLocation> make_file_locatons(
+    std::vector<combined_file_utils::ParsedFileInfo> const & parsed_file_infos)
+{
+    std::vector<FileLocation> result;
+    result.reserve(parsed_file_infos.size());
+    for (auto const & parsed_file_info : parsed_file_infos) {
+        result.push_back(make_file_locaton(parsed_file_info));
+    }
+    return result;
+}
+
+/// Open the schema of an embedded index to find what it indexes.
+inline Result<std::string> find_index_type(
+    std::shared_ptr<arrow::io::RandomAccessFile> const & input,
+    arrow::MemoryPool * pool)
+{
+    arrow::ipc::IpcReadOptions options;
+    options.memory_pool = pool;
+
+    ARROW_ASSIGN_OR_RAISE(auto reader, arrow::ipc::RecordBatchFileReader::Open(input, options));
+    return read_index_type(reader->schema()->metadata());
 }
 
 class FileReaderImpl : public FileReader {
@@ -40,16 +88,44 @@ public:
         MigrationResult && migration_result,
         RunInfoTableReader && run_info_table_reader,
         ReadTableReader && read_table_reader,
-        SignalTableReader && signal_table_reader)
+        SignalTableReader && signal_table_reader,
+        boost::optional<SignalSummaryTableReader> && signal_summary_table_reader,
+        boost::optional<ChannelIndexTableReader> && channel_index_table_reader,
+        std::unique_ptr<PageCacheAdvisor> && page_cache_advisor,
+        std::vector<std::int64_t> && signal_batch_offsets,
+        std::shared_ptr<CoalescingFile> const & coalescing_file,
+        std::shared_ptr<DecodedSignalCache> const & decoded_signal_cache,
+        std::shared_ptr<SharedSignalCache> const & shared_signal_cache)
     : m_file_version_pre_migration(file_version_pre_migration)
     , m_migration_result(std::move(migration_result))
     , m_run_info_table_location(make_file_locaton(m_migration_result.footer().run_info_table))
     , m_read_table_location(make_file_locaton(m_migration_result.footer().reads_table))
     , m_signal_table_location(make_file_locaton(m_migration_result.footer().signal_table))
+    , m_other_index_locations(make_file_locatons(m_migration_result.footer().other_indices))
     , m_run_info_table_reader(std::move(run_info_table_reader))
     , m_read_table_reader(std::move(read_table_reader))
     , m_signal_table_reader(std::move(signal_table_reader))
+    , m_signal_summary_table_reader(std::move(signal_summary_table_reader))
+    , m_channel_index_table_reader(std::move(channel_index_table_reader))
+    , m_page_cache_advisor(std::move(page_cache_advisor))
+    , m_signal_batch_offsets(std::move(signal_batch_offsets))
+    , m_coalescing_file(coalescing_file)
+    , m_decoded_signal_cache(decoded_signal_cache)
+    , m_decoded_signal_cache_file_id(
+          decoded_signal_cache ? decoded_signal_cache->register_file() : 0)
+    , m_file_identifier(m_read_table_reader.schema_metadata().file_identifier)
+    {
+        // Shared caches key reads by file identifier, which only identifies files which have one:
+        if (!m_file_identifier.is_nil()) {
+            m_shared_signal_cache = shared_signal_cache;
+        }
+    }
+
+    ~FileReaderImpl()
     {
+        if (m_decoded_signal_cache) {
+            m_decoded_signal_cache->remove_file(m_decoded_signal_cache_file_id);
+        }
     }
 
     SchemaMetadataDescription schema_metadata() const override
@@ -110,11 +186,50 @@ public:
         return m_signal_table_reader.extract_sample_count(row_indices);
     }
 
+    Result<std::size_t> extract_samples_byte_count(
+        gsl::span<std::uint64_t const> const & row_indices) const override
+    {
+        return m_signal_table_reader.extract_samples_byte_count(row_indices);
+    }
+
     Status extract_samples(
         gsl::span<std::uint64_t const> const & row_indices,
         gsl::span<std::int16_t> const & output_samples) const override
     {
-        return m_signal_table_reader.extract_samples(row_indices, output_samples);
+        if ((!m_decoded_signal_cache && !m_shared_signal_cache) || row_indices.empty()) {
+            return m_signal_table_reader.extract_samples(row_indices, output_samples);
+        }
+
+        if (m_decoded_signal_cache) {
+            auto const cached =
+                m_decoded_signal_cache->find(m_decoded_signal_cache_file_id, row_indices);
+            if (cached) {
+                if (cached->size() > output_samples.size()) {
+                    return Status::Invalid("Too few samples in input samples array");
+                }
+                std::copy(cached->begin(), cached->end(), output_samples.begin());
+                return Status::OK();
+            }
+        }
+
+        if (m_shared_signal_cache) {
+            auto const sample_count =
+                m_shared_signal_cache->find(m_file_identifier, row_indices, output_samples);
+            if (sample_count > 0) {
+                insert_decoded_signal(row_indices, output_samples.first(sample_count));
+                return Status::OK();
+            }
+        }
+
+        ARROW_ASSIGN_OR_RAISE(
+            auto const sample_count,
+            m_signal_table_reader.extract_counted_samples(row_indices, output_samples));
+        auto const samples = output_samples.first(sample_count);
+        if (m_shared_signal_cache) {
+            m_shared_signal_cache->insert(m_file_identifier, row_indices, samples);
+        }
+        insert_decoded_signal(row_indices, samples);
+        return Status::OK();
     }
 
     Result<std::vector<std::shared_ptr<arrow::Buffer>>> extract_samples_inplace(
@@ -133,10 +248,30 @@ public:
 
     FileLocation const & signal_table_location() const override { return m_signal_table_location; }
 
+    std::vector<FileLocation> const & other_index_locations() const override
+    {
+        return m_other_index_locations;
+    }
+
     Version file_version_pre_migration() const override { return m_file_version_pre_migration; }
 
     SignalType signal_type() const override { return m_signal_table_reader.signal_type(); }
 
+    std::shared_ptr<DecodedSignalCache> const & decoded_signal_cache() const override
+    {
+        return m_decoded_signal_cache;
+    }
+
+    std::shared_ptr<SharedSignalCache> const & shared_signal_cache() const override
+    {
+        return m_shared_signal_cache;
+    }
+
+    std::shared_ptr<VbzDictionary const> signal_dictionary() const override
+    {
+        return m_signal_table_reader.vbz_dictionary();
+    }
+
     Result<std::shared_ptr<RunInfoData const>> find_run_info(
         std::string const & acquisition_id) const override
     {
@@ -153,38 +288,326 @@ public:
         return m_run_info_table_reader.get_run_info_count();
     }
 
+    bool has_signal_summary() const override { return !!m_signal_summary_table_reader; }
+
+    Result<SignalSummary> get_signal_summary(
+        boost::uuids::uuid const & read_id,
+        std::size_t level,
+        std::uint64_t first_sample,
+        std::uint64_t sample_count) const override
+    {
+        if (!m_signal_summary_table_reader) {
+            return arrow::Status::KeyError("File does not contain a signal summary index");
+        }
+        return m_signal_summary_table_reader->get_signal_summary(
+            read_id, level, first_sample, sample_count);
+    }
+
+    bool has_channel_index() const override { return !!m_channel_index_table_reader; }
+
+    Result<ReadTraversalPlan> plan_channel_window_traversal(
+        std::uint16_t channel,
+        std::uint64_t first_sample,
+        std::uint64_t end_sample) const override
+    {
+        if (!m_channel_index_table_reader) {
+            return arrow::Status::KeyError("File does not contain a channel index");
+        }
+        ARROW_ASSIGN_OR_RAISE(
+            auto entries,
+            m_channel_index_table_reader->find_channel_window(channel, first_sample, end_sample));
+        return make_read_traversal_plan(entries, num_read_record_batches());
+    }
+
+    Result<ReadTraversalPlan> plan_channel_read_number_traversal(
+        std::uint16_t channel,
+        std::uint32_t read_number) const override
+    {
+        if (!m_channel_index_table_reader) {
+            return arrow::Status::KeyError("File does not contain a channel index");
+        }
+        ARROW_ASSIGN_OR_RAISE(
+            auto entry, m_channel_index_table_reader->find_read(channel, read_number));
+        return make_read_traversal_plan(gsl::make_span(&entry, 1), num_read_record_batches());
+    }
+
+    Result<gsl::span<ChannelIndexEntry const>> channel_ordered_read_locations() const override
+    {
+        if (m_channel_index_table_reader) {
+            return m_channel_index_table_reader->entries();
+        }
+
+        std::lock_guard<std::mutex> l(m_channel_order_mutex);
+        if (!m_channel_order_built) {
+            std::vector<ChannelIndexEntry> locations;
+            for (std::size_t batch = 0; batch < num_read_record_batches(); ++batch) {
+                ARROW_ASSIGN_OR_RAISE(auto read_batch, read_read_record_batch(batch));
+                ARROW_ASSIGN_OR_RAISE(auto view, LatestReadBatchView::make(read_batch));
+                for (std::size_t row = 0; row < view.num_rows(); ++row) {
+                    locations.push_back(
+                        {view.channel(row),
+                         view.start_sample(row),
+                         view.read_number(row),
+                         std::uint32_t(batch),
+                         std::uint32_t(row)});
+                }
+            }
+            sort_channel_index_entries(locations);
+
+            m_channel_order = std::move(locations);
+            m_channel_order_built = true;
+        }
+        return gsl::make_span(m_channel_order);
+    }
+
+    void release_signal_batches_before(std::size_t batch_index) const override
+    {
+        if (!m_page_cache_advisor || m_signal_batch_offsets.empty()) {
+            return;
+        }
+
+        // Offsets are relative to the signal table, the advisor works on its containing file:
+        std::int64_t offset = m_signal_table_location.size;
+        if (batch_index < m_signal_batch_offsets.size()) {
+            offset = m_signal_batch_offsets[batch_index];
+        }
+        m_page_cache_advisor->release_before(m_signal_table_location.offset + offset);
+    }
+
+    Status prefetch_signal_batches(std::vector<std::size_t> const & batch_indices) const override
+    {
+        if (!m_coalescing_file) {
+            return Status::OK();
+        }
+
+        std::vector<arrow::io::ReadRange> ranges;
+        {
+            std::lock_guard<std::mutex> l(m_signal_batch_ranges_mutex);
+            if (m_signal_batch_ranges.empty()) {
+                ARROW_ASSIGN_OR_RAISE(m_signal_batch_ranges, find_signal_batch_ranges());
+            }
+            for (auto batch_index : batch_indices) {
+                if (batch_index >= m_signal_batch_ranges.size()) {
+                    return Status::IndexError(
+                        "Signal batch ", batch_index, " out of range for prefetch");
+                }
+                ranges.push_back(m_signal_batch_ranges[batch_index]);
+            }
+        }
+        return m_coalescing_file->prefetch(CoalescingFile::PrefetchKind::Signal, ranges);
+    }
+
+    Status prefetch_traversal(ReadTraversalPlan const & plan) const override
+    {
+        if (!m_coalescing_file) {
+            return Status::OK();
+        }
+
+        std::vector<std::size_t> signal_batches;
+        std::size_t plan_row = 0;
+        for (std::size_t batch_index = 0; batch_index < plan.batch_counts.size(); ++batch_index) {
+            auto const row_count = plan.batch_counts[batch_index];
+            if (row_count == 0) {
+                continue;
+            }
+            if (plan_row + row_count > plan.batch_rows.size()) {
+                return Status::Invalid("Traversal plan has fewer rows than its batch counts");
+            }
+
+            ARROW_ASSIGN_OR_RAISE(auto const batch, read_read_record_batch(batch_index));
+            auto const signal_column = batch.signal_column();
+            for (std::uint32_t i = 0; i < row_count; ++i, ++plan_row) {
+                auto const batch_row = plan.batch_rows[plan_row];
+                if (batch_row >= std::size_t(batch.num_rows())) {
+                    return Status::IndexError("Traversal plan row out of range");
+                }
+                auto const signal_rows = std::static_pointer_cast<arrow::UInt64Array>(
+                    signal_column->value_slice(batch_row));
+                for (std::int64_t j = 0; j < signal_rows->length(); ++j) {
+                    std::size_t signal_batch_row = 0;
+                    ARROW_ASSIGN_OR_RAISE(
+                        auto const signal_batch,
+                        signal_batch_for_row_id(signal_rows->Value(j), &signal_batch_row));
+                    signal_batches.push_back(signal_batch);
+                }
+            }
+        }
+
+        std::sort(signal_batches.begin(), signal_batches.end());
+        signal_batches.erase(
+            std::unique(signal_batches.begin(), signal_batches.end()), signal_batches.end());
+        return prefetch_signal_batches(signal_batches);
+    }
+
+    void check_run_info_batch_checksums(BatchChecksumReport & report) const override
+    {
+        for (std::size_t i = 0; i < m_run_info_table_reader.num_record_batches(); ++i) {
+            m_run_info_table_reader.check_record_batch(i, "run info", report);
+        }
+    }
+
+    Result<ReadTableRecordBatch> read_and_check_read_record_batch(
+        std::size_t i,
+        BatchChecksumReport & report) const override
+    {
+        return m_read_table_reader.read_and_check_record_batch(i, report);
+    }
+
+    Result<SignalTableRecordBatch> read_and_check_signal_record_batch(
+        std::size_t i,
+        BatchChecksumReport & report) const override
+    {
+        return m_signal_table_reader.read_and_check_record_batch(i, report);
+    }
+
+    Result<BatchChecksumReport> verify_batch_checksums(
+        std::size_t worker_count,
+        std::shared_ptr<ThreadPool> const & thread_pool) const override
+    {
+        struct TableBatch {
+            char const * table_name;
+            TableReader const * table;
+            std::size_t batch;
+        };
+
+        std::vector<TableBatch> batches;
+        auto const add_table = [&](char const * table_name, TableReader const & table) {
+            for (std::size_t batch = 0; batch < table.num_record_batches(); ++batch) {
+                batches.push_back({table_name, &table, batch});
+            }
+        };
+        add_table("run info", m_run_info_table_reader);
+        add_table("read", m_read_table_reader);
+        add_table("signal", m_signal_table_reader);
+
+        if (worker_count == 0) {
+            worker_count = std::max(1u, std::thread::hardware_concurrency());
+        }
+        worker_count = std::max<std::size_t>(1, std::min(worker_count, batches.size()));
+
+        std::atomic<std::size_t> next_batch{0};
+        std::mutex report_mutex;
+        BatchChecksumReport report;
+
+        auto const verify_batches = [&] {
+            BatchChecksumReport worker_report;
+            for (std::size_t i = next_batch++; i < batches.size(); i = next_batch++) {
+                auto const & entry = batches[i];
+                entry.table->check_record_batch(entry.batch, entry.table_name, worker_report);
+            }
+
+            std::lock_guard<std::mutex> l(report_mutex);
+            report.merge(std::move(worker_report));
+        };
+
+        run_on_workers(
+            thread_pool ? *thread_pool : *shared_thread_pool(), worker_count, verify_batches);
+
+        std::sort(report.failures.begin(), report.failures.end());
+        return report;
+    }
+
 private:
+    /// Offer decoded [samples] of the read at [row_indices] to the private decoded cache, if any.
+    void insert_decoded_signal(
+        gsl::span<std::uint64_t const> const & row_indices,
+        gsl::span<std::int16_t const> const & samples) const
+    {
+        if (!m_decoded_signal_cache) {
+            return;
+        }
+        m_decoded_signal_cache->insert(m_decoded_signal_cache_file_id, row_indices, samples);
+    }
+
+    /// Find the range of the file holding each signal batch, preferring the ranges recorded with
+    /// the batch checksums over walking the signal table's messages.
+    Result<std::vector<arrow::io::ReadRange>> find_signal_batch_ranges() const
+    {
+        auto const table_offset = std::int64_t(m_signal_table_location.offset);
+        std::vector<arrow::io::ReadRange> ranges;
+        for (std::size_t i = 0; i < m_signal_table_reader.num_record_batches(); ++i) {
+            auto const checksum = m_signal_table_reader.batch_checksum(i);
+            if (!checksum) {
+                ranges.clear();
+                break;
+            }
+            ranges.push_back({table_offset + checksum->offset, checksum->length});
+        }
+        if (!ranges.empty()) {
+            return ranges;
+        }
+
+        ARROW_ASSIGN_OR_RAISE(auto const offsets, m_signal_table_reader.record_batch_offsets());
+        for (std::size_t i = 0; i < offsets.size(); ++i) {
+            // The last batch is followed by the table's footer, which is small:
+            auto const end = i + 1 < offsets.size() ? offsets[i + 1]
+                                                    : std::int64_t(m_signal_table_location.size);
+            ranges.push_back({table_offset + offsets[i], end - offsets[i]});
+        }
+        return ranges;
+    }
+
     Version m_file_version_pre_migration;
     MigrationResult m_migration_result;
     FileLocation m_run_info_table_location;
     FileLocation m_read_table_location;
     FileLocation m_signal_table_location;
+    std::vector<FileLocation> m_other_index_locations;
     RunInfoTableReader m_run_info_table_reader;
     ReadTableReader m_read_table_reader;
     SignalTableReader m_signal_table_reader;
+    boost::optional<SignalSummaryTableReader> m_signal_summary_table_reader;
+    boost::optional<ChannelIndexTableReader> m_channel_index_table_reader;
+
+    std::unique_ptr<PageCacheAdvisor> m_page_cache_advisor;
+    // Offset of each signal batch in the signal table, only found for sequential access:
+    std::vector<std::int64_t> m_signal_batch_offsets;
+
+    std::shared_ptr<CoalescingFile> m_coalescing_file;
+    std::shared_ptr<DecodedSignalCache> m_decoded_signal_cache;
+    std::uint64_t m_decoded_signal_cache_file_id;
+    boost::uuids::uuid m_file_identifier;
+    std::shared_ptr<SharedSignalCache> m_shared_signal_cache;
+    // Range of each signal batch in the file, found on the first prefetch.
+    mutable std::mutex m_signal_batch_ranges_mutex;
+    mutable std::vector<arrow::io::ReadRange> m_signal_batch_ranges;
+
+    // Read locations in channel order, built on demand for files without a channel index.
+    mutable std::mutex m_channel_order_mutex;
+    mutable bool m_channel_order_built = false;
+    mutable std::vector<ChannelIndexEntry> m_channel_order;
 };
 
-pod5::Result<std::shared_ptr<FileReader>> open_file_reader(
+namespace {
+
+/// Open a reader on [file], [path] is empty if the file isn't backed by a file on disk.
+pod5::Result<std::shared_ptr<FileReader>> open_file_reader_impl(
     std::string const & path,
+    std::shared_ptr<arrow::io::RandomAccessFile> const & input_file,
     FileReaderOptions const & options)
 {
     auto pool = options.memory_pool();
     if (!pool) {
         return Status::Invalid("Invalid memory pool specified for file writer");
     }
-
-    std::shared_ptr<arrow::io::RandomAccessFile> file;
-    if (!options.force_disable_file_mapping() && getenv("POD5_DISABLE_MMAP_OPEN") == nullptr) {
-        // Try to open the file with mmap, if we fail fall back to a traditional open.
-        auto file_opt = arrow::io::MemoryMappedFile::Open(path, arrow::io::FileMode::READ);
-        if (file_opt.ok()) {
-            file = *file_opt;
-        }
+    if (!input_file) {
+        return Status::Invalid("Invalid input file specified for file reader");
+    }
+    if (options.use_direct_io() && path.empty()) {
+        return Status::Invalid("Direct io is only supported for files opened by path");
     }
 
-    if (!file) {
-        ARROW_ASSIGN_OR_RAISE(auto file_reader, arrow::io::ReadableFile::Open(path, pool));
-        file = file_reader;
+    auto file = input_file;
+    std::shared_ptr<CoalescingFile> coalescing_file;
+    if (options.coalesce_reads() && path.empty()) {
+        ARROW_ASSIGN_OR_RAISE(
+            coalescing_file,
+            CoalescingFile::open(
+                input_file,
+                arrow::io::CacheOptions::MakeFromNetworkMetrics(
+                    options.storage_time_to_first_byte_millis(),
+                    options.storage_bandwidth_mib_per_sec())));
+        file = coalescing_file;
     }
 
     ARROW_ASSIGN_OR_RAISE(
@@ -197,6 +620,39 @@ pod5::Result<std::shared_ptr<FileReader>> open_file_reader(
         auto migration_result,
         migrate_if_required(original_writer_version, original_footer_metadata, file, pool));
 
+    if (coalescing_file) {
+        // Opening reads all of the small tables, and both ends of the signal table (its schema
+        // and footer), fetch them together. Migrated tables are no longer in the file:
+        std::int64_t const SIGNAL_TABLE_END_PREFETCH_SIZE = 1024 * 1024;
+        std::vector<arrow::io::ReadRange> ranges;
+        auto const & footer = migration_result.footer();
+        for (auto const * table : {&footer.run_info_table, &footer.reads_table}) {
+            if (table->file == file) {
+                ranges.push_back({table->file_start_offset, table->file_length});
+            }
+        }
+        for (auto const & index : footer.other_indices) {
+            if (index.file == file) {
+                ranges.push_back({index.file_start_offset, index.file_length});
+            }
+        }
+        if (footer.signal_dictionary && footer.signal_dictionary->file == file) {
+            ranges.push_back(
+                {footer.signal_dictionary->file_start_offset,
+                 footer.signal_dictionary->file_length});
+        }
+        if (footer.signal_table.file == file) {
+            auto const & signal_table = footer.signal_table;
+            auto const end_size =
+                std::min(signal_table.file_length, SIGNAL_TABLE_END_PREFETCH_SIZE);
+            ranges.push_back({signal_table.file_start_offset, end_size});
+            ranges.push_back(
+                {signal_table.file_start_offset + signal_table.file_length - end_size, end_size});
+        }
+        ARROW_RETURN_NOT_OK(
+            coalescing_file->prefetch(CoalescingFile::PrefetchKind::Metadata, ranges));
+    }
+
     // Files are written standalone, and so needs to be treated with a file offset - it wants to seek around as if the reads file is standalone:
 
     ARROW_ASSIGN_OR_RAISE(
@@ -208,11 +664,61 @@ pod5::Result<std::shared_ptr<FileReader>> open_file_reader(
         auto reads_sub_file, open_sub_file(migration_result.footer().reads_table));
     ARROW_ASSIGN_OR_RAISE(auto read_table_reader, make_read_table_reader(reads_sub_file, pool));
 
-    ARROW_ASSIGN_OR_RAISE(
-        auto signal_sub_file, open_sub_file(migration_result.footer().signal_table));
+    auto signal_table_info = migration_result.footer().signal_table;
+#ifdef __linux__
+    if (options.use_direct_io()) {
+        // Keep enough released buffers to reuse for a few batches of the default size:
+        std::size_t const MAX_CACHED_BUFFER_BYTES = 64 * 1024 * 1024;
+        auto const buffer_pool = std::make_shared<AlignedBufferPool>(
+            DirectIOFile::ALIGNMENT, MAX_CACHED_BUFFER_BYTES);
+        ARROW_ASSIGN_OR_RAISE(
+            signal_table_info.file, DirectIOFile::open(signal_table_info.file_path, buffer_pool));
+    }
+#endif
+
+    // Vbz signal may be compressed with a dictionary, loaded once for all rows:
+    std::shared_ptr<VbzDictionary const> signal_dictionary;
+    if (auto const & signal_dictionary_info = migration_result.footer().signal_dictionary) {
+        ARROW_ASSIGN_OR_RAISE(auto dictionary_sub_file, open_sub_file(*signal_dictionary_info));
+        ARROW_ASSIGN_OR_RAISE(
+            auto dictionary_data,
+            read_signal_dictionary_table(
+                dictionary_sub_file, read_table_reader.schema_metadata().file_identifier, pool));
+        ARROW_ASSIGN_OR_RAISE(signal_dictionary, VbzDictionary::make(dictionary_data));
+    }
+
+    ARROW_ASSIGN_OR_RAISE(auto signal_sub_file, open_sub_file(signal_table_info));
     ARROW_ASSIGN_OR_RAISE(
         auto signal_table_reader,
-        make_signal_table_reader(signal_sub_file, options.max_cached_signal_table_batches(), pool));
+        make_signal_table_reader(
+            signal_sub_file, options.max_cached_signal_table_batches(), pool, signal_dictionary));
+
+    // Direct io reads bypass the page cache, so have no use for advice on it. Nor do files not on
+    // disk, whose memory is owned by the caller:
+    std::unique_ptr<PageCacheAdvisor> page_cache_advisor;
+    std::vector<std::int64_t> signal_batch_offsets;
+    if (options.access_pattern() != FileAccessPattern::Normal && !options.use_direct_io()
+        && !path.empty())
+    {
+        auto const & signal_table = migration_result.footer().signal_table;
+        ARROW_ASSIGN_OR_RAISE(
+            page_cache_advisor,
+            PageCacheAdvisor::make(
+                signal_table.file_path, signal_table.file, options.access_pattern()));
+        if (options.access_pattern() == FileAccessPattern::Sequential) {
+            ARROW_ASSIGN_OR_RAISE(
+                signal_batch_offsets, signal_table_reader.record_batch_offsets());
+        }
+    }
+
+    // Batch checksums are kept in the footer, migrated tables were rewritten without them:
+    run_info_table_reader.set_batch_checksums(
+        migration_result.footer().run_info_table.batch_checksums);
+    read_table_reader.set_batch_checksums(migration_result.footer().reads_table.batch_checksums);
+    signal_table_reader.set_batch_checksums(signal_table_info.batch_checksums);
+    run_info_table_reader.set_verify_batch_checksums(options.verify_batch_checksums());
+    read_table_reader.set_verify_batch_checksums(options.verify_batch_checksums());
+    signal_table_reader.set_verify_batch_checksums(options.verify_batch_checksums());
 
     auto signal_metadata = signal_table_reader.schema_metadata();
     auto reads_metadata = read_table_reader.schema_metadata();
@@ -224,12 +730,118 @@ pod5::Result<std::shared_ptr<FileReader>> open_file_reader(
             reads_metadata.file_identifier);
     }
 
+    // Indexes are optional, those of an unknown type are left for other tools to interpret:
+    boost::optional<SignalSummaryTableReader> signal_summary_table_reader;
+    boost::optional<ChannelIndexTableReader> channel_index_table_reader;
+    for (auto const & other_index : migration_result.footer().other_indices) {
+        ARROW_ASSIGN_OR_RAISE(auto index_sub_file, open_sub_file(other_index));
+        ARROW_ASSIGN_OR_RAISE(auto index_type, find_index_type(index_sub_file, pool));
+        if (index_type == SIGNAL_SUMMARY_INDEX_TYPE && !signal_summary_table_reader) {
+            ARROW_ASSIGN_OR_RAISE(
+                signal_summary_table_reader,
+                make_signal_summary_table_reader(index_sub_file, pool));
+            if (signal_summary_table_reader->schema_metadata().file_identifier
+                != reads_metadata.file_identifier)
+            {
+                return Status::Invalid("Signal summary index does not belong to this file");
+            }
+        } else if (index_type == CHANNEL_INDEX_TYPE && !channel_index_table_reader) {
+            ARROW_ASSIGN_OR_RAISE(
+                channel_index_table_reader, make_channel_index_table_reader(index_sub_file, pool));
+            if (channel_index_table_reader->schema_metadata().file_identifier
+                != reads_metadata.file_identifier)
+            {
+                return Status::Invalid("Channel index does not belong to this file");
+            }
+        }
+    }
+
     return std::make_shared<FileReaderImpl>(
         original_writer_version,
         std::move(migration_result),
         std::move(run_info_table_reader),
         std::move(read_table_reader),
-        std::move(signal_table_reader));
+        std::move(signal_table_reader),
+        std::move(signal_summary_table_reader),
+        std::move(channel_index_table_reader),
+        std::move(page_cache_advisor),
+        std::move(signal_batch_offsets),
+        coalescing_file,
+        options.decoded_signal_cache(),
+        options.shared_signal_cache());
+}
+
+}  // namespace
+
+pod5::Result<std::shared_ptr<FileReader>> open_file_reader(
+    std::string const & path,
+    FileReaderOptions const & options)
+{
+    if (path.empty()) {
+        return Status::Invalid("Empty path specified for file reader");
+    }
+
+    std::shared_ptr<arrow::io::RandomAccessFile> file;
+    if (!options.force_disable_file_mapping() && getenv("POD5_DISABLE_MMAP_OPEN") == nullptr) {
+        // Try to open the file with mmap, if we fail fall back to a traditional open.
+        auto file_opt = arrow::io::MemoryMappedFile::Open(path, arrow::io::FileMode::READ);
+        if (file_opt.ok()) {
+            file = *file_opt;
+        }
+    }
+
+    if (!file) {
+        auto pool = options.memory_pool();
+        if (!pool) {
+            return Status::Invalid("Invalid memory pool specified for file writer");
+        }
+        ARROW_ASSIGN_OR_RAISE(auto file_reader, arrow::io::ReadableFile::Open(path, pool));
+        file = file_reader;
+    }
+
+    return open_file_reader_impl(path, file, options);
+}
+
+pod5::Result<std::shared_ptr<FileReader>> open_file_reader(
+    std::shared_ptr<arrow::io::RandomAccessFile> const & file,
+    FileReaderOptions const & options)
+{
+    return open_file_reader_impl({}, file, options);
+}
+
+pod5::Result<std::shared_ptr<FileReader>> open_file_reader(
+    std::shared_ptr<arrow::fs::FileSystem> const & filesystem,
+    std::string const & path,
+    FileReaderOptions const & options)
+{
+    if (!filesystem) {
+        return Status::Invalid("Invalid filesystem specified for file reader");
+    }
+    ARROW_ASSIGN_OR_RAISE(auto file, filesystem->OpenInputFile(path));
+
+    auto coalescing_options = options;
+    coalescing_options.set_coalesce_reads(true);
+    return open_file_reader_impl({}, file, coalescing_options);
+}
+
+pod5::Result<std::shared_ptr<FileReader>> open_file_reader_from_uri(
+    std::string const & uri,
+    FileReaderOptions const & options)
+{
+    std::string path;
+    ARROW_ASSIGN_OR_RAISE(auto filesystem, arrow::fs::FileSystemFromUri(uri, &path));
+    return open_file_reader(filesystem, path, options);
+}
+
+pod5::Result<std::shared_ptr<FileReader>> open_file_reader(
+    std::shared_ptr<arrow::Buffer> const & buffer,
+    FileReaderOptions const & options)
+{
+    if (!buffer) {
+        return Status::Invalid("Invalid buffer specified for file reader");
+    }
+    // Reads from a buffer reader are slices of the buffer, nothing is copied:
+    return open_file_reader_impl({}, std::make_shared<arrow::io::BufferReader>(buffer), options);
 }
 
 }  // namespace pod5
@@ -1,27 +1,57 @@
 #pragma once
 
+#include "pod5_format/batch_checksum.h"
 #include "pod5_format/pod5_format_export.h"
 #include "pod5_format/read_table_utils.h"
 #include "pod5_format/result.h"
 #include "pod5_format/signal_table_utils.h"
 
+#include <boost/uuid/uuid.hpp>
+
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 namespace arrow {
 class Array;
 class Buffer;
 class MemoryPool;
+namespace fs {
+class FileSystem;
+}
+namespace io {
+class RandomAccessFile;
+}
 }  // namespace arrow
 
 namespace pod5 {
 
 class Version;
+class DecodedSignalCache;
+class SharedSignalCache;
+class ThreadPool;
 struct SchemaMetadataDescription;
+struct SignalSummary;
+struct ChannelIndexEntry;
+class VbzDictionary;
+
+/// \brief How a file is expected to be read, passed on to the OS to tune caching and read ahead.
+enum class FileAccessPattern {
+    /// No hint is given.
+    Normal,
+    /// The file is scanned once from start to end. Aggressive read ahead is used, and cached pages
+    /// of signal batches are dropped once the caller has moved past them, so a scan of a large
+    /// file doesn't evict everything else from the page cache.
+    Sequential,
+    /// Reads are scattered through the file, read ahead is disabled.
+    Random,
+};
 
 class POD5_FORMAT_EXPORT FileReaderOptions {
 public:
     static constexpr std::uint32_t DEFAULT_MAX_CACHED_SIGNAL_TABLE_BATCHES = 5;
+    static constexpr std::int64_t DEFAULT_STORAGE_TIME_TO_FIRST_BYTE_MILLIS = 50;
+    static constexpr std::int64_t DEFAULT_STORAGE_BANDWIDTH_MIB_PER_SEC = 100;
 
     FileReaderOptions();
 
@@ -45,10 +75,90 @@ public:
 
     bool force_disable_file_mapping() const { return m_force_disable_file_mapping; }
 
+    // Set if table batches should be checked against the checksums stored by the writer as they
+    // are loaded. Batches written without checksums are loaded unchecked.
+    void set_verify_batch_checksums(bool verify_batch_checksums)
+    {
+        m_verify_batch_checksums = verify_batch_checksums;
+    }
+
+    bool verify_batch_checksums() const { return m_verify_batch_checksums; }
+
+    // Set if signal table batches should be read with O_DIRECT into pooled aligned buffers,
+    // bypassing the page cache so large scans don't evict other data. Batches are read in place
+    // from files written with a signal batch alignment. Only supported on Linux.
+    void set_use_direct_io(bool use_direct_io) { m_use_direct_io = use_direct_io; }
+
+    bool use_direct_io() const { return m_use_direct_io; }
+
+    // Set how the file will be read, see FileAccessPattern. Only applied on Linux, and not to
+    // signal read with direct io.
+    void set_access_pattern(FileAccessPattern access_pattern) { m_access_pattern = access_pattern; }
+
+    FileAccessPattern access_pattern() const { return m_access_pattern; }
+
+    // Set if reads of a file opened from an arrow::io::RandomAccessFile are coalesced into a few
+    // large concurrent requests, for storage where each request is slow (eg. S3). Files opened
+    // through an arrow::fs::FileSystem always coalesce reads, files opened by path never do.
+    void set_coalesce_reads(bool coalesce_reads) { m_coalesce_reads = coalesce_reads; }
+
+    bool coalesce_reads() const { return m_coalesce_reads; }
+
+    // Set the time to first byte and bandwidth of the storage reads are coalesced for, these
+    // decide how far apart ranges can be and still be fetched together, and how large requests
+    // grow (see arrow::io::CacheOptions::MakeFromNetworkMetrics).
+    void set_storage_metrics(
+        std::int64_t time_to_first_byte_millis,
+        std::int64_t bandwidth_mib_per_sec)
+    {
+        m_storage_time_to_first_byte_millis = time_to_first_byte_millis;
+        m_storage_bandwidth_mib_per_sec = bandwidth_mib_per_sec;
+    }
+
+    std::int64_t storage_time_to_first_byte_millis() const
+    {
+        return m_storage_time_to_first_byte_millis;
+    }
+
+    std::int64_t storage_bandwidth_mib_per_sec() const { return m_storage_bandwidth_mib_per_sec; }
+
+    // Set a cache of decoded reads for extract_samples() to consult, so reads fetched repeatedly
+    // are only decompressed once. One cache can be shared by many readers, null disables caching.
+    void set_decoded_signal_cache(std::shared_ptr<DecodedSignalCache> const & cache)
+    {
+        m_decoded_signal_cache = cache;
+    }
+
+    std::shared_ptr<DecodedSignalCache> const & decoded_signal_cache() const
+    {
+        return m_decoded_signal_cache;
+    }
+
+    // Set a cache of decoded reads in shared memory for extract_samples() to consult, so
+    // processes reading the same files only decompress each read once. Files without an
+    // identifier aren't cached, null disables caching.
+    void set_shared_signal_cache(std::shared_ptr<SharedSignalCache> const & cache)
+    {
+        m_shared_signal_cache = cache;
+    }
+
+    std::shared_ptr<SharedSignalCache> const & shared_signal_cache() const
+    {
+        return m_shared_signal_cache;
+    }
+
 private:
     arrow::MemoryPool * m_memory_pool;
     std::size_t m_max_cached_signal_table_batches;
     bool m_force_disable_file_mapping = false;
+    bool m_verify_batch_checksums = false;
+    bool m_use_direct_io = false;
+    FileAccessPattern m_access_pattern = FileAccessPattern::Normal;
+    bool m_coalesce_reads = false;
+    std::int64_t m_storage_time_to_first_byte_millis = DEFAULT_STORAGE_TIME_TO_FIRST_BYTE_MILLIS;
+    std::int64_t m_storage_bandwidth_mib_per_sec = DEFAULT_STORAGE_BANDWIDTH_MIB_PER_SEC;
+    std::shared_ptr<DecodedSignalCache> m_decoded_signal_cache;
+    std::shared_ptr<SharedSignalCache> m_shared_signal_cache;
 };
 
 class POD5_FORMAT_EXPORT FileLocation {
@@ -63,6 +173,8 @@ public:
     std::string file_path;
     std::size_t offset;
     std::size_t size;
+    /// Checksums of the table's record batches, relative to [offset]. Empty if none were stored.
+    std::vector<BatchChecksum> batch_checksums;
 };
 
 class ReadTableRecordBatch;
@@ -95,9 +207,18 @@ public:
     virtual Result<std::size_t> extract_sample_count(
         gsl::span<std::uint64_t const> const & row_indices) const = 0;
 
+    /// \brief Find the number of bytes stored in the signal table for a given list of rows.
+    /// \param row_indices      The rows to query for stored size.
+    /// \returns The sum of all stored signal sizes on input rows.
+    /// \note Prefer the read table's num_samples column for per-read sample counts, it requires no
+    ///       signal table access.
+    virtual Result<std::size_t> extract_samples_byte_count(
+        gsl::span<std::uint64_t const> const & row_indices) const = 0;
+
     /// \brief Extract the samples for a list of rows.
     /// \param row_indices      The rows to query for samples.
     /// \param output_samples   The output samples from the rows.
+    /// \note With a decoded signal cache, the rows are looked up (and cached) as one read.
     virtual Status extract_samples(
         gsl::span<std::uint64_t const> const & row_indices,
         gsl::span<std::int16_t> const & output_samples) const = 0;
@@ -112,20 +233,143 @@ public:
     virtual FileLocation const & run_info_table_location() const = 0;
     virtual FileLocation const & read_table_location() const = 0;
     virtual FileLocation const & signal_table_location() const = 0;
+    /// \brief Find the locations of all indexes embedded in the file (including unrecognised ones).
+    virtual std::vector<FileLocation> const & other_index_locations() const = 0;
 
     virtual Version file_version_pre_migration() const = 0;
 
     virtual SignalType signal_type() const = 0;
 
+    /// \brief Find the cache of decoded reads extract_samples() consults, null if there is none.
+    virtual std::shared_ptr<DecodedSignalCache> const & decoded_signal_cache() const = 0;
+
+    /// \brief Find the shared memory cache of decoded reads extract_samples() consults, null if
+    ///        there is none.
+    virtual std::shared_ptr<SharedSignalCache> const & shared_signal_cache() const = 0;
+
+    /// \brief Find the dictionary vbz signal in the file was compressed with, null if none was.
+    /// \note Signal extracted in place must be decompressed with this dictionary.
+    virtual std::shared_ptr<VbzDictionary const> signal_dictionary() const = 0;
+
     virtual Result<std::shared_ptr<RunInfoData const>> find_run_info(
         std::string const & acquisition_id) const = 0;
 
     virtual Result<std::shared_ptr<RunInfoData const>> get_run_info(std::size_t index) const = 0;
     virtual Result<std::size_t> get_run_info_count() const = 0;
+
+    /// \brief Find if the file contains a signal summary index.
+    virtual bool has_signal_summary() const = 0;
+
+    /// \brief Find a zoomed out view of a read's signal, without decompressing any samples.
+    /// \param read_id      The read to query.
+    /// \param level        The level to query, level n has bins of (base bin size * 2^n) samples.
+    /// \param first_sample The first sample of the range to view.
+    /// \param sample_count The number of samples in the range to view.
+    /// \returns The summary bins overlapping the range, KeyError if the file or read has no summary.
+    virtual Result<SignalSummary> get_signal_summary(
+        boost::uuids::uuid const & read_id,
+        std::size_t level,
+        std::uint64_t first_sample,
+        std::uint64_t sample_count) const = 0;
+
+    /// \brief Find if the file contains a channel index.
+    virtual bool has_channel_index() const = 0;
+
+    /// \brief Plan a traversal of the reads on [channel] that start in [first_sample, end_sample).
+    /// \returns Read table rows grouped by batch, in the form expected by AsyncSignalLoader,
+    ///          KeyError if the file has no channel index.
+    virtual Result<ReadTraversalPlan> plan_channel_window_traversal(
+        std::uint16_t channel,
+        std::uint64_t first_sample,
+        std::uint64_t end_sample) const = 0;
+
+    /// \brief Plan a traversal of the read with [read_number] on [channel].
+    /// \returns A plan containing the single read, KeyError if the file has no channel index or
+    ///          the read is not in the file.
+    virtual Result<ReadTraversalPlan> plan_channel_read_number_traversal(
+        std::uint16_t channel,
+        std::uint32_t read_number) const = 0;
+
+    /// \brief Find the location of every read in the file, ordered by (channel, start_sample).
+    /// \details Taken from the channel index if the file has one, otherwise built from the read
+    ///          table on first use. The span remains valid for the lifetime of the reader.
+    virtual Result<gsl::span<ChannelIndexEntry const>> channel_ordered_read_locations() const = 0;
+
+    /// \brief Check every batch of the run info, read and signal tables against the checksums
+    ///        stored by the writer.
+    /// \param worker_count Number of threads to check batches with, 0 uses one per core.
+    /// \param thread_pool  Pool to run the checks on alongside the calling thread, or null for the
+    ///                     library's shared pool.
+    /// \returns A report of the batches checked, and any that failed.
+    virtual Result<BatchChecksumReport> verify_batch_checksums(
+        std::size_t worker_count = 0,
+        std::shared_ptr<ThreadPool> const & thread_pool = nullptr) const = 0;
+
+    /// \brief Check the batches of the run info table against their stored checksums, adding the
+    ///        outcomes to [report].
+    virtual void check_run_info_batch_checksums(BatchChecksumReport & report) const = 0;
+
+    /// \brief Read batch [i] of the read table, first checking it against its stored checksum
+    ///        whatever the reader's options, and adding the outcome to [report].
+    /// \details A batch passing the check is decoded from the checked bytes, so is only read from
+    ///          the file once. A batch failing it is still read.
+    virtual Result<ReadTableRecordBatch> read_and_check_read_record_batch(
+        std::size_t i,
+        BatchChecksumReport & report) const = 0;
+
+    /// \brief Read batch [i] of the signal table, checked as read_and_check_read_record_batch.
+    /// \note The batch is not cached by the reader.
+    virtual Result<SignalTableRecordBatch> read_and_check_signal_record_batch(
+        std::size_t i,
+        BatchChecksumReport & report) const = 0;
+
+    /// \brief Tell the reader signal batches before [batch_index] will not be read again.
+    /// \details With a sequential access pattern the cached pages of those batches are dropped,
+    ///          otherwise this has no effect. Batches can still be read afterwards, from disk.
+    virtual void release_signal_batches_before(std::size_t batch_index) const = 0;
+
+    /// \brief Start fetching signal batches [batch_indices] ahead of them being read.
+    /// \details Only has an effect on files read with coalescing, where nearby batches are fetched
+    ///          together in a few large concurrent requests. Each call replaces the batches
+    ///          fetched by the last, so only the batches about to be read should be passed.
+    virtual Status prefetch_signal_batches(
+        std::vector<std::size_t> const & batch_indices) const = 0;
+
+    /// \brief Start fetching the signal batches holding the reads of [plan] ahead of them being
+    ///        read, see prefetch_signal_batches().
+    virtual Status prefetch_traversal(ReadTraversalPlan const & plan) const = 0;
 };
 
 POD5_FORMAT_EXPORT pod5::Result<std::shared_ptr<FileReader>> open_file_reader(
     std::string const & path,
     FileReaderOptions const & options = {});
 
+/// \brief Open a reader on a pod5 file held by [file], eg. one fetched from remote storage.
+/// \note The file is read in place, direct io isn't supported and access pattern hints are
+///       ignored. Reads should be zero copy, as they are for arrow::io::BufferReader.
+POD5_FORMAT_EXPORT pod5::Result<std::shared_ptr<FileReader>> open_file_reader(
+    std::shared_ptr<arrow::io::RandomAccessFile> const & file,
+    FileReaderOptions const & options = {});
+
+/// \brief Open a reader on the pod5 file at [path] in [filesystem], eg. an S3 bucket.
+/// \details Reads are coalesced, see FileReaderOptions::set_coalesce_reads(). The tables and the
+///          signal table's metadata are fetched as the file is opened, signal can be fetched
+///          ahead with FileReader::prefetch_traversal().
+POD5_FORMAT_EXPORT pod5::Result<std::shared_ptr<FileReader>> open_file_reader(
+    std::shared_ptr<arrow::fs::FileSystem> const & filesystem,
+    std::string const & path,
+    FileReaderOptions const & options = {});
+
+/// \brief Open a reader on the pod5 file at [uri], eg. "s3://bucket/file.pod5", reading it
+///        through the arrow filesystem for the uri's scheme.
+POD5_FORMAT_EXPORT pod5::Result<std::shared_ptr<FileReader>> open_file_reader_from_uri(
+    std::string const & uri,
+    FileReaderOptions const & options = {});
+
+/// \brief Open a reader on a pod5 file held in memory.
+/// \note Data loaded from the file refers to [buffer], keeping it alive.
+POD5_FORMAT_EXPORT pod5::Result<std::shared_ptr<FileReader>> open_file_reader(
+    std::shared_ptr<arrow::Buffer> const & buffer,
+    FileReaderOptions const & options = {});
+
 }  // namespace pod5
@@ -23,10 +23,9 @@ struct RecoveredData {
     std::size_t recovered_rows = 0;
 };
 
-template <typename DestFileType>
-arrow::Result<RecoveredData> recover_arrow_file(
-    std::shared_ptr<arrow::io::RandomAccessFile> const & file_to_recover,
-    DestFileType const & destination_file)
+/// Open the stream of batches within an arrow file that may not have been completed.
+inline arrow::Result<std::shared_ptr<arrow::ipc::RecordBatchStreamReader>> open_recovery_stream(
+    std::shared_ptr<arrow::io::RandomAccessFile> const & file_to_recover)
 {
     // Check for arrow start file:
     const int32_t magic_size = static_cast<int>(::strlen(kArrowMagicBytes));
@@ -38,8 +37,23 @@ arrow::Result<RecoveredData> recover_arrow_file(
     // Open the stream format within the ipc file:
     ARROW_ASSIGN_OR_RAISE(
         auto input_stream, combined_file_utils::open_sub_file(file_to_recover, 8));
-    ARROW_ASSIGN_OR_RAISE(
-        auto opened_stream, arrow::ipc::RecordBatchStreamReader::Open(input_stream));
+    return arrow::ipc::RecordBatchStreamReader::Open(input_stream);
+}
+
+/// Read the metadata of a file to recover, without recovering any of its batches.
+inline arrow::Result<SchemaMetadataDescription> recover_arrow_file_metadata(
+    std::shared_ptr<arrow::io::RandomAccessFile> const & file_to_recover)
+{
+    ARROW_ASSIGN_OR_RAISE(auto opened_stream, open_recovery_stream(file_to_recover));
+    return read_schema_key_value_metadata(opened_stream->schema()->metadata());
+}
+
+template <typename DestFileType>
+arrow::Result<RecoveredData> recover_arrow_file(
+    std::shared_ptr<arrow::io::RandomAccessFile> const & file_to_recover,
+    DestFileType const & destination_file)
+{
+    ARROW_ASSIGN_OR_RAISE(auto opened_stream, open_recovery_stream(file_to_recover));
 
     auto const & expected_schema = destination_file->schema();
     auto schema = opened_stream->schema();
@@ -3,8 +3,11 @@
 #include "pod5_format/file_reader.h"
 #include "pod5_format/internal/combined_file_utils.h"
 #include "pod5_format/schema_metadata.h"
+#include "pod5_format/signal_compression.h"
+#include "pod5_format/signal_dictionary_table.h"
 
 #include <arrow/io/file.h>
+#include <arrow/io/memory.h>
 #include <boost/uuid/random_generator.hpp>
 
 namespace pod5 {
@@ -49,6 +52,37 @@ pod5::Status update_file(
             combined_file_utils::SubFileCleanup::LeaveOrignalFile,
             section_marker));
 
+    std::vector<combined_file_utils::FileInfo> other_indices;
+    for (auto const & other_index_location : source->other_index_locations()) {
+        ARROW_ASSIGN_OR_RAISE(
+            auto other_index_table,
+            combined_file_utils::write_file_and_marker(
+                pool,
+                main_file,
+                other_index_location,
+                combined_file_utils::SubFileCleanup::LeaveOrignalFile,
+                section_marker));
+        other_indices.push_back(other_index_table);
+    }
+
+    // Signal is copied as is, so keeps needing the dictionary it was compressed with:
+    boost::optional<combined_file_utils::FileInfo> signal_dictionary_table;
+    if (auto const signal_dictionary = source->signal_dictionary()) {
+        ARROW_ASSIGN_OR_RAISE(auto table_metadata, make_schema_key_value_metadata(metadata));
+        ARROW_ASSIGN_OR_RAISE(auto dictionary_stream, arrow::io::BufferOutputStream::Create());
+        ARROW_RETURN_NOT_OK(write_signal_dictionary_table(
+            dictionary_stream, table_metadata, *signal_dictionary, pool));
+        ARROW_ASSIGN_OR_RAISE(auto dictionary_buffer, dictionary_stream->Finish());
+
+        signal_dictionary_table.emplace();
+        ARROW_ASSIGN_OR_RAISE(signal_dictionary_table->file_start_offset, main_file->Tell());
+        ARROW_RETURN_NOT_OK(main_file->Write(dictionary_buffer));
+        signal_dictionary_table->file_length = dictionary_buffer->size();
+
+        ARROW_RETURN_NOT_OK(combined_file_utils::pad_file(main_file, 8));
+        ARROW_RETURN_NOT_OK(combined_file_utils::write_section_marker(main_file, section_marker));
+    }
+
     // Write full file footer:
     ARROW_RETURN_NOT_OK(combined_file_utils::write_footer(
         main_file,
@@ -57,7 +91,9 @@ pod5::Status update_file(
         metadata.writing_software,
         signal_info_table,
         run_info_info_table,
-        reads_info_table));
+        reads_info_table,
+        other_indices,
+        signal_dictionary_table));
 
     return main_file->Close();
 }
@@ -0,0 +1,263 @@
+#include "pod5_format/file_verifier.h"
+
+#include "pod5_format/file_reader.h"
+#include "pod5_format/read_batch_view.h"
+#include "pod5_format/signal_table_reader.h"
+#include "pod5_format/thread_pool.h"
+
+#include <arrow/array/array_primitive.h>
+#include <boost/uuid/uuid_io.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+namespace pod5 {
+
+namespace {
+
+class ErrorList {
+public:
+    void add(std::string error)
+    {
+        error_count += 1;
+        if (errors.size() < FileVerificationReport::MAX_REPORTED_ERRORS) {
+            errors.emplace_back(std::move(error));
+        }
+    }
+
+    void merge(ErrorList && other)
+    {
+        error_count += other.error_count;
+        for (auto & error : other.errors) {
+            if (errors.size() >= FileVerificationReport::MAX_REPORTED_ERRORS) {
+                break;
+            }
+            errors.emplace_back(std::move(error));
+        }
+    }
+
+    std::size_t error_count = 0;
+    std::vector<std::string> errors;
+};
+
+struct SignalBatchSummary {
+    bool loaded = false;
+    std::size_t row_count = 0;
+    std::vector<std::uint32_t> sample_counts;
+};
+
+struct DecodeTotals {
+    std::uint64_t sample_count = 0;
+    std::uint64_t signal_byte_count = 0;
+    ErrorList errors;
+    BatchChecksumReport batch_checksums;
+};
+
+/// Decode every row of signal batch [batch_index], recording its row sample counts. If
+/// [verify_batch_checksums] is set the batch is checked against its checksum as it is read.
+void decode_signal_batch(
+    FileReader const & reader,
+    std::size_t batch_index,
+    bool verify_batch_checksums,
+    std::vector<std::int16_t> & samples,
+    SignalBatchSummary & summary,
+    DecodeTotals & totals)
+{
+    auto batch =
+        verify_batch_checksums
+            ? reader.read_and_check_signal_record_batch(batch_index, totals.batch_checksums)
+            : reader.read_signal_record_batch(batch_index);
+    if (!batch.ok()) {
+        totals.errors.add(
+            "Signal batch " + std::to_string(batch_index)
+            + " could not be loaded: " + batch.status().message());
+        return;
+    }
+
+    auto const samples_column = batch->samples_column();
+    summary.loaded = true;
+    summary.row_count = batch->num_rows();
+    summary.sample_counts.resize(summary.row_count);
+    for (std::size_t row = 0; row < summary.row_count; ++row) {
+        summary.sample_counts[row] = samples_column->Value(row);
+
+        // Check the stored count against the stored signal before allocating for it:
+        auto const max_samples = batch->max_samples_in_row(row);
+        if (!max_samples.ok()) {
+            totals.errors.add(
+                "Signal batch " + std::to_string(batch_index) + " row " + std::to_string(row)
+                + " failed to decode: " + max_samples.status().message());
+            continue;
+        }
+        if (summary.sample_counts[row] > *max_samples) {
+            totals.errors.add(
+                "Signal batch " + std::to_string(batch_index) + " row " + std::to_string(row)
+                + " records " + std::to_string(summary.sample_counts[row])
+                + " samples, but its stored signal can hold at most "
+                + std::to_string(*max_samples));
+            continue;
+        }
+
+        samples.resize(summary.sample_counts[row]);
+        auto const status = batch->extract_signal_row(row, gsl::make_span(samples));
+        if (!status.ok()) {
+            totals.errors.add(
+                "Signal batch " + std::to_string(batch_index) + " row " + std::to_string(row)
+                + " failed to decode: " + status.message());
+            continue;
+        }
+
+        totals.sample_count += samples.size();
+        auto const byte_count = batch->samples_byte_count(row);
+        if (byte_count.ok()) {
+            totals.signal_byte_count += *byte_count;
+        }
+    }
+}
+
+}  // namespace
+
+Result<FileVerificationReport> verify_file(
+    FileReader const & reader,
+    std::size_t worker_count,
+    bool verify_batch_checksums)
+{
+    auto const start = std::chrono::steady_clock::now();
+    if (worker_count == 0) {
+        worker_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Batch checksums are checked as the read and signal batches are read, so each batch is only
+    // read once:
+    FileVerificationReport report;
+    if (verify_batch_checksums) {
+        reader.check_run_info_batch_checksums(report.batch_checksums);
+    }
+
+    ErrorList errors;
+
+    // Decode every signal batch, each worker taking the next undecoded batch:
+    std::size_t const signal_batch_count = reader.num_signal_record_batches();
+    std::vector<SignalBatchSummary> signal_batches(signal_batch_count);
+    {
+        std::atomic<std::size_t> next_batch{0};
+        std::mutex totals_mutex;
+        DecodeTotals totals;
+
+        auto const decode_batches = [&] {
+            DecodeTotals worker_totals;
+            std::vector<std::int16_t> samples;
+            for (std::size_t i = next_batch++; i < signal_batch_count; i = next_batch++) {
+                decode_signal_batch(
+                    reader,
+                    i,
+                    verify_batch_checksums,
+                    samples,
+                    signal_batches[i],
+                    worker_totals);
+            }
+
+            std::lock_guard<std::mutex> l(totals_mutex);
+            totals.sample_count += worker_totals.sample_count;
+            totals.signal_byte_count += worker_totals.signal_byte_count;
+            totals.errors.merge(std::move(worker_totals.errors));
+            totals.batch_checksums.merge(std::move(worker_totals.batch_checksums));
+        };
+
+        // The calling thread decodes too, alongside workers from the shared library pool:
+        run_on_workers(
+            *shared_thread_pool(),
+            std::min(worker_count, std::max<std::size_t>(1, signal_batch_count)),
+            decode_batches);
+
+        report.sample_count = totals.sample_count;
+        report.signal_byte_count = totals.signal_byte_count;
+        errors.merge(std::move(totals.errors));
+        report.batch_checksums.merge(std::move(totals.batch_checksums));
+    }
+
+    // Readers locate signal rows assuming every batch but the last holds the same number of rows:
+    std::size_t const expected_batch_rows =
+        signal_batch_count > 0 && signal_batches[0].loaded ? signal_batches[0].row_count : 0;
+    std::vector<std::uint64_t> batch_first_row(signal_batch_count + 1, 0);
+    for (std::size_t i = 0; i < signal_batch_count; ++i) {
+        auto & batch = signal_batches[i];
+        if (!batch.loaded) {
+            batch.row_count = expected_batch_rows;
+        } else if (i + 1 < signal_batch_count && batch.row_count != expected_batch_rows) {
+            errors.add(
+                "Signal batch " + std::to_string(i) + " holds " + std::to_string(batch.row_count)
+                + " rows, expected " + std::to_string(expected_batch_rows));
+        }
+        batch_first_row[i + 1] = batch_first_row[i] + batch.row_count;
+    }
+    std::uint64_t const signal_row_count = batch_first_row.back();
+    report.signal_row_count = signal_row_count;
+
+    // Check every read's references into the signal table:
+    std::vector<bool> referenced(signal_row_count, false);
+    for (std::size_t batch_index = 0; batch_index < reader.num_read_record_batches();
+         ++batch_index)
+    {
+        ARROW_ASSIGN_OR_RAISE(
+            auto read_batch,
+            verify_batch_checksums
+                ? reader.read_and_check_read_record_batch(batch_index, report.batch_checksums)
+                : reader.read_read_record_batch(batch_index));
+        ARROW_ASSIGN_OR_RAISE(auto view, LatestReadBatchView::make(read_batch));
+
+        for (std::size_t row = 0; row < view.num_rows(); ++row) {
+            report.read_count += 1;
+
+            std::uint64_t sample_count = 0;
+            bool sample_count_known = true;
+            for (auto const signal_row : view.signal_rows(row)) {
+                if (signal_row >= signal_row_count) {
+                    errors.add(
+                        "Read " + boost::uuids::to_string(view.read_id(row))
+                        + " refers to signal row " + std::to_string(signal_row) + ", beyond the "
+                        + std::to_string(signal_row_count) + " rows of the signal table");
+                    sample_count_known = false;
+                    continue;
+                }
+                if (referenced[signal_row]) {
+                    errors.add(
+                        "Read " + boost::uuids::to_string(view.read_id(row))
+                        + " refers to signal row " + std::to_string(signal_row)
+                        + ", which belongs to another read");
+                }
+                referenced[signal_row] = true;
+
+                auto const it = std::upper_bound(
+                    batch_first_row.begin(), batch_first_row.end(), signal_row);
+                auto const signal_batch = std::size_t(it - batch_first_row.begin()) - 1;
+                auto const & summary = signal_batches[signal_batch];
+                if (!summary.loaded) {
+                    sample_count_known = false;
+                    continue;
+                }
+                sample_count += summary.sample_counts[signal_row - batch_first_row[signal_batch]];
+            }
+
+            if (sample_count_known && sample_count != view.num_samples(row)) {
+                errors.add(
+                    "Read " + boost::uuids::to_string(view.read_id(row)) + " records "
+                    + std::to_string(view.num_samples(row)) + " samples, but its signal holds "
+                    + std::to_string(sample_count));
+            }
+        }
+    }
+
+    std::sort(report.batch_checksums.failures.begin(), report.batch_checksums.failures.end());
+    report.unreferenced_signal_row_count = std::count(referenced.begin(), referenced.end(), false);
+    report.error_count = errors.error_count;
+    report.errors = std::move(errors.errors);
+    report.elapsed_seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return report;
+}
+
+}  // namespace pod5
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "pod5_format/batch_checksum.h"
+#include "pod5_format/pod5_format_export.h"
+#include "pod5_format/result.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace pod5 {
+
+class FileReader;
+
+/// \brief Outcome of a full integrity scrub of a file.
+struct FileVerificationReport {
+    /// Maximum number of error descriptions kept, further errors are only counted.
+    static constexpr std::size_t MAX_REPORTED_ERRORS = 100;
+
+    /// Result of checking the table batches against their stored checksums, empty if skipped.
+    BatchChecksumReport batch_checksums;
+
+    /// Number of reads checked in the read table.
+    std::size_t read_count = 0;
+    /// Number of rows decoded from the signal table.
+    std::size_t signal_row_count = 0;
+    /// Number of signal rows not referenced by any read.
+    std::size_t unreferenced_signal_row_count = 0;
+    /// Total number of samples decoded.
+    std::uint64_t sample_count = 0;
+    /// Total size of the stored signal data decoded.
+    std::uint64_t signal_byte_count = 0;
+    /// Wall clock time taken by the scrub.
+    double elapsed_seconds = 0;
+
+    /// Number of integrity errors found, excluding checksum failures.
+    std::size_t error_count = 0;
+    /// Descriptions of the first MAX_REPORTED_ERRORS integrity errors.
+    std::vector<std::string> errors;
+
+    bool ok() const { return error_count == 0 && batch_checksums.ok(); }
+};
+
+/// \brief Check the integrity of every read and signal row in a file.
+/// \details Every signal row is decoded, spread across [worker_count] threads of the shared pool,
+///          and the decoded length checked against the row's stored sample count (which must fit
+///          the stored signal). The read table is then checked: every signal row a read refers
+///          to must exist and belong to no other read, and the read's num_samples must equal the
+///          sample counts of its rows.
+/// \param worker_count             Number of threads to decode with, 0 uses one per core.
+/// \param verify_batch_checksums   Also check every table batch against its stored checksum, from
+///                                 the same bytes the batch is decoded from.
+/// \returns The report of the scrub, an error status only if the file could not be scrubbed.
+POD5_FORMAT_EXPORT Result<FileVerificationReport> verify_file(
+    FileReader const & reader,
+    std::size_t worker_count = 0,
+    bool verify_batch_checksums = true);
+
+}  // namespace pod5
@@ -1,18 +1,26 @@
 #include "pod5_format/file_writer.h"
 
+#include "pod5_format/channel_index_table_writer.h"
 #include "pod5_format/file_recovery.h"
 #include "pod5_format/internal/async_output_stream.h"
 #include "pod5_format/internal/combined_file_utils.h"
+#include "pod5_format/internal/stream_file_utils.h"
 #include "pod5_format/read_table_reader.h"
 #include "pod5_format/read_table_writer.h"
 #include "pod5_format/read_table_writer_utils.h"
 #include "pod5_format/run_info_table_writer.h"
 #include "pod5_format/schema_metadata.h"
+#include "pod5_format/signal_compression.h"
+#include "pod5_format/signal_dictionary_table.h"
+#include "pod5_format/signal_statistics.h"
+#include "pod5_format/signal_summary_table_writer.h"
 #include "pod5_format/signal_table_writer.h"
 #include "pod5_format/thread_pool.h"
 #include "pod5_format/version.h"
 
+#include <arrow/array/array_primitive.h>
 #include <arrow/io/file.h>
+#include <arrow/io/memory.h>
 #include <arrow/memory_pool.h>
 #include <arrow/result.h>
 #include <arrow/util/future.h>
@@ -20,7 +28,9 @@
 #include <boost/optional/optional.hpp>
 #include <boost/uuid/random_generator.hpp>
 
+#include <algorithm>
 #include <iostream>
+#include <map>
 
 #ifdef __linux__
 #include <fcntl.h>
@@ -84,6 +94,16 @@ FileWriterOptions::FileWriterOptions()
 , m_read_table_batch_size(DEFAULT_READ_TABLE_BATCH_SIZE)
 , m_run_info_table_batch_size(DEFAULT_RUN_INFO_TABLE_BATCH_SIZE)
 , m_use_directio{DEFAULT_USE_DIRECTIO}
+, m_signal_summary_bin_size(DEFAULT_SIGNAL_SUMMARY_BIN_SIZE)
+, m_write_channel_index(DEFAULT_WRITE_CHANNEL_INDEX)
+, m_write_signal_statistics(DEFAULT_WRITE_SIGNAL_STATISTICS)
+, m_signal_batch_alignment(DEFAULT_SIGNAL_BATCH_ALIGNMENT)
+, m_signal_compression_level(DEFAULT_VBZ_COMPRESSION_LEVEL)
+, m_signal_dictionary_training_size(DEFAULT_SIGNAL_DICTIONARY_TRAINING_SIZE)
+, m_signal_dictionary_max_size(DEFAULT_SIGNAL_DICTIONARY_MAX_SIZE)
+, m_adaptive_signal_compression(false)
+, m_adaptive_signal_compression_min_level(DEFAULT_VBZ_COMPRESSION_LEVEL)
+, m_adaptive_signal_compression_max_level(DEFAULT_VBZ_COMPRESSION_LEVEL)
 {
 }
 
@@ -102,12 +122,16 @@ public:
         RunInfoTableWriter && run_info_table_writer,
         ReadTableWriter && read_table_writer,
         SignalTableWriter && signal_table_writer,
+        boost::optional<SignalSummaryTableWriter> && signal_summary_table_writer,
+        boost::optional<ChannelIndexWriter> && channel_index_writer,
         std::uint32_t signal_chunk_size,
         arrow::MemoryPool * pool)
     : m_read_table_dict_writers(std::move(read_table_dict_writers))
     , m_run_info_table_writer(std::move(run_info_table_writer))
     , m_read_table_writer(std::move(read_table_writer))
     , m_signal_table_writer(std::move(signal_table_writer))
+    , m_signal_summary_table_writer(std::move(signal_summary_table_writer))
+    , m_channel_index_writer(std::move(channel_index_writer))
     , m_signal_chunk_size(signal_chunk_size)
     , m_pool(pool)
     {
@@ -130,7 +154,16 @@ public:
     pod5::Result<RunInfoDictionaryIndex> add_run_info(RunInfoData const & run_info_data)
     {
         ARROW_RETURN_NOT_OK(m_run_info_table_writer->add_run_info(run_info_data));
-        return m_read_table_dict_writers.run_info_writer->add(run_info_data.acquisition_id);
+        ARROW_ASSIGN_OR_RAISE(
+            auto index,
+            m_read_table_dict_writers.run_info_writer->add(run_info_data.acquisition_id));
+
+        // Remember the digitiser range, to count saturated samples in reads for this run:
+        if (m_run_info_adc_ranges.size() <= std::size_t(index)) {
+            m_run_info_adc_ranges.resize(index + 1);
+        }
+        m_run_info_adc_ranges[index] = std::make_pair(run_info_data.adc_min, run_info_data.adc_max);
+        return index;
     }
 
     pod5::Status add_complete_read(
@@ -143,13 +176,30 @@ public:
 
         ARROW_RETURN_NOT_OK(check_read(read_data));
 
+        bool const write_statistics = m_read_table_writer->writes_signal_statistics();
+        SignalStatisticsAccumulator statistics;
+        if (write_statistics && std::size_t(read_data.run_info) < m_run_info_adc_ranges.size()) {
+            auto const & adc_range = m_run_info_adc_ranges[read_data.run_info];
+            statistics = SignalStatisticsAccumulator(adc_range.first, adc_range.second);
+        }
+
         ARROW_ASSIGN_OR_RAISE(
-            std::vector<std::uint64_t> signal_rows, add_signal(read_data.read_id, signal));
+            std::vector<std::uint64_t> signal_rows,
+            add_signal(read_data.read_id, signal, write_statistics ? &statistics : nullptr));
+
+        if (m_signal_summary_table_writer) {
+            ARROW_RETURN_NOT_OK(
+                m_signal_summary_table_writer->add_read_summary(read_data.read_id, signal));
+        }
 
         // Write read data and signal row entries:
         auto read_table_row = m_read_table_writer->add_read(
-            read_data, gsl::make_span(signal_rows.data(), signal_rows.size()), signal.size());
-        return read_table_row.status();
+            read_data,
+            gsl::make_span(signal_rows.data(), signal_rows.size()),
+            signal.size(),
+            write_statistics ? boost::make_optional(statistics.statistics()) : boost::none);
+        ARROW_RETURN_NOT_OK(read_table_row);
+        return add_channel_index_entry(read_data, *read_table_row);
     }
 
     pod5::Status add_complete_read(
@@ -166,7 +216,22 @@ public:
         // Write read data and signal row entries:
         auto read_table_row =
             m_read_table_writer->add_read(read_data, signal_rows, signal_duration);
-        return read_table_row.status();
+        ARROW_RETURN_NOT_OK(read_table_row);
+        return add_channel_index_entry(read_data, *read_table_row);
+    }
+
+    arrow::Status add_channel_index_entry(ReadData const & read_data, std::size_t read_table_row)
+    {
+        if (m_channel_index_writer) {
+            auto const batch_size = m_read_table_writer->table_batch_size();
+            m_channel_index_writer->add_read(
+                read_data.channel,
+                read_data.start_sample,
+                read_data.read_number,
+                read_table_row / batch_size,
+                read_table_row % batch_size);
+        }
+        return arrow::Status::OK();
     }
 
     arrow::Status check_read(ReadData const & read_data)
@@ -188,7 +253,8 @@ public:
 
     pod5::Result<std::vector<SignalTableRowIndex>> add_signal(
         boost::uuids::uuid const & read_id,
-        gsl::span<std::int16_t const> const & signal)
+        gsl::span<std::int16_t const> const & signal,
+        SignalStatisticsAccumulator * statistics = nullptr)
     {
         if (!m_signal_table_writer || !m_read_table_writer) {
             return arrow::Status::Invalid("File writer closed, cannot write further data");
@@ -204,11 +270,16 @@ public:
                 std::min<std::size_t>(signal.size() - chunk_start, m_signal_chunk_size);
 
             auto const chunk_span = signal.subspan(chunk_start, chunk_size);
+            if (statistics) {
+                // Gather statistics while the chunk is hot in cache for compression:
+                statistics->add(chunk_span);
+            }
 
             ARROW_ASSIGN_OR_RAISE(
                 auto row_index, m_signal_table_writer->add_signal(read_id, chunk_span));
             signal_rows.push_back(row_index);
         }
+        ARROW_RETURN_NOT_OK(check_signal_dictionary());
         return signal_rows;
     }
 
@@ -221,8 +292,11 @@ public:
             return arrow::Status::Invalid("File writer closed, cannot write further data");
         }
 
-        return m_signal_table_writer->add_pre_compressed_signal(
-            read_id, signal_bytes, sample_count);
+        ARROW_ASSIGN_OR_RAISE(
+            auto row_index,
+            m_signal_table_writer->add_pre_compressed_signal(read_id, signal_bytes, sample_count));
+        ARROW_RETURN_NOT_OK(check_signal_dictionary());
+        return row_index;
     }
 
     pod5::Result<std::pair<SignalTableRowIndex, SignalTableRowIndex>> add_signal_batch(
@@ -234,7 +308,11 @@ public:
             return arrow::Status::Invalid("File writer closed, cannot write further data");
         }
 
-        return m_signal_table_writer->add_signal_batch(row_count, std::move(columns), final_batch);
+        ARROW_ASSIGN_OR_RAISE(
+            auto rows,
+            m_signal_table_writer->add_signal_batch(row_count, std::move(columns), final_batch));
+        ARROW_RETURN_NOT_OK(check_signal_dictionary());
+        return rows;
     }
 
     SignalType signal_type() const { return m_signal_table_writer->signal_type(); }
@@ -244,10 +322,19 @@ public:
         return m_signal_table_writer->table_batch_size();
     }
 
+    SignalCompressionMetrics signal_compression_metrics() const
+    {
+        if (m_signal_table_writer) {
+            return m_signal_table_writer->compression_metrics();
+        }
+        return m_closed_signal_compression_metrics;
+    }
+
     pod5::Status close_run_info_table_writer()
     {
         if (m_run_info_table_writer) {
             ARROW_RETURN_NOT_OK(m_run_info_table_writer->close());
+            m_run_info_batch_checksums = m_run_info_table_writer->batch_checksums();
             m_run_info_table_writer = boost::none;
         }
         return pod5::Status::OK();
@@ -257,6 +344,7 @@ public:
     {
         if (m_read_table_writer) {
             ARROW_RETURN_NOT_OK(m_read_table_writer->close());
+            m_read_batch_checksums = m_read_table_writer->batch_checksums();
             m_read_table_writer = boost::none;
         }
         return pod5::Status::OK();
@@ -266,13 +354,53 @@ public:
     {
         if (m_signal_table_writer) {
             ARROW_RETURN_NOT_OK(m_signal_table_writer->close());
+            // Closing may complete training of a dictionary:
+            ARROW_RETURN_NOT_OK(check_signal_dictionary());
+            m_closed_signal_compression_metrics = m_signal_table_writer->compression_metrics();
+            m_signal_batch_checksums = m_signal_table_writer->batch_checksums();
             m_signal_table_writer = boost::none;
         }
         return pod5::Status::OK();
     }
 
+    pod5::Status close_signal_summary_table_writer()
+    {
+        if (m_signal_summary_table_writer) {
+            ARROW_RETURN_NOT_OK(m_signal_summary_table_writer->close());
+            m_signal_summary_table_writer = boost::none;
+        }
+        return pod5::Status::OK();
+    }
+
+    /// \brief Take the channel index writer, if one is in use, so it can be written on close.
+    boost::optional<ChannelIndexWriter> release_channel_index_writer()
+    {
+        auto result = std::move(m_channel_index_writer);
+        m_channel_index_writer = boost::none;
+        return result;
+    }
+
     virtual arrow::Status close() = 0;
 
+    /// \brief Find the batch checksums of each closed table, stored by the file footer.
+    std::vector<BatchChecksum> const & run_info_batch_checksums() const
+    {
+        return m_run_info_batch_checksums;
+    }
+
+    std::vector<BatchChecksum> const & read_batch_checksums() const
+    {
+        return m_read_batch_checksums;
+    }
+
+    std::vector<BatchChecksum> const & signal_batch_checksums() const
+    {
+        return m_signal_batch_checksums;
+    }
+
+    /// \brief Store the dictionary signal is compressed with, called once it is known.
+    virtual arrow::Status store_signal_dictionary(VbzDictionary const & dictionary) = 0;
+
     bool is_closed() const
     {
         assert(!!m_read_table_writer == !!m_signal_table_writer);
@@ -289,12 +417,44 @@ public:
         return m_run_info_table_writer.get_ptr();
     }
 
-    ReadTableWriter * read_table_writer()
+    std::shared_ptr<arrow::Schema> const & read_table_schema() const
+    {
+        return m_read_table_writer->schema();
+    }
+
+    /// \brief Write a batch of read table rows as is, such as rows recovered from another file,
+    ///        recording each row in the channel index like reads added one at a time.
+    arrow::Status write_read_table_batch(arrow::RecordBatch const & batch)
     {
         if (is_closed()) {
-            return nullptr;
+            return arrow::Status::Invalid("File writer closed, cannot write further data");
+        }
+
+        auto const batch_index = m_read_table_writer->written_batch_count();
+        ARROW_RETURN_NOT_OK(m_read_table_writer->write_batch(batch));
+        if (!m_channel_index_writer) {
+            return arrow::Status::OK();
+        }
+
+        auto const & fields = *m_read_table_writer->field_locations();
+        auto const channel = std::dynamic_pointer_cast<arrow::UInt16Array>(
+            batch.GetColumnByName(fields.channel.name()));
+        auto const start = std::dynamic_pointer_cast<arrow::UInt64Array>(
+            batch.GetColumnByName(fields.start.name()));
+        auto const read_number = std::dynamic_pointer_cast<arrow::UInt32Array>(
+            batch.GetColumnByName(fields.read_number.name()));
+        if (!channel || !start || !read_number) {
+            return arrow::Status::Invalid("Read table batch is missing channel index columns");
         }
-        return m_read_table_writer.get_ptr();
+        for (std::int64_t row = 0; row < batch.num_rows(); ++row) {
+            m_channel_index_writer->add_read(
+                channel->Value(row),
+                start->Value(row),
+                read_number->Value(row),
+                std::uint32_t(batch_index),
+                std::uint32_t(row));
+        }
+        return arrow::Status::OK();
     }
 
     SignalTableWriter * signal_table_writer()
@@ -306,12 +466,36 @@ public:
     }
 
 private:
+    arrow::Status check_signal_dictionary()
+    {
+        if (m_signal_dictionary_stored) {
+            return arrow::Status::OK();
+        }
+        auto const dictionary = m_signal_table_writer->vbz_dictionary();
+        if (!dictionary) {
+            return arrow::Status::OK();
+        }
+        m_signal_dictionary_stored = true;
+        return store_signal_dictionary(*dictionary);
+    }
+
     DictionaryWriters m_read_table_dict_writers;
     boost::optional<RunInfoTableWriter> m_run_info_table_writer;
     boost::optional<ReadTableWriter> m_read_table_writer;
     boost::optional<SignalTableWriter> m_signal_table_writer;
+    SignalCompressionMetrics m_closed_signal_compression_metrics;
+    std::vector<BatchChecksum> m_run_info_batch_checksums;
+    std::vector<BatchChecksum> m_read_batch_checksums;
+    std::vector<BatchChecksum> m_signal_batch_checksums;
+    boost::optional<SignalSummaryTableWriter> m_signal_summary_table_writer;
+    boost::optional<ChannelIndexWriter> m_channel_index_writer;
     std::uint32_t m_signal_chunk_size;
     arrow::MemoryPool * m_pool;
+
+    // adc_min/adc_max of each run info added, indexed by run info dictionary index.
+    std::vector<std::pair<std::int16_t, std::int16_t>> m_run_info_adc_ranges;
+
+    bool m_signal_dictionary_stored = false;
 };
 
 class CombinedFileWriterImpl : public FileWriterImpl {
@@ -320,14 +504,19 @@ public:
         std::string const & path,
         std::string const & run_info_tmp_path,
         std::string const & reads_tmp_path,
+        std::string const & signal_summary_tmp_path,
+        std::string const & signal_dictionary_tmp_path,
         std::int64_t signal_file_start_offset,
         boost::uuids::uuid const & section_marker,
         boost::uuids::uuid const & file_identifier,
         std::string const & software_name,
+        std::shared_ptr<const arrow::KeyValueMetadata> const & file_schema_metadata,
         DictionaryWriters && dict_writers,
         RunInfoTableWriter && run_info_table_writer,
         ReadTableWriter && read_table_writer,
         SignalTableWriter && signal_table_writer,
+        boost::optional<SignalSummaryTableWriter> && signal_summary_table_writer,
+        boost::optional<ChannelIndexWriter> && channel_index_writer,
         std::uint32_t signal_chunk_size,
         arrow::MemoryPool * pool)
     : FileWriterImpl(
@@ -335,15 +524,20 @@ public:
         std::move(run_info_table_writer),
         std::move(read_table_writer),
         std::move(signal_table_writer),
+        std::move(signal_summary_table_writer),
+        std::move(channel_index_writer),
         signal_chunk_size,
         pool)
     , m_path(path)
     , m_run_info_tmp_path(run_info_tmp_path)
     , m_reads_tmp_path(reads_tmp_path)
+    , m_signal_summary_tmp_path(signal_summary_tmp_path)
+    , m_signal_dictionary_tmp_path(signal_dictionary_tmp_path)
     , m_signal_file_start_offset(signal_file_start_offset)
     , m_section_marker(section_marker)
     , m_file_identifier(file_identifier)
     , m_software_name(software_name)
+    , m_file_schema_metadata(file_schema_metadata)
     {
     }
 
@@ -357,6 +551,8 @@ public:
         ARROW_RETURN_NOT_OK(close_run_info_table_writer());
         ARROW_RETURN_NOT_OK(close_read_table_writer());
         ARROW_RETURN_NOT_OK(close_signal_table_writer());
+        ARROW_RETURN_NOT_OK(close_signal_summary_table_writer());
+        auto channel_index_writer = release_channel_index_writer();
 
         // Open main path with append set:
         ARROW_ASSIGN_OR_RAISE(auto file, arrow::io::FileOutputStream::Open(m_path, true));
@@ -366,6 +562,7 @@ public:
         signal_table.file_start_offset = m_signal_file_start_offset;
         ARROW_ASSIGN_OR_RAISE(signal_table.file_length, file->Tell());
         signal_table.file_length -= signal_table.file_start_offset;
+        signal_table.batch_checksums = signal_batch_checksums();
 
         // pad file to 8 bytes and mark section:
         ARROW_RETURN_NOT_OK(combined_file_utils::pad_file(file, 8));
@@ -381,6 +578,7 @@ public:
         // Write in run_info table:
         ARROW_ASSIGN_OR_RAISE(
             auto run_info_location, file_location_for_full_file(m_run_info_tmp_path));
+        run_info_location.batch_checksums = run_info_batch_checksums();
         ARROW_ASSIGN_OR_RAISE(
             auto run_info_info_table,
             combined_file_utils::write_file_and_marker(
@@ -392,6 +590,7 @@ public:
 
         // Write in read table:
         ARROW_ASSIGN_OR_RAISE(auto reads_location, file_location_for_full_file(m_reads_tmp_path));
+        reads_location.batch_checksums = read_batch_checksums();
         ARROW_ASSIGN_OR_RAISE(
             auto reads_info_table,
             combined_file_utils::write_file_and_marker(
@@ -401,6 +600,53 @@ public:
                 combined_file_utils::SubFileCleanup::CleanupOriginalFile,
                 m_section_marker));
 
+        // Write in any indexes:
+        std::vector<combined_file_utils::FileInfo> other_indices;
+        if (!m_signal_summary_tmp_path.empty()) {
+            ARROW_ASSIGN_OR_RAISE(
+                auto signal_summary_location,
+                file_location_for_full_file(m_signal_summary_tmp_path));
+            ARROW_ASSIGN_OR_RAISE(
+                auto signal_summary_table,
+                combined_file_utils::write_file_and_marker(
+                    pool(),
+                    file,
+                    signal_summary_location,
+                    combined_file_utils::SubFileCleanup::CleanupOriginalFile,
+                    m_section_marker));
+            other_indices.push_back(signal_summary_table);
+        }
+        if (channel_index_writer) {
+            // The index is only sorted once all reads are known, so it is built in memory here:
+            ARROW_ASSIGN_OR_RAISE(auto index_stream, arrow::io::BufferOutputStream::Create());
+            ARROW_RETURN_NOT_OK(channel_index_writer->write(index_stream, m_file_schema_metadata));
+            ARROW_ASSIGN_OR_RAISE(auto index_buffer, index_stream->Finish());
+
+            combined_file_utils::FileInfo channel_index_table;
+            ARROW_ASSIGN_OR_RAISE(channel_index_table.file_start_offset, file->Tell());
+            ARROW_RETURN_NOT_OK(file->Write(index_buffer));
+            channel_index_table.file_length = index_buffer->size();
+
+            ARROW_RETURN_NOT_OK(combined_file_utils::pad_file(file, 8));
+            ARROW_RETURN_NOT_OK(combined_file_utils::write_section_marker(file, m_section_marker));
+            other_indices.push_back(channel_index_table);
+        }
+
+        boost::optional<combined_file_utils::FileInfo> signal_dictionary_table;
+        if (m_signal_dictionary_written) {
+            ARROW_ASSIGN_OR_RAISE(
+                auto signal_dictionary_location,
+                file_location_for_full_file(m_signal_dictionary_tmp_path));
+            ARROW_ASSIGN_OR_RAISE(
+                signal_dictionary_table,
+                combined_file_utils::write_file_and_marker(
+                    pool(),
+                    file,
+                    signal_dictionary_location,
+                    combined_file_utils::SubFileCleanup::CleanupOriginalFile,
+                    m_section_marker));
+        }
+
         // Write full file footer:
         ARROW_RETURN_NOT_OK(combined_file_utils::write_footer(
             file,
@@ -409,7 +655,21 @@ public:
             m_software_name,
             signal_table,
             run_info_info_table,
-            reads_info_table));
+            reads_info_table,
+            other_indices,
+            signal_dictionary_table));
+        return arrow::Status::OK();
+    }
+
+    arrow::Status store_signal_dictionary(VbzDictionary const & dictionary) override
+    {
+        // Written as soon as it is known, so signal compressed with it can be recovered:
+        ARROW_ASSIGN_OR_RAISE(
+            auto dictionary_file, arrow::io::FileOutputStream::Open(m_signal_dictionary_tmp_path));
+        ARROW_RETURN_NOT_OK(write_signal_dictionary_table(
+            dictionary_file, m_file_schema_metadata, dictionary, pool()));
+        ARROW_RETURN_NOT_OK(dictionary_file->Close());
+        m_signal_dictionary_written = true;
         return arrow::Status::OK();
     }
 
@@ -417,10 +677,96 @@ private:
     std::string m_path;
     std::string m_run_info_tmp_path;
     std::string m_reads_tmp_path;
+    std::string m_signal_summary_tmp_path;
+    std::string m_signal_dictionary_tmp_path;
+    bool m_signal_dictionary_written = false;
     std::int64_t m_signal_file_start_offset;
     boost::uuids::uuid m_section_marker;
     boost::uuids::uuid m_file_identifier;
     std::string m_software_name;
+    std::shared_ptr<const arrow::KeyValueMetadata> m_file_schema_metadata;
+};
+
+class StreamFileWriterImpl : public FileWriterImpl {
+public:
+    StreamFileWriterImpl(
+        std::shared_ptr<arrow::io::OutputStream> const & sink,
+        std::vector<std::shared_ptr<arrow::io::OutputStream>> && table_streams,
+        boost::uuids::uuid const & file_identifier,
+        std::string const & software_name,
+        std::shared_ptr<const arrow::KeyValueMetadata> const & file_schema_metadata,
+        DictionaryWriters && dict_writers,
+        RunInfoTableWriter && run_info_table_writer,
+        ReadTableWriter && read_table_writer,
+        SignalTableWriter && signal_table_writer,
+        boost::optional<SignalSummaryTableWriter> && signal_summary_table_writer,
+        boost::optional<ChannelIndexWriter> && channel_index_writer,
+        std::uint32_t signal_chunk_size,
+        arrow::MemoryPool * pool)
+    : FileWriterImpl(
+        std::move(dict_writers),
+        std::move(run_info_table_writer),
+        std::move(read_table_writer),
+        std::move(signal_table_writer),
+        std::move(signal_summary_table_writer),
+        std::move(channel_index_writer),
+        signal_chunk_size,
+        pool)
+    , m_sink(sink)
+    , m_table_streams(std::move(table_streams))
+    , m_file_identifier(file_identifier)
+    , m_software_name(software_name)
+    , m_file_schema_metadata(file_schema_metadata)
+    {
+    }
+
+    std::string path() const override { return {}; }
+
+    arrow::Status close() override
+    {
+        if (is_closed()) {
+            return arrow::Status::OK();
+        }
+        ARROW_RETURN_NOT_OK(close_run_info_table_writer());
+        ARROW_RETURN_NOT_OK(close_read_table_writer());
+        ARROW_RETURN_NOT_OK(close_signal_table_writer());
+        ARROW_RETURN_NOT_OK(close_signal_summary_table_writer());
+        if (auto channel_index_writer = release_channel_index_writer()) {
+            auto index_stream = std::make_shared<stream_file_utils::FramedOutputStream>(
+                m_sink, stream_file_utils::StreamSection::ChannelIndexTable);
+            ARROW_RETURN_NOT_OK(channel_index_writer->write(index_stream, m_file_schema_metadata));
+            m_table_streams.push_back(index_stream);
+        }
+
+        // Write out what remains of each table, then mark the stream complete:
+        for (auto const & table_stream : m_table_streams) {
+            ARROW_RETURN_NOT_OK(table_stream->Close());
+        }
+        using stream_file_utils::StreamSection;
+        for (auto const & table :
+             {std::make_pair(StreamSection::RunInfoTable, &run_info_batch_checksums()),
+              std::make_pair(StreamSection::ReadsTable, &read_batch_checksums()),
+              std::make_pair(StreamSection::SignalTable, &signal_batch_checksums())})
+        {
+            ARROW_RETURN_NOT_OK(
+                stream_file_utils::write_batch_checksums(m_sink, table.first, *table.second));
+        }
+        ARROW_RETURN_NOT_OK(
+            stream_file_utils::write_trailer(m_sink, m_file_identifier, m_software_name));
+        return m_sink->Flush();
+    }
+
+    arrow::Status store_signal_dictionary(VbzDictionary const &) override
+    {
+        return arrow::Status::NotImplemented("Signal dictionaries are not supported in streams");
+    }
+
+private:
+    std::shared_ptr<arrow::io::OutputStream> m_sink;
+    std::vector<std::shared_ptr<arrow::io::OutputStream>> m_table_streams;
+    boost::uuids::uuid m_file_identifier;
+    std::string m_software_name;
+    std::shared_ptr<const arrow::KeyValueMetadata> m_file_schema_metadata;
 };
 
 FileWriter::FileWriter(std::unique_ptr<FileWriterImpl> && impl) : m_impl(std::move(impl)) {}
@@ -491,6 +837,11 @@ std::size_t FileWriter::signal_table_batch_size() const
     return m_impl->signal_table_batch_size();
 }
 
+SignalCompressionMetrics FileWriter::signal_compression_metrics() const
+{
+    return m_impl->signal_compression_metrics();
+}
+
 pod5::Result<FileWriterImpl::DictionaryWriters> make_dictionary_writers(arrow::MemoryPool * pool)
 {
     FileWriterImpl::DictionaryWriters writers;
@@ -518,6 +869,64 @@ std::string make_run_info_tmp_path(
            + ("." + boost::uuids::to_string(file_identifier) + ".tmp-run-info");
 }
 
+std::string make_signal_summary_tmp_path(
+    ::arrow::internal::PlatformFilename const & arrow_path,
+    boost::uuids::uuid const & file_identifier)
+{
+    return arrow_path.Parent().ToString() + "/"
+           + ("." + boost::uuids::to_string(file_identifier) + ".tmp-signal-summary");
+}
+
+std::string make_signal_dictionary_tmp_path(
+    ::arrow::internal::PlatformFilename const & arrow_path,
+    boost::uuids::uuid const & file_identifier)
+{
+    return arrow_path.Parent().ToString() + "/"
+           + ("." + boost::uuids::to_string(file_identifier) + ".tmp-signal-dictionary");
+}
+
+/// Load the dictionary [options] give to compress signal with, null if none is given.
+pod5::Result<std::shared_ptr<VbzDictionary const>> load_signal_dictionary(
+    FileWriterOptions const & options)
+{
+    if (!options.signal_dictionary() && options.signal_dictionary_training_size() == 0) {
+        return nullptr;
+    }
+    if (options.signal_type() != SignalType::VbzSignal) {
+        return Status::Invalid("Signal dictionaries are only supported for vbz signal");
+    }
+    if (options.adaptive_signal_compression()) {
+        return Status::Invalid("Adaptive compression levels are not supported with a dictionary");
+    }
+    if (!options.signal_dictionary()) {
+        return nullptr;
+    }
+    return VbzDictionary::make(options.signal_dictionary(), options.signal_compression_level());
+}
+
+/// Apply the signal compression options to [signal_table_writer].
+pod5::Status set_signal_compression(
+    SignalTableWriter & signal_table_writer,
+    FileWriterOptions const & options,
+    std::shared_ptr<VbzDictionary const> const & dictionary)
+{
+    if (signal_table_writer.signal_type() != SignalType::VbzSignal) {
+        return Status::OK();
+    }
+    ARROW_RETURN_NOT_OK(
+        signal_table_writer.set_vbz_compression(options.signal_compression_level(), dictionary));
+    if (!dictionary && options.signal_dictionary_training_size() > 0) {
+        ARROW_RETURN_NOT_OK(signal_table_writer.train_vbz_dictionary(
+            options.signal_dictionary_training_size(), options.signal_dictionary_max_size()));
+    }
+    if (options.adaptive_signal_compression()) {
+        return signal_table_writer.set_adaptive_vbz_compression(
+            options.adaptive_signal_compression_min_level(),
+            options.adaptive_signal_compression_max_level());
+    }
+    return Status::OK();
+}
+
 pod5::Result<std::unique_ptr<FileWriter>> create_file_writer(
     std::string const & path,
     std::string const & writing_software_name,
@@ -527,6 +936,11 @@ pod5::Result<std::unique_ptr<FileWriter>> create_file_writer(
     if (!pool) {
         return Status::Invalid("Invalid memory pool specified for file writer");
     }
+    if (options.signal_batch_alignment() % 8 != 0) {
+        return Status::Invalid(
+            "Signal batch alignment must be a multiple of 8 bytes, not ",
+            options.signal_batch_alignment());
+    }
 
     auto thread_pool = options.thread_pool();
     if (!thread_pool) {
@@ -539,6 +953,8 @@ pod5::Result<std::unique_ptr<FileWriter>> create_file_writer(
         return Status::Invalid("Unable to create new file '", path, "', already exists");
     }
 
+    ARROW_ASSIGN_OR_RAISE(auto signal_dictionary, load_signal_dictionary(options));
+
     // Open dictionary writers:
     ARROW_ASSIGN_OR_RAISE(auto dict_writers, make_dictionary_writers(pool));
 
@@ -569,7 +985,8 @@ pod5::Result<std::unique_ptr<FileWriter>> create_file_writer(
             dict_writers.pore_writer,
             dict_writers.end_reason_writer,
             dict_writers.run_info_writer,
-            pool));
+            pool,
+            options.write_signal_statistics()));
 
     // Prepare the temporary run_info file:
     auto run_info_table_file_async = ::makeAsyncStream(
@@ -583,6 +1000,29 @@ pod5::Result<std::unique_ptr<FileWriter>> create_file_writer(
             options.run_info_table_batch_size(),
             pool));
 
+    // Prepare the optional temporary signal summary file:
+    std::string signal_summary_tmp_path;
+    boost::optional<SignalSummaryTableWriter> signal_summary_table_tmp_writer;
+    if (options.signal_summary_bin_size() > 0) {
+        signal_summary_tmp_path = make_signal_summary_tmp_path(arrow_path, file_identifier);
+        auto signal_summary_table_file_async = ::makeAsyncStream(
+            ::Open(signal_summary_tmp_path, false, use_directio), thread_pool, use_directio);
+
+        ARROW_ASSIGN_OR_RAISE(
+            signal_summary_table_tmp_writer,
+            make_signal_summary_table_writer(
+                signal_summary_table_file_async,
+                file_schema_metadata,
+                options.signal_summary_bin_size(),
+                options.read_table_batch_size(),
+                pool));
+    }
+
+    boost::optional<ChannelIndexWriter> channel_index_writer;
+    if (options.write_channel_index()) {
+        channel_index_writer.emplace(options.read_table_batch_size(), pool);
+    }
+
     // Prepare the main file - and set up the signal table to write here:
     auto signal_file =
         ::makeAsyncStream(::Open(path, false, use_directio), thread_pool, use_directio);
@@ -602,25 +1042,340 @@ pod5::Result<std::unique_ptr<FileWriter>> create_file_writer(
             file_schema_metadata,
             options.signal_table_batch_size(),
             options.signal_type(),
-            pool));
+            pool,
+            options.signal_batch_alignment(),
+            signal_table_start,
+            options.signal_dictionary() || options.signal_dictionary_training_size() > 0));
+    ARROW_RETURN_NOT_OK(set_signal_compression(signal_table_writer, options, signal_dictionary));
 
     // Throw it all together into a writer object:
     return std::make_unique<FileWriter>(std::make_unique<CombinedFileWriterImpl>(
         path,
         run_info_tmp_path,
         reads_tmp_path,
+        signal_summary_tmp_path,
+        make_signal_dictionary_tmp_path(arrow_path, file_identifier),
         signal_table_start,
         section_marker,
         file_identifier,
         writing_software_name,
+        file_schema_metadata,
         std::move(dict_writers),
         std::move(run_info_table_tmp_writer),
         std::move(read_table_tmp_writer),
         std::move(signal_table_writer),
+        std::move(signal_summary_table_tmp_writer),
+        std::move(channel_index_writer),
+        options.max_signal_chunk_size(),
+        pool));
+}
+
+std::string make_stream_table_tmp_path(
+    ::arrow::internal::PlatformFilename const & arrow_path,
+    boost::uuids::uuid const & conversion_identifier,
+    stream_file_utils::StreamSection section)
+{
+    return arrow_path.Parent().ToString() + "/"
+           + ("." + boost::uuids::to_string(conversion_identifier) + ".tmp-stream-"
+              + std::to_string(static_cast<std::uint32_t>(section)));
+}
+
+pod5::Result<std::unique_ptr<FileWriter>> create_stream_file_writer(
+    std::shared_ptr<arrow::io::OutputStream> const & sink,
+    std::string const & writing_software_name,
+    FileWriterOptions const & options)
+{
+    using stream_file_utils::FramedOutputStream;
+    using stream_file_utils::StreamSection;
+
+    auto pool = options.memory_pool();
+    if (!pool) {
+        return Status::Invalid("Invalid memory pool specified for file writer");
+    }
+    if (!sink) {
+        return Status::Invalid("Invalid sink specified for stream file writer");
+    }
+    if (options.signal_batch_alignment() % 8 != 0) {
+        return Status::Invalid(
+            "Signal batch alignment must be a multiple of 8 bytes, not ",
+            options.signal_batch_alignment());
+    }
+    if (options.signal_dictionary() || options.signal_dictionary_training_size() > 0) {
+        return Status::Invalid("Signal dictionaries are not supported by stream file writers");
+    }
+
+    // Open dictionary writers:
+    ARROW_ASSIGN_OR_RAISE(auto dict_writers, make_dictionary_writers(pool));
+
+    // Prep file metadata:
+    auto uuid_gen = boost::uuids::random_generator_mt19937();
+    auto const file_identifier = uuid_gen();
+
+    ARROW_ASSIGN_OR_RAISE(auto current_version, parse_version_number(Pod5Version));
+    ARROW_ASSIGN_OR_RAISE(
+        auto file_schema_metadata,
+        make_schema_key_value_metadata({file_identifier, writing_software_name, current_version}));
+
+    ARROW_RETURN_NOT_OK(stream_file_utils::write_stream_signature(sink));
+
+    std::vector<std::shared_ptr<arrow::io::OutputStream>> table_streams;
+    auto const make_table_stream = [&](StreamSection section) {
+        table_streams.push_back(std::make_shared<FramedOutputStream>(sink, section));
+        return table_streams.back();
+    };
+
+    ARROW_ASSIGN_OR_RAISE(
+        auto read_table_writer,
+        make_read_table_writer(
+            make_table_stream(StreamSection::ReadsTable),
+            file_schema_metadata,
+            options.read_table_batch_size(),
+            dict_writers.pore_writer,
+            dict_writers.end_reason_writer,
+            dict_writers.run_info_writer,
+            pool,
+            options.write_signal_statistics()));
+
+    ARROW_ASSIGN_OR_RAISE(
+        auto run_info_table_writer,
+        make_run_info_table_writer(
+            make_table_stream(StreamSection::RunInfoTable),
+            file_schema_metadata,
+            options.run_info_table_batch_size(),
+            pool));
+
+    boost::optional<SignalSummaryTableWriter> signal_summary_table_writer;
+    if (options.signal_summary_bin_size() > 0) {
+        ARROW_ASSIGN_OR_RAISE(
+            signal_summary_table_writer,
+            make_signal_summary_table_writer(
+                make_table_stream(StreamSection::SignalSummaryTable),
+                file_schema_metadata,
+                options.signal_summary_bin_size(),
+                options.read_table_batch_size(),
+                pool));
+    }
+
+    boost::optional<ChannelIndexWriter> channel_index_writer;
+    if (options.write_channel_index()) {
+        channel_index_writer.emplace(options.read_table_batch_size(), pool);
+    }
+
+    // Conversion places the signal table directly after the combined file header:
+    ARROW_ASSIGN_OR_RAISE(
+        auto signal_table_writer,
+        make_signal_table_writer(
+            make_table_stream(StreamSection::SignalTable),
+            file_schema_metadata,
+            options.signal_table_batch_size(),
+            options.signal_type(),
+            pool,
+            options.signal_batch_alignment(),
+            combined_file_utils::header_size));
+    ARROW_RETURN_NOT_OK(set_signal_compression(signal_table_writer, options, nullptr));
+
+    return std::make_unique<FileWriter>(std::make_unique<StreamFileWriterImpl>(
+        sink,
+        std::move(table_streams),
+        file_identifier,
+        writing_software_name,
+        file_schema_metadata,
+        std::move(dict_writers),
+        std::move(run_info_table_writer),
+        std::move(read_table_writer),
+        std::move(signal_table_writer),
+        std::move(signal_summary_table_writer),
+        std::move(channel_index_writer),
         options.max_signal_chunk_size(),
         pool));
 }
 
+namespace {
+/// Removes the files of a failed conversion, those still needed are released from it.
+class ConversionCleanup {
+public:
+    ~ConversionCleanup()
+    {
+        for (auto const & path : m_paths) {
+            auto arrow_path = ::arrow::internal::PlatformFilename::FromString(path);
+            if (arrow_path.ok()) {
+                (void)arrow::internal::DeleteFile(*arrow_path);
+            }
+        }
+    }
+
+    void add(std::string const & path) { m_paths.push_back(path); }
+
+    void release(std::string const & path)
+    {
+        m_paths.erase(std::remove(m_paths.begin(), m_paths.end(), path), m_paths.end());
+    }
+
+private:
+    std::vector<std::string> m_paths;
+};
+
+/// Passes recovered read table batches to a file writer, which indexes them as it writes them.
+class RecoveredReadTableWriter {
+public:
+    explicit RecoveredReadTableWriter(FileWriterImpl * file) : m_file(file) {}
+
+    std::shared_ptr<arrow::Schema> const & schema() const { return m_file->read_table_schema(); }
+
+    arrow::Status write_batch(arrow::RecordBatch const & batch)
+    {
+        return m_file->write_read_table_batch(batch);
+    }
+
+private:
+    FileWriterImpl * m_file;
+};
+}  // namespace
+
+pod5::Status convert_stream_to_file(
+    std::shared_ptr<arrow::io::InputStream> const & stream,
+    std::string const & path)
+{
+    using stream_file_utils::StreamSection;
+
+    if (!stream) {
+        return Status::Invalid("Invalid stream specified for conversion");
+    }
+    auto pool = arrow::default_memory_pool();
+
+    ARROW_ASSIGN_OR_RAISE(auto arrow_path, ::arrow::internal::PlatformFilename::FromString(path));
+    ARROW_ASSIGN_OR_RAISE(bool file_exists, arrow::internal::FileExists(arrow_path));
+    if (file_exists) {
+        return Status::Invalid("Unable to create new file '", path, "', already exists");
+    }
+
+    ARROW_RETURN_NOT_OK(stream_file_utils::check_stream_signature(stream));
+
+    ConversionCleanup cleanup;
+    cleanup.add(path);
+    ARROW_ASSIGN_OR_RAISE(auto file, arrow::io::FileOutputStream::Open(path));
+
+    auto uuid_gen = boost::uuids::random_generator_mt19937();
+    auto const section_marker = uuid_gen();
+    auto const conversion_identifier = uuid_gen();
+    ARROW_RETURN_NOT_OK(combined_file_utils::write_combined_header(file, section_marker));
+
+    // Signal goes straight into the file, other tables wait in temporary files for it to end:
+    combined_file_utils::FileInfo signal_table;
+    signal_table.file_start_offset = combined_file_utils::header_size;
+    signal_table.file_length = 0;
+    std::map<StreamSection, std::shared_ptr<arrow::io::FileOutputStream>> table_files;
+
+    std::map<StreamSection, std::vector<BatchChecksum>> batch_checksums;
+    boost::uuids::uuid file_identifier;
+    std::string software_name;
+    while (true) {
+        ARROW_ASSIGN_OR_RAISE(auto const frame, stream_file_utils::read_frame_header(stream));
+        ARROW_ASSIGN_OR_RAISE(
+            auto const payload, stream_file_utils::read_exactly(stream, frame.length));
+
+        if (frame.section == StreamSection::Trailer) {
+            if (payload->size() < std::int64_t(file_identifier.size())) {
+                return Status::IOError("Invalid pod5 stream trailer");
+            }
+            std::copy(
+                payload->data(), payload->data() + file_identifier.size(), file_identifier.begin());
+            software_name.assign(
+                reinterpret_cast<char const *>(payload->data()) + file_identifier.size(),
+                payload->size() - file_identifier.size());
+            break;
+        }
+
+        if (frame.section == StreamSection::BatchChecksums) {
+            StreamSection section;
+            ARROW_ASSIGN_OR_RAISE(
+                auto checksums, stream_file_utils::parse_batch_checksums(*payload, &section));
+            batch_checksums[section] = std::move(checksums);
+            continue;
+        }
+
+        if (frame.section == StreamSection::SignalTable) {
+            ARROW_RETURN_NOT_OK(file->Write(payload));
+            signal_table.file_length += payload->size();
+            continue;
+        }
+
+        switch (frame.section) {
+        case StreamSection::RunInfoTable:
+        case StreamSection::ReadsTable:
+        case StreamSection::SignalSummaryTable:
+        case StreamSection::ChannelIndexTable:
+            break;
+        default:
+            return Status::IOError(
+                "Unknown section in pod5 stream: ", static_cast<std::uint32_t>(frame.section));
+        }
+
+        auto & table_file = table_files[frame.section];
+        if (!table_file) {
+            auto const tmp_path =
+                make_stream_table_tmp_path(arrow_path, conversion_identifier, frame.section);
+            cleanup.add(tmp_path);
+            ARROW_ASSIGN_OR_RAISE(table_file, arrow::io::FileOutputStream::Open(tmp_path));
+        }
+        ARROW_RETURN_NOT_OK(table_file->Write(payload));
+    }
+
+    if (!table_files.count(StreamSection::RunInfoTable)
+        || !table_files.count(StreamSection::ReadsTable))
+    {
+        return Status::IOError("Pod5 stream is missing its run info or reads table");
+    }
+
+    signal_table.batch_checksums = batch_checksums[StreamSection::SignalTable];
+
+    // pad file to 8 bytes and mark section:
+    ARROW_RETURN_NOT_OK(combined_file_utils::pad_file(file, 8));
+    ARROW_RETURN_NOT_OK(combined_file_utils::write_section_marker(file, section_marker));
+
+    auto const write_table = [&](StreamSection section) -> Result<combined_file_utils::FileInfo> {
+        auto & table_file = table_files[section];
+        ARROW_ASSIGN_OR_RAISE(auto const size, table_file->Tell());
+        ARROW_RETURN_NOT_OK(table_file->Close());
+        FileLocation location{
+            make_stream_table_tmp_path(arrow_path, conversion_identifier, section),
+            0,
+            std::size_t(size)};
+        location.batch_checksums = batch_checksums[section];
+        return combined_file_utils::write_file_and_marker(
+            pool,
+            file,
+            location,
+            combined_file_utils::SubFileCleanup::CleanupOriginalFile,
+            section_marker);
+    };
+
+    ARROW_ASSIGN_OR_RAISE(auto run_info_table, write_table(StreamSection::RunInfoTable));
+    ARROW_ASSIGN_OR_RAISE(auto reads_table, write_table(StreamSection::ReadsTable));
+
+    std::vector<combined_file_utils::FileInfo> other_indices;
+    for (auto section : {StreamSection::SignalSummaryTable, StreamSection::ChannelIndexTable}) {
+        if (table_files.count(section)) {
+            ARROW_ASSIGN_OR_RAISE(auto index_table, write_table(section));
+            other_indices.push_back(index_table);
+        }
+    }
+
+    ARROW_RETURN_NOT_OK(combined_file_utils::write_footer(
+        file,
+        section_marker,
+        file_identifier,
+        software_name,
+        signal_table,
+        run_info_table,
+        reads_table,
+        other_indices));
+    ARROW_RETURN_NOT_OK(file->Close());
+
+    cleanup.release(path);
+    return Status::OK();
+}
+
 pod5::Result<std::unique_ptr<FileWriter>> recover_file_writer(
     std::string const & src_path,
     std::string const & dest_path,
@@ -646,6 +1401,33 @@ pod5::Result<std::unique_ptr<FileWriter>> recover_file_writer(
         ARROW_ASSIGN_OR_RAISE(
             auto raw_sub_file,
             combined_file_utils::open_sub_file(file, combined_file_utils::header_size));
+
+        // Signal compressed with a dictionary is copied as is, so [dest_file] must store the same
+        // dictionary:
+        ARROW_ASSIGN_OR_RAISE(auto signal_metadata, recover_arrow_file_metadata(raw_sub_file));
+        auto const signal_dictionary_tmp_path =
+            make_signal_dictionary_tmp_path(arrow_path, signal_metadata.file_identifier);
+        ARROW_ASSIGN_OR_RAISE(
+            auto signal_dictionary_arrow_path,
+            ::arrow::internal::PlatformFilename::FromString(signal_dictionary_tmp_path));
+        ARROW_ASSIGN_OR_RAISE(
+            bool has_signal_dictionary,
+            arrow::internal::FileExists(signal_dictionary_arrow_path));
+        if (has_signal_dictionary) {
+            ARROW_ASSIGN_OR_RAISE(
+                auto dictionary_file,
+                arrow::io::ReadableFile::Open(signal_dictionary_tmp_path, pool));
+            ARROW_ASSIGN_OR_RAISE(
+                auto dictionary_data,
+                read_signal_dictionary_table(
+                    dictionary_file, signal_metadata.file_identifier, pool));
+            ARROW_ASSIGN_OR_RAISE(
+                auto dictionary,
+                VbzDictionary::make(dictionary_data, options.signal_compression_level()));
+            ARROW_RETURN_NOT_OK(dest_file->impl()->signal_table_writer()->set_vbz_compression(
+                options.signal_compression_level(), dictionary));
+        }
+
         ARROW_ASSIGN_OR_RAISE(
             recovered_raw_data,
             recover_arrow_file(raw_sub_file, dest_file->impl()->signal_table_writer()));
@@ -671,9 +1453,9 @@ pod5::Result<std::unique_ptr<FileWriter>> recover_file_writer(
         ARROW_ASSIGN_OR_RAISE(auto file, arrow::io::ReadableFile::Open(reads_tmp_path, pool));
         ARROW_ASSIGN_OR_RAISE(auto size, file->GetSize());
         if (size > 0) {
+            RecoveredReadTableWriter read_table_writer{dest_file->impl()};
             ARROW_ASSIGN_OR_RAISE(
-                recovered_raw_data,
-                recover_arrow_file(file, dest_file->impl()->read_table_writer()));
+                recovered_raw_data, recover_arrow_file(file, &read_table_writer));
         }
     }
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "pod5_format/adaptive_compression_level.h"
 #include "pod5_format/pod5_format_export.h"
 #include "pod5_format/read_table_utils.h"
 #include "pod5_format/result.h"
@@ -10,7 +11,12 @@
 
 namespace arrow {
 class Array;
+class Buffer;
 class MemoryPool;
+namespace io {
+class InputStream;
+class OutputStream;
+}  // namespace io
 }  // namespace arrow
 
 namespace pod5 {
@@ -26,6 +32,13 @@ public:
     static constexpr std::uint32_t DEFAULT_RUN_INFO_TABLE_BATCH_SIZE = 1;
     static constexpr SignalType DEFAULT_SIGNAL_TYPE = SignalType::VbzSignal;
     static constexpr bool DEFAULT_USE_DIRECTIO = false;
+    static constexpr std::uint32_t DEFAULT_SIGNAL_SUMMARY_BIN_SIZE = 0;
+    static constexpr bool DEFAULT_WRITE_CHANNEL_INDEX = false;
+    static constexpr bool DEFAULT_WRITE_SIGNAL_STATISTICS = false;
+    static constexpr std::uint32_t DEFAULT_SIGNAL_BATCH_ALIGNMENT = 0;
+    static constexpr std::size_t DEFAULT_SIGNAL_DICTIONARY_TRAINING_SIZE = 0;
+    /// \brief Default maximum size of a trained signal dictionary, as used by the zstd cli.
+    static constexpr std::size_t DEFAULT_SIGNAL_DICTIONARY_MAX_SIZE = 112'640;
 
     FileWriterOptions();
 
@@ -73,6 +86,117 @@ public:
 
     bool use_directio() const { return m_use_directio; }
 
+    /// \brief Set the number of samples summarised by each bin of the finest signal summary level.
+    /// \note A signal summary index is only written when this is non-zero (off by default),
+    ///       readers predating the index are unable to open files containing it.
+    void set_signal_summary_bin_size(std::uint32_t bin_size)
+    {
+        m_signal_summary_bin_size = bin_size;
+    }
+
+    std::uint32_t signal_summary_bin_size() const { return m_signal_summary_bin_size; }
+
+    /// \brief Set if an index of reads sorted by (channel, start_sample) is written to the file.
+    /// \note Off by default, readers predating the index are unable to open files containing it.
+    ///       The index is held in memory until the file is closed, at ~32 bytes per read.
+    void set_write_channel_index(bool write_channel_index)
+    {
+        m_write_channel_index = write_channel_index;
+    }
+
+    bool write_channel_index() const { return m_write_channel_index; }
+
+    /// \brief Set if the optional signal statistics columns (signal_min, signal_max, signal_mean,
+    ///        signal_stdev and signal_saturated_count) are written to the reads table.
+    /// \note Off by default. Statistics are only computed for reads added with their samples.
+    void set_write_signal_statistics(bool write_signal_statistics)
+    {
+        m_write_signal_statistics = write_signal_statistics;
+    }
+
+    bool write_signal_statistics() const { return m_write_signal_statistics; }
+
+    /// \brief Set the alignment in bytes of each signal batch body within the file, eg. 4096 for
+    ///        O_DIRECT reads or 2 MiB for huge page mappings.
+    /// \note The alignment must be a multiple of 8 bytes, 0 (the default) leaves batches unaligned.
+    ///       Each batch is padded by up to the alignment, aligned files remain readable by all
+    ///       readers.
+    void set_signal_batch_alignment(std::uint32_t alignment)
+    {
+        m_signal_batch_alignment = alignment;
+    }
+
+    std::uint32_t signal_batch_alignment() const { return m_signal_batch_alignment; }
+
+    /// \brief Set the zstd level vbz signal is compressed at, higher levels give smaller files but
+    ///        compress more slowly. Decompression speed is largely unaffected.
+    /// \note Only applies to vbz signal, levels outside zstd's range are clamped to it.
+    void set_signal_compression_level(int compression_level)
+    {
+        m_signal_compression_level = compression_level;
+    }
+
+    int signal_compression_level() const { return m_signal_compression_level; }
+
+    /// \brief Set a trained zstd dictionary (see train_vbz_dictionary()) to compress vbz signal
+    ///        with. The dictionary is stored in the file, and loaded by readers to decompress it.
+    /// \note Readers predating signal dictionaries are unable to open files containing one.
+    void set_signal_dictionary(std::shared_ptr<arrow::Buffer> const & dictionary)
+    {
+        m_signal_dictionary = dictionary;
+    }
+
+    std::shared_ptr<arrow::Buffer> const & signal_dictionary() const { return m_signal_dictionary; }
+
+    /// \brief Set the number of bytes of samples a zstd dictionary for vbz signal is trained on,
+    ///        0 (the default) trains no dictionary.
+    /// \details The first reads written are held in memory until this much signal has been added,
+    ///          then a dictionary of up to [max_dictionary_size] bytes is trained on them and
+    ///          stored in the file, and all signal is compressed with it. Training should see
+    ///          around 100 times the dictionary size. A dictionary set with
+    ///          set_signal_dictionary() is used in preference to training one.
+    /// \note Readers predating signal dictionaries are unable to open files containing one.
+    void set_signal_dictionary_training_size(
+        std::size_t training_size,
+        std::size_t max_dictionary_size = DEFAULT_SIGNAL_DICTIONARY_MAX_SIZE)
+    {
+        m_signal_dictionary_training_size = training_size;
+        m_signal_dictionary_max_size = max_dictionary_size;
+    }
+
+    std::size_t signal_dictionary_training_size() const
+    {
+        return m_signal_dictionary_training_size;
+    }
+
+    std::size_t signal_dictionary_max_size() const { return m_signal_dictionary_max_size; }
+
+    /// \brief Set the writer to pick the zstd level of each vbz signal batch, between [min_level]
+    ///        and [max_level], from how far it is falling behind the signal being added.
+    /// \details Signal starts at the compression level set (clamped to the range given). While
+    ///          the writer spends most of its time compressing the level drops, while it is idle
+    ///          the level rises, see AdaptiveCompressionLevel. The levels used are reported by
+    ///          FileWriter::signal_compression_metrics().
+    /// \note Only applies to vbz signal, not supported with a signal dictionary.
+    void set_adaptive_signal_compression(int min_level, int max_level)
+    {
+        m_adaptive_signal_compression = true;
+        m_adaptive_signal_compression_min_level = min_level;
+        m_adaptive_signal_compression_max_level = max_level;
+    }
+
+    bool adaptive_signal_compression() const { return m_adaptive_signal_compression; }
+
+    int adaptive_signal_compression_min_level() const
+    {
+        return m_adaptive_signal_compression_min_level;
+    }
+
+    int adaptive_signal_compression_max_level() const
+    {
+        return m_adaptive_signal_compression_max_level;
+    }
+
 private:
     std::shared_ptr<ThreadPool> m_writer_thread_pool;
     std::uint32_t m_max_signal_chunk_size;
@@ -82,6 +206,17 @@ private:
     std::size_t m_read_table_batch_size;
     std::size_t m_run_info_table_batch_size;
     bool m_use_directio;
+    std::uint32_t m_signal_summary_bin_size;
+    bool m_write_channel_index;
+    bool m_write_signal_statistics;
+    std::uint32_t m_signal_batch_alignment;
+    int m_signal_compression_level;
+    std::shared_ptr<arrow::Buffer> m_signal_dictionary;
+    std::size_t m_signal_dictionary_training_size;
+    std::size_t m_signal_dictionary_max_size;
+    bool m_adaptive_signal_compression;
+    int m_adaptive_signal_compression_min_level;
+    int m_adaptive_signal_compression_max_level;
 };
 
 class FileWriterImpl;
@@ -127,6 +262,10 @@ public:
     SignalType signal_type() const;
     std::size_t signal_table_batch_size() const;
 
+    /// \brief Find the measurements of the signal compressed by the writer so far, including
+    ///        after it is closed.
+    SignalCompressionMetrics signal_compression_metrics() const;
+
     FileWriterImpl * impl() const { return m_impl.get(); };
 
 private:
@@ -138,6 +277,24 @@ POD5_FORMAT_EXPORT pod5::Result<std::unique_ptr<FileWriter>> create_file_writer(
     std::string const & writing_software_name,
     FileWriterOptions const & options = {});
 
+/// \brief Create a writer streaming a pod5 file into [sink], which need not be seekable (eg. a pipe
+///        or socket). No temporary files are used.
+/// \details Tables are interleaved in the stream as they are written, once the writer is closed
+///          convert_stream_to_file() turns the stream into a pod5 file. The sink is written on the
+///          calling thread, and is flushed but not closed when the writer is closed. Direct io and
+///          thread pool options are not used, signal dictionaries are not supported.
+POD5_FORMAT_EXPORT pod5::Result<std::unique_ptr<FileWriter>> create_stream_file_writer(
+    std::shared_ptr<arrow::io::OutputStream> const & sink,
+    std::string const & writing_software_name,
+    FileWriterOptions const & options = {});
+
+/// \brief Write the pod5 stream read from [stream] to a new pod5 file at [path].
+/// \details Signal is written to [path] as it arrives, other tables are held in temporary files
+///          next to [path] until the stream ends. If the stream is incomplete no file is left.
+POD5_FORMAT_EXPORT pod5::Status convert_stream_to_file(
+    std::shared_ptr<arrow::io::InputStream> const & stream,
+    std::string const & path);
+
 POD5_FORMAT_EXPORT pod5::Result<std::unique_ptr<FileWriter>> recover_file_writer(
     std::string const & src_path,
     std::string const & dest_path,
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <arrow/buffer.h>
+#include <arrow/io/interfaces.h>
+#include <arrow/ipc/writer.h>
+#include <arrow/util/key_value_metadata.h>
+
+#include <cstring>
+
+namespace pod5 {
+
+/// \brief Payload writer which pads the metadata of each record batch message so the batch body
+///        starts on a multiple of [alignment] bytes into the output file.
+/// \details Padding the metadata flatbuffer with zeros is what the IPC writer itself does to reach
+///          8 byte alignment, so the padded messages remain readable as both IPC file and stream.
+class AlignedBatchPayloadWriter : public arrow::ipc::internal::IpcPayloadWriter {
+public:
+    /// \param sink_offset Offset of the sink's position zero in the output file.
+    AlignedBatchPayloadWriter(
+        std::shared_ptr<arrow::io::OutputStream> const & sink,
+        std::unique_ptr<arrow::ipc::internal::IpcPayloadWriter> && writer,
+        std::uint32_t alignment,
+        std::int64_t sink_offset,
+        arrow::MemoryPool * pool)
+    : m_sink(sink)
+    , m_writer(std::move(writer))
+    , m_alignment(alignment)
+    , m_sink_offset(sink_offset)
+    , m_pool(pool)
+    {
+    }
+
+    arrow::Status Start() override { return m_writer->Start(); }
+
+    arrow::Status WritePayload(arrow::ipc::IpcPayload const & payload) override
+    {
+        if (payload.type != arrow::ipc::MessageType::RECORD_BATCH) {
+            return m_writer->WritePayload(payload);
+        }
+
+        // A message is a continuation token and length, then the metadata and then the body:
+        std::size_t const PREFIX_SIZE = 8;
+        ARROW_ASSIGN_OR_RAISE(auto const position, m_sink->Tell());
+        std::int64_t const metadata_start = m_sink_offset + position + PREFIX_SIZE;
+        std::int64_t const metadata_end = metadata_start + payload.metadata->size();
+        std::int64_t const body_start =
+            (metadata_end + m_alignment - 1) / m_alignment * m_alignment;
+
+        ARROW_ASSIGN_OR_RAISE(
+            std::shared_ptr<arrow::Buffer> metadata,
+            arrow::AllocateBuffer(body_start - metadata_start, m_pool));
+        std::memcpy(metadata->mutable_data(), payload.metadata->data(), payload.metadata->size());
+        std::memset(
+            metadata->mutable_data() + payload.metadata->size(),
+            0,
+            metadata->size() - payload.metadata->size());
+
+        auto padded_payload = payload;
+        padded_payload.metadata = std::move(metadata);
+        return m_writer->WritePayload(padded_payload);
+    }
+
+    arrow::Status Close() override { return m_writer->Close(); }
+
+private:
+    std::shared_ptr<arrow::io::OutputStream> m_sink;
+    std::unique_ptr<arrow::ipc::internal::IpcPayloadWriter> m_writer;
+    std::int64_t m_alignment;
+    std::int64_t m_sink_offset;
+    arrow::MemoryPool * m_pool;
+};
+
+/// \brief Open an IPC file writer on [sink] which starts each record batch body on a multiple
+///        of [alignment] bytes into the output file.
+/// \param alignment   Alignment of batch bodies, a multiple of 8 bytes.
+/// \param sink_offset Offset of the sink's position zero in the output file.
+/// \note Dictionary replacement is written as in the IPC stream format, tables with changing
+///       dictionaries must not be aligned.
+inline arrow::Result<std::shared_ptr<arrow::ipc::RecordBatchWriter>> make_aligned_batch_file_writer(
+    std::shared_ptr<arrow::io::OutputStream> const & sink,
+    std::shared_ptr<arrow::Schema> const & schema,
+    arrow::ipc::IpcWriteOptions const & options,
+    std::shared_ptr<arrow::KeyValueMetadata const> const & metadata,
+    std::uint32_t alignment,
+    std::int64_t sink_offset)
+{
+    if (alignment == 0 || alignment % 8 != 0) {
+        return arrow::Status::Invalid(
+            "Batch alignment must be a non-zero multiple of 8 bytes, not ", alignment);
+    }
+
+    ARROW_ASSIGN_OR_RAISE(
+        auto file_writer,
+        arrow::ipc::internal::MakePayloadFileWriter(sink.get(), schema, options, metadata));
+    std::unique_ptr<arrow::ipc::internal::IpcPayloadWriter> aligned_writer(
+        new AlignedBatchPayloadWriter(
+            sink, std::move(file_writer), alignment, sink_offset, options.memory_pool));
+    ARROW_ASSIGN_OR_RAISE(
+        auto writer,
+        arrow::ipc::internal::OpenRecordBatchWriter(std::move(aligned_writer), schema, options));
+    return std::shared_ptr<arrow::ipc::RecordBatchWriter>(std::move(writer));
+}
+
+}  // namespace pod5
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "pod5_format/batch_checksum.h"
+#include "pod5_format/internal/aligned_batch_file_writer.h"
+
+#include <arrow/buffer.h>
+#include <arrow/io/interfaces.h>
+#include <arrow/ipc/writer.h>
+#include <arrow/record_batch.h>
+#include <arrow/util/key_value_metadata.h>
+
+#include <vector>
+
+namespace pod5 {
+
+/// \brief Output stream forwarding to another stream, checksumming the bytes of each record batch.
+/// \details Offsets are taken from the wrapped stream's Tell(), which table writers already report
+///          relative to the start of the table. The checksums are stored by the pod5 footer, not
+///          by the table itself.
+class BatchChecksumOutputStream : public arrow::io::OutputStream {
+public:
+    BatchChecksumOutputStream(std::shared_ptr<arrow::io::OutputStream> const & sink) : m_sink(sink)
+    {
+    }
+
+    arrow::Status Close() override { return m_sink->Close(); }
+
+    arrow::Status Abort() override { return m_sink->Abort(); }
+
+    arrow::Result<int64_t> Tell() const override { return m_sink->Tell(); }
+
+    bool closed() const override { return m_sink->closed(); }
+
+    arrow::Status Flush() override { return m_sink->Flush(); }
+
+    arrow::Status Write(void const * data, int64_t nbytes) override
+    {
+        update(data, nbytes);
+        return m_sink->Write(data, nbytes);
+    }
+
+    arrow::Status Write(std::shared_ptr<arrow::Buffer> const & data) override
+    {
+        update(data->data(), data->size());
+        return m_sink->Write(data);
+    }
+
+    /// \brief Write [record_batch] with [writer], recording the checksum of the bytes it emits.
+    arrow::Status write_record_batch(
+        arrow::ipc::RecordBatchWriter & writer,
+        arrow::RecordBatch const & record_batch)
+    {
+        ARROW_ASSIGN_OR_RAISE(auto const start, Tell());
+        m_in_batch = true;
+        m_current_crc = 0;
+        auto const status = writer.WriteRecordBatch(record_batch);
+        m_in_batch = false;
+        ARROW_RETURN_NOT_OK(status);
+
+        ARROW_ASSIGN_OR_RAISE(auto const end, Tell());
+        m_checksums.push_back({start, end - start, m_current_crc});
+        return arrow::Status::OK();
+    }
+
+    /// \brief The checksum of each record batch written so far, in batch order.
+    std::vector<BatchChecksum> const & checksums() const { return m_checksums; }
+
+private:
+    void update(void const * data, int64_t nbytes)
+    {
+        if (m_in_batch) {
+            m_current_crc = crc32c(data, nbytes, m_current_crc);
+        }
+    }
+
+    std::shared_ptr<arrow::io::OutputStream> m_sink;
+    bool m_in_batch = false;
+    std::uint32_t m_current_crc = 0;
+    std::vector<BatchChecksum> m_checksums;
+};
+
+/// \brief Open an IPC file writer on [sink] which checksums each record batch it writes.
+/// \param metadata        Metadata stored in the table's footer.
+/// \param checksum_stream Set to the stream batches must be written through.
+/// \param batch_alignment If non-zero, the alignment of record batch bodies in the output file.
+/// \param sink_offset     Offset of the sink's position zero in the output file.
+inline arrow::Result<std::shared_ptr<arrow::ipc::RecordBatchWriter>> make_checksummed_file_writer(
+    std::shared_ptr<arrow::io::OutputStream> const & sink,
+    std::shared_ptr<arrow::Schema> const & schema,
+    arrow::ipc::IpcWriteOptions const & options,
+    std::shared_ptr<arrow::KeyValueMetadata const> const & metadata,
+    std::shared_ptr<BatchChecksumOutputStream> * checksum_stream,
+    std::uint32_t batch_alignment = 0,
+    std::int64_t sink_offset = 0)
+{
+    auto stream = std::make_shared<BatchChecksumOutputStream>(sink);
+    std::shared_ptr<arrow::ipc::RecordBatchWriter> writer;
+    if (batch_alignment != 0) {
+        ARROW_ASSIGN_OR_RAISE(
+            writer,
+            make_aligned_batch_file_writer(
+                stream, schema, options, metadata, batch_alignment, sink_offset));
+    } else {
+        ARROW_ASSIGN_OR_RAISE(
+            writer, arrow::ipc::MakeFileWriter(stream, schema, options, metadata));
+    }
+    *checksum_stream = std::move(stream);
+    return writer;
+}
+
+}  // namespace pod5
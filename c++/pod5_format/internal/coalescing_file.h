@@ -0,0 +1,174 @@
+#pragma once
+
+#include "pod5_format/result.h"
+
+#include <arrow/buffer.h>
+#include <arrow/io/caching.h>
+#include <arrow/io/concurrency.h>
+#include <arrow/io/interfaces.h>
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+namespace pod5 {
+
+/// \brief File on high latency storage, whose reads are fetched ahead in a few large concurrent
+///        requests.
+/// \details Ranges expected to be read are passed to prefetch(), which merges nearby ranges (see
+///          arrow::io::CacheOptions) and requests them in the background. Reads inside a
+///          prefetched range are slices of its buffer, any other read goes to the underlying file.
+///          Metadata ranges are kept while the file is open, each prefetch of signal replaces the
+///          last so memory use stays bounded.
+class CoalescingFile
+: public arrow::io::internal::RandomAccessFileConcurrencyWrapper<CoalescingFile> {
+public:
+    /// Bytes fetched from each end of the file on open, enough for the footer of most files.
+    static constexpr std::int64_t FILE_END_PREFETCH_SIZE = 64 * 1024;
+
+    enum class PrefetchKind {
+        /// Kept until the file is closed.
+        Metadata,
+        /// Replaces the last signal prefetch.
+        Signal,
+    };
+
+    static arrow::Result<std::shared_ptr<CoalescingFile>> open(
+        std::shared_ptr<arrow::io::RandomAccessFile> const & file,
+        arrow::io::CacheOptions const & cache_options)
+    {
+        ARROW_ASSIGN_OR_RAISE(auto const size, file->GetSize());
+        auto coalescing_file = std::make_shared<CoalescingFile>(file, size, cache_options);
+
+        // Opening reads the file header and footer, fetch both together:
+        auto const end_size = std::min(size, FILE_END_PREFETCH_SIZE);
+        ARROW_RETURN_NOT_OK(coalescing_file->prefetch(
+            PrefetchKind::Metadata, {{0, end_size}, {size - end_size, end_size}}));
+        return coalescing_file;
+    }
+
+    CoalescingFile(
+        std::shared_ptr<arrow::io::RandomAccessFile> const & file,
+        std::int64_t size,
+        arrow::io::CacheOptions const & cache_options)
+    : m_file(file)
+    , m_size(size)
+    , m_cache_options(cache_options)
+    , m_metadata_cache(make_cache())
+    {
+    }
+
+    /// \brief Start fetching [ranges] in the background.
+    /// \note Metadata must be prefetched before the file is shared between threads.
+    arrow::Status prefetch(PrefetchKind kind, std::vector<arrow::io::ReadRange> ranges)
+    {
+        // Ranges must lie within the file, and the cache rejects empty ranges:
+        for (auto & range : ranges) {
+            range.offset = std::max<std::int64_t>(0, std::min(range.offset, m_size));
+            range.length = std::max<std::int64_t>(0, std::min(range.length, m_size - range.offset));
+        }
+        ranges.erase(
+            std::remove_if(
+                ranges.begin(),
+                ranges.end(),
+                [](arrow::io::ReadRange const & range) { return range.length == 0; }),
+            ranges.end());
+
+        std::shared_ptr<arrow::io::internal::ReadRangeCache> cache;
+        {
+            std::lock_guard<std::mutex> l(m_mutex);
+            if (kind == PrefetchKind::Signal) {
+                m_signal_cache = make_cache();
+                cache = m_signal_cache;
+            } else {
+                cache = m_metadata_cache;
+            }
+        }
+        return cache->Cache(std::move(ranges));
+    }
+
+    bool closed() const override { return m_file->closed(); }
+
+protected:
+    arrow::Status DoClose() { return m_file->Close(); }
+
+    arrow::Result<std::int64_t> DoTell() const { return m_position; }
+
+    arrow::Status DoSeek(int64_t position)
+    {
+        if (position < 0 || position > m_size) {
+            return arrow::Status::IOError("Invalid offset into CoalescingFile");
+        }
+        m_position = position;
+        return arrow::Status::OK();
+    }
+
+    arrow::Result<std::int64_t> DoRead(int64_t nbytes, void * out)
+    {
+        ARROW_ASSIGN_OR_RAISE(auto const read, DoReadAt(m_position, nbytes, out));
+        m_position += read;
+        return read;
+    }
+
+    arrow::Result<std::shared_ptr<arrow::Buffer>> DoRead(int64_t nbytes)
+    {
+        ARROW_ASSIGN_OR_RAISE(auto buffer, DoReadAt(m_position, nbytes));
+        m_position += buffer->size();
+        return buffer;
+    }
+
+    arrow::Result<std::int64_t> DoReadAt(int64_t position, int64_t nbytes, void * out)
+    {
+        ARROW_ASSIGN_OR_RAISE(auto const buffer, DoReadAt(position, nbytes));
+        std::memcpy(out, buffer->data(), buffer->size());
+        return buffer->size();
+    }
+
+    arrow::Result<std::shared_ptr<arrow::Buffer>> DoReadAt(int64_t position, int64_t nbytes)
+    {
+        if (position < 0 || nbytes < 0) {
+            return arrow::Status::IOError("Invalid read from CoalescingFile");
+        }
+        nbytes = std::max<std::int64_t>(0, std::min(nbytes, m_size - position));
+
+        std::shared_ptr<arrow::io::internal::ReadRangeCache> signal_cache;
+        {
+            std::lock_guard<std::mutex> l(m_mutex);
+            signal_cache = m_signal_cache;
+        }
+        // A range not (entirely) in a cache is an error from it, read those from the file:
+        for (auto const & cache : {signal_cache, m_metadata_cache}) {
+            if (!cache || nbytes == 0) {
+                continue;
+            }
+            auto buffer = cache->Read({position, nbytes});
+            if (buffer.ok()) {
+                return buffer;
+            }
+        }
+        return m_file->ReadAt(position, nbytes);
+    }
+
+    arrow::Result<std::int64_t> DoGetSize() { return m_size; }
+
+private:
+    friend RandomAccessFileConcurrencyWrapper<CoalescingFile>;
+
+    std::shared_ptr<arrow::io::internal::ReadRangeCache> make_cache() const
+    {
+        return std::make_shared<arrow::io::internal::ReadRangeCache>(
+            m_file, arrow::io::default_io_context(), m_cache_options);
+    }
+
+    std::shared_ptr<arrow::io::RandomAccessFile> m_file;
+    std::int64_t const m_size;
+    std::int64_t m_position = 0;
+    arrow::io::CacheOptions const m_cache_options;
+
+    std::shared_ptr<arrow::io::internal::ReadRangeCache> const m_metadata_cache;
+    std::mutex m_mutex;
+    std::shared_ptr<arrow::io::internal::ReadRangeCache> m_signal_cache;
+};
+
+}  // namespace pod5
@@ -10,10 +10,12 @@
 #include <arrow/util/endian.h>
 #include <arrow/util/io_util.h>
 #include <boost/lexical_cast.hpp>
+#include <boost/optional.hpp>
 #include <boost/uuid/uuid_io.hpp>
 #include <flatbuffers/flatbuffers.h>
 
 #include <array>
+#include <vector>
 
 namespace pod5 { namespace combined_file_utils {
 
@@ -65,6 +67,8 @@ inline pod5::Status write_footer_magic(std::shared_ptr<arrow::io::OutputStream>
 struct FileInfo {
     std::int64_t file_start_offset = 0;
     std::int64_t file_length = 0;
+    // Checksums of the table's record batches, relative to file_start_offset. Empty if none.
+    std::vector<BatchChecksum> batch_checksums;
 };
 
 struct ParsedFileInfo : FileInfo {
@@ -78,43 +82,66 @@ struct ParsedFileInfo : FileInfo {
             file, arrow::io::MemoryMappedFile::Open(in_file_path, arrow::io::FileMode::READ));
         file_start_offset = 0;
         ARROW_ASSIGN_OR_RAISE(file_length, file->GetSize());
+        // The table was rewritten, any checksums of the original no longer apply:
+        batch_checksums.clear();
         return arrow::Status::OK();
     }
 };
 
+inline flatbuffers::Offset<Minknow::ReadsFormat::EmbeddedFile> create_embedded_file(
+    flatbuffers::FlatBufferBuilder & builder,
+    FileInfo const & table,
+    Minknow::ReadsFormat::ContentType content_type)
+{
+    flatbuffers::Offset<flatbuffers::Vector<Minknow::ReadsFormat::BatchChecksum const *>>
+        batch_checksums;
+    if (!table.batch_checksums.empty()) {
+        std::vector<Minknow::ReadsFormat::BatchChecksum> checksums;
+        checksums.reserve(table.batch_checksums.size());
+        for (auto const & checksum : table.batch_checksums) {
+            checksums.emplace_back(checksum.offset, checksum.length, checksum.crc32c);
+        }
+        batch_checksums = builder.CreateVectorOfStructs(checksums);
+    }
+
+    return Minknow::ReadsFormat::CreateEmbeddedFile(
+        builder,
+        table.file_start_offset,
+        table.file_length,
+        Minknow::ReadsFormat::Format_FeatherV2,
+        content_type,
+        batch_checksums);
+}
+
 inline pod5::Result<std::int64_t> write_footer_flatbuffer(
     std::shared_ptr<arrow::io::OutputStream> const & sink,
     boost::uuids::uuid const & file_identifier,
     std::string const & software_name,
     FileInfo const & signal_table,
     FileInfo const & run_info_table,
-    FileInfo const & reads_table)
+    FileInfo const & reads_table,
+    std::vector<FileInfo> const & other_indices,
+    boost::optional<FileInfo> const & signal_dictionary)
 {
     flatbuffers::FlatBufferBuilder builder(1024);
 
-    auto signal_file = Minknow::ReadsFormat::CreateEmbeddedFile(
-        builder,
-        signal_table.file_start_offset,
-        signal_table.file_length,
-        Minknow::ReadsFormat::Format_FeatherV2,
-        Minknow::ReadsFormat::ContentType_SignalTable);
+    auto signal_file = create_embedded_file(
+        builder, signal_table, Minknow::ReadsFormat::ContentType_SignalTable);
+    auto run_info_file = create_embedded_file(
+        builder, run_info_table, Minknow::ReadsFormat::ContentType_RunInfoTable);
+    auto reads_file =
+        create_embedded_file(builder, reads_table, Minknow::ReadsFormat::ContentType_ReadsTable);
 
-    auto run_info_file = Minknow::ReadsFormat::CreateEmbeddedFile(
-        builder,
-        run_info_table.file_start_offset,
-        run_info_table.file_length,
-        Minknow::ReadsFormat::Format_FeatherV2,
-        Minknow::ReadsFormat::ContentType_RunInfoTable);
-
-    auto reads_file = Minknow::ReadsFormat::CreateEmbeddedFile(
-        builder,
-        reads_table.file_start_offset,
-        reads_table.file_length,
-        Minknow::ReadsFormat::Format_FeatherV2,
-        Minknow::ReadsFormat::ContentType_ReadsTable);
-
-    const std::vector<flatbuffers::Offset<Minknow::ReadsFormat::EmbeddedFile>> files{
+    std::vector<flatbuffers::Offset<Minknow::ReadsFormat::EmbeddedFile>> files{
         signal_file, run_info_file, reads_file};
+    for (auto const & other_index : other_indices) {
+        files.push_back(create_embedded_file(
+            builder, other_index, Minknow::ReadsFormat::ContentType_OtherIndex));
+    }
+    if (signal_dictionary) {
+        files.push_back(create_embedded_file(
+            builder, *signal_dictionary, Minknow::ReadsFormat::ContentType_SignalDictionary));
+    }
     auto footer = Minknow::ReadsFormat::CreateFooterDirect(
         builder,
         boost::uuids::to_string(file_identifier).c_str(),
@@ -134,13 +161,22 @@ inline pod5::Status write_footer(
     std::string const & software_name,
     FileInfo const & signal_table,
     FileInfo const & run_info_table,
-    FileInfo const & reads_table)
+    FileInfo const & reads_table,
+    std::vector<FileInfo> const & other_indices = {},
+    boost::optional<FileInfo> const & signal_dictionary = boost::none)
 {
     ARROW_RETURN_NOT_OK(write_footer_magic(sink));
     ARROW_ASSIGN_OR_RAISE(
         std::int64_t length,
         write_footer_flatbuffer(
-            sink, file_identifier, software_name, signal_table, run_info_table, reads_table));
+            sink,
+            file_identifier,
+            software_name,
+            signal_table,
+            run_info_table,
+            reads_table,
+            other_indices,
+            signal_dictionary));
     ARROW_RETURN_NOT_OK(pad_file(sink, 8));
 
     std::int64_t paded_flatbuffer_size = arrow::bit_util::ToLittleEndian(length);
@@ -158,6 +194,10 @@ struct ParsedFooter {
     ParsedFileInfo run_info_table;
     ParsedFileInfo reads_table;
     ParsedFileInfo signal_table;
+    // Indexes embedded as OtherIndex, each must be opened to find what it indexes.
+    std::vector<ParsedFileInfo> other_indices;
+    // Only present if vbz signal was compressed with a dictionary.
+    boost::optional<ParsedFileInfo> signal_dictionary;
 };
 
 inline pod5::Status check_signature(
@@ -246,32 +286,46 @@ inline pod5::Result<ParsedFooter> read_footer(
     if (!fb_footer->contents()) {
         return arrow::Status::IOError("Invalid footer contents");
     }
+    auto const parse_file_info = [&](Minknow::ReadsFormat::EmbeddedFile const & embedded_file) {
+        ParsedFileInfo file_info;
+        file_info.file_start_offset = embedded_file.offset();
+        file_info.file_length = embedded_file.length();
+        file_info.file = file;
+        file_info.file_path = file_path;
+        if (auto const batch_checksums = embedded_file.batch_checksums()) {
+            file_info.batch_checksums.reserve(batch_checksums->size());
+            for (auto const checksum : *batch_checksums) {
+                file_info.batch_checksums.push_back(
+                    {checksum->offset(), checksum->length(), checksum->crc32c()});
+            }
+        }
+        return file_info;
+    };
+
     for (auto const embedded_file : *fb_footer->contents()) {
         if (embedded_file->format() != Minknow::ReadsFormat::Format_FeatherV2) {
             return arrow::Status::IOError("Invalid embedded file format");
         }
         switch (embedded_file->content_type()) {
         case Minknow::ReadsFormat::ContentType_RunInfoTable:
-            footer.run_info_table.file_start_offset = embedded_file->offset();
-            footer.run_info_table.file_length = embedded_file->length();
-            footer.run_info_table.file = file;
-            footer.run_info_table.file_path = file_path;
+            footer.run_info_table = parse_file_info(*embedded_file);
             break;
         case Minknow::ReadsFormat::ContentType_ReadsTable:
-            footer.reads_table.file_start_offset = embedded_file->offset();
-            footer.reads_table.file_length = embedded_file->length();
-            footer.reads_table.file = file;
-            footer.reads_table.file_path = file_path;
+            footer.reads_table = parse_file_info(*embedded_file);
             break;
         case Minknow::ReadsFormat::ContentType_SignalTable:
-            footer.signal_table.file_start_offset = embedded_file->offset();
-            footer.signal_table.file_length = embedded_file->length();
-            footer.signal_table.file = file;
-            footer.signal_table.file_path = file_path;
+            footer.signal_table = parse_file_info(*embedded_file);
+            break;
+        case Minknow::ReadsFormat::ContentType_OtherIndex:
+            footer.other_indices.emplace_back(parse_file_info(*embedded_file));
+            break;
+        case Minknow::ReadsFormat::ContentType_SignalDictionary:
+            footer.signal_dictionary = parse_file_info(*embedded_file);
             break;
 
         default:
-            return arrow::Status::IOError("Unknown embedded file type");
+            // Skip content added by later writers, the tables above are all this reader needs:
+            break;
         }
     }
 
@@ -399,6 +453,8 @@ inline arrow::Result<combined_file_utils::FileInfo> write_file(
     SubFileCleanup cleanup_mode)
 {
     combined_file_utils::FileInfo table_data;
+    // The table is copied byte for byte, so its checksums still hold:
+    table_data.batch_checksums = file_location.batch_checksums;
     // Record file start location in bytes within the main file:
     ARROW_ASSIGN_OR_RAISE(table_data.file_start_offset, file->Tell());
 
@@ -0,0 +1,246 @@
+#pragma once
+
+#include "pod5_format/result.h"
+
+#include <arrow/buffer.h>
+#include <arrow/io/concurrency.h>
+#include <arrow/io/interfaces.h>
+
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#endif
+
+namespace pod5 {
+
+/// \brief Pool of aligned memory blocks, reused between reads to avoid repeated large allocations.
+class AlignedBufferPool : public std::enable_shared_from_this<AlignedBufferPool> {
+public:
+    /// \param alignment        Alignment of every block allocated.
+    /// \param max_cached_bytes Size of released blocks kept for reuse, larger blocks are freed.
+    AlignedBufferPool(std::size_t alignment, std::size_t max_cached_bytes)
+    : m_alignment(alignment)
+    , m_max_cached_bytes(max_cached_bytes)
+    {
+    }
+
+    ~AlignedBufferPool()
+    {
+        for (auto const & blocks : m_free_blocks) {
+            for (auto block : blocks.second) {
+                std::free(block);
+            }
+        }
+    }
+
+    /// \brief Allocate an aligned buffer of [size] bytes, returned to the pool once released.
+    arrow::Result<std::shared_ptr<arrow::Buffer>> allocate(std::size_t size)
+    {
+        // Round blocks up to a power of two, so released blocks are likely to fit later reads:
+        std::size_t capacity = m_alignment;
+        while (capacity < size) {
+            capacity *= 2;
+        }
+
+        std::uint8_t * data = nullptr;
+        {
+            std::lock_guard<std::mutex> l(m_mutex);
+            auto it = m_free_blocks.find(capacity);
+            if (it != m_free_blocks.end() && !it->second.empty()) {
+                data = it->second.back();
+                it->second.pop_back();
+                m_cached_bytes -= capacity;
+            }
+        }
+
+        if (!data && posix_memalign(reinterpret_cast<void **>(&data), m_alignment, capacity) != 0) {
+            return arrow::Status::OutOfMemory("Failed to allocate aligned read buffer");
+        }
+        return std::shared_ptr<arrow::Buffer>(
+            std::make_shared<PooledBuffer>(data, size, capacity, shared_from_this()));
+    }
+
+private:
+    class PooledBuffer : public arrow::MutableBuffer {
+    public:
+        PooledBuffer(
+            std::uint8_t * data,
+            std::size_t size,
+            std::size_t capacity,
+            std::shared_ptr<AlignedBufferPool> && pool)
+        : MutableBuffer(data, size)
+        , m_pool(std::move(pool))
+        {
+            capacity_ = capacity;
+        }
+
+        ~PooledBuffer() { m_pool->release(mutable_data(), capacity()); }
+
+    private:
+        std::shared_ptr<AlignedBufferPool> m_pool;
+    };
+
+    void release(std::uint8_t * data, std::size_t capacity)
+    {
+        {
+            std::lock_guard<std::mutex> l(m_mutex);
+            if (m_cached_bytes + capacity <= m_max_cached_bytes) {
+                m_free_blocks[capacity].push_back(data);
+                m_cached_bytes += capacity;
+                return;
+            }
+        }
+        std::free(data);
+    }
+
+    std::size_t const m_alignment;
+    std::size_t const m_max_cached_bytes;
+
+    std::mutex m_mutex;
+    std::map<std::size_t, std::vector<std::uint8_t *>> m_free_blocks;
+    std::size_t m_cached_bytes = 0;
+};
+
+#ifdef __linux__
+/// \brief File read with O_DIRECT, bypassing the page cache.
+/// \details Every read is widened to whole aligned blocks and read into a pooled aligned buffer,
+///          a read of an aligned range (eg. a batch body in a file written with a signal batch
+///          alignment) is used in place. Where the filesystem refuses O_DIRECT the file is read
+///          through the page cache, in the same aligned blocks.
+class DirectIOFile : public arrow::io::internal::RandomAccessFileConcurrencyWrapper<DirectIOFile> {
+public:
+    /// Alignment of file offsets, lengths and memory for O_DIRECT reads.
+    static constexpr std::int64_t ALIGNMENT = 4096;
+
+    static arrow::Result<std::shared_ptr<DirectIOFile>> open(
+        std::string const & path,
+        std::shared_ptr<AlignedBufferPool> const & pool)
+    {
+        int fd = ::open(path.c_str(), O_RDONLY | O_DIRECT);
+        if (fd < 0 && errno == EINVAL) {
+            fd = ::open(path.c_str(), O_RDONLY);
+        }
+        if (fd < 0) {
+            return arrow::Status::IOError(
+                "Failed to open '", path, "' for direct reads: ", std::strerror(errno));
+        }
+
+        struct stat file_stat;
+        if (::fstat(fd, &file_stat) < 0) {
+            auto const error = errno;
+            ::close(fd);
+            return arrow::Status::IOError(
+                "Failed to find size of '", path, "': ", std::strerror(error));
+        }
+        return std::make_shared<DirectIOFile>(fd, file_stat.st_size, pool);
+    }
+
+    DirectIOFile(int fd, std::int64_t size, std::shared_ptr<AlignedBufferPool> const & pool)
+    : m_fd(fd)
+    , m_size(size)
+    , m_pool(pool)
+    {
+    }
+
+    ~DirectIOFile() { (void)DoClose(); }
+
+    bool closed() const override { return m_fd < 0; }
+
+protected:
+    arrow::Status DoClose()
+    {
+        if (m_fd >= 0) {
+            ::close(m_fd);
+            m_fd = -1;
+        }
+        return arrow::Status::OK();
+    }
+
+    arrow::Result<std::int64_t> DoTell() const { return m_position; }
+
+    arrow::Status DoSeek(int64_t position)
+    {
+        if (position < 0 || position > m_size) {
+            return arrow::Status::IOError("Invalid offset into DirectIOFile");
+        }
+        m_position = position;
+        return arrow::Status::OK();
+    }
+
+    arrow::Result<std::int64_t> DoRead(int64_t nbytes, void * out)
+    {
+        ARROW_ASSIGN_OR_RAISE(auto const read, DoReadAt(m_position, nbytes, out));
+        m_position += read;
+        return read;
+    }
+
+    arrow::Result<std::shared_ptr<arrow::Buffer>> DoRead(int64_t nbytes)
+    {
+        ARROW_ASSIGN_OR_RAISE(auto buffer, DoReadAt(m_position, nbytes));
+        m_position += buffer->size();
+        return buffer;
+    }
+
+    arrow::Result<std::int64_t> DoReadAt(int64_t position, int64_t nbytes, void * out)
+    {
+        ARROW_ASSIGN_OR_RAISE(auto const buffer, DoReadAt(position, nbytes));
+        std::memcpy(out, buffer->data(), buffer->size());
+        return buffer->size();
+    }
+
+    arrow::Result<std::shared_ptr<arrow::Buffer>> DoReadAt(int64_t position, int64_t nbytes)
+    {
+        if (position < 0 || nbytes < 0) {
+            return arrow::Status::IOError("Invalid read from DirectIOFile");
+        }
+        nbytes = std::max<std::int64_t>(0, std::min(nbytes, m_size - position));
+
+        std::int64_t const start = position / ALIGNMENT * ALIGNMENT;
+        std::int64_t const end = (position + nbytes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+        ARROW_ASSIGN_OR_RAISE(auto buffer, m_pool->allocate(end - start));
+
+        auto const data = buffer->mutable_data();
+        std::int64_t read = 0;
+        while (start + read < position + nbytes) {
+            // O_DIRECT rejects unaligned offsets, so a short read resumes from its last aligned
+            // block, re-reading the partial block rather than continuing mid-block:
+            std::int64_t const offset = read / ALIGNMENT * ALIGNMENT;
+            auto const result = ::pread(m_fd, data + offset, end - start - offset, start + offset);
+            if (result < 0 && errno == EINTR) {
+                continue;
+            }
+            if (result < 0) {
+                return arrow::Status::IOError("Failed to read file: ", std::strerror(errno));
+            }
+            if (offset + result <= read) {
+                // No progress past the previous read - the file ends here.
+                break;
+            }
+            read = offset + result;
+        }
+
+        nbytes = std::max<std::int64_t>(0, std::min(start + read, position + nbytes) - position);
+        return arrow::SliceBuffer(std::move(buffer), position - start, nbytes);
+    }
+
+    arrow::Result<std::int64_t> DoGetSize() { return m_size; }
+
+private:
+    friend RandomAccessFileConcurrencyWrapper<DirectIOFile>;
+
+    int m_fd;
+    std::int64_t const m_size;
+    std::int64_t m_position = 0;
+    std::shared_ptr<AlignedBufferPool> m_pool;
+};
+#endif
+
+}  // namespace pod5
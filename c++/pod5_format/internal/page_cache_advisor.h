@@ -0,0 +1,139 @@
+#pragma once
+
+#include "pod5_format/file_reader.h"
+#include "pod5_format/result.h"
+
+#include <arrow/buffer.h>
+#include <arrow/io/file.h>
+
+#include <algorithm>
+#include <mutex>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace pod5 {
+
+/// \brief Passes a file's expected access pattern on to the OS, and drops cached pages of the file
+///        once a sequential reader has moved past them.
+/// \details Hints are applied to both the page cache (posix_fadvise) and, if the file is memory
+///          mapped, to the mapping (madvise). Dropping pages only costs a re-read if they are
+///          later used again, it never affects the data read.
+class PageCacheAdvisor {
+public:
+    static Result<std::unique_ptr<PageCacheAdvisor>> make(
+        std::string const & path,
+        std::shared_ptr<arrow::io::RandomAccessFile> const & file,
+        FileAccessPattern access_pattern)
+    {
+        ARROW_ASSIGN_OR_RAISE(auto const file_size, file->GetSize());
+        std::uint8_t const * mapping = nullptr;
+        if (std::dynamic_pointer_cast<arrow::io::MemoryMappedFile>(file) && file_size > 0) {
+            // A memory mapped file maps all of the file, reads are slices of the mapping:
+            ARROW_ASSIGN_OR_RAISE(auto const mapped, file->ReadAt(0, file_size));
+            mapping = mapped->data();
+        }
+
+        std::unique_ptr<PageCacheAdvisor> advisor(
+            new PageCacheAdvisor(file, mapping, file_size, access_pattern));
+#ifdef __linux__
+        // Advice applies to the file's pages, whichever descriptor it is given through:
+        advisor->m_fd = ::open(path.c_str(), O_RDONLY);
+        if (advisor->m_fd < 0) {
+            return Status::IOError("Failed to open '", path, "' for page cache advice");
+        }
+
+        int file_advice = POSIX_FADV_NORMAL;
+        int mapping_advice = MADV_NORMAL;
+        if (access_pattern == FileAccessPattern::Sequential) {
+            file_advice = POSIX_FADV_SEQUENTIAL;
+            mapping_advice = MADV_SEQUENTIAL;
+        } else if (access_pattern == FileAccessPattern::Random) {
+            file_advice = POSIX_FADV_RANDOM;
+            mapping_advice = MADV_RANDOM;
+        }
+        (void)::posix_fadvise(advisor->m_fd, 0, 0, file_advice);
+        if (mapping) {
+            auto const start = advisor->page_floor(mapping);
+            (void)::madvise(
+                const_cast<std::uint8_t *>(start), mapping + file_size - start, mapping_advice);
+        }
+#endif
+        return advisor;
+    }
+
+    ~PageCacheAdvisor()
+    {
+#ifdef __linux__
+        if (m_fd >= 0) {
+            ::close(m_fd);
+        }
+#endif
+    }
+
+    FileAccessPattern access_pattern() const { return m_access_pattern; }
+
+    /// \brief Drop the cached pages of the file before [offset], the reader has finished with them.
+    /// \note Pages already dropped by an earlier call are skipped, offsets need not increase.
+    void release_before(std::int64_t offset)
+    {
+#ifdef __linux__
+        std::lock_guard<std::mutex> l(m_mutex);
+        offset = std::min(offset, m_file_size) / m_page_size * m_page_size;
+        if (offset <= m_released_offset) {
+            return;
+        }
+
+        if (m_mapping) {
+            // Unmap the pages from this process first, the page cache can't drop mapped pages:
+            (void)::madvise(
+                const_cast<std::uint8_t *>(m_mapping + m_released_offset),
+                offset - m_released_offset,
+                MADV_DONTNEED);
+        }
+        (void)::posix_fadvise(
+            m_fd, m_released_offset, offset - m_released_offset, POSIX_FADV_DONTNEED);
+        m_released_offset = offset;
+#else
+        (void)offset;
+#endif
+    }
+
+private:
+    PageCacheAdvisor(
+        std::shared_ptr<arrow::io::RandomAccessFile> const & file,
+        std::uint8_t const * mapping,
+        std::int64_t file_size,
+        FileAccessPattern access_pattern)
+    : m_file(file)
+    , m_mapping(mapping)
+    , m_file_size(file_size)
+    , m_access_pattern(access_pattern)
+    {
+#ifdef __linux__
+        m_page_size = ::sysconf(_SC_PAGESIZE);
+#endif
+    }
+
+    std::uint8_t const * page_floor(std::uint8_t const * address) const
+    {
+        auto const value = reinterpret_cast<std::uintptr_t>(address);
+        return reinterpret_cast<std::uint8_t const *>(value - value % m_page_size);
+    }
+
+    // Keeps the mapping alive while advice is given on it:
+    std::shared_ptr<arrow::io::RandomAccessFile> m_file;
+    std::uint8_t const * m_mapping;
+    std::int64_t m_file_size;
+    FileAccessPattern m_access_pattern;
+    std::int64_t m_page_size = 4096;
+    int m_fd = -1;
+
+    std::mutex m_mutex;
+    std::int64_t m_released_offset = 0;
+};
+
+}  // namespace pod5
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "pod5_format/result.h"
+
+#include <arrow/buffer.h>
+#include <arrow/io/concurrency.h>
+#include <arrow/io/interfaces.h>
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+namespace pod5 {
+
+/// \brief File serving reads from buffers already read from the file it wraps, where it can.
+/// \details A table reader verifying a batch reads the batch's bytes once to checksum them, pins
+///          them here, and decodes the batch through this file, so the batch is decoded from the
+///          verified bytes instead of being read from the file again.
+class PinnedBufferFile
+: public arrow::io::internal::RandomAccessFileConcurrencyWrapper<PinnedBufferFile> {
+public:
+    explicit PinnedBufferFile(std::shared_ptr<arrow::io::RandomAccessFile> file)
+    : m_file(std::move(file))
+    {
+    }
+
+    /// \brief Serve reads within [offset, offset + buffer size) from [buffer] until it is unpinned.
+    void pin(std::int64_t offset, std::shared_ptr<arrow::Buffer> const & buffer)
+    {
+        std::lock_guard<std::mutex> l(m_pinned_mutex);
+        m_pinned.push_back({offset, buffer});
+    }
+
+    /// \brief Stop serving reads from [buffer], pinned at [offset].
+    void unpin(std::int64_t offset, std::shared_ptr<arrow::Buffer> const & buffer)
+    {
+        std::lock_guard<std::mutex> l(m_pinned_mutex);
+        auto const it =
+            std::find_if(m_pinned.begin(), m_pinned.end(), [&](PinnedBuffer const & pinned) {
+                return pinned.offset == offset && pinned.buffer == buffer;
+            });
+        if (it != m_pinned.end()) {
+            m_pinned.erase(it);
+        }
+    }
+
+protected:
+    arrow::Status DoClose() { return m_file->Close(); }
+
+    bool closed() const override { return m_file->closed(); }
+
+    arrow::Result<std::int64_t> DoTell() const { return m_file->Tell(); }
+
+    arrow::Status DoSeek(int64_t offset) { return m_file->Seek(offset); }
+
+    arrow::Result<std::int64_t> DoRead(int64_t length, void * data)
+    {
+        return m_file->Read(length, data);
+    }
+
+    arrow::Result<std::shared_ptr<arrow::Buffer>> DoRead(int64_t length)
+    {
+        return m_file->Read(length);
+    }
+
+    Result<int64_t> DoReadAt(int64_t position, int64_t nbytes, void * out)
+    {
+        if (auto const buffer = find_pinned(position, nbytes)) {
+            std::memcpy(out, buffer->data(), nbytes);
+            return nbytes;
+        }
+        return m_file->ReadAt(position, nbytes, out);
+    }
+
+    Result<std::shared_ptr<arrow::Buffer>> DoReadAt(int64_t position, int64_t nbytes)
+    {
+        if (auto buffer = find_pinned(position, nbytes)) {
+            return buffer;
+        }
+        return m_file->ReadAt(position, nbytes);
+    }
+
+    arrow::Result<std::int64_t> DoGetSize() { return m_file->GetSize(); }
+
+private:
+    friend RandomAccessFileConcurrencyWrapper<PinnedBufferFile>;
+
+    struct PinnedBuffer {
+        std::int64_t offset;
+        std::shared_ptr<arrow::Buffer> buffer;
+    };
+
+    /// Find the bytes [position, position + nbytes) in a pinned buffer, null if none holds them.
+    std::shared_ptr<arrow::Buffer> find_pinned(std::int64_t position, std::int64_t nbytes) const
+    {
+        std::lock_guard<std::mutex> l(m_pinned_mutex);
+        for (auto const & pinned : m_pinned) {
+            if (position >= pinned.offset && nbytes >= 0
+                && position + nbytes <= pinned.offset + pinned.buffer->size())
+            {
+                return arrow::SliceBuffer(pinned.buffer, position - pinned.offset, nbytes);
+            }
+        }
+        return nullptr;
+    }
+
+    std::shared_ptr<arrow::io::RandomAccessFile> m_file;
+    mutable std::mutex m_pinned_mutex;
+    std::vector<PinnedBuffer> m_pinned;
+};
+
+}  // namespace pod5
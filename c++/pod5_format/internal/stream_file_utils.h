@@ -0,0 +1,245 @@
+#pragma once
+
+#include "pod5_format/batch_checksum.h"
+#include "pod5_format/result.h"
+
+#include <arrow/buffer.h>
+#include <arrow/io/interfaces.h>
+#include <arrow/util/endian.h>
+#include <boost/uuid/uuid.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <vector>
+
+namespace pod5 { namespace stream_file_utils {
+
+/// A pod5 stream is this signature, then a sequence of frames. Each frame is a header then
+/// [length] bytes of the section it belongs to. Concatenating the frames of a table section gives
+/// that table's arrow file, the stream ends with a trailer frame.
+static constexpr std::array<char, 8>
+    STREAM_SIGNATURE{'\213', 'P', '5', 'S', '\r', '\n', '\032', '\n'};
+
+enum class StreamSection : std::uint32_t {
+    SignalTable = 1,
+    RunInfoTable = 2,
+    ReadsTable = 3,
+    SignalSummaryTable = 4,
+    ChannelIndexTable = 5,
+    // The section of a table (4 bytes), then the offset (8 bytes), length (8 bytes) and crc32c
+    // (4 bytes) of each of its batches. Written once the table is complete.
+    BatchChecksums = 6,
+    // File identifier (16 bytes) then the writing software name, written once all tables are.
+    Trailer = 0xffffffff,
+};
+
+struct FrameHeader {
+    StreamSection section;
+    std::uint32_t length;
+};
+
+static constexpr std::size_t frame_header_size = 8;
+static constexpr std::int64_t BATCH_CHECKSUM_ENTRY_SIZE = 8 + 8 + 4;
+
+inline pod5::Status write_stream_signature(std::shared_ptr<arrow::io::OutputStream> const & sink)
+{
+    return sink->Write(STREAM_SIGNATURE.data(), STREAM_SIGNATURE.size());
+}
+
+inline pod5::Status write_frame(
+    std::shared_ptr<arrow::io::OutputStream> const & sink,
+    StreamSection section,
+    void const * data,
+    std::uint32_t length)
+{
+    std::array<std::uint32_t, 2> const header{
+        arrow::bit_util::ToLittleEndian(static_cast<std::uint32_t>(section)),
+        arrow::bit_util::ToLittleEndian(length)};
+    ARROW_RETURN_NOT_OK(sink->Write(header.data(), frame_header_size));
+    return sink->Write(data, length);
+}
+
+inline pod5::Status write_trailer(
+    std::shared_ptr<arrow::io::OutputStream> const & sink,
+    boost::uuids::uuid const & file_identifier,
+    std::string const & software_name)
+{
+    std::vector<std::uint8_t> trailer(file_identifier.begin(), file_identifier.end());
+    trailer.insert(trailer.end(), software_name.begin(), software_name.end());
+    return write_frame(sink, StreamSection::Trailer, trailer.data(), trailer.size());
+}
+
+/// \brief Write the checksums of the batches of table [section] as a BatchChecksums frame.
+inline pod5::Status write_batch_checksums(
+    std::shared_ptr<arrow::io::OutputStream> const & sink,
+    StreamSection section,
+    std::vector<BatchChecksum> const & checksums)
+{
+    std::vector<std::uint8_t> payload(
+        sizeof(std::uint32_t) + checksums.size() * BATCH_CHECKSUM_ENTRY_SIZE);
+    auto out = payload.data();
+    auto const append = [&](auto value) {
+        value = arrow::bit_util::ToLittleEndian(value);
+        std::memcpy(out, &value, sizeof(value));
+        out += sizeof(value);
+    };
+
+    append(static_cast<std::uint32_t>(section));
+    for (auto const & checksum : checksums) {
+        append(checksum.offset);
+        append(checksum.length);
+        append(checksum.crc32c);
+    }
+    return write_frame(sink, StreamSection::BatchChecksums, payload.data(), payload.size());
+}
+
+/// \brief Parse a BatchChecksums frame, setting [section] to the table it belongs to.
+inline pod5::Result<std::vector<BatchChecksum>> parse_batch_checksums(
+    arrow::Buffer const & payload,
+    StreamSection * section)
+{
+    std::int64_t const entries_size = payload.size() - std::int64_t(sizeof(std::uint32_t));
+    if (entries_size < 0 || entries_size % BATCH_CHECKSUM_ENTRY_SIZE != 0) {
+        return arrow::Status::IOError("Invalid batch checksums in pod5 stream");
+    }
+
+    auto in = payload.data();
+    auto const take = [&](auto & value) {
+        std::memcpy(&value, in, sizeof(value));
+        value = arrow::bit_util::FromLittleEndian(value);
+        in += sizeof(value);
+    };
+
+    std::uint32_t section_value = 0;
+    take(section_value);
+    *section = static_cast<StreamSection>(section_value);
+
+    std::vector<BatchChecksum> checksums(entries_size / BATCH_CHECKSUM_ENTRY_SIZE);
+    for (auto & checksum : checksums) {
+        take(checksum.offset);
+        take(checksum.length);
+        take(checksum.crc32c);
+    }
+    return checksums;
+}
+
+/// \brief Output stream writing one section of a pod5 stream as frames into a shared sink.
+/// \details Writes are collected into frames of up to [max_frame_size] bytes, a frame is also
+///          written on Flush() and Close(). Tell() reports the position within the section, so
+///          table writers see the section as a file of its own. Closing leaves the sink open.
+class FramedOutputStream : public arrow::io::OutputStream {
+public:
+    static constexpr std::uint32_t DEFAULT_MAX_FRAME_SIZE = 1024 * 1024;
+
+    FramedOutputStream(
+        std::shared_ptr<arrow::io::OutputStream> const & sink,
+        StreamSection section,
+        std::uint32_t max_frame_size = DEFAULT_MAX_FRAME_SIZE)
+    : m_sink(sink)
+    , m_section(section)
+    , m_max_frame_size(max_frame_size)
+    {
+        m_frame.reserve(m_max_frame_size);
+    }
+
+    arrow::Status Close() override
+    {
+        if (m_closed) {
+            return arrow::Status::OK();
+        }
+        ARROW_RETURN_NOT_OK(write_pending_frame());
+        m_closed = true;
+        return arrow::Status::OK();
+    }
+
+    bool closed() const override { return m_closed; }
+
+    arrow::Result<std::int64_t> Tell() const override { return m_position; }
+
+    arrow::Status Write(void const * data, std::int64_t nbytes) override
+    {
+        if (m_closed) {
+            return arrow::Status::IOError("Write to closed stream section");
+        }
+
+        auto bytes = static_cast<std::uint8_t const *>(data);
+        m_position += nbytes;
+        while (nbytes > 0) {
+            auto const to_copy =
+                std::min<std::int64_t>(nbytes, m_max_frame_size - m_frame.size());
+            m_frame.insert(m_frame.end(), bytes, bytes + to_copy);
+            bytes += to_copy;
+            nbytes -= to_copy;
+            if (m_frame.size() == m_max_frame_size) {
+                ARROW_RETURN_NOT_OK(write_pending_frame());
+            }
+        }
+        return arrow::Status::OK();
+    }
+
+    arrow::Status Flush() override
+    {
+        ARROW_RETURN_NOT_OK(write_pending_frame());
+        return m_sink->Flush();
+    }
+
+private:
+    arrow::Status write_pending_frame()
+    {
+        if (m_frame.empty()) {
+            return arrow::Status::OK();
+        }
+        ARROW_RETURN_NOT_OK(write_frame(m_sink, m_section, m_frame.data(), m_frame.size()));
+        m_frame.clear();
+        return arrow::Status::OK();
+    }
+
+    std::shared_ptr<arrow::io::OutputStream> m_sink;
+    StreamSection const m_section;
+    std::uint32_t const m_max_frame_size;
+    std::vector<std::uint8_t> m_frame;
+    std::int64_t m_position = 0;
+    bool m_closed = false;
+};
+
+/// \brief Read exactly [length] bytes from [stream], failing if it ends first.
+inline pod5::Result<std::shared_ptr<arrow::Buffer>> read_exactly(
+    std::shared_ptr<arrow::io::InputStream> const & stream,
+    std::int64_t length)
+{
+    ARROW_ASSIGN_OR_RAISE(auto buffer, stream->Read(length));
+    if (buffer->size() != length) {
+        return arrow::Status::IOError("Unexpected end of pod5 stream");
+    }
+    return buffer;
+}
+
+inline pod5::Status check_stream_signature(std::shared_ptr<arrow::io::InputStream> const & stream)
+{
+    ARROW_ASSIGN_OR_RAISE(auto signature, stream->Read(STREAM_SIGNATURE.size()));
+    if (signature->size() != std::int64_t(STREAM_SIGNATURE.size())
+        || std::memcmp(signature->data(), STREAM_SIGNATURE.data(), STREAM_SIGNATURE.size()) != 0)
+    {
+        return arrow::Status::IOError("Invalid signature in pod5 stream");
+    }
+    return arrow::Status::OK();
+}
+
+inline pod5::Result<FrameHeader> read_frame_header(
+    std::shared_ptr<arrow::io::InputStream> const & stream)
+{
+    ARROW_ASSIGN_OR_RAISE(auto buffer, stream->Read(frame_header_size));
+    if (buffer->size() != std::int64_t(frame_header_size)) {
+        return arrow::Status::IOError(
+            "Pod5 stream ended before its trailer, was the writer closed?");
+    }
+
+    std::array<std::uint32_t, 2> header;
+    std::memcpy(header.data(), buffer->data(), frame_header_size);
+    return FrameHeader{
+        static_cast<StreamSection>(arrow::bit_util::FromLittleEndian(header[0])),
+        arrow::bit_util::FromLittleEndian(header[1])};
+}
+
+}}  // namespace pod5::stream_file_utils
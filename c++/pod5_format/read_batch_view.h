@@ -0,0 +1,226 @@
+#pragma once
+
+#include "pod5_format/read_table_reader.h"
+#include "pod5_format/read_table_schema.h"
+#include "pod5_format/result.h"
+#include "pod5_format/signal_statistics.h"
+
+#include <arrow/array/array_dict.h>
+#include <arrow/array/array_nested.h>
+#include <arrow/array/array_primitive.h>
+#include <arrow/util/bit_util.h>
+#include <boost/optional/optional.hpp>
+#include <boost/uuid/uuid.hpp>
+#include <gsl/gsl-lite.hpp>
+
+#include <cstdint>
+
+namespace pod5 {
+
+/// \brief Typed, per-version view over the rows of a read table batch.
+/// \details All column buffers are resolved once when the view is made, row accessors are then
+///          plain array loads with no field lookups, shared_ptr copies or version checks.
+///          Only the versions a FileReader can hand out (files are migrated to the latest version
+///          on open) are specialised.
+/// \note The view shares ownership of the batch data, it remains valid after the
+///       ReadTableRecordBatch it was made from is destroyed.
+template <TableSpecVersion::UnderlyingType Version>
+class ReadBatchView;
+
+template <>
+class ReadBatchView<3> {
+public:
+    static constexpr TableSpecVersion::UnderlyingType version = 3;
+
+    static Result<ReadBatchView> make(ReadTableRecordBatch const & batch)
+    {
+        ARROW_ASSIGN_OR_RAISE(auto columns, batch.columns());
+        if (columns.table_version.as_int() != version) {
+            return arrow::Status::Invalid(
+                "Read batch view for table version ",
+                int(version),
+                " can not be used with table version ",
+                int(columns.table_version.as_int()));
+        }
+
+        ARROW_ASSIGN_OR_RAISE(auto pore_type, dictionary_indices(columns.pore_type));
+        ARROW_ASSIGN_OR_RAISE(auto end_reason, dictionary_indices(columns.end_reason));
+        ARROW_ASSIGN_OR_RAISE(auto run_info, dictionary_indices(columns.run_info));
+
+        ReadBatchView view;
+        view.m_batch = batch.batch();
+        view.m_num_rows = batch.num_rows();
+
+        view.m_read_id = columns.read_id->raw_values();
+        view.m_signal_offsets = columns.signal->raw_value_offsets();
+        view.m_signal_values =
+            std::static_pointer_cast<arrow::UInt64Array>(columns.signal->values())->raw_values();
+        view.m_read_number = columns.read_number->raw_values();
+        view.m_start_sample = columns.start_sample->raw_values();
+        view.m_median_before = columns.median_before->raw_values();
+        view.m_num_minknow_events = columns.num_minknow_events->raw_values();
+        view.m_tracked_scaling_scale = columns.tracked_scaling_scale->raw_values();
+        view.m_tracked_scaling_shift = columns.tracked_scaling_shift->raw_values();
+        view.m_predicted_scaling_scale = columns.predicted_scaling_scale->raw_values();
+        view.m_predicted_scaling_shift = columns.predicted_scaling_shift->raw_values();
+        view.m_num_reads_since_mux_change = columns.num_reads_since_mux_change->raw_values();
+        view.m_time_since_mux_change = columns.time_since_mux_change->raw_values();
+        view.m_num_samples = columns.num_samples->raw_values();
+        view.m_channel = columns.channel->raw_values();
+        view.m_well = columns.well->raw_values();
+        view.m_pore_type = pore_type;
+        view.m_calibration_offset = columns.calibration_offset->raw_values();
+        view.m_calibration_scale = columns.calibration_scale->raw_values();
+        view.m_end_reason = end_reason;
+        view.m_end_reason_forced = columns.end_reason_forced->values()->data();
+        view.m_end_reason_forced_offset = columns.end_reason_forced->offset();
+        view.m_run_info = run_info;
+
+        if (columns.signal_mean) {
+            view.m_has_signal_statistics = true;
+            view.m_signal_min = columns.signal_min->raw_values();
+            view.m_signal_max = columns.signal_max->raw_values();
+            view.m_signal_mean = columns.signal_mean->raw_values();
+            view.m_signal_stdev = columns.signal_stdev->raw_values();
+            view.m_signal_saturated_count = columns.signal_saturated_count->raw_values();
+            view.m_signal_statistics_validity = columns.signal_mean->null_bitmap_data();
+            view.m_signal_statistics_offset = columns.signal_mean->offset();
+        }
+        return view;
+    }
+
+    std::size_t num_rows() const { return m_num_rows; }
+
+    boost::uuids::uuid const & read_id(std::size_t row) const { return m_read_id[row]; }
+
+    std::uint32_t read_number(std::size_t row) const { return m_read_number[row]; }
+
+    std::uint64_t start_sample(std::size_t row) const { return m_start_sample[row]; }
+
+    float median_before(std::size_t row) const { return m_median_before[row]; }
+
+    std::uint64_t num_minknow_events(std::size_t row) const { return m_num_minknow_events[row]; }
+
+    float tracked_scaling_scale(std::size_t row) const { return m_tracked_scaling_scale[row]; }
+
+    float tracked_scaling_shift(std::size_t row) const { return m_tracked_scaling_shift[row]; }
+
+    float predicted_scaling_scale(std::size_t row) const { return m_predicted_scaling_scale[row]; }
+
+    float predicted_scaling_shift(std::size_t row) const { return m_predicted_scaling_shift[row]; }
+
+    std::uint32_t num_reads_since_mux_change(std::size_t row) const
+    {
+        return m_num_reads_since_mux_change[row];
+    }
+
+    float time_since_mux_change(std::size_t row) const { return m_time_since_mux_change[row]; }
+
+    std::uint64_t num_samples(std::size_t row) const { return m_num_samples[row]; }
+
+    std::uint16_t channel(std::size_t row) const { return m_channel[row]; }
+
+    std::uint8_t well(std::size_t row) const { return m_well[row]; }
+
+    std::int16_t pore_type(std::size_t row) const { return m_pore_type[row]; }
+
+    float calibration_offset(std::size_t row) const { return m_calibration_offset[row]; }
+
+    float calibration_scale(std::size_t row) const { return m_calibration_scale[row]; }
+
+    std::int16_t end_reason(std::size_t row) const { return m_end_reason[row]; }
+
+    bool end_reason_forced(std::size_t row) const
+    {
+        return arrow::bit_util::GetBit(m_end_reason_forced, m_end_reason_forced_offset + row);
+    }
+
+    std::int16_t run_info(std::size_t row) const { return m_run_info[row]; }
+
+    std::size_t signal_row_count(std::size_t row) const
+    {
+        return m_signal_offsets[row + 1] - m_signal_offsets[row];
+    }
+
+    gsl::span<std::uint64_t const> signal_rows(std::size_t row) const
+    {
+        return gsl::make_span(m_signal_values + m_signal_offsets[row], signal_row_count(row));
+    }
+
+    bool has_signal_statistics() const { return m_has_signal_statistics; }
+
+    /// Find the signal statistics for [row], if they were recorded for the read.
+    boost::optional<SignalStatistics> signal_statistics(std::size_t row) const
+    {
+        if (!m_has_signal_statistics
+            || (m_signal_statistics_validity
+                && !arrow::bit_util::GetBit(
+                    m_signal_statistics_validity, m_signal_statistics_offset + row)))
+        {
+            return boost::none;
+        }
+
+        SignalStatistics result;
+        result.min = m_signal_min[row];
+        result.max = m_signal_max[row];
+        result.mean = m_signal_mean[row];
+        result.stdev = m_signal_stdev[row];
+        result.saturated_count = m_signal_saturated_count[row];
+        return result;
+    }
+
+private:
+    ReadBatchView() = default;
+
+    static Result<std::int16_t const *> dictionary_indices(
+        std::shared_ptr<arrow::DictionaryArray> const & column)
+    {
+        auto const & indices = column->indices();
+        if (indices->type_id() != arrow::Type::INT16) {
+            return arrow::Status::TypeError(
+                "Unexpected dictionary index type ", indices->type()->ToString());
+        }
+        return std::static_pointer_cast<arrow::Int16Array>(indices)->raw_values();
+    }
+
+    std::shared_ptr<arrow::RecordBatch> m_batch;
+    std::size_t m_num_rows = 0;
+
+    boost::uuids::uuid const * m_read_id = nullptr;
+    std::int32_t const * m_signal_offsets = nullptr;
+    std::uint64_t const * m_signal_values = nullptr;
+    std::uint32_t const * m_read_number = nullptr;
+    std::uint64_t const * m_start_sample = nullptr;
+    float const * m_median_before = nullptr;
+    std::uint64_t const * m_num_minknow_events = nullptr;
+    float const * m_tracked_scaling_scale = nullptr;
+    float const * m_tracked_scaling_shift = nullptr;
+    float const * m_predicted_scaling_scale = nullptr;
+    float const * m_predicted_scaling_shift = nullptr;
+    std::uint32_t const * m_num_reads_since_mux_change = nullptr;
+    float const * m_time_since_mux_change = nullptr;
+    std::uint64_t const * m_num_samples = nullptr;
+    std::uint16_t const * m_channel = nullptr;
+    std::uint8_t const * m_well = nullptr;
+    std::int16_t const * m_pore_type = nullptr;
+    float const * m_calibration_offset = nullptr;
+    float const * m_calibration_scale = nullptr;
+    std::int16_t const * m_end_reason = nullptr;
+    std::uint8_t const * m_end_reason_forced = nullptr;
+    std::int64_t m_end_reason_forced_offset = 0;
+    std::int16_t const * m_run_info = nullptr;
+
+    bool m_has_signal_statistics = false;
+    std::int16_t const * m_signal_min = nullptr;
+    std::int16_t const * m_signal_max = nullptr;
+    float const * m_signal_mean = nullptr;
+    float const * m_signal_stdev = nullptr;
+    std::uint64_t const * m_signal_saturated_count = nullptr;
+    std::uint8_t const * m_signal_statistics_validity = nullptr;
+    std::int64_t m_signal_statistics_offset = 0;
+};
+
+/// View type matching the table version produced by FileReader, which migrates files on open.
+using LatestReadBatchView = ReadBatchView<3>;
+
+}  // namespace pod5
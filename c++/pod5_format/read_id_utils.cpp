@@ -0,0 +1,286 @@
+#include "pod5_format/read_id_utils.h"
+
+#include "pod5_format/svb16/common.hpp"
+#ifdef SVB16_X64
+#include "pod5_format/svb16/intrinsics.hpp"
+#include "pod5_format/svb16/simd_detect_x64.hpp"
+#endif
+
+#include <cstring>
+
+namespace pod5 {
+
+namespace {
+
+constexpr char HexDigits[] = "0123456789abcdef";
+
+// Positions of the dashes in a formatted read id:
+constexpr std::size_t DashPositions[] = {8, 13, 18, 23};
+
+void format_read_id_scalar(std::uint8_t const * bytes, char * output)
+{
+    std::size_t out = 0;
+    for (std::size_t i = 0; i < 16; ++i) {
+        if (out == 8 || out == 13 || out == 18 || out == 23) {
+            output[out++] = '-';
+        }
+        output[out++] = HexDigits[bytes[i] >> 4];
+        output[out++] = HexDigits[bytes[i] & 0xf];
+    }
+}
+
+int hex_value(char c)
+{
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    auto const lower = c | 0x20;
+    if (lower >= 'a' && lower <= 'f') {
+        return lower - 'a' + 10;
+    }
+    return -1;
+}
+
+bool has_dashes(char const * input)
+{
+    for (auto position : DashPositions) {
+        if (input[position] != '-') {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool parse_read_id_scalar(char const * input, std::uint8_t * bytes)
+{
+    if (!has_dashes(input)) {
+        return false;
+    }
+    std::size_t in = 0;
+    for (std::size_t i = 0; i < 16; ++i) {
+        if (in == 8 || in == 13 || in == 18 || in == 23) {
+            ++in;
+        }
+        auto const high = hex_value(input[in++]);
+        auto const low = hex_value(input[in++]);
+        if (high < 0 || low < 0) {
+            return false;
+        }
+        bytes[i] = static_cast<std::uint8_t>((high << 4) | low);
+    }
+    return true;
+}
+
+#ifdef SVB16_X64
+
+constexpr std::uint8_t Zero = 0x80;
+
+/// Format 16 bytes as 36 characters, writing all 36.
+[[gnu::target("ssse3")]] void format_read_id_ssse3(std::uint8_t const * bytes, char * output)
+{
+    auto const value = _mm_loadu_si128(reinterpret_cast<__m128i const *>(bytes));
+    auto const low_nibbles = _mm_set1_epi8(0x0f);
+    auto const high = _mm_and_si128(_mm_srli_epi16(value, 4), low_nibbles);
+    auto const low = _mm_and_si128(value, low_nibbles);
+
+    auto const digits = _mm_loadu_si128(reinterpret_cast<__m128i const *>(HexDigits));
+    // Characters 0-15 and 16-31 of the id without dashes:
+    auto const first = _mm_shuffle_epi8(digits, _mm_unpacklo_epi8(high, low));
+    auto const second = _mm_shuffle_epi8(digits, _mm_unpackhi_epi8(high, low));
+
+    auto const out_0 = _mm_or_si128(
+        _mm_shuffle_epi8(
+            first, _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, Zero, 8, 9, 10, 11, Zero, 12, 13)),
+        _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, '-', 0, 0, 0, 0, '-', 0, 0));
+    auto const out_16 = _mm_or_si128(
+        _mm_or_si128(
+            _mm_shuffle_epi8(
+                first,
+                _mm_setr_epi8(
+                    14, 15, Zero, Zero, Zero, Zero, Zero, Zero, Zero, Zero, Zero, Zero, Zero,
+                    Zero, Zero, Zero)),
+            _mm_shuffle_epi8(
+                second,
+                _mm_setr_epi8(Zero, Zero, Zero, 0, 1, 2, 3, Zero, 4, 5, 6, 7, 8, 9, 10, 11))),
+        _mm_setr_epi8(0, 0, '-', 0, 0, 0, 0, '-', 0, 0, 0, 0, 0, 0, 0, 0));
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(output), out_0);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(output + 16), out_16);
+    auto const tail = static_cast<std::uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(second, 12)));
+    std::memcpy(output + 32, &tail, sizeof(tail));
+}
+
+/// Convert 16 hex characters to their values, clearing [valid] if any aren't hex.
+[[gnu::target("ssse3")]] __m128i hex_values_ssse3(__m128i characters, bool * valid)
+{
+    auto const digit = _mm_sub_epi8(characters, _mm_set1_epi8('0'));
+    auto const is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+    auto const letter =
+        _mm_sub_epi8(_mm_or_si128(characters, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    auto const is_letter = _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(5)), letter);
+    if (_mm_movemask_epi8(_mm_or_si128(is_digit, is_letter)) != 0xffff) {
+        *valid = false;
+    }
+    return _mm_or_si128(
+        _mm_and_si128(is_digit, digit),
+        _mm_and_si128(is_letter, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+}
+
+/// Parse 36 characters into 16 bytes.
+[[gnu::target("ssse3")]] bool parse_read_id_ssse3(char const * input, std::uint8_t * bytes)
+{
+    if (!has_dashes(input)) {
+        return false;
+    }
+    auto const in_0 = _mm_loadu_si128(reinterpret_cast<__m128i const *>(input));
+    auto const in_16 = _mm_loadu_si128(reinterpret_cast<__m128i const *>(input + 16));
+    auto const in_20 = _mm_loadu_si128(reinterpret_cast<__m128i const *>(input + 20));
+
+    // Gather the 32 hex characters, dropping the dashes:
+    auto const first = _mm_or_si128(
+        _mm_shuffle_epi8(
+            in_0, _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 9, 10, 11, 12, 14, 15, Zero, Zero)),
+        _mm_shuffle_epi8(
+            in_16,
+            _mm_setr_epi8(
+                Zero, Zero, Zero, Zero, Zero, Zero, Zero, Zero, Zero, Zero, Zero, Zero, Zero,
+                Zero, 0, 1)));
+    auto const second = _mm_or_si128(
+        _mm_shuffle_epi8(
+            in_16,
+            _mm_setr_epi8(3, 4, 5, 6, 8, 9, 10, 11, 12, 13, 14, 15, Zero, Zero, Zero, Zero)),
+        _mm_shuffle_epi8(
+            in_20,
+            _mm_setr_epi8(
+                Zero, Zero, Zero, Zero, Zero, Zero, Zero, Zero, Zero, Zero, Zero, Zero, 12, 13,
+                14, 15)));
+
+    bool valid = true;
+    auto const first_values = hex_values_ssse3(first, &valid);
+    auto const second_values = hex_values_ssse3(second, &valid);
+    if (!valid) {
+        return false;
+    }
+
+    // Combine each pair of nibbles into a byte, high nibble first:
+    auto const nibble_weights = _mm_set1_epi16(0x0110);
+    auto const value = _mm_packus_epi16(
+        _mm_maddubs_epi16(first_values, nibble_weights),
+        _mm_maddubs_epi16(second_values, nibble_weights));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(bytes), value);
+    return true;
+}
+
+bool use_ssse3()
+{
+    static bool const available = has_ssse3();
+    return available;
+}
+
+#endif
+
+void format_read_id_fast(boost::uuids::uuid const & read_id, char * output)
+{
+#ifdef SVB16_X64
+    if (use_ssse3()) {
+        format_read_id_ssse3(read_id.data, output);
+        return;
+    }
+#endif
+    format_read_id_scalar(read_id.data, output);
+}
+
+/// Parse the canonical form of a read id from [input], READ_ID_STRING_LENGTH characters long.
+bool parse_canonical_read_id(char const * input, boost::uuids::uuid * read_id)
+{
+#ifdef SVB16_X64
+    if (use_ssse3()) {
+        return parse_read_id_ssse3(input, read_id->data);
+    }
+#endif
+    return parse_read_id_scalar(input, read_id->data);
+}
+
+}  // namespace
+
+void format_read_id(boost::uuids::uuid const & read_id, char * output)
+{
+    format_read_id_fast(read_id, output);
+}
+
+Status format_read_ids(
+    gsl::span<boost::uuids::uuid const> read_ids,
+    gsl::span<char> output,
+    std::size_t stride)
+{
+    if (stride < READ_ID_STRING_LENGTH) {
+        return Status::Invalid(
+            "Read id stride ", stride, " is shorter than ", READ_ID_STRING_LENGTH, " characters");
+    }
+    if (output.size() < read_ids.size() * stride) {
+        return Status::Invalid(
+            "Output of ",
+            output.size(),
+            " characters is too short for ",
+            read_ids.size(),
+            " read ids");
+    }
+
+    auto out = output.data();
+    for (auto const & read_id : read_ids) {
+        format_read_id_fast(read_id, out);
+        if (stride > READ_ID_STRING_LENGTH) {
+            out[READ_ID_STRING_LENGTH] = '\0';
+        }
+        out += stride;
+    }
+    return Status::OK();
+}
+
+bool parse_read_id(gsl::span<char const> input, boost::uuids::uuid * read_id)
+{
+    return input.size() == READ_ID_STRING_LENGTH && parse_canonical_read_id(input.data(), read_id);
+}
+
+Result<std::size_t> parse_read_ids(
+    gsl::span<char const> input,
+    std::size_t stride,
+    gsl::span<boost::uuids::uuid> read_ids,
+    gsl::span<std::uint8_t> valid)
+{
+    if (stride == 0) {
+        return Status::Invalid("Read id stride must be non zero");
+    }
+    if (input.size() < read_ids.size() * stride) {
+        return Status::Invalid(
+            "Input of ",
+            input.size(),
+            " characters is too short for ",
+            read_ids.size(),
+            " read ids");
+    }
+    if (!valid.empty() && valid.size() < read_ids.size()) {
+        return Status::Invalid(
+            "Valid flags of ", valid.size(), " entries is too short for ", read_ids.size());
+    }
+
+    std::size_t valid_count = 0;
+    for (std::size_t i = 0; i < read_ids.size(); ++i) {
+        auto const entry = input.data() + i * stride;
+        auto const terminator = static_cast<char const *>(std::memchr(entry, '\0', stride));
+        auto const length = terminator ? std::size_t(terminator - entry) : stride;
+
+        bool const parsed = parse_read_id(gsl::make_span(entry, length), &read_ids[i]);
+        if (parsed) {
+            ++valid_count;
+        } else {
+            read_ids[i] = boost::uuids::uuid{};
+        }
+        if (!valid.empty()) {
+            valid[i] = parsed ? 1 : 0;
+        }
+    }
+    return valid_count;
+}
+
+}  // namespace pod5
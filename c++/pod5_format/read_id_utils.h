@@ -0,0 +1,48 @@
+#pragma once
+
+#include "pod5_format/pod5_format_export.h"
+#include "pod5_format/result.h"
+
+#include <boost/uuid/uuid.hpp>
+#include <gsl/gsl-lite.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace pod5 {
+
+/// \brief The length of a formatted read id, eg. "0000173c-bf67-44e7-9a9c-1ad0bc728e74",
+///        without a null terminator.
+static constexpr std::size_t READ_ID_STRING_LENGTH = 36;
+
+/// \brief Format [read_id] as lower case hex with dashes into [output], which must hold
+///        READ_ID_STRING_LENGTH characters. No null terminator is written.
+POD5_FORMAT_EXPORT void format_read_id(boost::uuids::uuid const & read_id, char * output);
+
+/// \brief Format each of [read_ids] into [output], one every [stride] characters.
+/// \details Where [stride] is longer than READ_ID_STRING_LENGTH each string is null terminated,
+///          and any characters after the terminator are left as they were.
+/// \returns Invalid if [stride] or [output] are too short.
+POD5_FORMAT_EXPORT Status format_read_ids(
+    gsl::span<boost::uuids::uuid const> read_ids,
+    gsl::span<char> output,
+    std::size_t stride = READ_ID_STRING_LENGTH + 1);
+
+/// \brief Parse a read id from [input].
+/// \details Only the 36 character form with dashes is accepted, in upper or lower case.
+/// \returns false if [input] isn't a read id.
+POD5_FORMAT_EXPORT bool parse_read_id(gsl::span<char const> input, boost::uuids::uuid * read_id);
+
+/// \brief Parse [count] read ids from [input], one every [stride] characters.
+/// \details Each entry runs up to its first null or to [stride] characters, so null padded fixed
+///          width strings (eg. numpy "S36" arrays) and null terminated strings can be passed.
+///          Read ids which don't parse are left zeroed in [read_ids].
+/// \param valid Optional, set to 1 for each entry which parsed and 0 otherwise.
+/// \returns The number of entries which parsed, or Invalid if a buffer is too short.
+POD5_FORMAT_EXPORT Result<std::size_t> parse_read_ids(
+    gsl::span<char const> input,
+    std::size_t stride,
+    gsl::span<boost::uuids::uuid> read_ids,
+    gsl::span<std::uint8_t> valid = {});
+
+}  // namespace pod5
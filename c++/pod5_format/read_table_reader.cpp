@@ -1,5 +1,6 @@
 #include "pod5_format/read_table_reader.h"
 
+#include "pod5_format/internal/pinned_buffer_file.h"
 #include "pod5_format/read_table_utils.h"
 #include "pod5_format/schema_metadata.h"
 #include "pod5_format/schema_utils.h"
@@ -20,12 +21,17 @@ ReadTableRecordBatch::ReadTableRecordBatch(
 : TableRecordBatch(std::move(batch))
 , m_field_locations(field_locations)
 {
+    decode_dictionaries();
 }
 
 ReadTableRecordBatch::ReadTableRecordBatch(ReadTableRecordBatch && other)
 : TableRecordBatch(std::move(other))
 {
     m_field_locations = std::move(other.m_field_locations);
+    m_pore_types = std::move(other.m_pore_types);
+    m_end_reason_strings = std::move(other.m_end_reason_strings);
+    m_end_reasons = std::move(other.m_end_reasons);
+    m_run_infos = std::move(other.m_run_infos);
 }
 
 ReadTableRecordBatch & ReadTableRecordBatch::operator=(ReadTableRecordBatch && other)
@@ -34,9 +40,68 @@ ReadTableRecordBatch & ReadTableRecordBatch::operator=(ReadTableRecordBatch && o
     base = other;
 
     m_field_locations = std::move(other.m_field_locations);
+    m_pore_types = std::move(other.m_pore_types);
+    m_end_reason_strings = std::move(other.m_end_reason_strings);
+    m_end_reasons = std::move(other.m_end_reasons);
+    m_run_infos = std::move(other.m_run_infos);
     return *this;
 }
 
+namespace {
+std::vector<std::string> decode_string_dictionary(
+    std::shared_ptr<arrow::DictionaryArray> const & column)
+{
+    std::vector<std::string> result;
+    if (!column || !column->dictionary()) {
+        return result;
+    }
+
+    auto const & dictionary = std::static_pointer_cast<arrow::StringArray>(column->dictionary());
+    result.reserve(dictionary->length());
+    for (std::int64_t i = 0; i < dictionary->length(); ++i) {
+        result.emplace_back(dictionary->GetString(i));
+    }
+    return result;
+}
+
+Result<DictionaryColumnData> make_dictionary_column_data(
+    std::shared_ptr<arrow::DictionaryArray> const & column,
+    std::vector<std::string> const & values)
+{
+    auto const & indices = column->indices();
+    if (indices->type_id() != arrow::Type::INT16) {
+        return arrow::Status::TypeError(
+            "Unexpected dictionary index type ", indices->type()->ToString());
+    }
+
+    auto const & typed_indices = std::static_pointer_cast<arrow::Int16Array>(indices);
+    return DictionaryColumnData{
+        gsl::make_span(typed_indices->raw_values(), typed_indices->length()),
+        gsl::make_span(values)};
+}
+}  // namespace
+
+void ReadTableRecordBatch::decode_dictionaries()
+{
+    auto const & bat = batch();
+    if (m_field_locations->pore_type.found_field()) {
+        m_pore_types = decode_string_dictionary(find_column(bat, m_field_locations->pore_type));
+    }
+
+    if (m_field_locations->end_reason.found_field()) {
+        m_end_reason_strings =
+            decode_string_dictionary(find_column(bat, m_field_locations->end_reason));
+        m_end_reasons.reserve(m_end_reason_strings.size());
+        for (auto const & str_value : m_end_reason_strings) {
+            m_end_reasons.push_back(end_reason_from_string(str_value));
+        }
+    }
+
+    if (m_field_locations->run_info.found_field()) {
+        m_run_infos = decode_string_dictionary(find_column(bat, m_field_locations->run_info));
+    }
+}
+
 std::shared_ptr<UuidArray> ReadTableRecordBatch::read_id_column() const
 {
     return find_column(batch(), m_field_locations->read_id);
@@ -47,6 +112,14 @@ std::shared_ptr<arrow::ListArray> ReadTableRecordBatch::signal_column() const
     return find_column(batch(), m_field_locations->signal);
 }
 
+Result<std::shared_ptr<arrow::UInt64Array>> ReadTableRecordBatch::num_samples_column() const
+{
+    if (m_field_locations->table_version() < ReadTableSpecVersion::v2()) {
+        return arrow::Status::Invalid("Read table version has no num_samples column");
+    }
+    return find_column(batch(), m_field_locations->num_samples);
+}
+
 Result<ReadTableRecordColumns> ReadTableRecordBatch::columns() const
 {
     ReadTableRecordColumns result;
@@ -93,6 +166,16 @@ Result<ReadTableRecordColumns> ReadTableRecordBatch::columns() const
         result.run_info = find_column(bat, m_field_locations->run_info);
     }
 
+    // Optional fields:
+    if (has_signal_statistics()) {
+        result.signal_min = find_column(bat, m_field_locations->signal_min);
+        result.signal_max = find_column(bat, m_field_locations->signal_max);
+        result.signal_mean = find_column(bat, m_field_locations->signal_mean);
+        result.signal_stdev = find_column(bat, m_field_locations->signal_stdev);
+        result.signal_saturated_count =
+            find_column(bat, m_field_locations->signal_saturated_count);
+    }
+
     return result;
 }
 
@@ -120,78 +203,125 @@ Result<std::shared_ptr<arrow::UInt64Array>> ReadTableRecordBatch::get_signal_row
 
 Result<std::string> ReadTableRecordBatch::get_pore_type(std::int16_t pore_index) const
 {
-    std::lock_guard<std::mutex> l(m_dictionary_access_lock);
-
     if (!m_field_locations->pore_type.found_field()) {
         return arrow::Status::Invalid("pore field is not present in the file");
     }
 
-    auto pore_column = find_column(batch(), m_field_locations->pore_type);
-    auto pore_data = std::static_pointer_cast<arrow::StringArray>(pore_column->dictionary());
-    if (pore_index < 0 || pore_index >= pore_data->length()) {
+    if (pore_index < 0 || pore_index >= (std::int64_t)m_pore_types.size()) {
         return arrow::Status::IndexError(
-            "Invalid index ", pore_index, " for pore array of length ", pore_data->length());
+            "Invalid index ", pore_index, " for pore array of length ", m_pore_types.size());
     }
 
-    return pore_data->Value(pore_index).to_string();
+    return m_pore_types[pore_index];
 }
 
 Result<std::pair<ReadEndReason, std::string>> ReadTableRecordBatch::get_end_reason(
     std::int16_t end_reason_index) const
 {
-    std::lock_guard<std::mutex> l(m_dictionary_access_lock);
-
     if (!m_field_locations->end_reason.found_field()) {
         return arrow::Status::Invalid("end_reason field is not present in the file");
     }
 
-    auto end_reason_column = find_column(batch(), m_field_locations->end_reason);
-    auto end_reason_data =
-        std::static_pointer_cast<arrow::StringArray>(end_reason_column->dictionary());
-    if (end_reason_index >= end_reason_data->length()) {
+    if (end_reason_index < 0 || end_reason_index >= (std::int64_t)m_end_reasons.size()) {
         return arrow::Status::IndexError(
             "Invalid index ",
             end_reason_index,
             " for end reason array of length ",
-            end_reason_data->length());
+            m_end_reasons.size());
     }
 
-    auto str_value = end_reason_data->Value(end_reason_index).to_string();
-
-    return std::make_pair(end_reason_from_string(str_value), str_value);
+    return std::make_pair(m_end_reasons[end_reason_index], m_end_reason_strings[end_reason_index]);
 }
 
 Result<std::string> ReadTableRecordBatch::get_run_info(std::int16_t run_info_index) const
 {
-    std::lock_guard<std::mutex> l(m_dictionary_access_lock);
-
     if (!m_field_locations->run_info.found_field()) {
-        return arrow::Status::Invalid("end_reason field is not present in the file");
+        return arrow::Status::Invalid("run_info field is not present in the file");
     }
 
-    auto run_info_column = find_column(batch(), m_field_locations->run_info);
-    auto run_info_data =
-        std::static_pointer_cast<arrow::StringArray>(run_info_column->dictionary());
-    if (run_info_index < 0 || run_info_index >= run_info_data->length()) {
+    if (run_info_index < 0 || run_info_index >= (std::int64_t)m_run_infos.size()) {
         return arrow::Status::IndexError(
             "Invalid index ",
             run_info_index,
             " for run info array of length ",
-            run_info_data->length());
+            m_run_infos.size());
+    }
+
+    return m_run_infos[run_info_index];
+}
+
+bool ReadTableRecordBatch::has_signal_statistics() const
+{
+    return m_field_locations->signal_min.found_field()
+           && m_field_locations->signal_max.found_field()
+           && m_field_locations->signal_mean.found_field()
+           && m_field_locations->signal_stdev.found_field()
+           && m_field_locations->signal_saturated_count.found_field();
+}
+
+Result<SignalStatistics> ReadTableRecordBatch::get_signal_statistics(std::int64_t batch_row) const
+{
+    if (!has_signal_statistics()) {
+        return arrow::Status::KeyError("signal statistics are not present in the file");
+    }
+
+    if (batch_row < 0 || batch_row >= (std::int64_t)num_rows()) {
+        return arrow::Status::IndexError(
+            "Invalid index ", batch_row, " for batch of length ", num_rows());
     }
 
-    return run_info_data->Value(run_info_index).to_string();
+    auto const & bat = batch();
+    auto const signal_mean = find_column(bat, m_field_locations->signal_mean);
+    if (signal_mean->IsNull(batch_row)) {
+        return arrow::Status::KeyError("signal statistics were not recorded for the read");
+    }
+
+    SignalStatistics result;
+    result.min = find_column(bat, m_field_locations->signal_min)->Value(batch_row);
+    result.max = find_column(bat, m_field_locations->signal_max)->Value(batch_row);
+    result.mean = signal_mean->Value(batch_row);
+    result.stdev = find_column(bat, m_field_locations->signal_stdev)->Value(batch_row);
+    result.saturated_count =
+        find_column(bat, m_field_locations->signal_saturated_count)->Value(batch_row);
+    return result;
+}
+
+Result<DictionaryColumnData> ReadTableRecordBatch::pore_type_column() const
+{
+    if (!m_field_locations->pore_type.found_field()) {
+        return arrow::Status::Invalid("pore field is not present in the file");
+    }
+    return make_dictionary_column_data(
+        find_column(batch(), m_field_locations->pore_type), m_pore_types);
+}
+
+Result<DictionaryColumnData> ReadTableRecordBatch::end_reason_column() const
+{
+    if (!m_field_locations->end_reason.found_field()) {
+        return arrow::Status::Invalid("end_reason field is not present in the file");
+    }
+    return make_dictionary_column_data(
+        find_column(batch(), m_field_locations->end_reason), m_end_reason_strings);
+}
+
+Result<DictionaryColumnData> ReadTableRecordBatch::run_info_column() const
+{
+    if (!m_field_locations->run_info.found_field()) {
+        return arrow::Status::Invalid("run_info field is not present in the file");
+    }
+    return make_dictionary_column_data(
+        find_column(batch(), m_field_locations->run_info), m_run_infos);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
 
 ReadTableReader::ReadTableReader(
-    std::shared_ptr<void> && input_source,
+    std::shared_ptr<arrow::io::RandomAccessFile> const & input_source,
     std::shared_ptr<arrow::ipc::RecordBatchFileReader> && reader,
     std::shared_ptr<ReadTableSchemaDescription const> const & field_locations,
     SchemaMetadataDescription && schema_metadata,
     arrow::MemoryPool * pool)
-: TableReader(std::move(input_source), std::move(reader), std::move(schema_metadata), pool)
+: TableReader(input_source, std::move(reader), std::move(schema_metadata), pool)
 , m_field_locations(field_locations)
 {
 }
@@ -214,13 +344,23 @@ ReadTableReader & ReadTableReader::operator=(ReadTableReader && other)
 Result<ReadTableRecordBatch> ReadTableReader::read_record_batch(std::size_t i) const
 {
     std::lock_guard<std::mutex> l(m_batch_get_mutex);
-    auto record_batch = reader()->ReadRecordBatch(i);
+    auto record_batch = read_checked_record_batch(i);
     if (!record_batch.ok()) {
         return record_batch.status();
     }
     return ReadTableRecordBatch{std::move(*record_batch), m_field_locations};
 }
 
+Result<ReadTableRecordBatch> ReadTableReader::read_and_check_record_batch(
+    std::size_t i,
+    BatchChecksumReport & report) const
+{
+    auto const checked_bytes = check_record_batch(i, "read", report);
+    std::lock_guard<std::mutex> l(m_batch_get_mutex);
+    ARROW_ASSIGN_OR_RAISE(auto record_batch, decode_record_batch(i, checked_bytes));
+    return ReadTableRecordBatch{std::move(record_batch), m_field_locations};
+}
+
 Status ReadTableReader::build_read_id_lookup()
 {
     if (!m_sorted_file_read_ids.empty()) {
@@ -326,7 +466,10 @@ Result<ReadTableReader> make_read_table_reader(
     arrow::ipc::IpcReadOptions options;
     options.memory_pool = pool;
 
-    ARROW_ASSIGN_OR_RAISE(auto reader, arrow::ipc::RecordBatchFileReader::Open(input, options));
+    // Read through a file which can serve batches from the bytes read to verify them:
+    auto const table_input = std::make_shared<PinnedBufferFile>(input);
+    ARROW_ASSIGN_OR_RAISE(
+        auto reader, arrow::ipc::RecordBatchFileReader::Open(table_input, options));
 
     auto read_metadata_key_values = reader->schema()->metadata();
     if (!read_metadata_key_values) {
@@ -338,7 +481,7 @@ Result<ReadTableReader> make_read_table_reader(
         auto field_locations, read_read_table_schema(read_metadata, reader->schema()));
 
     return ReadTableReader(
-        {input}, std::move(reader), field_locations, std::move(read_metadata), pool);
+        table_input, std::move(reader), field_locations, std::move(read_metadata), pool);
 }
 
 }  // namespace pod5
@@ -5,6 +5,7 @@
 #include "pod5_format/read_table_utils.h"
 #include "pod5_format/result.h"
 #include "pod5_format/schema_metadata.h"
+#include "pod5_format/signal_statistics.h"
 #include "pod5_format/table_reader.h"
 #include "pod5_format/types.h"
 
@@ -61,9 +62,23 @@ struct ReadTableRecordColumns {
     std::shared_ptr<arrow::BooleanArray> end_reason_forced;
     std::shared_ptr<arrow::DictionaryArray> run_info;
 
+    // Optional fields, null if the file was written without signal statistics:
+    std::shared_ptr<arrow::Int16Array> signal_min;
+    std::shared_ptr<arrow::Int16Array> signal_max;
+    std::shared_ptr<arrow::FloatArray> signal_mean;
+    std::shared_ptr<arrow::FloatArray> signal_stdev;
+    std::shared_ptr<arrow::UInt64Array> signal_saturated_count;
+
     TableSpecVersion table_version;
 };
 
+/// A dictionary column from a read table batch, split into per-row indices and the string table
+/// they refer to. Both spans are only valid while the owning ReadTableRecordBatch is alive.
+struct DictionaryColumnData {
+    gsl::span<std::int16_t const> indices;
+    gsl::span<std::string const> values;
+};
+
 class POD5_FORMAT_EXPORT ReadTableRecordBatch : public TableRecordBatch {
 public:
     ReadTableRecordBatch(
@@ -74,25 +89,47 @@ public:
 
     std::shared_ptr<UuidArray> read_id_column() const;
     std::shared_ptr<arrow::ListArray> signal_column() const;
+    /// Find the sample count of each read, answered without any signal table access.
+    /// \returns The column, or Invalid if the table predates the num_samples field.
+    Result<std::shared_ptr<arrow::UInt64Array>> num_samples_column() const;
 
     Result<std::string> get_pore_type(std::int16_t pore_dict_index) const;
     Result<std::pair<ReadEndReason, std::string>> get_end_reason(
         std::int16_t end_reason_dict_index) const;
     Result<std::string> get_run_info(std::int16_t run_info_dict_index) const;
 
+    /// Find if the batch carries signal statistics columns.
+    bool has_signal_statistics() const;
+    /// Find the signal statistics stored for [batch_row].
+    /// \returns The statistics, or a KeyError if none were stored for the read.
+    Result<SignalStatistics> get_signal_statistics(std::int64_t batch_row) const;
+
+    /// Bulk access to the dictionary columns, for callers decoding a whole batch at once.
+    Result<DictionaryColumnData> pore_type_column() const;
+    Result<DictionaryColumnData> end_reason_column() const;
+    Result<DictionaryColumnData> run_info_column() const;
+
     Result<ReadTableRecordColumns> columns() const;
 
     Result<std::shared_ptr<arrow::UInt64Array>> get_signal_rows(std::int64_t batch_row);
 
 private:
+    void decode_dictionaries();
+
     std::shared_ptr<ReadTableSchemaDescription const> m_field_locations;
-    mutable std::mutex m_dictionary_access_lock;
+
+    // Dictionary values are decoded once when the batch is loaded and never modified
+    // afterwards, so they can be read concurrently without locking.
+    std::vector<std::string> m_pore_types;
+    std::vector<std::string> m_end_reason_strings;
+    std::vector<ReadEndReason> m_end_reasons;
+    std::vector<std::string> m_run_infos;
 };
 
 class POD5_FORMAT_EXPORT ReadTableReader : public TableReader {
 public:
     ReadTableReader(
-        std::shared_ptr<void> && input_source,
+        std::shared_ptr<arrow::io::RandomAccessFile> const & input_source,
         std::shared_ptr<arrow::ipc::RecordBatchFileReader> && reader,
         std::shared_ptr<ReadTableSchemaDescription const> const & field_locations,
         SchemaMetadataDescription && schema_metadata,
@@ -103,6 +140,13 @@ public:
 
     Result<ReadTableRecordBatch> read_record_batch(std::size_t i) const;
 
+    /// \brief Read record batch [i], first checking it against its stored checksum whatever the
+    ///        verification setting, and adding the outcome to [report]. A batch passing the check
+    ///        is decoded from the checked bytes, so is only read from the file once.
+    Result<ReadTableRecordBatch> read_and_check_record_batch(
+        std::size_t i,
+        BatchChecksumReport & report) const;
+
     Status build_read_id_lookup();
 
     Result<std::size_t> search_for_read_ids(
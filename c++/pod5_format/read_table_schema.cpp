@@ -59,6 +59,17 @@ channel(this, "channel", arrow::uint16(), ReadTableSpecVersion::v3())
       "run_info",
       arrow::dictionary(arrow::int16(), arrow::utf8()),
       ReadTableSpecVersion::v3())
+,
+// Optional Fields
+signal_min(this, "signal_min", arrow::int16(), ReadTableSpecVersion::v3())
+, signal_max(this, "signal_max", arrow::int16(), ReadTableSpecVersion::v3())
+, signal_mean(this, "signal_mean", arrow::float32(), ReadTableSpecVersion::v3())
+, signal_stdev(this, "signal_stdev", arrow::float32(), ReadTableSpecVersion::v3())
+, signal_saturated_count(
+      this,
+      "signal_saturated_count",
+      arrow::uint64(),
+      ReadTableSpecVersion::v3())
 {
 }
 
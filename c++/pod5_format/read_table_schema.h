@@ -84,6 +84,13 @@ public:
     Field<19, arrow::BooleanArray> end_reason_forced;
     Field<20, arrow::DictionaryArray> run_info;
 
+    // Optional fields, present in files written with signal statistics:
+    OptionalField<21, arrow::Int16Array> signal_min;
+    OptionalField<22, arrow::Int16Array> signal_max;
+    OptionalField<23, arrow::FloatArray> signal_mean;
+    OptionalField<24, arrow::FloatArray> signal_stdev;
+    OptionalField<25, arrow::UInt64Array> signal_saturated_count;
+
     // Field Builders only for fields we write in newly generated files.
     // Should not include fields which are removed in the latest version:
     using FieldBuilders = FieldBuilder<
@@ -114,7 +121,14 @@ public:
         decltype(calibration_scale),
         decltype(end_reason),
         decltype(end_reason_forced),
-        decltype(run_info)>;
+        decltype(run_info),
+
+        // Optional fields
+        decltype(signal_min),
+        decltype(signal_max),
+        decltype(signal_mean),
+        decltype(signal_stdev),
+        decltype(signal_saturated_count)>;
 };
 
 POD5_FORMAT_EXPORT Result<std::shared_ptr<ReadTableSchemaDescription const>> read_read_table_schema(
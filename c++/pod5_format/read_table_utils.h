@@ -285,4 +285,15 @@ private:
     std::vector<InputId> m_search_read_ids;
 };
 
+/// \brief A set of read table rows to visit, in the form consumed by AsyncSignalLoader.
+/// \note AsyncSignalLoader refers to the plan's storage, the plan must outlive the loader.
+struct ReadTraversalPlan {
+    /// Number of rows to visit in each read table batch, one entry per batch.
+    std::vector<std::uint32_t> batch_counts;
+    /// Rows to visit, packed batch by batch and sorted within each batch.
+    std::vector<std::uint32_t> batch_rows;
+
+    std::size_t read_count() const { return batch_rows.size(); }
+};
+
 }  // namespace pod5
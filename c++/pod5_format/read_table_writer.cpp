@@ -1,8 +1,10 @@
 #include "pod5_format/read_table_writer.h"
 
 #include "pod5_format/errors.h"
+#include "pod5_format/internal/batch_checksum_output_stream.h"
 #include "pod5_format/internal/tracing/tracing.h"
 
+#include <arrow/array/util.h>
 #include <arrow/extension_type.h>
 #include <arrow/ipc/writer.h>
 #include <arrow/record_batch.h>
@@ -13,6 +15,7 @@ namespace pod5 {
 
 ReadTableWriter::ReadTableWriter(
     std::shared_ptr<arrow::ipc::RecordBatchWriter> && writer,
+    std::shared_ptr<BatchChecksumOutputStream> && checksum_stream,
     std::shared_ptr<arrow::Schema> && schema,
     std::shared_ptr<ReadTableSchemaDescription> const & field_locations,
     std::size_t table_batch_size,
@@ -24,13 +27,24 @@ ReadTableWriter::ReadTableWriter(
 : m_schema(schema)
 , m_field_locations(field_locations)
 , m_table_batch_size(table_batch_size)
+, m_writes_optional_fields(m_schema->GetFieldIndex(m_field_locations->signal_min.name()) != -1)
 , m_writer(std::move(writer))
+, m_checksum_stream(std::move(checksum_stream))
 , m_field_builders(m_field_locations, pool)
 , m_output_stream{output_stream}
 {
     m_field_builders.get_builder(m_field_locations->pore_type).set_dict_writer(pore_writer);
     m_field_builders.get_builder(m_field_locations->end_reason).set_dict_writer(end_reason_writer);
     m_field_builders.get_builder(m_field_locations->run_info).set_dict_writer(run_info_writer);
+
+    // Optional columns the schema leaves out aren't built:
+    auto const & fields = *m_field_locations;
+    auto const enabled = m_writes_optional_fields;
+    m_field_builders.get_builder(fields.signal_min).set_enabled(enabled);
+    m_field_builders.get_builder(fields.signal_max).set_enabled(enabled);
+    m_field_builders.get_builder(fields.signal_mean).set_enabled(enabled);
+    m_field_builders.get_builder(fields.signal_stdev).set_enabled(enabled);
+    m_field_builders.get_builder(fields.signal_saturated_count).set_enabled(enabled);
 }
 
 ReadTableWriter::ReadTableWriter(ReadTableWriter && other) = default;
@@ -46,13 +60,27 @@ ReadTableWriter::~ReadTableWriter()
 Result<std::size_t> ReadTableWriter::add_read(
     ReadData const & read_data,
     gsl::span<SignalTableRowIndex const> const & signal,
-    std::uint64_t signal_duration)
+    std::uint64_t signal_duration,
+    boost::optional<SignalStatistics> const & signal_statistics)
 {
     POD5_TRACE_FUNCTION();
     if (!m_writer) {
         return Status::IOError("Writer terminated");
     }
 
+    boost::optional<std::int16_t> signal_min;
+    boost::optional<std::int16_t> signal_max;
+    boost::optional<float> signal_mean;
+    boost::optional<float> signal_stdev;
+    boost::optional<std::uint64_t> signal_saturated_count;
+    if (signal_statistics) {
+        signal_min = signal_statistics->min;
+        signal_max = signal_statistics->max;
+        signal_mean = signal_statistics->mean;
+        signal_stdev = signal_statistics->stdev;
+        signal_saturated_count = signal_statistics->saturated_count;
+    }
+
     auto row_id = m_written_batched_row_count + m_current_batch_row_count;
     ARROW_RETURN_NOT_OK(m_field_builders.append(
         // V0 Fields
@@ -82,7 +110,14 @@ Result<std::size_t> ReadTableWriter::add_read(
         read_data.calibration_scale,
         read_data.end_reason,
         read_data.end_reason_forced,
-        read_data.run_info));
+        read_data.run_info,
+
+        // Optional Fields
+        signal_min,
+        signal_max,
+        signal_mean,
+        signal_stdev,
+        signal_saturated_count));
 
     ++m_current_batch_row_count;
 
@@ -92,6 +127,11 @@ Result<std::size_t> ReadTableWriter::add_read(
     return row_id;
 }
 
+std::vector<BatchChecksum> const & ReadTableWriter::batch_checksums() const
+{
+    return m_checksum_stream->checksums();
+}
+
 Status ReadTableWriter::close()
 {
     // Check for already closed
@@ -107,7 +147,39 @@ Status ReadTableWriter::close()
 
 Status ReadTableWriter::write_batch(arrow::RecordBatch const & record_batch)
 {
-    ARROW_RETURN_NOT_OK(m_writer->WriteRecordBatch(record_batch));
+    if (record_batch.schema()->Equals(*m_schema, false)) {
+        ARROW_RETURN_NOT_OK(m_checksum_stream->write_record_batch(*m_writer, record_batch));
+        m_written_batch_count += 1;
+        m_written_batched_row_count += record_batch.num_rows();
+        return m_output_stream->Flush();
+    }
+
+    // Batches recovered from a file written with other options may differ in which optional
+    // columns they carry, match them to this table by name:
+    std::vector<std::shared_ptr<arrow::Array>> columns;
+    for (auto const * field : m_field_locations->fields()) {
+        if (!m_field_locations->is_written_field(*field)
+            || (field->is_optional() && !m_writes_optional_fields))
+        {
+            continue;
+        }
+
+        auto column = record_batch.GetColumnByName(field->name());
+        if (!column) {
+            if (!field->is_optional()) {
+                return Status::Invalid("Batch is missing field '", field->name(), "'");
+            }
+            auto const & type = m_schema->field(columns.size())->type();
+            ARROW_ASSIGN_OR_RAISE(column, arrow::MakeArrayOfNull(type, record_batch.num_rows()));
+        }
+        columns.emplace_back(std::move(column));
+    }
+
+    auto const matched_batch =
+        arrow::RecordBatch::Make(m_schema, record_batch.num_rows(), std::move(columns));
+    ARROW_RETURN_NOT_OK(m_checksum_stream->write_record_batch(*m_writer, *matched_batch));
+    m_written_batch_count += 1;
+    m_written_batched_row_count += record_batch.num_rows();
     return m_output_stream->Flush();
 }
 
@@ -123,14 +195,14 @@ Status ReadTableWriter::write_batch()
     }
 
     ARROW_ASSIGN_OR_RAISE(auto columns, m_field_builders.finish_columns());
-
     auto const record_batch =
         arrow::RecordBatch::Make(m_schema, m_current_batch_row_count, std::move(columns));
 
+    m_written_batch_count += 1;
     m_written_batched_row_count += m_current_batch_row_count;
     m_current_batch_row_count = 0;
 
-    ARROW_RETURN_NOT_OK(m_writer->WriteRecordBatch(*record_batch));
+    ARROW_RETURN_NOT_OK(m_checksum_stream->write_record_batch(*m_writer, *record_batch));
     ARROW_RETURN_NOT_OK(m_output_stream->Flush());
 
     return reserve_rows();
@@ -145,10 +217,11 @@ Result<ReadTableWriter> make_read_table_writer(
     std::shared_ptr<PoreWriter> const & pore_writer,
     std::shared_ptr<EndReasonWriter> const & end_reason_writer,
     std::shared_ptr<RunInfoWriter> const & run_info_writer,
-    arrow::MemoryPool * pool)
+    arrow::MemoryPool * pool,
+    bool write_signal_statistics)
 {
     auto field_locations = std::make_shared<ReadTableSchemaDescription>();
-    auto schema = field_locations->make_writer_schema(metadata);
+    auto schema = field_locations->make_writer_schema(metadata, write_signal_statistics);
 
     arrow::ipc::IpcWriteOptions options;
     options.memory_pool = pool;
@@ -156,10 +229,14 @@ Result<ReadTableWriter> make_read_table_writer(
     // todo... consider:
     //ARROW_ASSIGN_OR_RAISE(options.codec, arrow::util::Codec::Create(arrow::Compression::LZ4_FRAME));
 
-    ARROW_ASSIGN_OR_RAISE(auto writer, arrow::ipc::MakeFileWriter(sink, schema, options, metadata));
+    std::shared_ptr<BatchChecksumOutputStream> checksum_stream;
+    ARROW_ASSIGN_OR_RAISE(
+        auto writer,
+        make_checksummed_file_writer(sink, schema, options, metadata, &checksum_stream));
 
     auto read_table_writer = ReadTableWriter(
         std::move(writer),
+        std::move(checksum_stream),
         std::move(schema),
         field_locations,
         table_batch_size,
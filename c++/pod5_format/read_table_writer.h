@@ -1,14 +1,17 @@
 #pragma once
 
+#include "pod5_format/batch_checksum.h"
 #include "pod5_format/pod5_format_export.h"
 #include "pod5_format/read_table_schema.h"
 #include "pod5_format/read_table_writer_utils.h"
 #include "pod5_format/result.h"
 #include "pod5_format/schema_field_builder.h"
+#include "pod5_format/signal_statistics.h"
 #include "pod5_format/signal_table_utils.h"
 
 #include <arrow/array/builder_dict.h>
 #include <arrow/io/type_fwd.h>
+#include <boost/optional/optional.hpp>
 #include <boost/variant/variant.hpp>
 
 namespace arrow {
@@ -25,10 +28,13 @@ class RecordBatchWriter;
 
 namespace pod5 {
 
+class BatchChecksumOutputStream;
+
 class POD5_FORMAT_EXPORT ReadTableWriter {
 public:
     ReadTableWriter(
         std::shared_ptr<arrow::ipc::RecordBatchWriter> && writer,
+        std::shared_ptr<BatchChecksumOutputStream> && checksum_stream,
         std::shared_ptr<arrow::Schema> && schema,
         std::shared_ptr<ReadTableSchemaDescription> const & field_locations,
         std::size_t table_batch_size,
@@ -47,21 +53,41 @@ public:
     /// \param read_data The data to add as a read.
     /// \param signal List of signal table row indices that belong to this read.
     /// \param signal_duration The length of the read in samples.
+    /// \param signal_statistics Statistics of the read's signal, written as null if not known.
     /// \returns The row index of the inserted read, or a status on failure.
     Result<std::size_t> add_read(
         ReadData const & read_data,
         gsl::span<SignalTableRowIndex const> const & signal,
-        std::uint64_t signal_duration);
+        std::uint64_t signal_duration,
+        boost::optional<SignalStatistics> const & signal_statistics = boost::none);
 
     /// \brief Close this writer, signaling no further data will be written to the writer.
     Status close();
 
+    /// \brief Find the checksum of each record batch written so far, stored by the file footer.
+    std::vector<BatchChecksum> const & batch_checksums() const;
+
     /// \brief Reserve space for future row writes, called automatically when a flush occurs.
     Status reserve_rows();
 
     /// \brief Find the schema for the table
     std::shared_ptr<arrow::Schema> const & schema() const { return m_schema; }
 
+    /// \brief Find the number of rows written in each batch of the table.
+    std::size_t table_batch_size() const { return m_table_batch_size; }
+
+    /// \brief Find the fields of the table.
+    std::shared_ptr<ReadTableSchemaDescription> const & field_locations() const
+    {
+        return m_field_locations;
+    }
+
+    /// \brief Find the number of record batches written to the table so far.
+    std::size_t written_batch_count() const { return m_written_batch_count; }
+
+    /// \brief Find if the optional signal statistics columns are written to the table.
+    bool writes_signal_statistics() const { return m_writes_optional_fields; }
+
     /// \brief Flush passed data into the writer as a record batch.
     Status write_batch(arrow::RecordBatch const &);
 
@@ -72,11 +98,14 @@ private:
     std::shared_ptr<arrow::Schema> m_schema;
     std::shared_ptr<ReadTableSchemaDescription> m_field_locations;
     std::size_t m_table_batch_size;
+    bool m_writes_optional_fields;
 
     std::shared_ptr<arrow::ipc::RecordBatchWriter> m_writer;
+    std::shared_ptr<BatchChecksumOutputStream> m_checksum_stream;
 
     ReadTableSchemaDescription::FieldBuilders m_field_builders;
 
+    std::size_t m_written_batch_count = 0;
     std::size_t m_written_batched_row_count = 0;
     std::size_t m_current_batch_row_count = 0;
     std::shared_ptr<arrow::io::OutputStream> m_output_stream;
@@ -87,6 +116,7 @@ private:
 /// \param metadata Metadata to be applied to the table schema.
 /// \param table_batch_size The size of each batch written for the table.
 /// \param pool Pool to be used for building table in memory.
+/// \param write_signal_statistics Whether the optional signal statistics columns are written.
 /// \returns The writer for the new table.
 POD5_FORMAT_EXPORT Result<ReadTableWriter> make_read_table_writer(
     std::shared_ptr<arrow::io::OutputStream> const & sink,
@@ -95,6 +125,7 @@ POD5_FORMAT_EXPORT Result<ReadTableWriter> make_read_table_writer(
     std::shared_ptr<PoreWriter> const & pore_writer,
     std::shared_ptr<EndReasonWriter> const & end_reason_writer,
     std::shared_ptr<RunInfoWriter> const & run_info_writer,
-    arrow::MemoryPool * pool);
+    arrow::MemoryPool * pool,
+    bool write_signal_statistics = false);
 
 }  // namespace pod5
@@ -1,5 +1,6 @@
 #include "pod5_format/run_info_table_reader.h"
 
+#include "pod5_format/internal/pinned_buffer_file.h"
 #include "pod5_format/schema_metadata.h"
 #include "pod5_format/schema_utils.h"
 
@@ -13,23 +14,49 @@
 
 namespace pod5 {
 
-inline std::vector<std::pair<std::string, std::string>> value_for_map(
+RunInfoMapView::RunInfoMapView(
     std::shared_ptr<arrow::MapArray> const & map_array,
     std::size_t row_index)
+: m_keys(std::static_pointer_cast<arrow::StringArray>(map_array->keys()))
+, m_items(std::static_pointer_cast<arrow::StringArray>(map_array->items()))
+, m_offset(map_array->value_offset(row_index))
+, m_length(map_array->value_length(row_index))
 {
-    std::size_t offset = map_array->value_offset(row_index);
-    std::size_t length = map_array->value_length(row_index);
+}
+
+arrow::util::string_view RunInfoMapView::key(std::size_t i) const
+{
+    return m_keys->GetView(m_offset + i);
+}
+
+arrow::util::string_view RunInfoMapView::value(std::size_t i) const
+{
+    return m_items->GetView(m_offset + i);
+}
 
-    auto const & keys = std::dynamic_pointer_cast<arrow::StringArray>(map_array->keys());
-    auto const & items = std::dynamic_pointer_cast<arrow::StringArray>(map_array->items());
+arrow::util::optional<arrow::util::string_view> RunInfoMapView::find(
+    arrow::util::string_view key_to_find) const
+{
+    for (std::size_t i = 0; i < m_length; ++i) {
+        if (key(i) == key_to_find) {
+            return value(i);
+        }
+    }
+    return arrow::util::nullopt;
+}
 
-    std::vector<std::pair<std::string, std::string>> result;
-    for (std::size_t i = offset; i < offset + length; ++i) {
-        result.push_back(std::make_pair(keys->Value(i).to_string(), items->Value(i).to_string()));
+RunInfoData::MapType RunInfoMapView::to_map() const
+{
+    RunInfoData::MapType result;
+    result.reserve(m_length);
+    for (std::size_t i = 0; i < m_length; ++i) {
+        result.emplace_back(key(i).to_string(), value(i).to_string());
     }
     return result;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+
 RunInfoTableRecordBatch::RunInfoTableRecordBatch(
     std::shared_ptr<arrow::RecordBatch> && batch,
     std::shared_ptr<RunInfoTableSchemaDescription const> const & field_locations)
@@ -85,15 +112,25 @@ Result<RunInfoTableRecordColumns> RunInfoTableRecordBatch::columns() const
     return result;
 }
 
+RunInfoMapView RunInfoTableRecordBatch::context_tags(std::size_t row) const
+{
+    return RunInfoMapView(find_column(batch(), m_field_locations->context_tags), row);
+}
+
+RunInfoMapView RunInfoTableRecordBatch::tracking_id(std::size_t row) const
+{
+    return RunInfoMapView(find_column(batch(), m_field_locations->tracking_id), row);
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 
 RunInfoTableReader::RunInfoTableReader(
-    std::shared_ptr<void> && input_source,
+    std::shared_ptr<arrow::io::RandomAccessFile> const & input_source,
     std::shared_ptr<arrow::ipc::RecordBatchFileReader> && reader,
     std::shared_ptr<RunInfoTableSchemaDescription const> const & field_locations,
     SchemaMetadataDescription && schema_metadata,
     arrow::MemoryPool * pool)
-: TableReader(std::move(input_source), std::move(reader), std::move(schema_metadata), pool)
+: TableReader(input_source, std::move(reader), std::move(schema_metadata), pool)
 , m_field_locations(field_locations)
 {
 }
@@ -114,7 +151,7 @@ RunInfoTableReader & RunInfoTableReader::operator=(RunInfoTableReader && other)
 Result<RunInfoTableRecordBatch> RunInfoTableReader::read_record_batch(std::size_t i) const
 {
     std::lock_guard<std::mutex> l(m_batch_get_mutex);
-    ARROW_ASSIGN_OR_RAISE(auto record_batch, reader()->ReadRecordBatch(i));
+    ARROW_ASSIGN_OR_RAISE(auto record_batch, read_checked_record_batch(i));
     return RunInfoTableRecordBatch{std::move(record_batch), m_field_locations};
 }
 
@@ -122,79 +159,79 @@ Result<std::shared_ptr<RunInfoData const>> RunInfoTableReader::find_run_info(
     std::string const & acquisition_id) const
 {
     std::lock_guard<std::mutex> l(m_run_info_lookup_mutex);
-    auto it = m_run_info_lookup.find(acquisition_id);
-    if (it != m_run_info_lookup.end()) {
-        return it->second;
-    }
-
-    ARROW_RETURN_NOT_OK(prepare_run_infos_vector());
-
-    std::shared_ptr<const RunInfoData> run_info = nullptr;
-    std::size_t glb_run_info_index = 0;
-    for (std::size_t i = 0; i < num_record_batches(); ++i) {
-        ARROW_ASSIGN_OR_RAISE(auto batch, read_record_batch(i));
-        auto acq_id = find_column(batch.batch(), m_field_locations->acquisition_id);
-
-        for (std::size_t j = 0; j < batch.num_rows(); ++j) {
-            if (acq_id->Value(j) == acquisition_id) {
-                ARROW_ASSIGN_OR_RAISE(
-                    run_info, load_run_info_from_batch(batch, j, glb_run_info_index++));
-                break;
-            }
-        }
+    ARROW_RETURN_NOT_OK(build_run_info_index());
 
-        if (run_info) {
-            break;
-        }
-    }
-
-    if (!run_info) {
+    auto it = m_run_info_index.find(acquisition_id);
+    if (it == m_run_info_index.end()) {
         return arrow::Status::Invalid(
             "Failed to find acquisition id '", acquisition_id, "' in run info table");
     }
 
-    return run_info;
+    return get_run_info_locked(it->second);
 }
 
-Result<std::shared_ptr<RunInfoData const>> RunInfoTableReader::get_run_info(std::size_t index) const
+Result<std::size_t> RunInfoTableReader::find_run_info_index(
+    std::string const & acquisition_id) const
 {
-    ARROW_RETURN_NOT_OK(prepare_run_infos_vector());
-
-    if (index < 0 || index >= m_run_infos.size()) {
-        return arrow::Status::IndexError(
-            "Invalid index into run infos (expected ", index, " < ", m_run_infos.size(), ")");
-    }
+    std::lock_guard<std::mutex> l(m_run_info_lookup_mutex);
+    ARROW_RETURN_NOT_OK(build_run_info_index());
 
-    if (m_run_infos[index]) {
-        return m_run_infos[index];
+    auto it = m_run_info_index.find(acquisition_id);
+    if (it == m_run_info_index.end()) {
+        return arrow::Status::Invalid(
+            "Failed to find acquisition id '", acquisition_id, "' in run info table");
     }
+    return it->second;
+}
 
-    ARROW_ASSIGN_OR_RAISE(auto first_batch, read_record_batch(0));
-    auto const batch_size = first_batch.num_rows();
-
-    auto const batch_idx = index / batch_size;
-    auto const batch_row = index - (batch_idx * batch_size);
+Result<std::shared_ptr<RunInfoData const>> RunInfoTableReader::get_run_info(std::size_t index) const
+{
+    std::lock_guard<std::mutex> l(m_run_info_lookup_mutex);
+    ARROW_RETURN_NOT_OK(build_run_info_index());
+    return get_run_info_locked(index);
+}
 
-    if (batch_idx >= num_record_batches()) {
-        return Status::Invalid("Row outside batch bounds");
-    }
+Result<std::size_t> RunInfoTableReader::get_run_info_count() const
+{
+    std::lock_guard<std::mutex> l(m_run_info_lookup_mutex);
+    ARROW_RETURN_NOT_OK(build_run_info_index());
+    return m_run_infos.size();
+}
 
-    ARROW_ASSIGN_OR_RAISE(auto batch, read_record_batch(batch_idx));
+Result<RunInfoMapView> RunInfoTableReader::get_context_tags(std::size_t index) const
+{
+    ARROW_ASSIGN_OR_RAISE(auto location, [&]() -> Result<RowLocation> {
+        std::lock_guard<std::mutex> l(m_run_info_lookup_mutex);
+        ARROW_RETURN_NOT_OK(build_run_info_index());
+        return locate_row(index);
+    }());
+
+    ARROW_ASSIGN_OR_RAISE(auto batch, read_record_batch(location.batch));
+    return batch.context_tags(location.batch_row);
+}
 
-    return load_run_info_from_batch(batch, batch_row, index);
+Result<RunInfoMapView> RunInfoTableReader::get_tracking_id(std::size_t index) const
+{
+    ARROW_ASSIGN_OR_RAISE(auto location, [&]() -> Result<RowLocation> {
+        std::lock_guard<std::mutex> l(m_run_info_lookup_mutex);
+        ARROW_RETURN_NOT_OK(build_run_info_index());
+        return locate_row(index);
+    }());
+
+    ARROW_ASSIGN_OR_RAISE(auto batch, read_record_batch(location.batch));
+    return batch.tracking_id(location.batch_row);
 }
 
-Result<std::size_t> RunInfoTableReader::get_run_info_count() const
+Result<std::shared_ptr<RunInfoData const>> RunInfoTableReader::get_run_info_locked(
+    std::size_t index) const
 {
-    auto batch_count = num_record_batches();
-    if (batch_count == 0) {
-        return 0;
+    ARROW_ASSIGN_OR_RAISE(auto location, locate_row(index));
+    if (m_run_infos[index]) {
+        return m_run_infos[index];
     }
 
-    ARROW_ASSIGN_OR_RAISE(auto first_batch, read_record_batch(0));
-    ARROW_ASSIGN_OR_RAISE(auto last_batch, read_record_batch(batch_count - 1));
-
-    return (batch_count - 1) * first_batch.num_rows() + last_batch.num_rows();
+    ARROW_ASSIGN_OR_RAISE(auto batch, read_record_batch(location.batch));
+    return load_run_info_from_batch(batch, location.batch_row, index);
 }
 
 Result<std::shared_ptr<RunInfoData const>> RunInfoTableReader::load_run_info_from_batch(
@@ -210,7 +247,7 @@ Result<std::shared_ptr<RunInfoData const>> RunInfoTableReader::load_run_info_fro
         columns.acquisition_start_time->Value(batch_index),
         columns.adc_max->Value(batch_index),
         columns.adc_min->Value(batch_index),
-        value_for_map(columns.context_tags, batch_index),
+        RunInfoMapView(columns.context_tags, batch_index).to_map(),
         columns.experiment_name->Value(batch_index).to_string(),
         columns.flow_cell_id->Value(batch_index).to_string(),
         columns.flow_cell_product_code->Value(batch_index).to_string(),
@@ -225,24 +262,59 @@ Result<std::shared_ptr<RunInfoData const>> RunInfoTableReader::load_run_info_fro
         columns.software->Value(batch_index).to_string(),
         columns.system_name->Value(batch_index).to_string(),
         columns.system_type->Value(batch_index).to_string(),
-        value_for_map(columns.tracking_id, batch_index));
+        RunInfoMapView(columns.tracking_id, batch_index).to_map());
 
     // Cache run info for later retrieval by index:
     m_run_infos[global_index] = run_info;
-    m_run_info_lookup[acquisition_id] = run_info;
     return run_info;
 }
 
-arrow::Status RunInfoTableReader::prepare_run_infos_vector() const
+arrow::Status RunInfoTableReader::build_run_info_index() const
 {
-    if (m_run_infos.empty()) {
-        ARROW_ASSIGN_OR_RAISE(auto row_count, get_run_info_count())
-        m_run_infos.resize(row_count);
+    if (m_run_info_index_built) {
+        return Status::OK();
     }
 
+    std::unordered_map<std::string, std::size_t> run_info_index;
+    std::vector<std::size_t> batch_row_offsets;
+    batch_row_offsets.reserve(num_record_batches() + 1);
+
+    // Only the acquisition id column is touched here, the remaining fields are
+    // parsed on demand when a specific run info is requested.
+    std::size_t global_index = 0;
+    for (std::size_t i = 0; i < num_record_batches(); ++i) {
+        ARROW_ASSIGN_OR_RAISE(auto batch, read_record_batch(i));
+        auto acq_id = find_column(batch.batch(), m_field_locations->acquisition_id);
+
+        batch_row_offsets.push_back(global_index);
+        for (std::int64_t j = 0; j < acq_id->length(); ++j) {
+            // Keep the first occurrence, matching the previous linear search behaviour.
+            run_info_index.emplace(acq_id->GetString(j), global_index + j);
+        }
+        global_index += acq_id->length();
+    }
+    batch_row_offsets.push_back(global_index);
+
+    m_run_info_index = std::move(run_info_index);
+    m_batch_row_offsets = std::move(batch_row_offsets);
+    m_run_infos.resize(global_index);
+    m_run_info_index_built = true;
     return Status::OK();
 }
 
+Result<RunInfoTableReader::RowLocation> RunInfoTableReader::locate_row(std::size_t index) const
+{
+    if (index >= m_run_infos.size()) {
+        return arrow::Status::IndexError(
+            "Invalid index into run infos (expected ", index, " < ", m_run_infos.size(), ")");
+    }
+
+    // m_batch_row_offsets holds the first global row of each batch, followed by the total row count.
+    auto it = std::upper_bound(m_batch_row_offsets.begin(), m_batch_row_offsets.end(), index);
+    auto const batch = std::distance(m_batch_row_offsets.begin(), it) - 1;
+    return RowLocation{std::size_t(batch), index - m_batch_row_offsets[batch]};
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 
 Result<RunInfoTableReader> make_run_info_table_reader(
@@ -252,7 +324,10 @@ Result<RunInfoTableReader> make_run_info_table_reader(
     arrow::ipc::IpcReadOptions options;
     options.memory_pool = pool;
 
-    ARROW_ASSIGN_OR_RAISE(auto reader, arrow::ipc::RecordBatchFileReader::Open(input, options));
+    // Read through a file which can serve batches from the bytes read to verify them:
+    auto const table_input = std::make_shared<PinnedBufferFile>(input);
+    ARROW_ASSIGN_OR_RAISE(
+        auto reader, arrow::ipc::RecordBatchFileReader::Open(table_input, options));
 
     auto read_metadata_key_values = reader->schema()->metadata();
     if (!read_metadata_key_values) {
@@ -264,7 +339,7 @@ Result<RunInfoTableReader> make_run_info_table_reader(
         auto field_locations, read_run_info_table_schema(read_metadata, reader->schema()));
 
     return RunInfoTableReader(
-        {input}, std::move(reader), field_locations, std::move(read_metadata), pool);
+        table_input, std::move(reader), field_locations, std::move(read_metadata), pool);
 }
 
 }  // namespace pod5
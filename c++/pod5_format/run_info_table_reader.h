@@ -9,6 +9,8 @@
 #include "pod5_format/types.h"
 
 #include <arrow/io/type_fwd.h>
+#include <arrow/util/optional.h>
+#include <arrow/util/string_view.h>
 #include <boost/uuid/uuid.hpp>
 #include <gsl/gsl-lite.hpp>
 
@@ -55,6 +57,33 @@ struct RunInfoTableRecordColumns {
     TableSpecVersion table_version;
 };
 
+/// Zero-copy view of a single row of a run info map column (context_tags or tracking_id).
+/// \note The view keeps the underlying arrow arrays alive, but string views returned from it
+///       are only valid while the view (or a copy of it) exists.
+class POD5_FORMAT_EXPORT RunInfoMapView {
+public:
+    RunInfoMapView() = default;
+    RunInfoMapView(std::shared_ptr<arrow::MapArray> const & map_array, std::size_t row_index);
+
+    std::size_t size() const { return m_length; }
+    bool empty() const { return m_length == 0; }
+
+    arrow::util::string_view key(std::size_t i) const;
+    arrow::util::string_view value(std::size_t i) const;
+
+    /// Find the value stored against [key], returns an empty optional if the key is not present.
+    arrow::util::optional<arrow::util::string_view> find(arrow::util::string_view key) const;
+
+    /// Copy the contents of the view into an owning map.
+    RunInfoData::MapType to_map() const;
+
+private:
+    std::shared_ptr<arrow::StringArray> m_keys;
+    std::shared_ptr<arrow::StringArray> m_items;
+    std::size_t m_offset = 0;
+    std::size_t m_length = 0;
+};
+
 class POD5_FORMAT_EXPORT RunInfoTableRecordBatch : public TableRecordBatch {
 public:
     RunInfoTableRecordBatch(
@@ -65,6 +94,9 @@ public:
 
     Result<RunInfoTableRecordColumns> columns() const;
 
+    RunInfoMapView context_tags(std::size_t row) const;
+    RunInfoMapView tracking_id(std::size_t row) const;
+
 private:
     std::shared_ptr<RunInfoTableSchemaDescription const> m_field_locations;
 };
@@ -72,7 +104,7 @@ private:
 class POD5_FORMAT_EXPORT RunInfoTableReader : public TableReader {
 public:
     RunInfoTableReader(
-        std::shared_ptr<void> && input_source,
+        std::shared_ptr<arrow::io::RandomAccessFile> const & input_source,
         std::shared_ptr<arrow::ipc::RecordBatchFileReader> && reader,
         std::shared_ptr<RunInfoTableSchemaDescription const> const & field_locations,
         SchemaMetadataDescription && schema_metadata,
@@ -85,20 +117,41 @@ public:
 
     Result<std::shared_ptr<RunInfoData const>> find_run_info(
         std::string const & acquisition_id) const;
+    /// Find the global row index of [acquisition_id] in the run info table.
+    Result<std::size_t> find_run_info_index(std::string const & acquisition_id) const;
 
     Result<std::shared_ptr<RunInfoData const>> get_run_info(std::size_t index) const;
     Result<std::size_t> get_run_info_count() const;
 
+    /// Access the map fields of a run info row without copying them out of the table.
+    Result<RunInfoMapView> get_context_tags(std::size_t index) const;
+    Result<RunInfoMapView> get_tracking_id(std::size_t index) const;
+
 private:
+    struct RowLocation {
+        std::size_t batch;
+        std::size_t batch_row;
+    };
+
+    Result<std::shared_ptr<RunInfoData const>> get_run_info_locked(std::size_t index) const;
     Result<std::shared_ptr<RunInfoData const>> load_run_info_from_batch(
         RunInfoTableRecordBatch const & batch,
         std::size_t batch_index,
         std::size_t global_index) const;
-    arrow::Status prepare_run_infos_vector() const;
+
+    /// Index all acquisition ids in the table, called with m_run_info_lookup_mutex held.
+    arrow::Status build_run_info_index() const;
+    Result<RowLocation> locate_row(std::size_t index) const;
 
     std::shared_ptr<RunInfoTableSchemaDescription const> m_field_locations;
     mutable std::mutex m_batch_get_mutex;
-    mutable std::unordered_map<std::string, std::shared_ptr<RunInfoData const>> m_run_info_lookup;
+
+    // Populated once by build_run_info_index():
+    mutable bool m_run_info_index_built = false;
+    mutable std::unordered_map<std::string, std::size_t> m_run_info_index;
+    mutable std::vector<std::size_t> m_batch_row_offsets;
+
+    // Parsed run infos, loaded lazily by global index:
     mutable std::vector<std::shared_ptr<RunInfoData const>> m_run_infos;
     mutable std::mutex m_run_info_lookup_mutex;
 };
@@ -1,6 +1,7 @@
 #include "pod5_format/run_info_table_writer.h"
 
 #include "pod5_format/errors.h"
+#include "pod5_format/internal/batch_checksum_output_stream.h"
 #include "pod5_format/internal/tracing/tracing.h"
 #include "pod5_format/read_table_utils.h"
 
@@ -14,6 +15,7 @@ namespace pod5 {
 
 RunInfoTableWriter::RunInfoTableWriter(
     std::shared_ptr<arrow::ipc::RecordBatchWriter> && writer,
+    std::shared_ptr<BatchChecksumOutputStream> && checksum_stream,
     std::shared_ptr<arrow::Schema> && schema,
     std::shared_ptr<RunInfoTableSchemaDescription> const & field_locations,
     std::shared_ptr<arrow::io::OutputStream> const & output_stream,
@@ -24,6 +26,7 @@ RunInfoTableWriter::RunInfoTableWriter(
 , m_output_stream{output_stream}
 , m_table_batch_size(table_batch_size)
 , m_writer(std::move(writer))
+, m_checksum_stream(std::move(checksum_stream))
 , m_field_builders(m_field_locations, pool)
 {
 }
@@ -77,6 +80,11 @@ Result<std::size_t> RunInfoTableWriter::add_run_info(RunInfoData const & run_inf
     return row_id;
 }
 
+std::vector<BatchChecksum> const & RunInfoTableWriter::batch_checksums() const
+{
+    return m_checksum_stream->checksums();
+}
+
 Status RunInfoTableWriter::close()
 {
     // Check for already closed
@@ -92,7 +100,7 @@ Status RunInfoTableWriter::close()
 
 Status RunInfoTableWriter::write_batch(arrow::RecordBatch const & record_batch)
 {
-    ARROW_RETURN_NOT_OK(m_writer->WriteRecordBatch(record_batch));
+    ARROW_RETURN_NOT_OK(m_checksum_stream->write_record_batch(*m_writer, record_batch));
     return m_output_stream->Flush();
 }
 
@@ -115,7 +123,7 @@ Status RunInfoTableWriter::write_batch()
     m_written_batched_row_count += m_current_batch_row_count;
     m_current_batch_row_count = 0;
 
-    ARROW_RETURN_NOT_OK(m_writer->WriteRecordBatch(*record_batch));
+    ARROW_RETURN_NOT_OK(m_checksum_stream->write_record_batch(*m_writer, *record_batch));
     ARROW_RETURN_NOT_OK(m_output_stream->Flush());
 
     return reserve_rows();
@@ -135,10 +143,19 @@ Result<RunInfoTableWriter> make_run_info_table_writer(
     arrow::ipc::IpcWriteOptions options;
     options.memory_pool = pool;
 
-    ARROW_ASSIGN_OR_RAISE(auto writer, arrow::ipc::MakeFileWriter(sink, schema, options, metadata));
+    std::shared_ptr<BatchChecksumOutputStream> checksum_stream;
+    ARROW_ASSIGN_OR_RAISE(
+        auto writer,
+        make_checksummed_file_writer(sink, schema, options, metadata, &checksum_stream));
 
     auto run_info_table_writer = RunInfoTableWriter(
-        std::move(writer), std::move(schema), field_locations, sink, table_batch_size, pool);
+        std::move(writer),
+        std::move(checksum_stream),
+        std::move(schema),
+        field_locations,
+        sink,
+        table_batch_size,
+        pool);
 
     ARROW_RETURN_NOT_OK(run_info_table_writer.reserve_rows());
 
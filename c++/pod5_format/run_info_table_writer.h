@@ -1,5 +1,6 @@
 #pragma once
 
+#include "pod5_format/batch_checksum.h"
 #include "pod5_format/pod5_format_export.h"
 #include "pod5_format/result.h"
 #include "pod5_format/run_info_table_schema.h"
@@ -23,12 +24,14 @@ class RecordBatchWriter;
 
 namespace pod5 {
 
+class BatchChecksumOutputStream;
 class RunInfoData;
 
 class POD5_FORMAT_EXPORT RunInfoTableWriter {
 public:
     RunInfoTableWriter(
         std::shared_ptr<arrow::ipc::RecordBatchWriter> && writer,
+        std::shared_ptr<BatchChecksumOutputStream> && checksum_stream,
         std::shared_ptr<arrow::Schema> && schema,
         std::shared_ptr<RunInfoTableSchemaDescription> const & field_locations,
         std::shared_ptr<arrow::io::OutputStream> const & output_stream,
@@ -48,6 +51,9 @@ public:
     /// \brief Close this writer, signaling no further data will be written to the writer.
     Status close();
 
+    /// \brief Find the checksum of each record batch written so far, stored by the file footer.
+    std::vector<BatchChecksum> const & batch_checksums() const;
+
     /// \brief Reserve space for future row writes, called automatically when a flush occurs.
     Status reserve_rows();
 
@@ -67,6 +73,7 @@ private:
     std::size_t m_table_batch_size;
 
     std::shared_ptr<arrow::ipc::RecordBatchWriter> m_writer;
+    std::shared_ptr<BatchChecksumOutputStream> m_checksum_stream;
 
     RunInfoTableSchemaDescription::FieldBuilders m_field_builders;
 
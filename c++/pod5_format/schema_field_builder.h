@@ -6,6 +6,9 @@
 #include <arrow/array/builder_binary.h>
 #include <arrow/array/builder_nested.h>
 #include <arrow/array/builder_primitive.h>
+#include <boost/optional/optional.hpp>
+
+#include <algorithm>
 
 namespace pod5 {
 
@@ -179,6 +182,49 @@ private:
     std::shared_ptr<DictionaryWriter> m_dict_writer;
 };
 
+template <typename ArrayType>
+class OptionalBuilderHelper : public BuilderHelper<ArrayType> {
+public:
+    using BuilderHelper<ArrayType>::BuilderHelper;
+    using BuilderHelper<ArrayType>::Append;
+
+    /// Disabled builders ignore their values and finish no column, for optional fields left out
+    /// of the schema being written.
+    void set_enabled(bool enabled) { m_enabled = enabled; }
+
+    arrow::Status Reserve(std::size_t rows)
+    {
+        if (!m_enabled) {
+            return arrow::Status::OK();
+        }
+        return BuilderHelper<ArrayType>::Reserve(rows);
+    }
+
+    template <typename T>
+    arrow::Status Append(boost::optional<T> const & value)
+    {
+        if (!m_enabled) {
+            return arrow::Status::OK();
+        }
+        if (!value) {
+            return this->AppendNull();
+        }
+        return BuilderHelper<ArrayType>::Append(*value);
+    }
+
+    arrow::Status Finish(std::shared_ptr<arrow::Array> * dest)
+    {
+        if (!m_enabled) {
+            *dest = nullptr;
+            return arrow::Status::OK();
+        }
+        return BuilderHelper<ArrayType>::Finish(dest);
+    }
+
+private:
+    bool m_enabled = true;
+};
+
 template <typename ElementArrayType>
 class ListBuilderHelper<arrow::ListArray, ElementArrayType> {
 public:
@@ -238,7 +284,6 @@ public:
         detail::for_each_in_tuple(m_builders, [&](auto & element, std::size_t index) {
             if (result.ok()) {
                 result = element.Finish(&columns[index]);
-                assert(columns[index] || !result.ok());
             }
         });
 
@@ -246,6 +291,8 @@ public:
             return result;
         }
 
+        // Disabled optional builders finish no column:
+        columns.erase(std::remove(columns.begin(), columns.end(), nullptr), columns.end());
         return columns;
     }
 
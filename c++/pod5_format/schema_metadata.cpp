@@ -102,4 +102,35 @@ Result<SchemaMetadataDescription> read_schema_key_value_metadata(
     return SchemaMetadataDescription{file_identifier, software_str, pod5_version};
 }
 
+Result<std::shared_ptr<const arrow::KeyValueMetadata>> make_index_key_value_metadata(
+    std::shared_ptr<const arrow::KeyValueMetadata> const & key_value_metadata,
+    std::string const & index_type)
+{
+    if (!key_value_metadata) {
+        return Status::Invalid("Expected file metadata to be specified for index metadata");
+    }
+
+    if (index_type.empty()) {
+        return Status::Invalid("Expected index_type to be specified for index metadata");
+    }
+
+    auto result = key_value_metadata->Copy();
+    result->Append("MINKNOW:index_type", index_type);
+    return result;
+}
+
+std::string read_index_type(
+    std::shared_ptr<const arrow::KeyValueMetadata> const & key_value_metadata)
+{
+    if (!key_value_metadata) {
+        return {};
+    }
+
+    auto index_type = key_value_metadata->Get("MINKNOW:index_type");
+    if (!index_type.ok()) {
+        return {};
+    }
+    return *index_type;
+}
+
 }  // namespace pod5
@@ -67,4 +67,17 @@ make_schema_key_value_metadata(SchemaMetadataDescription const & schema_metadata
 POD5_FORMAT_EXPORT Result<SchemaMetadataDescription> read_schema_key_value_metadata(
     std::shared_ptr<const arrow::KeyValueMetadata> const & key_value_metadata);
 
+/// \brief Add the index type to the metadata of a table embedded as an OtherIndex.
+/// \param key_value_metadata  Metadata of the file, as made by make_schema_key_value_metadata.
+/// \param index_type          Identifier for the contents of the index.
+POD5_FORMAT_EXPORT Result<std::shared_ptr<const arrow::KeyValueMetadata>>
+make_index_key_value_metadata(
+    std::shared_ptr<const arrow::KeyValueMetadata> const & key_value_metadata,
+    std::string const & index_type);
+
+/// \brief Find the index type of a table embedded as an OtherIndex.
+/// \returns The index type, or an empty string if the table does not record one.
+POD5_FORMAT_EXPORT std::string read_index_type(
+    std::shared_ptr<const arrow::KeyValueMetadata> const & key_value_metadata);
+
 }  // namespace pod5
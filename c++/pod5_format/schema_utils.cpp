@@ -6,18 +6,23 @@ namespace pod5 {
 /// \param metadata Metadata to be applied to the schema.
 /// \returns The schema for a read table.
 std::shared_ptr<arrow::Schema> SchemaDescriptionBase::make_writer_schema(
-    std::shared_ptr<const arrow::KeyValueMetadata> const & metadata) const
+    std::shared_ptr<const arrow::KeyValueMetadata> const & metadata,
+    bool include_optional_fields) const
 {
-    auto const latest_version = latest_table_version();
     arrow::FieldVector writer_fields;
     for (auto & field : fields()) {
-        if (field->removed_table_spec_version() > latest_version) {
+        if (is_written_field(*field) && (include_optional_fields || !field->is_optional())) {
             writer_fields.emplace_back(arrow::field(field->name(), field->datatype()));
         }
     }
     return arrow::schema(writer_fields, metadata);
 }
 
+bool SchemaDescriptionBase::is_written_field(FieldBase const & field) const
+{
+    return field.removed_table_spec_version() > latest_table_version();
+}
+
 Status SchemaDescriptionBase::read_schema(
     std::shared_ptr<SchemaDescriptionBase> dest_schema,
     SchemaMetadataDescription const & schema_metadata,
@@ -33,6 +38,10 @@ Status SchemaDescriptionBase::read_schema(
             continue;
         }
 
+        if (field->is_optional() && schema->GetFieldIndex(field->name()) == -1) {
+            continue;
+        }
+
         auto const & datatype = field->datatype();
         int field_index = 0;
         if (datatype->id() == arrow::Type::DICTIONARY) {
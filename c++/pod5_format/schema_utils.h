@@ -134,9 +134,15 @@ public:
 
     /// \brief Make a new schema for a read table to be written (will only contain fields which are written in the latest version).
     /// \param metadata Metadata to be applied to the schema.
+    /// \param include_optional_fields Whether optional fields are included in the schema, off by
+    ///        default as for the writer options enabling them.
     /// \returns The schema for a read table.
     std::shared_ptr<arrow::Schema> make_writer_schema(
-        std::shared_ptr<const arrow::KeyValueMetadata> const & metadata) const;
+        std::shared_ptr<const arrow::KeyValueMetadata> const & metadata,
+        bool include_optional_fields = false) const;
+
+    /// \brief Find if [field] is written in the latest version of the table.
+    bool is_written_field(FieldBase const & field) const;
 
     static Status read_schema(
         std::shared_ptr<SchemaDescriptionBase> dest_schema,
@@ -151,6 +157,8 @@ private:
 namespace detail {
 template <typename ArrayType>
 class BuilderHelper;
+template <typename ArrayType>
+class OptionalBuilderHelper;
 template <typename ArrayType, typename ElementArrayType>
 class ListBuilderHelper;
 }  // namespace detail
@@ -187,12 +195,20 @@ public:
 
     bool found_field() const { return m_field_index != (int)SpecialFieldValues::InvalidField; }
 
+    /// Optional fields may be missing from files of the same table version, and are only written
+    /// when the writer asks for them.
+    bool is_optional() const { return m_optional; }
+
+protected:
+    void set_optional(bool optional) { m_optional = optional; }
+
 private:
     std::string m_name;
     std::shared_ptr<arrow::DataType> m_datatype;
     int m_field_index = (int)SpecialFieldValues::InvalidField;
     TableSpecVersion m_added_table_spec_version;
     TableSpecVersion m_removed_table_spec_version;
+    bool m_optional = false;
 };
 
 template <int WriteIndex_, typename ArrayType_>
@@ -218,6 +234,28 @@ struct Field : public FieldBase {
     }
 };
 
+/// A field which may be missing when reading a table, and which may contain null values.
+template <int WriteIndex_, typename ArrayType_>
+struct OptionalField : public Field<WriteIndex_, ArrayType_> {
+    using BuilderType = detail::OptionalBuilderHelper<ArrayType_>;
+
+    OptionalField(
+        SchemaDescriptionBase * owner,
+        std::string name,
+        std::shared_ptr<arrow::DataType> const & datatype,
+        TableSpecVersion added_table_spec_version = TableSpecVersion::first_version(),
+        TableSpecVersion removed_table_spec_version = TableSpecVersion::unknown_version())
+    : Field<WriteIndex_, ArrayType_>(
+        owner,
+        name,
+        datatype,
+        added_table_spec_version,
+        removed_table_spec_version)
+    {
+        this->set_optional(true);
+    }
+};
+
 template <int WriteIndex_, typename ArrayType_, typename ElementType_>
 struct ListField : public Field<WriteIndex_, ArrayType_> {
     using ElementType = ElementType_;
@@ -0,0 +1,514 @@
+#include "pod5_format/shared_signal_cache.h"
+
+#include <boost/optional.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <thread>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#endif
+
+namespace pod5 {
+
+namespace {
+
+constexpr std::uint64_t LayoutMagic = 0x50444f3553534331ULL;  // "POD5SSC1"
+constexpr std::uint64_t LayoutVersion = 2;
+
+// Slots are sized for reads of around this many bytes of samples, with room to spare:
+constexpr std::size_t BytesPerSlot = 8 * 1024;
+constexpr std::size_t MinSlotCount = 1024;
+// The number of consecutive slots a read can be placed in:
+constexpr std::size_t ProbeCount = 8;
+// Reads larger than this fraction of the ring aren't cached, so one read can't flush the rest:
+constexpr std::size_t MaxReadFraction = 4;
+// Time to wait for another process to finish creating a cache:
+constexpr auto CreationTimeout = std::chrono::seconds(2);
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "Shared signal caches need address free atomics");
+
+struct Slot {
+    // Odd while the slot is written:
+    std::atomic<std::uint64_t> version;
+    std::atomic<std::uint64_t> file_identifier_high;
+    std::atomic<std::uint64_t> file_identifier_low;
+    std::atomic<std::uint64_t> first_signal_row;
+    // Row count in the high 32 bits, sample count in the low, a sample count of 0 is empty:
+    std::atomic<std::uint64_t> counts;
+    // Position of the read's signal rows in the ring, followed by its samples, counted in bytes
+    // since the cache was created:
+    std::atomic<std::uint64_t> position;
+    std::atomic<std::uint64_t> hits;
+    // Id of the process writing the slot, 0 when no process is:
+    std::atomic<std::uint64_t> writer;
+};
+
+static_assert(sizeof(Slot) == 64, "Slots should fill a cache line");
+
+struct Key {
+    std::uint64_t file_identifier_high;
+    std::uint64_t file_identifier_low;
+    gsl::span<std::uint64_t const> signal_rows;
+};
+
+Key make_key(
+    boost::uuids::uuid const & file_identifier,
+    gsl::span<std::uint64_t const> const & signal_rows)
+{
+    Key key;
+    std::memcpy(&key.file_identifier_high, file_identifier.data, sizeof(std::uint64_t));
+    std::memcpy(&key.file_identifier_low, file_identifier.data + 8, sizeof(std::uint64_t));
+    key.signal_rows = signal_rows;
+    return key;
+}
+
+std::uint64_t mix(std::uint64_t value)
+{
+    // splitmix64 finaliser:
+    value ^= value >> 30;
+    value *= 0xbf58476d1ce4e5b9ULL;
+    value ^= value >> 27;
+    value *= 0x94d049bb133111ebULL;
+    value ^= value >> 31;
+    return value;
+}
+
+std::uint64_t hash(Key const & key)
+{
+    auto result = mix(key.file_identifier_high ^ mix(key.file_identifier_low))
+                  ^ key.signal_rows.size();
+    for (auto const row : key.signal_rows) {
+        result = mix(result ^ row);
+    }
+    return result;
+}
+
+/// Find if [slot] may hold [key], the full signal rows are only known by reading the ring.
+bool slot_has_key(Slot const & slot, Key const & key)
+{
+    return slot.file_identifier_high.load(std::memory_order_relaxed) == key.file_identifier_high
+           && slot.file_identifier_low.load(std::memory_order_relaxed) == key.file_identifier_low
+           && slot.first_signal_row.load(std::memory_order_relaxed) == key.signal_rows[0]
+           && (slot.counts.load(std::memory_order_relaxed) >> 32) == key.signal_rows.size();
+}
+
+std::uint64_t sample_count(std::uint64_t counts) { return counts & 0xffffffff; }
+
+std::uint64_t signal_rows_bytes(Key const & key)
+{
+    return key.signal_rows.size() * sizeof(std::uint64_t);
+}
+
+std::uint64_t current_process_id()
+{
+#ifdef __linux__
+    return std::uint64_t(getpid());
+#else
+    return 1;
+#endif
+}
+
+/// Find if the process [process_id] has exited.
+bool process_exited(std::uint64_t process_id)
+{
+#ifdef __linux__
+    return kill(pid_t(process_id), 0) != 0 && errno == ESRCH;
+#else
+    (void)process_id;
+    return false;
+#endif
+}
+
+/// Take [slot] for writing by this process, returning the odd version it is written under.
+/// \details A slot held by a process which has exited is taken over, as that process died while
+///          writing it.
+boost::optional<std::uint64_t> lock_slot(Slot & slot)
+{
+    auto const self = current_process_id();
+    std::uint64_t writer = 0;
+    if (!slot.writer.compare_exchange_strong(writer, self, std::memory_order_acquire)) {
+        if (writer == self || !process_exited(writer)
+            || !slot.writer.compare_exchange_strong(writer, self, std::memory_order_acquire))
+        {
+            return boost::none;
+        }
+    }
+
+    // Readers skip the slot while its version is odd, a dead writer may have left it odd already:
+    auto const version = slot.version.load(std::memory_order_relaxed) | 1;
+    slot.version.store(version, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    return version;
+}
+
+void unlock_slot(Slot & slot, std::uint64_t version)
+{
+    slot.version.store(version + 1, std::memory_order_release);
+    slot.writer.store(0, std::memory_order_release);
+}
+
+#ifdef __linux__
+std::string shared_memory_name(std::string const & name)
+{
+    return name.empty() || name[0] == '/' ? name : "/" + name;
+}
+
+Status errno_status(char const * action, std::string const & name)
+{
+    return Status::IOError(
+        "Failed to ", action, " shared signal cache '", name, "': ", std::strerror(errno));
+}
+#endif
+
+}  // namespace
+
+struct SharedSignalCache::Layout {
+    std::atomic<std::uint64_t> magic;
+    std::uint64_t layout_version;
+    std::uint64_t slot_count;
+    std::uint64_t data_bytes;
+    // Bytes reserved in the ring since the cache was created:
+    std::atomic<std::uint64_t> write_position;
+    std::atomic<std::uint64_t> hits;
+    std::atomic<std::uint64_t> misses;
+    std::atomic<std::uint64_t> insertions;
+    std::atomic<std::uint64_t> skipped_insertions;
+    std::uint64_t padding[7];
+
+    Slot * slots() { return reinterpret_cast<Slot *>(this + 1); }
+
+    char * data() { return reinterpret_cast<char *>(slots() + slot_count); }
+
+    static std::size_t mapping_size(std::uint64_t slot_count, std::uint64_t data_bytes)
+    {
+        return sizeof(Layout) + slot_count * sizeof(Slot) + data_bytes;
+    }
+
+    /// Find if samples written at [position] may have been overwritten.
+    bool overwritten(std::uint64_t position) const
+    {
+        return write_position.load(std::memory_order_relaxed) > position + data_bytes;
+    }
+
+    /// Find if the signal rows written at [position] are [key]'s, the slot pointing at them may
+    /// be changing, so the result is only good once the slot's version is checked again.
+    bool has_signal_rows(std::uint64_t position, Key const & key)
+    {
+        auto const offset = position % data_bytes;
+        auto const bytes = signal_rows_bytes(key);
+        return offset + bytes <= data_bytes
+               && std::memcmp(data() + offset, key.signal_rows.data(), bytes) == 0;
+    }
+
+    /// Reserve [bytes] of the ring, contiguous in memory, returning their position.
+    std::uint64_t reserve(std::uint64_t bytes)
+    {
+        auto current = write_position.load(std::memory_order_relaxed);
+        while (true) {
+            auto start = current;
+            auto const offset = start % data_bytes;
+            if (offset + bytes > data_bytes) {
+                // Skip the end of the ring rather than splitting the read:
+                start += data_bytes - offset;
+            }
+            if (write_position.compare_exchange_weak(current, start + bytes)) {
+                return start;
+            }
+        }
+    }
+};
+
+Result<std::shared_ptr<SharedSignalCache>> SharedSignalCache::open(
+    std::string const & name,
+    std::size_t capacity_bytes)
+{
+#ifdef __linux__
+    auto const shm_name = shared_memory_name(name);
+    if (shm_name.size() < 2 || shm_name.find('/', 1) != std::string::npos) {
+        return Status::Invalid("Invalid shared signal cache name '", name, "'");
+    }
+
+    auto const data_bytes = (std::uint64_t(capacity_bytes) + 63) / 64 * 64;
+    if (data_bytes == 0) {
+        return Status::Invalid("Shared signal cache capacity must be non zero");
+    }
+
+    int fd = shm_open(shm_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd >= 0) {
+        // This process creates the cache, memory from ftruncate is zeroed, leaving every slot
+        // empty and every counter at 0:
+        auto const slot_count = std::max<std::uint64_t>(data_bytes / BytesPerSlot, MinSlotCount);
+        auto const size = Layout::mapping_size(slot_count, data_bytes);
+        if (ftruncate(fd, off_t(size)) != 0) {
+            auto const status = errno_status("size", name);
+            close(fd);
+            shm_unlink(shm_name.c_str());
+            return status;
+        }
+        auto const mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (mapping == MAP_FAILED) {
+            auto const status = errno_status("map", name);
+            shm_unlink(shm_name.c_str());
+            return status;
+        }
+
+        auto const layout = static_cast<Layout *>(mapping);
+        layout->layout_version = LayoutVersion;
+        layout->slot_count = slot_count;
+        layout->data_bytes = data_bytes;
+        layout->magic.store(LayoutMagic, std::memory_order_release);
+        return std::shared_ptr<SharedSignalCache>(new SharedSignalCache(name, mapping, size));
+    }
+    if (errno != EEXIST) {
+        return errno_status("create", name);
+    }
+
+    fd = shm_open(shm_name.c_str(), O_RDWR, 0600);
+    if (fd < 0) {
+        return errno_status("open", name);
+    }
+    auto fd_closer = gsl::finally([fd] { close(fd); });
+
+    // Wait for the creating process to size the memory and fill in the layout:
+    auto const deadline = std::chrono::steady_clock::now() + CreationTimeout;
+    std::size_t size = 0;
+    while (true) {
+        struct stat file_stat;
+        if (fstat(fd, &file_stat) != 0) {
+            return errno_status("find the size of", name);
+        }
+        size = std::size_t(file_stat.st_size);
+        if (size >= sizeof(Layout)) {
+            auto const header = mmap(nullptr, sizeof(Layout), PROT_READ, MAP_SHARED, fd, 0);
+            if (header == MAP_FAILED) {
+                return errno_status("map", name);
+            }
+            auto const layout = static_cast<Layout const *>(header);
+            bool const ready = layout->magic.load(std::memory_order_acquire) == LayoutMagic;
+            auto const layout_version = layout->layout_version;
+            auto const expected_size =
+                Layout::mapping_size(layout->slot_count, layout->data_bytes);
+            munmap(header, sizeof(Layout));
+            if (ready) {
+                if (layout_version != LayoutVersion || size != expected_size) {
+                    return Status::Invalid(
+                        "Shared signal cache '", name, "' was created by an incompatible version");
+                }
+                break;
+            }
+        }
+        if (std::chrono::steady_clock::now() > deadline) {
+            return Status::IOError("Timed out waiting for shared signal cache '", name, "'");
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    auto const mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        return errno_status("map", name);
+    }
+    return std::shared_ptr<SharedSignalCache>(new SharedSignalCache(name, mapping, size));
+#else
+    (void)name;
+    (void)capacity_bytes;
+    return Status::NotImplemented("Shared signal caches are only supported on Linux");
+#endif
+}
+
+Status SharedSignalCache::remove(std::string const & name)
+{
+#ifdef __linux__
+    if (shm_unlink(shared_memory_name(name).c_str()) != 0) {
+        return errno_status("remove", name);
+    }
+    return Status::OK();
+#else
+    (void)name;
+    return Status::NotImplemented("Shared signal caches are only supported on Linux");
+#endif
+}
+
+SharedSignalCache::SharedSignalCache(
+    std::string const & name,
+    void * mapping,
+    std::size_t mapping_size)
+: m_name(name)
+, m_mapping(mapping)
+, m_mapping_size(mapping_size)
+, m_layout(static_cast<Layout *>(mapping))
+{
+    static_assert(sizeof(Layout) == 128, "The layout header should fill two cache lines");
+}
+
+SharedSignalCache::~SharedSignalCache()
+{
+#ifdef __linux__
+    munmap(m_mapping, m_mapping_size);
+#endif
+}
+
+std::size_t SharedSignalCache::capacity_bytes() const { return m_layout->data_bytes; }
+
+std::size_t SharedSignalCache::find(
+    boost::uuids::uuid const & file_identifier,
+    gsl::span<std::uint64_t const> const & signal_rows,
+    gsl::span<std::int16_t> samples)
+{
+    auto & layout = *m_layout;
+    if (signal_rows.empty()) {
+        layout.misses.fetch_add(1, std::memory_order_relaxed);
+        return 0;
+    }
+    auto const key = make_key(file_identifier, signal_rows);
+    auto const first_slot = hash(key);
+    auto const rows_bytes = signal_rows_bytes(key);
+
+    for (std::size_t probe = 0; probe < ProbeCount; ++probe) {
+        auto & slot = layout.slots()[(first_slot + probe) % layout.slot_count];
+        auto const version = slot.version.load(std::memory_order_acquire);
+        if ((version & 1) || !slot_has_key(slot, key)) {
+            continue;
+        }
+
+        auto const count = sample_count(slot.counts.load(std::memory_order_relaxed));
+        auto const position = slot.position.load(std::memory_order_relaxed);
+        auto const bytes = rows_bytes + count * sizeof(std::int16_t);
+        auto const offset = position % layout.data_bytes;
+        if (count == 0 || count > samples.size() || offset + bytes > layout.data_bytes) {
+            break;
+        }
+        bool const same_rows = layout.has_signal_rows(position, key);
+        if (same_rows) {
+            std::memcpy(
+                samples.data(), layout.data() + offset + rows_bytes, count * sizeof(std::int16_t));
+        }
+
+        // The copy is only good if neither the slot nor the samples changed during it:
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (slot.version.load(std::memory_order_relaxed) != version
+            || layout.overwritten(position))
+        {
+            break;
+        }
+        if (!same_rows) {
+            // Another read sharing the first signal row and row count:
+            continue;
+        }
+
+        slot.hits.fetch_add(1, std::memory_order_relaxed);
+        layout.hits.fetch_add(1, std::memory_order_relaxed);
+        auto const age = layout.write_position.load(std::memory_order_relaxed) - position;
+        if (age > layout.data_bytes / 4 * 3) {
+            // About to be overwritten, but in use - move it to the front of the ring:
+            insert(file_identifier, signal_rows, samples.first(count), true);
+        }
+        return count;
+    }
+
+    layout.misses.fetch_add(1, std::memory_order_relaxed);
+    return 0;
+}
+
+bool SharedSignalCache::insert(
+    boost::uuids::uuid const & file_identifier,
+    gsl::span<std::uint64_t const> const & signal_rows,
+    gsl::span<std::int16_t const> samples)
+{
+    return insert(file_identifier, signal_rows, samples, false);
+}
+
+bool SharedSignalCache::insert(
+    boost::uuids::uuid const & file_identifier,
+    gsl::span<std::uint64_t const> const & signal_rows,
+    gsl::span<std::int16_t const> samples,
+    bool rewrite)
+{
+    auto & layout = *m_layout;
+    auto const key = make_key(file_identifier, signal_rows);
+    auto const rows_bytes = signal_rows_bytes(key);
+    auto const bytes = rows_bytes + samples.size() * sizeof(std::int16_t);
+    if (samples.empty() || signal_rows.empty()
+        || samples.size() > std::numeric_limits<std::uint32_t>::max()
+        || signal_rows.size() > std::numeric_limits<std::uint32_t>::max()
+        || bytes > layout.data_bytes / MaxReadFraction)
+    {
+        layout.skipped_insertions.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    auto const first_slot = hash(key);
+
+    // Use the slot already holding the read, else an empty or overwritten slot, else the least
+    // hit slot:
+    Slot * target = nullptr;
+    std::uint64_t target_hits = std::numeric_limits<std::uint64_t>::max();
+    for (std::size_t probe = 0; probe < ProbeCount; ++probe) {
+        auto & slot = layout.slots()[(first_slot + probe) % layout.slot_count];
+        auto const counts = slot.counts.load(std::memory_order_relaxed);
+        auto const position = slot.position.load(std::memory_order_relaxed);
+        bool const unused = sample_count(counts) == 0 || layout.overwritten(position);
+        if (!unused && slot_has_key(slot, key) && layout.has_signal_rows(position, key)) {
+            if (!rewrite) {
+                return true;
+            }
+            target = &slot;
+            break;
+        }
+
+        auto const hits = unused ? 0 : slot.hits.load(std::memory_order_relaxed) + 1;
+        if (hits < target_hits) {
+            target = &slot;
+            target_hits = hits;
+        }
+    }
+
+    auto const version = lock_slot(*target);
+    if (!version) {
+        layout.skipped_insertions.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    auto const position = layout.reserve((bytes + 7) / 8 * 8);
+    auto const record = layout.data() + position % layout.data_bytes;
+    std::memcpy(record, signal_rows.data(), rows_bytes);
+    std::memcpy(record + rows_bytes, samples.data(), samples.size() * sizeof(std::int16_t));
+    target->file_identifier_high.store(key.file_identifier_high, std::memory_order_relaxed);
+    target->file_identifier_low.store(key.file_identifier_low, std::memory_order_relaxed);
+    target->first_signal_row.store(signal_rows[0], std::memory_order_relaxed);
+    target->counts.store(
+        (std::uint64_t(signal_rows.size()) << 32) | samples.size(), std::memory_order_relaxed);
+    target->position.store(position, std::memory_order_relaxed);
+    if (!rewrite) {
+        target->hits.store(0, std::memory_order_relaxed);
+    }
+    unlock_slot(*target, *version);
+
+    layout.insertions.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+SharedSignalCacheMetrics SharedSignalCache::metrics() const
+{
+    auto const & layout = *m_layout;
+    SharedSignalCacheMetrics metrics;
+    metrics.hits = layout.hits.load(std::memory_order_relaxed);
+    metrics.misses = layout.misses.load(std::memory_order_relaxed);
+    metrics.insertions = layout.insertions.load(std::memory_order_relaxed);
+    metrics.skipped_insertions = layout.skipped_insertions.load(std::memory_order_relaxed);
+    metrics.bytes_written = layout.write_position.load(std::memory_order_relaxed);
+    return metrics;
+}
+
+}  // namespace pod5
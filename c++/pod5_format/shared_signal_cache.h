@@ -0,0 +1,107 @@
+#pragma once
+
+#include "pod5_format/pod5_format_export.h"
+#include "pod5_format/result.h"
+
+#include <boost/uuid/uuid.hpp>
+#include <gsl/gsl-lite.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace pod5 {
+
+/// \brief Counts of a shared signal cache's activity, across every process using it.
+struct SharedSignalCacheMetrics {
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::uint64_t insertions = 0;
+    /// Insertions skipped, as another process was writing the same slot, or the read was too large.
+    std::uint64_t skipped_insertions = 0;
+    /// Total bytes of samples written, once this passes the capacity old reads are overwritten.
+    std::uint64_t bytes_written = 0;
+
+    /// Find the fraction of lookups which hit, 0 if there were none.
+    double hit_rate() const
+    {
+        auto const lookups = hits + misses;
+        return lookups ? double(hits) / lookups : 0.0;
+    }
+};
+
+/// \brief A cache of decoded reads in POSIX shared memory, shared by every process which opens
+///        it by name, so processes reading the same files decompress and hold each read once.
+/// \details Reads are keyed by their file's identifier and all their signal rows. Each read's
+///          signal rows and samples are written to a ring, overwriting the oldest reads once it
+///          is full, and indexed by a hash table of slots. A read found in the oldest quarter of
+///          the ring is written again at the front, so reads in use stay cached. Where every slot
+///          a read can use is taken, the least hit slot is replaced.
+///
+///          Lookups take no locks: each slot carries a sequence number, odd while it is written,
+///          checked before and after the samples are copied, and the ring's write position is
+///          checked to find if the samples were overwritten during the copy. Writers lock only the
+///          slot they write, recording their process id, and skip the insertion if another live
+///          process holds it. A slot held by a process which has exited is taken over.
+/// \note Only supported on Linux. The shared memory persists until remove() is called, or the
+///       machine restarts. Processes sharing a cache must share a pid namespace, so writers can
+///       find if each other are alive.
+class POD5_FORMAT_EXPORT SharedSignalCache {
+public:
+    /// \brief Open the cache called [name], creating it with room for [capacity_bytes] of samples
+    ///        if it doesn't exist.
+    /// \details Processes opening an existing cache use the capacity it was created with.
+    static Result<std::shared_ptr<SharedSignalCache>> open(
+        std::string const & name,
+        std::size_t capacity_bytes);
+
+    /// \brief Remove the cache called [name], processes with it open can continue to use it.
+    static Status remove(std::string const & name);
+
+    ~SharedSignalCache();
+
+    SharedSignalCache(SharedSignalCache const &) = delete;
+    SharedSignalCache & operator=(SharedSignalCache const &) = delete;
+
+    std::string const & name() const { return m_name; }
+
+    /// \brief Find the bytes of samples the cache holds before overwriting old reads.
+    std::size_t capacity_bytes() const;
+
+    /// \brief Copy the samples of the read with [signal_rows] in file [file_identifier] into
+    ///        [samples].
+    /// \returns The number of samples copied, 0 if the read isn't cached or doesn't fit
+    ///          [samples].
+    std::size_t find(
+        boost::uuids::uuid const & file_identifier,
+        gsl::span<std::uint64_t const> const & signal_rows,
+        gsl::span<std::int16_t> samples);
+
+    /// \brief Add the samples of the read with [signal_rows] in file [file_identifier] to the
+    ///        cache.
+    /// \returns If the read was added (or was already cached).
+    bool insert(
+        boost::uuids::uuid const & file_identifier,
+        gsl::span<std::uint64_t const> const & signal_rows,
+        gsl::span<std::int16_t const> samples);
+
+    SharedSignalCacheMetrics metrics() const;
+
+private:
+    struct Layout;
+
+    SharedSignalCache(std::string const & name, void * mapping, std::size_t mapping_size);
+
+    bool insert(
+        boost::uuids::uuid const & file_identifier,
+        gsl::span<std::uint64_t const> const & signal_rows,
+        gsl::span<std::int16_t const> samples,
+        bool rewrite);
+
+    std::string m_name;
+    void * m_mapping;
+    std::size_t m_mapping_size;
+    Layout * m_layout;
+};
+
+}  // namespace pod5
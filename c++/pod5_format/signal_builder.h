@@ -20,13 +20,19 @@ struct UncompressedSignalBuilder {
 struct VbzSignalBuilder {
     ExpandableBuffer<std::int64_t> offset_values;
     ExpandableBuffer<std::uint8_t> data_values;
+    int compression_level = DEFAULT_VBZ_COMPRESSION_LEVEL;
+    // If set, signal is compressed with the dictionary (at its own level):
+    std::shared_ptr<VbzDictionary const> dictionary;
+    // The column type, distinct when the table may hold dictionary compressed signal:
+    std::shared_ptr<VbzSignalType> signal_type = vbz_signal();
 };
 
 using SignalBuilderVariant = boost::variant<UncompressedSignalBuilder, VbzSignalBuilder>;
 
 inline arrow::Result<SignalBuilderVariant> make_signal_builder(
     SignalType compression_type,
-    arrow::MemoryPool * pool)
+    arrow::MemoryPool * pool,
+    bool vbz_dictionary = false)
 {
     if (compression_type == SignalType::UncompressedSignal) {
         auto signal_array_builder = std::make_shared<arrow::Int16Builder>(pool);
@@ -36,6 +42,9 @@ inline arrow::Result<SignalBuilderVariant> make_signal_builder(
         };
     } else {
         VbzSignalBuilder vbz_builder;
+        if (vbz_dictionary) {
+            vbz_builder.signal_type = vbz_dictionary_signal();
+        }
         ARROW_RETURN_NOT_OK(vbz_builder.offset_values.init_buffer(pool));
         ARROW_RETURN_NOT_OK(vbz_builder.data_values.init_buffer(pool));
         return vbz_builder;
@@ -105,7 +114,10 @@ public:
 
     Status operator()(VbzSignalBuilder & builder) const
     {
-        ARROW_ASSIGN_OR_RAISE(auto compressed_signal, compress_signal(m_signal, m_pool));
+        ARROW_ASSIGN_OR_RAISE(
+            auto compressed_signal,
+            compress_signal(
+                m_signal, m_pool, builder.compression_level, builder.dictionary.get()));
 
         ARROW_RETURN_NOT_OK(builder.offset_values.append(builder.data_values.size()));
         return builder.data_values.append_array(
@@ -116,6 +128,19 @@ public:
     arrow::MemoryPool * m_pool;
 };
 
+class signal_data_size : boost::static_visitor<std::size_t> {
+public:
+    std::size_t operator()(UncompressedSignalBuilder const & builder) const
+    {
+        return builder.signal_data_builder->length() * sizeof(std::int16_t);
+    }
+
+    std::size_t operator()(VbzSignalBuilder const & builder) const
+    {
+        return builder.data_values.size();
+    }
+};
+
 class finish_column : boost::static_visitor<Status> {
 public:
     finish_column(std::shared_ptr<arrow::Array> * dest) : m_dest(dest) {}
@@ -141,8 +166,8 @@ public:
 
         std::shared_ptr<arrow::Buffer> null_bitmap;
 
-        *m_dest = arrow::MakeArray(
-            arrow::ArrayData::Make(vbz_signal(), length, {null_bitmap, offsets, value_data}, 0, 0));
+        *m_dest = arrow::MakeArray(arrow::ArrayData::Make(
+            builder.signal_type, length, {null_bitmap, offsets, value_data}, 0, 0));
 
         return arrow::Status::OK();
     }
@@ -0,0 +1,221 @@
+#include "pod5_format/signal_client.h"
+
+#include <cstring>
+
+#ifdef __linux__
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#endif
+
+namespace pod5 {
+
+namespace {
+
+template <typename T>
+gsl::span<std::uint8_t const> as_bytes(T const & value)
+{
+    return gsl::make_span(reinterpret_cast<std::uint8_t const *>(&value), sizeof(T));
+}
+
+template <typename T>
+Result<T> read_struct(gsl::span<std::uint8_t const> payload)
+{
+    if (payload.size() < sizeof(T)) {
+        return Status::IOError("Signal server reply is too short");
+    }
+    T value;
+    std::memcpy(&value, payload.data(), sizeof(T));
+    return value;
+}
+
+struct ReadsReplyData {
+    gsl::span<SignalServerRead const> reads;
+    gsl::span<std::int16_t const> samples;
+};
+
+/// Find the reads and samples in one reply to a GetReads or GetSignal request.
+Result<ReadsReplyData> parse_reads_reply(gsl::span<std::uint8_t const> data, bool with_samples)
+{
+    ARROW_ASSIGN_OR_RAISE(auto const reply, read_struct<signal_server::ReadsReply>(data));
+
+    auto const reads_size = reply.read_count * sizeof(SignalServerRead);
+    auto const samples_size = with_samples ? reply.sample_count * sizeof(std::int16_t) : 0;
+    if (reply.read_count > data.size() || reply.sample_count > data.size()
+        || data.size() != sizeof(reply) + reads_size + samples_size)
+    {
+        return Status::IOError("Signal server reply has the wrong size");
+    }
+
+    auto const reads_data = data.subspan(sizeof(reply));
+    ReadsReplyData result;
+    result.reads = gsl::make_span(
+        reinterpret_cast<SignalServerRead const *>(reads_data.data()), reply.read_count);
+    result.samples = gsl::make_span(
+        reinterpret_cast<std::int16_t const *>(reads_data.data() + reads_size),
+        samples_size / sizeof(std::int16_t));
+
+    for (auto const & read : result.reads) {
+        if (with_samples
+            && (read.sample_offset > result.samples.size()
+                || read.num_samples > result.samples.size() - read.sample_offset))
+        {
+            return Status::IOError("Signal server reply has samples out of range");
+        }
+    }
+    return result;
+}
+
+}  // namespace
+
+Result<std::shared_ptr<SignalServerReads>> SignalServerReads::make(
+    std::vector<signal_server::MessagePayload> && payloads,
+    bool with_samples)
+{
+    std::shared_ptr<SignalServerReads> reads(new SignalServerReads());
+    if (payloads.size() == 1) {
+        // Use the only reply in place:
+        reads->m_payload = std::move(payloads.front());
+        ARROW_ASSIGN_OR_RAISE(
+            auto const reply, parse_reads_reply(reads->m_payload.data(), with_samples));
+        reads->m_reads = reply.reads;
+        reads->m_samples = reply.samples;
+        return reads;
+    }
+
+    // Join the replies, releasing each once it is copied:
+    for (auto & payload : payloads) {
+        ARROW_ASSIGN_OR_RAISE(auto const reply, parse_reads_reply(payload.data(), with_samples));
+        auto const sample_offset = reads->m_sample_storage.size();
+        for (auto read : reply.reads) {
+            read.sample_offset += sample_offset;
+            reads->m_read_storage.push_back(read);
+        }
+        reads->m_sample_storage.insert(
+            reads->m_sample_storage.end(), reply.samples.begin(), reply.samples.end());
+        payload = signal_server::MessagePayload();
+    }
+    reads->m_reads = gsl::make_span(reads->m_read_storage);
+    reads->m_samples = gsl::make_span(reads->m_sample_storage);
+    return reads;
+}
+
+Result<std::unique_ptr<SignalClient>> SignalClient::connect(std::string const & socket_path)
+{
+#ifdef __linux__
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socket_path.empty() || socket_path.size() >= sizeof(address.sun_path)) {
+        return Status::Invalid("Invalid signal server socket path '", socket_path, "'");
+    }
+    std::memcpy(address.sun_path, socket_path.data(), socket_path.size());
+
+    int const fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return Status::IOError("Failed to create socket: ", std::strerror(errno));
+    }
+    if (::connect(fd, reinterpret_cast<sockaddr const *>(&address), sizeof(address)) != 0) {
+        auto const status = Status::IOError(
+            "Failed to connect to signal server '", socket_path, "': ", std::strerror(errno));
+        close(fd);
+        return status;
+    }
+    return std::unique_ptr<SignalClient>(new SignalClient(fd));
+#else
+    (void)socket_path;
+    return Status::NotImplemented("Signal servers are only supported on Linux");
+#endif
+}
+
+SignalClient::SignalClient(int socket) : m_socket(socket) {}
+
+SignalClient::~SignalClient()
+{
+#ifdef __linux__
+    close(m_socket);
+#endif
+}
+
+Result<SignalClient::OpenedFile> SignalClient::open_file(std::string const & path)
+{
+    gsl::span<std::uint8_t const> const payload[] = {
+        gsl::make_span(reinterpret_cast<std::uint8_t const *>(path.data()), path.size())};
+    ARROW_ASSIGN_OR_RAISE(
+        auto const reply_payloads, request(signal_server::MessageType::OpenFile, payload));
+    ARROW_ASSIGN_OR_RAISE(
+        auto const reply,
+        read_struct<signal_server::OpenFileReply>(reply_payloads.front().data()));
+
+    OpenedFile opened_file;
+    opened_file.file = reply.file;
+    opened_file.read_count = reply.read_count;
+    std::memcpy(
+        opened_file.file_identifier.data,
+        reply.file_identifier,
+        sizeof(reply.file_identifier));
+    return opened_file;
+}
+
+Status SignalClient::close_file(std::uint32_t file)
+{
+    signal_server::FileRequest file_request;
+    file_request.file = file;
+    gsl::span<std::uint8_t const> const payload[] = {as_bytes(file_request)};
+    return request(signal_server::MessageType::CloseFile, payload).status();
+}
+
+Result<std::shared_ptr<SignalServerReads>> SignalClient::get_reads(
+    std::uint32_t file,
+    gsl::span<boost::uuids::uuid const> read_ids,
+    bool with_samples)
+{
+    signal_server::FileRequest file_request;
+    file_request.file = file;
+    file_request.read_id_count = read_ids.size();
+    gsl::span<std::uint8_t const> const payload[] = {
+        as_bytes(file_request),
+        gsl::make_span(
+            reinterpret_cast<std::uint8_t const *>(read_ids.data()),
+            read_ids.size() * sizeof(boost::uuids::uuid))};
+
+    ARROW_ASSIGN_OR_RAISE(
+        auto reply_payloads,
+        request(
+            with_samples ? signal_server::MessageType::GetSignal
+                         : signal_server::MessageType::GetReads,
+            payload));
+    return SignalServerReads::make(std::move(reply_payloads), with_samples);
+}
+
+Result<std::vector<signal_server::MessagePayload>> SignalClient::request(
+    signal_server::MessageType type,
+    gsl::span<gsl::span<std::uint8_t const> const> payload)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    signal_server::MessageHeader header;
+    header.type = type;
+    ARROW_RETURN_NOT_OK(signal_server::send_message(m_socket, header, payload));
+
+    std::vector<signal_server::MessagePayload> reply_payloads;
+    while (true) {
+        ARROW_ASSIGN_OR_RAISE(
+            auto reply,
+            signal_server::receive_message(m_socket, signal_server::MAX_INLINE_REPLY_SIZE));
+        if (!reply) {
+            return Status::IOError("Signal server closed the connection");
+        }
+        if (reply->header.type != type) {
+            return Status::IOError("Signal server replied to the wrong request");
+        }
+        ARROW_RETURN_NOT_OK(signal_server::message_status(*reply));
+        reply_payloads.push_back(std::move(reply->payload));
+        if (!(reply->header.flags & signal_server::MessageHeader::MORE_REPLIES)) {
+            return reply_payloads;
+        }
+    }
+}
+
+}  // namespace pod5
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "pod5_format/pod5_format_export.h"
+#include "pod5_format/result.h"
+#include "pod5_format/signal_server_protocol.h"
+
+#include <boost/uuid/uuid.hpp>
+#include <gsl/gsl-lite.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace pod5 {
+
+/// \brief Reads fetched from a SignalServer, their metadata and optionally their samples.
+/// \details Large replies are mapped from the memfd the server wrote them to. The reads and
+///          samples of a single reply are used in place, those the server sent in several
+///          replies (one for each read batch) are joined.
+class POD5_FORMAT_EXPORT SignalServerReads {
+public:
+    static Result<std::shared_ptr<SignalServerReads>> make(
+        std::vector<signal_server::MessagePayload> && payloads,
+        bool with_samples);
+
+    gsl::span<SignalServerRead const> reads() const { return m_reads; }
+
+    /// \brief Find the samples of every read, each read's samples start at its sample_offset.
+    gsl::span<std::int16_t const> samples() const { return m_samples; }
+
+    /// \brief Find the samples of one of reads().
+    gsl::span<std::int16_t const> samples(SignalServerRead const & read) const
+    {
+        return m_samples.subspan(read.sample_offset, read.num_samples);
+    }
+
+private:
+    SignalServerReads() = default;
+
+    signal_server::MessagePayload m_payload;
+    // Reads and samples joined from several replies:
+    std::vector<SignalServerRead> m_read_storage;
+    std::vector<std::int16_t> m_sample_storage;
+
+    gsl::span<SignalServerRead const> m_reads;
+    gsl::span<std::int16_t const> m_samples;
+};
+
+/// \brief Connection to a SignalServer (see pod5d), fetching reads from the files it holds open.
+/// \note Requests are sent one at a time, a client can be shared by threads but they will
+///       wait on each other.
+class POD5_FORMAT_EXPORT SignalClient {
+public:
+    struct OpenedFile {
+        /// Handle for the file in later requests on this connection.
+        std::uint32_t file;
+        std::uint64_t read_count;
+        boost::uuids::uuid file_identifier;
+    };
+
+    static Result<std::unique_ptr<SignalClient>> connect(std::string const & socket_path);
+
+    ~SignalClient();
+
+    SignalClient(SignalClient const &) = delete;
+    SignalClient & operator=(SignalClient const &) = delete;
+
+    /// \brief Open the file at [path] on the server, the path is resolved by the server.
+    Result<OpenedFile> open_file(std::string const & path);
+
+    Status close_file(std::uint32_t file);
+
+    /// \brief Fetch the reads in [file] with [read_ids], in file order, read ids not found in the
+    ///        file are skipped. An empty [read_ids] fetches every read in the file.
+    /// \param with_samples Fetch the reads' samples as well as their metadata.
+    Result<std::shared_ptr<SignalServerReads>> get_reads(
+        std::uint32_t file,
+        gsl::span<boost::uuids::uuid const> read_ids,
+        bool with_samples);
+
+private:
+    explicit SignalClient(int socket);
+
+    /// \brief Send a request, returning the payload of each of its replies.
+    Result<std::vector<signal_server::MessagePayload>> request(
+        signal_server::MessageType type,
+        gsl::span<gsl::span<std::uint8_t const> const> payload);
+
+    int m_socket;
+    std::mutex m_mutex;
+};
+
+}  // namespace pod5
@@ -1,34 +1,152 @@
 #include "pod5_format/signal_compression.h"
 
+#include "pod5_format/signal_kernels.h"
 #include "pod5_format/svb16/decode.hpp"
 #include "pod5_format/svb16/encode.hpp"
 
 #include <arrow/buffer.h>
+#include <gsl/gsl-lite.hpp>
+#include <zdict.h>
 #include <zstd.h>
 
 namespace pod5 {
 
-std::size_t compressed_signal_max_size(std::size_t sample_count)
+namespace {
+
+struct ZstdDeleter {
+    void operator()(ZSTD_CCtx * context) const { ZSTD_freeCCtx(context); }
+
+    void operator()(ZSTD_DCtx * context) const { ZSTD_freeDCtx(context); }
+
+    void operator()(ZSTD_CDict * dictionary) const { ZSTD_freeCDict(dictionary); }
+
+    void operator()(ZSTD_DDict * dictionary) const { ZSTD_freeDDict(dictionary); }
+};
+
+// Contexts are reused by each thread, rather than allocated for every row:
+arrow::Result<ZSTD_CCtx *> thread_compression_context()
 {
-    auto const max_svb_size = svb16_max_encoded_length(sample_count);
-    auto const zstd_compressed_max_size = ZSTD_compressBound(max_svb_size);
-    return zstd_compressed_max_size;
+    thread_local std::unique_ptr<ZSTD_CCtx, ZstdDeleter> context{ZSTD_createCCtx()};
+    if (!context) {
+        return pod5::Status::OutOfMemory("Failed to create zstd compression context");
+    }
+    return context.get();
 }
 
-arrow::Result<std::size_t> compress_signal(
+arrow::Result<ZSTD_DCtx *> thread_decompression_context()
+{
+    thread_local std::unique_ptr<ZSTD_DCtx, ZstdDeleter> context{ZSTD_createDCtx()};
+    if (!context) {
+        return pod5::Status::OutOfMemory("Failed to create zstd decompression context");
+    }
+    return context.get();
+}
+
+static constexpr bool UseDelta = true;
+static constexpr bool UseZigzag = true;
+
+/// Svb encode [samples] into [out] with [kernel], returning the encoded size.
+std::size_t svb_encode_with(
+    SvbKernel kernel,
     gsl::span<SampleType const> const & samples,
-    arrow::MemoryPool * pool,
-    gsl::span<std::uint8_t> const & destination)
+    std::uint8_t * out)
+{
+    auto const keys = out;
+    auto const data = keys + ::svb16_key_length(samples.size());
+#ifdef SVB16_X64
+    if (kernel == SvbKernel::Sse) {
+        return svb16::encode_sse<SampleType, UseDelta, UseZigzag>(
+                   samples.data(), keys, data, samples.size(), 0)
+               - out;
+    }
+#endif
+    return svb16::encode_scalar<SampleType, UseDelta, UseZigzag>(
+               samples.data(), keys, data, samples.size(), 0)
+           - out;
+}
+
+/// Svb decode [in] into [out] with [kernel], returning the number of bytes consumed.
+std::size_t svb_decode_with(
+    SvbKernel kernel,
+    gsl::span<SampleType> const & out,
+    gsl::span<std::uint8_t const> const & in)
+{
+    auto const keys_length = ::svb16_key_length(out.size());
+    auto const keys = in.subspan(0, keys_length);
+    auto const data = in.subspan(keys_length);
+#ifdef SVB16_X64
+    if (kernel == SvbKernel::Sse) {
+        return svb16::decode_sse<SampleType, UseDelta, UseZigzag>(out, keys, data, 0) - in.begin();
+    }
+#endif
+    return svb16::decode_scalar<SampleType, UseDelta, UseZigzag>(out, keys, data, 0) - in.begin();
+}
+
+arrow::Result<std::unique_ptr<arrow::ResizableBuffer>> svb_encode(
+    gsl::span<SampleType const> const & samples,
+    arrow::MemoryPool * pool)
 {
-    // First compress the data using svb:
     auto const max_size = svb16_max_encoded_length(samples.size());
-    ARROW_ASSIGN_OR_RAISE(auto intermediate, arrow::AllocateResizableBuffer(max_size, pool));
+    ARROW_ASSIGN_OR_RAISE(auto encoded, arrow::AllocateResizableBuffer(max_size, pool));
+
+    auto const encoded_count =
+        svb_encode_with(signal_kernels().svb16_encode, samples, encoded->mutable_data());
+    ARROW_RETURN_NOT_OK(encoded->Resize(encoded_count));
+    return encoded;
+}
+
+/// Decompress the zstd frame [compressed] into [out] through the streaming api.
+arrow::Status zstd_decompress_streaming(
+    ZSTD_DCtx * context,
+    gsl::span<std::uint8_t> const & out,
+    gsl::span<std::uint8_t const> const & compressed,
+    ZSTD_DDict const * dictionary)
+{
+    // Leave the context as it was found, so one shot calls don't pick up the dictionary:
+    auto reset_context =
+        gsl::finally([&] { ZSTD_DCtx_reset(context, ZSTD_reset_session_and_parameters); });
+    ZSTD_DCtx_reset(context, ZSTD_reset_session_and_parameters);
+    if (dictionary) {
+        auto const result = ZSTD_DCtx_refDDict(context, dictionary);
+        if (ZSTD_isError(result)) {
+            return pod5::Status::Invalid(
+                "Failed to use zstd dictionary: ", ZSTD_getErrorName(result));
+        }
+    }
 
-    static constexpr bool UseDelta = true;
-    static constexpr bool UseZigzag = true;
-    auto const encoded_count = svb16::encode<SampleType, UseDelta, UseZigzag>(
-        samples.data(), intermediate->mutable_data(), samples.size());
-    ARROW_RETURN_NOT_OK(intermediate->Resize(encoded_count));
+    ZSTD_inBuffer input{compressed.data(), compressed.size(), 0};
+    ZSTD_outBuffer output{out.data(), out.size(), 0};
+    while (true) {
+        auto const input_pos = input.pos;
+        auto const output_pos = output.pos;
+        auto const result = ZSTD_decompressStream(context, &output, &input);
+        if (ZSTD_isError(result)) {
+            return pod5::Status::Invalid(
+                "Input data failed to decompress using zstd: (",
+                result,
+                " ",
+                ZSTD_getErrorName(result),
+                ")");
+        }
+        if (result == 0) {
+            return pod5::Status::OK();
+        }
+        if (input.pos == input_pos && output.pos == output_pos) {
+            return pod5::Status::Invalid("Input data failed to decompress using zstd: (truncated)");
+        }
+    }
+}
+
+/// Compress [samples] with svb then zstd, with [dictionary] if non-null, otherwise at [level].
+arrow::Result<std::size_t> compress_signal_impl(
+    gsl::span<SampleType const> const & samples,
+    arrow::MemoryPool * pool,
+    gsl::span<std::uint8_t> const & destination,
+    int compression_level,
+    ZSTD_CDict const * dictionary)
+{
+    // First compress the data using svb:
+    ARROW_ASSIGN_OR_RAISE(auto intermediate, svb_encode(samples, pool));
 
     // Now compress the svb data using zstd:
     size_t const zstd_compressed_max_size = ZSTD_compressBound(intermediate->size());
@@ -36,38 +154,171 @@ arrow::Result<std::size_t> compress_signal(
         return pod5::Status::Invalid("Failed to find zstd max size for data");
     }
 
-    /* Compress.
-     * If you are doing many compressions, you may want to reuse the context.
-     * See the multiple_simple_compression.c example.
-     */
-    size_t const compressed_size = ZSTD_compress(
-        destination.data(), destination.size(), intermediate->data(), intermediate->size(), 1);
+    ARROW_ASSIGN_OR_RAISE(auto context, thread_compression_context());
+    size_t const compressed_size = dictionary ? ZSTD_compress_usingCDict(
+                                                    context,
+                                                    destination.data(),
+                                                    destination.size(),
+                                                    intermediate->data(),
+                                                    intermediate->size(),
+                                                    dictionary)
+                                              : ZSTD_compressCCtx(
+                                                    context,
+                                                    destination.data(),
+                                                    destination.size(),
+                                                    intermediate->data(),
+                                                    intermediate->size(),
+                                                    compression_level);
     if (ZSTD_isError(compressed_size)) {
         return pod5::Status::Invalid("Failed to compress data");
     }
     return compressed_size;
 }
 
+}  // namespace
+
+struct VbzDictionary::Impl {
+    std::shared_ptr<arrow::Buffer> data;
+    int compression_level;
+    std::uint32_t id;
+    std::unique_ptr<ZSTD_CDict, ZstdDeleter> compression_dictionary;
+    std::unique_ptr<ZSTD_DDict, ZstdDeleter> decompression_dictionary;
+};
+
+VbzDictionary::VbzDictionary(std::unique_ptr<Impl> && impl) : m_impl(std::move(impl)) {}
+
+VbzDictionary::~VbzDictionary() = default;
+
+Result<std::shared_ptr<VbzDictionary const>> VbzDictionary::make(
+    std::shared_ptr<arrow::Buffer> const & data,
+    int compression_level)
+{
+    if (!data) {
+        return pod5::Status::Invalid("Missing signal dictionary data");
+    }
+
+    // Raw content dictionaries have no id, so frames compressed with them can't be recognised:
+    auto const id = ZSTD_getDictID_fromDict(data->data(), data->size());
+    if (id == 0) {
+        return pod5::Status::Invalid("Signal dictionary is not a trained zstd dictionary");
+    }
+
+    auto impl = std::make_unique<Impl>();
+    impl->data = data;
+    impl->compression_level = compression_level;
+    impl->id = id;
+    impl->compression_dictionary.reset(
+        ZSTD_createCDict(data->data(), data->size(), compression_level));
+    impl->decompression_dictionary.reset(ZSTD_createDDict(data->data(), data->size()));
+    if (!impl->compression_dictionary || !impl->decompression_dictionary) {
+        return pod5::Status::Invalid("Failed to load zstd signal dictionary");
+    }
+
+    return std::shared_ptr<VbzDictionary const>(new VbzDictionary(std::move(impl)));
+}
+
+std::shared_ptr<arrow::Buffer> const & VbzDictionary::data() const { return m_impl->data; }
+
+std::uint32_t VbzDictionary::id() const { return m_impl->id; }
+
+int VbzDictionary::compression_level() const { return m_impl->compression_level; }
+
+std::size_t compressed_signal_max_size(std::size_t sample_count)
+{
+    auto const max_svb_size = svb16_max_encoded_length(sample_count);
+    auto const zstd_compressed_max_size = ZSTD_compressBound(max_svb_size);
+    return zstd_compressed_max_size;
+}
+
+arrow::Result<std::size_t> vbz_signal_max_sample_count(
+    gsl::span<std::uint8_t const> const & compressed_bytes)
+{
+    unsigned long long const decompressed_zstd_size =
+        ZSTD_getFrameContentSize(compressed_bytes.data(), compressed_bytes.size());
+    if (ZSTD_isError(decompressed_zstd_size)) {
+        return pod5::Status::Invalid(
+            "Input data not compressed by zstd: (",
+            decompressed_zstd_size,
+            " ",
+            ZSTD_getErrorName(decompressed_zstd_size),
+            ")");
+    }
+
+    // svb stores every sample in at least one byte, after the keys:
+    return std::size_t(decompressed_zstd_size);
+}
+
+arrow::Result<std::size_t> compress_signal(
+    gsl::span<SampleType const> const & samples,
+    arrow::MemoryPool * pool,
+    gsl::span<std::uint8_t> const & destination)
+{
+    return compress_signal_impl(samples, pool, destination, DEFAULT_VBZ_COMPRESSION_LEVEL, nullptr);
+}
+
+arrow::Result<std::size_t> compress_signal(
+    gsl::span<SampleType const> const & samples,
+    arrow::MemoryPool * pool,
+    gsl::span<std::uint8_t> const & destination,
+    int compression_level)
+{
+    return compress_signal_impl(samples, pool, destination, compression_level, nullptr);
+}
+
+arrow::Result<std::size_t> compress_signal(
+    gsl::span<SampleType const> const & samples,
+    arrow::MemoryPool * pool,
+    gsl::span<std::uint8_t> const & destination,
+    VbzDictionary const & dictionary)
+{
+    return compress_signal_impl(
+        samples,
+        pool,
+        destination,
+        dictionary.compression_level(),
+        dictionary.impl().compression_dictionary.get());
+}
+
 arrow::Result<std::shared_ptr<arrow::Buffer>> compress_signal(
     gsl::span<SampleType const> const & samples,
     arrow::MemoryPool * pool)
+{
+    return compress_signal(samples, pool, DEFAULT_VBZ_COMPRESSION_LEVEL, nullptr);
+}
+
+arrow::Result<std::shared_ptr<arrow::Buffer>> compress_signal(
+    gsl::span<SampleType const> const & samples,
+    arrow::MemoryPool * pool,
+    int compression_level,
+    VbzDictionary const * dictionary)
 {
     ARROW_ASSIGN_OR_RAISE(
         std::shared_ptr<arrow::ResizableBuffer> out,
         arrow::AllocateResizableBuffer(compressed_signal_max_size(samples.size()), pool));
 
+    auto const destination = gsl::make_span(out->mutable_data(), out->size());
     ARROW_ASSIGN_OR_RAISE(
         auto final_size,
-        compress_signal(samples, pool, gsl::make_span(out->mutable_data(), out->size())));
+        dictionary ? compress_signal(samples, pool, destination, *dictionary)
+                   : compress_signal(samples, pool, destination, compression_level));
 
     ARROW_RETURN_NOT_OK(out->Resize(final_size));
     return out;
 }
 
-POD5_FORMAT_EXPORT arrow::Status decompress_signal(
+arrow::Status decompress_signal(
     gsl::span<std::uint8_t const> const & compressed_bytes,
     arrow::MemoryPool * pool,
     gsl::span<std::int16_t> const & destination)
+{
+    return decompress_signal(compressed_bytes, pool, destination, nullptr);
+}
+
+arrow::Status decompress_signal(
+    gsl::span<std::uint8_t const> const & compressed_bytes,
+    arrow::MemoryPool * pool,
+    gsl::span<std::int16_t> const & destination,
+    VbzDictionary const * dictionary)
 {
     // First decompress the data using zstd:
     unsigned long long const decompressed_zstd_size =
@@ -81,29 +332,61 @@ POD5_FORMAT_EXPORT arrow::Status decompress_signal(
             ")");
     }
 
+    // Frames compressed with a dictionary record its id, those without one record zero:
+    ZSTD_DDict const * zstd_dictionary = nullptr;
+    auto const dictionary_id =
+        ZSTD_getDictID_fromFrame(compressed_bytes.data(), compressed_bytes.size());
+    if (dictionary_id != 0) {
+        if (!dictionary || dictionary->id() != dictionary_id) {
+            return pod5::Status::Invalid(
+                "Signal was compressed with zstd dictionary ",
+                dictionary_id,
+                ", which is not available");
+        }
+        zstd_dictionary = dictionary->impl().decompression_dictionary.get();
+    }
+
+    auto const kernels = signal_kernels();
     auto allocation_padding = svb16::decode_input_buffer_padding_byte_count();
     ARROW_ASSIGN_OR_RAISE(
         auto intermediate,
         arrow::AllocateResizableBuffer(decompressed_zstd_size + allocation_padding, pool));
-    size_t const decompress_res = ZSTD_decompress(
-        intermediate->mutable_data(),
-        intermediate->size(),
-        compressed_bytes.data(),
-        compressed_bytes.size());
-    if (ZSTD_isError(decompress_res)) {
-        return pod5::Status::Invalid(
-            "Input data failed to decompress using zstd: (",
-            decompress_res,
-            " ",
-            ZSTD_getErrorName(decompress_res),
-            ")");
+    ARROW_ASSIGN_OR_RAISE(auto context, thread_decompression_context());
+    if (kernels.zstd_decompress == ZstdDecompressMode::Streaming) {
+        ARROW_RETURN_NOT_OK(zstd_decompress_streaming(
+            context,
+            gsl::make_span(intermediate->mutable_data(), decompressed_zstd_size),
+            compressed_bytes,
+            zstd_dictionary));
+    } else {
+        size_t const decompress_res = zstd_dictionary ? ZSTD_decompress_usingDDict(
+                                                            context,
+                                                            intermediate->mutable_data(),
+                                                            intermediate->size(),
+                                                            compressed_bytes.data(),
+                                                            compressed_bytes.size(),
+                                                            zstd_dictionary)
+                                                      : ZSTD_decompressDCtx(
+                                                            context,
+                                                            intermediate->mutable_data(),
+                                                            intermediate->size(),
+                                                            compressed_bytes.data(),
+                                                            compressed_bytes.size());
+        if (ZSTD_isError(decompress_res)) {
+            return pod5::Status::Invalid(
+                "Input data failed to decompress using zstd: (",
+                decompress_res,
+                " ",
+                ZSTD_getErrorName(decompress_res),
+                ")");
+        }
     }
 
     // Now decompress the data using svb:
-    static constexpr bool UseDelta = true;
-    static constexpr bool UseZigzag = true;
-    auto consumed_count = svb16::decode<SampleType, UseDelta, UseZigzag>(
-        destination, gsl::make_span(intermediate->data(), intermediate->size()));
+    auto consumed_count = svb_decode_with(
+        kernels.svb16_decode,
+        destination,
+        gsl::make_span(intermediate->data(), intermediate->size()));
     if ((consumed_count + allocation_padding) != (std::size_t)intermediate->size()) {
         return pod5::Status::Invalid("Remaining data at end of signal buffer");
     }
@@ -115,6 +398,15 @@ arrow::Result<std::shared_ptr<arrow::Buffer>> decompress_signal(
     gsl::span<std::uint8_t const> const & compressed_bytes,
     std::uint32_t samples_count,
     arrow::MemoryPool * pool)
+{
+    return decompress_signal(compressed_bytes, samples_count, pool, nullptr);
+}
+
+arrow::Result<std::shared_ptr<arrow::Buffer>> decompress_signal(
+    gsl::span<std::uint8_t const> const & compressed_bytes,
+    std::uint32_t samples_count,
+    arrow::MemoryPool * pool,
+    VbzDictionary const * dictionary)
 {
     ARROW_ASSIGN_OR_RAISE(
         std::shared_ptr<arrow::ResizableBuffer> out,
@@ -122,7 +414,47 @@ arrow::Result<std::shared_ptr<arrow::Buffer>> decompress_signal(
 
     auto signal_span = gsl::make_span(out->mutable_data(), out->size()).as_span<std::int16_t>();
 
-    ARROW_RETURN_NOT_OK(decompress_signal(compressed_bytes, pool, signal_span));
+    ARROW_RETURN_NOT_OK(decompress_signal(compressed_bytes, pool, signal_span, dictionary));
     return out;
 }
+
+arrow::Result<std::shared_ptr<arrow::Buffer>> train_vbz_dictionary(
+    std::vector<gsl::span<SampleType const>> const & samples,
+    std::size_t max_size,
+    arrow::MemoryPool * pool)
+{
+    // zstd trains on the svb encoded rows, as that is what it compresses:
+    std::size_t max_encoded_size = 0;
+    for (auto const & row : samples) {
+        max_encoded_size += svb16_max_encoded_length(row.size());
+    }
+    ARROW_ASSIGN_OR_RAISE(auto encoded, arrow::AllocateResizableBuffer(max_encoded_size, pool));
+
+    std::vector<std::size_t> encoded_sizes;
+    encoded_sizes.reserve(samples.size());
+    std::size_t encoded_size = 0;
+    auto const encode_kernel = signal_kernels().svb16_encode;
+    for (auto const & row : samples) {
+        auto const row_size =
+            svb_encode_with(encode_kernel, row, encoded->mutable_data() + encoded_size);
+        encoded_sizes.push_back(row_size);
+        encoded_size += row_size;
+    }
+
+    ARROW_ASSIGN_OR_RAISE(auto dictionary, arrow::AllocateResizableBuffer(max_size, pool));
+    auto const dictionary_size = ZDICT_trainFromBuffer(
+        dictionary->mutable_data(),
+        dictionary->size(),
+        encoded->data(),
+        encoded_sizes.data(),
+        static_cast<unsigned>(encoded_sizes.size()));
+    if (ZDICT_isError(dictionary_size)) {
+        return pod5::Status::Invalid(
+            "Failed to train signal dictionary: ", ZDICT_getErrorName(dictionary_size));
+    }
+
+    ARROW_RETURN_NOT_OK(dictionary->Resize(dictionary_size));
+    return std::shared_ptr<arrow::Buffer>(std::move(dictionary));
+}
+
 }  // namespace pod5
@@ -5,6 +5,9 @@
 
 #include <gsl/gsl-lite.hpp>
 
+#include <memory>
+#include <vector>
+
 namespace arrow {
 class MemoryPool;
 class Buffer;
@@ -14,8 +17,49 @@ namespace pod5 {
 
 using SampleType = std::int16_t;
 
+/// \brief The zstd level vbz signal is compressed at unless another is requested.
+static constexpr int DEFAULT_VBZ_COMPRESSION_LEVEL = 1;
+
+/// \brief A trained zstd dictionary for vbz signal, prepared once for (de)compression.
+/// \details A dictionary primes zstd with the patterns common to a file's signal, so each row need
+///          not relearn them. It helps most with short rows.
+class POD5_FORMAT_EXPORT VbzDictionary {
+public:
+    ~VbzDictionary();
+
+    /// \brief Prepare the dictionary [data] (as made by train_vbz_dictionary()) for use.
+    /// \param compression_level The zstd level signal is compressed at with this dictionary.
+    static Result<std::shared_ptr<VbzDictionary const>> make(
+        std::shared_ptr<arrow::Buffer> const & data,
+        int compression_level = DEFAULT_VBZ_COMPRESSION_LEVEL);
+
+    /// \brief Find the dictionary data, as stored in files.
+    std::shared_ptr<arrow::Buffer> const & data() const;
+
+    /// \brief Find the id of the dictionary, recorded in each zstd frame compressed with it.
+    std::uint32_t id() const;
+
+    int compression_level() const;
+
+    /// \brief The prepared zstd dictionaries, only defined within the library.
+    struct Impl;
+
+    Impl const & impl() const { return *m_impl; }
+
+private:
+    VbzDictionary(std::unique_ptr<Impl> && impl);
+
+    std::unique_ptr<Impl> m_impl;
+};
+
 POD5_FORMAT_EXPORT std::size_t compressed_signal_max_size(std::size_t sample_count);
 
+/// \brief Find the most samples [compressed_bytes] of vbz signal can decompress to.
+/// \details Read from the size recorded in the zstd frame, without decompressing it, so a stored
+///          sample count can be checked before space is allocated for it.
+POD5_FORMAT_EXPORT arrow::Result<std::size_t> vbz_signal_max_sample_count(
+    gsl::span<std::uint8_t const> const & compressed_bytes);
+
 POD5_FORMAT_EXPORT arrow::Result<std::size_t> compress_signal(
     gsl::span<SampleType const> const & samples,
     arrow::MemoryPool * pool,
@@ -25,6 +69,29 @@ POD5_FORMAT_EXPORT arrow::Result<std::shared_ptr<arrow::Buffer>> compress_signal
     gsl::span<SampleType const> const & samples,
     arrow::MemoryPool * pool);
 
+/// \brief Compress [samples] into [destination] at zstd level [compression_level].
+POD5_FORMAT_EXPORT arrow::Result<std::size_t> compress_signal(
+    gsl::span<SampleType const> const & samples,
+    arrow::MemoryPool * pool,
+    gsl::span<std::uint8_t> const & destination,
+    int compression_level);
+
+/// \brief Compress [samples] into [destination] with [dictionary], at the dictionary's level.
+/// \note The signal can only be decompressed with the same dictionary.
+POD5_FORMAT_EXPORT arrow::Result<std::size_t> compress_signal(
+    gsl::span<SampleType const> const & samples,
+    arrow::MemoryPool * pool,
+    gsl::span<std::uint8_t> const & destination,
+    VbzDictionary const & dictionary);
+
+/// \brief Compress [samples] at zstd level [compression_level], or with [dictionary] if one is
+///        passed.
+POD5_FORMAT_EXPORT arrow::Result<std::shared_ptr<arrow::Buffer>> compress_signal(
+    gsl::span<SampleType const> const & samples,
+    arrow::MemoryPool * pool,
+    int compression_level,
+    VbzDictionary const * dictionary);
+
 POD5_FORMAT_EXPORT arrow::Result<std::shared_ptr<arrow::Buffer>> decompress_signal(
     gsl::span<std::uint8_t const> const & compressed_bytes,
     std::uint32_t samples_count,
@@ -35,4 +102,27 @@ POD5_FORMAT_EXPORT arrow::Status decompress_signal(
     arrow::MemoryPool * pool,
     gsl::span<std::int16_t> const & destination);
 
+/// \brief Decompress signal that may have been compressed with [dictionary].
+/// \details Signal compressed without a dictionary is also accepted, signal compressed with a
+///          dictionary other than [dictionary] (or with any dictionary, if it is null) is not.
+POD5_FORMAT_EXPORT arrow::Result<std::shared_ptr<arrow::Buffer>> decompress_signal(
+    gsl::span<std::uint8_t const> const & compressed_bytes,
+    std::uint32_t samples_count,
+    arrow::MemoryPool * pool,
+    VbzDictionary const * dictionary);
+
+POD5_FORMAT_EXPORT arrow::Status decompress_signal(
+    gsl::span<std::uint8_t const> const & compressed_bytes,
+    arrow::MemoryPool * pool,
+    gsl::span<std::int16_t> const & destination,
+    VbzDictionary const * dictionary);
+
+/// \brief Train a vbz dictionary of at most [max_size] bytes on the rows of [samples].
+/// \returns The dictionary data, or Invalid if zstd could not train on the signal given (eg. there
+///          was too little of it).
+POD5_FORMAT_EXPORT arrow::Result<std::shared_ptr<arrow::Buffer>> train_vbz_dictionary(
+    std::vector<gsl::span<SampleType const>> const & samples,
+    std::size_t max_size,
+    arrow::MemoryPool * pool);
+
 }  // namespace pod5
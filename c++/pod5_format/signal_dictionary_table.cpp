@@ -0,0 +1,81 @@
+#include "pod5_format/signal_dictionary_table.h"
+
+#include "pod5_format/schema_metadata.h"
+#include "pod5_format/signal_compression.h"
+
+#include <arrow/array/array_binary.h>
+#include <arrow/array/builder_binary.h>
+#include <arrow/io/interfaces.h>
+#include <arrow/ipc/reader.h>
+#include <arrow/ipc/writer.h>
+#include <arrow/record_batch.h>
+#include <arrow/type.h>
+
+namespace pod5 {
+
+namespace {
+char const * const DICTIONARY_FIELD_NAME = "dictionary";
+}
+
+Status write_signal_dictionary_table(
+    std::shared_ptr<arrow::io::OutputStream> const & sink,
+    std::shared_ptr<const arrow::KeyValueMetadata> const & metadata,
+    VbzDictionary const & dictionary,
+    arrow::MemoryPool * pool)
+{
+    auto schema =
+        arrow::schema({arrow::field(DICTIONARY_FIELD_NAME, arrow::large_binary())}, metadata);
+
+    arrow::LargeBinaryBuilder dictionary_builder(pool);
+    auto const & data = dictionary.data();
+    ARROW_RETURN_NOT_OK(dictionary_builder.Append(data->data(), data->size()));
+    ARROW_ASSIGN_OR_RAISE(auto dictionary_column, dictionary_builder.Finish());
+
+    arrow::ipc::IpcWriteOptions options;
+    options.memory_pool = pool;
+    ARROW_ASSIGN_OR_RAISE(auto writer, arrow::ipc::MakeFileWriter(sink, schema, options, metadata));
+
+    auto const record_batch = arrow::RecordBatch::Make(schema, 1, {dictionary_column});
+    ARROW_RETURN_NOT_OK(writer->WriteRecordBatch(*record_batch));
+    return writer->Close();
+}
+
+Result<std::shared_ptr<arrow::Buffer>> read_signal_dictionary_table(
+    std::shared_ptr<arrow::io::RandomAccessFile> const & input,
+    boost::uuids::uuid const & file_identifier,
+    arrow::MemoryPool * pool)
+{
+    arrow::ipc::IpcReadOptions options;
+    options.memory_pool = pool;
+    ARROW_ASSIGN_OR_RAISE(auto reader, arrow::ipc::RecordBatchFileReader::Open(input, options));
+
+    auto const schema = reader->schema();
+    if (!schema->metadata()) {
+        return Status::IOError("Missing metadata on signal dictionary table schema");
+    }
+    ARROW_ASSIGN_OR_RAISE(auto schema_metadata, read_schema_key_value_metadata(schema->metadata()));
+    if (schema_metadata.file_identifier != file_identifier) {
+        return Status::Invalid("Signal dictionary does not belong to this file");
+    }
+
+    auto const field_index = schema->GetFieldIndex(DICTIONARY_FIELD_NAME);
+    if (field_index < 0 || !schema->field(field_index)->type()->Equals(arrow::large_binary())) {
+        return Status::Invalid("Signal dictionary table has no dictionary column");
+    }
+    if (reader->num_record_batches() != 1) {
+        return Status::Invalid("Signal dictionary table must hold a single batch");
+    }
+
+    ARROW_ASSIGN_OR_RAISE(auto const record_batch, reader->ReadRecordBatch(0));
+    if (record_batch->num_rows() != 1) {
+        return Status::Invalid("Signal dictionary table must hold a single row");
+    }
+    auto const dictionary_column =
+        std::static_pointer_cast<arrow::LargeBinaryArray>(record_batch->column(field_index));
+    return arrow::SliceBuffer(
+        dictionary_column->value_data(),
+        dictionary_column->value_offset(0),
+        dictionary_column->value_length(0));
+}
+
+}  // namespace pod5
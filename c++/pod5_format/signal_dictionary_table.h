@@ -0,0 +1,38 @@
+#pragma once
+
+#include "pod5_format/pod5_format_export.h"
+#include "pod5_format/result.h"
+
+#include <arrow/io/type_fwd.h>
+#include <boost/uuid/uuid.hpp>
+
+#include <memory>
+
+namespace arrow {
+class Buffer;
+class KeyValueMetadata;
+class MemoryPool;
+}  // namespace arrow
+
+namespace pod5 {
+
+class VbzDictionary;
+
+/// \brief Write [dictionary] to [sink] as a signal dictionary table.
+/// \details The table holds a single row, with the dictionary data in its "dictionary" column. It
+///          is embedded in a file as a SignalDictionary.
+/// \param metadata Metadata of the file, applied to the table schema.
+POD5_FORMAT_EXPORT Status write_signal_dictionary_table(
+    std::shared_ptr<arrow::io::OutputStream> const & sink,
+    std::shared_ptr<const arrow::KeyValueMetadata> const & metadata,
+    VbzDictionary const & dictionary,
+    arrow::MemoryPool * pool);
+
+/// \brief Read the dictionary data from the signal dictionary table in [input].
+/// \param file_identifier The identifier of the file the dictionary is expected to belong to.
+POD5_FORMAT_EXPORT Result<std::shared_ptr<arrow::Buffer>> read_signal_dictionary_table(
+    std::shared_ptr<arrow::io::RandomAccessFile> const & input,
+    boost::uuids::uuid const & file_identifier,
+    arrow::MemoryPool * pool);
+
+}  // namespace pod5
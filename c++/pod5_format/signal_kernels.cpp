@@ -0,0 +1,363 @@
+#include "pod5_format/signal_kernels.h"
+
+#include "pod5_format/signal_compression.h"
+#include "pod5_format/svb16/common.hpp"
+#ifdef SVB16_X64
+#include "pod5_format/svb16/simd_detect_x64.hpp"
+#endif
+
+#include <arrow/buffer.h>
+#include <arrow/memory_pool.h>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/trim.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <limits>
+#include <mutex>
+#include <random>
+#include <vector>
+
+namespace pod5 {
+
+namespace {
+
+// Calibration times each kernel on this much signal, keeping the fastest of a few repeats:
+constexpr std::size_t CalibrationSampleCount = 64 * 1024;
+constexpr int CalibrationRepeats = 5;
+// Other kernels must beat the detected ones by this factor, so timing noise doesn't move off them:
+constexpr double DetectedKernelPreference = 0.95;
+
+char const * svb_kernel_name(SvbKernel kernel, bool decode)
+{
+    if (kernel == SvbKernel::Sse) {
+        return decode ? "sse4.1" : "ssse3";
+    }
+    return "scalar";
+}
+
+char const * zstd_mode_name(ZstdDecompressMode mode)
+{
+    return mode == ZstdDecompressMode::Streaming ? "streaming" : "one_shot";
+}
+
+SignalKernels detected_signal_kernels()
+{
+    SignalKernels kernels;
+    if (svb_kernel_available(SvbKernel::Sse)) {
+        kernels.svb16_decode = SvbKernel::Sse;
+        kernels.svb16_encode = SvbKernel::Sse;
+    }
+    return kernels;
+}
+
+/// Apply the kernels named in the environment over [kernels], if the variable is set.
+Result<SignalKernels> apply_environment(SignalKernels const & kernels, bool * applied)
+{
+    auto const description = std::getenv(SIGNAL_KERNELS_ENVIRONMENT_VARIABLE);
+    *applied = description && *description;
+    if (!*applied) {
+        return kernels;
+    }
+    auto const result = parse_signal_kernels(description, kernels);
+    if (!result.ok()) {
+        return Status::Invalid(
+            "Invalid ", SIGNAL_KERNELS_ENVIRONMENT_VARIABLE, ": ", result.status().message());
+    }
+    return result;
+}
+
+class KernelState {
+public:
+    KernelState()
+    {
+        auto kernels = detected_signal_kernels();
+        bool from_environment = false;
+        // An invalid variable is reported by calibrate_signal_kernels(), until then it's ignored:
+        auto const with_environment = apply_environment(kernels, &from_environment);
+        if (with_environment.ok()) {
+            kernels = *with_environment;
+        }
+        store(kernels);
+        m_source = from_environment && with_environment.ok() ? "environment" : "detected";
+    }
+
+    SignalKernels load() const
+    {
+        SignalKernels kernels;
+        kernels.svb16_decode = m_svb16_decode.load(std::memory_order_relaxed);
+        kernels.svb16_encode = m_svb16_encode.load(std::memory_order_relaxed);
+        kernels.zstd_decompress = m_zstd_decompress.load(std::memory_order_relaxed);
+        return kernels;
+    }
+
+    void store(SignalKernels const & kernels)
+    {
+        m_svb16_decode.store(kernels.svb16_decode, std::memory_order_relaxed);
+        m_svb16_encode.store(kernels.svb16_encode, std::memory_order_relaxed);
+        m_zstd_decompress.store(kernels.zstd_decompress, std::memory_order_relaxed);
+    }
+
+    SignalKernelSelection selection() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return {load(), m_source, m_timings};
+    }
+
+    void set_selection(SignalKernelSelection const & selection)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        store(selection.kernels);
+        m_source = selection.source;
+        m_timings = selection.timings;
+    }
+
+    // Held while calibrating, so an explicit choice isn't overwritten by a calibration under way:
+    std::mutex m_calibration_mutex;
+    // Calibration runs once per process, later requests are given its result:
+    std::once_flag m_calibration_once;
+    Result<SignalKernelSelection> m_calibration;
+
+private:
+    std::atomic<SvbKernel> m_svb16_decode;
+    std::atomic<SvbKernel> m_svb16_encode;
+    std::atomic<ZstdDecompressMode> m_zstd_decompress;
+
+    mutable std::mutex m_mutex;
+    std::string m_source;
+    std::map<std::string, double> m_timings;
+};
+
+KernelState & kernel_state()
+{
+    static KernelState state;
+    return state;
+}
+
+/// Find the fastest of [repeats] runs of [run] in nanoseconds per sample.
+template <typename Run>
+Result<double> time_kernel(Run && run)
+{
+    auto best = std::numeric_limits<double>::max();
+    for (int i = 0; i < CalibrationRepeats; ++i) {
+        auto const start = std::chrono::steady_clock::now();
+        ARROW_RETURN_NOT_OK(run());
+        auto const elapsed = std::chrono::duration<double, std::nano>(
+                                 std::chrono::steady_clock::now() - start)
+                                 .count();
+        best = std::min(best, elapsed / CalibrationSampleCount);
+    }
+    return best;
+}
+
+std::vector<std::int16_t> calibration_signal()
+{
+    // A level with noise, like real signal, so zstd and svb see typical data:
+    std::mt19937 gen(42);
+    std::normal_distribution<float> noise(0, 10);
+    std::vector<std::int16_t> signal(CalibrationSampleCount);
+    for (std::size_t i = 0; i < signal.size(); ++i) {
+        signal[i] = static_cast<std::int16_t>(500 + (i / 1000 % 8) * 25 + noise(gen));
+    }
+    return signal;
+}
+
+}  // namespace
+
+SignalKernels signal_kernels() { return kernel_state().load(); }
+
+SignalKernelSelection signal_kernel_selection() { return kernel_state().selection(); }
+
+bool svb_kernel_available(SvbKernel kernel)
+{
+    if (kernel == SvbKernel::Scalar) {
+        return true;
+    }
+#ifdef SVB16_X64
+    return has_sse4_1() && has_ssse3();
+#else
+    return false;
+#endif
+}
+
+namespace {
+
+/// Time the kernels on [state]'s behalf and use the fastest.
+Result<SignalKernelSelection> run_calibration(KernelState & state)
+{
+    std::lock_guard<std::mutex> calibration_lock(state.m_calibration_mutex);
+    auto const previous = state.load();
+
+    auto const pool = arrow::default_memory_pool();
+    auto const signal = calibration_signal();
+    std::vector<std::int16_t> decoded(signal.size());
+    ARROW_ASSIGN_OR_RAISE(auto compressed, compress_signal(gsl::make_span(signal), pool));
+    auto const compressed_span = gsl::make_span(compressed->data(), compressed->size());
+
+    std::vector<SvbKernel> svb_kernels{SvbKernel::Scalar};
+    if (svb_kernel_available(SvbKernel::Sse)) {
+        svb_kernels.push_back(SvbKernel::Sse);
+    }
+
+    // Each stage is timed in isolation, the others left at their detected kernels. Other threads
+    // compressing meanwhile run with the kernels under test, which all give the same results:
+    SignalKernelSelection selection;
+    selection.source = "calibrated";
+    auto & best = selection.kernels;
+    best = detected_signal_kernels();
+    auto const time_with = [&](SignalKernels const & kernels, bool decode) {
+        state.store(kernels);
+        return time_kernel([&]() -> Status {
+            if (decode) {
+                return decompress_signal(compressed_span, pool, gsl::make_span(decoded));
+            }
+            return compress_signal(gsl::make_span(signal), pool).status();
+        });
+    };
+    auto const record = [&](std::string const & key, Result<double> const & timing) -> Status {
+        if (!timing.ok()) {
+            state.store(previous);
+            return timing.status();
+        }
+        selection.timings[key] = *timing;
+        return Status::OK();
+    };
+
+    double best_time = std::numeric_limits<double>::max();
+    auto const detected = best;
+    for (auto kernel : svb_kernels) {
+        auto kernels = detected;
+        kernels.svb16_decode = kernel;
+        auto const timing = time_with(kernels, true);
+        ARROW_RETURN_NOT_OK(
+            record(std::string("svb16_decode=") + svb_kernel_name(kernel, true), timing));
+        auto const score = kernel == detected.svb16_decode ? *timing * DetectedKernelPreference
+                                                           : *timing;
+        if (score < best_time) {
+            best_time = score;
+            best.svb16_decode = kernel;
+        }
+    }
+
+    best_time = std::numeric_limits<double>::max();
+    for (auto kernel : svb_kernels) {
+        auto kernels = detected;
+        kernels.svb16_encode = kernel;
+        auto const timing = time_with(kernels, false);
+        ARROW_RETURN_NOT_OK(
+            record(std::string("svb16_encode=") + svb_kernel_name(kernel, false), timing));
+        auto const score = kernel == detected.svb16_encode ? *timing * DetectedKernelPreference
+                                                           : *timing;
+        if (score < best_time) {
+            best_time = score;
+            best.svb16_encode = kernel;
+        }
+    }
+
+    best_time = std::numeric_limits<double>::max();
+    for (auto mode : {ZstdDecompressMode::OneShot, ZstdDecompressMode::Streaming}) {
+        auto kernels = detected;
+        kernels.zstd_decompress = mode;
+        auto const timing = time_with(kernels, true);
+        ARROW_RETURN_NOT_OK(
+            record(std::string("zstd_decompress=") + zstd_mode_name(mode), timing));
+        auto const score = mode == detected.zstd_decompress ? *timing * DetectedKernelPreference
+                                                            : *timing;
+        if (score < best_time) {
+            best_time = score;
+            best.zstd_decompress = mode;
+        }
+    }
+
+    bool from_environment = false;
+    auto const with_environment = apply_environment(best, &from_environment);
+    if (!with_environment.ok()) {
+        state.set_selection(selection);
+        return with_environment.status();
+    }
+    if (from_environment) {
+        best = *with_environment;
+        selection.source = "environment";
+    }
+    state.set_selection(selection);
+    return selection;
+}
+
+}  // namespace
+
+Result<SignalKernelSelection> calibrate_signal_kernels()
+{
+    auto & state = kernel_state();
+    std::call_once(state.m_calibration_once, [&] { state.m_calibration = run_calibration(state); });
+    return state.m_calibration;
+}
+
+Status set_signal_kernels(SignalKernels const & kernels)
+{
+    if (!svb_kernel_available(kernels.svb16_decode)
+        || !svb_kernel_available(kernels.svb16_encode))
+    {
+        return Status::Invalid(
+            "Signal kernels ", format_signal_kernels(kernels), " are not available on this cpu");
+    }
+    auto & state = kernel_state();
+    std::lock_guard<std::mutex> calibration_lock(state.m_calibration_mutex);
+    state.set_selection({kernels, "explicit", {}});
+    return Status::OK();
+}
+
+std::string format_signal_kernels(SignalKernels const & kernels)
+{
+    return std::string("svb16_decode=") + svb_kernel_name(kernels.svb16_decode, true)
+           + ",svb16_encode=" + svb_kernel_name(kernels.svb16_encode, false)
+           + ",zstd_decompress=" + zstd_mode_name(kernels.zstd_decompress);
+}
+
+Result<SignalKernels> parse_signal_kernels(std::string const & description, SignalKernels kernels)
+{
+    std::vector<std::string> entries;
+    boost::algorithm::split(entries, description, [](char c) { return c == ',' || c == ' '; });
+    for (auto & entry : entries) {
+        boost::algorithm::trim(entry);
+        if (entry.empty()) {
+            continue;
+        }
+        auto const separator = entry.find('=');
+        if (separator == std::string::npos) {
+            return Status::Invalid("Expected <stage>=<kernel>, found '", entry, "'");
+        }
+        auto const stage = entry.substr(0, separator);
+        auto const kernel = entry.substr(separator + 1);
+
+        if (stage == "svb16_decode" || stage == "svb16_encode") {
+            SvbKernel svb_kernel;
+            if (kernel == "scalar") {
+                svb_kernel = SvbKernel::Scalar;
+            } else if (kernel == "sse" || kernel == "sse4.1" || kernel == "ssse3") {
+                svb_kernel = SvbKernel::Sse;
+            } else {
+                return Status::Invalid("Unknown ", stage, " kernel '", kernel, "'");
+            }
+            if (!svb_kernel_available(svb_kernel)) {
+                return Status::Invalid(
+                    stage, " kernel '", kernel, "' is not available on this cpu");
+            }
+            (stage == "svb16_decode" ? kernels.svb16_decode : kernels.svb16_encode) = svb_kernel;
+        } else if (stage == "zstd_decompress") {
+            if (kernel == "one_shot") {
+                kernels.zstd_decompress = ZstdDecompressMode::OneShot;
+            } else if (kernel == "streaming") {
+                kernels.zstd_decompress = ZstdDecompressMode::Streaming;
+            } else {
+                return Status::Invalid("Unknown zstd_decompress mode '", kernel, "'");
+            }
+        } else {
+            return Status::Invalid("Unknown signal kernel stage '", stage, "'");
+        }
+    }
+    return kernels;
+}
+
+}  // namespace pod5
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "pod5_format/pod5_format_export.h"
+#include "pod5_format/result.h"
+
+#include <map>
+#include <string>
+
+namespace pod5 {
+
+/// \brief Implementations of the svb16 stage of vbz signal compression.
+enum class SvbKernel {
+    Scalar,
+    /// SSE4.1 for decoding, SSSE3 for encoding, only available on x64 processors supporting them.
+    Sse,
+};
+
+/// \brief Ways of running the zstd stage of vbz signal decompression.
+enum class ZstdDecompressMode {
+    /// Decompress each row in a single call.
+    OneShot,
+    /// Decompress each row through the zstd streaming api.
+    Streaming,
+};
+
+/// \brief The kernels vbz signal is compressed and decompressed with.
+/// \details Every kernel produces the same output, they differ only in speed.
+struct SignalKernels {
+    SvbKernel svb16_decode = SvbKernel::Scalar;
+    SvbKernel svb16_encode = SvbKernel::Scalar;
+    ZstdDecompressMode zstd_decompress = ZstdDecompressMode::OneShot;
+
+    bool operator==(SignalKernels const & other) const
+    {
+        return svb16_decode == other.svb16_decode && svb16_encode == other.svb16_encode
+               && zstd_decompress == other.zstd_decompress;
+    }
+
+    bool operator!=(SignalKernels const & other) const { return !(*this == other); }
+};
+
+/// \brief The kernels in use, with how they were chosen.
+struct SignalKernelSelection {
+    SignalKernels kernels;
+    /// "detected" (picked from the cpu's features), "calibrated", "environment" or "explicit".
+    std::string source;
+    /// Nanoseconds per sample measured for each kernel on calibration, keyed as in
+    /// format_signal_kernels(), empty if no calibration has run.
+    std::map<std::string, double> timings;
+};
+
+/// \brief Environment variable overriding the kernels chosen, in the form given by
+///        format_signal_kernels(), eg. "svb16_decode=scalar,zstd_decompress=streaming".
+/// \note Kernels not named in the variable are chosen as usual.
+static constexpr char const * SIGNAL_KERNELS_ENVIRONMENT_VARIABLE = "POD5_SIGNAL_KERNELS";
+
+/// \brief Find the kernels in use.
+/// \details Until calibrate_signal_kernels() or set_signal_kernels() is called, the kernels are
+///          picked from the cpu's features, then overridden by the environment.
+POD5_FORMAT_EXPORT SignalKernels signal_kernels();
+
+/// \brief Find the kernels in use and how they were chosen.
+POD5_FORMAT_EXPORT SignalKernelSelection signal_kernel_selection();
+
+/// \brief Find if [kernel] can run on this cpu.
+POD5_FORMAT_EXPORT bool svb_kernel_available(SvbKernel kernel);
+
+/// \brief Time each available kernel on a short synthetic signal, then use the fastest, before
+///        applying any override from the environment.
+/// \details Takes a few milliseconds, pod5_init() runs it. Calibration runs once per process, as
+///          the kernels under test are used by any thread compressing signal meanwhile: later
+///          calls return the first call's result without changing the kernels in use.
+/// \returns The selection made, or Invalid if the environment variable can't be parsed (in
+///          which case the calibrated kernels are used).
+POD5_FORMAT_EXPORT Result<SignalKernelSelection> calibrate_signal_kernels();
+
+/// \brief Use [kernels], overriding any calibration or environment.
+/// \returns Invalid if a kernel can't run on this cpu.
+POD5_FORMAT_EXPORT Status set_signal_kernels(SignalKernels const & kernels);
+
+/// \brief Describe [kernels],
+///        eg. "svb16_decode=sse4.1,svb16_encode=ssse3,zstd_decompress=one_shot".
+POD5_FORMAT_EXPORT std::string format_signal_kernels(SignalKernels const & kernels);
+
+/// \brief Parse kernel names (as from format_signal_kernels()) over [kernels], leaving those not
+///        named unchanged.
+POD5_FORMAT_EXPORT Result<SignalKernels> parse_signal_kernels(
+    std::string const & description,
+    SignalKernels kernels);
+
+}  // namespace pod5
@@ -0,0 +1,561 @@
+#include "pod5_format/signal_server.h"
+
+#include "pod5_format/async_signal_loader.h"
+#include "pod5_format/decoded_signal_cache.h"
+#include "pod5_format/read_batch_view.h"
+#include "pod5_format/read_table_utils.h"
+#include "pod5_format/schema_metadata.h"
+#include "pod5_format/signal_server_protocol.h"
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#endif
+
+namespace pod5 {
+
+namespace {
+
+template <typename T>
+void append_bytes(std::vector<std::uint8_t> & output, T const & value)
+{
+    auto const bytes = reinterpret_cast<std::uint8_t const *>(&value);
+    output.insert(output.end(), bytes, bytes + sizeof(T));
+}
+
+/// A reply to send, the samples it refers to are owned by the loaded signal batch.
+struct Reply {
+    std::vector<std::uint8_t> head;
+    std::unique_ptr<CachedBatchSignalData> signal;
+    std::vector<gsl::span<std::uint8_t const>> samples;
+
+    std::vector<gsl::span<std::uint8_t const>> payload() const
+    {
+        std::vector<gsl::span<std::uint8_t const>> result{gsl::make_span(head)};
+        result.insert(result.end(), samples.begin(), samples.end());
+        return result;
+    }
+};
+
+SignalServerRead make_read(LatestReadBatchView const & view, std::size_t row)
+{
+    SignalServerRead read{};
+    std::memcpy(read.read_id, view.read_id(row).data, sizeof(read.read_id));
+    read.start_sample = view.start_sample(row);
+    read.num_samples = view.num_samples(row);
+    read.num_minknow_events = view.num_minknow_events(row);
+    read.read_number = view.read_number(row);
+    read.channel = view.channel(row);
+    read.well = view.well(row);
+    read.median_before = view.median_before(row);
+    read.calibration_offset = view.calibration_offset(row);
+    read.calibration_scale = view.calibration_scale(row);
+    read.tracked_scaling_scale = view.tracked_scaling_scale(row);
+    read.tracked_scaling_shift = view.tracked_scaling_shift(row);
+    read.predicted_scaling_scale = view.predicted_scaling_scale(row);
+    read.predicted_scaling_shift = view.predicted_scaling_shift(row);
+    read.num_reads_since_mux_change = view.num_reads_since_mux_change(row);
+    read.time_since_mux_change = view.time_since_mux_change(row);
+    return read;
+}
+
+}  // namespace
+
+struct SignalServer::OpenFile {
+    std::string path;
+    std::shared_ptr<FileReader> reader;
+    std::uint64_t read_count = 0;
+    // Number of client handles to the file, guarded by m_files_mutex:
+    std::size_t users = 0;
+    bool idle = false;
+    std::list<std::string>::iterator idle_position;
+};
+
+/// A client's connection, served on its own thread.
+class SignalServer::Connection {
+public:
+    Connection(SignalServer & server, int socket)
+    : m_server(server)
+    , m_socket(socket)
+    , m_thread([this] { serve(); })
+    {
+    }
+
+    ~Connection()
+    {
+        m_thread.join();
+        for (auto const & file : m_files) {
+            if (file) {
+                m_server.release_file(file);
+            }
+        }
+#ifdef __linux__
+        close(m_socket);
+#endif
+    }
+
+    bool finished() const { return m_finished; }
+
+private:
+    void serve()
+    {
+#ifdef __linux__
+        while (!m_server.m_stopping) {
+            pollfd poll_fds[] = {{m_socket, POLLIN, 0}, {m_server.m_stop_read, POLLIN, 0}};
+            if (poll(poll_fds, 2, -1) < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                break;
+            }
+            if (poll_fds[1].revents) {
+                break;
+            }
+
+            auto request =
+                signal_server::receive_message(m_socket, signal_server::MAX_INLINE_REQUEST_SIZE);
+            if (!request.ok() || !*request) {
+                break;
+            }
+            if (!serve_request(**request).ok()) {
+                break;
+            }
+        }
+#endif
+        m_finished = true;
+    }
+
+    Status serve_request(signal_server::Message const & request)
+    {
+        auto const status = send_replies(request);
+        if (!m_send_status.ok()) {
+            // The connection failed, there is no way to report it to the client:
+            return m_send_status;
+        }
+        if (!status.ok()) {
+            return signal_server::send_error(m_socket, request.header.type, status);
+        }
+        return Status::OK();
+    }
+
+    /// Send [reply] to a request of [type], flagged if more replies to the request follow it.
+    Status send_reply(signal_server::MessageType type, Reply const & reply, bool more_replies)
+    {
+        signal_server::MessageHeader header;
+        header.type = type;
+        if (more_replies) {
+            header.flags = signal_server::MessageHeader::MORE_REPLIES;
+        }
+        auto const payload = reply.payload();
+        m_send_status = signal_server::send_message(
+            m_socket, header, payload, m_server.m_options.file_payload_size);
+        return m_send_status;
+    }
+
+    Status send_replies(signal_server::Message const & request)
+    {
+        auto const type = request.header.type;
+        auto const payload = request.payload.data();
+        switch (type) {
+        case signal_server::MessageType::OpenFile: {
+            ARROW_ASSIGN_OR_RAISE(
+                auto const reply, open_file(std::string(payload.begin(), payload.end())));
+            return send_reply(type, reply, false);
+        }
+        case signal_server::MessageType::CloseFile: {
+            ARROW_ASSIGN_OR_RAISE(auto const file, find_file(payload));
+            m_server.release_file(m_files[file]);
+            m_files[file] = nullptr;
+            return send_reply(type, Reply{}, false);
+        }
+        case signal_server::MessageType::GetReads:
+            return send_reads(payload, type, false);
+        case signal_server::MessageType::GetSignal:
+            return send_reads(payload, type, true);
+        }
+        return Status::Invalid("Unknown request type ", int(type));
+    }
+
+    Result<Reply> open_file(std::string const & path)
+    {
+        ARROW_ASSIGN_OR_RAISE(auto const file, m_server.open_file(path));
+
+        auto const free_handle = std::find(m_files.begin(), m_files.end(), nullptr);
+        auto const handle = std::size_t(free_handle - m_files.begin());
+        if (free_handle == m_files.end()) {
+            m_files.push_back(file);
+        } else {
+            *free_handle = file;
+        }
+
+        signal_server::OpenFileReply open_reply{};
+        open_reply.file = std::uint32_t(handle);
+        open_reply.read_count = file->read_count;
+        auto const file_identifier = file->reader->schema_metadata().file_identifier;
+        std::memcpy(
+            open_reply.file_identifier, file_identifier.data, sizeof(open_reply.file_identifier));
+
+        Reply reply;
+        append_bytes(reply.head, open_reply);
+        return reply;
+    }
+
+    /// Find the handle a request names, checking it is open.
+    Result<std::size_t> find_file(gsl::span<std::uint8_t const> payload) const
+    {
+        if (payload.size() < sizeof(signal_server::FileRequest)) {
+            return Status::Invalid("Request is too short");
+        }
+        signal_server::FileRequest file_request;
+        std::memcpy(&file_request, payload.data(), sizeof(file_request));
+        if (file_request.file >= m_files.size() || !m_files[file_request.file]) {
+            return Status::Invalid("File ", file_request.file, " is not open");
+        }
+        return file_request.file;
+    }
+
+    /// Send a reply for each read batch holding requested reads, releasing each batch's signal
+    /// once it is sent so only the batches the loader is working on are held at once.
+    Status send_reads(
+        gsl::span<std::uint8_t const> payload,
+        signal_server::MessageType type,
+        bool with_samples)
+    {
+        ARROW_ASSIGN_OR_RAISE(auto const file, find_file(payload));
+        auto const & reader = m_files[file]->reader;
+
+        signal_server::FileRequest file_request;
+        std::memcpy(&file_request, payload.data(), sizeof(file_request));
+        auto const read_ids = payload.subspan(sizeof(file_request));
+        if (file_request.read_id_count > read_ids.size()
+            || read_ids.size() != file_request.read_id_count * sizeof(boost::uuids::uuid))
+        {
+            return Status::Invalid("Request read id count doesn't match its size");
+        }
+
+        // Find the rows to visit, or visit every row if no read ids were given:
+        auto const batch_count = reader->num_read_record_batches();
+        ReadTraversalPlan plan;
+        if (file_request.read_id_count > 0) {
+            plan.batch_counts.resize(batch_count);
+            plan.batch_rows.resize(file_request.read_id_count);
+            ARROW_ASSIGN_OR_RAISE(
+                auto const found_count,
+                reader->search_for_read_ids(
+                    ReadIdSearchInput(gsl::make_span(
+                        reinterpret_cast<boost::uuids::uuid const *>(read_ids.data()),
+                        file_request.read_id_count)),
+                    gsl::make_span(plan.batch_counts),
+                    gsl::make_span(plan.batch_rows)));
+            plan.batch_rows.resize(found_count);
+        }
+
+        if (batch_count == 0 || (file_request.read_id_count > 0 && plan.batch_rows.empty())) {
+            Reply reply;
+            append_bytes(reply.head, signal_server::ReadsReply{});
+            return send_reply(type, reply, false);
+        }
+
+        // Every batch is replied to when visiting the whole file, otherwise those holding rows:
+        auto last_batch = batch_count - 1;
+        while (!plan.batch_counts.empty() && plan.batch_counts[last_batch] == 0) {
+            last_batch -= 1;
+        }
+
+        std::unique_ptr<AsyncSignalLoader> loader;
+        if (with_samples) {
+            auto const row_count =
+                plan.batch_counts.empty() ? m_files[file]->read_count : plan.read_count();
+            auto const worker_count = std::max<std::size_t>(
+                1,
+                std::min<std::size_t>(
+                    m_server.m_options.worker_count,
+                    row_count / AsyncSignalLoader::MINIMUM_JOB_SIZE + 1));
+            loader = std::make_unique<AsyncSignalLoader>(
+                reader,
+                AsyncSignalLoader::SamplesMode::Samples,
+                plan.batch_counts,
+                plan.batch_rows,
+                worker_count);
+        }
+
+        std::size_t batch_rows_offset = 0;
+        for (std::size_t batch = 0; batch <= last_batch; ++batch) {
+            Reply reply;
+            if (loader) {
+                ARROW_ASSIGN_OR_RAISE(reply.signal, loader->release_next_batch());
+                if (!reply.signal || reply.signal->batch_index() != batch) {
+                    return Status::Invalid("Signal for read batch ", batch, " was not loaded");
+                }
+            }
+            if (!plan.batch_counts.empty() && plan.batch_counts[batch] == 0) {
+                continue;
+            }
+
+            ARROW_ASSIGN_OR_RAISE(auto const read_batch, reader->read_read_record_batch(batch));
+            ARROW_ASSIGN_OR_RAISE(auto const view, LatestReadBatchView::make(read_batch));
+
+            // Rows loaded from this batch, in the order the loader visits them:
+            auto const row_count =
+                plan.batch_counts.empty() ? view.num_rows() : plan.batch_counts[batch];
+            auto const row = [&](std::size_t i) -> std::size_t {
+                return plan.batch_counts.empty() ? i : plan.batch_rows[batch_rows_offset + i];
+            };
+
+            signal_server::ReadsReply reads_reply{};
+            append_bytes(reply.head, reads_reply);
+            for (std::size_t i = 0; i < row_count; ++i) {
+                auto read = make_read(view, row(i));
+                if (reply.signal) {
+                    auto const & samples = reply.signal->samples()[i];
+                    read.num_samples = samples.size();
+                    read.sample_offset = reads_reply.sample_count;
+                    reads_reply.sample_count += samples.size();
+                    reply.samples.push_back(gsl::make_span(
+                        reinterpret_cast<std::uint8_t const *>(samples.data()),
+                        samples.size() * sizeof(std::int16_t)));
+                }
+                append_bytes(reply.head, read);
+                reads_reply.read_count += 1;
+            }
+            batch_rows_offset += row_count;
+
+            std::memcpy(reply.head.data(), &reads_reply, sizeof(reads_reply));
+            ARROW_RETURN_NOT_OK(send_reply(type, reply, batch != last_batch));
+        }
+        return Status::OK();
+    }
+
+    SignalServer & m_server;
+    int m_socket;
+    // Files the client has open, indexed by handle, null where closed:
+    std::vector<std::shared_ptr<OpenFile>> m_files;
+    // Set once sending a reply fails, after which the connection is closed:
+    Status m_send_status;
+    std::atomic<bool> m_finished{false};
+    std::thread m_thread;
+};
+
+Result<std::unique_ptr<SignalServer>> SignalServer::create(SignalServerOptions const & options)
+{
+#ifdef __linux__
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    auto const & path = options.socket_path;
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        return Status::Invalid("Invalid signal server socket path '", path, "'");
+    }
+    std::memcpy(address.sun_path, path.data(), path.size());
+    if (options.file_payload_size > signal_server::MAX_INLINE_REPLY_SIZE) {
+        return Status::Invalid(
+            "Signal server file payload size must be at most ",
+            signal_server::MAX_INLINE_REPLY_SIZE,
+            " bytes");
+    }
+
+    // Replace a socket left by a server which didn't exit cleanly, but nothing else:
+    struct stat path_stat;
+    if (lstat(path.c_str(), &path_stat) == 0) {
+        if (!S_ISSOCK(path_stat.st_mode)) {
+            return Status::Invalid("Signal server socket path '", path, "' is not a socket");
+        }
+        unlink(path.c_str());
+    }
+
+    int const listen_socket = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listen_socket < 0) {
+        return Status::IOError("Failed to create socket: ", std::strerror(errno));
+    }
+    // Restrict who may connect before listening, so no client can connect in between:
+    if (bind(listen_socket, reinterpret_cast<sockaddr const *>(&address), sizeof(address)) != 0
+        || chmod(path.c_str(), mode_t(options.socket_permissions)) != 0
+        || listen(listen_socket, SOMAXCONN) != 0)
+    {
+        auto const status = Status::IOError(
+            "Failed to listen on '", path, "': ", std::strerror(errno));
+        close(listen_socket);
+        return status;
+    }
+
+    int stop_pipe[2];
+    if (pipe2(stop_pipe, O_CLOEXEC | O_NONBLOCK) != 0) {
+        auto const status = Status::IOError("Failed to create pipe: ", std::strerror(errno));
+        close(listen_socket);
+        unlink(path.c_str());
+        return status;
+    }
+
+    auto server_options = options;
+    if (server_options.decoded_signal_cache_bytes > 0
+        && !server_options.reader_options.decoded_signal_cache())
+    {
+        server_options.reader_options.set_decoded_signal_cache(
+            std::make_shared<DecodedSignalCache>(server_options.decoded_signal_cache_bytes));
+    }
+    return std::unique_ptr<SignalServer>(
+        new SignalServer(server_options, listen_socket, stop_pipe));
+#else
+    (void)options;
+    return Status::NotImplemented("Signal servers are only supported on Linux");
+#endif
+}
+
+SignalServer::SignalServer(SignalServerOptions const & options, int listen_socket, int stop_pipe[2])
+: m_options(options)
+, m_listen_socket(listen_socket)
+, m_stop_read(stop_pipe[0])
+, m_stop_write(stop_pipe[1])
+{
+}
+
+SignalServer::~SignalServer()
+{
+    stop();
+    m_connections.clear();
+#ifdef __linux__
+    close(m_listen_socket);
+    unlink(m_options.socket_path.c_str());
+    close(m_stop_read);
+    close(m_stop_write);
+#endif
+}
+
+Status SignalServer::run()
+{
+#ifdef __linux__
+    Status status;
+    while (!m_stopping) {
+        pollfd poll_fds[] = {{m_listen_socket, POLLIN, 0}, {m_stop_read, POLLIN, 0}};
+        if (poll(poll_fds, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            status = Status::IOError("Failed to wait for clients: ", std::strerror(errno));
+            break;
+        }
+        if (poll_fds[1].revents) {
+            break;
+        }
+
+        int const client_socket = accept4(m_listen_socket, nullptr, nullptr, SOCK_CLOEXEC);
+        if (client_socket < 0) {
+            if (errno == EINTR || errno == ECONNABORTED || errno == EMFILE || errno == ENFILE) {
+                continue;
+            }
+            status = Status::IOError("Failed to accept client: ", std::strerror(errno));
+            break;
+        }
+
+        std::lock_guard<std::mutex> lock(m_connections_mutex);
+        m_connections.remove_if([](auto const & connection) { return connection->finished(); });
+        m_connections.push_back(std::make_unique<Connection>(*this, client_socket));
+    }
+
+    // Connections see the stop pipe and finish their current request:
+    stop();
+    std::lock_guard<std::mutex> lock(m_connections_mutex);
+    m_connections.clear();
+    return status;
+#else
+    return Status::NotImplemented("Signal servers are only supported on Linux");
+#endif
+}
+
+void SignalServer::stop()
+{
+    m_stopping = true;
+#ifdef __linux__
+    // The pipe is never drained, so it stays readable for every waiting thread:
+    char const byte = 0;
+    auto const result = write(m_stop_write, &byte, 1);
+    (void)result;
+#endif
+}
+
+std::size_t SignalServer::open_file_count() const
+{
+    std::lock_guard<std::mutex> lock(m_files_mutex);
+    return m_files.size();
+}
+
+Result<std::shared_ptr<SignalServer::OpenFile>> SignalServer::open_file(std::string const & path)
+{
+#ifdef __linux__
+    // Key files by their resolved path, so each file is only opened once:
+    char resolved_path[PATH_MAX];
+    if (!realpath(path.c_str(), resolved_path)) {
+        return Status::IOError("Failed to find file '", path, "': ", std::strerror(errno));
+    }
+    std::string const key = resolved_path;
+
+    auto const find_open_file = [&]() -> std::shared_ptr<OpenFile> {
+        auto const it = m_files.find(key);
+        if (it == m_files.end()) {
+            return nullptr;
+        }
+        auto const & file = it->second;
+        if (file->idle) {
+            m_idle_files.erase(file->idle_position);
+            file->idle = false;
+        }
+        file->users += 1;
+        return file;
+    };
+
+    {
+        std::lock_guard<std::mutex> lock(m_files_mutex);
+        if (auto file = find_open_file()) {
+            return file;
+        }
+    }
+
+    // Open the file without holding the lock, other clients' files stay available:
+    auto file = std::make_shared<OpenFile>();
+    file->path = key;
+    ARROW_ASSIGN_OR_RAISE(file->reader, open_file_reader(key, m_options.reader_options));
+    ARROW_ASSIGN_OR_RAISE(file->read_count, file->reader->read_count());
+
+    std::lock_guard<std::mutex> lock(m_files_mutex);
+    if (auto existing_file = find_open_file()) {
+        // Another client opened the file meanwhile:
+        return existing_file;
+    }
+    file->users = 1;
+    m_files[key] = file;
+    return file;
+#else
+    (void)path;
+    return Status::NotImplemented("Signal servers are only supported on Linux");
+#endif
+}
+
+void SignalServer::release_file(std::shared_ptr<OpenFile> const & file)
+{
+    std::lock_guard<std::mutex> lock(m_files_mutex);
+    file->users -= 1;
+    if (file->users > 0) {
+        return;
+    }
+
+    file->idle = true;
+    file->idle_position = m_idle_files.insert(m_idle_files.end(), file->path);
+    while (m_idle_files.size() > m_options.max_idle_files) {
+        auto const & oldest = m_files[m_idle_files.front()];
+        oldest->idle = false;
+        m_files.erase(m_idle_files.front());
+        m_idle_files.pop_front();
+    }
+}
+
+}  // namespace pod5
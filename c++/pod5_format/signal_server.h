@@ -0,0 +1,101 @@
+#pragma once
+
+#include "pod5_format/file_reader.h"
+#include "pod5_format/pod5_format_export.h"
+#include "pod5_format/result.h"
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace pod5 {
+
+class DecodedSignalCache;
+
+struct SignalServerOptions {
+    /// Path of the Unix domain socket to listen on, replaced if it exists.
+    std::string socket_path;
+    /// Bytes of decoded samples to cache, shared by every file served. 0 disables the cache
+    /// (unless reader_options sets one).
+    std::size_t decoded_signal_cache_bytes = 1024 * 1024 * 1024;
+    /// Workers decoding each request's signal.
+    std::size_t worker_count = std::thread::hardware_concurrency();
+    /// Files kept open once no client has them open, so they can be reopened without reading
+    /// their footer and indexes again.
+    std::size_t max_idle_files = 256;
+    /// Replies of at least this many bytes are passed in a memfd rather than through the socket,
+    /// at most signal_server::MAX_INLINE_REPLY_SIZE.
+    std::uint64_t file_payload_size = 256 * 1024;
+    /// Permissions of the socket, by default only processes running as the server's user may
+    /// connect (see SignalServer).
+    std::uint32_t socket_permissions = 0600;
+    FileReaderOptions reader_options;
+};
+
+/// \brief Serves read metadata and signal from pod5 files to local processes, over a Unix
+///        domain socket (see signal_server_protocol.h and SignalClient).
+/// \details Files are opened once and shared by every client, and stay open for a while after
+///          they are closed, with a decoded signal cache shared by all of them. Each client
+///          connection is served by its own thread, the signal for each request is decoded by
+///          an AsyncSignalLoader and sent a read batch at a time.
+///
+///          Clients are trusted with the server's own access: any process able to connect can
+///          read every file the server can. Connections aren't authenticated, access is only
+///          limited by the socket's permissions (SignalServerOptions::socket_permissions), so
+///          widen them only to users trusted with all of the server's files.
+class POD5_FORMAT_EXPORT SignalServer {
+public:
+    /// \brief Create a server listening on options.socket_path.
+    /// \note Only supported on Linux.
+    static Result<std::unique_ptr<SignalServer>> create(SignalServerOptions const & options);
+
+    /// \brief Stop the server, closing every connection and removing the socket.
+    ~SignalServer();
+
+    SignalServer(SignalServer const &) = delete;
+    SignalServer & operator=(SignalServer const &) = delete;
+
+    std::string const & socket_path() const { return m_options.socket_path; }
+
+    /// \brief Accept and serve clients until stop() is called.
+    Status run();
+
+    /// \brief Make run() return, disconnecting all clients.
+    /// \note Safe to call from any thread, and from a signal handler.
+    void stop();
+
+    /// \brief Find the number of files open, in use by a client or idle.
+    std::size_t open_file_count() const;
+
+private:
+    class Connection;
+    struct OpenFile;
+
+    SignalServer(SignalServerOptions const & options, int listen_socket, int stop_pipe[2]);
+
+    Result<std::shared_ptr<OpenFile>> open_file(std::string const & path);
+    void release_file(std::shared_ptr<OpenFile> const & file);
+
+    SignalServerOptions m_options;
+    int m_listen_socket;
+    int m_stop_read;
+    int m_stop_write;
+    std::atomic<bool> m_stopping{false};
+
+    std::mutex m_connections_mutex;
+    std::list<std::unique_ptr<Connection>> m_connections;
+
+    mutable std::mutex m_files_mutex;
+    // Open files by their resolved path:
+    std::unordered_map<std::string, std::shared_ptr<OpenFile>> m_files;
+    // Files no client has open, least recently closed first:
+    std::list<std::string> m_idle_files;
+};
+
+}  // namespace pod5
@@ -0,0 +1,349 @@
+#include "pod5_format/signal_server_protocol.h"
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <climits>
+#endif
+
+#include <vector>
+
+namespace pod5 { namespace signal_server {
+
+namespace {
+
+#ifdef __linux__
+/// Seals a payload file must carry, so its sender can't change it while the receiver reads it.
+constexpr int PAYLOAD_FILE_SEALS = F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE;
+
+/// Descriptors a message may carry beyond the one expected, room for them lets them be closed.
+constexpr std::size_t MAX_RECEIVED_FDS = 8;
+
+Status errno_status(char const * action)
+{
+    return Status::IOError("Failed to ", action, ": ", std::strerror(errno));
+}
+
+/// Send all of [iov], retrying partial sends, with [control] attached to the first byte.
+Status send_all(int socket, std::vector<iovec> iov, void * control, std::size_t control_size)
+{
+    std::size_t first = 0;
+    while (first < iov.size()) {
+        msghdr message{};
+        message.msg_iov = iov.data() + first;
+        message.msg_iovlen = std::min<std::size_t>(iov.size() - first, IOV_MAX);
+        message.msg_control = control;
+        message.msg_controllen = control_size;
+
+        auto sent = sendmsg(socket, &message, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return errno_status("send message");
+        }
+        control = nullptr;
+        control_size = 0;
+
+        while (first < iov.size() && std::size_t(sent) >= iov[first].iov_len) {
+            sent -= iov[first].iov_len;
+            ++first;
+        }
+        if (first < iov.size()) {
+            iov[first].iov_base = static_cast<char *>(iov[first].iov_base) + sent;
+            iov[first].iov_len -= sent;
+        }
+    }
+    return Status::OK();
+}
+
+/// Receive exactly [size] bytes, or none if the peer closed the socket first.
+Result<bool> receive_all(int socket, void * data, std::size_t size)
+{
+    std::size_t received = 0;
+    while (received < size) {
+        auto const count = recv(socket, static_cast<char *>(data) + received, size - received, 0);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return errno_status("receive message");
+        }
+        if (count == 0) {
+            if (received == 0) {
+                return false;
+            }
+            return Status::IOError("Connection closed part way through a message");
+        }
+        received += count;
+    }
+    return true;
+}
+
+Result<MessagePayload> map_payload_file(int fd, std::uint64_t size)
+{
+    auto const seals = fcntl(fd, F_GET_SEALS);
+    if (seals < 0 || (seals & PAYLOAD_FILE_SEALS) != PAYLOAD_FILE_SEALS) {
+        return Status::IOError("Message payload file is not sealed");
+    }
+
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0) {
+        return errno_status("find the size of message payload");
+    }
+    if (size == 0 || std::uint64_t(file_stat.st_size) < size) {
+        return Status::IOError("Message payload file is smaller than its header claims");
+    }
+    auto const mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        return errno_status("map message payload");
+    }
+    return MessagePayload(mapping, size);
+}
+#endif
+
+}  // namespace
+
+MessagePayload::MessagePayload(std::vector<std::uint8_t> && data) : m_data(std::move(data)) {}
+
+MessagePayload::MessagePayload(void const * mapping, std::size_t size)
+: m_mapping(mapping)
+, m_mapping_size(size)
+{
+}
+
+MessagePayload::~MessagePayload() { release(); }
+
+MessagePayload::MessagePayload(MessagePayload && other) { *this = std::move(other); }
+
+MessagePayload & MessagePayload::operator=(MessagePayload && other)
+{
+    if (this != &other) {
+        release();
+        m_data = std::move(other.m_data);
+        m_mapping = other.m_mapping;
+        m_mapping_size = other.m_mapping_size;
+        other.m_mapping = nullptr;
+        other.m_mapping_size = 0;
+    }
+    return *this;
+}
+
+gsl::span<std::uint8_t const> MessagePayload::data() const
+{
+    if (m_mapping) {
+        return gsl::make_span(static_cast<std::uint8_t const *>(m_mapping), m_mapping_size);
+    }
+    return gsl::make_span(m_data);
+}
+
+void MessagePayload::release()
+{
+#ifdef __linux__
+    if (m_mapping) {
+        munmap(const_cast<void *>(m_mapping), m_mapping_size);
+    }
+#endif
+    m_mapping = nullptr;
+    m_mapping_size = 0;
+}
+
+Status send_message(
+    int socket,
+    MessageHeader header,
+    gsl::span<gsl::span<std::uint8_t const> const> payload,
+    std::uint64_t file_payload_size)
+{
+#ifdef __linux__
+    header.payload_size = 0;
+    for (auto const & part : payload) {
+        header.payload_size += part.size();
+    }
+    header.flags &= ~MessageHeader::PAYLOAD_IN_FILE;
+
+    std::vector<iovec> iov;
+    iov.push_back({&header, sizeof(header)});
+    if (header.payload_size == 0 || header.payload_size < file_payload_size) {
+        for (auto const & part : payload) {
+            if (!part.empty()) {
+                iov.push_back({const_cast<std::uint8_t *>(part.data()), part.size()});
+            }
+        }
+        return send_all(socket, std::move(iov), nullptr, 0);
+    }
+
+    // Write the payload to a memfd, the receiver maps it rather than reading it from the socket:
+    int const fd = memfd_create("pod5_signal_server_payload", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd < 0) {
+        return errno_status("create message payload file");
+    }
+    auto fd_closer = gsl::finally([fd] { close(fd); });
+    if (ftruncate(fd, off_t(header.payload_size)) != 0) {
+        return errno_status("size message payload file");
+    }
+    auto const mapping =
+        mmap(nullptr, header.payload_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        return errno_status("map message payload file");
+    }
+    auto output = static_cast<std::uint8_t *>(mapping);
+    for (auto const & part : payload) {
+        std::memcpy(output, part.data(), part.size());
+        output += part.size();
+    }
+    munmap(mapping, header.payload_size);
+    if (fcntl(fd, F_ADD_SEALS, PAYLOAD_FILE_SEALS) != 0) {
+        return errno_status("seal message payload file");
+    }
+
+    header.flags |= MessageHeader::PAYLOAD_IN_FILE;
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+    auto const control_message = reinterpret_cast<cmsghdr *>(control);
+    control_message->cmsg_level = SOL_SOCKET;
+    control_message->cmsg_type = SCM_RIGHTS;
+    control_message->cmsg_len = CMSG_LEN(sizeof(int));
+    std::memcpy(CMSG_DATA(control_message), &fd, sizeof(int));
+    return send_all(socket, std::move(iov), control, sizeof(control));
+#else
+    (void)socket;
+    (void)header;
+    (void)payload;
+    (void)file_payload_size;
+    return Status::NotImplemented("Signal servers are only supported on Linux");
+#endif
+}
+
+Status send_error(int socket, MessageType type, Status const & status)
+{
+    MessageHeader header;
+    header.type = type;
+    header.status_code = std::uint32_t(status.code());
+    auto const & message = status.message();
+    gsl::span<std::uint8_t const> const payload[] = {gsl::make_span(
+        reinterpret_cast<std::uint8_t const *>(message.data()), message.size())};
+    return send_message(socket, header, payload);
+}
+
+Result<std::unique_ptr<Message>> receive_message(int socket, std::uint64_t max_inline_payload_size)
+{
+#ifdef __linux__
+    auto message = std::make_unique<Message>();
+    auto & header = message->header;
+
+    // Any payload file arrives with the first byte of the header:
+    alignas(cmsghdr) char control[CMSG_SPACE(MAX_RECEIVED_FDS * sizeof(int))] = {};
+    iovec iov{&header, sizeof(header)};
+    msghdr socket_message{};
+    socket_message.msg_iov = &iov;
+    socket_message.msg_iovlen = 1;
+    socket_message.msg_control = control;
+    socket_message.msg_controllen = sizeof(control);
+
+    ssize_t received = 0;
+    do {
+        received = recvmsg(socket, &socket_message, MSG_CMSG_CLOEXEC);
+    } while (received < 0 && errno == EINTR);
+    if (received < 0) {
+        return errno_status("receive message");
+    }
+    if (received == 0) {
+        return nullptr;
+    }
+
+    // Every descriptor received is now open in this process, close them all whatever happens:
+    std::vector<int> received_fds;
+    for (auto control_message = CMSG_FIRSTHDR(&socket_message); control_message;
+         control_message = CMSG_NXTHDR(&socket_message, control_message))
+    {
+        if (control_message->cmsg_level == SOL_SOCKET && control_message->cmsg_type == SCM_RIGHTS) {
+            auto const fd_count = (control_message->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+            for (std::size_t i = 0; i < fd_count; ++i) {
+                int fd = -1;
+                std::memcpy(&fd, CMSG_DATA(control_message) + i * sizeof(int), sizeof(int));
+                received_fds.push_back(fd);
+            }
+        }
+    }
+    auto fd_closer = gsl::finally([&received_fds] {
+        for (auto const fd : received_fds) {
+            close(fd);
+        }
+    });
+    if (socket_message.msg_flags & MSG_CTRUNC) {
+        return Status::IOError("Received a message with truncated control data");
+    }
+    if (received_fds.size() > 1) {
+        return Status::IOError("Received a message with more than one payload file");
+    }
+
+    if (std::size_t(received) < sizeof(header)) {
+        ARROW_ASSIGN_OR_RAISE(
+            auto const complete,
+            receive_all(
+                socket,
+                reinterpret_cast<char *>(&header) + received,
+                sizeof(header) - received));
+        if (!complete) {
+            return Status::IOError("Connection closed part way through a message");
+        }
+    }
+
+    if (header.magic != PROTOCOL_MAGIC || header.version != PROTOCOL_VERSION) {
+        return Status::IOError("Received a message from an incompatible signal server protocol");
+    }
+
+    if (header.flags & MessageHeader::PAYLOAD_IN_FILE) {
+        if (received_fds.empty()) {
+            return Status::IOError("Received a message without its payload file");
+        }
+        if (header.payload_size > MAX_PAYLOAD_SIZE) {
+            return Status::IOError(
+                "Received a message payload file of ", header.payload_size, " bytes");
+        }
+        ARROW_ASSIGN_OR_RAISE(
+            message->payload, map_payload_file(received_fds.front(), header.payload_size));
+    } else if (!received_fds.empty()) {
+        return Status::IOError("Received an unexpected file with a message");
+    } else if (header.payload_size > max_inline_payload_size) {
+        return Status::IOError(
+            "Received a message payload of ",
+            header.payload_size,
+            " bytes through the socket, more than the limit of ",
+            max_inline_payload_size);
+    } else if (header.payload_size > 0) {
+        std::vector<std::uint8_t> data(header.payload_size);
+        ARROW_ASSIGN_OR_RAISE(auto const complete, receive_all(socket, data.data(), data.size()));
+        if (!complete) {
+            return Status::IOError("Connection closed part way through a message");
+        }
+        message->payload = MessagePayload(std::move(data));
+    }
+    return message;
+#else
+    (void)socket;
+    (void)max_inline_payload_size;
+    return Status::NotImplemented("Signal servers are only supported on Linux");
+#endif
+}
+
+Status message_status(Message const & message)
+{
+    if (message.header.status_code == 0) {
+        return Status::OK();
+    }
+    auto const payload = message.payload.data();
+    return Status(
+        arrow::StatusCode(message.header.status_code),
+        std::string(payload.begin(), payload.end()));
+}
+
+}}  // namespace pod5::signal_server
@@ -0,0 +1,171 @@
+#pragma once
+
+#include "pod5_format/pod5_format_export.h"
+#include "pod5_format/result.h"
+
+#include <gsl/gsl-lite.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace pod5 {
+
+/// \brief Messages exchanged by a SignalServer and its clients over a Unix domain socket.
+/// \details Every message is a MessageHeader followed by payload_size bytes of payload. Large
+///          payloads are written to a memfd instead, passed with the header as SCM_RIGHTS
+///          ancillary data (MessageHeader::PAYLOAD_IN_FILE), the receiver maps it rather than
+///          copying it through the socket. Payload files must be sealed against writing and
+///          resizing, so the sender can't change them once the receiver has checked them.
+///          Payloads sent through the socket are limited to MAX_INLINE_REQUEST_SIZE and
+///          MAX_INLINE_REPLY_SIZE bytes.
+///
+///          Each request is answered by replies of the same type, in order. Every reply but the
+///          last to a request has MessageHeader::MORE_REPLIES set. Replies with a non zero
+///          status_code are errors (an arrow::StatusCode), their payload is the message, and
+///          they are always the last reply to their request.
+///
+///          Request and reply payloads:
+///          - OpenFile: the file's path / OpenFileReply.
+///          - CloseFile: a FileRequest / nothing.
+///          - GetReads, GetSignal: a FileRequest then read_id_count 16 byte read ids, none
+///            requesting every read / a reply for each read table batch holding requested reads
+///            (one empty reply if there are none): a ReadsReply, reply.read_count
+///            SignalServerRead records, then for GetSignal each read's samples, in record order.
+///            Each record's sample_offset is relative to the samples in its own reply.
+namespace signal_server {
+
+constexpr std::uint32_t PROTOCOL_MAGIC = 0x44354450;  // "PD5D"
+constexpr std::uint16_t PROTOCOL_VERSION = 2;
+
+enum class MessageType : std::uint16_t {
+    OpenFile = 1,
+    CloseFile = 2,
+    GetReads = 3,
+    GetSignal = 4,
+};
+
+struct MessageHeader {
+    static constexpr std::uint32_t PAYLOAD_IN_FILE = 1;
+    static constexpr std::uint32_t MORE_REPLIES = 2;
+
+    std::uint32_t magic = PROTOCOL_MAGIC;
+    std::uint16_t version = PROTOCOL_VERSION;
+    MessageType type;
+    std::uint32_t status_code = 0;
+    std::uint32_t flags = 0;
+    std::uint64_t payload_size = 0;
+};
+
+static_assert(sizeof(MessageHeader) == 24, "Message headers are sent as is");
+
+struct OpenFileReply {
+    std::uint32_t file;
+    std::uint32_t padding = 0;
+    std::uint64_t read_count;
+    std::uint8_t file_identifier[16];
+};
+
+struct FileRequest {
+    std::uint32_t file;
+    std::uint32_t padding = 0;
+    std::uint64_t read_id_count = 0;
+};
+
+struct ReadsReply {
+    std::uint64_t read_count;
+    std::uint64_t sample_count;
+};
+
+/// \brief The largest payload file a server or client will map.
+constexpr std::uint64_t MAX_PAYLOAD_SIZE = std::uint64_t(1) << 40;
+/// \brief The largest request payload a server reads from the socket, larger requests are sent in
+///        a payload file.
+constexpr std::uint64_t MAX_INLINE_REQUEST_SIZE = 4 * 1024 * 1024;
+/// \brief The largest reply payload a client reads from the socket.
+constexpr std::uint64_t MAX_INLINE_REPLY_SIZE = 16 * 1024 * 1024;
+/// \brief Payloads of at least this many bytes are sent in a payload file by default.
+constexpr std::uint64_t DEFAULT_FILE_PAYLOAD_SIZE = 256 * 1024;
+
+}  // namespace signal_server
+
+/// \brief A read's metadata, as served by a SignalServer.
+/// \note Laid out identically to the C API's SignalServerRead_t.
+struct SignalServerRead {
+    std::uint8_t read_id[16];
+    std::uint64_t start_sample;
+    std::uint64_t num_samples;
+    std::uint64_t num_minknow_events;
+    /// Offset of the read's first sample in the reply's samples, for signal requests.
+    std::uint64_t sample_offset;
+    std::uint32_t read_number;
+    std::uint16_t channel;
+    std::uint8_t well;
+    std::uint8_t padding_0;
+    float median_before;
+    float calibration_offset;
+    float calibration_scale;
+    float tracked_scaling_scale;
+    float tracked_scaling_shift;
+    float predicted_scaling_scale;
+    float predicted_scaling_shift;
+    std::uint32_t num_reads_since_mux_change;
+    float time_since_mux_change;
+    std::uint32_t padding_1;
+};
+
+static_assert(sizeof(SignalServerRead) == 96, "Reads are sent as is");
+
+namespace signal_server {
+
+/// \brief A received message's payload, either read from the socket or mapped from a memfd.
+class POD5_FORMAT_EXPORT MessagePayload {
+public:
+    MessagePayload() = default;
+    explicit MessagePayload(std::vector<std::uint8_t> && data);
+    /// Take ownership of a read only mapping of [size] bytes.
+    MessagePayload(void const * mapping, std::size_t size);
+    ~MessagePayload();
+
+    MessagePayload(MessagePayload && other);
+    MessagePayload & operator=(MessagePayload && other);
+
+    gsl::span<std::uint8_t const> data() const;
+
+private:
+    void release();
+
+    std::vector<std::uint8_t> m_data;
+    void const * m_mapping = nullptr;
+    std::size_t m_mapping_size = 0;
+};
+
+struct Message {
+    MessageHeader header;
+    MessagePayload payload;
+};
+
+/// \brief Send [header] and [payload] on [socket], through a sealed memfd if the payload is at
+///        least [file_payload_size] bytes.
+/// \note header.payload_size and the PAYLOAD_IN_FILE flag are filled in from the payload.
+POD5_FORMAT_EXPORT Status send_message(
+    int socket,
+    MessageHeader header,
+    gsl::span<gsl::span<std::uint8_t const> const> payload,
+    std::uint64_t file_payload_size = DEFAULT_FILE_PAYLOAD_SIZE);
+
+/// \brief Send an error reply of [type] describing [status] on [socket].
+POD5_FORMAT_EXPORT Status send_error(int socket, MessageType type, Status const & status);
+
+/// \brief Receive the next message from [socket], rejecting payloads of more than
+///        [max_inline_payload_size] bytes sent through the socket.
+/// \returns The message, or null if the peer closed the socket before sending one.
+POD5_FORMAT_EXPORT Result<std::unique_ptr<Message>> receive_message(
+    int socket,
+    std::uint64_t max_inline_payload_size);
+
+/// \brief Find the status an error reply describes, OK if [message] is not an error.
+POD5_FORMAT_EXPORT Status message_status(Message const & message);
+
+}  // namespace signal_server
+}  // namespace pod5
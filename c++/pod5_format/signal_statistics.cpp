@@ -0,0 +1,203 @@
+#include "pod5_format/signal_statistics.h"
+
+#include "pod5_format/svb16/common.hpp"
+
+#ifdef SVB16_X64
+#include <emmintrin.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+
+namespace pod5 {
+
+namespace {
+
+// Samples are processed in blocks small enough that the per block sums (and the per lane
+// saturation counts of the vector kernel) cannot overflow their accumulators.
+constexpr std::size_t StatisticsBlockSize = 1024;
+
+struct BlockStatistics {
+    std::int32_t sum = 0;
+    std::uint64_t sum_squares = 0;
+    SampleType min = std::numeric_limits<SampleType>::max();
+    SampleType max = std::numeric_limits<SampleType>::min();
+    std::uint32_t saturated_count = 0;
+};
+
+BlockStatistics block_statistics_scalar(
+    SampleType const * samples,
+    std::size_t count,
+    SampleType saturation_min,
+    SampleType saturation_max)
+{
+    std::int32_t sum = 0;
+    std::uint32_t sum_squares_low = 0;
+    std::uint32_t sum_squares_high = 0;
+    SampleType min = std::numeric_limits<SampleType>::max();
+    SampleType max = std::numeric_limits<SampleType>::min();
+    std::uint32_t saturated_count = 0;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        std::int32_t const value = samples[i];
+        sum += value;
+
+        // value^2 can reach 2^30, split the squares over two 32 bit accumulators
+        // so a full block cannot overflow.
+        std::uint32_t const square = std::uint32_t(value * value);
+        sum_squares_low += square & 0xffff;
+        sum_squares_high += square >> 16;
+
+        min = std::min<SampleType>(min, samples[i]);
+        max = std::max<SampleType>(max, samples[i]);
+        saturated_count += (samples[i] <= saturation_min) | (samples[i] >= saturation_max);
+    }
+
+    BlockStatistics result;
+    result.sum = sum;
+    result.sum_squares = std::uint64_t(sum_squares_low) + (std::uint64_t(sum_squares_high) << 16);
+    result.min = min;
+    result.max = max;
+    result.saturated_count = saturated_count;
+    return result;
+}
+
+#ifdef SVB16_X64
+// SSE2 is part of the x86-64 baseline, so this kernel needs no runtime dispatch.
+BlockStatistics block_statistics_sse2(
+    SampleType const * samples,
+    std::size_t count,
+    SampleType saturation_min,
+    SampleType saturation_max)
+{
+    __m128i const ones = _mm_set1_epi16(1);
+    __m128i const zero = _mm_setzero_si128();
+    __m128i const saturation_min_vec = _mm_set1_epi16(saturation_min);
+    __m128i const saturation_max_vec = _mm_set1_epi16(saturation_max);
+
+    __m128i sum = zero;
+    __m128i sum_squares = zero;
+    __m128i min = _mm_set1_epi16(std::numeric_limits<SampleType>::max());
+    __m128i max = _mm_set1_epi16(std::numeric_limits<SampleType>::min());
+    __m128i saturated_count = zero;
+
+    std::size_t const vector_count = count - (count % 8);
+    for (std::size_t i = 0; i < vector_count; i += 8) {
+        __m128i const values =
+            _mm_loadu_si128(reinterpret_cast<__m128i const *>(samples + i));
+
+        sum = _mm_add_epi32(sum, _mm_madd_epi16(values, ones));
+
+        // Each pair of squares sums to at most 2^31, which fits the lane when read as unsigned,
+        // widen to 64 bits before accumulating.
+        __m128i const squares = _mm_madd_epi16(values, values);
+        sum_squares = _mm_add_epi64(sum_squares, _mm_unpacklo_epi32(squares, zero));
+        sum_squares = _mm_add_epi64(sum_squares, _mm_unpackhi_epi32(squares, zero));
+
+        min = _mm_min_epi16(min, values);
+        max = _mm_max_epi16(max, values);
+
+        // Lanes strictly inside the limits are all ones, count one for each other lane:
+        __m128i const unsaturated = _mm_and_si128(
+            _mm_cmpgt_epi16(values, saturation_min_vec),
+            _mm_cmplt_epi16(values, saturation_max_vec));
+        saturated_count = _mm_add_epi16(saturated_count, _mm_andnot_si128(unsaturated, ones));
+    }
+
+    alignas(16) std::int32_t sum_lanes[4];
+    alignas(16) std::uint64_t sum_squares_lanes[2];
+    alignas(16) SampleType min_lanes[8];
+    alignas(16) SampleType max_lanes[8];
+    alignas(16) std::int32_t saturated_lanes[4];
+    _mm_store_si128(reinterpret_cast<__m128i *>(sum_lanes), sum);
+    _mm_store_si128(reinterpret_cast<__m128i *>(sum_squares_lanes), sum_squares);
+    _mm_store_si128(reinterpret_cast<__m128i *>(min_lanes), min);
+    _mm_store_si128(reinterpret_cast<__m128i *>(max_lanes), max);
+    _mm_store_si128(
+        reinterpret_cast<__m128i *>(saturated_lanes), _mm_madd_epi16(saturated_count, ones));
+
+    auto result = block_statistics_scalar(
+        samples + vector_count, count - vector_count, saturation_min, saturation_max);
+    for (std::size_t lane = 0; lane < 4; ++lane) {
+        result.sum += sum_lanes[lane];
+        result.saturated_count += std::uint32_t(saturated_lanes[lane]);
+    }
+    result.sum_squares += sum_squares_lanes[0] + sum_squares_lanes[1];
+    for (std::size_t lane = 0; lane < 8; ++lane) {
+        result.min = std::min(result.min, min_lanes[lane]);
+        result.max = std::max(result.max, max_lanes[lane]);
+    }
+    return result;
+}
+#endif
+
+BlockStatistics block_statistics(
+    SampleType const * samples,
+    std::size_t count,
+    SampleType saturation_min,
+    SampleType saturation_max)
+{
+#ifdef SVB16_X64
+    return block_statistics_sse2(samples, count, saturation_min, saturation_max);
+#else
+    return block_statistics_scalar(samples, count, saturation_min, saturation_max);
+#endif
+}
+
+}  // namespace
+
+SignalStatisticsAccumulator::SignalStatisticsAccumulator(
+    SampleType saturation_min,
+    SampleType saturation_max)
+: m_saturation_min(saturation_min)
+, m_saturation_max(saturation_max)
+{
+}
+
+void SignalStatisticsAccumulator::add(gsl::span<SampleType const> const & samples)
+{
+    for (std::size_t block_start = 0; block_start < samples.size();
+         block_start += StatisticsBlockSize) {
+        auto const count = std::min(StatisticsBlockSize, samples.size() - block_start);
+        auto const block = block_statistics(
+            samples.data() + block_start, count, m_saturation_min, m_saturation_max);
+
+        m_sum += block.sum;
+        m_sum_squares += block.sum_squares;
+        m_min = std::min(m_min, block.min);
+        m_max = std::max(m_max, block.max);
+        m_saturated_count += block.saturated_count;
+    }
+    m_sample_count += samples.size();
+}
+
+SignalStatistics SignalStatisticsAccumulator::statistics() const
+{
+    SignalStatistics result;
+    if (m_sample_count == 0) {
+        return result;
+    }
+
+    double const count = double(m_sample_count);
+    double const mean = double(m_sum) / count;
+    double const variance = std::max(0.0, double(m_sum_squares) / count - mean * mean);
+
+    result.min = m_min;
+    result.max = m_max;
+    result.mean = float(mean);
+    result.stdev = float(std::sqrt(variance));
+    result.saturated_count = m_saturated_count;
+    return result;
+}
+
+SignalStatistics compute_signal_statistics(
+    gsl::span<SampleType const> const & samples,
+    SampleType saturation_min,
+    SampleType saturation_max)
+{
+    SignalStatisticsAccumulator accumulator(saturation_min, saturation_max);
+    accumulator.add(samples);
+    return accumulator.statistics();
+}
+
+}  // namespace pod5
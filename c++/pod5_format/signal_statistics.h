@@ -0,0 +1,67 @@
+#pragma once
+
+#include "pod5_format/pod5_format_export.h"
+#include "pod5_format/signal_compression.h"
+
+#include <gsl/gsl-lite.hpp>
+
+#include <cstdint>
+#include <limits>
+
+namespace pod5 {
+
+/// \brief Summary statistics of a read's signal, in raw ADC units.
+/// \note To convert to pA apply the read's calibration: (value + offset) * scale for the mean,
+///       min and max, and stdev * scale for the standard deviation.
+struct SignalStatistics {
+    SampleType min = 0;
+    SampleType max = 0;
+    float mean = 0.0f;
+    float stdev = 0.0f;
+    /// Number of samples at or beyond the digitiser limits of the read's run.
+    std::uint64_t saturated_count = 0;
+
+    bool operator==(SignalStatistics const & other) const
+    {
+        return min == other.min && max == other.max && mean == other.mean && stdev == other.stdev
+               && saturated_count == other.saturated_count;
+    }
+
+    bool operator!=(SignalStatistics const & other) const { return !(*this == other); }
+};
+
+/// \brief Accumulate signal statistics over a read, one chunk at a time.
+/// \details Chunks are expected to be added as they pass through compression, so the samples
+///          are already in cache when the statistics are gathered.
+class POD5_FORMAT_EXPORT SignalStatisticsAccumulator {
+public:
+    SignalStatisticsAccumulator(
+        SampleType saturation_min = std::numeric_limits<SampleType>::min(),
+        SampleType saturation_max = std::numeric_limits<SampleType>::max());
+
+    void add(gsl::span<SampleType const> const & samples);
+
+    std::uint64_t sample_count() const { return m_sample_count; }
+
+    /// Find the statistics of all samples added so far.
+    SignalStatistics statistics() const;
+
+private:
+    SampleType m_saturation_min;
+    SampleType m_saturation_max;
+
+    std::uint64_t m_sample_count = 0;
+    std::int64_t m_sum = 0;
+    std::uint64_t m_sum_squares = 0;
+    SampleType m_min = std::numeric_limits<SampleType>::max();
+    SampleType m_max = std::numeric_limits<SampleType>::min();
+    std::uint64_t m_saturated_count = 0;
+};
+
+/// \brief Compute statistics for a complete signal in one pass.
+POD5_FORMAT_EXPORT SignalStatistics compute_signal_statistics(
+    gsl::span<SampleType const> const & samples,
+    SampleType saturation_min = std::numeric_limits<SampleType>::min(),
+    SampleType saturation_max = std::numeric_limits<SampleType>::max());
+
+}  // namespace pod5
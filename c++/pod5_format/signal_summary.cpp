@@ -0,0 +1,92 @@
+#include "pod5_format/signal_summary.h"
+
+#include <algorithm>
+
+namespace pod5 {
+
+std::vector<SignalSummaryLevel> build_signal_summary_levels(
+    gsl::span<SampleType const> const & signal,
+    std::uint32_t base_bin_size)
+{
+    std::vector<SignalSummaryLevel> levels;
+    if (signal.empty() || base_bin_size == 0) {
+        return levels;
+    }
+
+    // Sums and sample counts are carried between levels so coarser means are exact,
+    // rather than averages of rounded averages.
+    std::vector<std::int64_t> sums;
+    std::vector<std::uint64_t> counts;
+
+    {
+        std::size_t const bin_count = (signal.size() + base_bin_size - 1) / base_bin_size;
+        SignalSummaryLevel level;
+        level.bin_size = base_bin_size;
+        level.min.resize(bin_count);
+        level.max.resize(bin_count);
+        level.mean.resize(bin_count);
+        sums.resize(bin_count);
+        counts.resize(bin_count);
+
+        for (std::size_t bin = 0; bin < bin_count; ++bin) {
+            std::size_t const start = bin * base_bin_size;
+            std::size_t const count = std::min<std::size_t>(base_bin_size, signal.size() - start);
+            SampleType const * samples = signal.data() + start;
+
+            std::int64_t sum = 0;
+            SampleType min = samples[0];
+            SampleType max = samples[0];
+            for (std::size_t i = 0; i < count; ++i) {
+                sum += samples[i];
+                min = std::min(min, samples[i]);
+                max = std::max(max, samples[i]);
+            }
+
+            level.min[bin] = min;
+            level.max[bin] = max;
+            level.mean[bin] = float(double(sum) / count);
+            sums[bin] = sum;
+            counts[bin] = count;
+        }
+        levels.emplace_back(std::move(level));
+    }
+
+    while (levels.back().bin_count() > 1) {
+        auto const & previous = levels.back();
+        std::size_t const bin_count = (previous.bin_count() + 1) / 2;
+
+        SignalSummaryLevel level;
+        level.bin_size = previous.bin_size * 2;
+        level.min.resize(bin_count);
+        level.max.resize(bin_count);
+        level.mean.resize(bin_count);
+
+        for (std::size_t bin = 0; bin < bin_count; ++bin) {
+            std::size_t const first = bin * 2;
+            std::size_t const last = std::min(first + 1, previous.bin_count() - 1);
+
+            level.min[bin] = std::min(previous.min[first], previous.min[last]);
+            level.max[bin] = std::max(previous.max[first], previous.max[last]);
+
+            std::int64_t sum = sums[first];
+            std::uint64_t count = counts[first];
+            if (last != first) {
+                sum += sums[last];
+                count += counts[last];
+            }
+            level.mean[bin] = float(double(sum) / count);
+
+            // Safe to overwrite in place, [bin] never exceeds the source index [first]:
+            sums[bin] = sum;
+            counts[bin] = count;
+        }
+        sums.resize(bin_count);
+        counts.resize(bin_count);
+
+        levels.emplace_back(std::move(level));
+    }
+
+    return levels;
+}
+
+}  // namespace pod5
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "pod5_format/pod5_format_export.h"
+#include "pod5_format/signal_compression.h"
+
+#include <gsl/gsl-lite.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace pod5 {
+
+/// \brief One level of a read's signal summary pyramid.
+/// \details Each bin summarises [bin_size] consecutive samples, the final bin of a level may
+///          cover fewer samples if the read length is not a multiple of the bin size.
+struct SignalSummaryLevel {
+    std::uint32_t bin_size = 0;
+    std::vector<SampleType> min;
+    std::vector<SampleType> max;
+    std::vector<float> mean;
+
+    std::size_t bin_count() const { return mean.size(); }
+};
+
+/// \brief Build the summary pyramid for a read.
+/// \details Level 0 holds bins of [base_bin_size] samples, each following level halves the number
+///          of bins, until a level holding a single bin is produced.
+/// \param signal           The samples of the read.
+/// \param base_bin_size    Number of samples summarised by each bin of level 0.
+/// \returns The levels of the pyramid, finest first. Empty if [signal] is empty.
+POD5_FORMAT_EXPORT std::vector<SignalSummaryLevel> build_signal_summary_levels(
+    gsl::span<SampleType const> const & signal,
+    std::uint32_t base_bin_size);
+
+/// \brief A range of bins from one level of a read's signal summary pyramid.
+struct SignalSummary {
+    /// Level of the pyramid these bins were taken from.
+    std::size_t level = 0;
+    /// Number of levels stored for the read.
+    std::size_t level_count = 0;
+    /// Number of samples summarised by each bin.
+    std::uint32_t bin_size = 0;
+    /// Index of the first sample covered by the first returned bin.
+    std::uint64_t first_sample = 0;
+    /// Total number of samples in the read.
+    std::uint64_t read_sample_count = 0;
+
+    std::vector<SampleType> min;
+    std::vector<SampleType> max;
+    std::vector<float> mean;
+
+    std::size_t bin_count() const { return mean.size(); }
+};
+
+}  // namespace pod5
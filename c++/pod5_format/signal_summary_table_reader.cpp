@@ -0,0 +1,226 @@
+#include "pod5_format/signal_summary_table_reader.h"
+
+#include "pod5_format/schema_metadata.h"
+#include "pod5_format/schema_utils.h"
+
+#include <arrow/array/array_nested.h>
+#include <arrow/array/array_primitive.h>
+#include <arrow/ipc/reader.h>
+
+#include <algorithm>
+
+namespace pod5 {
+
+namespace {
+
+template <typename ArrayType, typename T>
+void copy_list_range(
+    arrow::ListArray const & list,
+    std::size_t row,
+    std::size_t first,
+    std::size_t count,
+    std::vector<T> & dest)
+{
+    auto const & values = static_cast<ArrayType const &>(*list.values());
+    auto const * begin = values.raw_values() + list.value_offset(row) + first;
+    dest.assign(begin, begin + count);
+}
+
+}  // namespace
+
+SignalSummaryTableRecordBatch::SignalSummaryTableRecordBatch(
+    std::shared_ptr<arrow::RecordBatch> && batch,
+    std::shared_ptr<SignalSummaryTableSchemaDescription const> const & field_locations)
+: TableRecordBatch(std::move(batch))
+, m_field_locations(field_locations)
+{
+}
+
+SignalSummaryTableRecordBatch::SignalSummaryTableRecordBatch(
+    SignalSummaryTableRecordBatch && other)
+: TableRecordBatch(std::move(other))
+{
+    m_field_locations = std::move(other.m_field_locations);
+}
+
+SignalSummaryTableRecordBatch & SignalSummaryTableRecordBatch::operator=(
+    SignalSummaryTableRecordBatch && other)
+{
+    TableRecordBatch & base = *this;
+    base = other;
+
+    m_field_locations = std::move(other.m_field_locations);
+    return *this;
+}
+
+Result<SignalSummaryTableRecordColumns> SignalSummaryTableRecordBatch::columns() const
+{
+    SignalSummaryTableRecordColumns result;
+    result.table_version = m_field_locations->table_version();
+
+    auto const & bat = batch();
+
+    // V0 fields:
+    result.read_id = find_column(bat, m_field_locations->read_id);
+    result.level = find_column(bat, m_field_locations->level);
+    result.bin_size = find_column(bat, m_field_locations->bin_size);
+    result.sample_count = find_column(bat, m_field_locations->sample_count);
+    result.min = find_column(bat, m_field_locations->min);
+    result.max = find_column(bat, m_field_locations->max);
+    result.mean = find_column(bat, m_field_locations->mean);
+
+    return result;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+SignalSummaryTableReader::SignalSummaryTableReader(
+    std::shared_ptr<arrow::io::RandomAccessFile> const & input_source,
+    std::shared_ptr<arrow::ipc::RecordBatchFileReader> && reader,
+    std::shared_ptr<SignalSummaryTableSchemaDescription const> const & field_locations,
+    SchemaMetadataDescription && schema_metadata,
+    arrow::MemoryPool * pool)
+: TableReader(input_source, std::move(reader), std::move(schema_metadata), pool)
+, m_field_locations(field_locations)
+{
+}
+
+SignalSummaryTableReader::SignalSummaryTableReader(SignalSummaryTableReader && other)
+: TableReader(std::move(other))
+, m_field_locations(std::move(other.m_field_locations))
+, m_read_index_built(other.m_read_index_built)
+, m_read_index(std::move(other.m_read_index))
+{
+}
+
+SignalSummaryTableReader & SignalSummaryTableReader::operator=(
+    SignalSummaryTableReader && other)
+{
+    static_cast<TableReader &>(*this) = std::move(static_cast<TableReader &>(other));
+    m_field_locations = std::move(other.m_field_locations);
+    m_read_index_built = other.m_read_index_built;
+    m_read_index = std::move(other.m_read_index);
+    return *this;
+}
+
+Result<SignalSummaryTableRecordBatch> SignalSummaryTableReader::read_record_batch(
+    std::size_t i) const
+{
+    std::lock_guard<std::mutex> l(m_batch_get_mutex);
+    ARROW_ASSIGN_OR_RAISE(auto record_batch, read_checked_record_batch(i));
+    return SignalSummaryTableRecordBatch{std::move(record_batch), m_field_locations};
+}
+
+Result<SignalSummary> SignalSummaryTableReader::get_signal_summary(
+    boost::uuids::uuid const & read_id,
+    std::size_t level,
+    std::uint64_t first_sample,
+    std::uint64_t sample_count) const
+{
+    ARROW_ASSIGN_OR_RAISE(auto entry, [&]() -> Result<ReadEntry> {
+        std::lock_guard<std::mutex> l(m_index_mutex);
+        ARROW_RETURN_NOT_OK(build_read_index());
+
+        auto it = m_read_index.find(read_id);
+        if (it == m_read_index.end()) {
+            return arrow::Status::KeyError("No signal summary stored for read");
+        }
+        return it->second;
+    }());
+
+    if (level >= entry.level_count) {
+        return arrow::Status::IndexError(
+            "Invalid signal summary level (expected ", level, " < ", entry.level_count, ")");
+    }
+
+    ARROW_ASSIGN_OR_RAISE(auto batch, read_record_batch(entry.batch));
+    ARROW_ASSIGN_OR_RAISE(auto columns, batch.columns());
+    auto const row = entry.batch_row + level;
+
+    SignalSummary result;
+    result.level = level;
+    result.level_count = entry.level_count;
+    result.bin_size = columns.bin_size->Value(row);
+    result.read_sample_count = columns.sample_count->Value(row);
+    if (result.bin_size == 0) {
+        return arrow::Status::Invalid("Invalid signal summary bin size");
+    }
+
+    // Clamp the requested range to the read, then widen it to whole bins:
+    first_sample = std::min(first_sample, result.read_sample_count);
+    auto const end_sample =
+        first_sample + std::min(sample_count, result.read_sample_count - first_sample);
+    auto const first_bin = first_sample / result.bin_size;
+    auto const end_bin = (end_sample + result.bin_size - 1) / result.bin_size;
+    auto const bin_count = end_bin > first_bin ? end_bin - first_bin : 0;
+    result.first_sample = first_bin * result.bin_size;
+
+    std::size_t const stored_bins = columns.mean->value_length(row);
+    if (first_bin + bin_count > stored_bins) {
+        return arrow::Status::Invalid("Signal summary is shorter than the read it describes");
+    }
+
+    copy_list_range<arrow::Int16Array>(*columns.min, row, first_bin, bin_count, result.min);
+    copy_list_range<arrow::Int16Array>(*columns.max, row, first_bin, bin_count, result.max);
+    copy_list_range<arrow::FloatArray>(*columns.mean, row, first_bin, bin_count, result.mean);
+    return result;
+}
+
+arrow::Status SignalSummaryTableReader::build_read_index() const
+{
+    if (m_read_index_built) {
+        return Status::OK();
+    }
+
+    std::unordered_map<boost::uuids::uuid, ReadEntry, boost::hash<boost::uuids::uuid>> read_index;
+
+    // The levels of a read are written as consecutive rows of one batch, starting at level 0.
+    for (std::size_t i = 0; i < num_record_batches(); ++i) {
+        ARROW_ASSIGN_OR_RAISE(auto batch, read_record_batch(i));
+        ARROW_ASSIGN_OR_RAISE(auto columns, batch.columns());
+
+        auto const read_ids = columns.read_id->raw_values();
+        ReadEntry * current = nullptr;
+        for (std::int64_t j = 0; j < columns.level->length(); ++j) {
+            if (columns.level->Value(j) == 0) {
+                current = &read_index[read_ids[j]];
+                *current = ReadEntry{i, std::size_t(j), 0};
+            } else if (!current || read_ids[j] != read_ids[current->batch_row]) {
+                return arrow::Status::Invalid("Signal summary levels stored out of order");
+            }
+            current->level_count += 1;
+        }
+    }
+
+    m_read_index = std::move(read_index);
+    m_read_index_built = true;
+    return Status::OK();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+Result<SignalSummaryTableReader> make_signal_summary_table_reader(
+    std::shared_ptr<arrow::io::RandomAccessFile> const & input,
+    arrow::MemoryPool * pool)
+{
+    arrow::ipc::IpcReadOptions options;
+    options.memory_pool = pool;
+
+    ARROW_ASSIGN_OR_RAISE(auto reader, arrow::ipc::RecordBatchFileReader::Open(input, options));
+
+    auto metadata_key_values = reader->schema()->metadata();
+    if (!metadata_key_values) {
+        return Status::IOError("Missing metadata on signal summary table schema");
+    }
+    if (read_index_type(metadata_key_values) != SIGNAL_SUMMARY_INDEX_TYPE) {
+        return Status::Invalid("Table is not a signal summary index");
+    }
+    ARROW_ASSIGN_OR_RAISE(auto metadata, read_schema_key_value_metadata(metadata_key_values));
+    ARROW_ASSIGN_OR_RAISE(
+        auto field_locations, read_signal_summary_table_schema(metadata, reader->schema()));
+
+    return SignalSummaryTableReader(
+        {input}, std::move(reader), field_locations, std::move(metadata), pool);
+}
+
+}  // namespace pod5
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "pod5_format/pod5_format_export.h"
+#include "pod5_format/result.h"
+#include "pod5_format/schema_metadata.h"
+#include "pod5_format/signal_summary.h"
+#include "pod5_format/signal_summary_table_schema.h"
+#include "pod5_format/table_reader.h"
+#include "pod5_format/types.h"
+
+#include <arrow/io/type_fwd.h>
+#include <boost/functional/hash.hpp>
+#include <boost/uuid/uuid.hpp>
+
+#include <mutex>
+#include <unordered_map>
+
+namespace arrow {
+class Schema;
+
+namespace io {
+class RandomAccessFile;
+}
+
+namespace ipc {
+class RecordBatchFileReader;
+}
+}  // namespace arrow
+
+namespace pod5 {
+
+struct SignalSummaryTableRecordColumns {
+    // V0 Fields
+    std::shared_ptr<UuidArray> read_id;
+    std::shared_ptr<arrow::UInt8Array> level;
+    std::shared_ptr<arrow::UInt32Array> bin_size;
+    std::shared_ptr<arrow::UInt64Array> sample_count;
+    std::shared_ptr<arrow::ListArray> min;
+    std::shared_ptr<arrow::ListArray> max;
+    std::shared_ptr<arrow::ListArray> mean;
+
+    TableSpecVersion table_version;
+};
+
+class POD5_FORMAT_EXPORT SignalSummaryTableRecordBatch : public TableRecordBatch {
+public:
+    SignalSummaryTableRecordBatch(
+        std::shared_ptr<arrow::RecordBatch> && batch,
+        std::shared_ptr<SignalSummaryTableSchemaDescription const> const & field_locations);
+    SignalSummaryTableRecordBatch(SignalSummaryTableRecordBatch &&);
+    SignalSummaryTableRecordBatch & operator=(SignalSummaryTableRecordBatch &&);
+
+    Result<SignalSummaryTableRecordColumns> columns() const;
+
+private:
+    std::shared_ptr<SignalSummaryTableSchemaDescription const> m_field_locations;
+};
+
+class POD5_FORMAT_EXPORT SignalSummaryTableReader : public TableReader {
+public:
+    SignalSummaryTableReader(
+        std::shared_ptr<arrow::io::RandomAccessFile> const & input_source,
+        std::shared_ptr<arrow::ipc::RecordBatchFileReader> && reader,
+        std::shared_ptr<SignalSummaryTableSchemaDescription const> const & field_locations,
+        SchemaMetadataDescription && schema_metadata,
+        arrow::MemoryPool * pool);
+
+    SignalSummaryTableReader(SignalSummaryTableReader && other);
+    SignalSummaryTableReader & operator=(SignalSummaryTableReader && other);
+
+    Result<SignalSummaryTableRecordBatch> read_record_batch(std::size_t i) const;
+
+    /// \brief Find the bins of one level of a read's summary covering a range of samples.
+    /// \param read_id      The read to find the summary for.
+    /// \param level        The level of the pyramid to query, 0 is the finest level.
+    /// \param first_sample The first sample of the range to query.
+    /// \param sample_count The number of samples in the range to query, clamped to the read length.
+    /// \returns The bins overlapping the queried range, KeyError if the read has no summary.
+    Result<SignalSummary> get_signal_summary(
+        boost::uuids::uuid const & read_id,
+        std::size_t level,
+        std::uint64_t first_sample,
+        std::uint64_t sample_count) const;
+
+private:
+    struct ReadEntry {
+        std::size_t batch;
+        std::size_t batch_row;
+        std::size_t level_count;
+    };
+
+    /// Index all read ids in the table, called with m_index_mutex held.
+    arrow::Status build_read_index() const;
+
+    std::shared_ptr<SignalSummaryTableSchemaDescription const> m_field_locations;
+    mutable std::mutex m_batch_get_mutex;
+
+    // Populated once by build_read_index():
+    mutable bool m_read_index_built = false;
+    mutable std::unordered_map<boost::uuids::uuid, ReadEntry, boost::hash<boost::uuids::uuid>>
+        m_read_index;
+    mutable std::mutex m_index_mutex;
+};
+
+POD5_FORMAT_EXPORT Result<SignalSummaryTableReader> make_signal_summary_table_reader(
+    std::shared_ptr<arrow::io::RandomAccessFile> const & input,
+    arrow::MemoryPool * pool);
+
+}  // namespace pod5
@@ -0,0 +1,39 @@
+#include "pod5_format/signal_summary_table_schema.h"
+
+#include "pod5_format/schema_metadata.h"
+#include "pod5_format/types.h"
+
+namespace pod5 {
+
+SignalSummaryTableSchemaDescription::SignalSummaryTableSchemaDescription()
+: SchemaDescriptionBase(SignalSummaryTableSpecVersion::latest())
+// V0 Fields
+, read_id(this, "read_id", uuid(), SignalSummaryTableSpecVersion::v0())
+, level(this, "level", arrow::uint8(), SignalSummaryTableSpecVersion::v0())
+, bin_size(this, "bin_size", arrow::uint32(), SignalSummaryTableSpecVersion::v0())
+, sample_count(this, "sample_count", arrow::uint64(), SignalSummaryTableSpecVersion::v0())
+, min(this, "min", arrow::list(arrow::int16()), SignalSummaryTableSpecVersion::v0())
+, max(this, "max", arrow::list(arrow::int16()), SignalSummaryTableSpecVersion::v0())
+, mean(this, "mean", arrow::list(arrow::float32()), SignalSummaryTableSpecVersion::v0())
+{
+}
+
+TableSpecVersion SignalSummaryTableSchemaDescription::table_version_from_file_version(
+    Version file_version) const
+{
+    return SignalSummaryTableSpecVersion::latest();
+}
+
+Result<std::shared_ptr<SignalSummaryTableSchemaDescription const>>
+read_signal_summary_table_schema(
+    SchemaMetadataDescription const & schema_metadata,
+    std::shared_ptr<arrow::Schema> const & schema)
+{
+    auto result = std::make_shared<SignalSummaryTableSchemaDescription>();
+    ARROW_RETURN_NOT_OK(
+        SignalSummaryTableSchemaDescription::read_schema(result, schema_metadata, schema));
+
+    return result;
+}
+
+}  // namespace pod5
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "pod5_format/pod5_format_export.h"
+#include "pod5_format/result.h"
+#include "pod5_format/schema_utils.h"
+#include "pod5_format/tuple_utils.h"
+#include "pod5_format/types.h"
+
+#include <memory>
+#include <tuple>
+#include <vector>
+
+namespace arrow {
+class KeyValueMetadata;
+class Schema;
+class DataType;
+class StructType;
+}  // namespace arrow
+
+namespace pod5 {
+
+class SignalSummaryTableSpecVersion {
+public:
+    static TableSpecVersion v0() { return TableSpecVersion::first_version(); }
+
+    static TableSpecVersion latest() { return v0(); }
+};
+
+/// Index type recorded in the schema metadata of an embedded signal summary table.
+static constexpr char const * SIGNAL_SUMMARY_INDEX_TYPE = "signal_summary";
+
+/// \brief Schema of the signal summary table, embedded in a file as an OtherIndex.
+/// \details Holds one row per pyramid level for each read, the rows of a read are consecutive
+///          and ordered from the finest level to the coarsest.
+class SignalSummaryTableSchemaDescription : public SchemaDescriptionBase {
+public:
+    SignalSummaryTableSchemaDescription();
+
+    SignalSummaryTableSchemaDescription(SignalSummaryTableSchemaDescription const &) = delete;
+    SignalSummaryTableSchemaDescription & operator=(SignalSummaryTableSchemaDescription const &) =
+        delete;
+
+    TableSpecVersion table_version_from_file_version(Version file_version) const override;
+
+    Field<0, UuidArray> read_id;
+    Field<1, arrow::UInt8Array> level;
+    Field<2, arrow::UInt32Array> bin_size;
+    Field<3, arrow::UInt64Array> sample_count;
+    ListField<4, arrow::ListArray, arrow::Int16Array> min;
+    ListField<5, arrow::ListArray, arrow::Int16Array> max;
+    ListField<6, arrow::ListArray, arrow::FloatArray> mean;
+
+    using FieldBuilders = FieldBuilder<
+        // V0 fields
+        decltype(read_id),
+        decltype(level),
+        decltype(bin_size),
+        decltype(sample_count),
+        decltype(min),
+        decltype(max),
+        decltype(mean)>;
+};
+
+POD5_FORMAT_EXPORT Result<std::shared_ptr<SignalSummaryTableSchemaDescription const>>
+read_signal_summary_table_schema(
+    SchemaMetadataDescription const & schema_metadata,
+    std::shared_ptr<arrow::Schema> const &);
+
+}  // namespace pod5
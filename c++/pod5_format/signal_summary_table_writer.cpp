@@ -0,0 +1,158 @@
+#include "pod5_format/signal_summary_table_writer.h"
+
+#include "pod5_format/internal/tracing/tracing.h"
+#include "pod5_format/schema_metadata.h"
+#include "pod5_format/signal_summary.h"
+
+#include <arrow/extension_type.h>
+#include <arrow/ipc/writer.h>
+#include <arrow/record_batch.h>
+#include <arrow/type.h>
+
+namespace pod5 {
+
+SignalSummaryTableWriter::SignalSummaryTableWriter(
+    std::shared_ptr<arrow::ipc::RecordBatchWriter> && writer,
+    std::shared_ptr<arrow::Schema> && schema,
+    std::shared_ptr<SignalSummaryTableSchemaDescription> const & field_locations,
+    std::shared_ptr<arrow::io::OutputStream> const & output_stream,
+    std::uint32_t base_bin_size,
+    std::size_t table_batch_size,
+    arrow::MemoryPool * pool)
+: m_schema(schema)
+, m_field_locations(field_locations)
+, m_output_stream{output_stream}
+, m_base_bin_size(base_bin_size)
+, m_table_batch_size(table_batch_size)
+, m_writer(std::move(writer))
+, m_field_builders(m_field_locations, pool)
+{
+}
+
+SignalSummaryTableWriter::SignalSummaryTableWriter(SignalSummaryTableWriter && other) = default;
+SignalSummaryTableWriter & SignalSummaryTableWriter::operator=(SignalSummaryTableWriter &&) =
+    default;
+
+SignalSummaryTableWriter::~SignalSummaryTableWriter()
+{
+    if (m_writer) {
+        (void)close();
+    }
+}
+
+Result<std::size_t> SignalSummaryTableWriter::add_read_summary(
+    boost::uuids::uuid const & read_id,
+    gsl::span<std::int16_t const> const & signal)
+{
+    POD5_TRACE_FUNCTION();
+    if (!m_writer) {
+        return Status::IOError("Writer terminated");
+    }
+
+    auto const levels = build_signal_summary_levels(signal, m_base_bin_size);
+    if (levels.size() > std::numeric_limits<std::uint8_t>::max()) {
+        return Status::Invalid("Too many signal summary levels for read");
+    }
+
+    std::uint64_t const sample_count = signal.size();
+    for (std::size_t i = 0; i < levels.size(); ++i) {
+        auto const & level = levels[i];
+        ARROW_RETURN_NOT_OK(m_field_builders.append(
+            // V0 Fields
+            read_id,
+            std::uint8_t(i),
+            level.bin_size,
+            sample_count,
+            level.min,
+            level.max,
+            level.mean));
+        ++m_current_batch_row_count;
+    }
+
+    // Levels of one read are kept in a single batch, so a batch may exceed the requested size:
+    if (m_current_batch_row_count >= m_table_batch_size) {
+        ARROW_RETURN_NOT_OK(write_batch());
+    }
+    return levels.size();
+}
+
+Status SignalSummaryTableWriter::close()
+{
+    // Check for already closed
+    if (!m_writer) {
+        return Status::OK();
+    }
+
+    ARROW_RETURN_NOT_OK(write_batch());
+    ARROW_RETURN_NOT_OK(m_writer->Close());
+    m_writer = nullptr;
+    return Status::OK();
+}
+
+Status SignalSummaryTableWriter::write_batch()
+{
+    POD5_TRACE_FUNCTION();
+    if (m_current_batch_row_count == 0) {
+        return Status::OK();
+    }
+
+    if (!m_writer) {
+        return Status::IOError("Writer terminated");
+    }
+
+    ARROW_ASSIGN_OR_RAISE(auto columns, m_field_builders.finish_columns());
+
+    auto const record_batch =
+        arrow::RecordBatch::Make(m_schema, m_current_batch_row_count, std::move(columns));
+
+    m_current_batch_row_count = 0;
+
+    ARROW_RETURN_NOT_OK(m_writer->WriteRecordBatch(*record_batch));
+    ARROW_RETURN_NOT_OK(m_output_stream->Flush());
+
+    return reserve_rows();
+}
+
+Status SignalSummaryTableWriter::reserve_rows()
+{
+    return m_field_builders.reserve(m_table_batch_size);
+}
+
+Result<SignalSummaryTableWriter> make_signal_summary_table_writer(
+    std::shared_ptr<arrow::io::OutputStream> const & sink,
+    std::shared_ptr<const arrow::KeyValueMetadata> const & metadata,
+    std::uint32_t base_bin_size,
+    std::size_t table_batch_size,
+    arrow::MemoryPool * pool)
+{
+    if (base_bin_size == 0) {
+        return Status::Invalid("Signal summary bin size must be greater than zero");
+    }
+
+    ARROW_ASSIGN_OR_RAISE(
+        auto index_metadata, make_index_key_value_metadata(metadata, SIGNAL_SUMMARY_INDEX_TYPE));
+
+    auto field_locations = std::make_shared<SignalSummaryTableSchemaDescription>();
+    auto schema = field_locations->make_writer_schema(index_metadata);
+
+    arrow::ipc::IpcWriteOptions options;
+    options.memory_pool = pool;
+
+    ARROW_ASSIGN_OR_RAISE(
+        auto writer, arrow::ipc::MakeFileWriter(sink, schema, options, index_metadata));
+
+    auto signal_summary_table_writer = SignalSummaryTableWriter(
+        std::move(writer),
+        std::move(schema),
+        field_locations,
+        sink,
+        base_bin_size,
+        table_batch_size,
+        pool);
+
+    ARROW_RETURN_NOT_OK(signal_summary_table_writer.reserve_rows());
+
+    return signal_summary_table_writer;
+}
+
+}  // namespace pod5
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "pod5_format/pod5_format_export.h"
+#include "pod5_format/result.h"
+#include "pod5_format/schema_field_builder.h"
+#include "pod5_format/signal_summary_table_schema.h"
+
+#include <arrow/io/type_fwd.h>
+#include <boost/uuid/uuid.hpp>
+#include <gsl/gsl-lite.hpp>
+
+namespace arrow {
+class Schema;
+
+namespace io {
+class OutputStream;
+}
+
+namespace ipc {
+class RecordBatchWriter;
+}
+}  // namespace arrow
+
+namespace pod5 {
+
+class POD5_FORMAT_EXPORT SignalSummaryTableWriter {
+public:
+    SignalSummaryTableWriter(
+        std::shared_ptr<arrow::ipc::RecordBatchWriter> && writer,
+        std::shared_ptr<arrow::Schema> && schema,
+        std::shared_ptr<SignalSummaryTableSchemaDescription> const & field_locations,
+        std::shared_ptr<arrow::io::OutputStream> const & output_stream,
+        std::uint32_t base_bin_size,
+        std::size_t table_batch_size,
+        arrow::MemoryPool * pool);
+    SignalSummaryTableWriter(SignalSummaryTableWriter &&);
+    SignalSummaryTableWriter & operator=(SignalSummaryTableWriter &&);
+    SignalSummaryTableWriter(SignalSummaryTableWriter const &) = delete;
+    SignalSummaryTableWriter & operator=(SignalSummaryTableWriter const &) = delete;
+    ~SignalSummaryTableWriter();
+
+    /// \brief Summarise a read's signal and add the pyramid levels to the table.
+    /// \param read_id  The read the signal belongs to.
+    /// \param signal   The complete signal of the read.
+    /// \returns The number of levels added for the read, or a status on failure.
+    Result<std::size_t> add_read_summary(
+        boost::uuids::uuid const & read_id,
+        gsl::span<std::int16_t const> const & signal);
+
+    /// \brief Close this writer, signaling no further data will be written to the writer.
+    Status close();
+
+    /// \brief Reserve space for future row writes, called automatically when a flush occurs.
+    Status reserve_rows();
+
+    /// \brief Find the schema for the table
+    std::shared_ptr<arrow::Schema> const & schema() const { return m_schema; }
+
+    std::uint32_t base_bin_size() const { return m_base_bin_size; }
+
+private:
+    /// \brief Flush buffered data into the writer as a record batch.
+    Status write_batch();
+
+    std::shared_ptr<arrow::Schema> m_schema;
+    std::shared_ptr<SignalSummaryTableSchemaDescription> m_field_locations;
+    std::shared_ptr<arrow::io::OutputStream> m_output_stream;
+    std::uint32_t m_base_bin_size;
+    std::size_t m_table_batch_size;
+
+    std::shared_ptr<arrow::ipc::RecordBatchWriter> m_writer;
+
+    SignalSummaryTableSchemaDescription::FieldBuilders m_field_builders;
+
+    std::size_t m_current_batch_row_count = 0;
+};
+
+/// \brief Make a new writer for a signal summary table.
+/// \param sink Sink to be used for output of the table.
+/// \param metadata Metadata of the file, the index type is added to this for the table schema.
+/// \param base_bin_size Number of samples summarised by each bin of the finest level.
+/// \param table_batch_size The size of each batch written for the table.
+/// \param pool Pool to be used for building table in memory.
+/// \returns The writer for the new table.
+POD5_FORMAT_EXPORT Result<SignalSummaryTableWriter> make_signal_summary_table_writer(
+    std::shared_ptr<arrow::io::OutputStream> const & sink,
+    std::shared_ptr<const arrow::KeyValueMetadata> const & metadata,
+    std::uint32_t base_bin_size,
+    std::size_t table_batch_size,
+    arrow::MemoryPool * pool);
+
+}  // namespace pod5
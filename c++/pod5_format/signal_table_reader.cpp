@@ -1,5 +1,6 @@
 #include "pod5_format/signal_table_reader.h"
 
+#include "pod5_format/internal/pinned_buffer_file.h"
 #include "pod5_format/schema_metadata.h"
 #include "pod5_format/signal_compression.h"
 
@@ -39,10 +40,12 @@ struct SignalTableReaderCacheCleaner {
 SignalTableRecordBatch::SignalTableRecordBatch(
     std::shared_ptr<arrow::RecordBatch> const & batch,
     SignalTableSchemaDescription field_locations,
-    arrow::MemoryPool * pool)
+    arrow::MemoryPool * pool,
+    std::shared_ptr<VbzDictionary const> const & vbz_dictionary)
 : TableRecordBatch(batch)
 , m_field_locations(field_locations)
 , m_pool(pool)
+, m_vbz_dictionary(vbz_dictionary)
 {
 }
 
@@ -85,6 +88,22 @@ Result<std::size_t> SignalTableRecordBatch::samples_byte_count(std::size_t row_i
     return pod5::Status::Invalid("Unknown signal type");
 }
 
+Result<std::size_t> SignalTableRecordBatch::max_samples_in_row(std::size_t row_index) const
+{
+    switch (m_field_locations.signal_type) {
+    case SignalType::UncompressedSignal: {
+        auto signal_column = uncompressed_signal_column();
+        return signal_column->value_length(row_index);
+    }
+    case SignalType::VbzSignal: {
+        auto signal_column = vbz_signal_column();
+        return pod5::vbz_signal_max_sample_count(signal_column->Value(row_index));
+    }
+    }
+
+    return pod5::Status::Invalid("Unknown signal type");
+}
+
 Status SignalTableRecordBatch::extract_signal_row(
     std::size_t row_index,
     gsl::span<std::int16_t> samples) const
@@ -110,13 +129,18 @@ Status SignalTableRecordBatch::extract_signal_row(
         auto signal_column = uncompressed_signal_column();
         auto signal =
             std::static_pointer_cast<arrow::Int16Array>(signal_column->value_slice(row_index));
+        if (std::size_t(signal->length()) != samples.size()) {
+            return pod5::Status::Invalid(
+                "Stored signal holds ", signal->length(), " samples, expected ", samples.size());
+        }
         std::copy(signal->raw_values(), signal->raw_values() + signal->length(), samples.begin());
         return Status::OK();
     }
     case SignalType::VbzSignal: {
         auto signal_column = vbz_signal_column();
         auto signal_compressed = signal_column->Value(row_index);
-        return pod5::decompress_signal(signal_compressed, m_pool, samples);
+        return pod5::decompress_signal(
+            signal_compressed, m_pool, samples, m_vbz_dictionary.get());
     }
     }
 
@@ -161,19 +185,22 @@ Result<std::shared_ptr<arrow::Buffer>> SignalTableRecordBatch::extract_signal_ro
 //---------------------------------------------------------------------------------------------------------------------
 
 SignalTableReader::SignalTableReader(
-    std::shared_ptr<void> && input_source,
+    std::shared_ptr<arrow::io::RandomAccessFile> const & input_source,
     std::shared_ptr<arrow::ipc::RecordBatchFileReader> && reader,
     SignalTableSchemaDescription field_locations,
     SchemaMetadataDescription && schema_metadata,
     std::size_t num_record_batches,
     std::size_t batch_size,
     std::size_t max_cached_table_batches,
-    arrow::MemoryPool * pool)
-: TableReader(std::move(input_source), std::move(reader), std::move(schema_metadata), pool)
+    arrow::MemoryPool * pool,
+    std::shared_ptr<VbzDictionary const> const & vbz_dictionary)
+: TableReader(input_source, std::move(reader), std::move(schema_metadata), pool)
 , m_field_locations(field_locations)
 , m_pool(pool)
+, m_vbz_dictionary(vbz_dictionary)
 , m_max_cached_table_batches(max_cached_table_batches)
 , m_table_batches(num_record_batches)
+, m_batch_row_counts(num_record_batches)
 , m_batch_size(batch_size)
 {
 }
@@ -182,8 +209,10 @@ SignalTableReader::SignalTableReader(SignalTableReader && other)
 : TableReader(std::move(other))
 , m_field_locations(std::move(other.m_field_locations))
 , m_pool(other.m_pool)
+, m_vbz_dictionary(std::move(other.m_vbz_dictionary))
 , m_max_cached_table_batches(other.m_max_cached_table_batches)
 , m_table_batches(std::move(other.m_table_batches))
+, m_batch_row_counts(std::move(other.m_batch_row_counts))
 , m_batch_size(other.m_batch_size)
 {
 }
@@ -192,9 +221,11 @@ SignalTableReader & SignalTableReader::operator=(SignalTableReader && other)
 {
     m_field_locations = std::move(other.m_field_locations);
     m_pool = other.m_pool;
+    m_vbz_dictionary = std::move(other.m_vbz_dictionary);
     m_max_cached_table_batches = other.m_max_cached_table_batches;
     m_batch_size = other.m_batch_size;
     m_table_batches = std::move(other.m_table_batches);
+    m_batch_row_counts = std::move(other.m_batch_row_counts);
     static_cast<TableReader &>(*this) = std::move(static_cast<TableReader &>(other));
     return *this;
 }
@@ -203,7 +234,8 @@ Result<SignalTableRecordBatch> SignalTableReader::read_record_batch(std::size_t
 {
     std::lock_guard<std::mutex> l(m_batch_get_mutex);
     if (m_last_read_record_batch_index == i) {
-        return pod5::SignalTableRecordBatch{m_last_read_record_batch, m_field_locations, m_pool};
+        return pod5::SignalTableRecordBatch{
+            m_last_read_record_batch, m_field_locations, m_pool, m_vbz_dictionary};
     }
 
     auto it = m_table_batches.find(i);
@@ -218,16 +250,30 @@ Result<SignalTableRecordBatch> SignalTableReader::read_record_batch(std::size_t
         assert(m_table_batches.size() < m_max_cached_table_batches);
     }
 
-    ARROW_ASSIGN_OR_RAISE(m_last_read_record_batch, reader()->ReadRecordBatch(i));
+    ARROW_ASSIGN_OR_RAISE(m_last_read_record_batch, read_checked_record_batch(i));
     m_last_read_record_batch_index = i;
     auto inserted = m_table_batches.emplace(
         i,
         CachedItem{
-            pod5::SignalTableRecordBatch{m_last_read_record_batch, m_field_locations, m_pool},
+            pod5::SignalTableRecordBatch{
+                m_last_read_record_batch, m_field_locations, m_pool, m_vbz_dictionary},
             m_last_access_index++});
     return inserted.first->second.item;
 }
 
+Result<SignalTableRecordBatch> SignalTableReader::read_and_check_record_batch(
+    std::size_t i,
+    BatchChecksumReport & report) const
+{
+    auto const checked_bytes = check_record_batch(i, "signal", report);
+    std::shared_ptr<arrow::RecordBatch> record_batch;
+    {
+        std::lock_guard<std::mutex> l(m_batch_get_mutex);
+        ARROW_ASSIGN_OR_RAISE(record_batch, decode_record_batch(i, checked_bytes));
+    }
+    return SignalTableRecordBatch{record_batch, m_field_locations, m_pool, m_vbz_dictionary};
+}
+
 Result<std::size_t> SignalTableReader::signal_batch_for_row_id(
     std::uint64_t row,
     std::size_t * batch_row) const
@@ -258,16 +304,80 @@ Result<std::size_t> SignalTableReader::extract_sample_count(
         ARROW_ASSIGN_OR_RAISE(
             auto const signal_batch_index, signal_batch_for_row_id(signal_row, &batch_row));
 
-        ARROW_ASSIGN_OR_RAISE(auto const & signal_batch, read_record_batch(signal_batch_index));
-        auto const & samples_column = signal_batch.samples_column();
-        sample_count += samples_column->Value(batch_row);
+        ARROW_ASSIGN_OR_RAISE(auto const row_counts, batch_row_counts(signal_batch_index));
+        if (batch_row >= row_counts->sample_counts.size()) {
+            return Status::Invalid("Row outside batch bounds");
+        }
+        sample_count += row_counts->sample_counts[batch_row];
     }
     return sample_count;
 }
 
+Result<std::size_t> SignalTableReader::extract_samples_byte_count(
+    gsl::span<std::uint64_t const> const & row_indices) const
+{
+    std::size_t byte_count = 0;
+    for (auto const & signal_row : row_indices) {
+        std::size_t batch_row = 0;
+        ARROW_ASSIGN_OR_RAISE(
+            auto const signal_batch_index, signal_batch_for_row_id(signal_row, &batch_row));
+
+        ARROW_ASSIGN_OR_RAISE(auto const row_counts, batch_row_counts(signal_batch_index));
+        if (batch_row >= row_counts->byte_counts.size()) {
+            return Status::Invalid("Row outside batch bounds");
+        }
+        byte_count += row_counts->byte_counts[batch_row];
+    }
+    return byte_count;
+}
+
+Result<std::shared_ptr<SignalTableReader::BatchRowCounts const>>
+SignalTableReader::batch_row_counts(std::size_t batch_index) const
+{
+    {
+        std::lock_guard<std::mutex> l(m_row_counts_mutex);
+        if (batch_index >= m_batch_row_counts.size()) {
+            return Status::Invalid("Batch index ", batch_index, " out of range");
+        }
+        if (m_batch_row_counts[batch_index]) {
+            return m_batch_row_counts[batch_index];
+        }
+    }
+
+    // Read the batch bypassing the batch cache - only the samples column and the signal offsets
+    // are touched, not the signal data itself.
+    std::shared_ptr<arrow::RecordBatch> record_batch;
+    {
+        std::lock_guard<std::mutex> l(m_batch_get_mutex);
+        ARROW_ASSIGN_OR_RAISE(record_batch, read_checked_record_batch(batch_index));
+    }
+    SignalTableRecordBatch const signal_batch{
+        record_batch, m_field_locations, m_pool, m_vbz_dictionary};
+
+    auto counts = std::make_shared<BatchRowCounts>();
+    auto const samples_column = signal_batch.samples_column();
+    counts->sample_counts.assign(
+        samples_column->raw_values(), samples_column->raw_values() + samples_column->length());
+    counts->byte_counts.resize(signal_batch.num_rows());
+    for (std::size_t row = 0; row < signal_batch.num_rows(); ++row) {
+        ARROW_ASSIGN_OR_RAISE(counts->byte_counts[row], signal_batch.samples_byte_count(row));
+    }
+
+    std::lock_guard<std::mutex> l(m_row_counts_mutex);
+    m_batch_row_counts[batch_index] = counts;
+    return counts;
+}
+
 Status SignalTableReader::extract_samples(
     gsl::span<std::uint64_t const> const & row_indices,
     gsl::span<std::int16_t> const & output_samples) const
+{
+    return extract_counted_samples(row_indices, output_samples).status();
+}
+
+Result<std::size_t> SignalTableReader::extract_counted_samples(
+    gsl::span<std::uint64_t const> const & row_indices,
+    gsl::span<std::int16_t> const & output_samples) const
 {
     std::size_t sample_count = 0;
 
@@ -288,7 +398,7 @@ Status SignalTableReader::extract_samples(
         ARROW_RETURN_NOT_OK(signal_batch.extract_signal_row(
             batch_row, output_samples.subspan(sample_start, row_samples_count)));
     }
-    return Status::OK();
+    return sample_count;
 }
 
 Result<std::vector<std::shared_ptr<arrow::Buffer>>> SignalTableReader::extract_samples_inplace(
@@ -319,12 +429,16 @@ SignalType SignalTableReader::signal_type() const { return m_field_locations.sig
 Result<SignalTableReader> make_signal_table_reader(
     std::shared_ptr<arrow::io::RandomAccessFile> const & input,
     std::size_t max_cached_table_batches,
-    arrow::MemoryPool * pool)
+    arrow::MemoryPool * pool,
+    std::shared_ptr<VbzDictionary const> const & vbz_dictionary)
 {
     arrow::ipc::IpcReadOptions options;
     options.memory_pool = pool;
 
-    ARROW_ASSIGN_OR_RAISE(auto reader, arrow::ipc::RecordBatchFileReader::Open(input, options));
+    // Read through a file which can serve batches from the bytes read to verify them:
+    auto const table_input = std::make_shared<PinnedBufferFile>(input);
+    ARROW_ASSIGN_OR_RAISE(
+        auto reader, arrow::ipc::RecordBatchFileReader::Open(table_input, options));
 
     auto read_metadata_key_values = reader->schema()->metadata();
     if (!read_metadata_key_values) {
@@ -342,14 +456,15 @@ Result<SignalTableReader> make_signal_table_reader(
     }
 
     return SignalTableReader(
-        {input},
+        table_input,
         std::move(reader),
         field_locations,
         std::move(read_metadata),
         num_record_batches,
         batch_size,
         max_cached_table_batches,
-        pool);
+        pool,
+        vbz_dictionary);
 }
 
 }  // namespace pod5
@@ -15,6 +15,7 @@
 #include <atomic>
 #include <mutex>
 #include <unordered_map>
+#include <vector>
 
 namespace arrow {
 class Schema;
@@ -31,13 +32,15 @@ class RecordBatchFileReader;
 namespace pod5 {
 
 struct SignalTableReaderCacheCleaner;
+class VbzDictionary;
 
 class POD5_FORMAT_EXPORT SignalTableRecordBatch : public TableRecordBatch {
 public:
     SignalTableRecordBatch(
         std::shared_ptr<arrow::RecordBatch> const & batch,
         SignalTableSchemaDescription field_locations,
-        arrow::MemoryPool * pool);
+        arrow::MemoryPool * pool,
+        std::shared_ptr<VbzDictionary const> const & vbz_dictionary = nullptr);
 
     std::shared_ptr<UuidArray> read_id_column() const;
     std::shared_ptr<arrow::LargeListArray> uncompressed_signal_column() const;
@@ -46,6 +49,10 @@ public:
 
     Result<std::size_t> samples_byte_count(std::size_t row_index) const;
 
+    /// \brief Find the most samples the stored signal of a row can hold, without decoding it.
+    /// \details Used to check a row's stored sample count before space is allocated for it.
+    Result<std::size_t> max_samples_in_row(std::size_t row_index) const;
+
     /// \brief Extract a row of sample data into [samples], decompressing if required.
     Status extract_signal_row(std::size_t row_index, gsl::span<std::int16_t> samples) const;
     Result<std::shared_ptr<arrow::Buffer>> extract_signal_row_inplace(std::size_t row_index) const;
@@ -53,25 +60,35 @@ public:
 private:
     SignalTableSchemaDescription m_field_locations;
     arrow::MemoryPool * m_pool;
+    std::shared_ptr<VbzDictionary const> m_vbz_dictionary;
 };
 
 class POD5_FORMAT_EXPORT SignalTableReader : public TableReader {
 public:
     SignalTableReader(
-        std::shared_ptr<void> && input_source,
+        std::shared_ptr<arrow::io::RandomAccessFile> const & input_source,
         std::shared_ptr<arrow::ipc::RecordBatchFileReader> && reader,
         SignalTableSchemaDescription field_locations,
         SchemaMetadataDescription && schema_metadata,
         std::size_t num_record_batches,
         std::size_t batch_size,
         std::size_t max_cached_table_batches,
-        arrow::MemoryPool * pool);
+        arrow::MemoryPool * pool,
+        std::shared_ptr<VbzDictionary const> const & vbz_dictionary = nullptr);
 
     SignalTableReader(SignalTableReader &&);
     SignalTableReader & operator=(SignalTableReader &&);
 
     Result<SignalTableRecordBatch> read_record_batch(std::size_t i) const;
 
+    /// \brief Read record batch [i] bypassing the batch cache, first checking it against its
+    ///        stored checksum whatever the verification setting, and adding the outcome to
+    ///        [report]. A batch passing the check is decoded from the checked bytes, so is only
+    ///        read from the file once.
+    Result<SignalTableRecordBatch> read_and_check_record_batch(
+        std::size_t i,
+        BatchChecksumReport & report) const;
+
     Result<std::size_t> signal_batch_for_row_id(std::uint64_t row, std::size_t * batch_row) const;
 
     /// \brief Find the number of samples in a given list of rows.
@@ -80,6 +97,12 @@ public:
     Result<std::size_t> extract_sample_count(
         gsl::span<std::uint64_t const> const & row_indices) const;
 
+    /// \brief Find the number of bytes stored for a given list of rows.
+    /// \param row_indices      The rows to query for stored size.
+    /// \returns The sum of the stored (compressed, if applicable) signal sizes of all input rows.
+    Result<std::size_t> extract_samples_byte_count(
+        gsl::span<std::uint64_t const> const & row_indices) const;
+
     /// \brief Extract the samples for a list of rows.
     /// \param row_indices      The rows to query for samples.
     /// \param output_samples   The output samples from the rows. Data in the vector is cleared before appending.
@@ -87,6 +110,12 @@ public:
         gsl::span<std::uint64_t const> const & row_indices,
         gsl::span<std::int16_t> const & output_samples) const;
 
+    /// \brief Extract the samples for a list of rows, as extract_samples().
+    /// \returns The number of samples extracted.
+    Result<std::size_t> extract_counted_samples(
+        gsl::span<std::uint64_t const> const & row_indices,
+        gsl::span<std::int16_t> const & output_samples) const;
+
     /// \brief Extract the samples as written in the arrow table for a list of rows.
     /// \param row_indices      The rows to query for samples.
     Result<std::vector<std::shared_ptr<arrow::Buffer>>> extract_samples_inplace(
@@ -96,9 +125,24 @@ public:
     /// \brief Find the signal type of this writer
     SignalType signal_type() const;
 
+    /// \brief Find the dictionary vbz signal in the table was compressed with, null if none was.
+    std::shared_ptr<VbzDictionary const> const & vbz_dictionary() const { return m_vbz_dictionary; }
+
 private:
+    /// Sample and stored byte counts of every row in a batch.
+    struct BatchRowCounts {
+        std::vector<std::uint32_t> sample_counts;
+        std::vector<std::uint64_t> byte_counts;
+    };
+
+    /// Find the row counts of a batch, loading them on first use.
+    /// \note Counts are kept separately to the batch cache, so count queries neither evict cached
+    ///       batches nor reload batches that were evicted.
+    Result<std::shared_ptr<BatchRowCounts const>> batch_row_counts(std::size_t batch_index) const;
+
     SignalTableSchemaDescription m_field_locations;
     arrow::MemoryPool * m_pool;
+    std::shared_ptr<VbzDictionary const> m_vbz_dictionary;
     std::size_t m_max_cached_table_batches;
 
     mutable std::size_t m_last_read_record_batch_index = -1;
@@ -116,14 +160,20 @@ private:
 
     mutable AccessIndex m_last_access_index = 0;
 
+    mutable std::mutex m_row_counts_mutex;
+    mutable std::vector<std::shared_ptr<BatchRowCounts const>> m_batch_row_counts;
+
     std::size_t m_batch_size;
 
     friend struct SignalTableReaderCacheCleaner;
 };
 
+/// \brief Make a new reader for a signal table.
+/// \param vbz_dictionary The dictionary vbz signal in the table was compressed with, if any.
 POD5_FORMAT_EXPORT Result<SignalTableReader> make_signal_table_reader(
     std::shared_ptr<arrow::io::RandomAccessFile> const & sink,
     std::size_t max_cached_table_batches,
-    arrow::MemoryPool * pool);
+    arrow::MemoryPool * pool,
+    std::shared_ptr<VbzDictionary const> const & vbz_dictionary = nullptr);
 
 }  // namespace pod5
@@ -10,13 +10,16 @@ namespace pod5 {
 std::shared_ptr<arrow::Schema> make_signal_table_schema(
     SignalType signal_type,
     std::shared_ptr<const arrow::KeyValueMetadata> const & metadata,
-    SignalTableSchemaDescription * field_locations)
+    SignalTableSchemaDescription * field_locations,
+    bool vbz_dictionary)
 {
     auto const uuid_type = uuid();
 
     if (field_locations) {
         *field_locations = {};
         field_locations->signal_type = signal_type;
+        field_locations->vbz_dictionary =
+            signal_type == SignalType::VbzSignal && vbz_dictionary;
     }
 
     std::shared_ptr<arrow::DataType> signal_schema_type;
@@ -25,7 +28,7 @@ std::shared_ptr<arrow::Schema> make_signal_table_schema(
         signal_schema_type = arrow::large_list(arrow::int16());
         break;
     case SignalType::VbzSignal:
-        signal_schema_type = vbz_signal();
+        signal_schema_type = vbz_dictionary ? vbz_dictionary_signal() : vbz_signal();
         break;
     }
 
@@ -46,6 +49,7 @@ Result<SignalTableSchemaDescription> read_signal_table_schema(
 
     ARROW_ASSIGN_OR_RAISE(auto signal_field_idx, find_field_untyped(schema, "signal"));
     SignalType signal_type = SignalType::UncompressedSignal;
+    bool vbz_dictionary = false;
     {
         auto const signal_field = schema->field(signal_field_idx);
 
@@ -58,6 +62,9 @@ Result<SignalTableSchemaDescription> read_signal_table_schema(
             }
         } else if (signal_arrow_type->Equals(vbz_signal())) {
             signal_type = SignalType::VbzSignal;
+        } else if (signal_arrow_type->Equals(vbz_dictionary_signal())) {
+            signal_type = SignalType::VbzSignal;
+            vbz_dictionary = true;
         } else {
             return Status::TypeError(
                 "Schema field 'signal' is incorrect type: '", signal_arrow_type->name(), "'");
@@ -65,7 +72,7 @@ Result<SignalTableSchemaDescription> read_signal_table_schema(
     }
 
     return SignalTableSchemaDescription{
-        signal_type, read_id_field_idx, signal_field_idx, samples_field_idx};
+        signal_type, read_id_field_idx, signal_field_idx, samples_field_idx, vbz_dictionary};
 }
 
 }  // namespace pod5
@@ -19,17 +19,22 @@ struct SignalTableSchemaDescription {
     int read_id = 0;
     int signal = 1;
     int samples = 2;
+
+    /// Whether vbz signal in the table may be compressed with the file's signal dictionary.
+    bool vbz_dictionary = false;
 };
 
 /// \brief Make a new schema for a signal table.
 /// \param signal_type The type of signal to use.
 /// \param metadata Metadata to be applied to the schema.
 /// \param field_locations [optional] The signal table field locations, for use when writing to the table.
+/// \param vbz_dictionary Whether vbz signal may be compressed with the file's signal dictionary.
 /// \returns The schema for a signal table.
 POD5_FORMAT_EXPORT std::shared_ptr<arrow::Schema> make_signal_table_schema(
     SignalType signal_type,
     std::shared_ptr<const arrow::KeyValueMetadata> const & metadata,
-    SignalTableSchemaDescription * field_locations);
+    SignalTableSchemaDescription * field_locations,
+    bool vbz_dictionary = false);
 
 POD5_FORMAT_EXPORT Result<SignalTableSchemaDescription> read_signal_table_schema(
     std::shared_ptr<arrow::Schema> const &);
@@ -1,6 +1,7 @@
 #include "pod5_format/signal_table_writer.h"
 
 #include "pod5_format/errors.h"
+#include "pod5_format/internal/batch_checksum_output_stream.h"
 #include "pod5_format/internal/tracing/tracing.h"
 #include "pod5_format/types.h"
 
@@ -17,6 +18,7 @@ namespace pod5 {
 
 SignalTableWriter::SignalTableWriter(
     std::shared_ptr<arrow::ipc::RecordBatchWriter> && writer,
+    std::shared_ptr<BatchChecksumOutputStream> && checksum_stream,
     std::shared_ptr<arrow::Schema> && schema,
     SignalBuilderVariant && signal_builder,
     SignalTableSchemaDescription const & field_locations,
@@ -29,6 +31,7 @@ SignalTableWriter::SignalTableWriter(
 , m_output_stream{output_stream}
 , m_table_batch_size(table_batch_size)
 , m_writer(std::move(writer))
+, m_checksum_stream(std::move(checksum_stream))
 , m_signal_builder(std::move(signal_builder))
 {
     m_read_id_builder = make_read_id_builder(m_pool);
@@ -54,11 +57,31 @@ Result<SignalTableRowIndex> SignalTableWriter::add_signal(
         return Status::IOError("Writer terminated");
     }
 
+    if (m_dictionary_training_size != 0) {
+        // No rows are added until training is complete, so held rows take the first row ids:
+        auto row_id = m_training_rows.size();
+        m_training_rows.push_back({read_id, {signal.begin(), signal.end()}});
+        m_training_bytes += signal.size() * sizeof(std::int16_t);
+        if (m_training_bytes >= m_dictionary_training_size) {
+            ARROW_RETURN_NOT_OK(finish_dictionary_training());
+        }
+        return row_id;
+    }
+
     auto row_id = m_written_batched_row_count + m_current_batch_row_count;
     ARROW_RETURN_NOT_OK(m_read_id_builder->Append(read_id.begin()));
 
+    auto const sample_bytes = signal.size() * sizeof(std::int16_t);
+    auto const size_before = boost::apply_visitor(visitors::signal_data_size{}, m_signal_builder);
+    auto const compress_start = AdaptiveCompressionLevel::Clock::now();
     ARROW_RETURN_NOT_OK(
         boost::apply_visitor(visitors::append_signal{signal, m_pool}, m_signal_builder));
+    auto const compress_end = AdaptiveCompressionLevel::Clock::now();
+    record_compressed_row(
+        sample_bytes,
+        boost::apply_visitor(visitors::signal_data_size{}, m_signal_builder) - size_before,
+        compress_end - compress_start,
+        compress_end);
 
     ARROW_RETURN_NOT_OK(m_samples_builder->Append(signal.size()));
     ++m_current_batch_row_count;
@@ -79,6 +102,7 @@ Result<SignalTableRowIndex> SignalTableWriter::add_pre_compressed_signal(
     if (!m_writer) {
         return Status::IOError("Writer terminated");
     }
+    ARROW_RETURN_NOT_OK(finish_dictionary_training());
 
     auto row_id = m_written_batched_row_count + m_current_batch_row_count;
     ARROW_RETURN_NOT_OK(m_read_id_builder->Append(read_id.begin()));
@@ -106,6 +130,7 @@ SignalTableWriter::add_signal_batch(
     if (!m_writer) {
         return Status::Invalid("Unable to write batches, writer is closed.");
     }
+    ARROW_RETURN_NOT_OK(finish_dictionary_training());
 
     if (m_current_batch_row_count != 0) {
         return Status::Invalid("Unable to write batches directly and using per read methods");
@@ -116,7 +141,7 @@ SignalTableWriter::add_signal_batch(
     }
 
     auto const record_batch = arrow::RecordBatch::Make(m_schema, row_count, std::move(columns));
-    ARROW_RETURN_NOT_OK(m_writer->WriteRecordBatch(*record_batch));
+    ARROW_RETURN_NOT_OK(m_checksum_stream->write_record_batch(*m_writer, *record_batch));
     if (final_batch) {
         ARROW_RETURN_NOT_OK(close());
     }
@@ -126,6 +151,11 @@ SignalTableWriter::add_signal_batch(
     return std::make_pair(first_row_id, m_written_batched_row_count);
 }
 
+std::vector<BatchChecksum> const & SignalTableWriter::batch_checksums() const
+{
+    return m_checksum_stream->checksums();
+}
+
 Status SignalTableWriter::close()
 {
     // Check for already closed
@@ -133,6 +163,7 @@ Status SignalTableWriter::close()
         return Status::OK();
     }
 
+    ARROW_RETURN_NOT_OK(finish_dictionary_training());
     ARROW_RETURN_NOT_OK(write_batch());
 
     ARROW_RETURN_NOT_OK(m_writer->Close());
@@ -142,9 +173,124 @@ Status SignalTableWriter::close()
 
 SignalType SignalTableWriter::signal_type() const { return m_field_locations.signal_type; }
 
+Status SignalTableWriter::set_vbz_compression(
+    int compression_level,
+    std::shared_ptr<VbzDictionary const> const & dictionary)
+{
+    ARROW_ASSIGN_OR_RAISE(auto builder, vbz_builder_before_first_row());
+    if (dictionary && !m_field_locations.vbz_dictionary) {
+        return Status::Invalid("Signal table was not created for dictionary compressed signal");
+    }
+    builder->compression_level = compression_level;
+    builder->dictionary = dictionary;
+    m_dictionary_training_size = 0;
+    m_adaptive_level = nullptr;
+    return Status::OK();
+}
+
+Status SignalTableWriter::train_vbz_dictionary(
+    std::size_t training_size,
+    std::size_t max_dictionary_size)
+{
+    ARROW_ASSIGN_OR_RAISE(auto builder, vbz_builder_before_first_row());
+    if (!m_field_locations.vbz_dictionary) {
+        return Status::Invalid("Signal table was not created for dictionary compressed signal");
+    }
+    builder->dictionary = nullptr;
+    m_adaptive_level = nullptr;
+    m_dictionary_training_size = training_size;
+    m_max_dictionary_size = max_dictionary_size;
+    return Status::OK();
+}
+
+std::shared_ptr<VbzDictionary const> SignalTableWriter::vbz_dictionary() const
+{
+    auto const builder = boost::get<VbzSignalBuilder>(&m_signal_builder);
+    if (!builder) {
+        return nullptr;
+    }
+    return builder->dictionary;
+}
+
+Status SignalTableWriter::set_adaptive_vbz_compression(int min_level, int max_level)
+{
+    ARROW_ASSIGN_OR_RAISE(auto builder, vbz_builder_before_first_row());
+    if (builder->dictionary || m_dictionary_training_size != 0) {
+        return Status::Invalid("Adaptive compression levels are not supported with a dictionary");
+    }
+    m_adaptive_level = std::make_unique<AdaptiveCompressionLevel>(
+        min_level, max_level, builder->compression_level);
+    builder->compression_level = m_adaptive_level->level();
+    return Status::OK();
+}
+
+void SignalTableWriter::record_compressed_row(
+    std::size_t sample_bytes,
+    std::size_t compressed_bytes,
+    AdaptiveCompressionLevel::Clock::duration compression_time,
+    AdaptiveCompressionLevel::Clock::time_point now)
+{
+    m_compression_metrics.sample_bytes += sample_bytes;
+    m_compression_metrics.compressed_bytes += compressed_bytes;
+    m_compression_metrics.compression_seconds +=
+        std::chrono::duration<double>(compression_time).count();
+
+    auto const builder = boost::get<VbzSignalBuilder>(&m_signal_builder);
+    if (builder) {
+        m_compression_metrics.rows_per_level[builder->compression_level] += 1;
+    }
+    if (m_adaptive_level) {
+        m_adaptive_level->add_row(sample_bytes, compression_time, now);
+    }
+}
+
+Result<VbzSignalBuilder *> SignalTableWriter::vbz_builder_before_first_row()
+{
+    auto const builder = boost::get<VbzSignalBuilder>(&m_signal_builder);
+    if (!builder) {
+        return Status::Invalid("Vbz compression options only apply to vbz signal");
+    }
+    if (m_written_batched_row_count + m_current_batch_row_count + m_training_rows.size() != 0) {
+        return Status::Invalid("Vbz compression options must be set before signal is added");
+    }
+    return builder;
+}
+
+Status SignalTableWriter::finish_dictionary_training()
+{
+    if (m_dictionary_training_size == 0) {
+        return Status::OK();
+    }
+    m_dictionary_training_size = 0;
+
+    std::vector<gsl::span<std::int16_t const>> samples;
+    samples.reserve(m_training_rows.size());
+    for (auto const & row : m_training_rows) {
+        samples.push_back(gsl::make_span(row.signal));
+    }
+
+    // Too little signal to train on leaves signal compressed without a dictionary:
+    auto dictionary_data = pod5::train_vbz_dictionary(samples, m_max_dictionary_size, m_pool);
+    if (dictionary_data.ok()) {
+        auto & builder = boost::get<VbzSignalBuilder>(m_signal_builder);
+        ARROW_ASSIGN_OR_RAISE(
+            builder.dictionary,
+            VbzDictionary::make(*dictionary_data, builder.compression_level));
+    }
+
+    auto training_rows = std::move(m_training_rows);
+    m_training_rows.clear();
+    m_training_bytes = 0;
+    for (auto const & row : training_rows) {
+        ARROW_RETURN_NOT_OK(add_signal(row.read_id, gsl::make_span(row.signal)));
+    }
+    return Status::OK();
+}
+
 Status SignalTableWriter::write_batch(arrow::RecordBatch const & record_batch)
 {
-    ARROW_RETURN_NOT_OK(m_writer->WriteRecordBatch(record_batch));
+    ARROW_RETURN_NOT_OK(finish_dictionary_training());
+    ARROW_RETURN_NOT_OK(m_checksum_stream->write_record_batch(*m_writer, record_batch));
     return m_output_stream->Flush();
 }
 
@@ -172,7 +318,12 @@ Status SignalTableWriter::write_batch()
     m_written_batched_row_count += m_current_batch_row_count;
     m_current_batch_row_count = 0;
 
-    ARROW_RETURN_NOT_OK(m_writer->WriteRecordBatch(*record_batch));
+    if (m_adaptive_level) {
+        boost::get<VbzSignalBuilder>(m_signal_builder).compression_level =
+            m_adaptive_level->finish_batch(AdaptiveCompressionLevel::Clock::now());
+    }
+
+    ARROW_RETURN_NOT_OK(m_checksum_stream->write_record_batch(*m_writer, *record_batch));
     ARROW_RETURN_NOT_OK(m_output_stream->Flush());
 
     // Reserve space for next batch:
@@ -195,20 +346,31 @@ Result<SignalTableWriter> make_signal_table_writer(
     std::shared_ptr<const arrow::KeyValueMetadata> const & metadata,
     std::size_t table_batch_size,
     SignalType compression_type,
-    arrow::MemoryPool * pool)
+    arrow::MemoryPool * pool,
+    std::uint32_t batch_alignment,
+    std::int64_t sink_offset,
+    bool vbz_dictionary)
 {
     SignalTableSchemaDescription field_locations;
-    auto schema = make_signal_table_schema(compression_type, metadata, &field_locations);
+    auto schema =
+        make_signal_table_schema(compression_type, metadata, &field_locations, vbz_dictionary);
 
     arrow::ipc::IpcWriteOptions options;
     options.memory_pool = pool;
 
-    ARROW_ASSIGN_OR_RAISE(auto writer, arrow::ipc::MakeFileWriter(sink, schema, options, metadata));
+    std::shared_ptr<BatchChecksumOutputStream> checksum_stream;
+    ARROW_ASSIGN_OR_RAISE(
+        auto writer,
+        make_checksummed_file_writer(
+            sink, schema, options, metadata, &checksum_stream, batch_alignment, sink_offset));
 
-    ARROW_ASSIGN_OR_RAISE(auto signal_builder, make_signal_builder(compression_type, pool));
+    ARROW_ASSIGN_OR_RAISE(
+        auto signal_builder,
+        make_signal_builder(compression_type, pool, field_locations.vbz_dictionary));
 
     auto signal_table_writer = SignalTableWriter(
         std::move(writer),
+        std::move(checksum_stream),
         std::move(schema),
         std::move(signal_builder),
         field_locations,
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "pod5_format/adaptive_compression_level.h"
+#include "pod5_format/batch_checksum.h"
 #include "pod5_format/pod5_format_export.h"
 #include "pod5_format/result.h"
 #include "pod5_format/signal_builder.h"
@@ -10,6 +12,8 @@
 #include <boost/variant/variant.hpp>
 #include <gsl/gsl-lite.hpp>
 
+#include <vector>
+
 namespace arrow {
 class Schema;
 
@@ -24,10 +28,13 @@ class RecordBatchWriter;
 
 namespace pod5 {
 
+class BatchChecksumOutputStream;
+
 class POD5_FORMAT_EXPORT SignalTableWriter {
 public:
     SignalTableWriter(
         std::shared_ptr<arrow::ipc::RecordBatchWriter> && writer,
+        std::shared_ptr<BatchChecksumOutputStream> && checksum_stream,
         std::shared_ptr<arrow::Schema> && schema,
         SignalBuilderVariant && signal_builder,
         SignalTableSchemaDescription const & field_locations,
@@ -76,6 +83,41 @@ public:
     /// \brief Find the signal type of this writer
     SignalType signal_type() const;
 
+    /// \brief Set the zstd level vbz signal is compressed at, and the dictionary it is compressed
+    ///        with (at the dictionary's level), if any. Replaces any dictionary training or
+    ///        adaptive levels requested.
+    /// \note Only valid for writers of vbz signal, before any signal is added, and a dictionary
+    ///       only for writers made for dictionary compressed signal.
+    Status set_vbz_compression(
+        int compression_level,
+        std::shared_ptr<VbzDictionary const> const & dictionary);
+
+    /// \brief Train a vbz dictionary on the first [training_size] bytes of samples added, then
+    ///        compress all signal with it.
+    /// \details Rows are held uncompressed until enough samples have arrived to train on, or until
+    ///          pre-compressed signal or a batch is added, or the writer is closed. If training
+    ///          fails (eg. on too little signal) signal is compressed without a dictionary.
+    /// \param max_dictionary_size The maximum size in bytes of the trained dictionary.
+    /// \note Only valid for writers of vbz signal made for dictionary compressed signal, before
+    ///       any signal is added.
+    Status train_vbz_dictionary(std::size_t training_size, std::size_t max_dictionary_size);
+
+    /// \brief Find the dictionary vbz signal is compressed with, null if none is used (or one is
+    ///        still to be trained).
+    std::shared_ptr<VbzDictionary const> vbz_dictionary() const;
+
+    /// \brief Pick the zstd level vbz signal is compressed at for each batch, between [min_level]
+    ///        and [max_level], from how far the writer is falling behind (see
+    ///        AdaptiveCompressionLevel).
+    /// \note Only valid for writers of vbz signal without a dictionary, before any signal is added.
+    Status set_adaptive_vbz_compression(int min_level, int max_level);
+
+    /// \brief Find the measurements of the signal compressed so far.
+    SignalCompressionMetrics const & compression_metrics() const { return m_compression_metrics; }
+
+    /// \brief Find the checksum of each record batch written so far, stored by the file footer.
+    std::vector<BatchChecksum> const & batch_checksums() const;
+
     /// \brief Reserve space for future row writes, called automatically when a flush occurs.
     Status reserve_rows();
 
@@ -89,6 +131,24 @@ private:
     /// \brief Flush buffered data into the writer as a record batch.
     Status write_batch();
 
+    /// \brief Check vbz compression can still be changed, returning the builder to change.
+    Result<VbzSignalBuilder *> vbz_builder_before_first_row();
+
+    /// \brief Train the vbz dictionary on the rows held for it, then add those rows.
+    Status finish_dictionary_training();
+
+    /// \brief Record a row compressed by the writer in the metrics and adaptive level.
+    void record_compressed_row(
+        std::size_t sample_bytes,
+        std::size_t compressed_bytes,
+        AdaptiveCompressionLevel::Clock::duration compression_time,
+        AdaptiveCompressionLevel::Clock::time_point now);
+
+    struct TrainingRow {
+        boost::uuids::uuid read_id;
+        std::vector<std::int16_t> signal;
+    };
+
     arrow::MemoryPool * m_pool = nullptr;
     std::shared_ptr<arrow::Schema> m_schema;
     SignalTableSchemaDescription m_field_locations;
@@ -96,6 +156,7 @@ private:
     std::size_t m_table_batch_size;
 
     std::shared_ptr<arrow::ipc::RecordBatchWriter> m_writer;
+    std::shared_ptr<BatchChecksumOutputStream> m_checksum_stream;
 
     std::unique_ptr<arrow::FixedSizeBinaryBuilder> m_read_id_builder;
     SignalBuilderVariant m_signal_builder;
@@ -103,6 +164,16 @@ private:
 
     std::size_t m_written_batched_row_count = 0;
     std::size_t m_current_batch_row_count = 0;
+
+    // Non-zero while rows are held to train a dictionary on:
+    std::size_t m_dictionary_training_size = 0;
+    std::size_t m_max_dictionary_size = 0;
+    std::size_t m_training_bytes = 0;
+    std::vector<TrainingRow> m_training_rows;
+
+    // Set while the vbz level is chosen per batch:
+    std::unique_ptr<AdaptiveCompressionLevel> m_adaptive_level;
+    SignalCompressionMetrics m_compression_metrics;
 };
 
 /// \brief Make a new writer for a signal table.
@@ -110,12 +181,19 @@ private:
 /// \param metadata Metadata to be applied to the table schema.
 /// \param table_batch_size The size of each batch written for the table.
 /// \param pool Pool to be used for building table in memory.
+/// \param batch_alignment If non-zero, the alignment in bytes of each batch body in the file.
+/// \param sink_offset Offset of the sink's position zero in the file, used to align batches.
+/// \param vbz_dictionary Whether vbz signal may be compressed with the file's signal dictionary,
+///        required before setting or training one.
 /// \returns The writer for the new table.
 POD5_FORMAT_EXPORT Result<SignalTableWriter> make_signal_table_writer(
     std::shared_ptr<arrow::io::OutputStream> const & sink,
     std::shared_ptr<const arrow::KeyValueMetadata> const & metadata,
     std::size_t table_batch_size,
     SignalType compression_type,
-    arrow::MemoryPool * pool);
+    arrow::MemoryPool * pool,
+    std::uint32_t batch_alignment = 0,
+    std::int64_t sink_offset = 0,
+    bool vbz_dictionary = false);
 
 }  // namespace pod5
@@ -1,8 +1,16 @@
 #include "pod5_format/table_reader.h"
 
+#include "pod5_format/internal/pinned_buffer_file.h"
+
+#include <arrow/buffer.h>
+#include <arrow/io/interfaces.h>
+#include <arrow/ipc/message.h>
 #include <arrow/ipc/reader.h>
 #include <arrow/record_batch.h>
 
+#include <cstring>
+#include <string>
+
 namespace pod5 {
 
 TableRecordBatch::TableRecordBatch(std::shared_ptr<arrow::RecordBatch> const & batch)
@@ -26,11 +34,12 @@ std::size_t TableRecordBatch::num_rows() const { return m_batch->num_rows(); }
 //---------------------------------------------------------------------------------------------------------------------
 
 TableReader::TableReader(
-    std::shared_ptr<void> && input_source,
+    std::shared_ptr<arrow::io::RandomAccessFile> const & input_source,
     std::shared_ptr<arrow::ipc::RecordBatchFileReader> && reader,
     SchemaMetadataDescription && schema_metadata,
     arrow::MemoryPool * pool)
-: m_input_source(std::move(input_source))
+: m_input_source(input_source)
+, m_pinned_input_source(std::dynamic_pointer_cast<PinnedBufferFile>(input_source))
 , m_reader(std::move(reader))
 , m_schema_metadata(std::move(schema_metadata))
 {
@@ -42,4 +51,165 @@ TableReader::~TableReader() = default;
 
 std::size_t TableReader::num_record_batches() const { return m_reader->num_record_batches(); }
 
+void TableReader::set_batch_checksums(std::vector<BatchChecksum> batch_checksums)
+{
+    m_batch_checksums_status = Status::OK();
+    auto const file_size = m_input_source->GetSize();
+    if (!file_size.ok()) {
+        m_batch_checksums_status = file_size.status();
+    } else {
+        for (auto const & checksum : batch_checksums) {
+            if (checksum.offset < 0 || checksum.length < 0
+                || checksum.offset > *file_size - checksum.length)
+            {
+                m_batch_checksums_status = Status::IOError(
+                    "Invalid batch checksum range ",
+                    checksum.offset,
+                    "+",
+                    checksum.length,
+                    " for a table of ",
+                    *file_size,
+                    " bytes");
+                break;
+            }
+        }
+    }
+    m_batch_checksums = std::move(batch_checksums);
+}
+
+BatchChecksum const * TableReader::batch_checksum(std::size_t i) const
+{
+    if (i >= m_batch_checksums.size()) {
+        return nullptr;
+    }
+    return &m_batch_checksums[i];
+}
+
+Result<std::vector<std::int64_t>> TableReader::record_batch_offsets() const
+{
+    // Messages follow the padded file magic, each prefixed by a continuation token and length:
+    std::int64_t const FILE_MAGIC_SIZE = 8;
+    std::int64_t const PREFIX_SIZE = 8;
+    ARROW_ASSIGN_OR_RAISE(auto const file_size, m_input_source->GetSize());
+
+    std::vector<std::int64_t> offsets;
+    std::int64_t position = FILE_MAGIC_SIZE;
+    bool schema_message = true;
+    while (position + PREFIX_SIZE <= file_size) {
+        ARROW_ASSIGN_OR_RAISE(auto const prefix, m_input_source->ReadAt(position, PREFIX_SIZE));
+        if (prefix->size() < PREFIX_SIZE) {
+            break;
+        }
+        std::int32_t continuation = 0;
+        std::int32_t metadata_length = 0;
+        std::memcpy(&continuation, prefix->data(), sizeof(continuation));
+        std::memcpy(
+            &metadata_length, prefix->data() + sizeof(continuation), sizeof(metadata_length));
+        // A zero length marks the end of the stream, before the file footer:
+        if (continuation != -1 || metadata_length <= 0) {
+            break;
+        }
+
+        ARROW_ASSIGN_OR_RAISE(
+            auto const message_start,
+            m_input_source->ReadAt(position, PREFIX_SIZE + metadata_length));
+        std::unique_ptr<arrow::ipc::Message> message;
+        arrow::ipc::MessageDecoder decoder(
+            std::make_shared<arrow::ipc::AssignMessageDecoderListener>(&message));
+        ARROW_RETURN_NOT_OK(decoder.Consume(message_start));
+        // Messages without a body are decoded immediately, otherwise the decoder waits for it:
+        std::int64_t const body_length =
+            decoder.state() == arrow::ipc::MessageDecoder::State::BODY
+                ? decoder.next_required_size()
+                : 0;
+
+        if (!schema_message) {
+            offsets.push_back(position);
+        }
+        schema_message = false;
+        position += PREFIX_SIZE + metadata_length + body_length;
+    }
+
+    if (offsets.size() != num_record_batches()) {
+        return Status::Invalid(
+            "Found ",
+            offsets.size(),
+            " messages for ",
+            num_record_batches(),
+            " record batches, tables with dictionary batches can't be walked");
+    }
+    return offsets;
+}
+
+Result<std::shared_ptr<arrow::Buffer>> TableReader::read_checked_batch_bytes(std::size_t i) const
+{
+    ARROW_RETURN_NOT_OK(m_batch_checksums_status);
+    if (i >= num_record_batches()) {
+        return Status::IndexError(
+            "Invalid record batch index ", i, " of ", num_record_batches(), " batches");
+    }
+
+    auto const checksum = batch_checksum(i);
+    if (!checksum) {
+        return std::shared_ptr<arrow::Buffer>{};
+    }
+
+    auto bytes = read_checked_bytes(*m_input_source, *checksum);
+    if (!bytes.ok()) {
+        return bytes.status().WithMessage("Record batch ", i, ": ", bytes.status().message());
+    }
+    return bytes;
+}
+
+Status TableReader::verify_record_batch(std::size_t i) const
+{
+    return read_checked_batch_bytes(i).status();
+}
+
+std::shared_ptr<arrow::Buffer> TableReader::check_record_batch(
+    std::size_t i,
+    char const * table_name,
+    BatchChecksumReport & report) const
+{
+    auto bytes = read_checked_batch_bytes(i);
+    if (!bytes.ok()) {
+        report.failures.push_back(std::string(table_name) + " table: " + bytes.status().message());
+        return nullptr;
+    }
+    if (!*bytes) {
+        report.unchecked_batch_count += 1;
+        return nullptr;
+    }
+    report.checked_batch_count += 1;
+    report.checked_byte_count += (*bytes)->size();
+    return std::move(*bytes);
+}
+
+Result<std::shared_ptr<arrow::RecordBatch>> TableReader::read_checked_record_batch(
+    std::size_t i) const
+{
+    if (!m_verify_batch_checksums) {
+        return m_reader->ReadRecordBatch(i);
+    }
+
+    ARROW_ASSIGN_OR_RAISE(auto const bytes, read_checked_batch_bytes(i));
+    return decode_record_batch(i, bytes);
+}
+
+Result<std::shared_ptr<arrow::RecordBatch>> TableReader::decode_record_batch(
+    std::size_t i,
+    std::shared_ptr<arrow::Buffer> const & checked_bytes) const
+{
+    if (!checked_bytes || !m_pinned_input_source) {
+        return m_reader->ReadRecordBatch(i);
+    }
+
+    // The batch's messages all lie within the checked bytes, so decoding reads only from them:
+    auto const offset = batch_checksum(i)->offset;
+    m_pinned_input_source->pin(offset, checked_bytes);
+    auto batch = m_reader->ReadRecordBatch(i);
+    m_pinned_input_source->unpin(offset, checked_bytes);
+    return batch;
+}
+
 }  // namespace pod5
@@ -1,14 +1,21 @@
 #pragma once
 
+#include "pod5_format/batch_checksum.h"
 #include "pod5_format/pod5_format_export.h"
 #include "pod5_format/schema_metadata.h"
 
 #include <memory>
+#include <vector>
 
 namespace arrow {
+class Buffer;
 class MemoryPool;
 class RecordBatch;
 
+namespace io {
+class RandomAccessFile;
+}
+
 namespace ipc {
 class RecordBatchFileReader;
 }
@@ -16,6 +23,8 @@ class RecordBatchFileReader;
 
 namespace pod5 {
 
+class PinnedBufferFile;
+
 class POD5_FORMAT_EXPORT TableRecordBatch {
 public:
     TableRecordBatch(std::shared_ptr<arrow::RecordBatch> const & batch);
@@ -37,8 +46,10 @@ private:
 
 class POD5_FORMAT_EXPORT TableReader {
 public:
+    /// \note Batches are only decoded from the bytes read to verify them if [input_source] is a
+    ///       PinnedBufferFile, which [reader] reads through. Otherwise they are read twice.
     TableReader(
-        std::shared_ptr<void> && input_source,
+        std::shared_ptr<arrow::io::RandomAccessFile> const & input_source,
         std::shared_ptr<arrow::ipc::RecordBatchFileReader> && reader,
         SchemaMetadataDescription && schema_metadata,
         arrow::MemoryPool * pool);
@@ -54,10 +65,67 @@ public:
 
     std::shared_ptr<arrow::ipc::RecordBatchFileReader> const & reader() const { return m_reader; }
 
+    /// \brief Set the checksums of this table's record batches, from the file footer.
+    /// \details Checksums for ranges outside the table are reported when verification is
+    ///          attempted, so the table remains readable without verification.
+    /// \note Must be set before the reader is shared between threads.
+    void set_batch_checksums(std::vector<BatchChecksum> batch_checksums);
+
+    /// \brief Find if the writer stored checksums for this table's record batches.
+    bool has_batch_checksums() const { return !m_batch_checksums.empty(); }
+
+    /// \brief Find the checksum stored for record batch [i], nullptr if there is none.
+    BatchChecksum const * batch_checksum(std::size_t i) const;
+
+    /// \brief Check the stored bytes of record batch [i] against the checksum recorded when it was
+    ///        written.
+    /// \returns OK if the batch matches, or if no checksum was stored for it. IOError otherwise.
+    Status verify_record_batch(std::size_t i) const;
+
+    /// \brief Check record batch [i] like verify_record_batch, adding the outcome to [report].
+    /// \param table_name Name of the table, to describe a failure with.
+    /// \returns The bytes checked, to decode the batch from. Null if the batch has no checksum or
+    ///          failed the check.
+    std::shared_ptr<arrow::Buffer> check_record_batch(
+        std::size_t i,
+        char const * table_name,
+        BatchChecksumReport & report) const;
+
+    /// \brief Set if record batches should be verified against their checksums as they are read.
+    /// \note Must be set before the reader is shared between threads.
+    void set_verify_batch_checksums(bool verify) { m_verify_batch_checksums = verify; }
+
+    bool verify_batch_checksums() const { return m_verify_batch_checksums; }
+
+    /// \brief Find the offset of each record batch message within the table's file.
+    /// \details Only the prefix and metadata of each message are read, the bodies are skipped.
+    /// \note Tables written with dictionary batches can't be walked, an error is returned.
+    Result<std::vector<std::int64_t>> record_batch_offsets() const;
+
+protected:
+    /// Read record batch [i], verifying it first if verification on read was requested. A verified
+    /// batch is decoded from the bytes read to verify it.
+    /// \note Every read of a batch from the table should go through this.
+    Result<std::shared_ptr<arrow::RecordBatch>> read_checked_record_batch(std::size_t i) const;
+
+    /// Decode record batch [i], from [checked_bytes] (see check_record_batch) if not null.
+    Result<std::shared_ptr<arrow::RecordBatch>> decode_record_batch(
+        std::size_t i,
+        std::shared_ptr<arrow::Buffer> const & checked_bytes) const;
+
 private:
-    std::shared_ptr<void> m_input_source;
+    /// Read the bytes of record batch [i] and check them against its checksum.
+    /// \returns The bytes read, null if no checksum was stored for the batch.
+    Result<std::shared_ptr<arrow::Buffer>> read_checked_batch_bytes(std::size_t i) const;
+
+    std::shared_ptr<arrow::io::RandomAccessFile> m_input_source;
+    std::shared_ptr<PinnedBufferFile> m_pinned_input_source;
     std::shared_ptr<arrow::ipc::RecordBatchFileReader> m_reader;
     SchemaMetadataDescription m_schema_metadata;
+
+    Status m_batch_checksums_status;
+    std::vector<BatchChecksum> m_batch_checksums;
+    bool m_verify_batch_checksums = false;
 };
 
 }  // namespace pod5
@@ -3,6 +3,11 @@
 #include <boost/asio.hpp>
 #include <boost/optional.hpp>
 
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 namespace pod5 {
 
 class StrandImpl : public ThreadPoolStrand {
@@ -52,4 +57,48 @@ std::shared_ptr<ThreadPool> make_thread_pool(std::size_t worker_threads)
     return std::make_shared<ThreadPoolImpl>(worker_threads);
 }
 
+std::shared_ptr<ThreadPool> shared_thread_pool()
+{
+    static auto const pool =
+        make_thread_pool(std::max<std::size_t>(1, std::thread::hardware_concurrency()));
+    return pool;
+}
+
+void run_on_workers(
+    ThreadPool & thread_pool,
+    std::size_t worker_count,
+    std::function<void()> const & work)
+{
+    struct State {
+        std::mutex mutex;
+        std::condition_variable finished;
+        std::size_t running = 0;
+        bool closed = false;
+    };
+    auto const state = std::make_shared<State>();
+
+    for (std::size_t i = 1; i < worker_count; ++i) {
+        thread_pool.create_strand()->post([state, &work] {
+            {
+                std::lock_guard<std::mutex> l(state->mutex);
+                if (state->closed) {
+                    return;
+                }
+                state->running += 1;
+            }
+            work();
+            std::lock_guard<std::mutex> l(state->mutex);
+            state->running -= 1;
+            state->finished.notify_all();
+        });
+    }
+
+    work();
+
+    // [work] is only referenced by runs counted as running, which must finish before returning:
+    std::unique_lock<std::mutex> l(state->mutex);
+    state->closed = true;
+    state->finished.wait(l, [&] { return state->running == 0; });
+}
+
 }  // namespace pod5
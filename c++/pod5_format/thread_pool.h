@@ -20,4 +20,18 @@ public:
 };
 
 POD5_FORMAT_EXPORT std::shared_ptr<ThreadPool> make_thread_pool(std::size_t worker_threads);
+
+/// \brief Find the pool shared by library operations not given one, with a thread per core.
+/// \details Created on first use, and kept until the library is unloaded.
+POD5_FORMAT_EXPORT std::shared_ptr<ThreadPool> shared_thread_pool();
+
+/// \brief Run [work] on the calling thread and [worker_count] - 1 of [thread_pool]'s threads,
+///        returning once every run has finished.
+/// \details [work] should take items from a shared queue until none remain. Runs which have not
+///          started by the time the calling thread's run finishes are skipped, so this does not
+///          wait on a busy pool, and can be called from one of the pool's own threads.
+POD5_FORMAT_EXPORT void run_on_workers(
+    ThreadPool & thread_pool,
+    std::size_t worker_count,
+    std::function<void()> const & work);
 }  // namespace pod5
@@ -95,7 +95,7 @@ arrow::Result<std::shared_ptr<arrow::DataType>> VbzSignalType::Deserialize(
         return arrow::Status::Invalid(
             "Incorrect storage for VbzSignalType: '", storage_type->ToString(), "'");
     }
-    return std::make_shared<VbzSignalType>();
+    return std::make_shared<VbzSignalType>(m_dictionary_compressed);
 }
 
 std::unique_ptr<arrow::FixedSizeBinaryBuilder> make_read_id_builder(arrow::MemoryPool * pool)
@@ -115,6 +115,12 @@ std::shared_ptr<VbzSignalType> vbz_signal()
     return vbz_signal;
 }
 
+std::shared_ptr<VbzSignalType> vbz_dictionary_signal()
+{
+    static auto vbz_dictionary_signal = std::make_shared<VbzSignalType>(true);
+    return vbz_dictionary_signal;
+}
+
 std::shared_ptr<UuidType> uuid()
 {
     static auto uuid = std::make_shared<UuidType>();
@@ -128,6 +134,7 @@ pod5::Status register_extension_types()
     if (++g_pod5_register_count == 1) {
         ARROW_RETURN_NOT_OK(arrow::RegisterExtensionType(uuid()));
         ARROW_RETURN_NOT_OK(arrow::RegisterExtensionType(vbz_signal()));
+        ARROW_RETURN_NOT_OK(arrow::RegisterExtensionType(vbz_dictionary_signal()));
     }
     return pod5::Status::OK();
 }
@@ -142,6 +149,9 @@ pod5::Status unregister_extension_types()
         if (arrow::GetExtensionType("minknow.vbz")) {
             ARROW_RETURN_NOT_OK(arrow::UnregisterExtensionType("minknow.vbz"));
         }
+        if (arrow::GetExtensionType("minknow.vbz_dictionary")) {
+            ARROW_RETURN_NOT_OK(arrow::UnregisterExtensionType("minknow.vbz_dictionary"));
+        }
     }
     return pod5::Status::OK();
 }
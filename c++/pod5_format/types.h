@@ -62,9 +62,21 @@ public:
 
 class POD5_FORMAT_EXPORT VbzSignalType : public arrow::ExtensionType {
 public:
-    VbzSignalType() : ExtensionType(arrow::large_binary()) {}
+    /// \param dictionary_compressed Whether values may be compressed with the file's signal
+    ///        dictionary, which gives the type its own extension name so readers unable to
+    ///        decode it reject the column instead of failing on the first read.
+    explicit VbzSignalType(bool dictionary_compressed = false)
+    : ExtensionType(arrow::large_binary())
+    , m_dictionary_compressed(dictionary_compressed)
+    {
+    }
+
+    std::string extension_name() const override
+    {
+        return m_dictionary_compressed ? "minknow.vbz_dictionary" : "minknow.vbz";
+    }
 
-    std::string extension_name() const override { return "minknow.vbz"; }
+    bool dictionary_compressed() const { return m_dictionary_compressed; }
 
     bool ExtensionEquals(ExtensionType const & other) const override;
     std::shared_ptr<arrow::Array> MakeArray(std::shared_ptr<arrow::ArrayData> data) const override;
@@ -72,11 +84,16 @@ public:
     arrow::Result<std::shared_ptr<arrow::DataType>> Deserialize(
         std::shared_ptr<arrow::DataType> storage_type,
         std::string const & serialized_data) const override;
+
+private:
+    bool m_dictionary_compressed;
 };
 
 std::unique_ptr<arrow::FixedSizeBinaryBuilder> make_read_id_builder(arrow::MemoryPool * pool);
 
 std::shared_ptr<VbzSignalType> vbz_signal();
+/// \brief The vbz signal type of signal tables which may hold dictionary compressed signal.
+std::shared_ptr<VbzSignalType> vbz_dictionary_signal();
 std::shared_ptr<UuidType> uuid();
 
 /// \brief Register all required extension types.
@@ -4,15 +4,17 @@
 #include "pod5_format/c_api.h"
 #include "pod5_format/file_reader.h"
 #include "pod5_format/file_updater.h"
+#include "pod5_format/file_verifier.h"
 #include "pod5_format/file_writer.h"
+#include "pod5_format/read_id_utils.h"
 #include "pod5_format/read_table_reader.h"
 #include "pod5_format/signal_compression.h"
+#include "pod5_format/signal_kernels.h"
 #include "pod5_format/signal_table_reader.h"
 #include "pod5_format/thread_pool.h"
 #include "utils.h"
 
 #include <arrow/memory_pool.h>
-#include <boost/lexical_cast.hpp>
 #include <boost/uuid/uuid_io.hpp>
 #include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
@@ -199,6 +201,15 @@ struct Pod5FileReaderPtr {
 
     void close() { reader = nullptr; }
 
+    pod5::FileVerificationReport verify(std::size_t worker_count, bool verify_batch_checksums)
+    {
+        // The scrub decodes the whole file, so let other python threads run meanwhile:
+        py::gil_scoped_release release;
+        POD5_PYTHON_ASSIGN_OR_RAISE(
+            auto report, pod5::verify_file(*reader, worker_count, verify_batch_checksums));
+        return report;
+    }
+
     std::size_t plan_traversal(
         py::array_t<std::uint8_t, py::array::c_style | py::array::forcecast> const & read_id_data,
         py::array_t<std::uint32_t, py::array::c_style | py::array::forcecast> & batch_counts,
@@ -511,14 +522,24 @@ inline void FileWriter_add_reads_pre_compressed(
     }
 }
 
+/// Decompress [compressed_signal], with the signal dictionary of [file_reader] if one is passed.
 inline void decompress_signal_wrapper(
     py::array_t<uint8_t, py::array::c_style | py::array::forcecast> const & compressed_signal,
-    py::array_t<std::int16_t, py::array::c_style | py::array::forcecast> & signal_out)
+    py::array_t<std::int16_t, py::array::c_style | py::array::forcecast> & signal_out,
+    Pod5FileReaderPtr const * file_reader)
 {
+    std::shared_ptr<pod5::VbzDictionary const> dictionary;
+    if (file_reader) {
+        if (!file_reader->reader) {
+            throw std::runtime_error("File reader is closed");
+        }
+        dictionary = file_reader->reader->signal_dictionary();
+    }
     throw_on_error(pod5::decompress_signal(
         gsl::make_span(compressed_signal.data(0), compressed_signal.shape(0)),
         arrow::system_memory_pool(),
-        gsl::make_span(signal_out.mutable_data(0), signal_out.shape(0))));
+        gsl::make_span(signal_out.mutable_data(0), signal_out.shape(0)),
+        dictionary.get()));
 }
 
 inline std::size_t compress_signal_wrapper(
@@ -553,16 +574,72 @@ inline std::size_t load_read_id_iterable(
         }
 
         temp_uuid = read_id.cast<py::str>();
-        try {
-            auto found_uuid = boost::lexical_cast<boost::uuids::uuid>(temp_uuid);
-            read_ids[out_idx++] = found_uuid;
+        // Invalid ids are skipped - we will return one fewer read ids than expected and the caller
+        // can deal with it.
+        if (pod5::parse_read_id(
+                gsl::make_span(temp_uuid.data(), temp_uuid.size()), &read_ids[out_idx]))
+        {
+            out_idx += 1;
+        }
+    }
+
+    return out_idx;
+}
+
+inline std::size_t load_read_id_array(
+    py::array const & read_ids_str,
+    py::array_t<std::uint8_t, py::array::c_style | py::array::forcecast> & read_id_data_out)
+{
+    auto const strings = py::array::ensure(read_ids_str, py::array::c_style);
+    if (!strings || strings.ndim() != 1) {
+        throw std::runtime_error("Expected a one dimensional array of read id strings");
+    }
+    auto const kind = strings.dtype().kind();
+    if (kind != 'S' && kind != 'U') {
+        throw std::runtime_error("Expected a numpy bytes ('S') or str ('U') array of read ids");
+    }
+
+    std::size_t const count = strings.shape(0);
+    if (std::size_t(read_id_data_out.size()) < count * 16) {
+        throw std::runtime_error("Too many input uuids for output container");
+    }
+    auto read_ids = reinterpret_cast<boost::uuids::uuid *>(read_id_data_out.mutable_data());
+
+    std::size_t stride = strings.itemsize();
+    if (kind == 'U') {
+        stride /= sizeof(std::uint32_t);
+    }
+    if (count == 0 || stride == 0) {
+        return 0;
+    }
 
-        } catch (boost::bad_lexical_cast const & e) {
-            // Ignore - we will return one fewer read ids than expected and the caller can deal with it.
-            continue;
+    auto chars = static_cast<char const *>(strings.data());
+    std::vector<char> ascii;
+    if (kind == 'U') {
+        // Narrow the UCS4 code points, anything outside ascii can't be part of a read id:
+        auto const code_points = static_cast<std::uint32_t const *>(strings.data());
+        ascii.resize(count * stride);
+        for (std::size_t i = 0; i < ascii.size(); ++i) {
+            ascii[i] = code_points[i] < 0x80 ? char(code_points[i]) : char(0x7f);
         }
+        chars = ascii.data();
     }
 
+    std::vector<std::uint8_t> valid(count);
+    auto const parsed = pod5::parse_read_ids(
+        gsl::make_span(chars, count * stride),
+        stride,
+        gsl::make_span(read_ids, count),
+        gsl::make_span(valid));
+    throw_on_error(parsed.status());
+
+    // Invalid ids are skipped, as in load_read_id_iterable:
+    std::size_t out_idx = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (valid[i]) {
+            read_ids[out_idx++] = read_ids[i];
+        }
+    }
     return out_idx;
 }
 
@@ -576,14 +653,32 @@ inline py::list format_read_id_to_str(
 
     py::list result;
 
-    std::array<char, 37> str_data;
+    std::array<char, pod5::READ_ID_STRING_LENGTH> str_data;
     std::size_t const count = read_id_data_out.size() / 16;
+    auto read_ids = reinterpret_cast<boost::uuids::uuid const *>(read_id_data_out.data());
     for (std::size_t i = 0; i < count; ++i) {
-        auto read_id_data = read_id_data_out.data() + (i * 16);
+        pod5::format_read_id(read_ids[i], str_data.data());
+        result.append(py::str(str_data.data(), str_data.size()));
+    }
+
+    return result;
+}
 
-        pod5_format_read_id(read_id_data, str_data.data());
-        result.append(py::str(str_data.data(), str_data.size() - 1));
+inline py::array format_read_ids_to_array(
+    py::array_t<std::uint8_t, py::array::c_style | py::array::forcecast> & read_id_data)
+{
+    if (read_id_data.size() % 16 != 0) {
+        throw std::runtime_error(
+            "Unexpected amount of data for read id - expected data to align to 16 bytes.");
     }
 
+    std::size_t const count = read_id_data.size() / 16;
+    py::array result(py::dtype("S36"), std::vector<std::size_t>{count});
+    auto read_ids = reinterpret_cast<boost::uuids::uuid const *>(read_id_data.data());
+    auto const output = static_cast<char *>(result.mutable_data());
+    throw_on_error(pod5::format_read_ids(
+        gsl::make_span(read_ids, count),
+        gsl::make_span(output, count * pod5::READ_ID_STRING_LENGTH),
+        pod5::READ_ID_STRING_LENGTH));
     return result;
 }
@@ -6,7 +6,10 @@
 PYBIND11_MODULE(pod5_format_pybind, m)
 {
     using namespace pod5;
-    pod5_init();
+    if (pod5_init() != POD5_OK) {
+        throw std::runtime_error(
+            std::string("Failed to initialise pod5: ") + pod5_get_error_string());
+    }
 
     m.doc() = "POD5 Format Raw Bindings";
 
@@ -77,8 +80,39 @@ PYBIND11_MODULE(pod5_format_pybind, m)
         .def("batch_get_signal", &Pod5FileReaderPtr::batch_get_signal)
         .def("batch_get_signal_selection", &Pod5FileReaderPtr::batch_get_signal_selection)
         .def("batch_get_signal_batches", &Pod5FileReaderPtr::batch_get_signal_batches)
+        .def(
+            "verify",
+            &Pod5FileReaderPtr::verify,
+            py::arg("worker_count") = 0,
+            py::arg("verify_batch_checksums") = true)
         .def("close", &Pod5FileReaderPtr::close);
 
+    py::class_<FileVerificationReport>(m, "FileVerificationReport")
+        .def_property_readonly("ok", &FileVerificationReport::ok)
+        .def_readonly("read_count", &FileVerificationReport::read_count)
+        .def_readonly("signal_row_count", &FileVerificationReport::signal_row_count)
+        .def_readonly(
+            "unreferenced_signal_row_count", &FileVerificationReport::unreferenced_signal_row_count)
+        .def_readonly("sample_count", &FileVerificationReport::sample_count)
+        .def_readonly("signal_byte_count", &FileVerificationReport::signal_byte_count)
+        .def_readonly("elapsed_seconds", &FileVerificationReport::elapsed_seconds)
+        .def_readonly("error_count", &FileVerificationReport::error_count)
+        .def_readonly("errors", &FileVerificationReport::errors)
+        .def_property_readonly(
+            "checked_batch_count",
+            [](FileVerificationReport const & r) { return r.batch_checksums.checked_batch_count; })
+        .def_property_readonly(
+            "unchecked_batch_count",
+            [](FileVerificationReport const & r) {
+                return r.batch_checksums.unchecked_batch_count;
+            })
+        .def_property_readonly(
+            "checked_byte_count",
+            [](FileVerificationReport const & r) { return r.batch_checksums.checked_byte_count; })
+        .def_property_readonly("checksum_failures", [](FileVerificationReport const & r) {
+            return r.batch_checksums.failures;
+        });
+
     // Errors API
     m.def("get_error_string", &pod5_get_error_string, "Get the most recent error as a string");
 
@@ -101,9 +135,19 @@ PYBIND11_MODULE(pod5_format_pybind, m)
         "Update a POD5 file to the latest writer format");
 
     // Signal API
-    m.def("decompress_signal", &decompress_signal_wrapper, "Decompress a numpy array of signal");
+    m.def(
+        "decompress_signal",
+        &decompress_signal_wrapper,
+        "Decompress a numpy array of signal, with the signal dictionary of file_reader if passed",
+        py::arg("compressed_signal"),
+        py::arg("signal_out"),
+        py::arg("file_reader") = nullptr);
     m.def("compress_signal", &compress_signal_wrapper, "Compress a numpy array of signal");
     m.def("vbz_compressed_signal_max_size", &vbz_compressed_signal_max_size);
+    m.def(
+        "get_signal_kernels",
+        [] { return pod5::format_signal_kernels(pod5::signal_kernels()); },
+        "Describe the signal compression kernels in use, in the form POD5_SIGNAL_KERNELS takes");
 
     // Repacker API
     py::class_<repack::Pod5RepackerOutput, std::shared_ptr<repack::Pod5RepackerOutput>>(
@@ -127,5 +171,13 @@ PYBIND11_MODULE(pod5_format_pybind, m)
         "load_read_id_iterable",
         &load_read_id_iterable,
         "Load an iterable of read ids into a numpy array of data");
+    m.def(
+        "load_read_id_array",
+        &load_read_id_array,
+        "Load a numpy array of read id strings into a numpy array of data");
     m.def("format_read_id_to_str", &format_read_id_to_str, "Format an array of read ids to string");
+    m.def(
+        "format_read_ids_to_array",
+        &format_read_ids_to_array,
+        "Format an array of read ids to a numpy array of strings");
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "pod5_format/internal/tracing/tracing.h"
+#include "pod5_format/read_batch_view.h"
 #include "pod5_format/read_table_reader.h"
 #include "pod5_format/signal_builder.h"
 #include "pod5_format/signal_table_schema.h"
@@ -37,15 +38,8 @@ arrow::Result<ReadReadData> read_read_data(
     ARROW_ASSIGN_OR_RAISE(
         auto source_read_table_batch, source_file->read_read_record_batch(in_batch.batch_index));
 
-    ARROW_ASSIGN_OR_RAISE(auto columns, source_read_table_batch.columns());
-
-    auto source_reads_pore_type_column =
-        std::static_pointer_cast<arrow::Int16Array>(columns.pore_type->indices());
-    auto source_reads_end_reason_column =
-        std::static_pointer_cast<arrow::Int16Array>(columns.end_reason->indices());
-    auto source_reads_run_info_column =
-        std::static_pointer_cast<arrow::Int16Array>(columns.run_info->indices());
-    auto source_reads_signal_column = source_read_table_batch.signal_column();
+    ARROW_ASSIGN_OR_RAISE(
+        auto const view, pod5::LatestReadBatchView::make(source_read_table_batch));
 
     auto batch_rows = std::move(in_batch.batch_rows);
     if (batch_rows.empty()) {
@@ -62,28 +56,27 @@ arrow::Result<ReadReadData> read_read_data(
     for (std::size_t batch_row_index = 0; batch_row_index < batch_rows.size(); ++batch_row_index) {
         auto batch_row = batch_rows[batch_row_index];
         // Find the read params
-        auto const & read_id = columns.read_id->Value(batch_row);
-        auto const & read_number = columns.read_number->Value(batch_row);
-        auto const & start_sample = columns.start_sample->Value(batch_row);
-        auto const & channel = columns.channel->Value(batch_row);
-        auto const & well = columns.well->Value(batch_row);
-        auto const & calibration_offset = columns.calibration_offset->Value(batch_row);
-        auto const & calibration_scale = columns.calibration_scale->Value(batch_row);
-        auto const & median_before = columns.median_before->Value(batch_row);
-        auto const & end_reason_forced = columns.end_reason_forced->Value(batch_row);
-        auto const & num_minknow_events = columns.num_minknow_events->Value(batch_row);
-        auto const & tracked_scaling_scale = columns.tracked_scaling_scale->Value(batch_row);
-        auto const & tracked_scaling_shift = columns.tracked_scaling_shift->Value(batch_row);
-        auto const & predicted_scaling_scale = columns.predicted_scaling_scale->Value(batch_row);
-        auto const & predicted_scaling_shift = columns.predicted_scaling_shift->Value(batch_row);
-        auto const & num_reads_since_mux_change =
-            columns.num_reads_since_mux_change->Value(batch_row);
-        auto const & time_since_mux_change = columns.time_since_mux_change->Value(batch_row);
-        auto const & num_samples = columns.num_samples->Value(batch_row);
-
-        auto const & pore_type_index = source_reads_pore_type_column->Value(batch_row);
-        auto const & end_reason_index = source_reads_end_reason_column->Value(batch_row);
-        auto const & run_info_index = source_reads_run_info_column->Value(batch_row);
+        auto const & read_id = view.read_id(batch_row);
+        auto const read_number = view.read_number(batch_row);
+        auto const start_sample = view.start_sample(batch_row);
+        auto const channel = view.channel(batch_row);
+        auto const well = view.well(batch_row);
+        auto const calibration_offset = view.calibration_offset(batch_row);
+        auto const calibration_scale = view.calibration_scale(batch_row);
+        auto const median_before = view.median_before(batch_row);
+        auto const end_reason_forced = view.end_reason_forced(batch_row);
+        auto const num_minknow_events = view.num_minknow_events(batch_row);
+        auto const tracked_scaling_scale = view.tracked_scaling_scale(batch_row);
+        auto const tracked_scaling_shift = view.tracked_scaling_shift(batch_row);
+        auto const predicted_scaling_scale = view.predicted_scaling_scale(batch_row);
+        auto const predicted_scaling_shift = view.predicted_scaling_shift(batch_row);
+        auto const num_reads_since_mux_change = view.num_reads_since_mux_change(batch_row);
+        auto const time_since_mux_change = view.time_since_mux_change(batch_row);
+        auto const num_samples = view.num_samples(batch_row);
+
+        auto const pore_type_index = view.pore_type(batch_row);
+        auto const end_reason_index = view.end_reason(batch_row);
+        auto const run_info_index = view.run_info(batch_row);
 
         ARROW_ASSIGN_OR_RAISE(
             auto dest_pore_index,
@@ -116,10 +109,7 @@ arrow::Result<ReadReadData> read_read_data(
             time_since_mux_change);
         result.signal_durations.emplace_back(num_samples);
 
-        auto const signal_rows = std::static_pointer_cast<arrow::UInt64Array>(
-            source_reads_signal_column->value_slice(batch_row));
-        auto const signal_rows_span =
-            gsl::make_span(signal_rows->raw_values(), signal_rows->length());
+        auto const signal_rows_span = view.signal_rows(batch_row);
 
         result.signal_rows.insert(
             result.signal_rows.end(), signal_rows_span.begin(), signal_rows_span.end());
@@ -144,9 +134,11 @@ arrow::Status read_signal(
 {
     auto signal_rows_span = gsl::make_span(&abs_signal_row, 1);
 
-    // If were using the same compression type in both files, just copy compressed:
+    // If were using the same compression type in both files, just copy compressed. Signal
+    // compressed with a dictionary needs it to decompress, so is recompressed without one:
     if (input_compression_type == output_compression_type
-        && output_compression_type == pod5::SignalType::VbzSignal)
+        && output_compression_type == pod5::SignalType::VbzSignal
+        && !source_file->signal_dictionary())
     {
         std::vector<uint32_t> sample_counts;
         ARROW_ASSIGN_OR_RAISE(
@@ -0,0 +1,127 @@
+#include "pod5_format/shared_signal_cache.h"
+#include "pod5_format/signal_server.h"
+#include "pod5_format/types.h"
+
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+pod5::SignalServer * g_server = nullptr;
+
+void handle_stop_signal(int) { g_server->stop(); }
+
+void print_usage()
+{
+    std::cerr << "Usage: pod5d <socket path> [options]\n"
+                 "Serve read metadata and signal from pod5 files over a Unix domain socket.\n"
+                 "\n"
+                 "Options:\n"
+                 "  --cache-mib <n>         MiB of decoded signal to cache (default 1024).\n"
+                 "  --shared-cache <name>   Also cache decoded signal in the named shared memory\n"
+                 "                          cache, shared with other processes.\n"
+                 "  --workers <n>           Workers decoding each request's signal.\n"
+                 "  --max-idle-files <n>    Files kept open once no client uses them (default "
+                 "256).\n"
+                 "  --socket-mode <mode>    Octal permissions of the socket (default 600). Any\n"
+                 "                          process able to connect can read every file pod5d\n"
+                 "                          can.\n";
+}
+
+/// Parse [value] as a non negative integer in [base], false if it isn't one.
+bool parse_integer(std::string const & value, std::size_t & result, int base = 10)
+{
+    try {
+        std::size_t end = 0;
+        result = std::stoull(value, &end, base);
+        return end == value.size() && value.find('-') == std::string::npos;
+    } catch (std::logic_error const &) {
+        // Not a number (std::invalid_argument), or too large (std::out_of_range):
+        return false;
+    }
+}
+
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+    if (argc < 2 || argv[1][0] == '-') {
+        print_usage();
+        return EXIT_FAILURE;
+    }
+
+    pod5::SignalServerOptions options;
+    options.socket_path = argv[1];
+    std::string shared_cache_name;
+    std::size_t cache_mib = options.decoded_signal_cache_bytes / (1024 * 1024);
+    std::size_t socket_mode = options.socket_permissions;
+    for (int i = 2; i < argc; i += 2) {
+        if (i + 1 >= argc) {
+            print_usage();
+            return EXIT_FAILURE;
+        }
+        std::string const option = argv[i];
+        std::string const value = argv[i + 1];
+        bool valid = true;
+        if (option == "--cache-mib") {
+            valid = parse_integer(value, cache_mib) && cache_mib <= SIZE_MAX / (1024 * 1024);
+        } else if (option == "--shared-cache") {
+            shared_cache_name = value;
+        } else if (option == "--workers") {
+            valid = parse_integer(value, options.worker_count);
+        } else if (option == "--max-idle-files") {
+            valid = parse_integer(value, options.max_idle_files);
+        } else if (option == "--socket-mode") {
+            valid = parse_integer(value, socket_mode, 8) && socket_mode <= 0777;
+        } else {
+            valid = false;
+        }
+        if (!valid) {
+            print_usage();
+            return EXIT_FAILURE;
+        }
+    }
+    options.socket_permissions = std::uint32_t(socket_mode);
+    options.decoded_signal_cache_bytes = cache_mib * 1024 * 1024;
+
+    auto const status = pod5::register_extension_types();
+    if (!status.ok()) {
+        std::cerr << "Failed to register pod5 types: " << status << "\n";
+        return EXIT_FAILURE;
+    }
+
+    if (!shared_cache_name.empty()) {
+        auto shared_cache =
+            pod5::SharedSignalCache::open(shared_cache_name, options.decoded_signal_cache_bytes);
+        if (!shared_cache.ok()) {
+            std::cerr << "Failed to open shared cache: " << shared_cache.status() << "\n";
+            return EXIT_FAILURE;
+        }
+        options.reader_options.set_shared_signal_cache(*shared_cache);
+    }
+
+    auto server = pod5::SignalServer::create(options);
+    if (!server.ok()) {
+        std::cerr << "Failed to start server: " << server.status() << "\n";
+        return EXIT_FAILURE;
+    }
+
+    g_server = server->get();
+    std::signal(SIGINT, handle_stop_signal);
+    std::signal(SIGTERM, handle_stop_signal);
+    std::cerr << "Serving on " << options.socket_path << "\n";
+
+    auto const run_status = (*server)->run();
+    server->reset();
+    (void)pod5::unregister_extension_types();
+    if (!run_status.ok()) {
+        std::cerr << "Server failed: " << run_status << "\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,163 @@
+#include "pod5_format/async_file_reader.h"
+#include "pod5_format/file_reader.h"
+#include "pod5_format/file_writer.h"
+#include "pod5_format/types.h"
+#include "test_utils.h"
+#include "utils.h"
+
+#include <arrow/array/array_primitive.h>
+#include <boost/uuid/random_generator.hpp>
+#include <catch2/catch.hpp>
+
+#include <future>
+#include <numeric>
+#include <vector>
+
+namespace {
+
+/// A coroutine run eagerly, its future set once it returns.
+struct Task {
+    struct promise_type {
+        Task get_return_object() { return Task{done.get_future()}; }
+
+        std::suspend_never initial_suspend() noexcept { return {}; }
+
+        std::suspend_never final_suspend() noexcept { return {}; }
+
+        void return_value(pod5::Status status) { done.set_value(std::move(status)); }
+
+        void unhandled_exception() { done.set_exception(std::current_exception()); }
+
+        std::promise<pod5::Status> done;
+    };
+
+    std::future<pod5::Status> done;
+};
+
+Task read_all_signal(
+    pod5::AsyncFileReader reader,
+    std::vector<std::vector<std::int16_t>> & signals)
+{
+    // Start every batch read before awaiting any of them:
+    std::vector<pod5::AsyncResult<pod5::Result<pod5::ReadTableRecordBatch>>> batches;
+    for (std::size_t i = 0; i < reader.num_read_record_batches(); ++i) {
+        batches.push_back(reader.read_read_record_batch(i));
+    }
+
+    std::vector<pod5::AsyncResult<pod5::Status>> extractions;
+    for (auto & pending_batch : batches) {
+        auto batch = co_await pending_batch;
+        if (!batch.ok()) {
+            co_return batch.status();
+        }
+
+        for (std::size_t row = 0; row < batch->num_rows(); ++row) {
+            auto signal_rows = batch->get_signal_rows(row);
+            if (!signal_rows.ok()) {
+                co_return signal_rows.status();
+            }
+            auto const rows =
+                gsl::make_span((*signal_rows)->raw_values(), (*signal_rows)->length());
+            auto sample_count = reader.reader().extract_sample_count(rows);
+            if (!sample_count.ok()) {
+                co_return sample_count.status();
+            }
+
+            signals.emplace_back(*sample_count);
+            extractions.push_back(reader.extract_samples(rows, gsl::make_span(signals.back())));
+        }
+    }
+
+    for (auto & extraction : extractions) {
+        auto status = co_await extraction;
+        if (!status.ok()) {
+            co_return status;
+        }
+    }
+    co_return pod5::Status::OK();
+}
+
+Task read_batches(
+    pod5::AsyncFileReader reader,
+    std::size_t read_batch_index,
+    std::size_t signal_batch_index,
+    std::size_t & signal_row_count)
+{
+    auto signal_batch = reader.read_signal_record_batch(signal_batch_index);
+    auto read_batch = reader.read_read_record_batch(read_batch_index);
+
+    auto signal_result = co_await signal_batch;
+    if (!signal_result.ok()) {
+        co_return signal_result.status();
+    }
+    signal_row_count = signal_result->num_rows();
+    co_return (co_await read_batch).status();
+}
+
+}  // namespace
+
+SCENARIO("Async file reader")
+{
+    static constexpr char const * file = "./foo_async_reader.pod5";
+    REQUIRE_ARROW_STATUS_OK(remove_file_if_exists(file));
+    (void)pod5::register_extension_types();
+    auto fin = gsl::finally([] { (void)pod5::unregister_extension_types(); });
+
+    auto uuid_gen = boost::uuids::random_generator_mt19937();
+    std::vector<std::vector<std::int16_t>> signals;
+    {
+        pod5::FileWriterOptions options;
+        options.set_read_table_batch_size(10);
+        options.set_max_signal_chunk_size(500);
+        auto writer = pod5::create_file_writer(file, "test_software", options);
+        REQUIRE_ARROW_STATUS_OK(writer);
+        auto run_info = (*writer)->add_run_info(get_test_run_info_data("_run_info"));
+        auto end_reason = (*writer)->lookup_end_reason(pod5::ReadEndReason::unknown);
+        auto pore_type = (*writer)->add_pore_type("pore_type");
+        for (std::uint32_t i = 0; i < 25; ++i) {
+            signals.emplace_back(200 + 100 * i);
+            std::iota(signals.back().begin(), signals.back().end(), std::int16_t(i));
+
+            pod5::ReadData read_data{};
+            read_data.read_id = uuid_gen();
+            read_data.read_number = i;
+            read_data.pore_type = *pore_type;
+            read_data.end_reason = *end_reason;
+            read_data.run_info = *run_info;
+            REQUIRE_ARROW_STATUS_OK(
+                (*writer)->add_complete_read(read_data, gsl::make_span(signals[i])));
+        }
+        REQUIRE_ARROW_STATUS_OK((*writer)->close());
+    }
+
+    auto file_reader = pod5::open_file_reader(file, {});
+    REQUIRE_ARROW_STATUS_OK(file_reader);
+    pod5::AsyncFileReader reader(*file_reader, pod5::make_thread_pool(4));
+    REQUIRE(reader.num_read_record_batches() == 3);
+
+    GIVEN("Every read's signal awaited")
+    {
+        std::vector<std::vector<std::int16_t>> read_signals;
+        read_signals.reserve(signals.size());
+        auto task = read_all_signal(reader, read_signals);
+        CHECK_ARROW_STATUS_OK(task.done.get());
+        CHECK(read_signals == signals);
+    }
+
+    GIVEN("Signal and read batches awaited")
+    {
+        std::size_t signal_row_count = 0;
+        auto task = read_batches(reader, 2, 0, signal_row_count);
+        CHECK_ARROW_STATUS_OK(task.done.get());
+        CHECK(signal_row_count > 0);
+
+        THEN("Errors are returned from the await")
+        {
+            auto failed_read = read_batches(reader, 3, 0, signal_row_count);
+            CHECK_ARROW_STATUS_NOT_OK(failed_read.done.get());
+            auto failed_signal =
+                read_batches(reader, 0, reader.num_signal_record_batches(), signal_row_count);
+            CHECK_ARROW_STATUS_NOT_OK(failed_signal.done.get());
+        }
+    }
+}
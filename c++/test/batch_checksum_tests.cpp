@@ -0,0 +1,87 @@
+#include "pod5_format/batch_checksum.h"
+
+#include <arrow/buffer.h>
+#include <arrow/io/memory.h>
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <vector>
+
+SCENARIO("Batch checksum Tests")
+{
+    GIVEN("The standard check input")
+    {
+        std::string const input = "123456789";
+
+        THEN("The CRC32C matches the published check value")
+        {
+            CHECK(pod5::crc32c(input.data(), input.size()) == 0xE3069283);
+        }
+
+        THEN("A checksum built in pieces matches the whole")
+        {
+            auto const first = pod5::crc32c(input.data(), 4);
+            CHECK(pod5::crc32c(input.data() + 4, input.size() - 4, first) == 0xE3069283);
+        }
+    }
+
+    GIVEN("A buffer longer than a word")
+    {
+        std::vector<std::uint8_t> data(1001);
+        for (std::size_t i = 0; i < data.size(); ++i) {
+            data[i] = std::uint8_t(i * 7);
+        }
+        auto const crc = pod5::crc32c(data.data(), data.size());
+
+        THEN("Every single byte change alters the checksum")
+        {
+            for (std::size_t i = 0; i < data.size(); i += 97) {
+                auto changed = data;
+                changed[i] ^= 1;
+                CHECK(pod5::crc32c(changed.data(), changed.size()) != crc);
+            }
+        }
+
+        THEN("Unaligned pieces combine to the same checksum")
+        {
+            auto partial = pod5::crc32c(data.data(), 3);
+            partial = pod5::crc32c(data.data() + 3, 500, partial);
+            partial = pod5::crc32c(data.data() + 503, data.size() - 503, partial);
+            CHECK(partial == crc);
+        }
+    }
+
+    GIVEN("A file holding a checksummed range")
+    {
+        std::string const contents = "header--checksummed bytes--trailer";
+        auto const file =
+            std::make_shared<arrow::io::BufferReader>(arrow::Buffer::FromString(contents));
+        std::int64_t const offset = 8;
+        std::int64_t const length = 17;
+        pod5::BatchChecksum const checksum{
+            offset, length, pod5::crc32c(contents.data() + offset, length)};
+
+        THEN("Reading the range returns the checked bytes")
+        {
+            auto const bytes = pod5::read_checked_bytes(*file, checksum);
+            REQUIRE(bytes.ok());
+            CHECK((*bytes)->ToString() == contents.substr(offset, length));
+            CHECK(pod5::verify_batch_checksum(*file, checksum).ok());
+        }
+
+        THEN("A changed checksum is reported")
+        {
+            auto changed = checksum;
+            changed.crc32c ^= 1;
+            CHECK_FALSE(pod5::read_checked_bytes(*file, changed).ok());
+            CHECK_FALSE(pod5::verify_batch_checksum(*file, changed).ok());
+        }
+
+        THEN("A range past the end of the file is reported")
+        {
+            auto past_end = checksum;
+            past_end.offset = std::int64_t(contents.size()) - 4;
+            CHECK_FALSE(pod5::read_checked_bytes(*file, past_end).ok());
+        }
+    }
+}
@@ -1,8 +1,10 @@
 #include "pod5_format/c_api.h"
 
 #include "pod5_format/file_reader.h"
+#include "pod5_format/file_writer.h"
 #include "pod5_format/schema_metadata.h"
 #include "pod5_format/version.h"
+#include "test_utils.h"
 #include "utils.h"
 
 #include <boost/uuid/random_generator.hpp>
@@ -10,8 +12,17 @@
 #include <catch2/catch.hpp>
 #include <gsl/gsl-lite.hpp>
 
+#include <algorithm>
+#include <fstream>
+#include <functional>
 #include <iostream>
+#include <iterator>
 #include <numeric>
+#include <random>
+
+#ifdef __linux__
+#include <poll.h>
+#endif
 
 struct Pod5C_Result {
     static Pod5C_Result capture(pod5_error_t err_num)
@@ -263,6 +274,31 @@ SCENARIO("C API Reads")
         CHECK_POD5_OK(pod5_get_read_count(file, &read_count));
         REQUIRE(read_count == 2);
 
+        {
+            // Signal compressed without a dictionary decodes with any file's:
+            std::vector<char> compressed_signal(
+                pod5_vbz_compressed_signal_max_size(signal_2.size()));
+            std::size_t compressed_size = compressed_signal.size();
+            CHECK_POD5_OK(pod5_vbz_compress_signal(
+                signal_2.data(), signal_2.size(), compressed_signal.data(), &compressed_size));
+            std::vector<std::int16_t> decompressed(signal_2.size());
+            CHECK_POD5_OK(pod5_vbz_decompress_file_signal(
+                file,
+                compressed_signal.data(),
+                compressed_size,
+                decompressed.size(),
+                decompressed.data()));
+            CHECK(decompressed == signal_2);
+            CHECK(
+                pod5_vbz_decompress_file_signal(
+                    nullptr,
+                    compressed_signal.data(),
+                    compressed_size,
+                    decompressed.size(),
+                    decompressed.data())
+                != POD5_OK);
+        }
+
         std::vector<Pod5ReadId> read_ids(2);
         CHECK(pod5_get_read_ids(file, 1, (read_id_t *)read_ids.data()) != POD5_OK);
         CHECK_POD5_OK(pod5_get_read_ids(file, read_ids.size(), (read_id_t *)read_ids.data()));
@@ -367,6 +403,12 @@ SCENARIO("C API Reads")
             std::size_t sample_count = 0;
             CHECK_POD5_OK(pod5_get_read_complete_sample_count(file, batch_0, row, &sample_count));
             CHECK(sample_count == signal_row_info.front()->stored_sample_count);
+            std::size_t byte_count = 0;
+            CHECK_POD5_OK(pod5_get_read_complete_byte_count(file, batch_0, row, &byte_count));
+            CHECK(byte_count == signal_row_info.front()->stored_byte_count);
+            CHECK(
+                pod5_get_read_complete_sample_count(file, batch_0, 1'000, &sample_count)
+                == POD5_ERROR_INDEXERROR);
             CHECK_POD5_OK(pod5_get_read_complete_signal(
                 file, batch_0, row, sample_count, read_signal.data()));
             CHECK(read_signal == signal);
@@ -668,6 +710,108 @@ SCENARIO("C API Many Reads")
         pod5_close_and_free_reader(file);
         CHECK_POD5_OK(pod5_get_error_no());
     }
+
+    // Read the file back from memory:
+    {
+        std::ifstream input(filename, std::ios::binary);
+        std::vector<char> const file_data{
+            std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>()};
+        REQUIRE(!file_data.empty());
+
+        struct ReleaseState {
+            void const * data = nullptr;
+            std::size_t size = 0;
+            std::size_t release_count = 0;
+        } release_state;
+        auto release = [](void const * data, size_t size, void * context) {
+            auto state = static_cast<ReleaseState *>(context);
+            state->data = data;
+            state->size = size;
+            state->release_count += 1;
+        };
+
+        CHECK(!pod5_open_buffer(NULL, file_data.size(), release, &release_state));
+        CHECK(pod5_get_error_no() == POD5_ERROR_INVALID);
+        CHECK(release_state.release_count == 1);
+        release_state = {};
+
+        auto file = pod5_open_buffer(file_data.data(), file_data.size(), release, &release_state);
+        CHECK_POD5_OK(pod5_get_error_no());
+        REQUIRE(!!file);
+
+        std::size_t read_count_returned = 0;
+        CHECK_POD5_OK(pod5_get_read_count(file, &read_count_returned));
+        CHECK(read_count_returned == read_count);
+
+        Pod5ReadRecordBatch * batch_0 = nullptr;
+        CHECK_POD5_OK(pod5_get_read_batch(&batch_0, file, 0));
+        REQUIRE(!!batch_0);
+
+        std::vector<std::int16_t> samples(signal_1.size());
+        CHECK_POD5_OK(
+            pod5_get_read_complete_signal(file, batch_0, 0, samples.size(), samples.data()));
+        CHECK(samples == signal_1);
+
+        // Batches keep the file's memory in use after the reader is closed:
+        CHECK_POD5_OK(pod5_close_and_free_reader(file));
+        CHECK(release_state.release_count == 0);
+
+        CHECK_POD5_OK(pod5_free_read_batch(batch_0));
+        CHECK(release_state.release_count == 1);
+        CHECK(release_state.data == file_data.data());
+        CHECK(release_state.size == file_data.size());
+    }
+
+    // Read the file back through a decoded signal cache:
+    {
+        auto cache = pod5_create_decoded_signal_cache(1024 * 1024);
+        REQUIRE(!!cache);
+        CHECK(!pod5_open_file_with_signal_cache(filename, NULL, NULL));
+        auto file = pod5_open_file_with_signal_cache(filename, NULL, cache);
+        CHECK_POD5_OK(pod5_get_error_no());
+        REQUIRE(!!file);
+        // Readers keep the cache in use after it is freed:
+        CHECK_POD5_OK(pod5_free_decoded_signal_cache(cache));
+
+        Pod5ReadRecordBatch * batch_0 = nullptr;
+        CHECK_POD5_OK(pod5_get_read_batch(&batch_0, file, 0));
+        REQUIRE(!!batch_0);
+
+        for (int i = 0; i < 3; ++i) {
+            std::vector<std::int16_t> samples(signal_1.size());
+            CHECK_POD5_OK(
+                pod5_get_read_complete_signal(file, batch_0, 0, samples.size(), samples.data()));
+            CHECK(samples == signal_1);
+        }
+        CHECK_POD5_OK(pod5_free_read_batch(batch_0));
+        CHECK_POD5_OK(pod5_close_and_free_reader(file));
+    }
+
+    {
+        auto cache = pod5_create_decoded_signal_cache(1024 * 1024);
+        auto file = pod5_open_file_with_signal_cache(filename, NULL, cache);
+        REQUIRE(!!file);
+
+        Pod5ReadRecordBatch * batch_0 = nullptr;
+        CHECK_POD5_OK(pod5_get_read_batch(&batch_0, file, 0));
+        std::vector<std::int16_t> samples(signal_1.size());
+        for (int i = 0; i < 3; ++i) {
+            CHECK_POD5_OK(
+                pod5_get_read_complete_signal(file, batch_0, 0, samples.size(), samples.data()));
+        }
+
+        DecodedSignalCacheMetrics_t metrics;
+        CHECK(pod5_get_decoded_signal_cache_metrics(cache, NULL) == POD5_ERROR_INVALID);
+        CHECK_POD5_OK(pod5_get_decoded_signal_cache_metrics(cache, &metrics));
+        CHECK(metrics.misses == 1);
+        CHECK(metrics.hits == 2);
+        CHECK(metrics.entry_count == 1);
+        CHECK(metrics.byte_count == signal_1.size() * sizeof(std::int16_t));
+
+        CHECK_POD5_OK(pod5_free_read_batch(batch_0));
+        CHECK_POD5_OK(pod5_close_and_free_reader(file));
+        CHECK_POD5_OK(pod5_free_decoded_signal_cache(cache));
+    }
 }
 
 SCENARIO("C API Run Info")
@@ -756,3 +900,223 @@ SCENARIO("C API Run Info")
         CHECK_POD5_OK(pod5_close_and_free_reader(file));
     }
 }
+
+SCENARIO("C API Signal kernels")
+{
+    CHECK_POD5_OK(pod5_init());
+    auto fin = gsl::finally([] { pod5_terminate(); });
+
+    std::size_t kernels_size = 0;
+    char empty[1] = {};
+    CHECK(pod5_get_signal_kernels(empty, &kernels_size) == POD5_ERROR_STRING_NOT_LONG_ENOUGH);
+    REQUIRE(kernels_size > 1);
+
+    std::vector<char> kernels(kernels_size);
+    CHECK_POD5_OK(pod5_get_signal_kernels(kernels.data(), &kernels_size));
+    std::string const description(kernels.data());
+    CHECK(description.size() + 1 == kernels_size);
+    CHECK(description.find("svb16_decode=") != std::string::npos);
+    CHECK(description.find("zstd_decompress=") != std::string::npos);
+
+    CHECK(pod5_get_signal_kernels(kernels.data(), nullptr) == POD5_ERROR_INVALID);
+}
+
+SCENARIO("C API Read id strings")
+{
+    CHECK_POD5_OK(pod5_init());
+    auto fin = gsl::finally([] { pod5_terminate(); });
+
+    std::vector<boost::uuids::uuid> read_ids(10);
+    std::mt19937 gen(3);
+    boost::uuids::basic_random_generator<std::mt19937> uuid_gen(gen);
+    std::generate(read_ids.begin(), read_ids.end(), std::ref(uuid_gen));
+    auto const packed = reinterpret_cast<read_id_t const *>(read_ids.data());
+
+    std::size_t const stride = 37;
+    std::vector<char> strings(read_ids.size() * stride);
+    CHECK_POD5_OK(pod5_format_read_ids(packed, read_ids.size(), strings.data()));
+    for (std::size_t i = 0; i < read_ids.size(); ++i) {
+        CHECK(std::string(strings.data() + i * stride) == boost::uuids::to_string(read_ids[i]));
+    }
+
+    std::vector<boost::uuids::uuid> parsed(read_ids.size());
+    auto const parsed_packed = reinterpret_cast<read_id_t *>(parsed.data());
+    CHECK_POD5_OK(pod5_parse_read_ids(strings.data(), read_ids.size(), stride, parsed_packed));
+    CHECK(parsed == read_ids);
+
+    strings[4 * stride + 3] = 'x';
+    CHECK(
+        pod5_parse_read_ids(strings.data(), read_ids.size(), stride, parsed_packed)
+        == POD5_ERROR_INVALID);
+    CHECK(std::string(pod5_get_error_string()).find("index 4") != std::string::npos);
+
+    CHECK(pod5_format_read_ids(packed, read_ids.size(), nullptr) == POD5_ERROR_INVALID);
+    CHECK(
+        pod5_parse_read_ids(nullptr, read_ids.size(), stride, parsed_packed)
+        == POD5_ERROR_INVALID);
+}
+
+#ifdef __linux__
+SCENARIO("C API Async reads")
+{
+    static constexpr char const * filename = "./foo_c_api_async.pod5";
+    CHECK_POD5_OK(pod5_init());
+    auto fin = gsl::finally([] { pod5_terminate(); });
+
+    auto uuid_gen = boost::uuids::random_generator_mt19937();
+    std::vector<boost::uuids::uuid> read_ids;
+    std::vector<std::vector<std::int16_t>> signals;
+    {
+        REQUIRE(remove_file_if_exists(filename).ok());
+        pod5::FileWriterOptions options;
+        options.set_read_table_batch_size(10);
+        auto writer = pod5::create_file_writer(filename, "c_software", options);
+        REQUIRE_ARROW_STATUS_OK(writer);
+        auto run_info = (*writer)->add_run_info(get_test_run_info_data("_run_info"));
+        auto end_reason = (*writer)->lookup_end_reason(pod5::ReadEndReason::unknown);
+        auto pore_type = (*writer)->add_pore_type("pore_type");
+        for (std::uint32_t i = 0; i < 25; ++i) {
+            signals.emplace_back(100 + 10 * i);
+            std::iota(signals.back().begin(), signals.back().end(), std::int16_t(i));
+
+            pod5::ReadData read_data{};
+            read_data.read_id = uuid_gen();
+            read_data.read_number = i;
+            read_data.pore_type = *pore_type;
+            read_data.end_reason = *end_reason;
+            read_data.run_info = *run_info;
+            read_ids.push_back(read_data.read_id);
+            REQUIRE_ARROW_STATUS_OK(
+                (*writer)->add_complete_read(read_data, gsl::make_span(signals[i])));
+        }
+        REQUIRE_ARROW_STATUS_OK((*writer)->close());
+    }
+
+    auto queue = pod5_create_async_queue(2);
+    REQUIRE(queue);
+    auto free_queue = gsl::finally([&] { pod5_free_async_queue(queue); });
+    int fd = -1;
+    CHECK_POD5_OK(pod5_get_async_queue_fd(queue, &fd));
+
+    // Wait on the queue's descriptor as an event loop would:
+    auto const wait_for_completions = [&](std::size_t expected_count) {
+        std::vector<Pod5AsyncCompletion_t> completions;
+        while (completions.size() < expected_count) {
+            pollfd poll_fd{fd, POLLIN, 0};
+            REQUIRE(poll(&poll_fd, 1, 10000) == 1);
+
+            Pod5AsyncCompletion_t collected[4];
+            std::size_t count = 0;
+            CHECK_POD5_OK(pod5_get_async_completions(queue, collected, 4, &count));
+            completions.insert(completions.end(), collected, collected + count);
+        }
+        CHECK(completions.size() == expected_count);
+        return completions;
+    };
+
+    int open_tag = 0;
+    CHECK_POD5_OK(pod5_async_open_file(queue, filename, nullptr, &open_tag));
+    auto opened = wait_for_completions(1);
+    REQUIRE(opened[0].user_data == &open_tag);
+    CHECK(opened[0].operation == POD5_ASYNC_OPEN_FILE);
+    CHECK(opened[0].error_no == POD5_OK);
+    auto reader = opened[0].reader;
+    REQUIRE(reader);
+    auto close_reader = gsl::finally([&] { pod5_close_and_free_reader(reader); });
+
+    GIVEN("A file that does not exist")
+    {
+        CHECK_POD5_OK(pod5_async_open_file(queue, "./not_a_file.pod5", nullptr, nullptr));
+        auto failed = wait_for_completions(1);
+        CHECK(failed[0].error_no != POD5_OK);
+        CHECK(std::string(failed[0].error_string).size() > 0);
+        CHECK(!failed[0].reader);
+    }
+
+    GIVEN("A planned traversal")
+    {
+        std::vector<boost::uuids::uuid> search{read_ids[22], read_ids[3], uuid_gen()};
+        std::vector<std::uint32_t> batch_counts(3);
+        std::vector<std::uint32_t> batch_rows(search.size());
+        std::size_t find_success_count = 0;
+        CHECK_POD5_OK(pod5_async_plan_traversal(
+            queue,
+            reader,
+            reinterpret_cast<std::uint8_t const *>(search.data()),
+            search.size(),
+            batch_counts.data(),
+            batch_rows.data(),
+            &find_success_count,
+            nullptr));
+        auto planned = wait_for_completions(1);
+        CHECK(planned[0].operation == POD5_ASYNC_PLAN_TRAVERSAL);
+        CHECK(planned[0].error_no == POD5_OK);
+        CHECK(find_success_count == 2);
+        CHECK(batch_counts == std::vector<std::uint32_t>{1, 0, 1});
+        CHECK(batch_rows[0] == 3);
+        CHECK(batch_rows[1] == 2);
+    }
+
+    GIVEN("Every batch and signal read asynchronously")
+    {
+        std::vector<std::size_t> batch_indices{0, 1, 2};
+        for (auto & index : batch_indices) {
+            CHECK_POD5_OK(pod5_async_get_read_batch(queue, reader, index, &index));
+        }
+        auto batches = wait_for_completions(batch_indices.size());
+
+        std::vector<std::vector<std::int16_t>> read_signals(read_ids.size());
+        for (auto const & completion : batches) {
+            CHECK(completion.operation == POD5_ASYNC_GET_READ_BATCH);
+            CHECK(completion.error_no == POD5_OK);
+            REQUIRE(completion.batch);
+            auto const first_read = *static_cast<std::size_t *>(completion.user_data) * 10;
+
+            std::size_t row_count = 0;
+            CHECK_POD5_OK(pod5_get_read_batch_row_count(&row_count, completion.batch));
+            for (std::size_t row = 0; row < row_count; ++row) {
+                auto & signal = read_signals[first_read + row];
+                std::size_t sample_count = 0;
+                CHECK_POD5_OK(pod5_get_read_complete_sample_count(
+                    reader, completion.batch, row, &sample_count));
+                signal.resize(sample_count);
+                CHECK_POD5_OK(pod5_async_get_read_complete_signal(
+                    queue, reader, completion.batch, row, sample_count, signal.data(), nullptr));
+            }
+            std::int16_t sample = 0;
+            CHECK(
+                pod5_async_get_read_complete_signal(
+                    queue, reader, completion.batch, row_count, 1, &sample, nullptr)
+                == POD5_ERROR_INDEXERROR);
+            CHECK(
+                pod5_async_get_read_complete_signal(
+                    queue, nullptr, completion.batch, 0, 1, &sample, nullptr)
+                == POD5_ERROR_INVALID);
+
+            // The batch can be freed while its signal is decoded:
+            CHECK_POD5_OK(pod5_free_read_batch(completion.batch));
+        }
+
+        auto decoded = wait_for_completions(read_ids.size());
+        for (auto const & completion : decoded) {
+            CHECK(completion.operation == POD5_ASYNC_GET_READ_COMPLETE_SIGNAL);
+            CHECK(completion.error_no == POD5_OK);
+        }
+        CHECK(read_signals == signals);
+
+        THEN("The descriptor is not readable once every completion is collected")
+        {
+            pollfd poll_fd{fd, POLLIN, 0};
+            CHECK(poll(&poll_fd, 1, 0) == 0);
+        }
+    }
+
+    GIVEN("Invalid arguments")
+    {
+        CHECK(pod5_async_open_file(queue, "", nullptr, nullptr) == POD5_ERROR_INVALID);
+        CHECK(pod5_async_get_read_batch(queue, nullptr, 0, nullptr) == POD5_ERROR_INVALID);
+        std::size_t count = 0;
+        CHECK(pod5_get_async_completions(queue, nullptr, 1, &count) == POD5_ERROR_INVALID);
+    }
+}
+#endif
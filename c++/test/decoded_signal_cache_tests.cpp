@@ -0,0 +1,198 @@
+#include "pod5_format/decoded_signal_cache.h"
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace {
+pod5::DecodedSignalCache::Samples make_samples(std::size_t count, std::int16_t value)
+{
+    return std::make_shared<std::vector<std::int16_t> const>(count, value);
+}
+
+std::vector<std::uint64_t> rows(std::uint64_t first, std::size_t count)
+{
+    std::vector<std::uint64_t> result(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        result[i] = first + i;
+    }
+    return result;
+}
+}  // namespace
+
+SCENARIO("Frequency sketch")
+{
+    pod5::FrequencySketch sketch(1000);
+    CHECK(sketch.width() == 1024);
+
+    GIVEN("Keys accessed different numbers of times")
+    {
+        for (std::uint64_t key = 0; key < 100; ++key) {
+            for (std::uint64_t i = 0; i < key % 10; ++i) {
+                sketch.increment(key);
+            }
+        }
+
+        THEN("Estimates are never below the true count")
+        {
+            for (std::uint64_t key = 0; key < 100; ++key) {
+                CHECK(sketch.estimate(key) >= key % 10);
+            }
+            CHECK(sketch.estimate(12345) <= 1);
+        }
+
+        THEN("Counts saturate, then fade as other keys are accessed")
+        {
+            for (int i = 0; i < 100; ++i) {
+                sketch.increment(5);
+            }
+            CHECK(sketch.estimate(5) == pod5::FrequencySketch::MAX_COUNT);
+
+            for (std::uint64_t key = 1000; key < 1000 + 10 * sketch.width(); ++key) {
+                sketch.increment(key);
+            }
+            CHECK(sketch.estimate(5) < pod5::FrequencySketch::MAX_COUNT);
+        }
+    }
+}
+
+SCENARIO("Decoded signal cache")
+{
+    // Room for 10 reads of 100 samples:
+    pod5::DecodedSignalCache cache(10 * 100 * sizeof(std::int16_t));
+    auto const file = cache.register_file();
+    auto const other_file = cache.register_file();
+    CHECK(file != other_file);
+
+    GIVEN("A read added to the cache")
+    {
+        CHECK(!cache.find(file, rows(0, 1)));
+        CHECK(cache.insert(file, rows(0, 1), make_samples(100, 7)));
+
+        THEN("Lookups of the read hit")
+        {
+            auto const samples = cache.find(file, rows(0, 1));
+            REQUIRE(samples);
+            CHECK(samples->size() == 100);
+            CHECK((*samples)[0] == 7);
+
+            auto const metrics = cache.metrics();
+            CHECK(metrics.hits == 1);
+            CHECK(metrics.misses == 1);
+            CHECK(metrics.hit_rate() == 0.5);
+            CHECK(metrics.entry_count == 1);
+            CHECK(metrics.byte_count == 200);
+        }
+
+        THEN("Lookups of other files and rows miss")
+        {
+            CHECK(!cache.find(other_file, rows(0, 1)));
+            CHECK(!cache.find(file, rows(1, 1)));
+            CHECK(!cache.find(file, rows(0, 2)));
+        }
+
+        THEN("Reads sharing the first row and row count but not later rows are told apart")
+        {
+            std::vector<std::uint64_t> const split_rows{0, 7};
+            CHECK(!cache.find(file, split_rows));
+            CHECK(cache.insert(file, rows(0, 2), make_samples(100, 1)));
+            CHECK(cache.insert(file, split_rows, make_samples(100, 2)));
+
+            auto const contiguous = cache.find(file, rows(0, 2));
+            auto const split = cache.find(file, split_rows);
+            REQUIRE(contiguous);
+            REQUIRE(split);
+            CHECK((*contiguous)[0] == 1);
+            CHECK((*split)[0] == 2);
+            CHECK(cache.metrics().entry_count == 3);
+        }
+
+        THEN("Removing the file drops the read")
+        {
+            cache.remove_file(file);
+            CHECK(!cache.find(file, rows(0, 1)));
+            CHECK(cache.metrics().byte_count == 0);
+        }
+    }
+
+    GIVEN("A read larger than the cache")
+    {
+        THEN("It is rejected")
+        {
+            CHECK(!cache.insert(file, rows(0, 1), make_samples(2000, 1)));
+            CHECK(cache.metrics().rejections == 1);
+        }
+    }
+
+    GIVEN("Samples offered without a copy")
+    {
+        std::vector<std::int16_t> const samples(100, 3);
+        std::vector<std::int16_t> const large_samples(2000, 3);
+
+        THEN("Admitted samples are copied into the cache")
+        {
+            CHECK(cache.insert(file, rows(0, 1), gsl::make_span(samples)));
+            auto const cached = cache.find(file, rows(0, 1));
+            REQUIRE(cached);
+            CHECK(*cached == samples);
+            CHECK(cached->data() != samples.data());
+        }
+
+        THEN("Rejected samples are not added")
+        {
+            CHECK(!cache.insert(file, rows(0, 1), gsl::make_span(large_samples)));
+            CHECK(cache.metrics().rejections == 1);
+            CHECK(cache.metrics().entry_count == 0);
+        }
+    }
+
+    GIVEN("A full cache of reads looked up repeatedly")
+    {
+        for (std::uint64_t row = 0; row < 10; ++row) {
+            for (int i = 0; i < 3; ++i) {
+                cache.find(file, rows(row, 1));
+            }
+            REQUIRE(cache.insert(file, rows(row, 1), make_samples(100, std::int16_t(row))));
+        }
+
+        WHEN("A scan of reads used once follows")
+        {
+            for (std::uint64_t row = 100; row < 200; ++row) {
+                if (!cache.find(file, rows(row, 1))) {
+                    cache.insert(file, rows(row, 1), make_samples(100, 0));
+                }
+            }
+
+            THEN("The scan doesn't evict the hot reads")
+            {
+                for (std::uint64_t row = 0; row < 10; ++row) {
+                    auto const samples = cache.find(file, rows(row, 1));
+                    REQUIRE(samples);
+                    CHECK((*samples)[0] == std::int16_t(row));
+                }
+                CHECK(cache.metrics().rejections == 100);
+                CHECK(cache.metrics().evictions == 0);
+            }
+        }
+
+        WHEN("A new read becomes hotter than the others")
+        {
+            for (int i = 0; i < 5; ++i) {
+                cache.find(file, rows(50, 1));
+            }
+            CHECK(cache.insert(file, rows(50, 1), make_samples(100, 50)));
+
+            THEN("It replaces the least recently used read")
+            {
+                CHECK(cache.find(file, rows(50, 1)));
+                CHECK(!cache.find(file, rows(0, 1)));
+                auto const metrics = cache.metrics();
+                CHECK(metrics.evictions == 1);
+                CHECK(metrics.entry_count == 10);
+                CHECK(metrics.byte_count == cache.capacity_bytes());
+            }
+        }
+    }
+}
@@ -1,7 +1,16 @@
 #include "pod5_format/async_signal_loader.h"
+#include "pod5_format/channel_index_table_schema.h"
+#include "pod5_format/channel_ordered_read_loader.h"
+#include "pod5_format/decoded_signal_cache.h"
 #include "pod5_format/file_reader.h"
+#include "pod5_format/file_updater.h"
+#include "pod5_format/file_verifier.h"
 #include "pod5_format/file_writer.h"
 #include "pod5_format/read_table_reader.h"
+#include "pod5_format/shared_signal_cache.h"
+#include "pod5_format/signal_compression.h"
+#include "pod5_format/signal_statistics.h"
+#include "pod5_format/signal_summary.h"
 #include "pod5_format/signal_table_reader.h"
 #include "test_utils.h"
 #include "utils.h"
@@ -9,14 +18,28 @@
 #include <arrow/array/array_binary.h>
 #include <arrow/array/array_dict.h>
 #include <arrow/array/array_primitive.h>
+#include <arrow/filesystem/localfs.h>
+#include <arrow/io/file.h>
+#include <arrow/io/memory.h>
+#include <arrow/ipc/message.h>
 #include <arrow/memory_pool.h>
 #include <boost/lexical_cast.hpp>
 #include <boost/uuid/random_generator.hpp>
 #include <boost/uuid/uuid_io.hpp>
 #include <catch2/catch.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <fstream>
 #include <iostream>
+#include <limits>
 #include <numeric>
+#include <random>
+#include <tuple>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
 
 void run_file_reader_writer_tests()
 {
@@ -54,6 +77,7 @@ void run_file_reader_writer_tests()
         options.set_max_signal_chunk_size(20'480);
         options.set_read_table_batch_size(1);
         options.set_signal_table_batch_size(5);
+        options.set_write_signal_statistics(true);
 
         auto writer = pod5::create_file_writer(file, "test_software", options);
         REQUIRE_ARROW_STATUS_OK(writer);
@@ -95,6 +119,8 @@ void run_file_reader_writer_tests()
         REQUIRE_ARROW_STATUS_OK(reader);
 
         REQUIRE((*reader)->num_read_record_batches() == 10);
+        CHECK(!(*reader)->has_signal_summary());
+        CHECK((*reader)->other_index_locations().empty());
         for (std::size_t i = 0; i < 10; ++i) {
             auto read_batch = (*reader)->read_read_record_batch(i);
             REQUIRE_ARROW_STATUS_OK(read_batch);
@@ -112,6 +138,14 @@ void run_file_reader_writer_tests()
             auto const run_info = (*reader)->find_run_info(*run_info_id);
             CHECK(**run_info == run_info_data);
 
+            REQUIRE(read_batch->has_signal_statistics());
+            auto const statistics = read_batch->get_signal_statistics(0);
+            REQUIRE_ARROW_STATUS_OK(statistics);
+            CHECK(
+                *statistics
+                == pod5::compute_signal_statistics(
+                    gsl::make_span(signal_1), run_info_data.adc_min, run_info_data.adc_max));
+
             REQUIRE((*reader)->num_signal_record_batches() == 10);
             auto signal_batch = (*reader)->read_signal_record_batch(i);
             REQUIRE_ARROW_STATUS_OK(signal_batch);
@@ -341,3 +375,1617 @@ SCENARIO("Opening older files")
             {"version", "3.4.0-rc3"},
         });
 }
+
+SCENARIO("Signal summary index")
+{
+    static constexpr char const * file = "./foo_summary.pod5";
+    REQUIRE_ARROW_STATUS_OK(remove_file_if_exists(file));
+    (void)pod5::register_extension_types();
+    auto fin = gsl::finally([] { (void)pod5::unregister_extension_types(); });
+
+    auto uuid_gen = boost::uuids::random_generator_mt19937();
+    std::vector<boost::uuids::uuid> read_ids{uuid_gen(), uuid_gen(), uuid_gen()};
+    std::vector<std::vector<std::int16_t>> signals{
+        std::vector<std::int16_t>(10'000), std::vector<std::int16_t>(1), {}};
+    for (std::size_t i = 0; i < signals[0].size(); ++i) {
+        signals[0][i] = std::int16_t((i * 31) % 997) - 400;
+    }
+    signals[1][0] = 12;
+
+    std::uint32_t const bin_size = 64;
+    {
+        pod5::FileWriterOptions options;
+        options.set_signal_summary_bin_size(bin_size);
+        options.set_read_table_batch_size(2);
+
+        auto writer = pod5::create_file_writer(file, "test_software", options);
+        REQUIRE_ARROW_STATUS_OK(writer);
+
+        auto run_info = (*writer)->add_run_info(get_test_run_info_data("_run_info"));
+        auto end_reason = (*writer)->lookup_end_reason(pod5::ReadEndReason::unknown);
+        auto pore_type = (*writer)->add_pore_type("pore_type");
+
+        for (std::size_t i = 0; i < read_ids.size(); ++i) {
+            pod5::ReadData read_data{};
+            read_data.read_id = read_ids[i];
+            read_data.pore_type = *pore_type;
+            read_data.end_reason = *end_reason;
+            read_data.run_info = *run_info;
+            CHECK_ARROW_STATUS_OK(
+                (*writer)->add_complete_read(read_data, gsl::make_span(signals[i])));
+        }
+        CHECK_ARROW_STATUS_OK((*writer)->close());
+    }
+
+    auto reader = pod5::open_file_reader(file, {});
+    REQUIRE_ARROW_STATUS_OK(reader);
+    REQUIRE((*reader)->has_signal_summary());
+    CHECK((*reader)->other_index_locations().size() == 1);
+
+    // Signal statistics are not written unless asked for:
+    auto read_batch = (*reader)->read_read_record_batch(0);
+    REQUIRE_ARROW_STATUS_OK(read_batch);
+    CHECK(!read_batch->has_signal_statistics());
+
+    auto const expected_levels =
+        pod5::build_signal_summary_levels(gsl::make_span(signals[0]), bin_size);
+    // 157 bins at level 0, halving until a single bin remains:
+    REQUIRE(expected_levels.size() == 9);
+
+    for (std::size_t level = 0; level < expected_levels.size(); ++level) {
+        CAPTURE(level);
+        auto const & expected = expected_levels[level];
+        auto summary = (*reader)->get_signal_summary(read_ids[0], level, 0, signals[0].size());
+        REQUIRE_ARROW_STATUS_OK(summary);
+        CHECK(summary->level_count == expected_levels.size());
+        CHECK(summary->bin_size == bin_size << level);
+        CHECK(summary->first_sample == 0);
+        CHECK(summary->read_sample_count == signals[0].size());
+        CHECK(summary->min == expected.min);
+        CHECK(summary->max == expected.max);
+        CHECK(summary->mean == expected.mean);
+    }
+
+    // The coarsest level covers the whole read:
+    auto const & top = expected_levels.back();
+    CHECK(top.min[0] == *std::min_element(signals[0].begin(), signals[0].end()));
+    CHECK(top.max[0] == *std::max_element(signals[0].begin(), signals[0].end()));
+
+    // A sub range is widened to whole bins:
+    auto range = (*reader)->get_signal_summary(read_ids[0], 1, 200, 300);
+    REQUIRE_ARROW_STATUS_OK(range);
+    CHECK(range->first_sample == 128);
+    REQUIRE(range->bin_count() == 3);
+    CHECK(range->mean[0] == expected_levels[1].mean[1]);
+    CHECK(range->mean[2] == expected_levels[1].mean[3]);
+
+    // Ranges past the end of the read are clamped:
+    auto past_end = (*reader)->get_signal_summary(read_ids[0], 0, 20'000, 10);
+    REQUIRE_ARROW_STATUS_OK(past_end);
+    CHECK(past_end->bin_count() == 0);
+
+    auto single_sample = (*reader)->get_signal_summary(read_ids[1], 0, 0, 100);
+    REQUIRE_ARROW_STATUS_OK(single_sample);
+    CHECK(single_sample->level_count == 1);
+    CHECK(single_sample->mean == std::vector<float>{12.0f});
+
+    CHECK((*reader)->get_signal_summary(read_ids[0], 9, 0, 1).status().IsIndexError());
+    CHECK((*reader)->get_signal_summary(read_ids[2], 0, 0, 1).status().IsKeyError());
+    CHECK((*reader)->get_signal_summary(uuid_gen(), 0, 0, 1).status().IsKeyError());
+}
+
+SCENARIO("Channel index")
+{
+    static constexpr char const * file = "./foo_channel_index.pod5";
+    REQUIRE_ARROW_STATUS_OK(remove_file_if_exists(file));
+    (void)pod5::register_extension_types();
+    auto fin = gsl::finally([] { (void)pod5::unregister_extension_types(); });
+
+    struct TestRead {
+        boost::uuids::uuid read_id;
+        std::uint16_t channel;
+        std::uint32_t read_number;
+        std::uint64_t start_sample;
+    };
+
+    // Reads are written interleaved across channels, as they would be during acquisition:
+    auto uuid_gen = boost::uuids::random_generator_mt19937();
+    std::vector<TestRead> reads;
+    for (std::uint32_t i = 0; i < 20; ++i) {
+        std::uint16_t const channel = 1 + (i % 3);
+        reads.push_back({uuid_gen(), channel, 100 + i, std::uint64_t(1000 * (i / 3))});
+    }
+    // An out of order read (written late) on channel 2:
+    reads.push_back({uuid_gen(), 2, 5, 500});
+
+    std::vector<std::int16_t> signal(10, 1);
+    {
+        pod5::FileWriterOptions options;
+        options.set_write_channel_index(true);
+        options.set_read_table_batch_size(4);
+
+        auto writer = pod5::create_file_writer(file, "test_software", options);
+        REQUIRE_ARROW_STATUS_OK(writer);
+
+        auto run_info = (*writer)->add_run_info(get_test_run_info_data("_run_info"));
+        auto end_reason = (*writer)->lookup_end_reason(pod5::ReadEndReason::unknown);
+        auto pore_type = (*writer)->add_pore_type("pore_type");
+
+        for (auto const & read : reads) {
+            pod5::ReadData read_data{};
+            read_data.read_id = read.read_id;
+            read_data.channel = read.channel;
+            read_data.read_number = read.read_number;
+            read_data.start_sample = read.start_sample;
+            read_data.pore_type = *pore_type;
+            read_data.end_reason = *end_reason;
+            read_data.run_info = *run_info;
+            CHECK_ARROW_STATUS_OK((*writer)->add_complete_read(read_data, gsl::make_span(signal)));
+        }
+        CHECK_ARROW_STATUS_OK((*writer)->close());
+    }
+
+    auto reader = pod5::open_file_reader(file, {});
+    REQUIRE_ARROW_STATUS_OK(reader);
+    REQUIRE((*reader)->has_channel_index());
+    CHECK_FALSE((*reader)->has_signal_summary());
+
+    auto const plan_read_ids = [&](pod5::ReadTraversalPlan const & plan) {
+        REQUIRE(plan.batch_counts.size() == (*reader)->num_read_record_batches());
+        std::vector<boost::uuids::uuid> result;
+        std::size_t row_offset = 0;
+        for (std::size_t batch = 0; batch < plan.batch_counts.size(); ++batch) {
+            auto read_batch = (*reader)->read_read_record_batch(batch);
+            REQUIRE_ARROW_STATUS_OK(read_batch);
+            auto read_ids = read_batch->read_id_column();
+            for (std::size_t i = 0; i < plan.batch_counts[batch]; ++i) {
+                result.push_back(read_ids->Value(plan.batch_rows[row_offset + i]));
+            }
+            row_offset += plan.batch_counts[batch];
+        }
+        CHECK(row_offset == plan.read_count());
+        return result;
+    };
+
+    auto const expected_read_ids =
+        [&](std::uint16_t channel, std::uint64_t first, std::uint64_t end) {
+            std::vector<boost::uuids::uuid> result;
+            for (auto const & read : reads) {
+                if (read.channel == channel && read.start_sample >= first
+                    && read.start_sample < end)
+                {
+                    result.push_back(read.read_id);
+                }
+            }
+            return result;
+        };
+
+    auto const sorted = [](std::vector<boost::uuids::uuid> ids) {
+        std::sort(ids.begin(), ids.end());
+        return ids;
+    };
+
+    auto window = (*reader)->plan_channel_window_traversal(2, 500, 3000);
+    REQUIRE_ARROW_STATUS_OK(window);
+    CHECK(window->read_count() == 3);
+    CHECK(sorted(plan_read_ids(*window)) == sorted(expected_read_ids(2, 500, 3000)));
+
+    auto whole_channel = (*reader)->plan_channel_window_traversal(
+        3, 0, std::numeric_limits<std::uint64_t>::max());
+    REQUIRE_ARROW_STATUS_OK(whole_channel);
+    CHECK(
+        sorted(plan_read_ids(*whole_channel))
+        == sorted(expected_read_ids(3, 0, std::numeric_limits<std::uint64_t>::max())));
+
+    auto empty_window = (*reader)->plan_channel_window_traversal(1, 1, 1000);
+    REQUIRE_ARROW_STATUS_OK(empty_window);
+    CHECK(empty_window->read_count() == 0);
+
+    auto missing_channel = (*reader)->plan_channel_window_traversal(512, 0, 1000);
+    REQUIRE_ARROW_STATUS_OK(missing_channel);
+    CHECK(missing_channel->read_count() == 0);
+
+    auto by_read_number = (*reader)->plan_channel_read_number_traversal(2, 5);
+    REQUIRE_ARROW_STATUS_OK(by_read_number);
+    CHECK(plan_read_ids(*by_read_number) == std::vector<boost::uuids::uuid>{reads.back().read_id});
+
+    CHECK((*reader)->plan_channel_read_number_traversal(1, 5).status().IsKeyError());
+
+    // Plans can be handed directly to the signal loader:
+    pod5::AsyncSignalLoader loader(
+        *reader,
+        pod5::AsyncSignalLoader::SamplesMode::Samples,
+        gsl::make_span(window->batch_counts),
+        gsl::make_span(window->batch_rows));
+    std::size_t loaded_reads = 0;
+    while (true) {
+        auto next_batch = loader.release_next_batch();
+        REQUIRE_ARROW_STATUS_OK(next_batch);
+        if (!*next_batch) {
+            break;
+        }
+        for (auto const & samples : (*next_batch)->samples()) {
+            CHECK(samples == signal);
+            loaded_reads += 1;
+        }
+    }
+    CHECK(loaded_reads == window->read_count());
+}
+
+SCENARIO("Channel ordered read loader")
+{
+    static constexpr char const * file = "./foo_channel_ordered.pod5";
+    REQUIRE_ARROW_STATUS_OK(remove_file_if_exists(file));
+    (void)pod5::register_extension_types();
+    auto fin = gsl::finally([] { (void)pod5::unregister_extension_types(); });
+
+    auto const write_channel_index = GENERATE(true, false);
+    CAPTURE(write_channel_index);
+
+    struct TestRead {
+        boost::uuids::uuid read_id;
+        std::uint16_t channel;
+        std::uint64_t start_sample;
+        std::vector<std::int16_t> signal;
+    };
+
+    // Write reads round robin across channels, with start samples decreasing on odd channels:
+    auto uuid_gen = boost::uuids::random_generator_mt19937();
+    std::vector<TestRead> reads;
+    for (std::uint32_t i = 0; i < 50; ++i) {
+        std::uint16_t const channel = 1 + (i % 5);
+        std::uint64_t const start_sample = (channel % 2) ? 10'000 - i * 100 : i * 100;
+        std::vector<std::int16_t> signal(1 + i, std::int16_t(i));
+        reads.push_back({uuid_gen(), channel, start_sample, std::move(signal)});
+    }
+
+    {
+        pod5::FileWriterOptions options;
+        options.set_write_channel_index(write_channel_index);
+        options.set_read_table_batch_size(7);
+
+        auto writer = pod5::create_file_writer(file, "test_software", options);
+        REQUIRE_ARROW_STATUS_OK(writer);
+
+        auto run_info = (*writer)->add_run_info(get_test_run_info_data("_run_info"));
+        auto end_reason = (*writer)->lookup_end_reason(pod5::ReadEndReason::unknown);
+        auto pore_type = (*writer)->add_pore_type("pore_type");
+
+        for (auto const & read : reads) {
+            pod5::ReadData read_data{};
+            read_data.read_id = read.read_id;
+            read_data.channel = read.channel;
+            read_data.start_sample = read.start_sample;
+            read_data.pore_type = *pore_type;
+            read_data.end_reason = *end_reason;
+            read_data.run_info = *run_info;
+            CHECK_ARROW_STATUS_OK(
+                (*writer)->add_complete_read(read_data, gsl::make_span(read.signal)));
+        }
+        CHECK_ARROW_STATUS_OK((*writer)->close());
+    }
+
+    auto reader = pod5::open_file_reader(file, {});
+    REQUIRE_ARROW_STATUS_OK(reader);
+    CHECK((*reader)->has_channel_index() == write_channel_index);
+
+    auto expected = reads;
+    std::stable_sort(expected.begin(), expected.end(), [](auto const & a, auto const & b) {
+        return std::tie(a.channel, a.start_sample) < std::tie(b.channel, b.start_sample);
+    });
+
+    auto locations = (*reader)->channel_ordered_read_locations();
+    REQUIRE_ARROW_STATUS_OK(locations);
+    REQUIRE(locations->size() == expected.size());
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        CHECK((*locations)[i].channel == expected[i].channel);
+        CHECK((*locations)[i].start_sample == expected[i].start_sample);
+    }
+
+    pod5::ChannelOrderedReadLoader loader(
+        *reader, pod5::ChannelOrderedReadLoader::SamplesMode::Samples, 8, 3, 2);
+    CHECK(loader.read_count() == expected.size());
+
+    std::size_t next_read = 0;
+    while (true) {
+        auto batch = loader.release_next_batch();
+        REQUIRE_ARROW_STATUS_OK(batch);
+        if (!*batch) {
+            break;
+        }
+        CHECK((*batch)->first_read_index() == next_read);
+        for (std::size_t i = 0; i < (*batch)->read_ids().size(); ++i, ++next_read) {
+            CAPTURE(next_read);
+            REQUIRE(next_read < expected.size());
+            CHECK((*batch)->read_ids()[i] == expected[next_read].read_id);
+            CHECK((*batch)->locations()[i].channel == expected[next_read].channel);
+            CHECK((*batch)->sample_count()[i] == expected[next_read].signal.size());
+            CHECK((*batch)->samples()[i] == expected[next_read].signal);
+        }
+    }
+    CHECK(next_read == expected.size());
+    CHECK(loader.is_finished());
+}
+
+SCENARIO("Batch checksums")
+{
+    static constexpr char const * file = "./foo_batch_checksums.pod5";
+    REQUIRE_ARROW_STATUS_OK(remove_file_if_exists(file));
+    (void)pod5::register_extension_types();
+    auto fin = gsl::finally([] { (void)pod5::unregister_extension_types(); });
+
+    auto uuid_gen = boost::uuids::random_generator_mt19937();
+    {
+        pod5::FileWriterOptions options;
+        options.set_read_table_batch_size(3);
+        options.set_signal_table_batch_size(3);
+
+        auto writer = pod5::create_file_writer(file, "test_software", options);
+        REQUIRE_ARROW_STATUS_OK(writer);
+
+        auto run_info = (*writer)->add_run_info(get_test_run_info_data("_run_info"));
+        auto end_reason = (*writer)->lookup_end_reason(pod5::ReadEndReason::unknown);
+        auto pore_type = (*writer)->add_pore_type("pore_type");
+
+        std::vector<std::int16_t> signal(20'000);
+        for (std::uint32_t i = 0; i < 10; ++i) {
+            for (std::size_t j = 0; j < signal.size(); ++j) {
+                signal[j] = std::int16_t((j * 7919 + i) % 2001);
+            }
+
+            pod5::ReadData read_data{};
+            read_data.read_id = uuid_gen();
+            read_data.read_number = i;
+            read_data.pore_type = *pore_type;
+            read_data.end_reason = *end_reason;
+            read_data.run_info = *run_info;
+            CHECK_ARROW_STATUS_OK((*writer)->add_complete_read(read_data, gsl::make_span(signal)));
+        }
+        CHECK_ARROW_STATUS_OK((*writer)->close());
+    }
+
+    std::size_t signal_table_offset = 0;
+    std::size_t signal_table_size = 0;
+    std::size_t expected_batch_count = 0;
+    {
+        auto reader = pod5::open_file_reader(file, {});
+        REQUIRE_ARROW_STATUS_OK(reader);
+
+        signal_table_offset = (*reader)->signal_table_location().offset;
+        signal_table_size = (*reader)->signal_table_location().size;
+        // The checksums are stored in the file footer, one per batch:
+        CHECK(
+            (*reader)->signal_table_location().batch_checksums.size()
+            == (*reader)->num_signal_record_batches());
+        CHECK(
+            (*reader)->read_table_location().batch_checksums.size()
+            == (*reader)->num_read_record_batches());
+
+        auto report = (*reader)->verify_batch_checksums(3);
+        REQUIRE_ARROW_STATUS_OK(report);
+        CHECK(report->ok());
+        CHECK(report->unchecked_batch_count == 0);
+        CHECK(report->checked_byte_count > 0);
+
+        // Every read and signal batch, and at least one run info batch:
+        expected_batch_count = report->checked_batch_count;
+        CHECK(
+            expected_batch_count
+            > (*reader)->num_read_record_batches() + (*reader)->num_signal_record_batches());
+    }
+
+    GIVEN("A byte of signal data is damaged")
+    {
+        {
+            // The signal batches make up almost all of the signal table:
+            std::fstream stream(file, std::ios::in | std::ios::out | std::ios::binary);
+            stream.seekg(signal_table_offset + signal_table_size / 2);
+            char value = 0;
+            stream.read(&value, 1);
+            stream.seekp(signal_table_offset + signal_table_size / 2);
+            value ^= 0x10;
+            stream.write(&value, 1);
+        }
+
+        THEN("The file verification reports one failure")
+        {
+            auto reader = pod5::open_file_reader(file, {});
+            REQUIRE_ARROW_STATUS_OK(reader);
+
+            auto report = (*reader)->verify_batch_checksums();
+            REQUIRE_ARROW_STATUS_OK(report);
+            CHECK(report->failures.size() == 1);
+            CHECK(report->checked_batch_count == expected_batch_count - 1);
+
+            // The scrub checks the same bytes it decodes:
+            auto scrub = pod5::verify_file(**reader, 2);
+            REQUIRE_ARROW_STATUS_OK(scrub);
+            CHECK(scrub->batch_checksums.failures.size() == 1);
+            CHECK(scrub->batch_checksums.checked_batch_count == expected_batch_count - 1);
+        }
+
+        THEN("A copy of the file keeps the checksums, and the damage")
+        {
+            static constexpr char const * copy = "./foo_batch_checksums_copy.pod5";
+            REQUIRE_ARROW_STATUS_OK(remove_file_if_exists(copy));
+            auto reader = pod5::open_file_reader(file, {});
+            REQUIRE_ARROW_STATUS_OK(reader);
+            REQUIRE_ARROW_STATUS_OK(
+                pod5::update_file(arrow::default_memory_pool(), *reader, copy));
+
+            auto copy_reader = pod5::open_file_reader(copy, {});
+            REQUIRE_ARROW_STATUS_OK(copy_reader);
+            auto report = (*copy_reader)->verify_batch_checksums();
+            REQUIRE_ARROW_STATUS_OK(report);
+            CHECK(report->unchecked_batch_count == 0);
+            CHECK(report->failures.size() == 1);
+        }
+
+        THEN("Loading the damaged batch fails when verification is requested")
+        {
+            pod5::FileReaderOptions options;
+            options.set_verify_batch_checksums(true);
+            auto reader = pod5::open_file_reader(file, options);
+            REQUIRE_ARROW_STATUS_OK(reader);
+
+            std::size_t failed_batches = 0;
+            for (std::size_t i = 0; i < (*reader)->num_signal_record_batches(); ++i) {
+                auto batch = (*reader)->read_signal_record_batch(i);
+                if (!batch.ok()) {
+                    CHECK(batch.status().IsIOError());
+                    failed_batches += 1;
+                }
+            }
+            CHECK(failed_batches == 1);
+        }
+
+        THEN("Sample counts from the damaged batch fail when verification is requested")
+        {
+            pod5::FileReaderOptions options;
+            options.set_verify_batch_checksums(true);
+            auto reader = pod5::open_file_reader(file, options);
+            REQUIRE_ARROW_STATUS_OK(reader);
+
+            // Sample counts are served without decoding signal, they must still be checked:
+            std::size_t failed_reads = 0;
+            for (std::size_t i = 0; i < (*reader)->num_read_record_batches(); ++i) {
+                auto read_batch = (*reader)->read_read_record_batch(i);
+                REQUIRE_ARROW_STATUS_OK(read_batch);
+                auto const signal_column = read_batch->signal_column();
+                for (std::int64_t row = 0; row < signal_column->length(); ++row) {
+                    auto const signal_rows = std::static_pointer_cast<arrow::UInt64Array>(
+                        signal_column->value_slice(row));
+                    auto const sample_count = (*reader)->extract_sample_count(
+                        gsl::make_span(signal_rows->raw_values(), signal_rows->length()));
+                    if (!sample_count.ok()) {
+                        CHECK(sample_count.status().IsIOError());
+                        failed_reads += 1;
+                    }
+                }
+            }
+            CHECK(failed_reads > 0);
+        }
+    }
+}
+
+SCENARIO("File verification")
+{
+    static constexpr char const * file = "./foo_verification.pod5";
+    REQUIRE_ARROW_STATUS_OK(remove_file_if_exists(file));
+    (void)pod5::register_extension_types();
+    auto fin = gsl::finally([] { (void)pod5::unregister_extension_types(); });
+
+    auto const write_damaged_reads = GENERATE(false, true);
+    CAPTURE(write_damaged_reads);
+
+    auto uuid_gen = boost::uuids::random_generator_mt19937();
+    {
+        pod5::FileWriterOptions options;
+        options.set_max_signal_chunk_size(100);
+        options.set_signal_table_batch_size(4);
+        options.set_read_table_batch_size(3);
+
+        auto writer = pod5::create_file_writer(file, "test_software", options);
+        REQUIRE_ARROW_STATUS_OK(writer);
+
+        auto run_info = (*writer)->add_run_info(get_test_run_info_data("_run_info"));
+        auto end_reason = (*writer)->lookup_end_reason(pod5::ReadEndReason::unknown);
+        auto pore_type = (*writer)->add_pore_type("pore_type");
+
+        auto const make_read_data = [&] {
+            pod5::ReadData read_data{};
+            read_data.read_id = uuid_gen();
+            read_data.pore_type = *pore_type;
+            read_data.end_reason = *end_reason;
+            read_data.run_info = *run_info;
+            return read_data;
+        };
+
+        // Reads spanning several signal rows and batches:
+        for (std::uint32_t i = 0; i < 10; ++i) {
+            std::vector<std::int16_t> signal(50 + 40 * i, std::int16_t(i));
+            CHECK_ARROW_STATUS_OK(
+                (*writer)->add_complete_read(make_read_data(), gsl::make_span(signal)));
+        }
+
+        if (write_damaged_reads) {
+            std::vector<std::int16_t> signal(100, 5);
+            auto compressed =
+                pod5::compress_signal(gsl::make_span(signal), arrow::default_memory_pool());
+            REQUIRE_ARROW_STATUS_OK(compressed);
+            auto const compressed_span = gsl::make_span(
+                (*compressed)->data(), std::size_t((*compressed)->size()));
+
+            auto const valid_read = make_read_data();
+            auto valid_row =
+                (*writer)->add_pre_compressed_signal(valid_read.read_id, compressed_span, 100);
+            REQUIRE_ARROW_STATUS_OK(valid_row);
+            // A row recording fewer samples than it holds:
+            auto const short_read = make_read_data();
+            auto short_row =
+                (*writer)->add_pre_compressed_signal(short_read.read_id, compressed_span, 90);
+            REQUIRE_ARROW_STATUS_OK(short_row);
+
+            auto const miscounted_read = make_read_data();
+            auto miscounted_row =
+                (*writer)->add_pre_compressed_signal(miscounted_read.read_id, compressed_span, 100);
+            REQUIRE_ARROW_STATUS_OK(miscounted_row);
+
+            std::vector<std::uint64_t> rows{*valid_row};
+            CHECK_ARROW_STATUS_OK((*writer)->add_complete_read(valid_read, rows, 100));
+            // A second read sharing the valid read's row:
+            CHECK_ARROW_STATUS_OK((*writer)->add_complete_read(make_read_data(), rows, 100));
+
+            // A read recording the wrong sample count:
+            rows = {*miscounted_row};
+            CHECK_ARROW_STATUS_OK((*writer)->add_complete_read(miscounted_read, rows, 101));
+
+            rows = {*short_row};
+            CHECK_ARROW_STATUS_OK((*writer)->add_complete_read(short_read, rows, 90));
+            rows = {1'000'000};
+            CHECK_ARROW_STATUS_OK((*writer)->add_complete_read(make_read_data(), rows, 0));
+        }
+        CHECK_ARROW_STATUS_OK((*writer)->close());
+    }
+
+    auto reader = pod5::open_file_reader(file, {});
+    REQUIRE_ARROW_STATUS_OK(reader);
+
+    auto report = pod5::verify_file(**reader, 3);
+    REQUIRE_ARROW_STATUS_OK(report);
+    CHECK(report->batch_checksums.ok());
+    CHECK(report->batch_checksums.checked_batch_count > 0);
+    CHECK(report->elapsed_seconds >= 0);
+
+    // Every read is chunked into rows of at most 100 samples:
+    std::size_t expected_rows = 0;
+    std::uint64_t expected_samples = 0;
+    for (std::uint32_t i = 0; i < 10; ++i) {
+        expected_rows += (50 + 40 * i + 99) / 100;
+        expected_samples += 50 + 40 * i;
+    }
+
+    if (!write_damaged_reads) {
+        CHECK(report->ok());
+        CHECK(report->errors.empty());
+        CHECK(report->read_count == 10);
+        CHECK(report->signal_row_count == expected_rows);
+        CHECK(report->unreferenced_signal_row_count == 0);
+        CHECK(report->sample_count == expected_samples);
+        CHECK(report->signal_byte_count > 0);
+    } else {
+        CHECK_FALSE(report->ok());
+        CHECK(report->read_count == 15);
+        CHECK(report->signal_row_count == expected_rows + 3);
+        // The short row fails to decode, so its samples are not counted:
+        CHECK(report->sample_count == expected_samples + 200);
+
+        // Decode failure, shared row, wrong sample count and out of range row:
+        CHECK(report->error_count == 4);
+        REQUIRE(report->errors.size() == 4);
+        auto const has_error = [&](std::string const & text) {
+            return std::any_of(report->errors.begin(), report->errors.end(), [&](auto const & e) {
+                return e.find(text) != std::string::npos;
+            });
+        };
+        CHECK(has_error("failed to decode"));
+        CHECK(has_error("belongs to another read"));
+        CHECK(has_error("records 101 samples, but its signal holds 100"));
+        CHECK(has_error("beyond the"));
+    }
+}
+
+SCENARIO("Aligned signal batches")
+{
+    static constexpr char const * file = "./foo_aligned_signal.pod5";
+    REQUIRE_ARROW_STATUS_OK(remove_file_if_exists(file));
+    (void)pod5::register_extension_types();
+    auto fin = gsl::finally([] { (void)pod5::unregister_extension_types(); });
+
+    auto const alignment = GENERATE(0u, 4096u, 65536u);
+    CAPTURE(alignment);
+
+    std::uint64_t expected_samples = 0;
+    auto uuid_gen = boost::uuids::random_generator_mt19937();
+    {
+        pod5::FileWriterOptions options;
+        options.set_signal_table_batch_size(3);
+        options.set_signal_batch_alignment(alignment);
+
+        auto writer = pod5::create_file_writer(file, "test_software", options);
+        REQUIRE_ARROW_STATUS_OK(writer);
+
+        auto run_info = (*writer)->add_run_info(get_test_run_info_data("_run_info"));
+        auto end_reason = (*writer)->lookup_end_reason(pod5::ReadEndReason::unknown);
+        auto pore_type = (*writer)->add_pore_type("pore_type");
+
+        for (std::uint32_t i = 0; i < 10; ++i) {
+            std::vector<std::int16_t> signal(1'000 + 1'234 * i);
+            std::iota(signal.begin(), signal.end(), std::int16_t(i));
+            expected_samples += signal.size();
+
+            pod5::ReadData read_data{};
+            read_data.read_id = uuid_gen();
+            read_data.read_number = i;
+            read_data.pore_type = *pore_type;
+            read_data.end_reason = *end_reason;
+            read_data.run_info = *run_info;
+            CHECK_ARROW_STATUS_OK((*writer)->add_complete_read(read_data, gsl::make_span(signal)));
+        }
+        CHECK_ARROW_STATUS_OK((*writer)->close());
+    }
+
+    THEN("Every signal batch body starts on an aligned offset")
+    {
+        pod5::FileLocation signal_table_location{"", 0, 0};
+        {
+            auto reader = pod5::open_file_reader(file, {});
+            REQUIRE_ARROW_STATUS_OK(reader);
+            signal_table_location = (*reader)->signal_table_location();
+        }
+
+        // Walk the IPC messages following the file magic:
+        auto input = arrow::io::ReadableFile::Open(file);
+        REQUIRE_ARROW_STATUS_OK(input);
+        REQUIRE_ARROW_STATUS_OK((*input)->Seek(signal_table_location.offset + 8));
+        std::size_t record_batch_count = 0;
+        while (true) {
+            auto const message_start = (*input)->Tell();
+            REQUIRE_ARROW_STATUS_OK(message_start);
+            auto message = arrow::ipc::ReadMessage(input->get());
+            REQUIRE_ARROW_STATUS_OK(message);
+            if (!*message) {
+                break;
+            }
+            if ((*message)->type() == arrow::ipc::MessageType::RECORD_BATCH) {
+                record_batch_count += 1;
+                if (alignment != 0) {
+                    auto const body_start = *message_start + 8 + (*message)->metadata()->size();
+                    CHECK(body_start % alignment == 0);
+                }
+            }
+        }
+        CHECK(record_batch_count == 4);
+    }
+
+    THEN("The signal reads back correctly, with and without direct io")
+    {
+        auto const use_direct_io = GENERATE(false, true);
+        CAPTURE(use_direct_io);
+
+        pod5::FileReaderOptions options;
+        options.set_use_direct_io(use_direct_io);
+        options.set_verify_batch_checksums(true);
+        auto reader = pod5::open_file_reader(file, options);
+        REQUIRE_ARROW_STATUS_OK(reader);
+
+        auto report = pod5::verify_file(**reader, 2);
+        REQUIRE_ARROW_STATUS_OK(report);
+        CHECK(report->ok());
+        CHECK(report->read_count == 10);
+        CHECK(report->sample_count == expected_samples);
+
+        auto batch = (*reader)->read_signal_record_batch(1);
+        REQUIRE_ARROW_STATUS_OK(batch);
+        std::vector<std::int16_t> samples(batch->samples_column()->Value(0));
+        REQUIRE_ARROW_STATUS_OK(batch->extract_signal_row(0, gsl::make_span(samples)));
+        CHECK(samples.front() == 3);
+        CHECK(samples.back() == std::int16_t(3 + samples.size() - 1));
+    }
+}
+
+SCENARIO("File access pattern hints")
+{
+    static constexpr char const * file = "./foo_access_pattern.pod5";
+    REQUIRE_ARROW_STATUS_OK(remove_file_if_exists(file));
+    (void)pod5::register_extension_types();
+    auto fin = gsl::finally([] { (void)pod5::unregister_extension_types(); });
+
+    auto const access_pattern = GENERATE(
+        pod5::FileAccessPattern::Normal,
+        pod5::FileAccessPattern::Sequential,
+        pod5::FileAccessPattern::Random);
+    auto const force_disable_file_mapping = GENERATE(false, true);
+    CAPTURE(access_pattern, force_disable_file_mapping);
+
+    auto uuid_gen = boost::uuids::random_generator_mt19937();
+    std::vector<std::vector<std::int16_t>> signals;
+    {
+        pod5::FileWriterOptions options;
+        options.set_signal_table_batch_size(2);
+        options.set_read_table_batch_size(3);
+
+        auto writer = pod5::create_file_writer(file, "test_software", options);
+        REQUIRE_ARROW_STATUS_OK(writer);
+
+        auto run_info = (*writer)->add_run_info(get_test_run_info_data("_run_info"));
+        auto end_reason = (*writer)->lookup_end_reason(pod5::ReadEndReason::unknown);
+        auto pore_type = (*writer)->add_pore_type("pore_type");
+
+        for (std::uint32_t i = 0; i < 10; ++i) {
+            signals.emplace_back(5'000 + 100 * i);
+            std::iota(signals.back().begin(), signals.back().end(), std::int16_t(i));
+
+            pod5::ReadData read_data{};
+            read_data.read_id = uuid_gen();
+            read_data.read_number = i;
+            read_data.pore_type = *pore_type;
+            read_data.end_reason = *end_reason;
+            read_data.run_info = *run_info;
+            CHECK_ARROW_STATUS_OK(
+                (*writer)->add_complete_read(read_data, gsl::make_span(signals.back())));
+        }
+        CHECK_ARROW_STATUS_OK((*writer)->close());
+    }
+
+    pod5::FileReaderOptions options;
+    options.set_access_pattern(access_pattern);
+    options.set_force_disable_file_mapping(force_disable_file_mapping);
+    auto reader = pod5::open_file_reader(file, options);
+    REQUIRE_ARROW_STATUS_OK(reader);
+
+    THEN("A scan releasing data behind it loads every read")
+    {
+        pod5::AsyncSignalLoader loader(
+            *reader, pod5::AsyncSignalLoader::SamplesMode::Samples, {}, {}, 2);
+        std::size_t read_index = 0;
+        while (true) {
+            auto next_batch = loader.release_next_batch();
+            REQUIRE_ARROW_STATUS_OK(next_batch);
+            if (!*next_batch) {
+                break;
+            }
+            for (auto const & samples : (*next_batch)->samples()) {
+                REQUIRE(read_index < signals.size());
+                CHECK(samples == signals[read_index]);
+                read_index += 1;
+            }
+        }
+        CHECK(read_index == signals.size());
+    }
+
+    THEN("Released signal batches can still be read")
+    {
+        (*reader)->release_signal_batches_before((*reader)->num_signal_record_batches());
+
+        auto batch = (*reader)->read_signal_record_batch(0);
+        REQUIRE_ARROW_STATUS_OK(batch);
+        std::vector<std::int16_t> samples(signals[0].size());
+        REQUIRE_ARROW_STATUS_OK(batch->extract_signal_row(0, gsl::make_span(samples)));
+        CHECK(samples == signals[0]);
+    }
+}
+
+SCENARIO("Opening files not on disk")
+{
+    static constexpr char const * file = "./foo_in_memory.pod5";
+    REQUIRE_ARROW_STATUS_OK(remove_file_if_exists(file));
+    (void)pod5::register_extension_types();
+    auto fin = gsl::finally([] { (void)pod5::unregister_extension_types(); });
+
+    auto uuid_gen = boost::uuids::random_generator_mt19937();
+    std::vector<std::vector<std::int16_t>> signals;
+    {
+        pod5::FileWriterOptions options;
+        options.set_signal_table_batch_size(2);
+
+        auto writer = pod5::create_file_writer(file, "test_software", options);
+        REQUIRE_ARROW_STATUS_OK(writer);
+
+        auto run_info = (*writer)->add_run_info(get_test_run_info_data("_run_info"));
+        auto end_reason = (*writer)->lookup_end_reason(pod5::ReadEndReason::unknown);
+        auto pore_type = (*writer)->add_pore_type("pore_type");
+
+        for (std::uint32_t i = 0; i < 5; ++i) {
+            signals.emplace_back(1'000 + 10 * i);
+            std::iota(signals.back().begin(), signals.back().end(), std::int16_t(i));
+
+            pod5::ReadData read_data{};
+            read_data.read_id = uuid_gen();
+            read_data.read_number = i;
+            read_data.pore_type = *pore_type;
+            read_data.end_reason = *end_reason;
+            read_data.run_info = *run_info;
+            CHECK_ARROW_STATUS_OK(
+                (*writer)->add_complete_read(read_data, gsl::make_span(signals.back())));
+        }
+        CHECK_ARROW_STATUS_OK((*writer)->close());
+    }
+
+    auto const check_reader = [&](std::shared_ptr<pod5::FileReader> const & reader) {
+        CHECK(reader->num_read_record_batches() == 1);
+        REQUIRE(reader->num_signal_record_batches() == 3);
+
+        std::size_t read_index = 0;
+        for (std::size_t i = 0; i < reader->num_signal_record_batches(); ++i) {
+            auto batch = reader->read_signal_record_batch(i);
+            REQUIRE_ARROW_STATUS_OK(batch);
+            for (std::size_t row = 0; row < batch->num_rows(); ++row, ++read_index) {
+                std::vector<std::int16_t> samples(signals[read_index].size());
+                REQUIRE_ARROW_STATUS_OK(batch->extract_signal_row(row, gsl::make_span(samples)));
+                CHECK(samples == signals[read_index]);
+            }
+        }
+        CHECK(read_index == signals.size());
+    };
+
+    GIVEN("The file read into memory")
+    {
+        auto input = arrow::io::ReadableFile::Open(file);
+        REQUIRE_ARROW_STATUS_OK(input);
+        auto buffer = (*input)->Read(*(*input)->GetSize());
+        REQUIRE_ARROW_STATUS_OK(buffer);
+        std::weak_ptr<arrow::Buffer> const weak_buffer = *buffer;
+
+        THEN("A reader opened on the buffer reads all signal")
+        {
+            auto reader = pod5::open_file_reader(*buffer);
+            REQUIRE_ARROW_STATUS_OK(reader);
+            buffer = std::shared_ptr<arrow::Buffer>();
+            check_reader(*reader);
+
+            // The reader keeps the buffer alive, until it is closed:
+            CHECK(!weak_buffer.expired());
+            reader = std::shared_ptr<pod5::FileReader>();
+            CHECK(weak_buffer.expired());
+        }
+
+        THEN("Direct io can't be used")
+        {
+            pod5::FileReaderOptions options;
+            options.set_use_direct_io(true);
+            CHECK(!pod5::open_file_reader(*buffer, options).ok());
+        }
+
+        THEN("A truncated buffer fails to open")
+        {
+            CHECK(!pod5::open_file_reader(arrow::SliceBuffer(*buffer, 0, 100)).ok());
+        }
+    }
+
+    GIVEN("A caller opened file")
+    {
+        auto input = arrow::io::ReadableFile::Open(file);
+        REQUIRE_ARROW_STATUS_OK(input);
+
+        auto reader =
+            pod5::open_file_reader(std::shared_ptr<arrow::io::RandomAccessFile>(*input));
+        REQUIRE_ARROW_STATUS_OK(reader);
+        check_reader(*reader);
+    }
+}
+
+SCENARIO("Streaming files to a non-seekable sink")
+{
+    static constexpr char const * file = "./foo_from_stream.pod5";
+    REQUIRE_ARROW_STATUS_OK(remove_file_if_exists(file));
+    (void)pod5::register_extension_types();
+    auto fin = gsl::finally([] { (void)pod5::unregister_extension_types(); });
+
+    auto const signal_batch_alignment = GENERATE(0u, 4096u);
+    CAPTURE(signal_batch_alignment);
+
+    auto uuid_gen = boost::uuids::random_generator_mt19937();
+    std::vector<boost::uuids::uuid> read_ids;
+    std::vector<std::vector<std::int16_t>> signals;
+
+    auto sink = arrow::io::BufferOutputStream::Create();
+    REQUIRE_ARROW_STATUS_OK(sink);
+    {
+        pod5::FileWriterOptions options;
+        options.set_signal_table_batch_size(2);
+        options.set_read_table_batch_size(3);
+        options.set_signal_summary_bin_size(100);
+        options.set_write_channel_index(true);
+        options.set_signal_batch_alignment(signal_batch_alignment);
+
+        auto writer = pod5::create_stream_file_writer(*sink, "test_software", options);
+        REQUIRE_ARROW_STATUS_OK(writer);
+        CHECK((*writer)->path().empty());
+
+        auto run_info = (*writer)->add_run_info(get_test_run_info_data("_run_info"));
+        auto end_reason = (*writer)->lookup_end_reason(pod5::ReadEndReason::unknown);
+        auto pore_type = (*writer)->add_pore_type("pore_type");
+
+        for (std::uint32_t i = 0; i < 10; ++i) {
+            read_ids.push_back(uuid_gen());
+            signals.emplace_back(2'000 + 100 * i);
+            std::iota(signals.back().begin(), signals.back().end(), std::int16_t(i));
+
+            pod5::ReadData read_data{};
+            read_data.read_id = read_ids.back();
+            read_data.read_number = i;
+            read_data.channel = 10 - i;
+            read_data.pore_type = *pore_type;
+            read_data.end_reason = *end_reason;
+            read_data.run_info = *run_info;
+            CHECK_ARROW_STATUS_OK(
+                (*writer)->add_complete_read(read_data, gsl::make_span(signals.back())));
+        }
+        CHECK_ARROW_STATUS_OK((*writer)->close());
+    }
+    auto stream_data = (*sink)->Finish();
+    REQUIRE_ARROW_STATUS_OK(stream_data);
+
+    WHEN("The stream is converted to a file")
+    {
+        auto stream = std::make_shared<arrow::io::BufferReader>(*stream_data);
+        REQUIRE_ARROW_STATUS_OK(pod5::convert_stream_to_file(stream, file));
+
+        auto reader = pod5::open_file_reader(file);
+        REQUIRE_ARROW_STATUS_OK(reader);
+
+        THEN("The file holds every read and its signal")
+        {
+            CHECK((*reader)->num_signal_record_batches() == 5);
+            CHECK((*reader)->num_read_record_batches() == 4);
+            CHECK((*reader)->has_signal_summary());
+            CHECK((*reader)->has_channel_index());
+
+            auto report = pod5::verify_file(**reader, 2);
+            REQUIRE_ARROW_STATUS_OK(report);
+            CHECK(report->ok());
+            CHECK(report->read_count == read_ids.size());
+            // The batch checksums are carried through the stream into the file footer:
+            CHECK(report->batch_checksums.checked_batch_count > 0);
+            CHECK(report->batch_checksums.unchecked_batch_count == 0);
+
+            std::size_t read_index = 0;
+            for (std::size_t i = 0; i < (*reader)->num_read_record_batches(); ++i) {
+                auto batch = (*reader)->read_read_record_batch(i);
+                REQUIRE_ARROW_STATUS_OK(batch);
+                auto read_id_column = batch->read_id_column();
+                for (std::int64_t row = 0; row < batch->num_rows(); ++row, ++read_index) {
+                    CHECK(read_id_column->Value(row) == read_ids[read_index]);
+                }
+            }
+            CHECK(read_index == read_ids.size());
+
+            std::size_t signal_row = 0;
+            for (std::size_t i = 0; i < (*reader)->num_signal_record_batches(); ++i) {
+                auto batch = (*reader)->read_signal_record_batch(i);
+                REQUIRE_ARROW_STATUS_OK(batch);
+                for (std::size_t row = 0; row < batch->num_rows(); ++row, ++signal_row) {
+                    std::vector<std::int16_t> samples(signals[signal_row].size());
+                    REQUIRE_ARROW_STATUS_OK(
+                        batch->extract_signal_row(row, gsl::make_span(samples)));
+                    CHECK(samples == signals[signal_row]);
+                }
+            }
+        }
+
+        THEN("Converting again doesn't replace the file")
+        {
+            auto stream = std::make_shared<arrow::io::BufferReader>(*stream_data);
+            CHECK(!pod5::convert_stream_to_file(stream, file).ok());
+        }
+    }
+
+    WHEN("A truncated stream is converted")
+    {
+        auto stream = std::make_shared<arrow::io::BufferReader>(
+            arrow::SliceBuffer(*stream_data, 0, (*stream_data)->size() - 1));
+        CHECK(!pod5::convert_stream_to_file(stream, file).ok());
+
+        THEN("No file is left behind")
+        {
+            CHECK(!std::ifstream(file).good());
+        }
+    }
+}
+
+namespace {
+
+/// File forwarding to another, counting the reads made from it.
+class CountingFile : public arrow::io::RandomAccessFile {
+public:
+    explicit CountingFile(std::shared_ptr<arrow::io::RandomAccessFile> const & file) : m_file(file)
+    {
+    }
+
+    std::size_t read_count() const { return m_read_count; }
+
+    arrow::Status Close() override { return m_file->Close(); }
+
+    bool closed() const override { return m_file->closed(); }
+
+    arrow::Result<std::int64_t> Tell() const override { return m_file->Tell(); }
+
+    arrow::Status Seek(std::int64_t position) override { return m_file->Seek(position); }
+
+    arrow::Result<std::int64_t> GetSize() override { return m_file->GetSize(); }
+
+    arrow::Result<std::int64_t> Read(std::int64_t nbytes, void * out) override
+    {
+        ++m_read_count;
+        return m_file->Read(nbytes, out);
+    }
+
+    arrow::Result<std::shared_ptr<arrow::Buffer>> Read(std::int64_t nbytes) override
+    {
+        ++m_read_count;
+        return m_file->Read(nbytes);
+    }
+
+    arrow::Result<std::int64_t> ReadAt(std::int64_t position, std::int64_t nbytes, void * out)
+        override
+    {
+        ++m_read_count;
+        return m_file->ReadAt(position, nbytes, out);
+    }
+
+    arrow::Result<std::shared_ptr<arrow::Buffer>> ReadAt(std::int64_t position, std::int64_t nbytes)
+        override
+    {
+        ++m_read_count;
+        return m_file->ReadAt(position, nbytes);
+    }
+
+private:
+    std::shared_ptr<arrow::io::RandomAccessFile> m_file;
+    std::atomic<std::size_t> m_read_count{0};
+};
+
+}  // namespace
+
+SCENARIO("Coalescing reads from high latency storage")
+{
+    static constexpr char const * file = "./foo_coalesced.pod5";
+    REQUIRE_ARROW_STATUS_OK(remove_file_if_exists(file));
+    (void)pod5::register_extension_types();
+    auto fin = gsl::finally([] { (void)pod5::unregister_extension_types(); });
+
+    // Random samples don't compress, so the signal table is larger than is fetched on open:
+    auto uuid_gen = boost::uuids::random_generator_mt19937();
+    std::mt19937 sample_gen;
+    std::uniform_int_distribution<std::int16_t> sample_dist(-2000, 2000);
+    std::vector<std::vector<std::int16_t>> signals;
+    {
+        pod5::FileWriterOptions options;
+        options.set_signal_table_batch_size(2);
+        options.set_read_table_batch_size(4);
+
+        auto writer = pod5::create_file_writer(file, "test_software", options);
+        REQUIRE_ARROW_STATUS_OK(writer);
+
+        auto run_info = (*writer)->add_run_info(get_test_run_info_data("_run_info"));
+        auto end_reason = (*writer)->lookup_end_reason(pod5::ReadEndReason::unknown);
+        auto pore_type = (*writer)->add_pore_type("pore_type");
+
+        for (std::uint32_t i = 0; i < 20; ++i) {
+            signals.emplace_back(100'000);
+            std::generate(signals.back().begin(), signals.back().end(), [&] {
+                return sample_dist(sample_gen);
+            });
+
+            pod5::ReadData read_data{};
+            read_data.read_id = uuid_gen();
+            read_data.read_number = i;
+            read_data.pore_type = *pore_type;
+            read_data.end_reason = *end_reason;
+            read_data.run_info = *run_info;
+            CHECK_ARROW_STATUS_OK(
+                (*writer)->add_complete_read(read_data, gsl::make_span(signals.back())));
+        }
+        CHECK_ARROW_STATUS_OK((*writer)->close());
+    }
+
+    auto const check_signal_batch = [&](pod5::FileReader const & reader, std::size_t batch_index) {
+        auto batch = reader.read_signal_record_batch(batch_index);
+        REQUIRE_ARROW_STATUS_OK(batch);
+        REQUIRE(batch->num_rows() == 2);
+        for (std::size_t row = 0; row < 2; ++row) {
+            auto const & expected = signals[batch_index * 2 + row];
+            std::vector<std::int16_t> samples(expected.size());
+            REQUIRE_ARROW_STATUS_OK(batch->extract_signal_row(row, gsl::make_span(samples)));
+            CHECK(samples == expected);
+        }
+    };
+
+    auto const open_counted = [&](bool coalesce_reads) {
+        auto input = arrow::io::ReadableFile::Open(file);
+        REQUIRE_ARROW_STATUS_OK(input);
+        auto counting_file = std::make_shared<CountingFile>(*input);
+
+        pod5::FileReaderOptions options;
+        options.set_coalesce_reads(coalesce_reads);
+        // Small enough that the signal table isn't fetched as a whole:
+        options.set_storage_metrics(1, 100);
+        auto reader = pod5::open_file_reader(
+            std::shared_ptr<arrow::io::RandomAccessFile>(counting_file), options);
+        REQUIRE_ARROW_STATUS_OK(reader);
+        REQUIRE((*reader)->num_signal_record_batches() == 10);
+        return std::make_pair(counting_file, *reader);
+    };
+
+    GIVEN("A reader opened with coalescing")
+    {
+        auto const coalesced = open_counted(true);
+        auto const & counting_file = coalesced.first;
+        auto const & reader = coalesced.second;
+
+        THEN("Opening makes fewer reads than without coalescing")
+        {
+            CHECK(counting_file->read_count() < open_counted(false).first->read_count());
+        }
+
+        THEN("A prefetched traversal is read in fewer reads than it has batches")
+        {
+            // Reads 6 to 13, held in signal batches 3 to 6:
+            pod5::ReadTraversalPlan plan;
+            plan.batch_counts = {0, 2, 4, 2, 0};
+            plan.batch_rows = {2, 3, 0, 1, 2, 3, 0, 1};
+
+            auto const reads_before = counting_file->read_count();
+            REQUIRE_ARROW_STATUS_OK(reader->prefetch_traversal(plan));
+            for (std::size_t batch_index = 3; batch_index <= 6; ++batch_index) {
+                check_signal_batch(*reader, batch_index);
+            }
+            CHECK(counting_file->read_count() - reads_before < 4);
+        }
+
+        THEN("Batches not prefetched are still read correctly")
+        {
+            REQUIRE_ARROW_STATUS_OK(reader->prefetch_signal_batches({0, 1}));
+            for (std::size_t batch_index = 0; batch_index < 10; ++batch_index) {
+                check_signal_batch(*reader, batch_index);
+            }
+        }
+
+        THEN("Prefetching a batch out of range fails")
+        {
+            CHECK(!reader->prefetch_signal_batches({10}).ok());
+        }
+    }
+
+    GIVEN("A reader opened without coalescing")
+    {
+        auto const reader = open_counted(false).second;
+
+        THEN("Prefetching has no effect")
+        {
+            REQUIRE_ARROW_STATUS_OK(reader->prefetch_signal_batches({4}));
+            check_signal_batch(*reader, 4);
+        }
+    }
+
+    GIVEN("A reader opened through a filesystem")
+    {
+        auto reader =
+            pod5::open_file_reader(std::make_shared<arrow::fs::LocalFileSystem>(), file);
+        REQUIRE_ARROW_STATUS_OK(reader);
+        REQUIRE((*reader)->num_signal_record_batches() == 10);
+        REQUIRE_ARROW_STATUS_OK((*reader)->prefetch_signal_batches({5, 6}));
+        for (std::size_t batch_index = 0; batch_index < 10; ++batch_index) {
+            check_signal_batch(**reader, batch_index);
+        }
+    }
+
+    GIVEN("A uri with an unknown scheme")
+    {
+        CHECK(!pod5::open_file_reader_from_uri("unknown-scheme://host/foo.pod5").ok());
+    }
+}
+
+SCENARIO("Signal dictionaries")
+{
+    static constexpr char const * file = "./foo_dictionary.pod5";
+    REQUIRE_ARROW_STATUS_OK(remove_file_if_exists(file));
+    (void)pod5::register_extension_types();
+    auto fin = gsl::finally([] { (void)pod5::unregister_extension_types(); });
+
+    auto uuid_gen = boost::uuids::random_generator_mt19937();
+    std::mt19937 sample_gen(4);
+    std::normal_distribution<float> noise(0, 6);
+    std::vector<std::vector<std::int16_t>> signals;
+    for (std::uint32_t i = 0; i < 200; ++i) {
+        signals.emplace_back(500 + i);
+        for (std::size_t j = 0; j < signals.back().size(); ++j) {
+            signals.back()[j] = std::int16_t(450 + (j / 50 % 4) * 30 + noise(sample_gen));
+        }
+    }
+
+    auto const write_file = [&](pod5::FileWriterOptions const & options) {
+        REQUIRE_ARROW_STATUS_OK(remove_file_if_exists(file));
+        auto writer = pod5::create_file_writer(file, "test_software", options);
+        REQUIRE_ARROW_STATUS_OK(writer);
+
+        auto run_info = (*writer)->add_run_info(get_test_run_info_data("_run_info"));
+        auto end_reason = (*writer)->lookup_end_reason(pod5::ReadEndReason::unknown);
+        auto pore_type = (*writer)->add_pore_type("pore_type");
+
+        for (std::uint32_t i = 0; i < signals.size(); ++i) {
+            pod5::ReadData read_data{};
+            read_data.read_id = uuid_gen();
+            read_data.read_number = i;
+            read_data.pore_type = *pore_type;
+            read_data.end_reason = *end_reason;
+            read_data.run_info = *run_info;
+            CHECK_ARROW_STATUS_OK(
+                (*writer)->add_complete_read(read_data, gsl::make_span(signals[i])));
+        }
+        CHECK_ARROW_STATUS_OK((*writer)->close());
+    };
+
+    auto const check_file = [&](bool expect_dictionary) {
+        auto reader = pod5::open_file_reader(file, {});
+        REQUIRE_ARROW_STATUS_OK(reader);
+        CHECK(((*reader)->signal_dictionary() != nullptr) == expect_dictionary);
+        if ((*reader)->num_signal_record_batches() > 0) {
+            auto batch = (*reader)->read_signal_record_batch(0);
+            REQUIRE_ARROW_STATUS_OK(batch);
+            // Dictionary enabled files mark their signal so older readers reject it:
+            CHECK(
+                batch->vbz_signal_column()->extension_type()->extension_name()
+                == (expect_dictionary ? "minknow.vbz_dictionary" : "minknow.vbz"));
+        }
+
+        std::size_t row_index = 0;
+        for (std::size_t i = 0; i < (*reader)->num_signal_record_batches(); ++i) {
+            auto batch = (*reader)->read_signal_record_batch(i);
+            REQUIRE_ARROW_STATUS_OK(batch);
+            for (std::size_t row = 0; row < batch->num_rows(); ++row, ++row_index) {
+                auto const & expected = signals[row_index];
+                std::vector<std::int16_t> samples(expected.size());
+                REQUIRE_ARROW_STATUS_OK(batch->extract_signal_row(row, gsl::make_span(samples)));
+                CHECK(samples == expected);
+            }
+        }
+        CHECK(row_index == signals.size());
+    };
+
+    GIVEN("A file written with a higher compression level")
+    {
+        pod5::FileWriterOptions options;
+        options.set_signal_compression_level(9);
+        write_file(options);
+
+        THEN("The signal reads back without a dictionary") { check_file(false); }
+    }
+
+    GIVEN("A file written with a dictionary trained on its first reads")
+    {
+        pod5::FileWriterOptions options;
+        options.set_signal_table_batch_size(16);
+        options.set_signal_dictionary_training_size(100 * 1024, 8 * 1024);
+        write_file(options);
+
+        THEN("The signal reads back with the stored dictionary") { check_file(true); }
+    }
+
+    GIVEN("A file written with more training signal than reads")
+    {
+        pod5::FileWriterOptions options;
+        options.set_signal_dictionary_training_size(1024 * 1024 * 1024, 8 * 1024);
+        write_file(options);
+
+        THEN("The dictionary is trained when the file is closed") { check_file(true); }
+    }
+
+    GIVEN("A file written with a dictionary passed in")
+    {
+        std::vector<gsl::span<std::int16_t const>> training_rows;
+        for (auto const & signal : signals) {
+            training_rows.push_back(gsl::make_span(signal));
+        }
+        auto dictionary =
+            pod5::train_vbz_dictionary(training_rows, 8 * 1024, arrow::system_memory_pool());
+        REQUIRE_ARROW_STATUS_OK(dictionary);
+
+        pod5::FileWriterOptions options;
+        options.set_signal_dictionary(*dictionary);
+        write_file(options);
+
+        THEN("The signal reads back with the stored dictionary")
+        {
+            check_file(true);
+            auto reader = pod5::open_file_reader(file, {});
+            REQUIRE_ARROW_STATUS_OK(reader);
+            CHECK((*reader)->signal_dictionary()->data()->Equals(**dictionary));
+        }
+    }
+}
+
+SCENARIO("Adaptive signal compression levels")
+{
+    static constexpr char const * file = "./foo_adaptive.pod5";
+    REQUIRE_ARROW_STATUS_OK(remove_file_if_exists(file));
+    (void)pod5::register_extension_types();
+    auto fin = gsl::finally([] { (void)pod5::unregister_extension_types(); });
+
+    auto uuid_gen = boost::uuids::random_generator_mt19937();
+    std::mt19937 sample_gen(5);
+    std::normal_distribution<float> noise(0, 6);
+    std::vector<std::vector<std::int16_t>> signals;
+    for (std::uint32_t i = 0; i < 100; ++i) {
+        signals.emplace_back(5'000);
+        for (auto & sample : signals.back()) {
+            sample = std::int16_t(450 + noise(sample_gen));
+        }
+    }
+
+    GIVEN("A file written with adaptive compression levels")
+    {
+        pod5::FileWriterOptions options;
+        options.set_signal_table_batch_size(10);
+        options.set_signal_compression_level(3);
+        options.set_adaptive_signal_compression(1, 5);
+
+        pod5::SignalCompressionMetrics metrics;
+        {
+            auto writer = pod5::create_file_writer(file, "test_software", options);
+            REQUIRE_ARROW_STATUS_OK(writer);
+
+            auto run_info = (*writer)->add_run_info(get_test_run_info_data("_run_info"));
+            auto end_reason = (*writer)->lookup_end_reason(pod5::ReadEndReason::unknown);
+            auto pore_type = (*writer)->add_pore_type("pore_type");
+
+            for (std::uint32_t i = 0; i < signals.size(); ++i) {
+                pod5::ReadData read_data{};
+                read_data.read_id = uuid_gen();
+                read_data.read_number = i;
+                read_data.pore_type = *pore_type;
+                read_data.end_reason = *end_reason;
+                read_data.run_info = *run_info;
+                CHECK_ARROW_STATUS_OK(
+                    (*writer)->add_complete_read(read_data, gsl::make_span(signals[i])));
+            }
+            CHECK((*writer)->signal_compression_metrics().rows_per_level.size() > 0);
+            CHECK_ARROW_STATUS_OK((*writer)->close());
+            metrics = (*writer)->signal_compression_metrics();
+        }
+
+        THEN("The metrics describe the signal compressed")
+        {
+            CHECK(metrics.sample_bytes == signals.size() * 5'000 * sizeof(std::int16_t));
+            CHECK(metrics.compressed_bytes > 0);
+            CHECK(metrics.compression_ratio() > 1.0);
+
+            std::uint64_t row_count = 0;
+            for (auto const & level_rows : metrics.rows_per_level) {
+                CHECK(level_rows.first >= 1);
+                CHECK(level_rows.first <= 5);
+                row_count += level_rows.second;
+            }
+            CHECK(row_count == signals.size());
+            // The first batch is written at the level set:
+            CHECK(metrics.rows_per_level.count(3) == 1);
+        }
+
+        THEN("The signal reads back")
+        {
+            auto reader = pod5::open_file_reader(file, {});
+            REQUIRE_ARROW_STATUS_OK(reader);
+            std::size_t row_index = 0;
+            for (std::size_t i = 0; i < (*reader)->num_signal_record_batches(); ++i) {
+                auto batch = (*reader)->read_signal_record_batch(i);
+                REQUIRE_ARROW_STATUS_OK(batch);
+                for (std::size_t row = 0; row < batch->num_rows(); ++row, ++row_index) {
+                    std::vector<std::int16_t> samples(signals[row_index].size());
+                    REQUIRE_ARROW_STATUS_OK(
+                        batch->extract_signal_row(row, gsl::make_span(samples)));
+                    CHECK(samples == signals[row_index]);
+                }
+            }
+            CHECK(row_index == signals.size());
+        }
+    }
+
+    GIVEN("Adaptive compression levels with a signal dictionary")
+    {
+        pod5::FileWriterOptions options;
+        options.set_adaptive_signal_compression(1, 5);
+        options.set_signal_dictionary_training_size(1024 * 1024);
+
+        THEN("The writer can't be created")
+        {
+            CHECK(!pod5::create_file_writer(file, "test_software", options).ok());
+        }
+    }
+}
+
+SCENARIO("Decoded signal caching")
+{
+    static constexpr char const * file = "./foo_decoded_cache.pod5";
+    REQUIRE_ARROW_STATUS_OK(remove_file_if_exists(file));
+    (void)pod5::register_extension_types();
+    auto fin = gsl::finally([] { (void)pod5::unregister_extension_types(); });
+
+    auto uuid_gen = boost::uuids::random_generator_mt19937();
+    std::mt19937 sample_gen(7);
+    std::uniform_int_distribution<std::int16_t> sample_dist(0, 1000);
+    std::vector<std::vector<std::int16_t>> signals;
+    for (std::uint32_t i = 0; i < 20; ++i) {
+        signals.emplace_back(1'000 + i);
+        std::generate(signals.back().begin(), signals.back().end(), [&] {
+            return sample_dist(sample_gen);
+        });
+    }
+
+    {
+        auto writer = pod5::create_file_writer(file, "test_software", {});
+        REQUIRE_ARROW_STATUS_OK(writer);
+        auto run_info = (*writer)->add_run_info(get_test_run_info_data("_run_info"));
+        auto end_reason = (*writer)->lookup_end_reason(pod5::ReadEndReason::unknown);
+        auto pore_type = (*writer)->add_pore_type("pore_type");
+        for (std::uint32_t i = 0; i < signals.size(); ++i) {
+            pod5::ReadData read_data{};
+            read_data.read_id = uuid_gen();
+            read_data.read_number = i;
+            read_data.pore_type = *pore_type;
+            read_data.end_reason = *end_reason;
+            read_data.run_info = *run_info;
+            REQUIRE_ARROW_STATUS_OK(
+                (*writer)->add_complete_read(read_data, gsl::make_span(signals[i])));
+        }
+        REQUIRE_ARROW_STATUS_OK((*writer)->close());
+    }
+
+    // Each read is short enough to be stored in a single signal row:
+    auto const extract = [&](pod5::FileReader const & reader, std::uint64_t read) {
+        std::vector<std::int16_t> samples(signals[read].size());
+        auto const status = reader.extract_samples(
+            gsl::make_span(&read, 1), gsl::make_span(samples));
+        CHECK_ARROW_STATUS_OK(status);
+        return samples;
+    };
+    auto const extract_rows = [&](pod5::FileReader const & reader,
+                                  std::vector<std::uint64_t> const & rows) {
+        std::vector<std::int16_t> expected;
+        for (auto const row : rows) {
+            expected.insert(expected.end(), signals[row].begin(), signals[row].end());
+        }
+        std::vector<std::int16_t> samples(expected.size());
+        CHECK_ARROW_STATUS_OK(
+            reader.extract_samples(gsl::make_span(rows), gsl::make_span(samples)));
+        CHECK(samples == expected);
+    };
+
+    GIVEN("Two readers sharing a decoded signal cache")
+    {
+        auto cache = std::make_shared<pod5::DecodedSignalCache>(1024 * 1024);
+        pod5::FileReaderOptions options;
+        options.set_decoded_signal_cache(cache);
+        auto reader_a = pod5::open_file_reader(file, options);
+        auto reader_b = pod5::open_file_reader(file, options);
+        REQUIRE_ARROW_STATUS_OK(reader_a);
+        REQUIRE_ARROW_STATUS_OK(reader_b);
+        CHECK((*reader_a)->decoded_signal_cache() == cache);
+
+        WHEN("Reads are extracted repeatedly")
+        {
+            for (int pass = 0; pass < 3; ++pass) {
+                for (std::uint64_t read = 0; read < signals.size(); ++read) {
+                    CHECK(extract(**reader_a, read) == signals[read]);
+                }
+            }
+            CHECK(extract(**reader_b, 4) == signals[4]);
+
+            THEN("Repeated reads hit the cache, and each reader's reads are kept apart")
+            {
+                auto const metrics = cache->metrics();
+                CHECK(metrics.misses == signals.size() + 1);
+                CHECK(metrics.hits == 2 * signals.size());
+                CHECK(metrics.insertions == signals.size() + 1);
+                CHECK(metrics.entry_count == signals.size() + 1);
+            }
+
+            THEN("A closed reader's reads are dropped")
+            {
+                reader_b->reset();
+                CHECK(cache->metrics().entry_count == signals.size());
+            }
+        }
+
+        WHEN("Row lists sharing a first row but not later rows are extracted")
+        {
+            for (int pass = 0; pass < 2; ++pass) {
+                extract_rows(**reader_a, {5, 6});
+                extract_rows(**reader_a, {5, 7});
+            }
+
+            THEN("Each is cached separately")
+            {
+                auto const metrics = cache->metrics();
+                CHECK(metrics.misses == 2);
+                CHECK(metrics.hits == 2);
+                CHECK(metrics.entry_count == 2);
+            }
+        }
+    }
+
+    GIVEN("A reader without a cache")
+    {
+        auto reader = pod5::open_file_reader(file, {});
+        REQUIRE_ARROW_STATUS_OK(reader);
+        CHECK(!(*reader)->decoded_signal_cache());
+        CHECK(!(*reader)->shared_signal_cache());
+        CHECK(extract(**reader, 3) == signals[3]);
+    }
+
+#ifdef __linux__
+    GIVEN("Two readers using the same shared signal cache, each with a private cache")
+    {
+        std::string const cache_name = "pod5_test_file_reader_" + std::to_string(getpid());
+        (void)pod5::SharedSignalCache::remove(cache_name);
+        auto shared_cache_a = pod5::SharedSignalCache::open(cache_name, 1024 * 1024);
+        auto shared_cache_b = pod5::SharedSignalCache::open(cache_name, 1024 * 1024);
+        REQUIRE_ARROW_STATUS_OK(shared_cache_a);
+        REQUIRE_ARROW_STATUS_OK(shared_cache_b);
+        auto remove_cache =
+            gsl::finally([&] { (void)pod5::SharedSignalCache::remove(cache_name); });
+
+        pod5::FileReaderOptions options_a;
+        options_a.set_shared_signal_cache(*shared_cache_a);
+        auto reader_a = pod5::open_file_reader(file, options_a);
+        auto private_cache = std::make_shared<pod5::DecodedSignalCache>(1024 * 1024);
+        pod5::FileReaderOptions options_b;
+        options_b.set_shared_signal_cache(*shared_cache_b);
+        options_b.set_decoded_signal_cache(private_cache);
+        auto reader_b = pod5::open_file_reader(file, options_b);
+        REQUIRE_ARROW_STATUS_OK(reader_a);
+        REQUIRE_ARROW_STATUS_OK(reader_b);
+        CHECK((*reader_a)->shared_signal_cache() == *shared_cache_a);
+
+        WHEN("Reads decoded by one reader are extracted by the other")
+        {
+            for (std::uint64_t read = 0; read < signals.size(); ++read) {
+                CHECK(extract(**reader_a, read) == signals[read]);
+            }
+            for (int pass = 0; pass < 2; ++pass) {
+                for (std::uint64_t read = 0; read < signals.size(); ++read) {
+                    CHECK(extract(**reader_b, read) == signals[read]);
+                }
+            }
+
+            THEN("They are found in the shared cache, then the private one")
+            {
+                auto const shared_metrics = (*shared_cache_b)->metrics();
+                CHECK(shared_metrics.misses == signals.size());
+                CHECK(shared_metrics.hits == signals.size());
+                CHECK(shared_metrics.insertions == signals.size());
+
+                auto const private_metrics = private_cache->metrics();
+                CHECK(private_metrics.misses == signals.size());
+                CHECK(private_metrics.hits == signals.size());
+            }
+        }
+
+        WHEN("Row lists sharing a first row but not later rows are extracted by each reader")
+        {
+            extract_rows(**reader_a, {5, 6});
+            extract_rows(**reader_a, {5, 7});
+            extract_rows(**reader_b, {5, 7});
+            extract_rows(**reader_b, {5, 6});
+
+            THEN("Each is found in the shared cache separately")
+            {
+                auto const metrics = (*shared_cache_a)->metrics();
+                CHECK(metrics.misses == 2);
+                CHECK(metrics.hits == 2);
+                CHECK(metrics.insertions == 2);
+            }
+        }
+    }
+#endif
+}
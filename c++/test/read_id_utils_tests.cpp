@@ -0,0 +1,152 @@
+#include "pod5_format/read_id_utils.h"
+
+#include <boost/uuid/random_generator.hpp>
+#include <boost/uuid/string_generator.hpp>
+#include <boost/uuid/uuid_io.hpp>
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+SCENARIO("Read id parsing and formatting")
+{
+    using namespace pod5;
+
+    std::vector<boost::uuids::uuid> read_ids(100);
+    std::mt19937 gen(5);
+    boost::uuids::basic_random_generator<std::mt19937> uuid_gen(gen);
+    std::generate(read_ids.begin(), read_ids.end(), std::ref(uuid_gen));
+
+    GIVEN("Formatted read ids")
+    {
+        THEN("Each matches boost's formatting")
+        {
+            for (auto const & read_id : read_ids) {
+                std::string formatted(READ_ID_STRING_LENGTH, ' ');
+                format_read_id(read_id, &formatted[0]);
+                CHECK(formatted == boost::uuids::to_string(read_id));
+            }
+        }
+
+        THEN("Bulk formatting null terminates each entry within the stride")
+        {
+            std::size_t const stride = 40;
+            std::vector<char> output(read_ids.size() * stride, 'x');
+            REQUIRE(format_read_ids(gsl::make_span(read_ids), gsl::make_span(output), stride).ok());
+            for (std::size_t i = 0; i < read_ids.size(); ++i) {
+                auto const entry = output.data() + i * stride;
+                CHECK(std::string(entry) == boost::uuids::to_string(read_ids[i]));
+                CHECK(entry[READ_ID_STRING_LENGTH + 1] == 'x');
+            }
+        }
+
+        THEN("Bulk formatting rejects short buffers and strides")
+        {
+            std::vector<char> output(read_ids.size() * READ_ID_STRING_LENGTH);
+            CHECK_FALSE(format_read_ids(gsl::make_span(read_ids), gsl::make_span(output)).ok());
+            CHECK_FALSE(format_read_ids(gsl::make_span(read_ids), gsl::make_span(output), 35).ok());
+            CHECK(format_read_ids(
+                      gsl::make_span(read_ids), gsl::make_span(output), READ_ID_STRING_LENGTH)
+                      .ok());
+        }
+    }
+
+    GIVEN("Read id strings")
+    {
+        std::string const id = "0000173c-bf67-44e7-9a9c-1ad0bc728e74";
+        auto const expected = boost::uuids::string_generator()(id);
+        auto const parse = [](std::string const & input) {
+            boost::uuids::uuid read_id{};
+            bool const parsed = parse_read_id(gsl::make_span(input.data(), input.size()), &read_id);
+            return std::make_pair(parsed, read_id);
+        };
+
+        THEN("Lower and upper case forms parse")
+        {
+            for (auto const & input : {id, std::string("0000173C-BF67-44E7-9A9C-1AD0BC728E74")}) {
+                INFO(input);
+                auto const result = parse(input);
+                CHECK(result.first);
+                CHECK(result.second == expected);
+            }
+        }
+
+        THEN("Braced and dashless forms are rejected")
+        {
+            CHECK_FALSE(parse("{" + id + "}").first);
+            CHECK_FALSE(parse("0000173cbf6744e79a9c1ad0bc728e74").first);
+            CHECK_FALSE(parse("{0000173cbf6744e79a9c1ad0bc728e74}").first);
+        }
+
+        THEN("Bad characters, misplaced dashes and wrong lengths are rejected")
+        {
+            for (std::size_t i = 0; i < id.size(); ++i) {
+                for (char c : {'g', 'G', '-', '/', ':', '@', '`', ' ', '\0'}) {
+                    auto changed = id;
+                    if (changed[i] == c) {
+                        continue;
+                    }
+                    changed[i] = c;
+                    INFO(changed);
+                    CHECK_FALSE(parse(changed).first);
+                }
+            }
+            CHECK_FALSE(parse(id.substr(0, 35)).first);
+            CHECK_FALSE(parse(id + "0").first);
+            CHECK_FALSE(parse("").first);
+        }
+
+        THEN("Every formatted read id parses back")
+        {
+            for (auto const & read_id : read_ids) {
+                auto const result = parse(boost::uuids::to_string(read_id));
+                CHECK(result.first);
+                CHECK(result.second == read_id);
+            }
+        }
+    }
+
+    GIVEN("A fixed width, null padded array of read id strings")
+    {
+        std::size_t const stride = 40;
+        std::vector<char> input(read_ids.size() * stride, '\0');
+        for (std::size_t i = 0; i < read_ids.size(); ++i) {
+            auto const str = boost::uuids::to_string(read_ids[i]);
+            std::copy(str.begin(), str.end(), input.begin() + i * stride);
+        }
+        // Some entries invalid, one filling the whole stride:
+        input[3 * stride + 5] = 'z';
+        std::fill_n(input.begin() + 7 * stride, stride, '\0');
+        std::fill_n(input.begin() + 9 * stride + READ_ID_STRING_LENGTH, 4, 'a');
+
+        WHEN("Parsing the array")
+        {
+            std::vector<boost::uuids::uuid> parsed(read_ids.size(), uuid_gen());
+            std::vector<std::uint8_t> valid(read_ids.size());
+            auto const count = parse_read_ids(
+                gsl::make_span(input), stride, gsl::make_span(parsed), gsl::make_span(valid));
+
+            THEN("Valid entries parse and invalid ones are zeroed")
+            {
+                REQUIRE(count.ok());
+                CHECK(*count == read_ids.size() - 3);
+                for (std::size_t i = 0; i < read_ids.size(); ++i) {
+                    INFO(i);
+                    bool const expect_valid = i != 3 && i != 7 && i != 9;
+                    CHECK(valid[i] == expect_valid);
+                    CHECK(parsed[i] == (expect_valid ? read_ids[i] : boost::uuids::uuid{}));
+                }
+            }
+        }
+
+        THEN("Short buffers are rejected")
+        {
+            std::vector<boost::uuids::uuid> parsed(read_ids.size() + 1);
+            CHECK_FALSE(parse_read_ids(gsl::make_span(input), stride, gsl::make_span(parsed)).ok());
+            CHECK_FALSE(parse_read_ids(gsl::make_span(input), 0, gsl::make_span(parsed)).ok());
+        }
+    }
+}
@@ -1,3 +1,4 @@
+#include "pod5_format/read_batch_view.h"
 #include "pod5_format/read_table_reader.h"
 #include "pod5_format/read_table_writer.h"
 #include "pod5_format/schema_metadata.h"
@@ -219,6 +220,48 @@ SCENARIO("Read table Tests")
                 run_info_data = record_batch->get_run_info(1);
                 REQUIRE_ARROW_STATUS_OK(run_info_data);
                 CHECK(*run_info_data == "acq_id_2");
+
+                CHECK(!record_batch->get_pore_type(-1).ok());
+                CHECK(!record_batch->get_end_reason(-1).ok());
+                CHECK(!record_batch->get_run_info(2).ok());
+
+                auto run_info_column = record_batch->run_info_column();
+                REQUIRE_ARROW_STATUS_OK(run_info_column);
+                REQUIRE(run_info_column->indices.size() == std::size_t(read_count));
+                REQUIRE(run_info_column->values.size() == 2);
+                CHECK(run_info_column->values[0] == "acq_id_1");
+                CHECK(run_info_column->values[1] == "acq_id_2");
+                for (std::size_t j = 0; j < run_info_column->indices.size(); ++j) {
+                    CHECK(run_info_column->indices[j] == run_info_indices->Value(j));
+                }
+
+                auto end_reason_column = record_batch->end_reason_column();
+                REQUIRE_ARROW_STATUS_OK(end_reason_column);
+                CHECK(end_reason_column->values[1] == "mux_change");
+
+                auto pore_type_column = record_batch->pore_type_column();
+                REQUIRE_ARROW_STATUS_OK(pore_type_column);
+                CHECK(pore_type_column->values[0] == "Well Type");
+
+                auto view = pod5::LatestReadBatchView::make(*record_batch);
+                REQUIRE_ARROW_STATUS_OK(view);
+                REQUIRE(view->num_rows() == std::size_t(read_count));
+                for (auto j = 0; j < read_count; ++j) {
+                    CHECK(view->read_id(j) == columns->read_id->Value(j));
+                    CHECK(view->read_number(j) == columns->read_number->Value(j));
+                    CHECK(view->start_sample(j) == columns->start_sample->Value(j));
+                    CHECK(view->num_samples(j) == columns->num_samples->Value(j));
+                    CHECK(view->channel(j) == columns->channel->Value(j));
+                    CHECK(view->well(j) == columns->well->Value(j));
+                    CHECK(view->pore_type(j) == pore_indices->Value(j));
+                    CHECK(view->end_reason(j) == end_reason_indices->Value(j));
+                    CHECK(view->run_info(j) == run_info_indices->Value(j));
+                    CHECK(view->end_reason_forced(j) == columns->end_reason_forced->Value(j));
+                    CHECK(view->calibration_scale(j) == columns->calibration_scale->Value(j));
+                    CHECK(
+                        view->signal_row_count(j)
+                        == std::size_t(columns->signal->value_length(j)));
+                }
             }
         }
     }
@@ -113,6 +113,25 @@ SCENARIO("Run Info table Tests")
             auto found_run_info_1 = reader->find_run_info(run_info_data_1.acquisition_id);
             CHECK_ARROW_STATUS_OK(found_run_info_1);
             CHECK(**found_run_info_1 == run_info_data_1);
+
+            CHECK(*reader->find_run_info_index(run_info_data_0.acquisition_id) == 0);
+            CHECK(*reader->find_run_info_index(run_info_data_1.acquisition_id) == 1);
+            CHECK(!reader->find_run_info_index("missing_acquisition_id").ok());
+            CHECK(!reader->find_run_info("missing_acquisition_id").ok());
+            CHECK(*reader->get_run_info_count() == 2);
+            CHECK(**reader->get_run_info(1) == run_info_data_1);
+            CHECK(!reader->get_run_info(2).ok());
+
+            auto context_tags = reader->get_context_tags(1);
+            REQUIRE_ARROW_STATUS_OK(context_tags);
+            CHECK(context_tags->size() == run_info_data_1.context_tags.size());
+            CHECK(context_tags->to_map() == run_info_data_1.context_tags);
+            CHECK(*context_tags->find("other_2") == "tagz_2");
+            CHECK(!context_tags->find("other"));
+
+            auto tracking_id = reader->get_tracking_id(0);
+            REQUIRE_ARROW_STATUS_OK(tracking_id);
+            CHECK(tracking_id->to_map() == run_info_data_0.tracking_id);
         }
     }
 }
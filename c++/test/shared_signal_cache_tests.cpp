@@ -0,0 +1,174 @@
+#include "pod5_format/shared_signal_cache.h"
+
+#include "test_utils.h"
+
+#include <boost/uuid/random_generator.hpp>
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+std::string unique_cache_name(char const * prefix)
+{
+    return std::string("pod5_test_") + prefix + "_" + std::to_string(getpid());
+}
+
+std::vector<std::uint64_t> rows(std::uint64_t first, std::size_t count)
+{
+    std::vector<std::uint64_t> result(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        result[i] = first + i;
+    }
+    return result;
+}
+}  // namespace
+
+SCENARIO("Shared signal cache")
+{
+    auto const name = unique_cache_name("shared_signal_cache");
+    (void)pod5::SharedSignalCache::remove(name);
+
+    // Room for 64 reads of 1000 samples:
+    auto const capacity = 64 * 1000 * sizeof(std::int16_t);
+    auto cache_result = pod5::SharedSignalCache::open(name, capacity);
+    REQUIRE_ARROW_STATUS_OK(cache_result);
+    auto cache = *cache_result;
+    CHECK(cache->name() == name);
+    CHECK(cache->capacity_bytes() == capacity);
+
+    boost::uuids::random_generator uuid_gen;
+    auto const file = uuid_gen();
+    auto const other_file = uuid_gen();
+
+    std::vector<std::int16_t> read(1000);
+    for (std::size_t i = 0; i < read.size(); ++i) {
+        read[i] = std::int16_t(i);
+    }
+    std::vector<std::int16_t> output(2000);
+
+    GIVEN("A read added to the cache")
+    {
+        CHECK(cache->find(file, rows(10, 2), gsl::make_span(output)) == 0);
+        CHECK(cache->insert(file, rows(10, 2), gsl::make_span(read)));
+
+        THEN("Lookups of the read copy its samples")
+        {
+            CHECK(cache->find(file, rows(10, 2), gsl::make_span(output)) == read.size());
+            CHECK(std::equal(read.begin(), read.end(), output.begin()));
+
+            auto const metrics = cache->metrics();
+            CHECK(metrics.hits == 1);
+            CHECK(metrics.misses == 1);
+            CHECK(metrics.insertions == 1);
+            CHECK(
+                metrics.bytes_written
+                == 2 * sizeof(std::uint64_t) + read.size() * sizeof(std::int16_t));
+        }
+
+        THEN("Lookups of other files and rows miss")
+        {
+            CHECK(cache->find(other_file, rows(10, 2), gsl::make_span(output)) == 0);
+            CHECK(cache->find(file, rows(11, 2), gsl::make_span(output)) == 0);
+            CHECK(cache->find(file, rows(10, 1), gsl::make_span(output)) == 0);
+        }
+
+        THEN("Reads sharing the first row and row count but not later rows are told apart")
+        {
+            std::vector<std::uint64_t> const split_rows{10, 20};
+            CHECK(cache->find(file, split_rows, gsl::make_span(output)) == 0);
+            std::vector<std::int16_t> split_read(500, 7);
+            CHECK(cache->insert(file, split_rows, gsl::make_span(split_read)));
+
+            CHECK(cache->find(file, split_rows, gsl::make_span(output)) == split_read.size());
+            CHECK(std::equal(split_read.begin(), split_read.end(), output.begin()));
+            CHECK(cache->find(file, rows(10, 2), gsl::make_span(output)) == read.size());
+            CHECK(std::equal(read.begin(), read.end(), output.begin()));
+        }
+
+        THEN("Lookups into too small an output miss")
+        {
+            CHECK(cache->find(file, rows(10, 2), gsl::make_span(output).first(999)) == 0);
+        }
+
+        THEN("Another handle to the cache finds the read, using the original capacity")
+        {
+            auto other_cache = pod5::SharedSignalCache::open(name, capacity * 2);
+            REQUIRE_ARROW_STATUS_OK(other_cache);
+            CHECK((*other_cache)->capacity_bytes() == capacity);
+            CHECK(
+                (*other_cache)->find(file, rows(10, 2), gsl::make_span(output)) == read.size());
+            CHECK(std::equal(read.begin(), read.end(), output.begin()));
+        }
+
+        THEN("Another process finds the read, and adds its own")
+        {
+            auto const child = fork();
+            REQUIRE(child >= 0);
+            if (child == 0) {
+                auto child_cache = pod5::SharedSignalCache::open(name, capacity);
+                std::vector<std::int16_t> child_output(read.size());
+                bool const ok =
+                    child_cache.ok()
+                    && (*child_cache)->find(file, rows(10, 2), gsl::make_span(child_output))
+                           == read.size()
+                    && child_output == read
+                    && (*child_cache)->insert(other_file, rows(0, 1), gsl::make_span(read));
+                _exit(ok ? 0 : 1);
+            }
+
+            int status = 0;
+            REQUIRE(waitpid(child, &status, 0) == child);
+            CHECK(WIFEXITED(status));
+            CHECK(WEXITSTATUS(status) == 0);
+            CHECK(cache->find(other_file, rows(0, 1), gsl::make_span(output)) == read.size());
+            CHECK(cache->metrics().insertions == 2);
+        }
+    }
+
+    GIVEN("Reads larger than a quarter of the cache")
+    {
+        std::vector<std::int16_t> large_read(capacity / sizeof(std::int16_t) / 2);
+
+        THEN("They are skipped")
+        {
+            CHECK(!cache->insert(file, rows(0, 1), gsl::make_span(large_read)));
+            CHECK(cache->metrics().skipped_insertions == 1);
+            CHECK(cache->metrics().bytes_written == 0);
+        }
+    }
+
+    GIVEN("More reads added than the cache holds")
+    {
+        for (std::uint64_t row = 0; row < 200; ++row) {
+            read[0] = std::int16_t(row);
+            REQUIRE(cache->insert(file, rows(row, 1), gsl::make_span(read)));
+            if (row % 8 == 0) {
+                // Keep the first read in use:
+                REQUIRE(cache->find(file, rows(0, 1), gsl::make_span(output)) == read.size());
+                CHECK(output[0] == 0);
+            }
+        }
+
+        THEN("The oldest reads are overwritten, but reads in use and the newest are kept")
+        {
+            CHECK(cache->find(file, rows(1, 1), gsl::make_span(output)) == 0);
+            CHECK(cache->find(file, rows(0, 1), gsl::make_span(output)) == read.size());
+            CHECK(output[0] == 0);
+            CHECK(cache->find(file, rows(199, 1), gsl::make_span(output)) == read.size());
+            CHECK(output[0] == 199);
+            CHECK(cache->metrics().bytes_written > capacity);
+        }
+    }
+
+    cache.reset();
+    CHECK_ARROW_STATUS_OK(pod5::SharedSignalCache::remove(name));
+    CHECK(!pod5::SharedSignalCache::remove(name).ok());
+}
+#endif
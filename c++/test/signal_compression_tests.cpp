@@ -1,4 +1,6 @@
+#include "pod5_format/adaptive_compression_level.h"
 #include "pod5_format/signal_compression.h"
+#include "pod5_format/signal_kernels.h"
 
 #include "test_utils.h"
 #include "utils.h"
@@ -9,6 +11,7 @@
 #include <gsl/gsl-lite.hpp>
 
 #include <numeric>
+#include <random>
 
 SCENARIO("Signal compression Tests")
 {
@@ -27,4 +30,339 @@ SCENARIO("Signal compression Tests")
                                  .as_span<std::int16_t const>();
 
     CHECK(gsl::make_span(signal) == decompressed_span);
+
+    // The most samples the compressed signal can hold bounds the real count:
+    auto max_samples = pod5::vbz_signal_max_sample_count(compressed_span);
+    REQUIRE_ARROW_STATUS_OK(max_samples);
+    CHECK(*max_samples >= signal.size());
+    CHECK(*max_samples < 4 * signal.size());
+    CHECK_FALSE(pod5::vbz_signal_max_sample_count(compressed_span.subspan(0, 2)).ok());
+}
+
+SCENARIO("Vbz signal compression levels and dictionaries")
+{
+    auto pool = arrow::system_memory_pool();
+
+    // Many short rows with shared structure, the case dictionaries are meant for:
+    std::mt19937 gen(3);
+    std::normal_distribution<float> noise(0, 6);
+    std::vector<std::vector<std::int16_t>> rows(500);
+    for (auto & row : rows) {
+        for (std::size_t i = 0; i < 400; ++i) {
+            row.push_back(std::int16_t(450 + (i / 50 % 4) * 30 + noise(gen)));
+        }
+    }
+
+    auto const decompress = [&](std::shared_ptr<arrow::Buffer> const & compressed,
+                                std::size_t sample_count,
+                                pod5::VbzDictionary const * dictionary) {
+        return pod5::decompress_signal(
+            gsl::make_span(compressed->data(), compressed->size()),
+            sample_count,
+            pool,
+            dictionary);
+    };
+    auto const as_samples = [](std::shared_ptr<arrow::Buffer> const & buffer) {
+        return gsl::make_span(buffer->data(), buffer->size()).as_span<std::int16_t const>();
+    };
+
+    GIVEN("A higher compression level")
+    {
+        auto const level = GENERATE(-5, 1, 9, 19);
+        CAPTURE(level);
+
+        auto compressed = pod5::compress_signal(gsl::make_span(rows[0]), pool, level, nullptr);
+        REQUIRE_ARROW_STATUS_OK(compressed);
+
+        THEN("The signal decompresses without a dictionary")
+        {
+            auto decompressed = pod5::decompress_signal(
+                gsl::make_span((*compressed)->data(), (*compressed)->size()), rows[0].size(), pool);
+            REQUIRE_ARROW_STATUS_OK(decompressed);
+            CHECK(gsl::make_span(rows[0]) == as_samples(*decompressed));
+        }
+    }
+
+    GIVEN("A dictionary trained on the rows")
+    {
+        std::vector<gsl::span<std::int16_t const>> training_rows;
+        for (auto const & row : rows) {
+            training_rows.push_back(gsl::make_span(row));
+        }
+        auto dictionary_data = pod5::train_vbz_dictionary(training_rows, 16 * 1024, pool);
+        REQUIRE_ARROW_STATUS_OK(dictionary_data);
+        auto dictionary = pod5::VbzDictionary::make(*dictionary_data);
+        REQUIRE_ARROW_STATUS_OK(dictionary);
+        CHECK((*dictionary)->id() != 0);
+
+        std::size_t plain_size = 0;
+        std::size_t dictionary_size = 0;
+        std::vector<std::shared_ptr<arrow::Buffer>> compressed;
+        for (auto const & row : rows) {
+            auto plain = pod5::compress_signal(gsl::make_span(row), pool);
+            REQUIRE_ARROW_STATUS_OK(plain);
+            plain_size += (*plain)->size();
+
+            auto with_dictionary = pod5::compress_signal(
+                gsl::make_span(row), pool, pod5::DEFAULT_VBZ_COMPRESSION_LEVEL, dictionary->get());
+            REQUIRE_ARROW_STATUS_OK(with_dictionary);
+            dictionary_size += (*with_dictionary)->size();
+            compressed.push_back(*with_dictionary);
+        }
+
+        THEN("Short rows compress smaller than without it")
+        {
+            CHECK(dictionary_size < plain_size);
+        }
+
+        THEN("The rows decompress with the dictionary")
+        {
+            for (std::size_t i = 0; i < rows.size(); ++i) {
+                auto decompressed = decompress(compressed[i], rows[i].size(), dictionary->get());
+                REQUIRE_ARROW_STATUS_OK(decompressed);
+                CHECK(gsl::make_span(rows[i]) == as_samples(*decompressed));
+            }
+        }
+
+        THEN("Signal compressed without the dictionary still decompresses with it")
+        {
+            auto plain = pod5::compress_signal(gsl::make_span(rows[0]), pool);
+            REQUIRE_ARROW_STATUS_OK(plain);
+            auto decompressed = decompress(*plain, rows[0].size(), dictionary->get());
+            REQUIRE_ARROW_STATUS_OK(decompressed);
+            CHECK(gsl::make_span(rows[0]) == as_samples(*decompressed));
+        }
+
+        THEN("The rows fail to decompress without the dictionary")
+        {
+            CHECK(!decompress(compressed[0], rows[0].size(), nullptr).ok());
+        }
+    }
+
+    GIVEN("Data that isn't a dictionary")
+    {
+        auto data = arrow::AllocateBuffer(64, pool);
+        REQUIRE_ARROW_STATUS_OK(data);
+        std::fill((*data)->mutable_data(), (*data)->mutable_data() + 64, 0);
+        CHECK(!pod5::VbzDictionary::make(std::move(*data)).ok());
+    }
+}
+
+SCENARIO("Adaptive compression levels")
+{
+    using Clock = pod5::AdaptiveCompressionLevel::Clock;
+    using std::chrono::milliseconds;
+
+    pod5::AdaptiveCompressionLevel adaptive(1, 9, 3);
+    REQUIRE(adaptive.level() == 3);
+
+    auto now = Clock::now();
+    // Run a batch of [sample_bytes], compressed in [compress_ms] out of [elapsed_ms]:
+    auto const run_batch = [&](std::size_t sample_bytes, int compress_ms, int elapsed_ms) {
+        adaptive.add_row(sample_bytes, milliseconds(compress_ms), now + milliseconds(compress_ms));
+        now += milliseconds(elapsed_ms);
+        return adaptive.finish_batch(now);
+    };
+
+    GIVEN("A writer that is mostly idle")
+    {
+        THEN("The level rises one step per batch, up to the maximum")
+        {
+            CHECK(run_batch(1'000'000, 10, 100) == 4);
+            CHECK(run_batch(1'000'000, 10, 100) == 5);
+            for (int i = 0; i < 10; ++i) {
+                run_batch(1'000'000, 10, 100);
+            }
+            CHECK(adaptive.level() == 9);
+        }
+    }
+
+    GIVEN("A writer that is falling behind")
+    {
+        THEN("The level drops, down to the minimum")
+        {
+            CHECK(run_batch(1'000'000, 90, 100) == 2);
+            CHECK(run_batch(1'000'000, 90, 100) == 1);
+            CHECK(run_batch(1'000'000, 90, 100) == 1);
+        }
+    }
+
+    GIVEN("Levels measured at different throughputs")
+    {
+        // Measure levels 4 to 6 as fast while the writer is idle:
+        run_batch(1'000'000, 10, 100);
+        run_batch(1'000'000, 10, 100);
+        run_batch(1'000'000, 10, 100);
+        REQUIRE(adaptive.level() == 6);
+        CHECK(adaptive.throughput(5) == Approx(1e8));
+
+        THEN("A burst drops straight past levels measured too slow for it")
+        {
+            // Signal arriving 10x faster, level 6 compressing it at 1e8 bytes/s:
+            run_batch(10'000'000, 100, 100);
+            // Levels 3 to 5 were measured as slow, so the level drops to the unmeasured level 2:
+            CHECK(adaptive.level() == 2);
+        }
+
+        THEN("The level doesn't rise to a level measured too slow")
+        {
+            // Level 7 is measured slow, then the writer drops back to 6:
+            run_batch(1'000'000, 25, 100);
+            REQUIRE(adaptive.level() == 7);
+            run_batch(1'000'000, 70, 100);
+            REQUIRE(adaptive.level() == 6);
+            // An idle batch at 6 with signal arriving faster than level 7 can compress it:
+            CHECK(run_batch(4'000'000, 25, 100) == 6);
+        }
+    }
+
+    GIVEN("A batch with no signal")
+    {
+        now += milliseconds(100);
+        THEN("The level is unchanged") { CHECK(adaptive.finish_batch(now) == 3); }
+    }
+
+    GIVEN("An initial level outside the range")
+    {
+        CHECK(pod5::AdaptiveCompressionLevel(1, 9, 19).level() == 9);
+        CHECK(pod5::AdaptiveCompressionLevel(9, 1, -5).level() == 1);
+    }
+}
+
+SCENARIO("Signal compression kernels")
+{
+    auto pool = arrow::system_memory_pool();
+    auto const initial_kernels = pod5::signal_kernels();
+    auto restore = gsl::finally([&] { (void)pod5::set_signal_kernels(initial_kernels); });
+
+    GIVEN("Each combination of available kernels")
+    {
+        auto const svb16_decode = GENERATE(pod5::SvbKernel::Scalar, pod5::SvbKernel::Sse);
+        auto const svb16_encode = GENERATE(pod5::SvbKernel::Scalar, pod5::SvbKernel::Sse);
+        auto const zstd_decompress = GENERATE(
+            pod5::ZstdDecompressMode::OneShot, pod5::ZstdDecompressMode::Streaming);
+        pod5::SignalKernels kernels;
+        kernels.svb16_decode = svb16_decode;
+        kernels.svb16_encode = svb16_encode;
+        kernels.zstd_decompress = zstd_decompress;
+        CAPTURE(pod5::format_signal_kernels(kernels));
+
+        if (!pod5::svb_kernel_available(pod5::SvbKernel::Sse)
+            && (svb16_decode == pod5::SvbKernel::Sse || svb16_encode == pod5::SvbKernel::Sse))
+        {
+            CHECK(!pod5::set_signal_kernels(kernels).ok());
+            return;
+        }
+        REQUIRE_ARROW_STATUS_OK(pod5::set_signal_kernels(kernels));
+        CHECK(pod5::signal_kernels() == kernels);
+        CHECK(pod5::signal_kernel_selection().source == "explicit");
+
+        THEN("Signal round trips, with and without a dictionary")
+        {
+            std::mt19937 gen(6);
+            std::normal_distribution<float> noise(0, 20);
+            std::vector<std::vector<std::int16_t>> rows(200);
+            for (auto & row : rows) {
+                // Odd lengths exercise the kernels' scalar tails:
+                row.resize(1'001);
+                for (auto & sample : row) {
+                    sample = std::int16_t(300 + noise(gen));
+                }
+            }
+            std::vector<gsl::span<std::int16_t const>> training_rows(rows.begin(), rows.end());
+            auto dictionary_data = pod5::train_vbz_dictionary(training_rows, 4 * 1024, pool);
+            REQUIRE_ARROW_STATUS_OK(dictionary_data);
+            auto dictionary = pod5::VbzDictionary::make(*dictionary_data);
+            REQUIRE_ARROW_STATUS_OK(dictionary);
+
+            for (auto const * row_dictionary : {(pod5::VbzDictionary const *)nullptr,
+                                                 (pod5::VbzDictionary const *)dictionary->get()})
+            {
+                auto compressed = pod5::compress_signal(
+                    gsl::make_span(rows[0]),
+                    pool,
+                    pod5::DEFAULT_VBZ_COMPRESSION_LEVEL,
+                    row_dictionary);
+                REQUIRE_ARROW_STATUS_OK(compressed);
+                auto compressed_span = gsl::make_span((*compressed)->data(), (*compressed)->size());
+
+                auto decompressed =
+                    pod5::decompress_signal(compressed_span, rows[0].size(), pool, row_dictionary);
+                REQUIRE_ARROW_STATUS_OK(decompressed);
+                CHECK(
+                    gsl::make_span(rows[0])
+                    == gsl::make_span((*decompressed)->data(), (*decompressed)->size())
+                           .as_span<std::int16_t const>());
+
+                CHECK(!pod5::decompress_signal(
+                           compressed_span.first(compressed_span.size() - 4),
+                           rows[0].size(),
+                           pool,
+                           row_dictionary)
+                           .ok());
+            }
+
+            // Signal compressed without a dictionary still decompresses after one was used:
+            auto plain = pod5::compress_signal(gsl::make_span(rows[1]), pool);
+            REQUIRE_ARROW_STATUS_OK(plain);
+            auto decompressed = pod5::decompress_signal(
+                gsl::make_span((*plain)->data(), (*plain)->size()), rows[1].size(), pool);
+            REQUIRE_ARROW_STATUS_OK(decompressed);
+        }
+    }
+
+    GIVEN("Kernel descriptions")
+    {
+        pod5::SignalKernels kernels;
+        kernels.zstd_decompress = pod5::ZstdDecompressMode::Streaming;
+
+        THEN("A formatted description parses back")
+        {
+            auto parsed = pod5::parse_signal_kernels(
+                pod5::format_signal_kernels(kernels), pod5::SignalKernels{});
+            REQUIRE_ARROW_STATUS_OK(parsed);
+            CHECK(*parsed == kernels);
+        }
+
+        THEN("Stages not named are left unchanged")
+        {
+            auto parsed = pod5::parse_signal_kernels("svb16_encode=scalar", kernels);
+            REQUIRE_ARROW_STATUS_OK(parsed);
+            CHECK(*parsed == kernels);
+        }
+
+        THEN("Unknown stages and kernels are rejected")
+        {
+            CHECK(!pod5::parse_signal_kernels("svb16_decode=avx9", kernels).ok());
+            CHECK(!pod5::parse_signal_kernels("zstd=scalar", kernels).ok());
+            CHECK(!pod5::parse_signal_kernels("scalar", kernels).ok());
+        }
+    }
+
+    GIVEN("A calibration")
+    {
+        auto selection = pod5::calibrate_signal_kernels();
+        REQUIRE_ARROW_STATUS_OK(selection);
+
+        THEN("Every available kernel was timed")
+        {
+            CHECK(selection->timings.count("svb16_decode=scalar") == 1);
+            CHECK(selection->timings.count("zstd_decompress=one_shot") == 1);
+            CHECK(selection->timings.count("zstd_decompress=streaming") == 1);
+            CHECK(
+                selection->timings.count("svb16_decode=sse4.1")
+                == (pod5::svb_kernel_available(pod5::SvbKernel::Sse) ? 1 : 0));
+        }
+
+        THEN("Calibrating again reuses the first calibration and leaves the kernels in use")
+        {
+            REQUIRE_ARROW_STATUS_OK(pod5::set_signal_kernels(initial_kernels));
+            auto again = pod5::calibrate_signal_kernels();
+            REQUIRE_ARROW_STATUS_OK(again);
+            CHECK(again->kernels == selection->kernels);
+            CHECK(again->timings == selection->timings);
+            CHECK(pod5::signal_kernels() == initial_kernels);
+            CHECK(pod5::signal_kernel_selection().source == "explicit");
+        }
+    }
 }
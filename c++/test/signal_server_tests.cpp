@@ -0,0 +1,335 @@
+#include "pod5_format/c_api.h"
+#include "pod5_format/file_writer.h"
+#include "pod5_format/signal_client.h"
+#include "pod5_format/signal_server.h"
+#include "pod5_format/signal_server_protocol.h"
+#include "pod5_format/types.h"
+#include "test_utils.h"
+#include "utils.h"
+
+#include <boost/uuid/random_generator.hpp>
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+gsl::span<std::uint8_t const> as_bytes(std::vector<std::uint8_t> const & data)
+{
+    return gsl::make_span(data);
+}
+}  // namespace
+
+SCENARIO("Signal server messages")
+{
+    int sockets[2];
+    REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) == 0);
+    auto close_sockets = gsl::finally([&] {
+        close(sockets[0]);
+        close(sockets[1]);
+    });
+
+    std::vector<std::uint8_t> first_part(100);
+    std::vector<std::uint8_t> second_part(300 * 1024);
+    std::iota(first_part.begin(), first_part.end(), std::uint8_t(0));
+    std::iota(second_part.begin(), second_part.end(), std::uint8_t(7));
+    gsl::span<std::uint8_t const> const payload[] = {as_bytes(first_part), as_bytes(second_part)};
+
+    pod5::signal_server::MessageHeader header;
+    header.type = pod5::signal_server::MessageType::GetSignal;
+
+    auto const check_received = [&](bool in_file) {
+        auto message = pod5::signal_server::receive_message(
+            sockets[1], pod5::signal_server::MAX_INLINE_REQUEST_SIZE);
+        REQUIRE_ARROW_STATUS_OK(message);
+        REQUIRE(*message);
+        CHECK((*message)->header.type == pod5::signal_server::MessageType::GetSignal);
+        CHECK(
+            bool((*message)->header.flags & pod5::signal_server::MessageHeader::PAYLOAD_IN_FILE)
+            == in_file);
+        CHECK_ARROW_STATUS_OK(pod5::signal_server::message_status(**message));
+
+        auto const data = (*message)->payload.data();
+        REQUIRE(data.size() == first_part.size() + second_part.size());
+        CHECK(std::equal(first_part.begin(), first_part.end(), data.begin()));
+        CHECK(std::equal(second_part.begin(), second_part.end(), data.begin() + first_part.size()));
+    };
+
+    GIVEN("A message sent through the socket")
+    {
+        // Send from another thread, the payload is larger than the socket's buffer:
+        std::thread sender([&] {
+            CHECK_ARROW_STATUS_OK(pod5::signal_server::send_message(
+                sockets[0], header, payload, pod5::signal_server::MAX_INLINE_REQUEST_SIZE));
+        });
+        check_received(false);
+        sender.join();
+    }
+
+    GIVEN("A message sent through a payload file")
+    {
+        CHECK_ARROW_STATUS_OK(
+            pod5::signal_server::send_message(sockets[0], header, payload, 64 * 1024));
+        check_received(true);
+    }
+
+    GIVEN("A message with a larger payload than the receiver reads from the socket")
+    {
+        header.payload_size = pod5::signal_server::MAX_INLINE_REQUEST_SIZE + 1;
+        REQUIRE(send(sockets[0], &header, sizeof(header), 0) == sizeof(header));
+        CHECK_ARROW_STATUS_NOT_OK(pod5::signal_server::receive_message(
+            sockets[1], pod5::signal_server::MAX_INLINE_REQUEST_SIZE));
+    }
+
+    GIVEN("A message with a payload file that isn't sealed")
+    {
+        int const fd = memfd_create("pod5_signal_server_test", MFD_CLOEXEC);
+        REQUIRE(fd >= 0);
+        auto close_fd = gsl::finally([fd] { close(fd); });
+        REQUIRE(write(fd, first_part.data(), first_part.size()) == ssize_t(first_part.size()));
+
+        header.flags = pod5::signal_server::MessageHeader::PAYLOAD_IN_FILE;
+        header.payload_size = first_part.size();
+        iovec iov{&header, sizeof(header)};
+        alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+        msghdr socket_message{};
+        socket_message.msg_iov = &iov;
+        socket_message.msg_iovlen = 1;
+        socket_message.msg_control = control;
+        socket_message.msg_controllen = sizeof(control);
+        auto const control_message = CMSG_FIRSTHDR(&socket_message);
+        control_message->cmsg_level = SOL_SOCKET;
+        control_message->cmsg_type = SCM_RIGHTS;
+        control_message->cmsg_len = CMSG_LEN(sizeof(int));
+        std::memcpy(CMSG_DATA(control_message), &fd, sizeof(int));
+        REQUIRE(sendmsg(sockets[0], &socket_message, 0) == sizeof(header));
+
+        CHECK_ARROW_STATUS_NOT_OK(pod5::signal_server::receive_message(
+            sockets[1], pod5::signal_server::MAX_INLINE_REQUEST_SIZE));
+    }
+
+    GIVEN("An error sent through the socket")
+    {
+        CHECK_ARROW_STATUS_OK(pod5::signal_server::send_error(
+            sockets[0],
+            pod5::signal_server::MessageType::OpenFile,
+            pod5::Status::IOError("No such file")));
+        auto message = pod5::signal_server::receive_message(
+            sockets[1], pod5::signal_server::MAX_INLINE_REQUEST_SIZE);
+        REQUIRE_ARROW_STATUS_OK(message);
+        auto const status = pod5::signal_server::message_status(**message);
+        CHECK(status.IsIOError());
+        CHECK(status.message() == "No such file");
+    }
+
+    GIVEN("A closed socket")
+    {
+        close(sockets[0]);
+        sockets[0] = socket(AF_UNIX, SOCK_STREAM, 0);
+        auto message = pod5::signal_server::receive_message(
+            sockets[1], pod5::signal_server::MAX_INLINE_REQUEST_SIZE);
+        REQUIRE_ARROW_STATUS_OK(message);
+        CHECK(!*message);
+    }
+}
+
+SCENARIO("Signal server")
+{
+    static constexpr char const * file = "./foo_signal_server.pod5";
+    REQUIRE_ARROW_STATUS_OK(remove_file_if_exists(file));
+    (void)pod5::register_extension_types();
+    auto fin = gsl::finally([] { (void)pod5::unregister_extension_types(); });
+
+    auto uuid_gen = boost::uuids::random_generator_mt19937();
+    std::mt19937 sample_gen(3);
+    std::uniform_int_distribution<std::int16_t> sample_dist(0, 1000);
+    std::vector<boost::uuids::uuid> read_ids;
+    std::vector<std::vector<std::int16_t>> signals;
+    {
+        pod5::FileWriterOptions options;
+        options.set_read_table_batch_size(10);
+        auto writer = pod5::create_file_writer(file, "test_software", options);
+        REQUIRE_ARROW_STATUS_OK(writer);
+        auto run_info = (*writer)->add_run_info(get_test_run_info_data("_run_info"));
+        auto end_reason = (*writer)->lookup_end_reason(pod5::ReadEndReason::unknown);
+        auto pore_type = (*writer)->add_pore_type("pore_type");
+        for (std::uint32_t i = 0; i < 35; ++i) {
+            signals.emplace_back(1'000 + 100 * i);
+            std::generate(signals.back().begin(), signals.back().end(), [&] {
+                return sample_dist(sample_gen);
+            });
+
+            pod5::ReadData read_data{};
+            read_data.read_id = uuid_gen();
+            read_data.read_number = i;
+            read_data.channel = std::uint16_t(i % 4);
+            read_data.pore_type = *pore_type;
+            read_data.end_reason = *end_reason;
+            read_data.run_info = *run_info;
+            read_ids.push_back(read_data.read_id);
+            REQUIRE_ARROW_STATUS_OK(
+                (*writer)->add_complete_read(read_data, gsl::make_span(signals[i])));
+        }
+        REQUIRE_ARROW_STATUS_OK((*writer)->close());
+    }
+
+    pod5::SignalServerOptions options;
+    options.socket_path = "./pod5_signal_server_test_" + std::to_string(getpid()) + ".sock";
+    options.worker_count = 2;
+    options.file_payload_size = 16 * 1024;
+    auto server = pod5::SignalServer::create(options);
+    REQUIRE_ARROW_STATUS_OK(server);
+    std::thread server_thread([&] { CHECK_ARROW_STATUS_OK((*server)->run()); });
+    auto stop_server = gsl::finally([&] {
+        (*server)->stop();
+        server_thread.join();
+    });
+
+    // Only the server's user may connect by default:
+    struct stat socket_stat;
+    REQUIRE(stat(options.socket_path.c_str(), &socket_stat) == 0);
+    CHECK((socket_stat.st_mode & 0777) == 0600);
+
+    auto client = pod5::SignalClient::connect(options.socket_path);
+    REQUIRE_ARROW_STATUS_OK(client);
+    auto opened_file = (*client)->open_file(file);
+    REQUIRE_ARROW_STATUS_OK(opened_file);
+    CHECK(opened_file->read_count == read_ids.size());
+    CHECK(!opened_file->file_identifier.is_nil());
+
+    auto const read_index = [&](pod5::SignalServerRead const & read) {
+        auto const it =
+            std::find_if(read_ids.begin(), read_ids.end(), [&](boost::uuids::uuid const & id) {
+                return std::memcmp(id.data, read.read_id, sizeof(read.read_id)) == 0;
+            });
+        REQUIRE(it != read_ids.end());
+        return std::size_t(it - read_ids.begin());
+    };
+
+    GIVEN("Requests for every read")
+    {
+        auto reads = (*client)->get_reads(opened_file->file, {}, false);
+        auto signal = (*client)->get_reads(opened_file->file, {}, true);
+        REQUIRE_ARROW_STATUS_OK(reads);
+        REQUIRE_ARROW_STATUS_OK(signal);
+
+        THEN("Every read's metadata and samples are returned in file order, joined from each "
+             "batch's reply")
+        {
+            REQUIRE((*reads)->reads().size() == read_ids.size());
+            REQUIRE((*signal)->reads().size() == read_ids.size());
+            CHECK((*reads)->samples().empty());
+            for (std::size_t i = 0; i < read_ids.size(); ++i) {
+                auto const & read = (*reads)->reads()[i];
+                CHECK(read_index(read) == i);
+                CHECK(read.read_number == i);
+                CHECK(read.channel == i % 4);
+                CHECK(read.num_samples == signals[i].size());
+
+                auto const & signal_read = (*signal)->reads()[i];
+                CHECK(read_index(signal_read) == i);
+                auto const samples = (*signal)->samples(signal_read);
+                CHECK(std::vector<std::int16_t>(samples.begin(), samples.end()) == signals[i]);
+            }
+        }
+    }
+
+    GIVEN("Requests for specific reads, some not in the file")
+    {
+        std::vector<boost::uuids::uuid> requested{read_ids[30], uuid_gen(), read_ids[2]};
+        auto signal = (*client)->get_reads(opened_file->file, requested, true);
+        REQUIRE_ARROW_STATUS_OK(signal);
+
+        THEN("The reads found are returned")
+        {
+            REQUIRE((*signal)->reads().size() == 2);
+            for (auto const & read : (*signal)->reads()) {
+                auto const index = read_index(read);
+                CHECK((index == 2 || index == 30));
+                auto const samples = (*signal)->samples(read);
+                CHECK(std::vector<std::int16_t>(samples.begin(), samples.end()) == signals[index]);
+            }
+        }
+    }
+
+    GIVEN("A second client opening the same file")
+    {
+        auto second_client = pod5::SignalClient::connect(options.socket_path);
+        REQUIRE_ARROW_STATUS_OK(second_client);
+        auto second_file = (*second_client)->open_file(file);
+        REQUIRE_ARROW_STATUS_OK(second_file);
+
+        THEN("The server opens the file once, and keeps it open once closed")
+        {
+            CHECK((*server)->open_file_count() == 1);
+            CHECK_ARROW_STATUS_OK((*client)->close_file(opened_file->file));
+            CHECK_ARROW_STATUS_OK((*second_client)->close_file(second_file->file));
+            CHECK((*server)->open_file_count() == 1);
+        }
+    }
+
+    GIVEN("A client using the C API")
+    {
+        auto c_client = pod5_signal_client_connect(options.socket_path.c_str());
+        REQUIRE(c_client);
+        auto disconnect = gsl::finally([&] { pod5_signal_client_disconnect(c_client); });
+
+        std::uint32_t c_file = 0;
+        std::size_t read_count = 0;
+        REQUIRE(pod5_signal_client_open_file(c_client, file, &c_file, &read_count) == POD5_OK);
+        CHECK(read_count == read_ids.size());
+
+        Pod5SignalServerReads_t * c_reads = nullptr;
+        REQUIRE(
+            pod5_signal_client_get_reads(
+                c_client,
+                c_file,
+                reinterpret_cast<read_id_t const *>(&read_ids[5]),
+                1,
+                1,
+                &c_reads)
+            == POD5_OK);
+        auto free_reads = gsl::finally([&] { pod5_free_signal_server_reads(c_reads); });
+
+        THEN("The read and its samples are returned")
+        {
+            SignalServerRead_t const * read_data = nullptr;
+            std::size_t c_read_count = 0;
+            std::int16_t const * samples = nullptr;
+            std::size_t sample_count = 0;
+            REQUIRE(
+                pod5_get_signal_server_reads(
+                    c_reads, &read_data, &c_read_count, &samples, &sample_count)
+                == POD5_OK);
+            REQUIRE(c_read_count == 1);
+            CHECK(read_data[0].read_number == 5);
+            CHECK(sample_count == signals[5].size());
+            CHECK(std::equal(signals[5].begin(), signals[5].end(), samples));
+            CHECK(pod5_signal_client_close_file(c_client, c_file) == POD5_OK);
+            CHECK(pod5_signal_client_close_file(c_client, c_file) == POD5_ERROR_INVALID);
+        }
+    }
+
+    GIVEN("Invalid requests")
+    {
+        THEN("Errors are returned, and the connection stays usable")
+        {
+            CHECK_ARROW_STATUS_NOT_OK((*client)->open_file("./not_a_file.pod5"));
+            CHECK_ARROW_STATUS_NOT_OK((*client)->get_reads(opened_file->file + 1, {}, false));
+            CHECK_ARROW_STATUS_OK((*client)->close_file(opened_file->file));
+            CHECK_ARROW_STATUS_NOT_OK((*client)->get_reads(opened_file->file, {}, false));
+        }
+    }
+}
+#endif
@@ -0,0 +1,109 @@
+#include "pod5_format/signal_statistics.h"
+
+#include <catch2/catch.hpp>
+#include <gsl/gsl-lite.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <vector>
+
+SCENARIO("Signal statistics Tests")
+{
+    GIVEN("A signal spanning several accumulation blocks")
+    {
+        std::vector<std::int16_t> signal(5000);
+        for (std::size_t i = 0; i < signal.size(); ++i) {
+            signal[i] = std::int16_t((i * 7919) % 2001) - 1000;
+        }
+
+        double sum = 0;
+        for (auto s : signal) {
+            sum += s;
+        }
+        auto const mean = sum / signal.size();
+        double variance = 0;
+        for (auto s : signal) {
+            variance += (s - mean) * (s - mean);
+        }
+        variance /= signal.size();
+
+        WHEN("Computing statistics in one pass")
+        {
+            auto const stats = pod5::compute_signal_statistics(gsl::make_span(signal), -999, 999);
+
+            THEN("The statistics match a reference calculation")
+            {
+                CHECK(stats.min == -1000);
+                CHECK(stats.max == 1000);
+                CHECK(stats.mean == Approx(mean));
+                CHECK(stats.stdev == Approx(std::sqrt(variance)));
+                CHECK(
+                    stats.saturated_count
+                    == std::size_t(std::count_if(signal.begin(), signal.end(), [](std::int16_t s) {
+                           return s <= -999 || s >= 999;
+                       })));
+            }
+        }
+
+        WHEN("Accumulating the signal in uneven chunks")
+        {
+            pod5::SignalStatisticsAccumulator accumulator(-999, 999);
+            auto span = gsl::make_span(signal);
+            accumulator.add(span.subspan(0, 17));
+            accumulator.add(span.subspan(17, 3000));
+            accumulator.add(span.subspan(3017));
+
+            THEN("The statistics match the single pass result")
+            {
+                CHECK(accumulator.sample_count() == signal.size());
+                CHECK(
+                    accumulator.statistics()
+                    == pod5::compute_signal_statistics(span, -999, 999));
+            }
+        }
+    }
+
+    GIVEN("A full range signal with a length not a multiple of the vector width")
+    {
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<int> dist(
+            std::numeric_limits<std::int16_t>::min(), std::numeric_limits<std::int16_t>::max());
+        std::vector<std::int16_t> signal(4099);
+        for (auto & s : signal) {
+            s = std::int16_t(dist(gen));
+        }
+        // Extreme values give the largest squares the kernels must accumulate:
+        std::fill(signal.begin(), signal.begin() + 64, std::numeric_limits<std::int16_t>::min());
+
+        std::int64_t sum = 0;
+        for (auto s : signal) {
+            sum += s;
+        }
+        auto const mean = double(sum) / signal.size();
+        double variance = 0;
+        for (auto s : signal) {
+            variance += (s - mean) * (s - mean);
+        }
+        variance /= signal.size();
+
+        auto const stats = pod5::compute_signal_statistics(gsl::make_span(signal), -30000, 30000);
+
+        CHECK(stats.min == *std::min_element(signal.begin(), signal.end()));
+        CHECK(stats.max == *std::max_element(signal.begin(), signal.end()));
+        CHECK(stats.mean == Approx(mean));
+        CHECK(stats.stdev == Approx(std::sqrt(variance)));
+        CHECK(
+            stats.saturated_count
+            == std::size_t(std::count_if(signal.begin(), signal.end(), [](std::int16_t s) {
+                   return s <= -30000 || s >= 30000;
+               })));
+    }
+
+    GIVEN("An empty signal")
+    {
+        auto const stats = pod5::compute_signal_statistics({});
+        CHECK(stats == pod5::SignalStatistics{});
+    }
+}
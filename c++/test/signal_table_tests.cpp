@@ -138,6 +138,13 @@ SCENARIO("Signal table Tests")
             CHECK(samples->length() == 2);
             CHECK(samples->Value(0) == signal_1.size());
             CHECK(samples->Value(1) == signal_2.size());
+
+            // The batch message is found where the writer recorded it:
+            auto const offsets = reader->record_batch_offsets();
+            REQUIRE_ARROW_STATUS_OK(offsets);
+            REQUIRE(offsets->size() == 1);
+            REQUIRE(reader->batch_checksum(0));
+            CHECK((*offsets)[0] == reader->batch_checksum(0)->offset);
         }
     }
 }
@@ -3,6 +3,7 @@
 from ._version import __version__, __version_tuple__
 from .pod5_format_pybind import (
     EmbeddedFileData,
+    FileVerificationReport,
     FileWriter,
     FileWriterOptions,
     Pod5AsyncSignalLoader,
@@ -15,7 +16,10 @@ from .pod5_format_pybind import (
     recover_file,
     decompress_signal,
     format_read_id_to_str,
+    format_read_ids_to_array,
     get_error_string,
+    get_signal_kernels,
+    load_read_id_array,
     load_read_id_iterable,
     open_file,
     update_file,
@@ -26,6 +30,7 @@ __all__ = [
     "__version__",
     "__version_tuple__",
     "EmbeddedFileData",
+    "FileVerificationReport",
     "FileWriter",
     "FileWriterOptions",
     "Pod5AsyncSignalLoader",
@@ -38,7 +43,10 @@ __all__ = [
     "recover_file",
     "decompress_signal",
     "format_read_id_to_str",
+    "format_read_ids_to_array",
     "get_error_string",
+    "get_signal_kernels",
+    "load_read_id_array",
     "load_read_id_iterable",
     "open_file",
     "update_file",
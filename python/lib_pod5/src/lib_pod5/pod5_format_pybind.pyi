@@ -22,6 +22,35 @@ class EmbeddedFileData:
     @property
     def file_path(self) -> str: ...
 
+class FileVerificationReport:
+    def __init__(self, *args, **kwargs) -> None: ...
+    @property
+    def ok(self) -> bool: ...
+    @property
+    def read_count(self) -> int: ...
+    @property
+    def signal_row_count(self) -> int: ...
+    @property
+    def unreferenced_signal_row_count(self) -> int: ...
+    @property
+    def sample_count(self) -> int: ...
+    @property
+    def signal_byte_count(self) -> int: ...
+    @property
+    def elapsed_seconds(self) -> float: ...
+    @property
+    def error_count(self) -> int: ...
+    @property
+    def errors(self) -> List[str]: ...
+    @property
+    def checked_batch_count(self) -> int: ...
+    @property
+    def unchecked_batch_count(self) -> int: ...
+    @property
+    def checked_byte_count(self) -> int: ...
+    @property
+    def checksum_failures(self) -> List[str]: ...
+
 class FileWriter:
     def __init__(self, *args, **kwargs) -> None: ...
     def add_end_reason(self, end_reason_enum: int) -> int: ...
@@ -141,6 +170,9 @@ class Pod5FileReader:
         batch_counts: npt.NDArray[np.uint32],
         batch_rows: npt.NDArray[np.uint32],
     ) -> int: ...
+    def verify(
+        self, worker_count: int = 0, verify_batch_checksums: bool = True
+    ) -> FileVerificationReport: ...
 
 class Pod5RepackerOutput:
     def __init__(self, *args, **kwargs) -> None: ...
@@ -187,11 +219,20 @@ def recover_file(src_filename: str, dst_filename: str) -> FileWriter: ...
 def decompress_signal(
     compressed_signal: Union[npt.NDArray[np.uint8], memoryview],
     signal_out: npt.NDArray[np.int16],
+    file_reader: Optional[Pod5FileReader] = None,
 ) -> None: ...
 def format_read_id_to_str(
     read_id_data_out: npt.NDArray[np.uint8],
 ) -> List[str]: ...
+def format_read_ids_to_array(
+    read_id_data: npt.NDArray[np.uint8],
+) -> npt.NDArray[np.bytes_]: ...
 def get_error_string() -> str: ...
+def get_signal_kernels() -> str: ...
+def load_read_id_array(
+    read_ids_str: Union[npt.NDArray[np.bytes_], npt.NDArray[np.str_]],
+    read_id_data_out: npt.NDArray[np.uint8],
+) -> int: ...
 def load_read_id_iterable(
     read_ids_str: Iterable, read_id_data_out: npt.NDArray[np.uint8]
 ) -> int: ...
@@ -28,6 +28,7 @@ from .pod5_types import (
     Pore,
     Read,
     RunInfo,
+    SignalStatistics,
 )
 from .reader import Reader, ReadRecord, ReadRecordBatch
 from .dataset import DatasetReader
@@ -53,6 +54,7 @@ __all__ = (
     "Pore",
     "Read",
     "RunInfo",
+    "SignalStatistics",
     "Reader",
     "ReadRecord",
     "ReadRecordBatch",
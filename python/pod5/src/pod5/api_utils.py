@@ -9,7 +9,7 @@ from typing import Any, Collection, List, Union
 import numpy as np
 import numpy.typing as npt
 import pyarrow as pa
-from lib_pod5 import format_read_id_to_str, load_read_id_iterable
+from lib_pod5 import format_read_id_to_str, load_read_id_array, load_read_id_iterable
 
 
 class Pod5ApiException(Exception):
@@ -26,7 +26,8 @@ def pack_read_ids(
     Parameters
     ----------
     read_ids : Collection[str]
-        Collection of well-formatted read_id strings
+        Collection of well-formatted read_id strings, numpy arrays of str or bytes
+        are parsed in bulk
 
     Returns
     -------
@@ -34,7 +35,10 @@ def pack_read_ids(
         Repacked read_ids ready for writing to pod5 files.
     """
     read_id_data = np.empty(shape=(len(read_ids), 16), dtype=np.uint8)
-    count = load_read_id_iterable(read_ids, read_id_data)
+    if isinstance(read_ids, np.ndarray) and read_ids.dtype.kind in "SU":
+        count = load_read_id_array(read_ids, read_id_data)
+    else:
+        count = load_read_id_iterable(read_ids, read_id_data)
     if invalid_ok is False and count != len(read_ids):
         raise RuntimeError("Invalid read id passed")
 
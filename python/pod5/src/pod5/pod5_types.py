@@ -226,6 +226,38 @@ class RunInfo:
     tracking_id: Dict[str, str] = field(hash=False, compare=True)
 
 
+@dataclass()
+class SignalStatistics:
+    """
+    Statistics of a read's signal, stored in the read table by writers asked to.
+
+    Parameters
+    ----------
+
+    min: int
+        Minimum raw ADC value of the signal.
+    max: int
+        Maximum raw ADC value of the signal.
+    mean: float
+        Mean of the signal in raw ADC units.
+    stdev: float
+        Population standard deviation of the signal in raw ADC units.
+    saturated_count: int
+        Number of samples at or beyond the adc_min/adc_max limits of the read's run info.
+    """
+
+    #: Minimum raw ADC value of the signal.
+    min: int
+    #: Maximum raw ADC value of the signal.
+    max: int
+    #: Mean of the signal in raw ADC units.
+    mean: float
+    #: Population standard deviation of the signal in raw ADC units.
+    stdev: float
+    #: Number of samples at or beyond the adc_min/adc_max limits of the read's run info.
+    saturated_count: int
+
+
 @dataclass()
 class ShiftScalePair:
     """A pair of floating point shift and scale values."""
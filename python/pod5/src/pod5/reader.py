@@ -37,6 +37,7 @@ from pod5.pod5_types import (
     Read,
     RunInfo,
     ShiftScalePair,
+    SignalStatistics,
 )
 
 from .api_utils import Pod5ApiException, format_read_ids, pack_read_ids, safe_close
@@ -71,6 +72,16 @@ ReadRecordV3Columns = namedtuple(
 )
 
 
+#: Optional read table columns holding each read's SignalStatistics, in field order.
+SIGNAL_STATISTICS_COLUMNS = (
+    "signal_min",
+    "signal_max",
+    "signal_mean",
+    "signal_stdev",
+    "signal_saturated_count",
+)
+
+
 Signal = namedtuple("Signal", ["signal", "samples"])
 SignalRowInfo = namedtuple(
     "SignalRowInfo",
@@ -254,6 +265,17 @@ class ReadRecord:
         """
         return self.num_samples
 
+    @property
+    def signal_statistics(self) -> Optional[SignalStatistics]:
+        """
+        Get the statistics of the read's signal stored in the read table, without decoding the
+        signal. None if the file doesn't store statistics, or not for this read.
+        """
+        columns = self._batch.signal_statistics_columns
+        if columns is None or not columns[0][self._row].is_valid:
+            return None
+        return SignalStatistics(*(column[self._row].as_py() for column in columns))
+
     @property
     def byte_count(self) -> int:
         """
@@ -300,7 +322,9 @@ class ReadRecord:
             ]
             if self._reader.is_vbz_compressed:
                 vbz_decompress_signal_into(
-                    memoryview(signal[batch_row_index].as_buffer()), output_slice
+                    memoryview(signal[batch_row_index].as_buffer()),
+                    output_slice,
+                    self._reader.inner_file_reader,
                 )
             else:
                 output_slice[:] = signal.to_numpy()
@@ -399,7 +423,9 @@ class ReadRecord:
         if self._reader.is_vbz_compressed:
             sample_count = batch.samples[batch_row_index].as_py()
             return vbz_decompress_signal(
-                memoryview(signal[batch_row_index].as_buffer()), sample_count
+                memoryview(signal[batch_row_index].as_buffer()),
+                sample_count,
+                self._reader.inner_file_reader,
             )
 
         return signal.to_numpy()
@@ -453,6 +479,16 @@ class ReadRecordBatch:
             )
         return self._columns
 
+    @property
+    def signal_statistics_columns(self) -> Optional[List[pa.Array]]:
+        """
+        Return the optional signal statistics columns of this batch, in SignalStatistics field
+        order, or None if the file was written without them.
+        """
+        if SIGNAL_STATISTICS_COLUMNS[0] not in self._batch.schema.names:
+            return None
+        return [self._batch.column(name) for name in SIGNAL_STATISTICS_COLUMNS]
+
     def set_cached_signal(self, signal_cache: p5b.Pod5SignalCacheBatch) -> None:
         """Set the signal cache"""
         self._signal_cache = signal_cache
@@ -2,7 +2,7 @@
 Tools for handling pod5 signals
 """
 
-from typing import List, Tuple, Union
+from typing import List, Optional, Tuple, Union
 
 import lib_pod5 as p5b
 import numpy as np
@@ -12,7 +12,9 @@ DEFAULT_SIGNAL_CHUNK_SIZE = 102400
 
 
 def vbz_decompress_signal(
-    compressed_signal: Union[npt.NDArray[np.uint8], memoryview], sample_count: int
+    compressed_signal: Union[npt.NDArray[np.uint8], memoryview],
+    sample_count: int,
+    file_reader: Optional[p5b.Pod5FileReader] = None,
 ) -> npt.NDArray[np.int16]:
     """
     Decompress a contiguous (not-chunked) numpy array of compressed signal data
@@ -23,6 +25,9 @@ def vbz_decompress_signal(
         The array of compressed signal data to decompress.
     sample_count : int
         The number of samples in the original signal
+    file_reader : lib_pod5.Pod5FileReader
+        The file the signal was read from, required to decompress signal compressed
+        with the file's signal dictionary
 
     Returns
     -------
@@ -32,7 +37,7 @@ def vbz_decompress_signal(
         return np.array([], dtype=np.int16)
 
     signal = np.empty(sample_count, dtype="i2")
-    p5b.decompress_signal(compressed_signal, signal)
+    p5b.decompress_signal(compressed_signal, signal, file_reader)
     return signal
 
 
@@ -83,6 +88,7 @@ def vbz_decompress_signal_chunked(
 def vbz_decompress_signal_into(
     compressed_signal: Union[npt.NDArray[np.uint8], memoryview],
     output_array: npt.NDArray[np.int16],
+    file_reader: Optional[p5b.Pod5FileReader] = None,
 ) -> npt.NDArray[np.int16]:
     """
     Decompress a numpy array of compressed signal data into the destination
@@ -94,6 +100,9 @@ def vbz_decompress_signal_into(
         The array of compressed signal data to decompress.
     output_array : numpy.ndarray[int16]
         The destination location for signal
+    file_reader : lib_pod5.Pod5FileReader
+        The file the signal was read from, required to decompress signal compressed
+        with the file's signal dictionary
 
     Returns
     -------
@@ -102,7 +111,7 @@ def vbz_decompress_signal_into(
     if len(compressed_signal) == 0:
         return np.array([], dtype=np.int16)
 
-    p5b.decompress_signal(compressed_signal, output_array)
+    p5b.decompress_signal(compressed_signal, output_array, file_reader)
     return output_array
 
 
@@ -13,6 +13,7 @@ from pod5.tools.parsers import (
     prepare_pod5_filter_argparser,
     prepare_pod5_recover_argparser,
     prepare_pod5_update_argparser,
+    prepare_pod5_verify_argparser,
     prepare_pod5_view_argparser,
     run_tool,
 )
@@ -54,6 +55,7 @@ def main() -> Any:
     prepare_pod5_filter_argparser(root)
     prepare_pod5_recover_argparser(root)
     prepare_pod5_update_argparser(root)
+    prepare_pod5_verify_argparser(root)
     prepare_pod5_view_argparser(root)
 
     # Run the tool
@@ -658,6 +658,54 @@ def prepare_pod5_update_argparser(
     return parser
 
 
+#
+# Verify
+#
+def prepare_pod5_verify_argparser(
+    parent: Optional[argparse._SubParsersAction] = None,
+) -> argparse.ArgumentParser:
+    """Create an argument parser for the pod5 verify tool"""
+
+    _desc = (
+        "Check the integrity of pod5 files by decoding every signal row and "
+        "checking every read's references into the signal table"
+    )
+    if parent is None:
+        parser = argparse.ArgumentParser(description=_desc)
+    else:
+        parser = parent.add_parser(
+            name="verify",
+            description=_desc,
+            formatter_class=SubcommandHelpFormatter,
+        )
+
+    parser.add_argument(
+        "inputs", type=Path, nargs="+", help="Input pod5 file(s) to verify"
+    )
+    add_recursive_argument(parser)
+    parser.add_argument(
+        "-t",
+        "--threads",
+        default=0,
+        type=int,
+        help="Set the number of threads to use, 0 uses one per core",
+    )
+    parser.add_argument(
+        "--skip-checksums",
+        action="store_true",
+        help="Do not check table batches against their stored checksums",
+    )
+
+    def run(**kwargs) -> Any:
+        from pod5.tools.pod5_verify import verify_pod5
+
+        return verify_pod5(**kwargs)
+
+    parser.set_defaults(func=run)
+
+    return parser
+
+
 #
 # View
 #
@@ -0,0 +1,67 @@
+"""
+Tool for checking the integrity of pod5 files
+"""
+import typing
+from pathlib import Path
+
+import lib_pod5 as p5b
+from pod5.tools.parsers import prepare_pod5_verify_argparser, run_tool
+from pod5.tools.utils import collect_inputs
+
+
+def print_report(path: Path, report: p5b.FileVerificationReport) -> None:
+    """Print the outcome of verifying a single file"""
+    elapsed = max(report.elapsed_seconds, 1e-9)
+    print(
+        f"{path} - {'OK' if report.ok else 'FAILED'}\n"
+        f"  {report.read_count} reads, {report.signal_row_count} signal rows "
+        f"({report.unreferenced_signal_row_count} unreferenced), "
+        f"{report.sample_count} samples\n"
+        f"  {report.checked_batch_count} batches checksummed, "
+        f"{report.unchecked_batch_count} without checksums\n"
+        f"  decoded {report.signal_byte_count / elapsed / 1e6:.1f} MB/s, "
+        f"{report.sample_count / elapsed / 1e6:.1f} Msamples/s "
+        f"in {report.elapsed_seconds:.2f}s"
+    )
+    for failure in report.checksum_failures:
+        print(f"  {failure}")
+    for error in report.errors:
+        print(f"  {error}")
+    if report.error_count > len(report.errors):
+        print(f"  ... and {report.error_count - len(report.errors)} more errors")
+
+
+def verify_pod5(
+    inputs: typing.List[Path],
+    recursive: bool = False,
+    threads: int = 0,
+    skip_checksums: bool = False,
+) -> None:
+    """
+    Given a list of pod5 files, decode every signal row and check every read's
+    references into the signal table, raising if any file fails.
+    """
+    paths = collect_inputs(inputs, recursive=recursive, pattern="*.pod5")
+
+    failed = []
+    for path in sorted(paths):
+        reader = p5b.open_file(str(path.resolve()))
+        try:
+            report = reader.verify(threads, not skip_checksums)
+        finally:
+            reader.close()
+
+        print_report(path, report)
+        if not report.ok:
+            failed.append(path)
+
+    if failed:
+        raise RuntimeError(f"{len(failed)} of {len(paths)} files failed verification")
+
+
+def main():
+    run_tool(prepare_pod5_verify_argparser())
+
+
+if __name__ == "__main__":
+    main()
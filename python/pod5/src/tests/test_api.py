@@ -4,6 +4,7 @@ from pathlib import Path
 from typing import Union
 from uuid import UUID, uuid4, uuid5
 
+import lib_pod5
 import numpy as np
 import pytest
 
@@ -265,3 +266,23 @@ def test_read_id_packing():
     for rid, unpacked in zip(rids, unpacked_rids):
         assert type(rid) == type(unpacked)
         assert rid == unpacked
+
+
+@pytest.mark.parametrize("dtype", ["U36", "S36", "U40"])
+def test_read_id_array_packing(dtype: str):
+    """
+    Assert pack_read_ids parses numpy arrays of read id strings in bulk, matching
+    the packing of the same ids as a list
+    """
+    rids = [str(uuid4()) for _ in range(100)]
+    packed_rids = pack_read_ids(np.array(rids, dtype=dtype))
+    assert np.array_equal(packed_rids, pack_read_ids(rids))
+
+    formatted = lib_pod5.format_read_ids_to_array(packed_rids)
+    assert formatted.dtype == np.dtype("S36")
+    assert [rid.decode() for rid in formatted] == rids
+
+    bad_rids = np.array(rids[:3] + ["not-a-read-id"], dtype=dtype)
+    with pytest.raises(RuntimeError):
+        pack_read_ids(bad_rids)
+    assert np.array_equal(pack_read_ids(bad_rids, invalid_ok=True)[:3], packed_rids[:3])
@@ -217,6 +217,29 @@ class TestRecordBatch:
             # assert type(batch.read_number_column.to_numpy().tolist()) == list
             assert batch.read_number_column.to_numpy().tolist() == rnums
 
+    def test_signal_statistics(self, reader: p5.Reader) -> None:
+        batch = reader.get_batch(0)
+        assert batch.signal_statistics_columns is None
+        assert batch.get_read(0).signal_statistics is None
+
+        # Files written with signal statistics hold them in optional read table columns:
+        rows = batch.num_reads
+        table = pa.Table.from_batches([batch._batch])
+        for name, values, type in [
+            ("signal_min", [-5] + [None] * (rows - 1), pa.int16()),
+            ("signal_max", [900] + [None] * (rows - 1), pa.int16()),
+            ("signal_mean", [100.5] + [None] * (rows - 1), pa.float32()),
+            ("signal_stdev", [20.25] + [None] * (rows - 1), pa.float32()),
+            ("signal_saturated_count", [3] + [None] * (rows - 1), pa.uint64()),
+        ]:
+            table = table.append_column(name, pa.array(values, type))
+        stats_batch = ReadRecordBatch(reader, table.combine_chunks().to_batches()[0])
+
+        assert stats_batch.get_read(0).signal_statistics == p5.SignalStatistics(
+            min=-5, max=900, mean=100.5, stdev=20.25, saturated_count=3
+        )
+        assert stats_batch.get_read(1).signal_statistics is None
+
     def test_read_batches(self, pod5_factory) -> None:
         n_reads = 1100
         path = pod5_factory(n_reads)
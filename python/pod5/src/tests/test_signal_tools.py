@@ -7,6 +7,7 @@ import random
 
 import numpy as np
 import numpy.typing as npt
+import pod5 as p5
 from pod5.api_utils import safe_close
 import pytest
 
@@ -33,6 +34,18 @@ class TestPod5SignalTools:
         )
         assert np.array_equal(round_trip_signal, random_signal)
 
+    @pytest.mark.parametrize("random_signal", TEST_SEEDS[:1], indirect=True)
+    def test_round_trip_with_file_reader(
+        self, reader: p5.Reader, random_signal: npt.NDArray[np.int16]
+    ) -> None:
+        """Test signal decompresses with a file's signal dictionary passed"""
+        round_trip_signal = vbz_decompress_signal(
+            vbz_compress_signal(random_signal),
+            random_signal.shape[0],
+            reader.inner_file_reader,
+        )
+        assert np.array_equal(round_trip_signal, random_signal)
+
     def test_round_trip_empty(self) -> None:
         """Test compression and decompression round-trip of empty signal data"""
         empty_signal = np.array([], dtype=np.int16)
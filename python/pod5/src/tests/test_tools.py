@@ -109,7 +109,16 @@ class TestPod5Tools:
 
     @pytest.mark.parametrize(
         "command",
-        ["convert", "inspect", "filter", "merge", "subset", "repack", "update"],
+        [
+            "convert",
+            "inspect",
+            "filter",
+            "merge",
+            "subset",
+            "repack",
+            "update",
+            "verify",
+        ],
     )
     def test_tool_exists(self, command: str) -> None:
         """Assert that a pod5 tool exists"""
@@ -229,6 +238,19 @@ class TestPod5Tools:
         with patch("argparse._sys.argv", args):
             main.main()
 
+    def test_verify_command_runs(self) -> None:
+        """Assert that verify scrubs a valid file on several threads without raising"""
+
+        args = [
+            "pod5",
+            "verify",
+            str(POD5_PATH),
+            "--threads",
+            "2",
+        ]
+        with patch("argparse._sys.argv", args):
+            main.main()
+
     def test_subset_command_runs(self, tmp_path: Path) -> None:
         """Assert that typical commands are valid"""
 